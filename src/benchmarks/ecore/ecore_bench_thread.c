@@ -0,0 +1,217 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "ecore_bench.h"
+
+/* Every case halves a 1024 pixels wide ARGB image of 2 * request lines with
+ * a box filter, the way a batch of thumbnails would be scaled. */
+#define SRC_W 1024
+#define DST_W (SRC_W / 2)
+
+typedef struct _Scale_Job Scale_Job;
+struct _Scale_Job
+{
+   const unsigned int *src;
+   unsigned int       *dst;
+   unsigned int        start;
+   unsigned int        end;
+   int                *pending; /* jobs not done yet */
+};
+
+static void
+_scale_lines(const unsigned int *src, unsigned int *dst,
+             unsigned int start, unsigned int end)
+{
+   unsigned int y, x, c;
+
+   for (y = start; y < end; y++)
+     {
+        const unsigned int *s0 = src + (2 * y) * SRC_W;
+        const unsigned int *s1 = s0 + SRC_W;
+        unsigned int *d = dst + y * DST_W;
+
+        for (x = 0; x < DST_W; x++)
+          {
+             unsigned int p = 0;
+
+             for (c = 0; c < 32; c += 8)
+               {
+                  unsigned int sum;
+
+                  sum = ((s0[2 * x] >> c) & 0xff) + ((s0[2 * x + 1] >> c) & 0xff) +
+                        ((s1[2 * x] >> c) & 0xff) + ((s1[2 * x + 1] >> c) & 0xff);
+                  p |= (sum >> 2) << c;
+               }
+             d[x] = p;
+          }
+     }
+}
+
+static unsigned int *
+_scale_src_new(int request)
+{
+   unsigned int *src;
+   int i;
+
+   src = malloc(sizeof (unsigned int) * SRC_W * 2 * request);
+   if (!src) return NULL;
+   for (i = 0; i < SRC_W * 2 * request; i++)
+     src[i] = (unsigned int)i * 2654435761u;
+   return src;
+}
+
+static Eina_Value
+_bench_future_quit(void *data EINA_UNUSED, const Eina_Value v,
+                   const Eina_Future *dead EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+   return v;
+}
+
+static void
+bench_thread_serial(int request)
+{
+   unsigned int *src, *dst;
+
+   src = _scale_src_new(request);
+   dst = malloc(sizeof (unsigned int) * DST_W * request);
+   if (src && dst) _scale_lines(src, dst, 0, request);
+   free(src);
+   free(dst);
+}
+
+static void
+_parallel_scale(void *data, Ecore_Thread *thread EINA_UNUSED,
+                unsigned int start, unsigned int end)
+{
+   Scale_Job *job = data;
+
+   _scale_lines(job->src, job->dst, start, end);
+}
+
+static void
+bench_thread_parallel_for(int request)
+{
+   Scale_Job job;
+   Eina_Future *f;
+
+   job.src = _scale_src_new(request);
+   job.dst = malloc(sizeof (unsigned int) * DST_W * request);
+   if (job.src && job.dst)
+     {
+        f = ecore_thread_parallel_for(0, request, 0, _parallel_scale, &job);
+        if (f)
+          {
+             eina_future_then(f, _bench_future_quit, NULL);
+             ecore_main_loop_begin();
+          }
+     }
+   free((void *)job.src);
+   free(job.dst);
+}
+
+static void
+_line_scale(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Scale_Job *job = data;
+
+   _scale_lines(job->src, job->dst, job->start, job->end);
+}
+
+static void
+_line_done(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Scale_Job *job = data;
+
+   if (!--(*job->pending)) ecore_main_loop_quit();
+}
+
+/* What subsystems do by hand today: one ecore_thread_run() per line */
+static void
+bench_thread_run_per_line(int request)
+{
+   const unsigned int *src;
+   unsigned int *dst;
+   Scale_Job *jobs;
+   int i, pending;
+
+   src = _scale_src_new(request);
+   dst = malloc(sizeof (unsigned int) * DST_W * request);
+   jobs = calloc(request, sizeof (Scale_Job));
+   if (src && dst && jobs)
+     {
+        pending = request;
+        for (i = 0; i < request; i++)
+          {
+             jobs[i].src = src;
+             jobs[i].dst = dst;
+             jobs[i].start = i;
+             jobs[i].end = i + 1;
+             jobs[i].pending = &pending;
+             ecore_thread_run(_line_scale, _line_done, _line_done, &jobs[i]);
+          }
+        ecore_main_loop_begin();
+     }
+   free((void *)src);
+   free(dst);
+   free(jobs);
+}
+
+/* Scale every band of 64 lines twice, the second pass waiting on the first */
+static void
+bench_thread_graph(int request)
+{
+   Ecore_Thread_Graph *graph;
+   Ecore_Thread_Task *first, *second;
+   const unsigned int *src;
+   unsigned int *dst;
+   Scale_Job *jobs;
+   Eina_Future *f;
+   int i, bands;
+
+   bands = (request + 63) / 64;
+   src = _scale_src_new(request);
+   dst = malloc(sizeof (unsigned int) * DST_W * request);
+   jobs = calloc(bands, sizeof (Scale_Job));
+   graph = ecore_thread_graph_new();
+   if (src && dst && jobs && graph)
+     {
+        for (i = 0; i < bands; i++)
+          {
+             jobs[i].src = src;
+             jobs[i].dst = dst;
+             jobs[i].start = i * 64;
+             jobs[i].end = (i + 1) * 64 < request ? (i + 1) * 64 : request;
+             first = ecore_thread_graph_task_add(graph, _line_scale, &jobs[i]);
+             second = ecore_thread_graph_task_add(graph, _line_scale, &jobs[i]);
+             ecore_thread_graph_task_depend(second, first);
+          }
+        f = ecore_thread_graph_run(graph);
+        graph = NULL;
+        if (f)
+          {
+             eina_future_then(f, _bench_future_quit, NULL);
+             ecore_main_loop_begin();
+          }
+     }
+   ecore_thread_graph_free(graph);
+   free((void *)src);
+   free(dst);
+   free(jobs);
+}
+
+void ecore_bench_thread(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "serial",
+         EINA_BENCHMARK(bench_thread_serial), _ECORE_BENCH_TIMES(256, 10, 512));
+   eina_benchmark_register(bench, "parallel_for",
+         EINA_BENCHMARK(bench_thread_parallel_for), _ECORE_BENCH_TIMES(256, 10, 512));
+   eina_benchmark_register(bench, "ecore_thread_run_per_line",
+         EINA_BENCHMARK(bench_thread_run_per_line), _ECORE_BENCH_TIMES(256, 10, 512));
+   eina_benchmark_register(bench, "graph",
+         EINA_BENCHMARK(bench_thread_graph), _ECORE_BENCH_TIMES(256, 10, 512));
+}
@@ -40,12 +40,18 @@ static const Eina_Benchmark_Case etc[] = {
    { "Hash_Short_Key", eina_bench_crc_hash_short, EINA_TRUE },
    { "Hash_Medium_Key", eina_bench_crc_hash_medium, EINA_TRUE },
    { "Hash_Large_key", eina_bench_crc_hash_large, EINA_TRUE },
+   { "Hash_Huge_Key", eina_bench_crc_hash_huge, EINA_TRUE },
+   { "Hash_Path_Key", eina_bench_crc_hash_path, EINA_TRUE },
    { "Array vs List vs Inlist", eina_bench_array, EINA_TRUE },
    { "Stringshare", eina_bench_stringshare, EINA_TRUE },
    { "Convert", eina_bench_convert, EINA_TRUE },
    { "Sort", eina_bench_sort, EINA_TRUE },
    { "Mempool", eina_bench_mempool, EINA_TRUE },
    { "Rectangle_Pool", eina_bench_rectangle_pool, EINA_TRUE },
+   { "String", eina_bench_str, EINA_TRUE },
+   { "Cow", eina_bench_cow, EINA_TRUE },
+   { "Tiler", eina_bench_tiler, EINA_TRUE },
+   { "Value", eina_bench_value, EINA_TRUE },
    { "Render Loop", eina_bench_quadtree, EINA_FALSE },
    { NULL, NULL, EINA_FALSE }
 };
@@ -27,6 +27,8 @@ void eina_bench_hash(Eina_Benchmark *bench);
 void eina_bench_crc_hash_short(Eina_Benchmark *bench);
 void eina_bench_crc_hash_medium(Eina_Benchmark *bench);
 void eina_bench_crc_hash_large(Eina_Benchmark *bench);
+void eina_bench_crc_hash_huge(Eina_Benchmark *bench);
+void eina_bench_crc_hash_path(Eina_Benchmark *bench);
 void eina_bench_array(Eina_Benchmark *bench);
 void eina_bench_stringshare(Eina_Benchmark *bench);
 void eina_bench_convert(Eina_Benchmark *bench);
@@ -35,6 +37,10 @@ void eina_bench_mempool(Eina_Benchmark *bench);
 void eina_bench_rectangle_pool(Eina_Benchmark *bench);
 void eina_bench_quadtree(Eina_Benchmark *bench);
 void eina_bench_promise(Eina_Benchmark *bench);
+void eina_bench_str(Eina_Benchmark *bench);
+void eina_bench_cow(Eina_Benchmark *bench);
+void eina_bench_tiler(Eina_Benchmark *bench);
+void eina_bench_value(Eina_Benchmark *bench);
 
 /* Specific benchmark. */
 void eina_bench_e17(void);
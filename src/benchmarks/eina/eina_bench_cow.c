@@ -0,0 +1,102 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+/*
+ * A frame where every object of a canvas moves: each one gets a writable
+ * copy of its state, changes its geometry and hands it back for gc, then
+ * the pool is collected. "shared" objects only move between a few
+ * positions, so most of them end up merged back by the gc.
+ */
+
+#define FRAMES 10
+
+typedef struct _Bench_State Bench_State;
+struct _Bench_State
+{
+   int x, y, w, h;
+   int clip_x, clip_y, clip_w, clip_h;
+   double scale;
+   unsigned char color[4];
+   unsigned int layer;
+   void *clipper;
+   void *map;
+   Eina_Bool visible : 1;
+   Eina_Bool have_clipees : 1;
+   Eina_Bool anti_alias : 1;
+   int pad[12];
+};
+
+static const Bench_State default_state = {
+   0, 0, 0, 0, -100000, -100000, 200000, 200000, 1.0, { 255, 255, 255, 255 },
+   0, NULL, NULL, EINA_FALSE, EINA_FALSE, EINA_FALSE, { 0 }
+};
+
+static void
+_cow_frames(int request, int positions, Eina_Bool gc)
+{
+   const Bench_State **objs;
+   Eina_Cow *cow;
+   int f, i;
+
+   cow = eina_cow_add("bench", sizeof (Bench_State), 64, &default_state, gc);
+   objs = malloc(sizeof (Bench_State *) * request);
+   for (i = 0; i < request; i++)
+     objs[i] = eina_cow_alloc(cow);
+
+   for (f = 0; f < FRAMES; f++)
+     {
+        for (i = 0; i < request; i++)
+          {
+             EINA_COW_WRITE_BEGIN(cow, objs[i], Bench_State, state)
+               {
+                  state->x = (i + f) % positions;
+                  state->y = 10;
+                  state->w = 32;
+                  state->h = 32;
+                  state->visible = EINA_TRUE;
+               }
+             EINA_COW_WRITE_END(cow, objs[i], state);
+          }
+        while (eina_cow_gc(cow))
+          ;
+     }
+
+   for (i = 0; i < request; i++)
+     eina_cow_free(cow, (const Eina_Cow_Data **) &objs[i]);
+   free(objs);
+   eina_cow_del(cow);
+}
+
+static void
+eina_bench_cow_move(int request)
+{
+   _cow_frames(request, request, EINA_TRUE);
+}
+
+static void
+eina_bench_cow_move_shared(int request)
+{
+   _cow_frames(request, 8, EINA_TRUE);
+}
+
+static void
+eina_bench_cow_move_nogc(int request)
+{
+   _cow_frames(request, request, EINA_FALSE);
+}
+
+void eina_bench_cow(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "move",
+                           EINA_BENCHMARK(eina_bench_cow_move), 100, 20000, 500);
+   eina_benchmark_register(bench, "move shared",
+                           EINA_BENCHMARK(eina_bench_cow_move_shared), 100, 20000, 500);
+   eina_benchmark_register(bench, "move without gc",
+                           EINA_BENCHMARK(eina_bench_cow_move_nogc), 100, 20000, 500);
+}
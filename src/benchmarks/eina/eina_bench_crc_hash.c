@@ -71,6 +71,22 @@ eina_bench_cityhash(int request)
 }
 #endif
 
+static void
+eina_bench_fast_hash(int request)
+{
+   unsigned int i;
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        char tmp_key[key_size];
+
+        eina_convert_itoa(i, tmp_key);
+        eina_strlcat(tmp_key, key_str, key_size);
+
+        eina_hash_fast(tmp_key, key_size);
+     }
+}
+
 static void
 eina_bench_superfast_hash(int request)
 {
@@ -182,6 +198,9 @@ void eina_bench_crc_hash_short(Eina_Benchmark *bench)
    key_size -= 5;
    repchar(key_size);
 
+   eina_benchmark_register(bench, "fast-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_fast_hash),        10, 80000, 10);
    eina_benchmark_register(bench, "superfast-lookup",
                            EINA_BENCHMARK(
                               eina_bench_superfast_hash),   10, 80000, 10);
@@ -216,6 +235,9 @@ void eina_bench_crc_hash_medium(Eina_Benchmark *bench)
    key_size -= 5;
    repchar(key_size);
 
+   eina_benchmark_register(bench, "fast-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_fast_hash),        10, 80000, 10);
    eina_benchmark_register(bench, "superfast-lookup",
                            EINA_BENCHMARK(
                               eina_bench_superfast_hash),   10, 80000, 10);
@@ -250,6 +272,9 @@ void eina_bench_crc_hash_large(Eina_Benchmark *bench)
    key_size -= 5;
    repchar(key_size);
 
+   eina_benchmark_register(bench, "fast-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_fast_hash),        10, 80000, 10);
    eina_benchmark_register(bench, "superfast-lookup",
                            EINA_BENCHMARK(
                               eina_bench_superfast_hash),   10, 80000, 10);
@@ -277,3 +302,186 @@ void eina_bench_crc_hash_large(Eina_Benchmark *bench)
                            EINA_BENCHMARK(
                               eina_bench_evas_hash),        10, 80000, 10);
 }
+
+void eina_bench_crc_hash_huge(Eina_Benchmark *bench)
+{
+   key_size = 4096; /* Long enough for the vector path of eina_hash_fast */
+   key_size -= 5;
+   repchar(key_size);
+
+   eina_benchmark_register(bench, "fast-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_fast_hash),   10, 2000, 20);
+   eina_benchmark_register(bench, "superfast-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_superfast_hash),   10, 2000, 20);
+   eina_benchmark_register(bench, "djb2-lookup",
+                           EINA_BENCHMARK(
+                             eina_bench_djb2_hash),   10, 2000, 20);
+   eina_benchmark_register(bench, "murmur",
+                           EINA_BENCHMARK(
+                              eina_bench_murmur_hash),   10, 2000, 20);
+   eina_benchmark_register(bench, "crchash",
+                           EINA_BENCHMARK(
+			      eina_bench_crchash),   10, 2000, 20);
+#ifdef CITYHASH_BENCH
+   eina_benchmark_register(bench, "cityhash",
+                           EINA_BENCHMARK(
+                              eina_bench_cityhash),   10, 2000, 20);
+#endif
+}
+
+/*
+ * Theme groups and file paths share long prefixes and only differ in a few
+ * bytes, the case where weak hashes pile up in the same buckets. The lookup
+ * benchmarks run each hash on the same Eina_Hash with such keys, and the
+ * distribution of every hash over them is printed when the group is set up.
+ */
+#define PATH_KEYS 20000
+
+static char **path_keys = NULL;
+
+static void
+_path_keys_init(void)
+{
+   static const char *dirs[] = {
+      "/usr/share/elementary/themes/default.edj",
+      "/usr/local/share/icons/hicolor/scalable/apps",
+      "/home/user/.config/enlightenment/themes/dark.edj",
+      "/usr/share/elementary/images"
+   };
+   static const char *groups[] = {
+      "elm/button/base", "elm/genlist/item/double_label",
+      "elm/entry/cursor", "e/widgets/border/default", "elm/icon"
+   };
+   char buf[256];
+   unsigned int i;
+
+   if (path_keys) return;
+   path_keys = malloc(sizeof (char *) * PATH_KEYS);
+   for (i = 0; i < PATH_KEYS; i++)
+     {
+        snprintf(buf, sizeof (buf), "%s:%s/style-%u/%s",
+                 dirs[i % EINA_C_ARRAY_LENGTH(dirs)],
+                 groups[(i / 4) % EINA_C_ARRAY_LENGTH(groups)],
+                 i / 20, (i & 1) ? "default" : "focused");
+        path_keys[i] = strdup(buf);
+     }
+}
+
+static unsigned int
+_path_key_length(const char *key)
+{
+   return strlen(key) + 1;
+}
+
+static int
+_path_key_cmp(const char *key1, int key1_length,
+              const char *key2, int key2_length)
+{
+   int delta;
+
+   delta = key1_length - key2_length;
+   if (delta) return delta;
+   return strcmp(key1, key2);
+}
+
+static int
+_path_key_cmp_int(const void *a, const void *b)
+{
+   int x = *(const int *)a, y = *(const int *)b;
+
+   return (x > y) - (x < y);
+}
+
+static void
+_path_keys_report(const char *name, Eina_Key_Hash cb)
+{
+   unsigned int buckets[256] = { 0 };
+   unsigned int i, dup = 0, worst = 0;
+   int *hashes;
+
+   hashes = malloc(sizeof (int) * PATH_KEYS);
+   for (i = 0; i < PATH_KEYS; i++)
+     {
+        hashes[i] = cb(path_keys[i], _path_key_length(path_keys[i]));
+        buckets[hashes[i] & 0xff]++;
+     }
+   qsort(hashes, PATH_KEYS, sizeof (int), _path_key_cmp_int);
+   for (i = 1; i < PATH_KEYS; i++)
+     if (hashes[i] == hashes[i - 1]) dup++;
+   for (i = 0; i < 256; i++)
+     if (buckets[i] > worst) worst = buckets[i];
+   fprintf(stderr, "%-10s %u keys: %u 32bits collisions, fullest of 256 buckets %u (ideal %u)\n",
+           name, PATH_KEYS, dup, worst, PATH_KEYS / 256);
+   free(hashes);
+}
+
+static void
+_path_lookup(int request, Eina_Key_Hash cb)
+{
+   Eina_Hash *hash;
+   int i, r;
+
+   if (request > PATH_KEYS) request = PATH_KEYS;
+   hash = eina_hash_new(EINA_KEY_LENGTH(_path_key_length),
+                        EINA_KEY_CMP(_path_key_cmp),
+                        cb, NULL, 8);
+   for (i = 0; i < request; i++)
+     eina_hash_direct_add(hash, path_keys[i], path_keys[i]);
+   for (r = 0; r < 10; r++)
+     for (i = 0; i < request; i++)
+       eina_hash_find(hash, path_keys[i]);
+   eina_hash_free(hash);
+}
+
+static void
+eina_bench_path_fast(int request)
+{
+   _path_lookup(request, EINA_KEY_HASH(eina_hash_fast));
+}
+
+static void
+eina_bench_path_superfast(int request)
+{
+   _path_lookup(request, EINA_KEY_HASH(eina_hash_superfast));
+}
+
+static void
+eina_bench_path_djb2(int request)
+{
+   _path_lookup(request, EINA_KEY_HASH(eina_hash_djb2));
+}
+
+static void
+eina_bench_path_murmur(int request)
+{
+   _path_lookup(request, EINA_KEY_HASH(eina_hash_murmur3));
+}
+
+static void
+eina_bench_path_crc(int request)
+{
+   _path_lookup(request, EINA_KEY_HASH(eina_hash_crc));
+}
+
+void eina_bench_crc_hash_path(Eina_Benchmark *bench)
+{
+   _path_keys_init();
+   _path_keys_report("fast", EINA_KEY_HASH(eina_hash_fast));
+   _path_keys_report("superfast", EINA_KEY_HASH(eina_hash_superfast));
+   _path_keys_report("djb2", EINA_KEY_HASH(eina_hash_djb2));
+   _path_keys_report("murmur", EINA_KEY_HASH(eina_hash_murmur3));
+   _path_keys_report("crc", EINA_KEY_HASH(eina_hash_crc));
+
+   eina_benchmark_register(bench, "fast-lookup",
+                           EINA_BENCHMARK(eina_bench_path_fast), 1000, PATH_KEYS, 1900);
+   eina_benchmark_register(bench, "superfast-lookup",
+                           EINA_BENCHMARK(eina_bench_path_superfast), 1000, PATH_KEYS, 1900);
+   eina_benchmark_register(bench, "djb2-lookup",
+                           EINA_BENCHMARK(eina_bench_path_djb2), 1000, PATH_KEYS, 1900);
+   eina_benchmark_register(bench, "murmur",
+                           EINA_BENCHMARK(eina_bench_path_murmur), 1000, PATH_KEYS, 1900);
+   eina_benchmark_register(bench, "crchash",
+                           EINA_BENCHMARK(eina_bench_path_crc), 1000, PATH_KEYS, 1900);
+}
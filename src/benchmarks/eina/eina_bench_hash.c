@@ -319,6 +319,109 @@ eina_bench_lookup_djb2(int request)
    eina_hash_free(hash);
 }
 
+static void
+eina_bench_lookup_superfast_open(int request)
+{
+   Eina_Hash *hash = NULL;
+   int *tmp_val;
+   unsigned int i;
+   unsigned int j;
+
+   hash = eina_hash_backend_new(EINA_HASH_BACKEND_OPEN,
+                                EINA_KEY_LENGTH(_eina_string_key_length),
+                                EINA_KEY_CMP(_eina_string_key_cmp),
+                                EINA_KEY_HASH(eina_hash_superfast),
+                                free,
+                                8);
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        char tmp_key[10];
+
+        tmp_val = malloc(sizeof (int));
+
+        if (!tmp_val)
+           continue;
+
+        eina_convert_itoa(i, tmp_key);
+        *tmp_val = i;
+
+        eina_hash_add(hash, tmp_key, tmp_val);
+     }
+
+   srand(time(NULL));
+
+   for (j = 0; j < 200; ++j)
+      for (i = 0; i < (unsigned int)request; ++i)
+        {
+           char tmp_key[10];
+
+           eina_convert_itoa(rand() % request, tmp_key);
+           tmp_val = eina_hash_find(hash, tmp_key);
+        }
+
+   eina_hash_free(hash);
+}
+
+static void
+_eina_bench_lookup_pointer(Eina_Hash_Backend backend, int request)
+{
+   Eina_Hash *hash = NULL;
+   void **keys;
+   unsigned int i;
+   unsigned int j;
+
+   eina_hash_backend_default_set(backend);
+   hash = eina_hash_pointer_new(NULL);
+   eina_hash_backend_default_set(EINA_HASH_BACKEND_RBTREE);
+
+   keys = malloc(sizeof (void *) * request);
+   if (!keys) goto end;
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        keys[i] = malloc(16);
+        eina_hash_add(hash, &keys[i], keys[i]);
+     }
+
+   srand(time(NULL));
+
+   for (j = 0; j < 200; ++j)
+      for (i = 0; i < (unsigned int)request; ++i)
+        {
+           void *tmp;
+
+           tmp = eina_hash_find(hash, &keys[rand() % request]);
+           (void) tmp;
+        }
+
+   /* Churn, like callbacks or objects coming and going. */
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        eina_hash_del(hash, &keys[i], keys[i]);
+        eina_hash_add(hash, &keys[i], keys[i]);
+     }
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     free(keys[i]);
+   free(keys);
+
+ end:
+   eina_hash_free(hash);
+}
+
+static void
+eina_bench_lookup_pointer(int request)
+{
+   _eina_bench_lookup_pointer(EINA_HASH_BACKEND_RBTREE, request);
+}
+
+static void
+eina_bench_lookup_pointer_open(int request)
+{
+   _eina_bench_lookup_pointer(EINA_HASH_BACKEND_OPEN, request);
+}
+
 typedef struct _Eina_Bench_DJB2 Eina_Bench_DJB2;
 struct _Eina_Bench_DJB2
 {
@@ -369,6 +472,54 @@ eina_bench_lookup_djb2_inline(int request)
    eina_hash_free(hash);
 }
 
+static void
+eina_bench_lookup_djb2_inline_open(int request)
+{
+   Eina_Hash *hash = NULL;
+   Eina_Bench_DJB2 *elm;
+   unsigned int i;
+   unsigned int j;
+
+   hash = eina_hash_backend_new(EINA_HASH_BACKEND_OPEN,
+                                EINA_KEY_LENGTH(_eina_string_key_length),
+                                EINA_KEY_CMP(_eina_string_key_cmp),
+                                EINA_KEY_HASH(eina_hash_djb2),
+                                free,
+                                8);
+
+   for (i = 0; i < (unsigned int)request; ++i)
+     {
+        int length;
+
+        elm = malloc(sizeof (Eina_Bench_DJB2) + 10);
+        if (!elm)
+           continue;
+
+        elm->key = (char *)(elm + 1);
+
+        length = eina_convert_itoa(i, elm->key) + 1;
+        elm->value = i;
+
+        eina_hash_direct_add_by_hash(hash, elm->key, length,
+                                     eina_hash_djb2(elm->key, length), elm);
+     }
+
+   srand(time(NULL));
+
+   for (j = 0; j < 200; ++j)
+      for (i = 0; i < (unsigned int)request; ++i)
+        {
+           char tmp_key[10];
+           int length = eina_convert_itoa(rand() % request, tmp_key) + 1;
+
+           elm =
+              eina_hash_find_by_hash(hash, tmp_key, length,
+                                     eina_hash_djb2(tmp_key, length));
+        }
+
+   eina_hash_free(hash);
+}
+
 #ifdef EINA_BENCH_HAVE_GLIB
 typedef struct _Eina_Bench_Glib Eina_Bench_Glib;
 struct _Eina_Bench_Glib
@@ -525,6 +676,18 @@ void eina_bench_hash(Eina_Benchmark *bench)
    eina_benchmark_register(bench, "djb2-lookup-inline",
                            EINA_BENCHMARK(
                               eina_bench_lookup_djb2_inline), 10, 10000, 10);
+   eina_benchmark_register(bench, "superfast-lookup-open",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_superfast_open), 10, 10000, 10);
+   eina_benchmark_register(bench, "djb2-lookup-inline-open",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_djb2_inline_open), 10, 10000, 10);
+   eina_benchmark_register(bench, "pointer-lookup",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_pointer),     10, 10000, 10);
+   eina_benchmark_register(bench, "pointer-lookup-open",
+                           EINA_BENCHMARK(
+                              eina_bench_lookup_pointer_open), 10, 10000, 10);
    eina_benchmark_register(bench, "murmur",
                            EINA_BENCHMARK(
                               eina_bench_lookup_murmur),      10, 10000, 10);
@@ -20,6 +20,8 @@
 # include "config.h"
 #endif
 
+#include <stdlib.h>
+
 #ifdef EINA_BENCH_HAVE_GLIB
 # include <glib.h>
 #endif
@@ -54,6 +56,104 @@ _eina_mempool_bench(Eina_Mempool *mp, int request)
    eina_shutdown();
 }
 
+#define EINA_BENCH_MEMPOOL_THREADS 4
+
+typedef struct _Eina_Bench_Mempool_Thread Eina_Bench_Mempool_Thread;
+struct _Eina_Bench_Mempool_Thread
+{
+   Eina_Thread thread;
+   Eina_Mempool *mp;
+   int request;
+};
+
+static void *
+_eina_mempool_bench_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Eina_Bench_Mempool_Thread *bt = data;
+   void **items;
+   int i;
+   int j;
+
+   items = malloc(bt->request * sizeof (void *));
+   if (!items) return NULL;
+
+   for (i = 0; i < 100; ++i)
+     {
+        for (j = 0; j < bt->request; ++j)
+          items[j] = eina_mempool_malloc(bt->mp, sizeof (int));
+
+        for (j = 0; j < bt->request; ++j)
+          eina_mempool_free(bt->mp, items[j]);
+     }
+
+   free(items);
+   return NULL;
+}
+
+static void
+_eina_mempool_threads_bench(const char *name, int request)
+{
+   Eina_Bench_Mempool_Thread bt[EINA_BENCH_MEMPOOL_THREADS];
+   Eina_Mempool *mp;
+   unsigned int i, started;
+
+   eina_init();
+   eina_threads_init();
+
+   mp = eina_mempool_add(name, "test", NULL, sizeof (int), 256);
+
+   // every thread churns the same pool, splitting the work of the single
+   // threaded benchmark so the numbers can be compared
+   for (started = 0; started < EINA_BENCH_MEMPOOL_THREADS; ++started)
+     {
+        bt[started].mp = mp;
+        bt[started].request = request / EINA_BENCH_MEMPOOL_THREADS + 1;
+        if (!eina_thread_create(&bt[started].thread, EINA_THREAD_NORMAL, -1,
+                                _eina_mempool_bench_thread, &bt[started]))
+          break;
+     }
+
+   for (i = 0; i < started; ++i)
+     eina_thread_join(bt[i].thread);
+
+   eina_mempool_del(mp);
+
+   eina_threads_shutdown();
+   eina_shutdown();
+}
+
+#ifdef EINA_BUILD_CHAINED_POOL
+static void
+eina_mempool_chained_mempool_threads(int request)
+{
+   _eina_mempool_threads_bench("chained_mempool", request);
+}
+
+static void
+eina_mempool_chained_magazine(int request)
+{
+   Eina_Mempool *mp;
+
+   mp = eina_mempool_add("chained_magazine", "test", NULL, sizeof (int), 256);
+   _eina_mempool_bench(mp, request);
+   eina_mempool_del(mp);
+}
+
+static void
+eina_mempool_chained_magazine_threads(int request)
+{
+   _eina_mempool_threads_bench("chained_magazine", request);
+}
+#endif
+
+#ifdef EINA_BUILD_PASS_THROUGH
+static void
+eina_mempool_pass_through_threads(int request)
+{
+   _eina_mempool_threads_bench("pass_through", request);
+}
+#endif
+
 #ifdef EINA_BUILD_CHAINED_POOL
 static void
 eina_mempool_chained_mempool(int request)
@@ -78,6 +178,57 @@ eina_mempool_pass_through(int request)
 }
 #endif
 
+/* Eo like pattern: many objects of a handful of different sizes. */
+static void
+_eina_mempool_sizes_bench(Eina_Mempool *mp, int request)
+{
+   static const unsigned int sizes[] = { 24, 72, 136, 200, 488, 1096 };
+   Eina_Array *array;
+   int i;
+   int j;
+
+   eina_init();
+   array = eina_array_new(32);
+
+   for (i = 0; i < 100; ++i)
+     {
+        for (j = 0; j < request; ++j)
+          {
+             unsigned int size = sizes[(i + j) % EINA_C_ARRAY_LENGTH(sizes)];
+
+             if (mp) eina_array_push(array, eina_mempool_malloc(mp, size));
+             else eina_array_push(array, malloc(size));
+          }
+
+        for (j = 0; j < request; ++j)
+          {
+             if (mp) eina_mempool_free(mp, eina_array_pop(array));
+             else free(eina_array_pop(array));
+          }
+     }
+
+   eina_array_free(array);
+   eina_shutdown();
+}
+
+#ifdef EINA_BUILD_SLAB
+static void
+eina_mempool_slab(int request)
+{
+   Eina_Mempool *mp;
+
+   mp = eina_mempool_add("slab", "test", NULL);
+   _eina_mempool_sizes_bench(mp, request);
+   eina_mempool_del(mp);
+}
+#endif
+
+static void
+eina_mempool_malloc_sizes(int request)
+{
+   _eina_mempool_sizes_bench(NULL, request);
+}
+
 #ifdef EINA_BENCH_HAVE_GLIB
 static void
 eina_mempool_glib(int request)
@@ -115,12 +266,32 @@ eina_bench_mempool(Eina_Benchmark *bench)
    eina_benchmark_register(bench, "chained mempool",
                            EINA_BENCHMARK(
                               eina_mempool_chained_mempool), 10, 10000, 10);
+   eina_benchmark_register(bench, "chained mempool (threads)",
+                           EINA_BENCHMARK(
+                              eina_mempool_chained_mempool_threads), 10, 10000, 10);
+   eina_benchmark_register(bench, "chained magazine",
+                           EINA_BENCHMARK(
+                              eina_mempool_chained_magazine), 10, 10000, 10);
+   eina_benchmark_register(bench, "chained magazine (threads)",
+                           EINA_BENCHMARK(
+                              eina_mempool_chained_magazine_threads), 10, 10000, 10);
 #endif
 #ifdef EINA_BUILD_PASS_THROUGH
    eina_benchmark_register(bench, "pass through",
                            EINA_BENCHMARK(
                               eina_mempool_pass_through),    10, 10000, 10);
+   eina_benchmark_register(bench, "pass through (threads)",
+                           EINA_BENCHMARK(
+                              eina_mempool_pass_through_threads), 10, 10000, 10);
 #endif
+#ifdef EINA_BUILD_SLAB
+   eina_benchmark_register(bench, "slab (mixed sizes)",
+                           EINA_BENCHMARK(
+                              eina_mempool_slab),            10, 10000, 10);
+#endif
+   eina_benchmark_register(bench, "malloc (mixed sizes)",
+                           EINA_BENCHMARK(
+                              eina_mempool_malloc_sizes),    10, 10000, 10);
 #ifdef EINA_BENCH_HAVE_GLIB
    eina_benchmark_register(bench, "gslice",
                            EINA_BENCHMARK(
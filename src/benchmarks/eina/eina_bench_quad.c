@@ -25,6 +25,7 @@
 #include "eina_mempool.h"
 #include "eina_rectangle.h"
 #include "eina_quadtree.h"
+#include "eina_rtree.h"
 #include "eina_list.h"
 #include "eina_bench.h"
 
@@ -308,6 +309,82 @@ eina_bench_quadtree_render_loop(int request)
    eina_shutdown();
 }
 
+static void
+eina_bench_rtree_render_loop(int request)
+{
+   Eina_Rectangle *rects;
+   Eina_Inarray found;
+   Eina_Rectangle collide;
+   Eina_Rtree *t;
+   unsigned int *id;
+   int i;
+   int j;
+
+   eina_init();
+
+   rects = malloc(request * sizeof (Eina_Rectangle));
+   if (!rects) goto end;
+
+   for (i = 0; i < request; ++i)
+      EINA_RECTANGLE_SET(&rects[i],
+                         (rand() * WIDTH) / RAND_MAX,
+                         (rand() * HEIGHT) / RAND_MAX,
+                         (rand() * WIDTH / 2) / RAND_MAX,
+                         (rand() * HEIGHT / 2) / RAND_MAX);
+
+   t = eina_rtree_new();
+   eina_rtree_load(t, rects, NULL, request);
+   eina_inarray_step_set(&found, sizeof (found),
+                         sizeof (unsigned int), 64);
+
+   for (j = 0; j < 100; ++j)
+     {
+        int changed;
+
+        /* Do one collide search */
+        EINA_RECTANGLE_SET(&collide,
+                           (rand() * WIDTH) / RAND_MAX,
+                           (rand() * HEIGHT) / RAND_MAX,
+                           (rand() * WIDTH / 4) / RAND_MAX,
+                           (rand() * HEIGHT / 4) / RAND_MAX);
+        eina_rtree_collide(t, &collide, &found);
+        eina_inarray_resize(&found, 0);
+
+        /* Modify 50% of all objects, the order does not matter here */
+        changed = request * 50 / 100;
+        for (i = 0; i < changed; ++i)
+          {
+             Eina_Rectangle *r = &rects[rand() % request];
+
+             r->x = (rand() * WIDTH) / RAND_MAX;
+             r->y = (rand() * HEIGHT) / RAND_MAX;
+             r->w = (rand() * WIDTH / 3) / RAND_MAX;
+             r->h = (rand() * HEIGHT / 3) / RAND_MAX;
+
+             eina_rtree_update(t, r - rects, r);
+          }
+
+        /* Emulating the render loop by colliding the modified
+           objects with all intersecting object */
+        for (i = 0; i < changed; ++i)
+          {
+             Eina_Rectangle *r = &rects[rand() % request];
+
+             eina_rtree_collide(t, r, &found);
+             EINA_INARRAY_FOREACH(&found, id)
+               (void) eina_rtree_data_get(t, *id);
+             eina_inarray_resize(&found, 0);
+          }
+     }
+
+   eina_inarray_flush(&found);
+   eina_rtree_free(t);
+   free(rects);
+
+ end:
+   eina_shutdown();
+}
+
 void
 eina_bench_quadtree(Eina_Benchmark *bench)
 {
@@ -317,4 +394,7 @@ eina_bench_quadtree(Eina_Benchmark *bench)
    eina_benchmark_register(bench, "collide-quad-tree",
                            EINA_BENCHMARK(eina_bench_quadtree_render_loop),
                            100, 1500, 50);
+   eina_benchmark_register(bench, "collide-r-tree",
+                           EINA_BENCHMARK(eina_bench_rtree_render_loop),
+                           100, 1500, 50);
 }
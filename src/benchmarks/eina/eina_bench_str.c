@@ -0,0 +1,210 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+/*
+ * The byte at a time cases are what eina did before it got vector paths,
+ * run with EINA_CPU_NO_SSE2=1 EINA_CPU_NO_AVX2=1 (or EINA_CPU_NO_NEON=1)
+ * to get the scalar fallback of the eina cases.
+ */
+
+#define ROUNDS 10
+
+/* Mostly ascii with some latin, greek and cjk, like a translated ui. */
+static char *
+_bench_text_new(int request)
+{
+   static const char *words[] = {
+      "window ", "button ", "fen\xC3\xAAtre ", "\xCE\xBA\xCE\xBF\xCF\x85\xCE\xBC\xCF\x80\xCE\xAF ",
+      "list ", "\xE7\xAA\x97\xE5\x8F\xA3 ", "the \"label\" ", "entry\n"
+   };
+   char *text;
+   int len = 0;
+   unsigned int i = 0;
+
+   text = malloc(request + 16);
+   if (!text) return NULL;
+   while (len < request)
+     {
+        const char *w = words[(i++ * 7) % EINA_C_ARRAY_LENGTH(words)];
+        int l = strlen(w);
+
+        memcpy(text + len, w, l);
+        len += l;
+     }
+   text[request] = '\0';
+   /* do not leave a cut sequence at the end */
+   while ((request > 0) && ((unsigned char)text[request - 1] >= 0x80))
+     text[--request] = '\0';
+   return text;
+}
+
+static void
+eina_bench_str_utf8_len(int request)
+{
+   char *text = _bench_text_new(request);
+   int r;
+
+   for (r = 0; r < ROUNDS; r++)
+     eina_unicode_utf8_get_len(text);
+   free(text);
+}
+
+static void
+eina_bench_str_utf8_len_bytewise(int request)
+{
+   char *text = _bench_text_new(request);
+   int r, ind, len;
+
+   for (r = 0; r < ROUNDS; r++)
+     for (ind = 0, len = 0; eina_unicode_utf8_next_get(text, &ind); len++) ;
+   free(text);
+}
+
+static void
+eina_bench_str_utf8_to_unicode(int request)
+{
+   char *text = _bench_text_new(request);
+   int r;
+
+   for (r = 0; r < ROUNDS; r++)
+     free(eina_unicode_utf8_to_unicode(text, NULL));
+   free(text);
+}
+
+static void
+eina_bench_str_utf8_to_unicode_bytewise(int request)
+{
+   char *text = _bench_text_new(request);
+   Eina_Unicode *uni;
+   int r, ind, i;
+
+   uni = malloc(sizeof (Eina_Unicode) * (request + 1));
+   for (r = 0; r < ROUNDS; r++)
+     {
+        for (ind = 0, i = 0; (uni[i] = eina_unicode_utf8_next_get(text, &ind)); i++) ;
+     }
+   free(uni);
+   free(text);
+}
+
+static void
+eina_bench_str_escape(int request)
+{
+   char *text = _bench_text_new(request);
+   int r;
+
+   for (r = 0; r < ROUNDS; r++)
+     free(eina_str_escape(text));
+   free(text);
+}
+
+static char *
+_escape_bytewise(const char *str)
+{
+   char *s2, *d;
+   const char *s;
+
+   s2 = malloc((strlen(str) * 2) + 1);
+   for (s = str, d = s2; *s; s++)
+     {
+        switch (*s)
+          {
+           case ' ': case '\\': case '\'': case '\"':
+             *d++ = '\\';
+             *d++ = *s;
+             break;
+           case '\n':
+             *d++ = '\\';
+             *d++ = 'n';
+             break;
+           case '\t':
+             *d++ = '\\';
+             *d++ = 't';
+             break;
+           default:
+             *d++ = *s;
+          }
+     }
+   *d = 0;
+   return s2;
+}
+
+static void
+eina_bench_str_escape_bytewise(int request)
+{
+   char *text = _bench_text_new(request);
+   int r;
+
+   for (r = 0; r < ROUNDS; r++)
+     free(_escape_bytewise(text));
+   free(text);
+}
+
+static void
+eina_bench_str_strbuf_replace_all(int request)
+{
+   char *text = _bench_text_new(request);
+   Eina_Strbuf *buf;
+   int r;
+
+   buf = eina_strbuf_new();
+   for (r = 0; r < ROUNDS; r++)
+     {
+        eina_strbuf_reset(buf);
+        eina_strbuf_append(buf, text);
+        eina_strbuf_replace_all(buf, "button", "toggle_button");
+     }
+   eina_strbuf_free(buf);
+   free(text);
+}
+
+/* strstr() per match and an append per piece, the usual hand made loop */
+static void
+eina_bench_str_strbuf_replace_strstr(int request)
+{
+   char *text = _bench_text_new(request);
+   Eina_Strbuf *buf;
+   const char *p, *m;
+   int r;
+
+   buf = eina_strbuf_new();
+   for (r = 0; r < ROUNDS; r++)
+     {
+        eina_strbuf_reset(buf);
+        for (p = text; (m = strstr(p, "button")); p = m + 6)
+          {
+             eina_strbuf_append_length(buf, p, m - p);
+             eina_strbuf_append_length(buf, "toggle_button", 13);
+          }
+        eina_strbuf_append(buf, p);
+     }
+   eina_strbuf_free(buf);
+   free(text);
+}
+
+void eina_bench_str(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "utf8_get_len",
+                           EINA_BENCHMARK(eina_bench_str_utf8_len), 1000, 100000, 4950);
+   eina_benchmark_register(bench, "utf8_get_len bytewise",
+                           EINA_BENCHMARK(eina_bench_str_utf8_len_bytewise), 1000, 100000, 4950);
+   eina_benchmark_register(bench, "utf8_to_unicode",
+                           EINA_BENCHMARK(eina_bench_str_utf8_to_unicode), 1000, 100000, 4950);
+   eina_benchmark_register(bench, "utf8_to_unicode bytewise",
+                           EINA_BENCHMARK(eina_bench_str_utf8_to_unicode_bytewise), 1000, 100000, 4950);
+   eina_benchmark_register(bench, "str_escape",
+                           EINA_BENCHMARK(eina_bench_str_escape), 1000, 100000, 4950);
+   eina_benchmark_register(bench, "str_escape bytewise",
+                           EINA_BENCHMARK(eina_bench_str_escape_bytewise), 1000, 100000, 4950);
+   eina_benchmark_register(bench, "strbuf_replace_all",
+                           EINA_BENCHMARK(eina_bench_str_strbuf_replace_all), 1000, 100000, 4950);
+   eina_benchmark_register(bench, "strbuf_replace strstr",
+                           EINA_BENCHMARK(eina_bench_str_strbuf_replace_strstr), 1000, 100000, 4950);
+}
@@ -35,6 +35,7 @@
 #include "eina_bench.h"
 #include "eina_convert.h"
 #include "eina_main.h"
+#include "eina_thread.h"
 
 static void
 eina_bench_stringshare_job(int request)
@@ -69,6 +70,72 @@ eina_bench_stringshare_job(int request)
    eina_shutdown();
 }
 
+#define EINA_BENCH_STRINGSHARE_THREADS 4
+
+typedef struct _Eina_Bench_Stringshare_Thread Eina_Bench_Stringshare_Thread;
+struct _Eina_Bench_Stringshare_Thread
+{
+   Eina_Thread thread;
+   unsigned int seed;
+   int request;
+};
+
+static void *
+_eina_bench_stringshare_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Eina_Bench_Stringshare_Thread *bt = data;
+   const char **held;
+   unsigned int j;
+   int i;
+
+   held = calloc(bt->request, sizeof (const char *));
+   if (!held) return NULL;
+
+   /* every thread works on the same set of keys, like parallel loaders
+    * resolving the same file, group and part names */
+   for (j = 0; j < 50; ++j)
+      for (i = 0; i < bt->request; ++i)
+        {
+           char build[64] = "string_";
+           int k = rand_r(&bt->seed) % bt->request;
+
+           eina_convert_xtoa(k, build + 7);
+           eina_stringshare_del(held[k]);
+           held[k] = eina_stringshare_add(build);
+        }
+
+   for (i = 0; i < bt->request; ++i)
+      eina_stringshare_del(held[i]);
+   free(held);
+
+   return NULL;
+}
+
+static void
+eina_bench_stringshare_threads_job(int request)
+{
+   Eina_Bench_Stringshare_Thread bt[EINA_BENCH_STRINGSHARE_THREADS];
+   unsigned int i, started;
+
+   eina_init();
+   eina_threads_init();
+
+   for (started = 0; started < EINA_BENCH_STRINGSHARE_THREADS; ++started)
+     {
+        bt[started].seed = started + 1;
+        bt[started].request = request;
+        if (!eina_thread_create(&bt[started].thread, EINA_THREAD_NORMAL, -1,
+                                _eina_bench_stringshare_thread, &bt[started]))
+          break;
+     }
+
+   for (i = 0; i < started; ++i)
+      eina_thread_join(bt[i].thread);
+
+   eina_threads_shutdown();
+   eina_shutdown();
+}
+
 #ifdef EINA_BENCH_HAVE_GLIB
 static void
 eina_bench_stringchunk_job(int request)
@@ -171,6 +238,9 @@ void eina_bench_stringshare(Eina_Benchmark *bench)
    eina_benchmark_register(bench, "stringshare",
                            EINA_BENCHMARK(
                               eina_bench_stringshare_job), 100, 20100, 500);
+   eina_benchmark_register(bench, "stringshare (threads)",
+                           EINA_BENCHMARK(
+                              eina_bench_stringshare_threads_job), 100, 20100, 500);
 #ifdef EINA_BENCH_HAVE_GLIB
    eina_benchmark_register(bench, "stringchunk (glib)",
                            EINA_BENCHMARK(
@@ -0,0 +1,80 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+#define FRAMES 16
+
+/* A frame of damage: request small rectangles scattered over a 1080p
+ * output, merged with the previous frame damage like the engines do with
+ * their buffer age, then walked to redraw. */
+static void
+eina_bench_tiler_frames(int request, Eina_Tiler_Mode mode)
+{
+   Eina_Tiler *prev, *cur;
+   Eina_Iterator *it;
+   Eina_Rectangle *r;
+   unsigned int seed = 0x1234;
+   int frame, i, j;
+
+   eina_init();
+
+   prev = eina_tiler_new(1920, 1080);
+   cur = eina_tiler_new(1920, 1080);
+   eina_tiler_tile_size_set(prev, 16, 16);
+   eina_tiler_tile_size_set(cur, 16, 16);
+   eina_tiler_mode_set(prev, mode);
+   eina_tiler_mode_set(cur, mode);
+
+   for (frame = 0; frame < FRAMES; frame++)
+     {
+        for (i = 0; i < request; i++)
+          {
+             seed = seed * 1103515245 + 12345;
+             eina_tiler_rect_add(cur, &(Eina_Rectangle) {
+                                 (seed >> 8) % 1900, (seed >> 16) % 1060,
+                                 8 + (seed & 0x1f), 8 + ((seed >> 5) & 0x1f) });
+          }
+        eina_tiler_union(prev, cur);
+
+        j = 0;
+        it = eina_tiler_iterator_new(prev);
+        EINA_ITERATOR_FOREACH(it, r)
+          j += r->w * r->h;
+        eina_iterator_free(it);
+        if (j < 0) break;
+
+        eina_tiler_clear(prev);
+        eina_tiler_union(prev, cur);
+        eina_tiler_clear(cur);
+     }
+
+   eina_tiler_free(prev);
+   eina_tiler_free(cur);
+
+   eina_shutdown();
+}
+
+static void
+eina_bench_tiler_split(int request)
+{
+   eina_bench_tiler_frames(request, EINA_TILER_MODE_SPLIT);
+}
+
+static void
+eina_bench_tiler_bitmask(int request)
+{
+   eina_bench_tiler_frames(request, EINA_TILER_MODE_BITMASK);
+}
+
+void eina_bench_tiler(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "split",
+                           EINA_BENCHMARK(eina_bench_tiler_split),
+                           10, 1000, 50);
+   eina_benchmark_register(bench, "bitmask",
+                           EINA_BENCHMARK(eina_bench_tiler_bitmask),
+                           10, 1000, 50);
+}
@@ -0,0 +1,186 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "eina_bench.h"
+#include "Eina.h"
+
+#define PROPERTIES 16
+
+/* The copies and the moves are told apart by the memory they take more
+ * than by their time: malloc(), calloc() and realloc() are counted around
+ * the measured loops, where glibc lets them be wrapped. */
+#ifdef __GLIBC__
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static Eina_Bool _eina_bench_value_counting = EINA_FALSE;
+static unsigned long _eina_bench_value_allocs = 0;
+
+void *
+malloc(size_t size)
+{
+   if (_eina_bench_value_counting) _eina_bench_value_allocs++;
+   return __libc_malloc(size);
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+   if (_eina_bench_value_counting) _eina_bench_value_allocs++;
+   return __libc_calloc(nmemb, size);
+}
+
+void *
+realloc(void *ptr, size_t size)
+{
+   if (_eina_bench_value_counting) _eina_bench_value_allocs++;
+   return __libc_realloc(ptr, size);
+}
+
+static void
+_eina_bench_value_count_start(void)
+{
+   _eina_bench_value_allocs = 0;
+   _eina_bench_value_counting = EINA_TRUE;
+}
+
+static void
+_eina_bench_value_count_report(const char *name, int request)
+{
+   _eina_bench_value_counting = EINA_FALSE;
+   fprintf(stderr, "%-12s %6d requests: %8lu allocations, %.2f per request\n",
+           name, request, _eina_bench_value_allocs,
+           (double)_eina_bench_value_allocs / request);
+}
+#else
+# define _eina_bench_value_count_start()
+# define _eina_bench_value_count_report(name, request)
+#endif
+
+/* What a model does on each property fetch: find the stored value,
+ * hand out a copy of it and let the caller drop it. */
+static void
+eina_bench_value_fetch(int request, const Eina_Value_Type *type,
+                       const char *bench)
+{
+   Eina_Hash *properties;
+   Eina_Value *v;
+   char name[16];
+   int i, j;
+
+   eina_init();
+
+   properties = eina_hash_string_superfast_new(EINA_FREE_CB(eina_value_free));
+   for (i = 0; i < PROPERTIES; i++)
+     {
+        snprintf(name, sizeof (name), "property%d", i);
+        if (type == EINA_VALUE_TYPE_ARRAY)
+          {
+             v = eina_value_array_new(EINA_VALUE_TYPE_INT, 0);
+             for (j = 0; j < 4; j++)
+               eina_value_array_append(v, i + j);
+          }
+        else
+          {
+             v = eina_value_new(type);
+             eina_value_set(v, "a property value");
+          }
+        eina_hash_add(properties, name, v);
+     }
+
+   _eina_bench_value_count_start();
+   for (i = 0; i < request; i++)
+     {
+        Eina_Value *copy;
+
+        snprintf(name, sizeof (name), "property%d", i % PROPERTIES);
+        v = eina_hash_find(properties, name);
+        copy = eina_value_dup(v);
+        eina_value_free(copy);
+     }
+   _eina_bench_value_count_report(bench, request);
+
+   eina_hash_free(properties);
+
+   eina_shutdown();
+}
+
+static void
+eina_bench_value_fetch_string(int request)
+{
+   eina_bench_value_fetch(request, EINA_VALUE_TYPE_STRING, "fetch-string");
+}
+
+static void
+eina_bench_value_fetch_array(int request)
+{
+   eina_bench_value_fetch(request, EINA_VALUE_TYPE_ARRAY, "fetch-array");
+}
+
+/* Building an array of small arrays, like an a(ii) D-Bus reply is
+ * converted, either copying each member in or moving it. */
+static void
+eina_bench_value_nest(int request, Eina_Bool steal, const char *bench)
+{
+   Eina_Value *outer, *inner;
+   int i;
+
+   eina_init();
+
+   _eina_bench_value_count_start();
+   outer = eina_value_array_new(EINA_VALUE_TYPE_ARRAY, 0);
+   for (i = 0; i < request; i++)
+     {
+        inner = eina_value_array_new(EINA_VALUE_TYPE_STRING, 0);
+        eina_value_array_append(inner, "key");
+        eina_value_array_append(inner, "some value");
+
+        if (steal)
+          eina_value_array_append_steal(outer, inner);
+        else
+          {
+             Eina_Value_Array desc;
+
+             eina_value_get(inner, &desc);
+             eina_value_array_append(outer, desc);
+          }
+        eina_value_free(inner);
+     }
+   _eina_bench_value_count_report(bench, request);
+   eina_value_free(outer);
+
+   eina_shutdown();
+}
+
+static void
+eina_bench_value_nest_copy(int request)
+{
+   eina_bench_value_nest(request, EINA_FALSE, "nest-copy");
+}
+
+static void
+eina_bench_value_nest_steal(int request)
+{
+   eina_bench_value_nest(request, EINA_TRUE, "nest-steal");
+}
+
+void eina_bench_value(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "fetch-string",
+                           EINA_BENCHMARK(eina_bench_value_fetch_string),
+                           1000, 100000, 4000);
+   eina_benchmark_register(bench, "fetch-array",
+                           EINA_BENCHMARK(eina_bench_value_fetch_array),
+                           1000, 100000, 4000);
+   eina_benchmark_register(bench, "nest-copy",
+                           EINA_BENCHMARK(eina_bench_value_nest_copy),
+                           1000, 100000, 4000);
+   eina_benchmark_register(bench, "nest-steal",
+                           EINA_BENCHMARK(eina_bench_value_nest_steal),
+                           1000, 100000, 4000);
+}
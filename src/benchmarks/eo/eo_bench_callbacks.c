@@ -75,10 +75,96 @@ bench_eo_callbacks_call(int request)
      }
 }
 
+/* Objects like a widget with many children or a canvas listen to a lot of
+   different events, with a few listeners each. */
+#define EVENT_TYPES 32
+#define EVENT_LISTENERS 4
+
+static Efl_Event_Description _events[EVENT_TYPES];
+
+static Eo *
+_many_events_obj_add(void)
+{
+   Eo *obj = efl_add_ref(SIMPLE_CLASS, NULL);
+   int i, j;
+
+   for (i = 0 ; i < EVENT_TYPES ; i++)
+     {
+        _events[i].name = "bench";
+        for (j = 0 ; j < EVENT_LISTENERS ; j++)
+          efl_event_callback_priority_add(obj, &_events[i], (short) j, _cb, NULL);
+     }
+
+   return obj;
+}
+
+static void
+bench_eo_callbacks_call_many_event_types(int request)
+{
+   Eo *obj = _many_events_obj_add();
+   int i;
+
+   for (i = 0 ; i < request ; i++)
+     efl_event_callback_call(obj, &_events[i % EVENT_TYPES], NULL);
+
+   efl_unref(obj);
+}
+
+static void
+bench_eo_callbacks_call_many_event_types_miss(int request)
+{
+   Eo *obj = _many_events_obj_add();
+   int i;
+
+   for (i = 0 ; i < request ; i++)
+     efl_event_callback_call(obj, SIMPLE_BAR, NULL);
+
+   efl_unref(obj);
+}
+
+static void
+bench_eo_callbacks_call_many_listeners(int request)
+{
+   Eo *obj = _many_events_obj_add();
+   int i;
+
+   /* All of them listening to the emitted event, with no other event to skip. */
+   for (i = 0 ; i < EVENT_TYPES * EVENT_LISTENERS ; i++)
+     efl_event_callback_priority_add(obj, SIMPLE_FOO, (short) i, _cb, NULL);
+
+   for (i = 0 ; i < request ; i++)
+     efl_event_callback_call(obj, SIMPLE_FOO, NULL);
+
+   efl_unref(obj);
+}
+
+static void
+bench_eo_callbacks_del_many_event_types(int request)
+{
+   Eo *obj = _many_events_obj_add();
+   int i;
+
+   for (i = 0 ; i < request ; i++)
+     {
+        efl_event_callback_add(obj, SIMPLE_FOO, _cb, NULL);
+        efl_event_callback_del(obj, SIMPLE_FOO, _cb, NULL);
+     }
+
+   efl_unref(obj);
+}
+
 void eo_bench_callbacks(Eina_Benchmark *bench)
 {
    eina_benchmark_register(bench, "add",
          EINA_BENCHMARK(bench_eo_callbacks_add), _EO_BENCH_TIMES(1000, 10, 2000));
    eina_benchmark_register(bench, "call",
          EINA_BENCHMARK(bench_eo_callbacks_call), _EO_BENCH_TIMES(100000, 10, 500000));
+   eina_benchmark_register(bench, "call many event types",
+         EINA_BENCHMARK(bench_eo_callbacks_call_many_event_types), _EO_BENCH_TIMES(100000, 10, 500000));
+   eina_benchmark_register(bench, "call many event types miss",
+         EINA_BENCHMARK(bench_eo_callbacks_call_many_event_types_miss), _EO_BENCH_TIMES(100000, 10, 500000));
+   eina_benchmark_register(bench, "call many listeners",
+         EINA_BENCHMARK(bench_eo_callbacks_call_many_listeners), _EO_BENCH_TIMES(1000, 10, 5000));
+   eina_benchmark_register(bench, "del many event types",
+         EINA_BENCHMARK(bench_eo_callbacks_del_many_event_types), _EO_BENCH_TIMES(10000, 10, 50000));
 }
@@ -38,10 +38,22 @@ bench_efl_add_jump_by_2(int request)
    free(objs);
 }
 
+static void
+bench_efl_add_batch_linear(int request)
+{
+   Eo **objs = calloc(request, sizeof(Eo *));
+
+   efl_add_batch_ref(SIMPLE_CLASS, NULL, objs, request, NULL, NULL);
+   efl_unref_batch(objs, request);
+   free(objs);
+}
+
 void eo_bench_efl_add(Eina_Benchmark *bench)
 {
    eina_benchmark_register(bench, "efl_add_linear",
          EINA_BENCHMARK(bench_efl_add_linear), _EO_BENCH_TIMES(1000, 10, 50000));
    eina_benchmark_register(bench, "efl_add_jump_by_2",
          EINA_BENCHMARK(bench_efl_add_jump_by_2), _EO_BENCH_TIMES(1000, 10, 50000));
+   eina_benchmark_register(bench, "efl_add_batch_linear",
+         EINA_BENCHMARK(bench_efl_add_batch_linear), _EO_BENCH_TIMES(1000, 10, 50000));
 }
@@ -92,6 +92,33 @@ bench_eo_do_super(int request)
    efl_unref(obj);
 }
 
+static void
+bench_eo_do_two_classes(int request)
+{
+   static Efl_Class_Description class_desc = {
+        EO_VERSION,
+        "Simple3",
+        EFL_CLASS_TYPE_REGULAR,
+        0,
+        NULL,
+        NULL,
+        NULL
+   };
+   const Efl_Class *klass = efl_class_new(&class_desc, SIMPLE_CLASS, NULL);
+
+   /* The same call site alternating between objects of two classes */
+   int i;
+   Eo *obj = efl_add_ref(SIMPLE_CLASS, NULL);
+   Eo *obj2 = efl_add_ref(klass, NULL);
+   for (i = 0 ; i < request ; i++)
+     {
+        simple_a_set((i & 1) ? obj : obj2, i);
+     }
+
+   efl_unref(obj);
+   efl_unref(obj2);
+}
+
 void eo_bench_eo_do(Eina_Benchmark *bench)
 {
    eina_benchmark_register(bench, "simple",
@@ -100,6 +127,8 @@ void eo_bench_eo_do(Eina_Benchmark *bench)
          EINA_BENCHMARK(bench_eo_do_super),  _EO_BENCH_TIMES(1000, 10, 500000));
    eina_benchmark_register(bench, "two_objs",
          EINA_BENCHMARK(bench_eo_do_two_objs), _EO_BENCH_TIMES(1000, 10, 500000));
+   eina_benchmark_register(bench, "two_classes",
+         EINA_BENCHMARK(bench_eo_do_two_classes), _EO_BENCH_TIMES(1000, 10, 500000));
    eina_benchmark_register(bench, "two_objs_growing_stack",
          EINA_BENCHMARK(bench_eo_do_two_objs_growing_stack), _EO_BENCH_TIMES(1000, 10, 40000));
 }
@@ -0,0 +1,130 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include "Eo.h"
+#include "eo_bench.h"
+#include "class_simple.h"
+
+/*
+ * Worker threads using objects at the same time, either objects of their own
+ * thread domain or objects of the shared domain, where the ID table is shared
+ * by all the threads.
+ */
+
+#define THREADS 4
+
+typedef enum
+{
+   BENCH_CALLS,
+   BENCH_ADD_DEL
+} Bench_Work;
+
+typedef struct
+{
+   Eina_Thread thread;
+   Bench_Work work;
+   Eina_Bool shared;
+   Eina_Bool started;
+   int request;
+} Bench_Worker;
+
+static void *
+_worker(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Bench_Worker *w = data;
+   Eo *obj;
+   int i;
+
+   if (w->shared) efl_domain_current_push(EFL_ID_DOMAIN_SHARED);
+   switch (w->work)
+     {
+      case BENCH_CALLS:
+         obj = efl_add_ref(SIMPLE_CLASS, NULL);
+         for (i = 0 ; i < w->request ; i++)
+           simple_a_set(obj, i);
+         efl_unref(obj);
+         break;
+      case BENCH_ADD_DEL:
+         for (i = 0 ; i < w->request ; i++)
+           {
+              obj = efl_add_ref(SIMPLE_CLASS, NULL);
+              efl_unref(obj);
+           }
+         break;
+     }
+   if (w->shared) efl_domain_current_pop();
+   return NULL;
+}
+
+static void
+_workers_run(int request, Eina_Bool shared, const Bench_Work *work)
+{
+   Bench_Worker workers[THREADS];
+   int i;
+
+   for (i = 0 ; i < THREADS ; i++)
+     {
+        workers[i].work = work[i];
+        workers[i].shared = shared;
+        workers[i].request = request / THREADS;
+        workers[i].started = eina_thread_create(&workers[i].thread,
+                                                EINA_THREAD_NORMAL, -1,
+                                                _worker, &workers[i]);
+        if (!workers[i].started) _worker(&workers[i], 0);
+     }
+   for (i = 0 ; i < THREADS ; i++)
+     {
+        if (workers[i].started)
+          eina_thread_join(workers[i].thread);
+     }
+}
+
+static const Bench_Work calls[THREADS] = {
+   BENCH_CALLS, BENCH_CALLS, BENCH_CALLS, BENCH_CALLS
+};
+static const Bench_Work add_del[THREADS] = {
+   BENCH_ADD_DEL, BENCH_ADD_DEL, BENCH_ADD_DEL, BENCH_ADD_DEL
+};
+static const Bench_Work mixed[THREADS] = {
+   BENCH_CALLS, BENCH_ADD_DEL, BENCH_CALLS, BENCH_ADD_DEL
+};
+
+static void
+bench_eo_threads_calls(int request)
+{
+   _workers_run(request, EINA_FALSE, calls);
+}
+
+static void
+bench_eo_threads_shared_calls(int request)
+{
+   _workers_run(request, EINA_TRUE, calls);
+}
+
+static void
+bench_eo_threads_shared_add_del(int request)
+{
+   _workers_run(request, EINA_TRUE, add_del);
+}
+
+static void
+bench_eo_threads_shared_mixed(int request)
+{
+   _workers_run(request, EINA_TRUE, mixed);
+}
+
+void eo_bench_threads(Eina_Benchmark *bench)
+{
+   /* Make sure the class is created before the threads race for it */
+   simple_class_get();
+
+   eina_benchmark_register(bench, "calls",
+         EINA_BENCHMARK(bench_eo_threads_calls), _EO_BENCH_TIMES(4000, 10, 200000));
+   eina_benchmark_register(bench, "shared calls",
+         EINA_BENCHMARK(bench_eo_threads_shared_calls), _EO_BENCH_TIMES(4000, 10, 200000));
+   eina_benchmark_register(bench, "shared add del",
+         EINA_BENCHMARK(bench_eo_threads_shared_add_del), _EO_BENCH_TIMES(4000, 10, 20000));
+   eina_benchmark_register(bench, "shared calls and add del",
+         EINA_BENCHMARK(bench_eo_threads_shared_mixed), _EO_BENCH_TIMES(4000, 10, 20000));
+}
@@ -0,0 +1,125 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "../../lib/evas/include/evas_common_private.h"
+#include "evas_bench.h"
+
+/* Each case composites 1000 spans of the requested length, going through
+ * the software drawing functions that pick the span function evas uses for
+ * the cpu. Run it again with EVAS_CPU_NO_AVX2=1 EVAS_CPU_NO_AVX512=1 to
+ * compare with the older code. */
+
+#define SPANS 1000
+
+typedef enum
+{
+   SPAN_PIXEL,
+   SPAN_COLOR,
+   SPAN_PIXEL_COLOR,
+   SPAN_PIXEL_MASK,
+   SPAN_MASK_COLOR
+} Span_Type;
+
+static void
+evas_bench_blend_span(int request, Span_Type type, int op)
+{
+   RGBA_Image *src, *dst, *mask = NULL;
+   DATA32 col = 0xc0806040;
+   int i;
+
+   evas_init();
+   evas_common_init();
+
+   src = evas_common_image_new(request, 1, 1);
+   dst = evas_common_image_new(request, 1, 1);
+   if (!src || !dst) goto end;
+   if ((type == SPAN_PIXEL_MASK) || (type == SPAN_MASK_COLOR))
+     {
+        mask = evas_common_image_alpha_line_buffer_obtain(request);
+        if (!mask) goto end;
+     }
+
+   for (i = 0; i < request; i++)
+     {
+        DATA32 a = (i * 7) & 0xff;
+
+        src->image.data[i] = (a << 24) | ((a / 2) << 16) | ((a / 3) << 8) | (a / 4);
+        dst->image.data[i] = 0xff204060;
+        if (mask) mask->image.data8[i] = (i * 13) & 0xff;
+     }
+
+   for (i = 0; i < SPANS; i++)
+     {
+        switch (type)
+          {
+           case SPAN_PIXEL:
+           case SPAN_PIXEL_MASK:
+             evas_common_scale_rgba_sample_draw(src, dst, 0, 0, request, 1,
+                                                0xffffffff, op,
+                                                0, 0, request, 1,
+                                                0, 0, request, 1,
+                                                mask, 0, 0);
+             break;
+           case SPAN_PIXEL_COLOR:
+             evas_common_scale_rgba_sample_draw(src, dst, 0, 0, request, 1,
+                                                col, op,
+                                                0, 0, request, 1,
+                                                0, 0, request, 1,
+                                                NULL, 0, 0);
+             break;
+           case SPAN_COLOR:
+           case SPAN_MASK_COLOR:
+             evas_common_rectangle_rgba_draw(dst, col, op, 0, 0, request, 1,
+                                             mask, 0, 0);
+             break;
+          }
+     }
+
+ end:
+   if (mask) evas_common_image_alpha_line_buffer_release(mask);
+   if (dst) evas_common_rgba_image_free(&dst->cache_entry);
+   if (src) evas_common_rgba_image_free(&src->cache_entry);
+
+   evas_common_shutdown();
+   evas_shutdown();
+}
+
+#define SPAN_BENCH(Op, OP, Type, TYPE)                                  \
+  static void                                                           \
+  evas_bench_##Op##_##Type(int request)                                 \
+  {                                                                     \
+     evas_bench_blend_span(request, SPAN_##TYPE, _EVAS_RENDER_##OP);    \
+  }
+
+#define SPAN_BENCHES(Op, OP)                                            \
+  SPAN_BENCH(Op, OP, pixel, PIXEL)                                      \
+  SPAN_BENCH(Op, OP, color, COLOR)                                      \
+  SPAN_BENCH(Op, OP, pixel_color, PIXEL_COLOR)                          \
+  SPAN_BENCH(Op, OP, pixel_mask, PIXEL_MASK)                            \
+  SPAN_BENCH(Op, OP, mask_color, MASK_COLOR)
+
+SPAN_BENCHES(blend, BLEND)
+SPAN_BENCHES(copy, COPY)
+SPAN_BENCHES(mul, MUL)
+SPAN_BENCHES(mask, MASK)
+
+#define SPAN_REGISTER(Op, Type)                                         \
+  eina_benchmark_register(bench, #Op "-" #Type,                         \
+                          EINA_BENCHMARK(evas_bench_##Op##_##Type),     \
+                          8, 4096, 256)
+
+#define SPAN_REGISTERS(Op)                                              \
+  SPAN_REGISTER(Op, pixel);                                             \
+  SPAN_REGISTER(Op, color);                                             \
+  SPAN_REGISTER(Op, pixel_color);                                       \
+  SPAN_REGISTER(Op, pixel_mask);                                        \
+  SPAN_REGISTER(Op, mask_color)
+
+void evas_bench_blend(Eina_Benchmark *bench)
+{
+   SPAN_REGISTERS(blend);
+   SPAN_REGISTERS(copy);
+   SPAN_REGISTERS(mul);
+   SPAN_REGISTERS(mask);
+}
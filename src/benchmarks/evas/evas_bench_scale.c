@@ -0,0 +1,77 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "../../lib/evas/include/evas_common_private.h"
+#include "evas_bench.h"
+
+/* Each case zooms a square image of the requested size out from 512 to
+ * 256 pixels, one smooth draw per step, the way zoomable views animate.
+ * With mip levels on the draws start from them and their cost stops
+ * growing with the source size. */
+
+#define DST_SIZE 512
+#define STEPS 64
+
+static void
+evas_bench_scale_zoom(int request, Eina_Bool mipmap)
+{
+   RGBA_Image *src, *dst;
+   int i;
+
+   evas_init();
+   evas_common_init();
+
+   src = evas_common_image_new(request, request, 1);
+   dst = evas_common_image_new(DST_SIZE, DST_SIZE, 1);
+   if (!src || !dst) goto end;
+   src->cache_entry.flags.mipmap = mipmap;
+
+   for (i = 0; i < request * request; i++)
+     {
+        DATA32 a = (i * 7) & 0xff;
+
+        src->image.data[i] = (a << 24) | ((a / 2) << 16) | ((a / 3) << 8) | (a / 4);
+     }
+
+   for (i = 0; i < STEPS; i++)
+     {
+        int size = DST_SIZE - (i * (DST_SIZE / 2) / STEPS);
+
+        evas_common_scale_rgba_smooth_draw(src, dst,
+                                           0, 0, DST_SIZE, DST_SIZE,
+                                           0xffffffff, _EVAS_RENDER_BLEND,
+                                           0, 0, request, request,
+                                           0, 0, size, size,
+                                           NULL, 0, 0);
+     }
+
+ end:
+   if (dst) evas_common_rgba_image_free(&dst->cache_entry);
+   if (src) evas_common_rgba_image_free(&src->cache_entry);
+
+   evas_common_shutdown();
+   evas_shutdown();
+}
+
+static void
+evas_bench_scale_zoom_none(int request)
+{
+   evas_bench_scale_zoom(request, EINA_FALSE);
+}
+
+static void
+evas_bench_scale_zoom_mipmap(int request)
+{
+   evas_bench_scale_zoom(request, EINA_TRUE);
+}
+
+void evas_bench_scale(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "zoom",
+                           EINA_BENCHMARK(evas_bench_scale_zoom_none),
+                           1024, 8192, 1024);
+   eina_benchmark_register(bench, "zoom-mipmap",
+                           EINA_BENCHMARK(evas_bench_scale_zoom_mipmap),
+                           1024, 8192, 1024);
+}
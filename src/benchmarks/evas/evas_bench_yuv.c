@@ -0,0 +1,127 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "../../lib/evas/include/evas_common_private.h"
+#include "evas_bench.h"
+
+/* Each case converts 10 frames of the requested height at 16:9. Frames
+ * above 1080p are split across threads, run it with EVAS_CPU_NO_AVX2=1
+ * EVAS_CPU_NO_SSE41=1 to see the C rows. */
+
+#define FRAMES 10
+
+typedef enum
+{
+   YUV_PLANAR_601,
+   YUV_PLANAR_709,
+   YUV_YUY2,
+   YUV_NV12
+} Yuv_Format;
+
+static void
+evas_bench_yuv_convert(int request, Yuv_Format format)
+{
+   DATA8 **rows = NULL;
+   DATA8 *yuv = NULL, *rgb = NULL;
+   int w = ((request * 16 / 9) + 1) & ~1, h = request & ~1;
+   int i;
+
+   evas_init();
+   evas_common_init();
+
+   yuv = malloc(w * h * 2);
+   rgb = malloc(w * h * sizeof (DATA32));
+   rows = malloc(h * 2 * sizeof (DATA8 *));
+   if (!yuv || !rgb || !rows) goto end;
+
+   for (i = 0; i < w * h * 2; i++)
+     yuv[i] = (i * 7) & 0xff;
+
+   switch (format)
+     {
+      case YUV_YUY2:
+        for (i = 0; i < h; i++)
+          rows[i] = yuv + (i * w * 2);
+        break;
+      case YUV_NV12:
+        for (i = 0; i < h; i++)
+          rows[i] = yuv + (i * w);
+        for (i = 0; i < h / 2; i++)
+          rows[h + i] = yuv + (w * h) + (i * w);
+        break;
+      default:
+        for (i = 0; i < h; i++)
+          rows[i] = yuv + (i * w);
+        for (i = 0; i < h; i++)
+          rows[h + i] = yuv + (w * h) + (i * w / 2);
+        break;
+     }
+
+   for (i = 0; i < FRAMES; i++)
+     {
+        switch (format)
+          {
+           case YUV_PLANAR_601:
+             evas_common_convert_yuv_422p_601_rgba(rows, rgb, w, h);
+             break;
+           case YUV_PLANAR_709:
+             evas_common_convert_yuv_422p_709_rgba(rows, rgb, w, h);
+             break;
+           case YUV_YUY2:
+             evas_common_convert_yuv_422_601_rgba(rows, rgb, w, h);
+             break;
+           case YUV_NV12:
+             evas_common_convert_yuv_420_601_rgba(rows, rgb, w, h);
+             break;
+          }
+     }
+
+ end:
+   free(rows);
+   free(rgb);
+   free(yuv);
+
+   evas_common_shutdown();
+   evas_shutdown();
+}
+
+static void
+evas_bench_yuv_planar_601(int request)
+{
+   evas_bench_yuv_convert(request, YUV_PLANAR_601);
+}
+
+static void
+evas_bench_yuv_planar_709(int request)
+{
+   evas_bench_yuv_convert(request, YUV_PLANAR_709);
+}
+
+static void
+evas_bench_yuv_yuy2(int request)
+{
+   evas_bench_yuv_convert(request, YUV_YUY2);
+}
+
+static void
+evas_bench_yuv_nv12(int request)
+{
+   evas_bench_yuv_convert(request, YUV_NV12);
+}
+
+void evas_bench_yuv(Eina_Benchmark *bench)
+{
+   eina_benchmark_register(bench, "planar-601",
+                           EINA_BENCHMARK(evas_bench_yuv_planar_601),
+                           240, 2400, 240);
+   eina_benchmark_register(bench, "planar-709",
+                           EINA_BENCHMARK(evas_bench_yuv_planar_709),
+                           240, 2400, 240);
+   eina_benchmark_register(bench, "yuy2",
+                           EINA_BENCHMARK(evas_bench_yuv_yuy2),
+                           240, 2400, 240);
+   eina_benchmark_register(bench, "nv12",
+                           EINA_BENCHMARK(evas_bench_yuv_nv12),
+                           240, 2400, 240);
+}
@@ -51,6 +51,10 @@ static int _prof_off_opcode = EINA_DEBUG_OPCODE_INVALID;
 static int _cpufreq_on_opcode = EINA_DEBUG_OPCODE_INVALID;
 static int _cpufreq_off_opcode = EINA_DEBUG_OPCODE_INVALID;
 static int _evlog_get_opcode = EINA_DEBUG_OPCODE_INVALID;
+static int _eo_prof_on_opcode = EINA_DEBUG_OPCODE_INVALID;
+static int _eo_prof_off_opcode = EINA_DEBUG_OPCODE_INVALID;
+static int _eo_prof_reset_opcode = EINA_DEBUG_OPCODE_INVALID;
+static int _eo_prof_get_opcode = EINA_DEBUG_OPCODE_INVALID;
 
 static Eina_Debug_Session *_session = NULL;
 
@@ -94,6 +98,21 @@ _evlog_get_cb(Eina_Debug_Session *session EINA_UNUSED, int src EINA_UNUSED, void
    return EINA_TRUE;
 }
 
+static Eina_Bool
+_eo_prof_get_cb(Eina_Debug_Session *session EINA_UNUSED, int src EINA_UNUSED, void *buffer, int size)
+{
+   if (size > 0)
+     {
+        /* The report is a nul terminated string */
+        ((char *)buffer)[size - 1] = '\0';
+        fputs(buffer, stdout);
+     }
+   else
+      printf("No Eo profile, is Eo initialized?\n");
+   ecore_main_loop_quit();
+   return EINA_TRUE;
+}
+
 static Eina_Bool
 _cb_evlog(void *data EINA_UNUSED)
 {
@@ -149,6 +168,20 @@ _cid_get_cb(Eina_Debug_Session *session EINA_UNUSED, int cid EINA_UNUSED, void *
      }
    else if (!strcmp(op_str, "evlogoff"))
         eina_debug_session_send(_session, _cid, _cpufreq_off_opcode,  NULL, 0);
+   else if (!strcmp(op_str, "eoprofon"))
+     {
+        int sampling = SWAP_32(((my_argc - 1) >= 3) ? atoi(my_argv[3]) : 1);
+        eina_debug_session_send(_session, _cid, _eo_prof_on_opcode, &sampling, sizeof(int));
+     }
+   else if (!strcmp(op_str, "eoprofoff"))
+        eina_debug_session_send(_session, _cid, _eo_prof_off_opcode,  NULL, 0);
+   else if (!strcmp(op_str, "eoprofreset"))
+        eina_debug_session_send(_session, _cid, _eo_prof_reset_opcode,  NULL, 0);
+   else if (!strcmp(op_str, "eoprof"))
+     {
+        eina_debug_session_send(_session, _cid, _eo_prof_get_opcode,  NULL, 0);
+        quit = EINA_FALSE;
+     }
 
    if(quit)
         ecore_main_loop_quit();
@@ -248,6 +281,10 @@ EINA_DEBUG_OPCODES_ARRAY_DEFINE(ops,
       {"CPU/Freq/on",                      &_cpufreq_on_opcode,    NULL},
       {"CPU/Freq/off",                     &_cpufreq_off_opcode,   NULL},
       {"EvLog/get",                        &_evlog_get_opcode,     _evlog_get_cb},
+      {"Eo/Profiler/on",                   &_eo_prof_on_opcode,    NULL},
+      {"Eo/Profiler/off",                  &_eo_prof_off_opcode,   NULL},
+      {"Eo/Profiler/reset",                &_eo_prof_reset_opcode, NULL},
+      {"Eo/Profiler/get",                  &_eo_prof_get_opcode,   _eo_prof_get_cb},
       {NULL, NULL, NULL}
 );
 
@@ -0,0 +1,430 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Eina.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// converts event logs to the chrome trace event json format, which the
+// chrome://tracing and perfetto (ui.perfetto.dev) viewers load.
+//
+// how to use:
+//
+// eina_evlog_convert [-o trace.json] log.1 log ...
+//
+// the logs are either streams written with eina_evlog_stream_start() (or
+// EINA_EVLOG_FILE=log) or logs fetched with efl_debug evlogon. give the
+// files of a stream oldest first, so log.1 before log.
+//
+// "+name" and "-name" events begin and end a slice of their thread,
+// ">name" and "<name" begin and end an async "state" slice, "*name" events
+// with a number as detail are counters, other events are instants.
+
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+#define SWAP_64(x) x
+#define SWAP_32(x) x
+#define SWAP_16(x) x
+#else
+#define SWAP_64(x) eina_swap64(x)
+#define SWAP_32(x) eina_swap32(x)
+#define SWAP_16(x) eina_swap16(x)
+#endif
+
+#define EVLOG_STREAM_MAGIC "EINAEVL1"
+#define EVLOG_BLOCK_MAGIC 0xffee211
+
+typedef struct
+{
+   FILE *out;
+   Eina_Hash *threads; // thread handle -> tid
+   Eina_Hash *states; // state name -> id
+   int threads_count;
+   int states_count;
+   double t0;
+   Eina_Bool t0_set : 1;
+   Eina_Bool first : 1;
+} Convert;
+
+typedef struct
+{
+   const unsigned char *p;
+   const unsigned char *end;
+} Reader;
+
+static void
+_json_string(FILE *out, const char *str)
+{
+   const unsigned char *s;
+
+   fputc('"', out);
+   for (s = (const unsigned char *)str; *s; s++)
+     {
+        if ((*s == '"') || (*s == '\\')) fprintf(out, "\\%c", *s);
+        else if (*s < 0x20) fprintf(out, "\\u%04x", *s);
+        else fputc(*s, out);
+     }
+   fputc('"', out);
+}
+
+static void
+_event_begin(Convert *c)
+{
+   if (!c->first) fputs(",\n", c->out);
+   c->first = EINA_FALSE;
+}
+
+static int
+_thread_id(Convert *c, unsigned long long thread)
+{
+   intptr_t tid = (intptr_t)eina_hash_find(c->threads, &thread);
+
+   if (tid) return tid;
+   tid = ++c->threads_count;
+   eina_hash_add(c->threads, &thread, (void *)tid);
+   _event_begin(c);
+   fprintf(c->out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,"
+           "\"args\":{\"name\":\"thread %#llx\"}}", (int)tid, thread);
+   return tid;
+}
+
+static int
+_state_id(Convert *c, const char *name)
+{
+   intptr_t id = (intptr_t)eina_hash_find(c->states, name);
+
+   if (id) return id;
+   id = ++c->states_count;
+   eina_hash_add(c->states, name, (void *)id);
+   return id;
+}
+
+static void
+_event(Convert *c, double tim, double srctim, unsigned long long thread,
+       unsigned long long obj, const char *event, const char *detail)
+{
+   const char *name = event + 1;
+   char *end = NULL;
+   double value = 0.0;
+   int tid;
+
+   if (!event[0]) return;
+   if (!c->t0_set)
+     {
+        c->t0 = tim;
+        c->t0_set = EINA_TRUE;
+     }
+   tid = _thread_id(c, thread);
+   if ((event[0] == '*') && (detail)) value = strtod(detail, &end);
+
+   _event_begin(c);
+   fputs("{\"name\":", c->out);
+   _json_string(c->out, name);
+   switch (event[0])
+     {
+      case '+':
+        fputs(",\"ph\":\"B\"", c->out);
+        break;
+      case '-':
+        fputs(",\"ph\":\"E\"", c->out);
+        break;
+      case '>':
+        fprintf(c->out, ",\"ph\":\"b\",\"cat\":\"state\",\"id\":%i", _state_id(c, name));
+        break;
+      case '<':
+        fprintf(c->out, ",\"ph\":\"e\",\"cat\":\"state\",\"id\":%i", _state_id(c, name));
+        break;
+      case '*':
+        if ((end) && (end != detail))
+          {
+             fprintf(c->out, ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%i,"
+                     "\"args\":{\"value\":%g}}", (tim - c->t0) * 1000000.0, tid, value);
+             return;
+          }
+        EINA_FALLTHROUGH;
+      default:
+        if (event[0] != '!') name = event;
+        fputs(",\"ph\":\"i\",\"s\":\"t\"", c->out);
+        break;
+     }
+   fprintf(c->out, ",\"ts\":%.3f,\"pid\":1,\"tid\":%i,\"args\":{",
+           (tim - c->t0) * 1000000.0, tid);
+   if (detail)
+     {
+        fputs("\"detail\":", c->out);
+        _json_string(c->out, detail);
+     }
+   if (obj)
+     fprintf(c->out, "%s\"obj\":\"%#llx\"", detail ? "," : "", obj);
+   if (srctim > 0.0)
+     fprintf(c->out, "%s\"srctime\":%.3f", (detail || obj) ? "," : "",
+             (srctim - c->t0) * 1000000.0);
+   fputs("}}", c->out);
+}
+
+static void
+_lost(Convert *c, double tim, unsigned long long count)
+{
+   if (!c->t0_set) return;
+   _event_begin(c);
+   fprintf(c->out, "{\"name\":\"evlog lost %llu events\",\"ph\":\"i\",\"s\":\"g\","
+           "\"ts\":%.3f,\"pid\":1,\"tid\":0}", count, (tim - c->t0) * 1000000.0);
+}
+
+static Eina_Bool
+_read_uint(Reader *r, unsigned long long *val)
+{
+   unsigned int shift = 0;
+
+   *val = 0;
+   while (r->p < r->end)
+     {
+        unsigned char b = *(r->p++);
+
+        if (shift < 64) *val |= (unsigned long long)(b & 0x7f) << shift;
+        if (!(b & 0x80)) return EINA_TRUE;
+        shift += 7;
+     }
+   return EINA_FALSE;
+}
+
+static Eina_Bool
+_read_int(Reader *r, long long *val)
+{
+   unsigned long long u;
+
+   if (!_read_uint(r, &u)) return EINA_FALSE;
+   *val = (long long)(u >> 1) ^ -(long long)(u & 1);
+   return EINA_TRUE;
+}
+
+static const char *
+_string_get(Eina_Array *strings, unsigned long long id)
+{
+   if (id >= eina_array_count(strings)) return NULL;
+   return eina_array_data_get(strings, id);
+}
+
+static Eina_Bool
+_stream_convert(Convert *c, const unsigned char *data, size_t size)
+{
+   Reader r = { data + 8, data + size };
+   Eina_Array *strings = eina_array_new(64);
+   Eina_Array *threads = eina_array_new(8);
+   long long tim = 0, delta;
+   unsigned long long id, len, val, thread, event, detail, obj;
+   Eina_Bool ret = EINA_FALSE;
+   unsigned int i;
+   char *str;
+
+   while (r.p < r.end)
+     {
+        unsigned char type = *(r.p++);
+
+        switch (type)
+          {
+           case EINA_EVLOG_STREAM_STRING:
+             if ((!_read_uint(&r, &id)) || (!_read_uint(&r, &len)) ||
+                 (len > (unsigned long long)(r.end - r.p)) || (id > 1000000))
+               goto end;
+             str = malloc(len + 1);
+             memcpy(str, r.p, len);
+             str[len] = 0;
+             r.p += len;
+             while (eina_array_count(strings) <= id) eina_array_push(strings, strdup(""));
+             free(eina_array_data_get(strings, id));
+             eina_array_data_set(strings, id, str);
+             break;
+           case EINA_EVLOG_STREAM_THREAD:
+             if ((!_read_uint(&r, &id)) || (!_read_uint(&r, &val)) ||
+                 (id > 1000000))
+               goto end;
+             while (eina_array_count(threads) <= id) eina_array_push(threads, calloc(1, sizeof(val)));
+             memcpy(eina_array_data_get(threads, id), &val, sizeof(val));
+             break;
+           case EINA_EVLOG_STREAM_EVENT:
+             {
+                unsigned char flags;
+                long long src = 0;
+
+                if (r.p >= r.end) goto end;
+                flags = *(r.p++);
+                detail = obj = 0;
+                if ((!_read_int(&r, &delta)) || (!_read_uint(&r, &thread)) ||
+                    (!_read_uint(&r, &event)))
+                  goto end;
+                if ((flags & EINA_EVLOG_STREAM_DETAIL) && (!_read_uint(&r, &detail)))
+                  goto end;
+                if ((flags & EINA_EVLOG_STREAM_OBJ) && (!_read_uint(&r, &obj)))
+                  goto end;
+                if ((flags & EINA_EVLOG_STREAM_SRCTIME) && (!_read_int(&r, &src)))
+                  goto end;
+                tim += delta;
+                if (thread >= eina_array_count(threads)) goto end;
+                memcpy(&val, eina_array_data_get(threads, thread), sizeof(val));
+                if (!_string_get(strings, event)) goto end;
+                _event(c, tim / 1000000000.0,
+                       (flags & EINA_EVLOG_STREAM_SRCTIME) ? (tim - src) / 1000000000.0 : 0.0,
+                       val, obj, _string_get(strings, event),
+                       (flags & EINA_EVLOG_STREAM_DETAIL) ? _string_get(strings, detail) : NULL);
+             }
+             break;
+           case EINA_EVLOG_STREAM_LOST:
+             if (!_read_uint(&r, &val)) goto end;
+             _lost(c, tim / 1000000000.0, val);
+             break;
+           default:
+             fprintf(stderr, "Unknown record type %i, stopping\n", type);
+             goto end;
+          }
+     }
+   ret = EINA_TRUE;
+end:
+   // a stream cut by a crash ends with a partial record, that's fine
+   if (!ret) fprintf(stderr, "WARNING: The stream ends with a partial record\n");
+   for (i = 0; i < eina_array_count(strings); i++)
+     free(eina_array_data_get(strings, i));
+   for (i = 0; i < eina_array_count(threads); i++)
+     free(eina_array_data_get(threads, i));
+   eina_array_free(strings);
+   eina_array_free(threads);
+   return EINA_TRUE;
+}
+
+// the blocks written by efl_debug evlogon, items as in Eina_Evlog_Buf
+static Eina_Bool
+_blocks_convert(Convert *c, const unsigned char *data, size_t size)
+{
+   const unsigned char *p = data, *end = data + size;
+   unsigned int header[3];
+
+   while ((size_t)(end - p) >= sizeof(header))
+     {
+        const unsigned char *block, *block_end;
+
+        memcpy(header, p, sizeof(header));
+        p += sizeof(header);
+        if (header[0] != EVLOG_BLOCK_MAGIC) return EINA_FALSE;
+        header[1] = SWAP_32(header[1]);
+        if (header[1] > (size_t)(end - p)) return EINA_FALSE;
+        block = p;
+        block_end = p + header[1];
+        p = block_end;
+        while ((size_t)(block_end - block) >= sizeof(Eina_Evlog_Item))
+          {
+             Eina_Evlog_Item item;
+             unsigned long long tmp;
+             unsigned short next;
+             const char *detail = NULL;
+
+             memcpy(&item, block, sizeof(item));
+             next = SWAP_16(item.event_next);
+             if ((next < sizeof(item)) || (next > (size_t)(block_end - block)) ||
+                 (block[next - 1] != 0))
+               return EINA_FALSE;
+             memcpy(&tmp, &item.tim, sizeof(tmp));
+             tmp = SWAP_64(tmp);
+             memcpy(&item.tim, &tmp, sizeof(tmp));
+             memcpy(&tmp, &item.srctim, sizeof(tmp));
+             tmp = SWAP_64(tmp);
+             memcpy(&item.srctim, &tmp, sizeof(tmp));
+             item.event_offset = SWAP_16(item.event_offset);
+             item.detail_offset = SWAP_16(item.detail_offset);
+             if ((item.event_offset >= next) || (item.detail_offset >= next))
+               return EINA_FALSE;
+             if (item.detail_offset)
+               detail = (const char *)block + item.detail_offset;
+             _event(c, item.tim, item.srctim, SWAP_64(item.thread),
+                    SWAP_64(item.obj), (const char *)block + item.event_offset,
+                    detail);
+             block += next;
+          }
+     }
+   return EINA_TRUE;
+}
+
+int
+main(int argc, char **argv)
+{
+   Convert c = { 0 };
+   const char *output = NULL;
+   int i, ret = 0;
+
+   if ((argc > 2) && (!strcmp(argv[1], "-o")))
+     {
+        output = argv[2];
+        argv += 2;
+        argc -= 2;
+     }
+   if ((argc < 2) || (!strcmp(argv[1], "-h")) || (!strcmp(argv[1], "--help")))
+     {
+        printf("Usage: %s [-o trace.json] log [log ...]\n"
+               "Converts event logs to the chrome trace json format.\n", argv[0]);
+        return (argc < 2) ? 1 : 0;
+     }
+
+   eina_init();
+
+   c.out = stdout;
+   if ((output) && (!(c.out = fopen(output, "w"))))
+     {
+        fprintf(stderr, "ERROR: Can't open '%s'\n", output);
+        eina_shutdown();
+        return 1;
+     }
+   c.threads = eina_hash_int64_new(NULL);
+   c.states = eina_hash_string_superfast_new(NULL);
+   c.first = EINA_TRUE;
+
+   fputs("{\"traceEvents\":[\n", c.out);
+   for (i = 1; i < argc; i++)
+     {
+        Eina_File *f = eina_file_open(argv[i], EINA_FALSE);
+        const unsigned char *data;
+        size_t size;
+        Eina_Bool ok;
+
+        if (!f)
+          {
+             fprintf(stderr, "ERROR: Can't open '%s'\n", argv[i]);
+             ret = 1;
+             continue;
+          }
+        data = eina_file_map_all(f, EINA_FILE_SEQUENTIAL);
+        size = eina_file_size_get(f);
+        if ((data) && (size >= 8) && (!memcmp(data, EVLOG_STREAM_MAGIC, 8)))
+          ok = _stream_convert(&c, data, size);
+        else if (data)
+          ok = _blocks_convert(&c, data, size);
+        else
+          ok = EINA_FALSE;
+        if (!ok)
+          {
+             fprintf(stderr, "ERROR: '%s' is not a valid event log\n", argv[i]);
+             ret = 1;
+          }
+        if (data) eina_file_map_free(f, (void *)data);
+        eina_file_close(f);
+     }
+   fputs("\n],\"displayTimeUnit\":\"ns\"}\n", c.out);
+
+   if (c.out != stdout) fclose(c.out);
+   eina_hash_free(c.threads);
+   eina_hash_free(c.states);
+   eina_shutdown();
+   return ret;
+}
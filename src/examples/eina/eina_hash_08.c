@@ -63,8 +63,8 @@ main(int argc EINA_UNUSED, const char *argv[] EINA_UNUSED)
    r = eina_hash_del(phone_book, entry_name, NULL);
    printf("Hash entry successfully deleted? %d\n\n", r);
 
-   int hash = eina_hash_superfast("Ludwig van Beethoven",
-				  sizeof("Ludwig van Beethoven"));
+   int hash = eina_hash_fast("Ludwig van Beethoven",
+			     sizeof("Ludwig van Beethoven"));
 
    r = eina_hash_del_by_key_hash(phone_book, "Ludwig van Beethoven",
 				 sizeof("Ludwig van Beethoven"), hash);
@@ -77,7 +77,7 @@ main(int argc EINA_UNUSED, const char *argv[] EINA_UNUSED)
    entry_name = "Raul_Seixas";
    entry_size = sizeof("Raul Seixas");
    phone = strdup("+33 33 333-33333");
-   hash = eina_hash_superfast(entry_name, entry_size);
+   hash = eina_hash_fast(entry_name, entry_size);
    eina_hash_add_by_hash(phone_book, entry_name, entry_size, hash, phone);
 
    // don't need to free 'phone' after the next del:
@@ -85,7 +85,7 @@ main(int argc EINA_UNUSED, const char *argv[] EINA_UNUSED)
    printf("Hash entry successfully deleted? %d\n\n", r);
 
    // add entry by hash directly - no copy of the key will be done
-   hash = eina_hash_superfast(saved_entry_name, saved_entry_size);
+   hash = eina_hash_fast(saved_entry_name, saved_entry_size);
    phone = strdup("+44 44 444-44444");
    eina_hash_direct_add_by_hash(phone_book, saved_entry_name,
 				saved_entry_size, hash, phone);
@@ -2078,6 +2078,159 @@ EAPI void ecore_thread_max_reset(void);
  */
 EAPI int ecore_thread_available_get(void);
 
+/**
+ * @typedef Ecore_Thread_Range_Cb Ecore_Thread_Range_Cb
+ * A callback used by ecore_thread_parallel_for() to process the
+ * items in [@p start, @p end[.
+ *
+ * @since 1.22
+ */
+typedef void (*Ecore_Thread_Range_Cb)(void *data, Ecore_Thread *thread, unsigned int start, unsigned int end);
+
+/**
+ * @typedef Ecore_Thread_Graph
+ * A set of tasks to run in threads, some of them waiting for others.
+ *
+ * @since 1.22
+ */
+typedef struct _Ecore_Thread_Graph Ecore_Thread_Graph;
+
+/**
+ * @typedef Ecore_Thread_Task
+ * A task belonging to an #Ecore_Thread_Graph.
+ *
+ * @since 1.22
+ */
+typedef struct _Ecore_Thread_Task Ecore_Thread_Task;
+
+/**
+ * Runs a function over a range of items in parallel threads.
+ *
+ * @param start The first item of the range.
+ * @param end The item following the last one of the range.
+ * @param grain The number of items given to @p func at once, @c 0 to
+ * let Ecore pick a size from the range and the number of threads.
+ * @param func The function called in a thread for each chunk of items.
+ * @param data User context data to pass to @p func.
+ * @return A future resolved with an empty value once all the items are
+ * processed, or @c NULL on error.
+ *
+ * The range is cut in chunks of @p grain items that are handed out to at
+ * most ecore_thread_max_get() jobs, each of them taking the next chunk as
+ * soon as it is done with the previous one. @p func must be safe to call
+ * from several threads at once on distinct chunks. It may check
+ * ecore_thread_check() on its @p thread argument to stop early.
+ *
+ * Cancelling the returned future cancels the jobs still running. The
+ * future is rejected with @c ECANCELED if any job was cancelled or could
+ * not be started.
+ *
+ * @note This function must be called from the main loop.
+ *
+ * @see ecore_thread_run()
+ * @since 1.22
+ */
+EAPI Eina_Future *ecore_thread_parallel_for(unsigned int start, unsigned int end, unsigned int grain, Ecore_Thread_Range_Cb func, const void *data);
+
+/**
+ * Creates an empty task graph.
+ *
+ * @return A new graph, or @c NULL on error.
+ *
+ * @see ecore_thread_graph_task_add()
+ * @see ecore_thread_graph_run()
+ * @since 1.22
+ */
+EAPI Ecore_Thread_Graph *ecore_thread_graph_new(void);
+
+/**
+ * Frees a task graph that was never run.
+ *
+ * @param graph The graph to free.
+ *
+ * A graph given to ecore_thread_graph_run() is owned by Ecore and must
+ * not be freed with this function.
+ *
+ * @since 1.22
+ */
+EAPI void ecore_thread_graph_free(Ecore_Thread_Graph *graph);
+
+/**
+ * Adds a task to a graph.
+ *
+ * @param graph The graph the task belongs to.
+ * @param func The function to run in a thread.
+ * @param data User context data to pass to @p func.
+ * @return The new task, or @c NULL on error.
+ *
+ * The task starts as soon as the graph is run and all the tasks it
+ * depends on are done.
+ *
+ * @see ecore_thread_graph_task_depend()
+ * @since 1.22
+ */
+EAPI Ecore_Thread_Task *ecore_thread_graph_task_add(Ecore_Thread_Graph *graph, Ecore_Thread_Cb func, const void *data);
+
+/**
+ * Makes a task wait for another one of the same graph.
+ *
+ * @param task The task that has to wait.
+ * @param before The task that must be done before @p task starts.
+ * @return @c EINA_TRUE on success, @c EINA_FALSE otherwise.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Bool ecore_thread_graph_task_depend(Ecore_Thread_Task *task, Ecore_Thread_Task *before);
+
+/**
+ * Runs all the tasks of a graph.
+ *
+ * @param graph The graph to run. Ecore takes ownership of it.
+ * @return A future resolved with an empty value once all the tasks are
+ * done, or @c NULL on error.
+ *
+ * Tasks without pending dependencies are started right away with
+ * ecore_thread_run(), the others as soon as the last task they depend on
+ * is done. The future is rejected with @c EINVAL if the dependencies
+ * contain a cycle, and with @c ECANCELED if a task was cancelled or could
+ * not be started. Cancelling the returned future cancels the running
+ * tasks and drops the pending ones. The graph is freed once the future
+ * is settled.
+ *
+ * @note This function must be called from the main loop.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Future *ecore_thread_graph_run(Ecore_Thread_Graph *graph);
+
+/**
+ * Makes a range of a file mapping resident in a thread.
+ *
+ * @param file The file the mapping comes from.
+ * @param map The mapping, from eina_file_map_all() or eina_file_map_new().
+ * @param offset The offset of the range from the start of @p map.
+ * @param length The length of the range, @c 0 for all of @p map after
+ * @p offset.
+ * @return A future resolved with an empty value once the range is read
+ * and mapped, or @c NULL on error.
+ *
+ * This calls eina_file_map_prefetch() from a thread, so that the pages
+ * are read from the disk while the main loop goes on instead of stalling
+ * on page faults when the mapping is accessed. It is useful for files
+ * known to be read soon, like a theme at startup. Large ranges are read in
+ * chunks, cancelling the returned future stops at the next one.
+ *
+ * The future is rejected with @c EIO on an IO error, @c ECANCELED if it
+ * was cancelled, and @c EINVAL if @p map is freed before the range is
+ * read. @p map doesn't need to be kept mapped meanwhile.
+ *
+ * @note This function must be called from the main loop.
+ *
+ * @see eina_file_map_faulted()
+ * @since 1.22
+ */
+EAPI Eina_Future *ecore_thread_file_map_populate(Eina_File *file, const void *map, unsigned long int offset, unsigned long int length);
+
 /**
  * Adds some data to a hash local to the thread.
  *
@@ -113,6 +113,13 @@ static int _thread_id = -1;
 static int _thread_id_max = 0;
 static int _thread_id_update = 0;
 
+/* Eina_Cow pools written during a frame are merged back from an idler, a
+ * slice at a time, so the gc never delays the next frame. */
+#define ECORE_COW_GC_SLICE 0.0005
+
+static Ecore_Idle_Enterer *_ecore_cow_gc_enterer = NULL;
+static Ecore_Idler *_ecore_cow_gc_idler = NULL;
+
 static Ecore_Power_State _ecore_power_state = ECORE_POWER_STATE_MAINS;
 static Ecore_Memory_State _ecore_memory_state = ECORE_MEMORY_STATE_NORMAL;
 
@@ -225,6 +232,23 @@ ecore_app_no_system_modules(void)
    _no_system_modules = EINA_TRUE;
 }
 
+static Eina_Bool
+_ecore_cow_gc_idler_cb(void *data EINA_UNUSED)
+{
+   if (eina_cow_gc_background_run(ECORE_COW_GC_SLICE))
+     return ECORE_CALLBACK_RENEW;
+   _ecore_cow_gc_idler = NULL;
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_ecore_cow_gc_enterer_cb(void *data EINA_UNUSED)
+{
+   if (!_ecore_cow_gc_idler && eina_cow_gc_background_pending())
+     _ecore_cow_gc_idler = ecore_idler_add(_ecore_cow_gc_idler_cb, NULL);
+   return ECORE_CALLBACK_RENEW;
+}
+
 EAPI int
 ecore_init(void)
 {
@@ -283,6 +307,7 @@ ecore_init(void)
    _ecore_thread_init();
    _ecore_job_init();
    _ecore_time_init();
+   _ecore_cow_gc_enterer = ecore_idle_enterer_add(_ecore_cow_gc_enterer_cb, NULL);
 
    eina_lock_new(&_thread_mutex);
    eina_condition_new(&_thread_cond, &_thread_mutex);
@@ -407,6 +432,13 @@ ecore_shutdown(void)
      _ecore_poller_shutdown();
      _ecore_animator_shutdown();
      _ecore_glib_shutdown();
+     if (_ecore_cow_gc_idler)
+       {
+          ecore_idler_del(_ecore_cow_gc_idler);
+          _ecore_cow_gc_idler = NULL;
+       }
+     ecore_idle_enterer_del(_ecore_cow_gc_enterer);
+     _ecore_cow_gc_enterer = NULL;
      _ecore_job_shutdown();
      _ecore_thread_shutdown();
 
@@ -3,6 +3,8 @@
 #endif
 
 #include <stdlib.h>
+#include <errno.h>
+#include <limits.h>
 #include <sys/time.h>
 #include <assert.h>
 #include <sys/types.h>
@@ -44,8 +46,19 @@
 # define PHE(x, y)    eina_thread_equal(x, y)
 # define PHS()        eina_thread_self()
 # define PHC(x, f, d) eina_thread_create(&(x), EINA_THREAD_BACKGROUND, -1, (void *)f, d)
+# define PHCA(x, f, d, a) eina_thread_create(&(x), EINA_THREAD_BACKGROUND, a, (void *)f, d)
 # define PHJ(x)       eina_thread_join(x)
 
+#ifdef __ATOMIC_RELAXED
+# define ATOMIC_ADD(x, v) __atomic_add_fetch(&(x), (v), __ATOMIC_SEQ_CST)
+# define ATOMIC_GET(x)    __atomic_load_n(&(x), __ATOMIC_SEQ_CST)
+# define ATOMIC_SET(x, v) __atomic_store_n(&(x), (v), __ATOMIC_SEQ_CST)
+#else
+# define ATOMIC_ADD(x, v) _ecore_thread_atomic_add(&(x), (v))
+# define ATOMIC_GET(x)    _ecore_thread_atomic_add(&(x), 0)
+# define ATOMIC_SET(x, v) _ecore_thread_atomic_set(&(x), (v))
+#endif
+
 typedef struct _Ecore_Pthread_Worker Ecore_Pthread_Worker;
 typedef struct _Ecore_Pthread        Ecore_Pthread;
 typedef struct _Ecore_Thread_Data    Ecore_Thread_Data;
@@ -66,6 +79,8 @@ struct _Ecore_Thread_Data
 
 struct _Ecore_Pthread_Worker
 {
+   EINA_INLIST;
+
    union
    {
       struct
@@ -110,6 +125,10 @@ struct _Ecore_Pthread_Worker
 
    int                  cancel;
 
+   int                  deque; /* the deque it is pending in, or -1 */
+   int                  home; /* the deque of the worker thread running it */
+   int                  taken; /* the deque it was taken from */
+
    SLK(cancel_mutex);
 
    Eina_Bool            message_run : 1;
@@ -145,6 +164,98 @@ struct _Ecore_Pthread_Message
    Eina_Bool   sync : 1;
 };
 
+/* Pending jobs are spread over one deque per cpu instead of a global list,
+ * so that workers rarely contend on the same lock. A worker takes the oldest
+ * job of its own deque and, when that is empty, steals the newest job of a
+ * randomly chosen other deque. Short jobs and feedback jobs go into separate
+ * lanes: short jobs are always taken first and feedback jobs may not occupy
+ * all the workers, so that long jobs never starve short ones. That bound is
+ * split between the deques feedback jobs are queued on, so that the long
+ * jobs of one deque do not hold back those of the others either. */
+typedef enum
+{
+   ECORE_THREAD_LANE_SHORT = 0,
+   ECORE_THREAD_LANE_FEEDBACK,
+   ECORE_THREAD_LANE_LAST
+} Ecore_Thread_Lane;
+
+/* each deque gets its own cache line so that the workers of different
+ * deques do not bounce the lines holding each other's lock */
+#define ECORE_THREAD_CACHE_LINE 64
+
+typedef struct _Ecore_Thread_Deque Ecore_Thread_Deque;
+struct _Ecore_Thread_Deque
+{
+   SLK(lock);
+   Eina_Inlist *jobs[ECORE_THREAD_LANE_LAST];
+   int feedback_pending;
+   int feedback_running; /* taken from this deque and not done yet */
+}
+#ifdef __GNUC__
+__attribute__ ((aligned (ECORE_THREAD_CACHE_LINE)))
+#endif
+;
+
+typedef struct _Ecore_Thread_Parallel Ecore_Thread_Parallel;
+struct _Ecore_Thread_Parallel
+{
+   Ecore_Thread_Range_Cb func;
+   const void           *data;
+   Eina_Promise         *promise;
+   Ecore_Thread        **jobs;
+
+   unsigned int          start;
+   unsigned int          end;
+   unsigned int          grain;
+   int                   chunks;
+   int                   next; /* next chunk to hand out, shared by the jobs */
+   int                   count;
+   int                   running; /* only touched from the main loop */
+
+   Eina_Bool             cancel : 1;
+};
+
+struct _Ecore_Thread_Task
+{
+   EINA_INLIST;
+
+   Ecore_Thread_Graph *graph;
+   Ecore_Thread_Cb     func;
+   const void         *data;
+   Ecore_Thread       *thread;
+   Eina_List          *next; /* tasks depending on this one */
+
+   unsigned int        deps;
+   unsigned int        wait; /* dependencies not done yet */
+};
+
+struct _Ecore_Thread_Graph
+{
+   Eina_Inlist  *tasks;
+   Eina_Promise *promise;
+
+   unsigned int  count;
+   unsigned int  done;
+   unsigned int  running;
+
+   Eina_Bool     started : 1;
+   Eina_Bool     cancel : 1;
+};
+
+typedef struct _Ecore_Thread_Populate Ecore_Thread_Populate;
+struct _Ecore_Thread_Populate
+{
+   Eina_File         *file;
+   const void        *map;
+   Eina_Promise      *promise;
+   Ecore_Thread      *job;
+
+   unsigned long int  offset;
+   unsigned long int  length;
+   Eina_Error         error;
+   int                running;
+};
+
 static int _ecore_thread_count_max = 0;
 
 static void _ecore_thread_handler(void *data);
@@ -153,8 +264,14 @@ static int _ecore_thread_count = 0;
 static int _ecore_thread_count_no_queue = 0;
 
 static Eina_List *_ecore_running_job = NULL;
-static Eina_List *_ecore_pending_job_threads = NULL;
-static Eina_List *_ecore_pending_job_threads_feedback = NULL;
+static Ecore_Thread_Deque *_ecore_thread_deques = NULL;
+static void *_ecore_thread_deques_mem = NULL;
+static Ecore_Thread_Deque _ecore_thread_deque_fallback;
+static int _ecore_thread_deques_count = 0;
+static int _ecore_thread_deque_next = 0;
+static int _ecore_thread_feedback_next = 0;
+static int _ecore_pending_jobs[ECORE_THREAD_LANE_LAST] = { 0, 0 };
+static Eina_Bool _ecore_thread_affinity = EINA_FALSE;
 static SLK(_ecore_pending_job_threads_mutex);
 static SLK(_ecore_running_job_mutex);
 
@@ -171,6 +288,29 @@ static int _ecore_thread_worker_count = 0;
 static void                 *_ecore_thread_worker(void *);
 static Ecore_Pthread_Worker *_ecore_thread_worker_new(void);
 
+#ifndef __ATOMIC_RELAXED
+static SLK(_ecore_thread_atomic_mutex);
+
+static int
+_ecore_thread_atomic_add(int *x, int v)
+{
+   int r;
+
+   SLKL(_ecore_thread_atomic_mutex);
+   r = (*x += v);
+   SLKU(_ecore_thread_atomic_mutex);
+   return r;
+}
+
+static void
+_ecore_thread_atomic_set(int *x, int v)
+{
+   SLKL(_ecore_thread_atomic_mutex);
+   *x = v;
+   SLKU(_ecore_thread_atomic_mutex);
+}
+#endif
+
 static PH(get_main_loop_thread) (void)
 {
    static PH(main_loop_thread);
@@ -336,6 +476,204 @@ _ecore_message_notify_handler(void *data)
    free(notify);
 }
 
+static inline Ecore_Thread_Lane
+_ecore_thread_lane_get(const Ecore_Pthread_Worker *work)
+{
+   return work->feedback_run ? ECORE_THREAD_LANE_FEEDBACK : ECORE_THREAD_LANE_SHORT;
+}
+
+/* all the workers but a quarter, kept for short jobs */
+static int
+_ecore_thread_feedback_total(void)
+{
+   int max = _ecore_thread_count_max;
+
+   if (max > 1) max -= MAX(max / 4, 1);
+   return max;
+}
+
+/* feedback jobs are queued on no more deques than they may run at once */
+static int
+_ecore_thread_feedback_deques(void)
+{
+   return MIN(_ecore_thread_feedback_total(), _ecore_thread_deques_count);
+}
+
+/* the feedback jobs taken from a deque that may be running at once */
+static int
+_ecore_thread_feedback_max(int idx)
+{
+   int total = _ecore_thread_feedback_total();
+   int count = _ecore_thread_feedback_deques();
+
+   /* queued before the maximum number of threads was lowered */
+   if (idx >= count) return 1;
+   return (total / count) + (idx < (total % count));
+}
+
+static void
+_ecore_thread_deque_push(int idx, Ecore_Pthread_Worker *work)
+{
+   Ecore_Thread_Deque *d = &(_ecore_thread_deques[idx]);
+   Ecore_Thread_Lane lane = _ecore_thread_lane_get(work);
+
+   SLKL(d->lock);
+   d->jobs[lane] = eina_inlist_append(d->jobs[lane], EINA_INLIST_GET(work));
+   ATOMIC_SET(work->deque, idx);
+   ATOMIC_ADD(_ecore_pending_jobs[lane], 1);
+   if (lane == ECORE_THREAD_LANE_FEEDBACK) ATOMIC_ADD(d->feedback_pending, 1);
+   SLKU(d->lock);
+}
+
+/* Jobs are only queued from the main loop, so spread them over all deques */
+static void
+_ecore_thread_job_queue(Ecore_Pthread_Worker *work)
+{
+   int idx;
+
+   if (work->feedback_run)
+     {
+        idx = _ecore_thread_feedback_next % _ecore_thread_feedback_deques();
+        _ecore_thread_feedback_next = idx + 1;
+     }
+   else
+     {
+        idx = _ecore_thread_deque_next;
+        _ecore_thread_deque_next = (idx + 1) % _ecore_thread_deques_count;
+     }
+   _ecore_thread_deque_push(idx, work);
+}
+
+static Ecore_Pthread_Worker *
+_ecore_thread_deque_pop(Ecore_Thread_Deque *d, Ecore_Thread_Lane lane, Eina_Bool steal)
+{
+   Ecore_Pthread_Worker *work = NULL;
+   Eina_Inlist *l;
+
+   SLKL(d->lock);
+   l = d->jobs[lane];
+   if (l)
+     {
+        /* the owner takes the oldest job, thieves take the newest one */
+        if (steal) l = l->last;
+        d->jobs[lane] = eina_inlist_remove(d->jobs[lane], l);
+        work = EINA_INLIST_CONTAINER_GET(l, Ecore_Pthread_Worker);
+        ATOMIC_SET(work->deque, -1);
+        ATOMIC_ADD(_ecore_pending_jobs[lane], -1);
+        if (lane == ECORE_THREAD_LANE_FEEDBACK) ATOMIC_ADD(d->feedback_pending, -1);
+     }
+   SLKU(d->lock);
+
+   return work;
+}
+
+/* Remove a job that is still pending, returns EINA_FALSE if it was taken */
+static Eina_Bool
+_ecore_thread_deque_del(Ecore_Pthread_Worker *work)
+{
+   Ecore_Thread_Lane lane = _ecore_thread_lane_get(work);
+   int idx;
+
+   while ((idx = ATOMIC_GET(work->deque)) >= 0)
+     {
+        Ecore_Thread_Deque *d = &(_ecore_thread_deques[idx]);
+
+        SLKL(d->lock);
+        if (work->deque == idx)
+          {
+             d->jobs[lane] = eina_inlist_remove(d->jobs[lane], EINA_INLIST_GET(work));
+             ATOMIC_SET(work->deque, -1);
+             ATOMIC_ADD(_ecore_pending_jobs[lane], -1);
+             if (lane == ECORE_THREAD_LANE_FEEDBACK) ATOMIC_ADD(d->feedback_pending, -1);
+             SLKU(d->lock);
+             return EINA_TRUE;
+          }
+        SLKU(d->lock);
+     }
+
+   return EINA_FALSE;
+}
+
+static Ecore_Pthread_Worker *
+_ecore_thread_job_pop(int idx, Ecore_Thread_Lane lane, Eina_Bool steal)
+{
+   Ecore_Thread_Deque *d = &(_ecore_thread_deques[idx]);
+   Ecore_Pthread_Worker *work;
+
+   if (lane == ECORE_THREAD_LANE_SHORT)
+     return _ecore_thread_deque_pop(d, lane, steal);
+
+   if (!ATOMIC_GET(d->feedback_pending)) return NULL;
+   if (ATOMIC_ADD(d->feedback_running, 1) > _ecore_thread_feedback_max(idx))
+     {
+        ATOMIC_ADD(d->feedback_running, -1);
+        return NULL;
+     }
+   work = _ecore_thread_deque_pop(d, lane, steal);
+   if (!work)
+     {
+        ATOMIC_ADD(d->feedback_running, -1);
+        return NULL;
+     }
+   work->taken = idx;
+   return work;
+}
+
+static Ecore_Pthread_Worker *
+_ecore_thread_job_take(Ecore_Thread_Lane lane, int home, unsigned int *seed)
+{
+   Ecore_Pthread_Worker *work;
+   int i, victim;
+
+   work = _ecore_thread_job_pop(home, lane, EINA_FALSE);
+   if (!work)
+     {
+        /* xorshift, each worker has its own seed */
+        *seed ^= *seed << 13;
+        *seed ^= *seed >> 17;
+        *seed ^= *seed << 5;
+        victim = *seed % _ecore_thread_deques_count;
+        for (i = 0; (i < _ecore_thread_deques_count) && (!work); i++)
+          {
+             if (!ATOMIC_GET(_ecore_pending_jobs[lane])) break;
+             if (victim != home)
+               work = _ecore_thread_job_pop(victim, lane, EINA_TRUE);
+             victim = (victim + 1) % _ecore_thread_deques_count;
+          }
+     }
+   if (!work) return NULL;
+
+   work->home = home;
+   return work;
+}
+
+static Eina_Bool
+_ecore_thread_job_available(void)
+{
+   int i;
+
+   if (ATOMIC_GET(_ecore_pending_jobs[ECORE_THREAD_LANE_SHORT]) > 0)
+     return EINA_TRUE;
+   if (!ATOMIC_GET(_ecore_pending_jobs[ECORE_THREAD_LANE_FEEDBACK]))
+     return EINA_FALSE;
+   for (i = 0; i < _ecore_thread_deques_count; i++)
+     {
+        Ecore_Thread_Deque *d = &(_ecore_thread_deques[i]);
+
+        if ((ATOMIC_GET(d->feedback_pending) > 0) &&
+            (ATOMIC_GET(d->feedback_running) < _ecore_thread_feedback_max(i)))
+          return EINA_TRUE;
+     }
+   return EINA_FALSE;
+}
+
+static int
+_ecore_thread_affinity_get(int home)
+{
+   if (!_ecore_thread_affinity) return -1;
+   return home % eina_cpu_count();
+}
+
 static void
 _ecore_short_job_cleanup(void *data)
 {
@@ -351,9 +689,7 @@ _ecore_short_job_cleanup(void *data)
      {
         work->reschedule = EINA_FALSE;
 
-        SLKL(_ecore_pending_job_threads_mutex);
-        _ecore_pending_job_threads = eina_list_append(_ecore_pending_job_threads, work);
-        SLKU(_ecore_pending_job_threads_mutex);
+        _ecore_thread_deque_push(work->home, work);
      }
    else
      {
@@ -361,24 +697,14 @@ _ecore_short_job_cleanup(void *data)
      }
 }
 
-static void
-_ecore_short_job(PH(thread))
+static Eina_Bool
+_ecore_short_job(PH(thread), int home, unsigned int *seed)
 {
    Ecore_Pthread_Worker *work;
    int cancel;
 
-   SLKL(_ecore_pending_job_threads_mutex);
-
-   if (!_ecore_pending_job_threads)
-     {
-        SLKU(_ecore_pending_job_threads_mutex);
-        return;
-     }
-
-   work = eina_list_data_get(_ecore_pending_job_threads);
-   _ecore_pending_job_threads = eina_list_remove_list(_ecore_pending_job_threads,
-                                                      _ecore_pending_job_threads);
-   SLKU(_ecore_pending_job_threads_mutex);
+   work = _ecore_thread_job_take(ECORE_THREAD_LANE_SHORT, home, seed);
+   if (!work) return EINA_FALSE;
 
    SLKL(_ecore_running_job_mutex);
    _ecore_running_job = eina_list_append(_ecore_running_job, work);
@@ -394,6 +720,8 @@ _ecore_short_job(PH(thread))
      work->u.short_run.func_blocking((void *)work->data, (Ecore_Thread *)work);
    eina_thread_cancellable_set(EINA_FALSE, NULL);
    EINA_THREAD_CLEANUP_POP(EINA_TRUE);
+
+   return EINA_TRUE;
 }
 
 static void
@@ -407,13 +735,13 @@ _ecore_feedback_job_cleanup(void *data)
    _ecore_running_job = eina_list_remove(_ecore_running_job, work);
    SLKU(_ecore_running_job_mutex);
 
+   ATOMIC_ADD(_ecore_thread_deques[work->taken].feedback_running, -1);
+
    if (work->reschedule)
      {
         work->reschedule = EINA_FALSE;
 
-        SLKL(_ecore_pending_job_threads_mutex);
-        _ecore_pending_job_threads_feedback = eina_list_append(_ecore_pending_job_threads_feedback, work);
-        SLKU(_ecore_pending_job_threads_mutex);
+        _ecore_thread_deque_push(work->taken, work);
      }
    else
      {
@@ -421,24 +749,14 @@ _ecore_feedback_job_cleanup(void *data)
      }
 }
 
-static void
-_ecore_feedback_job(PH(thread))
+static Eina_Bool
+_ecore_feedback_job(PH(thread), int home, unsigned int *seed)
 {
    Ecore_Pthread_Worker *work;
    int cancel;
 
-   SLKL(_ecore_pending_job_threads_mutex);
-
-   if (!_ecore_pending_job_threads_feedback)
-     {
-        SLKU(_ecore_pending_job_threads_mutex);
-        return;
-     }
-
-   work = eina_list_data_get(_ecore_pending_job_threads_feedback);
-   _ecore_pending_job_threads_feedback = eina_list_remove_list(_ecore_pending_job_threads_feedback,
-                                                               _ecore_pending_job_threads_feedback);
-   SLKU(_ecore_pending_job_threads_mutex);
+   work = _ecore_thread_job_take(ECORE_THREAD_LANE_FEEDBACK, home, seed);
+   if (!work) return EINA_FALSE;
    SLKL(_ecore_running_job_mutex);
    _ecore_running_job = eina_list_append(_ecore_running_job, work);
    SLKU(_ecore_running_job_mutex);
@@ -453,6 +771,8 @@ _ecore_feedback_job(PH(thread))
      work->u.feedback_run.func_heavy((void *)work->data, (Ecore_Thread *)work);
    eina_thread_cancellable_set(EINA_FALSE, NULL);
    EINA_THREAD_CLEANUP_POP(EINA_TRUE);
+
+   return EINA_TRUE;
 }
 
 static void
@@ -490,39 +810,39 @@ _ecore_direct_worker(Ecore_Pthread_Worker *work)
 }
 
 static void
-_ecore_thread_worker_cleanup(void *data EINA_UNUSED)
+_ecore_thread_worker_cleanup(void *data)
 {
+   Eina_Bool *released = data;
+
    DBG("cleanup thread=%" PRIuPTR " (should join)", PHS());
    SLKL(_ecore_pending_job_threads_mutex);
-   _ecore_thread_count--;
+   if (!*released) _ecore_thread_count--;
    ecore_main_loop_thread_safe_call_async((Ecore_Cb)_ecore_thread_join,
                                           (void *)(intptr_t)PHS());
    SLKU(_ecore_pending_job_threads_mutex);
 }
 
 static void *
-_ecore_thread_worker(void *data EINA_UNUSED)
+_ecore_thread_worker(void *data)
 {
+   int home = (int)(intptr_t)data;
+   unsigned int seed = ((unsigned int)home + 1) * 2654435761U;
+   Eina_Bool released = EINA_FALSE;
+
    eina_thread_cancellable_set(EINA_FALSE, NULL);
-   EINA_THREAD_CLEANUP_PUSH(_ecore_thread_worker_cleanup, NULL);
+   EINA_THREAD_CLEANUP_PUSH(_ecore_thread_worker_cleanup, &released);
 restart:
 
-   /* these 2 are cancellation points as user cb may enable */
-   _ecore_short_job(PHS());
-   _ecore_feedback_job(PHS());
+   /* these are cancellation points as user cb may enable */
+   /* short jobs go first, then one long job before looking again */
+   while (_ecore_short_job(PHS(), home, &seed));
+   _ecore_feedback_job(PHS(), home, &seed);
 
    /* from here on, cancellations are guaranteed to be disabled */
 
-   /* FIXME: Check if there is feedback running task todo, and switch to feedback run handler. */
    eina_thread_name_set(eina_thread_self(), "Ethread-worker");
 
-   SLKL(_ecore_pending_job_threads_mutex);
-   if (_ecore_pending_job_threads || _ecore_pending_job_threads_feedback)
-     {
-        SLKU(_ecore_pending_job_threads_mutex);
-        goto restart;
-     }
-   SLKU(_ecore_pending_job_threads_mutex);
+   if (_ecore_thread_job_available()) goto restart;
 
    /* Sleep a little to prevent premature death */
 #ifdef _WIN32
@@ -531,12 +851,16 @@ restart:
    usleep(50);
 #endif
 
+   /* jobs are queued before the thread count is checked under this lock,
+    * so either we see the new job here or a new worker gets started */
    SLKL(_ecore_pending_job_threads_mutex);
-   if (_ecore_pending_job_threads || _ecore_pending_job_threads_feedback)
+   if (_ecore_thread_job_available())
      {
         SLKU(_ecore_pending_job_threads_mutex);
         goto restart;
      }
+   _ecore_thread_count--;
+   released = EINA_TRUE;
    SLKU(_ecore_pending_job_threads_mutex);
 
    EINA_THREAD_CLEANUP_POP(EINA_TRUE);
@@ -561,6 +885,7 @@ _ecore_thread_worker_new(void)
         memset(result, 0, sizeof(Ecore_Pthread_Worker));
      }
 
+   result->deque = -1;
    SLKI(result->cancel_mutex);
    LKI(result->mutex);
    CDI(result->cond, result->mutex);
@@ -571,10 +896,48 @@ _ecore_thread_worker_new(void)
 void
 _ecore_thread_init(void)
 {
+   const char *s;
+   int i;
+
    _ecore_thread_count_max = eina_cpu_count() * 4;
    if (_ecore_thread_count_max <= 0)
      _ecore_thread_count_max = 1;
 
+   if (!_ecore_thread_deques)
+     {
+        _ecore_thread_deques_count = eina_cpu_count();
+        if (_ecore_thread_deques_count <= 0)
+          _ecore_thread_deques_count = 1;
+        /* calloc does not align on a cache line, do it by hand */
+        _ecore_thread_deques_mem = calloc(1, _ecore_thread_deques_count *
+                                          sizeof(Ecore_Thread_Deque) +
+                                          ECORE_THREAD_CACHE_LINE - 1);
+        if (_ecore_thread_deques_mem)
+          {
+             _ecore_thread_deques = (Ecore_Thread_Deque *)
+               (((uintptr_t)_ecore_thread_deques_mem + ECORE_THREAD_CACHE_LINE - 1) &
+                ~((uintptr_t)ECORE_THREAD_CACHE_LINE - 1));
+          }
+        else
+          {
+             /* everything still works with a single global deque */
+             _ecore_thread_deques = &_ecore_thread_deque_fallback;
+             _ecore_thread_deques_count = 1;
+          }
+        for (i = 0; i < _ecore_thread_deques_count; i++)
+          SLKI(_ecore_thread_deques[i].lock);
+     }
+   _ecore_thread_deque_next = 0;
+   _ecore_thread_feedback_next = 0;
+
+   /* pin each worker to the cpu of its deque, only worth it on machines
+    * dedicated to the application */
+   s = getenv("ECORE_THREAD_AFFINITY");
+   _ecore_thread_affinity = (s && atoi(s));
+
+#ifndef __ATOMIC_RELAXED
+   SLKI(_ecore_thread_atomic_mutex);
+#endif
    SLKI(_ecore_pending_job_threads_mutex);
    LRWKI(_ecore_thread_global_hash_lock);
    LKI(_ecore_thread_global_hash_mutex);
@@ -590,24 +953,17 @@ _ecore_thread_shutdown(void)
    Eina_List *l;
    Eina_Bool test;
    int iteration = 0;
+   int i, lane;
 
-   SLKL(_ecore_pending_job_threads_mutex);
-
-   EINA_LIST_FREE(_ecore_pending_job_threads, work)
-     {
-        if (work->func_cancel)
-          work->func_cancel((void *)work->data, (Ecore_Thread *)work);
-        free(work);
-     }
-
-   EINA_LIST_FREE(_ecore_pending_job_threads_feedback, work)
-     {
-        if (work->func_cancel)
-          work->func_cancel((void *)work->data, (Ecore_Thread *)work);
-        free(work);
-     }
+   for (i = 0; i < _ecore_thread_deques_count; i++)
+     for (lane = 0; lane < ECORE_THREAD_LANE_LAST; lane++)
+       while ((work = _ecore_thread_deque_pop(&(_ecore_thread_deques[i]), lane, EINA_FALSE)))
+         {
+            if (work->func_cancel)
+              work->func_cancel((void *)work->data, (Ecore_Thread *)work);
+            free(work);
+         }
 
-   SLKU(_ecore_pending_job_threads_mutex);
    SLKL(_ecore_running_job_mutex);
 
    EINA_LIST_FOREACH(_ecore_running_job, l, work)
@@ -635,9 +991,9 @@ _ecore_thread_shutdown(void)
           }
      } while (test == EINA_TRUE && iteration < 50);
 
-   if (iteration == 20 && _ecore_thread_count > 0)
+   if (test)
      {
-        ERR("%i of the child thread are still running after 1s. This can lead to a segv. Sorry.", _ecore_thread_count);
+        ERR("%i of the child thread are still running at shutdown. This can lead to a segv. Sorry.", _ecore_thread_count);
      }
 
    if (_ecore_thread_global_hash)
@@ -649,7 +1005,23 @@ _ecore_thread_shutdown(void)
         free(work);
      }
 
+   /* workers still running look for jobs in the deques until they are
+    * done, so the deques are only freed once they are all gone, or else
+    * kept for the next init */
+   if (!test)
+     {
+        for (i = 0; i < _ecore_thread_deques_count; i++)
+          SLKD(_ecore_thread_deques[i].lock);
+        free(_ecore_thread_deques_mem);
+        _ecore_thread_deques_mem = NULL;
+        _ecore_thread_deques = NULL;
+        _ecore_thread_deques_count = 0;
+     }
+
    SLKD(_ecore_pending_job_threads_mutex);
+#ifndef __ATOMIC_RELAXED
+   SLKD(_ecore_thread_atomic_mutex);
+#endif
    LRWKD(_ecore_thread_global_hash_lock);
    LKD(_ecore_thread_global_hash_mutex);
    SLKD(_ecore_running_job_mutex);
@@ -664,6 +1036,7 @@ ecore_thread_run(Ecore_Thread_Cb func_blocking,
 {
    Ecore_Pthread_Worker *work;
    Eina_Bool tried = EINA_FALSE;
+   int home;
    PH(thread);
 
    EINA_MAIN_LOOP_CHECK_RETURN_VAL(NULL);
@@ -692,9 +1065,9 @@ ecore_thread_run(Ecore_Thread_Cb func_blocking,
    work->self = 0;
    work->hash = NULL;
 
-   SLKL(_ecore_pending_job_threads_mutex);
-   _ecore_pending_job_threads = eina_list_append(_ecore_pending_job_threads, work);
+   _ecore_thread_job_queue(work);
 
+   SLKL(_ecore_pending_job_threads_mutex);
    if (_ecore_thread_count == _ecore_thread_count_max)
      {
         SLKU(_ecore_pending_job_threads_mutex);
@@ -709,7 +1082,9 @@ ecore_thread_run(Ecore_Thread_Cb func_blocking,
    SLKL(_ecore_pending_job_threads_mutex);
 
 retry:
-   if (PHC(thread, _ecore_thread_worker, NULL))
+   home = _ecore_thread_count % _ecore_thread_deques_count;
+   if (PHCA(thread, _ecore_thread_worker, (void *)(intptr_t)home,
+            _ecore_thread_affinity_get(home)))
      {
         _ecore_thread_count++;
         SLKU(_ecore_pending_job_threads_mutex);
@@ -724,7 +1099,7 @@ retry:
 
    if (_ecore_thread_count == 0)
      {
-        _ecore_pending_job_threads = eina_list_remove(_ecore_pending_job_threads, work);
+        _ecore_thread_deque_del(work);
 
         if (work->func_cancel)
           work->func_cancel((void *)work->data, (Ecore_Thread *)work);
@@ -743,7 +1118,6 @@ EAPI Eina_Bool
 ecore_thread_cancel(Ecore_Thread *thread)
 {
    Ecore_Pthread_Worker *volatile work = (Ecore_Pthread_Worker *)thread;
-   Eina_List *l;
    int cancel;
 
    if (!work)
@@ -762,49 +1136,19 @@ ecore_thread_cancel(Ecore_Thread *thread)
           goto on_exit;
      }
 
-   SLKL(_ecore_pending_job_threads_mutex);
-
    if ((have_main_loop_thread) &&
        (PHE(get_main_loop_thread(), PHS())))
      {
-        if (!work->feedback_run)
-          EINA_LIST_FOREACH(_ecore_pending_job_threads, l, work)
-            {
-               if ((void *)work == (void *)thread)
-                 {
-                    _ecore_pending_job_threads = eina_list_remove_list(_ecore_pending_job_threads, l);
-
-                    SLKU(_ecore_pending_job_threads_mutex);
-
-                    if (work->func_cancel)
-                      work->func_cancel((void *)work->data, (Ecore_Thread *)work);
-                    free(work);
-
-                    return EINA_TRUE;
-                 }
-            }
-        else
-          EINA_LIST_FOREACH(_ecore_pending_job_threads_feedback, l, work)
-            {
-               if ((void *)work == (void *)thread)
-                 {
-                    _ecore_pending_job_threads_feedback = eina_list_remove_list(_ecore_pending_job_threads_feedback, l);
-
-                    SLKU(_ecore_pending_job_threads_mutex);
-
-                    if (work->func_cancel)
-                      work->func_cancel((void *)work->data, (Ecore_Thread *)work);
-                    free(work);
+        if (_ecore_thread_deque_del(work))
+          {
+             if (work->func_cancel)
+               work->func_cancel((void *)work->data, (Ecore_Thread *)work);
+             free(work);
 
-                    return EINA_TRUE;
-                 }
-            }
+             return EINA_TRUE;
+          }
      }
 
-   SLKU(_ecore_pending_job_threads_mutex);
-
-   work = (Ecore_Pthread_Worker *)thread;
-
    /* Delay the destruction */
 on_exit:
    eina_thread_cancel(work->self); /* noop unless eina_thread_cancellable_set() was used by user */
@@ -919,6 +1263,7 @@ ecore_thread_feedback_run(Ecore_Thread_Cb func_heavy,
 {
    Ecore_Pthread_Worker *worker;
    Eina_Bool tried = EINA_FALSE;
+   int home;
    PH(thread);
 
    EINA_MAIN_LOOP_CHECK_RETURN_VAL(NULL);
@@ -981,9 +1326,9 @@ retry_direct:
 
    worker->no_queue = EINA_FALSE;
 
-   SLKL(_ecore_pending_job_threads_mutex);
-   _ecore_pending_job_threads_feedback = eina_list_append(_ecore_pending_job_threads_feedback, worker);
+   _ecore_thread_job_queue(worker);
 
+   SLKL(_ecore_pending_job_threads_mutex);
    if (_ecore_thread_count == _ecore_thread_count_max)
      {
         SLKU(_ecore_pending_job_threads_mutex);
@@ -997,7 +1342,9 @@ retry_direct:
 
    SLKL(_ecore_pending_job_threads_mutex);
 retry:
-   if (PHC(thread, _ecore_thread_worker, NULL))
+   home = _ecore_thread_count % _ecore_thread_deques_count;
+   if (PHCA(thread, _ecore_thread_worker, (void *)(intptr_t)home,
+            _ecore_thread_affinity_get(home)))
      {
         _ecore_thread_count++;
         SLKU(_ecore_pending_job_threads_mutex);
@@ -1017,8 +1364,7 @@ on_error:
    SLKL(_ecore_pending_job_threads_mutex);
    if (_ecore_thread_count == 0)
      {
-        _ecore_pending_job_threads_feedback = eina_list_remove(_ecore_pending_job_threads_feedback,
-                                                               worker);
+        if (worker) _ecore_thread_deque_del(worker);
 
         if (func_cancel) func_cancel((void *)data, NULL);
 
@@ -1173,9 +1519,7 @@ ecore_thread_pending_get(void)
    int ret;
 
    EINA_MAIN_LOOP_CHECK_RETURN_VAL(0);
-   SLKL(_ecore_pending_job_threads_mutex);
-   ret = eina_list_count(_ecore_pending_job_threads);
-   SLKU(_ecore_pending_job_threads_mutex);
+   ret = ATOMIC_GET(_ecore_pending_jobs[ECORE_THREAD_LANE_SHORT]);
    return ret;
 }
 
@@ -1185,9 +1529,7 @@ ecore_thread_pending_feedback_get(void)
    int ret;
 
    EINA_MAIN_LOOP_CHECK_RETURN_VAL(0);
-   SLKL(_ecore_pending_job_threads_mutex);
-   ret = eina_list_count(_ecore_pending_job_threads_feedback);
-   SLKU(_ecore_pending_job_threads_mutex);
+   ret = ATOMIC_GET(_ecore_pending_jobs[ECORE_THREAD_LANE_FEEDBACK]);
    return ret;
 }
 
@@ -1197,9 +1539,8 @@ ecore_thread_pending_total_get(void)
    int ret;
 
    EINA_MAIN_LOOP_CHECK_RETURN_VAL(0);
-   SLKL(_ecore_pending_job_threads_mutex);
-   ret = eina_list_count(_ecore_pending_job_threads) + eina_list_count(_ecore_pending_job_threads_feedback);
-   SLKU(_ecore_pending_job_threads_mutex);
+   ret = ATOMIC_GET(_ecore_pending_jobs[ECORE_THREAD_LANE_SHORT]) +
+     ATOMIC_GET(_ecore_pending_jobs[ECORE_THREAD_LANE_FEEDBACK]);
    return ret;
 }
 
@@ -1239,6 +1580,486 @@ ecore_thread_available_get(void)
    return ret;
 }
 
+static void
+_ecore_thread_parallel_blocking(void *data, Ecore_Thread *thread)
+{
+   Ecore_Thread_Parallel *pf = data;
+   unsigned int start, end;
+   int idx;
+
+   while (!ecore_thread_check(thread))
+     {
+        idx = ATOMIC_ADD(pf->next, 1) - 1;
+        if (idx >= pf->chunks) break;
+
+        start = pf->start + (unsigned int)idx * pf->grain;
+        end = (pf->end - start > pf->grain) ? start + pf->grain : pf->end;
+        pf->func((void *)pf->data, thread, start, end);
+     }
+}
+
+static void
+_ecore_thread_parallel_done(void *data, Ecore_Thread *thread)
+{
+   Ecore_Thread_Parallel *pf = data;
+   int i;
+
+   for (i = 0; thread && i < pf->count; i++)
+     if (pf->jobs[i] == thread)
+       {
+          pf->jobs[i] = NULL;
+          break;
+       }
+
+   if (--pf->running) return;
+
+   if (pf->promise)
+     {
+        if ((!pf->cancel) && (ATOMIC_GET(pf->next) >= pf->chunks))
+          eina_promise_resolve(pf->promise, EINA_VALUE_EMPTY);
+        else
+          eina_promise_reject(pf->promise, ECANCELED);
+     }
+   free(pf->jobs);
+   free(pf);
+}
+
+static void
+_ecore_thread_parallel_cancel(void *data, const Eina_Promise *dead EINA_UNUSED)
+{
+   Ecore_Thread_Parallel *pf = data;
+   int i;
+
+   pf->promise = NULL;
+   pf->cancel = EINA_TRUE;
+   if (!pf->running) return; /* the promise could not be created */
+
+   /* pending jobs are cancelled right away, keep pf alive until the end */
+   pf->running++;
+   for (i = 0; i < pf->count; i++)
+     if (pf->jobs[i]) ecore_thread_cancel(pf->jobs[i]);
+   _ecore_thread_parallel_done(pf, NULL);
+}
+
+EAPI Eina_Future *
+ecore_thread_parallel_for(unsigned int start,
+                          unsigned int end,
+                          unsigned int grain,
+                          Ecore_Thread_Range_Cb func,
+                          const void *data)
+{
+   Ecore_Thread_Parallel *pf;
+   Eina_Future *f;
+   unsigned int range, chunks;
+   int i, max;
+
+   EINA_MAIN_LOOP_CHECK_RETURN_VAL(NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(func, NULL);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(end < start, NULL);
+
+   max = ecore_thread_max_get();
+   if (max < 1) max = 1;
+   range = end - start;
+   /* a few chunks per job, so that uneven chunks still balance out */
+   if (!grain) grain = range / ((unsigned int)max * 4);
+   if (!grain) grain = 1;
+   chunks = range / grain + !!(range % grain);
+   /* chunk indexes are handed out with int atomics */
+   if (chunks > INT_MAX / 2)
+     {
+        grain = range / (INT_MAX / 2) + 1;
+        chunks = range / grain + !!(range % grain);
+     }
+
+   pf = calloc(1, sizeof (Ecore_Thread_Parallel));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(pf, NULL);
+   pf->func = func;
+   pf->data = data;
+   pf->start = start;
+   pf->end = end;
+   pf->grain = grain;
+   pf->chunks = chunks;
+   pf->count = ((int)chunks < max) ? (int)chunks : max;
+
+   pf->jobs = calloc(pf->count ? pf->count : 1, sizeof (Ecore_Thread *));
+   if (!pf->jobs) goto on_error;
+   pf->promise = eina_promise_new(efl_loop_future_scheduler_get(ML_OBJ),
+                                  _ecore_thread_parallel_cancel, pf);
+   if (!pf->promise) goto on_error;
+   /* a failed future cancels the promise, which leaves pf to us */
+   f = eina_future_new(pf->promise);
+   if (!f) goto on_error;
+
+   /* hold one reference until all the jobs are queued, as a job that can
+    * not be started is cancelled before ecore_thread_run() returns */
+   pf->running = 1;
+   for (i = 0; i < pf->count; i++)
+     {
+        pf->running++;
+        pf->jobs[i] = ecore_thread_run(_ecore_thread_parallel_blocking,
+                                       _ecore_thread_parallel_done,
+                                       _ecore_thread_parallel_done,
+                                       pf);
+        if (!pf->jobs[i]) break;
+     }
+   _ecore_thread_parallel_done(pf, NULL);
+
+   return f;
+
+on_error:
+   free(pf->jobs);
+   free(pf);
+   return NULL;
+}
+
+EAPI Ecore_Thread_Graph *
+ecore_thread_graph_new(void)
+{
+   return calloc(1, sizeof (Ecore_Thread_Graph));
+}
+
+static void
+_ecore_thread_graph_del(Ecore_Thread_Graph *graph)
+{
+   Ecore_Thread_Task *task;
+
+   while (graph->tasks)
+     {
+        task = EINA_INLIST_CONTAINER_GET(graph->tasks, Ecore_Thread_Task);
+        graph->tasks = eina_inlist_remove(graph->tasks, graph->tasks);
+        eina_list_free(task->next);
+        free(task);
+     }
+   free(graph);
+}
+
+EAPI void
+ecore_thread_graph_free(Ecore_Thread_Graph *graph)
+{
+   if (!graph) return;
+   EINA_SAFETY_ON_TRUE_RETURN(graph->started);
+
+   _ecore_thread_graph_del(graph);
+}
+
+EAPI Ecore_Thread_Task *
+ecore_thread_graph_task_add(Ecore_Thread_Graph *graph,
+                            Ecore_Thread_Cb func,
+                            const void *data)
+{
+   Ecore_Thread_Task *task;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(graph, NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(func, NULL);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(graph->started, NULL);
+
+   task = calloc(1, sizeof (Ecore_Thread_Task));
+   if (!task) return NULL;
+   task->graph = graph;
+   task->func = func;
+   task->data = data;
+
+   graph->tasks = eina_inlist_append(graph->tasks, EINA_INLIST_GET(task));
+   graph->count++;
+
+   return task;
+}
+
+EAPI Eina_Bool
+ecore_thread_graph_task_depend(Ecore_Thread_Task *task,
+                               Ecore_Thread_Task *before)
+{
+   Eina_List *l;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(task, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(before, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(task->graph != before->graph, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(task->graph->started, EINA_FALSE);
+
+   l = eina_list_append(before->next, task);
+   if (!l) return EINA_FALSE;
+   before->next = l;
+   task->deps++;
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_ecore_thread_graph_acyclic(Ecore_Thread_Graph *graph)
+{
+   Ecore_Thread_Task **queue, *task, *next;
+   unsigned int head = 0, tail = 0;
+   Eina_List *l;
+
+   if (!graph->count) return EINA_TRUE;
+
+   queue = malloc(graph->count * sizeof (Ecore_Thread_Task *));
+   if (!queue) return EINA_FALSE;
+
+   EINA_INLIST_FOREACH(graph->tasks, task)
+     {
+        task->wait = task->deps;
+        if (!task->wait) queue[tail++] = task;
+     }
+   while (head < tail)
+     {
+        task = queue[head++];
+        EINA_LIST_FOREACH(task->next, l, next)
+          if (!--next->wait) queue[tail++] = next;
+     }
+   free(queue);
+
+   EINA_INLIST_FOREACH(graph->tasks, task)
+     task->wait = task->deps;
+
+   return tail == graph->count;
+}
+
+static void _ecore_thread_graph_task_launch(Ecore_Thread_Task *task);
+
+static void
+_ecore_thread_graph_unref(Ecore_Thread_Graph *graph)
+{
+   if (--graph->running) return;
+
+   if (graph->promise)
+     {
+        if ((!graph->cancel) && (graph->done == graph->count))
+          eina_promise_resolve(graph->promise, EINA_VALUE_EMPTY);
+        else
+          eina_promise_reject(graph->promise, ECANCELED);
+     }
+   _ecore_thread_graph_del(graph);
+}
+
+static void
+_ecore_thread_graph_cancel_all(Ecore_Thread_Graph *graph)
+{
+   Ecore_Thread_Task *task;
+
+   if (graph->cancel) return;
+   graph->cancel = EINA_TRUE;
+
+   EINA_INLIST_FOREACH(graph->tasks, task)
+     if (task->thread) ecore_thread_cancel(task->thread);
+}
+
+static void
+_ecore_thread_graph_task_blocking(void *data, Ecore_Thread *thread)
+{
+   Ecore_Thread_Task *task = data;
+
+   task->func((void *)task->data, thread);
+}
+
+static void
+_ecore_thread_graph_task_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Ecore_Thread_Task *task = data;
+   Ecore_Thread_Graph *graph = task->graph;
+   Ecore_Thread_Task *next;
+   Eina_List *l;
+
+   task->thread = NULL;
+   graph->done++;
+   if (!graph->cancel)
+     {
+        EINA_LIST_FOREACH(task->next, l, next)
+          if (!--next->wait) _ecore_thread_graph_task_launch(next);
+     }
+   _ecore_thread_graph_unref(graph);
+}
+
+static void
+_ecore_thread_graph_task_cancel(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Ecore_Thread_Task *task = data;
+   Ecore_Thread_Graph *graph = task->graph;
+
+   task->thread = NULL;
+   /* the tasks depending on this one will never run */
+   _ecore_thread_graph_cancel_all(graph);
+   _ecore_thread_graph_unref(graph);
+}
+
+static void
+_ecore_thread_graph_task_launch(Ecore_Thread_Task *task)
+{
+   task->graph->running++;
+   task->thread = ecore_thread_run(_ecore_thread_graph_task_blocking,
+                                   _ecore_thread_graph_task_end,
+                                   _ecore_thread_graph_task_cancel,
+                                   task);
+}
+
+static void
+_ecore_thread_graph_cancel(void *data, const Eina_Promise *dead EINA_UNUSED)
+{
+   Ecore_Thread_Graph *graph = data;
+
+   graph->promise = NULL;
+   if (!graph->running) return; /* the promise could not be created */
+
+   graph->running++;
+   _ecore_thread_graph_cancel_all(graph);
+   _ecore_thread_graph_unref(graph);
+}
+
+EAPI Eina_Future *
+ecore_thread_graph_run(Ecore_Thread_Graph *graph)
+{
+   Eina_Future_Scheduler *sched;
+   Ecore_Thread_Task *task;
+   Eina_Future *f;
+
+   EINA_MAIN_LOOP_CHECK_RETURN_VAL(NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(graph, NULL);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(graph->started, NULL);
+
+   graph->started = EINA_TRUE;
+   sched = efl_loop_future_scheduler_get(ML_OBJ);
+   if (!_ecore_thread_graph_acyclic(graph))
+     {
+        _ecore_thread_graph_del(graph);
+        return eina_future_rejected(sched, EINVAL);
+     }
+
+   graph->promise = eina_promise_new(sched, _ecore_thread_graph_cancel, graph);
+   if (!graph->promise)
+     {
+        _ecore_thread_graph_del(graph);
+        return NULL;
+     }
+   f = eina_future_new(graph->promise);
+   if (!f)
+     {
+        _ecore_thread_graph_del(graph);
+        return NULL;
+     }
+
+   /* same as parallel_for, a task that can not be started is cancelled
+    * synchronously, so hold a reference while launching the roots */
+   graph->running = 1;
+   EINA_INLIST_FOREACH(graph->tasks, task)
+     {
+        if (graph->cancel) break;
+        if (!task->wait) _ecore_thread_graph_task_launch(task);
+     }
+   _ecore_thread_graph_unref(graph);
+
+   return f;
+}
+
+/* a cancelled populate stops at the next chunk */
+#define ECORE_THREAD_POPULATE_CHUNK (2 * 1024 * 1024)
+
+static void
+_ecore_thread_populate_blocking(void *data, Ecore_Thread *thread)
+{
+   Ecore_Thread_Populate *pop = data;
+   unsigned long int done = 0, len;
+
+   if (!pop->length)
+     {
+        pop->error = eina_file_map_prefetch(pop->file, pop->map, pop->offset, 0);
+        return;
+     }
+
+   while ((done < pop->length) && (!ecore_thread_check(thread)))
+     {
+        len = pop->length - done;
+        if (len > ECORE_THREAD_POPULATE_CHUNK) len = ECORE_THREAD_POPULATE_CHUNK;
+        pop->error = eina_file_map_prefetch(pop->file, pop->map,
+                                            pop->offset + done, len);
+        if (pop->error) break;
+        done += len;
+     }
+}
+
+static void
+_ecore_thread_populate_done(void *data, Ecore_Thread *thread)
+{
+   Ecore_Thread_Populate *pop = data;
+
+   if (thread) pop->job = NULL;
+   if (--pop->running) return;
+
+   if (pop->promise)
+     {
+        if (pop->error) eina_promise_reject(pop->promise, pop->error);
+        else eina_promise_resolve(pop->promise, EINA_VALUE_EMPTY);
+     }
+   eina_file_close(pop->file);
+   free(pop);
+}
+
+static void
+_ecore_thread_populate_job_cancel(void *data, Ecore_Thread *thread)
+{
+   Ecore_Thread_Populate *pop = data;
+
+   if (!pop->error) pop->error = ECANCELED;
+   _ecore_thread_populate_done(pop, thread);
+}
+
+static void
+_ecore_thread_populate_cancel(void *data, const Eina_Promise *dead EINA_UNUSED)
+{
+   Ecore_Thread_Populate *pop = data;
+
+   pop->promise = NULL;
+   /* a pending job is cancelled right away and frees pop */
+   if (pop->job) ecore_thread_cancel(pop->job);
+}
+
+EAPI Eina_Future *
+ecore_thread_file_map_populate(Eina_File *file,
+                               const void *map,
+                               unsigned long int offset,
+                               unsigned long int length)
+{
+   Ecore_Thread_Populate *pop;
+   Ecore_Thread *job;
+   Eina_Future *f;
+
+   EINA_MAIN_LOOP_CHECK_RETURN_VAL(NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, NULL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(map, NULL);
+
+   pop = calloc(1, sizeof (Ecore_Thread_Populate));
+   EINA_SAFETY_ON_NULL_RETURN_VAL(pop, NULL);
+   pop->file = eina_file_dup(file);
+   pop->map = map;
+   pop->offset = offset;
+   pop->length = length;
+   pop->promise = eina_promise_new(efl_loop_future_scheduler_get(ML_OBJ),
+                                   _ecore_thread_populate_cancel, pop);
+   if (!pop->promise)
+     {
+        eina_file_close(pop->file);
+        free(pop);
+        return NULL;
+     }
+   f = eina_future_new(pop->promise);
+   if (!f)
+     {
+        eina_file_close(pop->file);
+        free(pop);
+        return NULL;
+     }
+
+   /* same as parallel_for, hold a reference while starting the job */
+   pop->running = 2;
+   job = ecore_thread_run(_ecore_thread_populate_blocking,
+                          _ecore_thread_populate_done,
+                          _ecore_thread_populate_job_cancel,
+                          pop);
+   if (job) pop->job = job;
+   _ecore_thread_populate_done(pop, NULL);
+
+   return f;
+}
+
 EAPI Eina_Bool
 ecore_thread_local_data_add(Ecore_Thread *thread,
                             const char *key,
@@ -69,25 +69,19 @@ _efl_generic_model_efl_model_property_set(Eo *obj, Efl_Generic_Model_Data *pd, c
 
    if (!exist)
      {
-        exist = eina_value_new(eina_value_type_get(value));
+        // eina_value_copy() will set it up
+        exist = eina_value_new(NULL);
         if (!exist)
           goto value_failed;
 
         if (!eina_hash_direct_add(pd->properties, eina_stringshare_ref(prop), exist))
           goto hash_failed;
      }
+   else eina_value_flush(exist);
 
    if (!eina_value_copy(value, exist))
      goto value_failed;
 
-   {
-      char *v = eina_value_to_string(value);
-      char *e = eina_value_to_string(exist);
-
-      free(v);
-      free(e);
-   }
-
    eina_stringshare_del(prop);
 
    evt.changed_properties = eina_array_new(1);
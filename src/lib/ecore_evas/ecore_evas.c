@@ -146,6 +146,20 @@ _ecore_evas_idle_exiter(void *data EINA_UNUSED)
    return ECORE_CALLBACK_RENEW;
 }
 
+/* Whether software canvases render asynchronously, on the single render
+ * thread of evas. With more than one cpu they render synchronously when
+ * evas is built with pipe rendering, their draws are then binned into
+ * tiles rasterized on all cpus. */
+EAPI Eina_Bool
+_ecore_evas_software_async_render_get(void)
+{
+   if (getenv("ECORE_EVAS_FORCE_SYNC_RENDER")) return EINA_FALSE;
+#ifdef BUILD_PIPE_RENDER
+   if (eina_cpu_count() > 1) return EINA_FALSE;
+#endif
+   return EINA_TRUE;
+}
+
 EAPI void
 ecore_evas_render_wait(Ecore_Evas *ee)
 {
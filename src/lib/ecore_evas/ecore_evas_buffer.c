@@ -809,10 +809,7 @@ ecore_evas_buffer_allocfunc_new(int w, int h,
    ee->req.h = ee->h;
    ee->profile_supported = 1;
 
-   if (getenv("ECORE_EVAS_FORCE_SYNC_RENDER"))
-     ee->can_async_render = 0;
-   else
-     ee->can_async_render = 1;
+   ee->can_async_render = _ecore_evas_software_async_render_get();
 
    ee->prop.max.w = 0;
    ee->prop.max.h = 0;
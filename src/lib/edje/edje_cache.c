@@ -286,6 +286,25 @@ _edje_file_coll_open(Edje_File *edf, const char *coll)
 extern size_t  _edje_data_string_mapping_size;
 extern void   *_edje_data_string_mapping;
 
+// reads the whole file in a thread, so that decoding the header, images,
+// fonts and scripts of a cold theme doesn't stall on page faults. eet keeps
+// the same map for as long as the file is open. this costs the IO and page
+// cache of the parts of the file never used, so it is only done when
+// EDJE_FILE_PREFETCH is set, for setups that open few and mostly used
+// themes from slow storage.
+static void
+_edje_file_prefetch(const Eina_File *f)
+{
+   void *map;
+
+   if (!getenv("EDJE_FILE_PREFETCH")) return;
+   if (!eina_main_loop_is()) return;
+   map = eina_file_map_all((Eina_File *)f, EINA_FILE_SEQUENTIAL);
+   if (!map) return;
+   ecore_thread_file_map_populate((Eina_File *)f, map, 0, 0);
+   eina_file_map_free((Eina_File *)f, map);
+}
+
 static Edje_File *
 _edje_file_open(const Eina_File *f, int *error_ret, time_t mtime, Eina_Bool coll)
 {
@@ -306,6 +325,7 @@ _edje_file_open(const Eina_File *f, int *error_ret, time_t mtime, Eina_Bool coll
         *error_ret = EDJE_LOAD_ERROR_UNKNOWN_FORMAT;
         return NULL;
      }
+   _edje_file_prefetch(f);
    // XXX: ancient edje file workaround
    mapping = eina_file_map_all((Eina_File *)f, EINA_FILE_SEQUENTIAL);
    if (mapping)
@@ -120,6 +120,8 @@ edje_init(void)
    EINA_SAFETY_ON_NULL_GOTO(_edje_calc_params_map_cow, shutdown_all);
    _edje_calc_params_physics_cow = eina_cow_add("Edje Calc Params Physics", sizeof (Edje_Calc_Params_Physics), 8, &default_calc_physics, EINA_TRUE);
    EINA_SAFETY_ON_NULL_GOTO(_edje_calc_params_physics_cow, shutdown_all);
+   eina_cow_gc_background_set(_edje_calc_params_map_cow, EINA_TRUE);
+   eina_cow_gc_background_set(_edje_calc_params_physics_cow, EINA_TRUE);
 
    _edje_language = eina_stringshare_add(getenv("LANGUAGE"));
 
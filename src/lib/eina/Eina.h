@@ -250,6 +250,7 @@ extern "C" {
 #include <eina_ustrbuf.h>
 #include <eina_unicode.h>
 #include <eina_quadtree.h>
+#include <eina_rtree.h>
 #include <eina_simple_xml_parser.h>
 #include <eina_lock.h>
 #include <eina_thread.h> /* after eina_lock.h since it will include pthread.h with proper flags */
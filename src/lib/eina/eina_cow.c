@@ -35,7 +35,9 @@
 #include "eina_types.h"
 #include "eina_safety_checks.h"
 #include "eina_list.h"
+#include "eina_inlist.h"
 #include "eina_hash.h"
+#include "eina_inline_private.h"
 
 #include "eina_cow.h"
 
@@ -63,17 +65,21 @@ struct _Eina_Cow_Ptr
 # endif
 #endif
    int refcount;
+   /* hash of the content, computed once by the gc and kept as long as the
+      block sits in the match table so unsharing it never rehashes */
+   unsigned int hash;
+   Eina_Cow_GC *togc;
 
 #ifdef EINA_COW_MAGIC_ON
    unsigned int writing;
 #endif
 
    Eina_Bool hashed : 1;
-   Eina_Bool togc : 1;
 };
 
 struct _Eina_Cow_GC
 {
+   EINA_INLIST;
 #ifdef EINA_COW_MAGIC_ON
    EINA_MAGIC;
 #endif
@@ -87,7 +93,7 @@ struct _Eina_Cow
    EINA_MAGIC;
 #endif
 
-   Eina_Hash *togc;
+   Eina_Inlist *togc;
    Eina_Hash *match;
 
    Eina_Mempool *pool;
@@ -95,9 +101,15 @@ struct _Eina_Cow
 
    unsigned int struct_size;
    unsigned int total_size;
-};
 
-typedef int (*Eina_Cow_Hash)(const void *, int);
+   unsigned int blocks;
+   unsigned int refs;
+   unsigned int pending;
+   unsigned int merged;
+
+   Eina_Bool gc : 1;
+   Eina_Bool background : 1;
+};
 
 #ifdef EINA_COW_MAGIC_ON
 # define EINA_COW_MAGIC_CHECK(d)                        \
@@ -145,40 +157,8 @@ static int _eina_cow_log_dom = -1;
 
 static Eina_Mempool *gc_pool = NULL;
 
-static inline int
-_eina_cow_hash_gen(const void *key, int key_length,
-                   Eina_Cow_Hash hash,
-                   int size)
-{
-   const unsigned char *walk = key;
-   int r = 0xDEADBEEF;
-
-   while (key_length > 0)
-     {
-        r ^= hash(walk, size);
-
-        walk += size;
-        key_length -= size;
-     }
-
-   return r;
-}
-
-#ifdef EFL64
-static int
-_eina_cow_hash64(const void *key, int key_length)
-{
-   return _eina_cow_hash_gen(key, key_length,
-                             (Eina_Cow_Hash) eina_hash_int64, sizeof (unsigned long long int));
-}
-#else
-static int
-_eina_cow_hash32(const void *key, int key_length)
-{
-   return _eina_cow_hash_gen(key, key_length,
-                             (Eina_Cow_Hash) eina_hash_int32, sizeof (int));
-}
-#endif
+/* Cows that eina_cow_gc_background_run() walks, see eina_cow_gc_background_set() */
+static Eina_List *background_cows = NULL;
 
 static int current_cow_size = 0;
 
@@ -207,23 +187,22 @@ _eina_cow_hash_del(Eina_Cow *cow,
    if (!ref->hashed) return;
 
    current_cow_size = cow->struct_size;
-   eina_hash_del(cow->match, data, data);
+   eina_hash_del_by_hash(cow->match, data, cow->struct_size, ref->hash, data);
    ref->hashed = EINA_FALSE;
 }
 
-static void
-_eina_cow_gc_free(void *data)
-{
-   eina_mempool_free(gc_pool, data);
-}
-
 static inline void
 _eina_cow_togc_del(Eina_Cow *cow, Eina_Cow_Ptr *ref)
 {
+   Eina_Cow_GC *gc;
+
    /* eina_cow_gc is not supposed to be thread safe */
-   if (!ref->togc) return;
-   eina_hash_del(cow->togc, &ref, NULL);
-   ref->togc = EINA_FALSE;
+   gc = ref->togc;
+   if (!gc) return;
+   cow->togc = eina_inlist_remove(cow->togc, EINA_INLIST_GET(gc));
+   cow->pending--;
+   ref->togc = NULL;
+   eina_mempool_free(gc_pool, gc);
 }
 
 static void
@@ -244,11 +223,12 @@ _eina_cow_togc_add(Eina_Cow *cow,
 
    gc->ref = ref;
    gc->dst = dst;
-   eina_hash_direct_add(cow->togc, &gc->ref, gc);
+   cow->togc = eina_inlist_append(cow->togc, EINA_INLIST_GET(gc));
+   cow->pending++;
 #ifndef NVALGRIND
    VALGRIND_MAKE_MEM_DEFINED(ref, sizeof (*ref));
 #endif
-   ref->togc = EINA_TRUE;
+   ref->togc = gc;
 #ifndef NVALGRIND
    VALGRIND_MAKE_MEM_NOACCESS(ref, sizeof (*ref));
 #endif
@@ -259,11 +239,13 @@ _eina_cow_gc(Eina_Cow *cow, Eina_Cow_GC *gc)
 {
    Eina_Cow_Data *data;
    Eina_Cow_Data *match;
+   int hash;
 
    data = EINA_COW_DATA_GET(gc->ref);
 
    current_cow_size = cow->struct_size;
-   match = eina_hash_find(cow->match, data);
+   hash = eina_hash_fast(data, cow->struct_size);
+   match = eina_hash_find_by_hash(cow->match, data, cow->struct_size, hash);
    if (match)
      {
         Eina_Cow_Ptr *ref = EINA_COW_PTR_GET(match);
@@ -271,6 +253,8 @@ _eina_cow_gc(Eina_Cow *cow, Eina_Cow_GC *gc)
         VALGRIND_MAKE_MEM_DEFINED(ref, sizeof (*ref));
 #endif
         ref->refcount += gc->ref->refcount;
+        cow->refs += gc->ref->refcount;
+        cow->merged++;
 
         *gc->dst = match;
         eina_cow_free(cow, (const Eina_Cow_Data**) &data);
@@ -281,10 +265,10 @@ _eina_cow_gc(Eina_Cow *cow, Eina_Cow_GC *gc)
      }
    else
      {
-        eina_hash_direct_add(cow->match, data, data);
+        eina_hash_direct_add_by_hash(cow->match, data, cow->struct_size, hash, data);
+        gc->ref->hash = hash;
         gc->ref->hashed = EINA_TRUE;
-        gc->ref->togc = EINA_FALSE;
-        eina_hash_del(cow->togc, &gc->ref, gc);
+        _eina_cow_togc_del(cow, gc->ref);
      }
 }
 
@@ -321,6 +305,7 @@ eina_cow_init(void)
 Eina_Bool
 eina_cow_shutdown(void)
 {
+   background_cows = eina_list_free(background_cows);
    eina_log_domain_unregister(_eina_cow_log_dom);
    eina_mempool_del(gc_pool);
    return EINA_TRUE;
@@ -358,26 +343,23 @@ eina_cow_add(const char *name, unsigned int struct_size, unsigned int step, cons
         goto on_error;
      }
 
-#ifdef EFL64
+   /* all accesses go through the *_by_hash() calls with the hash stored in
+      the block header, the callbacks are only there for completeness */
    cow->match = eina_hash_new(_eina_cow_length,
                               _eina_cow_cmp,
-                              _eina_cow_hash64,
+                              EINA_KEY_HASH(eina_hash_fast),
                               NULL,
                               6);
-#else
-   cow->match = eina_hash_new(_eina_cow_length,
-                              _eina_cow_cmp,
-                              _eina_cow_hash32,
-                              NULL,
-                              6);
-#endif
-   if (gc)
-     cow->togc = eina_hash_pointer_new(_eina_cow_gc_free);
-   else
-     cow->togc = NULL;
+   cow->togc = NULL;
+   cow->gc = !!gc;
+   cow->background = EINA_FALSE;
    cow->default_value = default_value;
    cow->struct_size = struct_size;
    cow->total_size = total_size;
+   cow->blocks = 0;
+   cow->refs = 0;
+   cow->pending = 0;
+   cow->merged = 0;
 
 #ifdef EINA_COW_MAGIC_ON
    EINA_MAGIC_SET(cow, EINA_COW_MAGIC);
@@ -399,9 +381,17 @@ eina_cow_del(Eina_Cow *cow)
    EINA_COW_MAGIC_CHECK(cow);
 #endif
 
+   if (cow->background)
+     background_cows = eina_list_remove(background_cows, cow);
+   while (cow->togc)
+     {
+        Eina_Cow_GC *gc = EINA_INLIST_CONTAINER_GET(cow->togc, Eina_Cow_GC);
+
+        cow->togc = eina_inlist_remove(cow->togc, cow->togc);
+        eina_mempool_free(gc_pool, gc);
+     }
    eina_mempool_del(cow->pool);
    eina_hash_free(cow->match);
-   if (cow->togc) eina_hash_free(cow->togc);
    free(cow);
 }
 
@@ -432,6 +422,7 @@ eina_cow_free(Eina_Cow *cow, const Eina_Cow_Data **data)
    VALGRIND_MAKE_MEM_DEFINED(ref, sizeof (*ref));
 #endif
    ref->refcount--;
+   cow->refs--;
 
    if (ref->refcount == 0) _eina_cow_hash_del(cow, *data, ref);
    *data = (Eina_Cow_Data*) cow->default_value;
@@ -448,6 +439,7 @@ eina_cow_free(Eina_Cow *cow, const Eina_Cow_Data **data)
    EINA_MAGIC_SET(ref, EINA_MAGIC_NONE);
 #endif
    _eina_cow_togc_del(cow, ref);
+   cow->blocks--;
    eina_mempool_free(cow->pool, (void*) ref);
 }
 
@@ -487,7 +479,7 @@ eina_cow_write(Eina_Cow *cow,
           }
 #endif
 
-        if (cow->togc)
+        if (cow->gc)
           _eina_cow_hash_del(cow, *data, ref);
 
 #ifndef NVALGRIND
@@ -496,15 +488,19 @@ eina_cow_write(Eina_Cow *cow,
         goto end;
      }
    ref->refcount--;
+   cow->refs--;
 
  allocate:
    ref = eina_mempool_malloc(cow->pool, cow->total_size);
    ref->refcount = 1;
+   cow->refs++;
+   cow->blocks++;
 #ifdef EINA_COW_MAGIC_ON
    ref->writing = 0;
 #endif
+   ref->hash = 0;
    ref->hashed = EINA_FALSE;
-   ref->togc = EINA_FALSE;
+   ref->togc = NULL;
 #ifdef EINA_COW_MAGIC_ON
    EINA_MAGIC_SET(ref, EINA_COW_PTR_MAGIC);
 #endif
@@ -560,7 +556,7 @@ eina_cow_done(Eina_Cow *cow,
    VALGRIND_MAKE_MEM_NOACCESS(ref, sizeof (*ref));
 #endif
 
-   if (!cow->togc || !needed_gc) return;
+   if (!cow->gc || !needed_gc) return;
 
 #ifndef NVALGRIND
    VALGRIND_MAKE_MEM_DEFINED(ref, sizeof (*ref));
@@ -589,8 +585,9 @@ eina_cow_memcpy(Eina_Cow *cow,
 
        EINA_COW_PTR_MAGIC_CHECK(ref);
        ref->refcount++;
+       cow->refs++;
 
-       if (cow->togc)
+       if (cow->gc)
          _eina_cow_togc_del(cow, ref);
 
 #ifndef NVALGRIND
@@ -607,22 +604,15 @@ EAPI Eina_Bool
 eina_cow_gc(Eina_Cow *cow)
 {
    Eina_Cow_GC *gc;
-   Eina_Iterator *it;
-   Eina_Bool r;
 #ifndef NVALGRIND
    Eina_Cow_Ptr *ref;
 #endif
 
    EINA_COW_MAGIC_CHECK(cow);
 
-   if (!cow->togc || !eina_hash_population(cow->togc))
-     return EINA_FALSE;
-
-   it = eina_hash_iterator_data_new(cow->togc);
-   r = eina_iterator_next(it, (void**) &gc);
-   eina_iterator_free(it);
+   if (!cow->togc) return EINA_FALSE;
 
-   if (!r) return EINA_FALSE; /* Something did go wrong here */
+   gc = EINA_INLIST_CONTAINER_GET(cow->togc, Eina_Cow_GC);
 
 #ifndef NVALGRIND
    /* Do handle hash and all funky merge thing here */
@@ -638,3 +628,74 @@ eina_cow_gc(Eina_Cow *cow)
    return EINA_TRUE;
 }
 
+
+EAPI Eina_Bool
+eina_cow_stats_get(const Eina_Cow *cow, Eina_Cow_Stats *stats)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(cow, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(stats, EINA_FALSE);
+
+   stats->blocks = cow->blocks;
+   stats->references = cow->refs;
+   stats->pending = cow->pending;
+   stats->merged = cow->merged;
+   stats->unique_bytes = (size_t) cow->blocks * cow->total_size;
+   stats->shared_bytes = (size_t) (cow->refs - cow->blocks) * cow->struct_size;
+   return EINA_TRUE;
+}
+
+EAPI void
+eina_cow_gc_background_set(Eina_Cow *cow, Eina_Bool background)
+{
+   EINA_SAFETY_ON_NULL_RETURN(cow);
+   EINA_COW_MAGIC_CHECK(cow);
+
+   background = !!background;
+   if (!cow->gc || cow->background == background) return;
+
+   cow->background = background;
+   if (background)
+     background_cows = eina_list_append(background_cows, cow);
+   else
+     background_cows = eina_list_remove(background_cows, cow);
+}
+
+EAPI Eina_Bool
+eina_cow_gc_background_pending(void)
+{
+   Eina_List *l;
+   Eina_Cow *cow;
+
+   EINA_LIST_FOREACH(background_cows, l, cow)
+     if (cow->pending) return EINA_TRUE;
+   return EINA_FALSE;
+}
+
+EAPI Eina_Bool
+eina_cow_gc_background_run(double budget)
+{
+   Eina_Nano_Time start, now;
+   Eina_List *l;
+   Eina_Cow *cow;
+   long int limit;
+   unsigned int steps = 0;
+
+   if (!background_cows) return EINA_FALSE;
+
+   limit = budget * 1000000000.0;
+   _eina_time_get(&start);
+   EINA_LIST_FOREACH(background_cows, l, cow)
+     {
+        while (eina_cow_gc(cow))
+          {
+             /* a gc step is a hash and a lookup, don't ask the clock for
+                every one of them */
+             if ((++steps & 0xf) != 0) continue;
+             _eina_time_get(&now);
+             if (_eina_time_delta(&start, &now) >= limit)
+               return eina_cow_gc_background_pending();
+          }
+     }
+
+   return EINA_FALSE;
+}
@@ -51,6 +51,31 @@ typedef struct _Eina_Cow Eina_Cow;
  */
 typedef void Eina_Cow_Data;
 
+/**
+ * @typedef Eina_Cow_Stats
+ * Memory accounting of an Eina_Cow pool, see eina_cow_stats_get().
+ *
+ * @since 1.22
+ */
+typedef struct _Eina_Cow_Stats Eina_Cow_Stats;
+
+/**
+ * @struct _Eina_Cow_Stats
+ * Memory accounting of an Eina_Cow pool. Pointers to the default value are
+ * not counted.
+ *
+ * @since 1.22
+ */
+struct _Eina_Cow_Stats
+{
+   unsigned int blocks; /**< Number of distinct blocks allocated from the pool */
+   unsigned int references; /**< Number of pointers to those blocks */
+   unsigned int pending; /**< Number of blocks waiting for the garbage collector */
+   unsigned int merged; /**< Number of blocks merged by the garbage collector since the pool was created */
+   size_t unique_bytes; /**< Memory used by the blocks, including their header */
+   size_t shared_bytes; /**< Memory the extra references would use if every one had its own copy */
+};
+
 /**
  * @brief Instantiates a new Eina_Cow pool.
  *
@@ -132,11 +157,60 @@ EAPI void eina_cow_memcpy(Eina_Cow *cow,
  * @return EINA_TRUE if something was compacted, EINA_FALSE if nothing was.
  *
  * There is no guaranty in the time it will require, but should remain low.
- * It does run a hash function on all possible common structures trying to
- * find the one that matches and merge them into one pointer.
+ * It does run a hash function on one of the structures written since the
+ * last call trying to find the one that matches and merge them into one
+ * pointer. The hash is kept with the block, so writing to a block that was
+ * already collected does not need to compute it again.
  */
 EAPI Eina_Bool eina_cow_gc(Eina_Cow *cow);
 
+/**
+ * @brief Gets the memory accounting of a pool.
+ *
+ * @param[in] cow The pool to look at.
+ * @param[out] stats Where to store the figures.
+ * @return EINA_TRUE on success, EINA_FALSE if a parameter is @c NULL.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Bool eina_cow_stats_get(const Eina_Cow *cow, Eina_Cow_Stats *stats);
+
+/**
+ * @brief Lets eina_cow_gc_background_run() collect a pool.
+ *
+ * @param[in,out] cow The pool, it must have been created with gc enabled.
+ * @param[in] background EINA_TRUE to collect it in the background.
+ *
+ * The main loop calls eina_cow_gc_background_run() when it is idle, so the
+ * pool must only be used from the main loop thread once this is set.
+ *
+ * @since 1.22
+ */
+EAPI void eina_cow_gc_background_set(Eina_Cow *cow, Eina_Bool background);
+
+/**
+ * @brief Tells if a background pool has something to collect.
+ *
+ * @return EINA_TRUE if eina_cow_gc_background_run() has work to do.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Bool eina_cow_gc_background_pending(void);
+
+/**
+ * @brief Runs the garbage collector on the background pools for a while.
+ *
+ * @param[in] budget The time to spend, in seconds.
+ * @return EINA_TRUE if there is still something to collect.
+ *
+ * This runs eina_cow_gc() on every pool given to
+ * eina_cow_gc_background_set() until they are all collected or @p budget
+ * is spent. It is meant to be called from an idler.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Bool eina_cow_gc_background_run(double budget);
+
 /**
  * @def EINA_COW_WRITE_BEGIN
  * @brief Definition for the macro to setup a writeable pointer from a const one.
@@ -83,6 +83,27 @@ static inline void _x86_cpuid(int op, int *a, int *b, int *c, int *d)
       : "cc");
 }
 
+/* Same as above, for the leaves that take a sub-leaf in %ecx */
+static inline void _x86_cpuid_count(int op, int sub, int *a, int *b, int *c, int *d)
+{
+   __asm__ volatile (
+#if defined(__x86_64__)
+      "pushq %%rbx      \n\t"
+#else
+      "pushl %%ebx      \n\t"
+#endif
+      "cpuid            \n\t"
+      "movl %%ebx, %1   \n\t"
+#if defined(__x86_64__)
+      "popq %%rbx       \n\t"
+#else
+      "popl %%ebx       \n\t"
+#endif
+      : "=a" (*a), "=r" (*b), "=c" (*c), "=d" (*d)
+      : "a" (op), "c" (sub)
+      : "cc");
+}
+
 static
 void _x86_simd(Eina_Cpu_Features *features)
 {
@@ -123,6 +144,35 @@ void _x86_simd(Eina_Cpu_Features *features)
 
    if ((c >> 20) & 1)
       *features |= EINA_CPU_SSE42;
+
+   /*
+    * AVX2 needs AVX (ecx 28) and the OS to save the ymm registers, which
+    * it tells through OSXSAVE (ecx 27) and the XCR0 bits 1 and 2. AVX2
+    * itself is leaf 7, ebx 5.
+    */
+   if (((c >> 27) & 1) && ((c >> 28) & 1))
+     {
+        unsigned int xcr0_lo, xcr0_hi;
+
+        __asm__ volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+        if ((xcr0_lo & 0x6) == 0x6)
+          {
+             _x86_cpuid(0, &a, &b, &c, &d);
+             if (a >= 7)
+               {
+                  _x86_cpuid_count(7, 0, &a, &b, &c, &d);
+                  if ((b >> 5) & 1)
+                    *features |= EINA_CPU_AVX2;
+                  /*
+                   * AVX-512 F (ebx 16) and BW (ebx 30) also need the OS
+                   * to save the opmask and zmm registers, XCR0 bits 5-7.
+                   */
+                  if (((b >> 16) & 1) && ((b >> 30) & 1) &&
+                      ((xcr0_lo & 0xe0) == 0xe0))
+                    *features |= EINA_CPU_AVX512;
+               }
+          }
+     }
 }
 #endif
 
@@ -39,6 +39,7 @@
 
 #include <time.h>
 #include <unistd.h>
+#include <limits.h>
 
 # ifdef HAVE_MMAP
 #  include <sys/mman.h>
@@ -57,12 +58,85 @@
 #endif
 
 # define EVLOG_BUF_SIZE (4 * (1024 * 1024))
+// per thread ring, must be a power of 2
+# define EVLOG_THREAD_BUF_SIZE (1024 * 1024)
+// an item size is stored in an unsigned short
+# define EVLOG_ITEM_MAX_SIZE (65536 - sizeof(double))
+
+# define EVLOG_STREAM_MAGIC "EINAEVL1"
+# define EVLOG_STREAM_INTERVAL 0.2
+# define EVLOG_STREAM_STRINGS_MAX 4096
+# define EVLOG_STREAM_WRITE_SIZE (256 * 1024)
+
+/*
+ * Every thread logs into its own ring, so eina_evlog() takes no lock: the
+ * thread is the only writer of the head of its ring, the reader the only
+ * writer of its tail. Items are stored in host order and are contiguous, if
+ * an item doesn't fit at the end of the ring it starts again at the
+ * beginning and the end is skipped, marked by an item with no event if
+ * there is room for one. When a ring is full, items are dropped and counted.
+ *
+ * Readers take _evlog_lock and merge the rings by time, either into the
+ * buffers given by eina_evlog_steal() or into the buffer of the stream, which
+ * is encoded and written to the file once the lock is released. The ring of
+ * a thread that exits is adopted by the next thread that logs.
+ */
+
+typedef struct _Eina_Evlog_Thread Eina_Evlog_Thread;
+struct _Eina_Evlog_Thread
+{
+   Eina_Evlog_Thread *next;
+   Eina_Evlog_Buf     ring; // overflow counts the dropped items
+   unsigned int       head;
+   unsigned int       tail;
+   unsigned int       overflow_seen; // by the reader
+   Eina_Bool          orphan : 1;
+};
+
+typedef struct
+{
+   Eina_Evlog_Thread *th;
+   unsigned int       pos;
+   unsigned int       head;
+   Eina_Evlog_Item   *item;
+} Eina_Evlog_Cursor;
+
+// returns EINA_FALSE to stop reading, the item is read again next time
+typedef Eina_Bool (*Eina_Evlog_Read_Cb)(void *data, const Eina_Evlog_Item *item);
+
+typedef struct
+{
+   FILE              *f;
+   char              *path;
+   unsigned long long max_size;
+   unsigned long long written;
+   Eina_Hash         *strings;
+   unsigned int       strings_count;
+   Eina_Hash         *threads;
+   unsigned int       threads_count;
+   long long          prev_time;
+   Eina_Evlog_Buf     items; // merged under _evlog_lock, overflow when full
+   unsigned char     *buf;
+   unsigned int       buf_size;
+   unsigned int       buf_top;
+   Eina_Thread        thread;
+   Eina_Lock          lock;
+   Eina_Condition     cond;
+   Eina_Bool          run : 1;
+} Eina_Evlog_Stream;
 
 static Eina_Spinlock   _evlog_lock;
 static int             _evlog_go = 0;
 
-static Eina_Evlog_Buf *buf; // current event log we are writing events to
-static Eina_Evlog_Buf  buffers[2]; // double-buffer our event log buffers
+static Eina_Evlog_Buf *buf; // the evlog buffer last stolen
+static Eina_Evlog_Buf  buffers[2]; // double-buffer our stolen event logs
+
+static Eina_TLS           _evlog_tls;
+static Eina_Evlog_Thread *_evlog_threads = NULL;
+static Eina_Evlog_Cursor *_evlog_cursors = NULL;
+static unsigned int       _evlog_cursors_size = 0;
+
+static Eina_Evlog_Stream *_evlog_stream = NULL;
 
 #if defined (HAVE_CLOCK_GETTIME) || defined (EXOTIC_PROVIDE_CLOCK_GETTIME)
 static clockid_t _eina_evlog_time_clock_id = -1;
@@ -136,32 +210,86 @@ free_buf(Eina_Evlog_Buf *b)
    b->top = 0;
 }
 
+static void
+_evlog_thread_del_cb(void *data)
+{
+   Eina_Evlog_Thread *th = data;
+
+   eina_spinlock_take(&_evlog_lock);
+   th->orphan = EINA_TRUE;
+   eina_spinlock_release(&_evlog_lock);
+}
+
+static Eina_Evlog_Thread *
+_evlog_thread_get(void)
+{
+   Eina_Evlog_Thread *th;
+
+   th = eina_tls_get(_evlog_tls);
+   if (EINA_LIKELY(th != NULL)) return th;
+
+   eina_spinlock_take(&_evlog_lock);
+   for (th = _evlog_threads; th; th = th->next)
+     {
+        if (th->orphan) break;
+     }
+   if (th) th->orphan = EINA_FALSE;
+   else
+     {
+        th = calloc(1, sizeof(Eina_Evlog_Thread));
+        if (th)
+          {
+             alloc_buf(&(th->ring), EVLOG_THREAD_BUF_SIZE);
+             if (!th->ring.buf)
+               {
+                  free(th);
+                  th = NULL;
+               }
+             else
+               {
+                  th->next = _evlog_threads;
+                  _evlog_threads = th;
+               }
+          }
+     }
+   eina_spinlock_release(&_evlog_lock);
+   if (th) eina_tls_set(_evlog_tls, th);
+   return th;
+}
+
+// reserves a contiguous item of size bytes at *pos, NULL if the ring is full
 static inline void *
-push_buf(Eina_Evlog_Buf *b, unsigned int size)
+push_buf(Eina_Evlog_Thread *th, unsigned int size, unsigned int *pos)
 {
-   void *ptr;
+   unsigned int off, pad = 0;
+   unsigned int tail = __atomic_load_n(&(th->tail), __ATOMIC_ACQUIRE);
 
-   if (b->size < size) abort();
-   if ((b->top + size) > (b->size))
+   off = th->head & (th->ring.size - 1);
+   if ((off + size) > th->ring.size) pad = th->ring.size - off;
+   if (((th->head - tail) + pad + size) > th->ring.size)
      {
-        b->overflow++;
-        b->top = 0;
+        __atomic_store_n(&(th->ring.overflow), th->ring.overflow + 1, __ATOMIC_RELAXED);
+        return NULL;
      }
-   ptr = (b->buf + b->top);
-   b->top += size;
-   return ptr;
+   if (pad >= sizeof(Eina_Evlog_Item))
+     ((Eina_Evlog_Item *)(th->ring.buf + off))->event_offset = 0;
+   *pos = th->head + pad;
+   return th->ring.buf + (*pos & (th->ring.size - 1));
 }
 
 EAPI void
 eina_evlog(const char *event, void *obj, double srctime, const char *detail)
 {
+   Eina_Evlog_Thread *th;
    Eina_Evlog_Item *item;
    char *strings;
    double now;
-   int size;
+   unsigned int size, pos;
    unsigned short detail_offset, event_size;
 
    if (!_evlog_go) return;
+   th = _evlog_thread_get();
+   if (EINA_UNLIKELY(!th)) return;
    now                 = get_time();
    event_size          = strlen(event) + 1;
    size                = sizeof(Eina_Evlog_Item) + event_size;
@@ -173,41 +301,125 @@ eina_evlog(const char *event, void *obj, double srctime, const char *detail)
      }
    size                = sizeof(double) * ((size + sizeof(double) - 1)
                                            / sizeof(double));
-   eina_spinlock_take(&_evlog_lock);
-   strings             = push_buf(buf, size);
+   if (EINA_UNLIKELY(size > EVLOG_ITEM_MAX_SIZE)) return;
+   strings             = push_buf(th, size, &pos);
+   if (!strings) return;
    item                = (Eina_Evlog_Item *)strings;
-   item->tim           = SWAP_DBL(now);
-   item->srctim        = SWAP_DBL(srctime);
-   item->thread        = SWAP_64((unsigned long long)(uintptr_t)pthread_self());
-   item->obj           = SWAP_64((unsigned long long)(uintptr_t)obj);
-   item->event_offset  = SWAP_16(sizeof(Eina_Evlog_Item));
-   item->detail_offset = SWAP_16(detail_offset);
-   item->event_next    = SWAP_16(size);
+   item->tim           = now;
+   item->srctim        = srctime;
+   item->thread        = (unsigned long long)(uintptr_t)pthread_self();
+   item->obj           = (unsigned long long)(uintptr_t)obj;
+   item->event_offset  = sizeof(Eina_Evlog_Item);
+   item->detail_offset = detail_offset;
+   item->event_next    = size;
    strcpy(strings + sizeof(Eina_Evlog_Item), event);
    if (detail_offset > 0) strcpy(strings + detail_offset, detail);
-   eina_spinlock_release(&_evlog_lock);
+   __atomic_store_n(&(th->head), pos + size, __ATOMIC_RELEASE);
 }
 
-EAPI Eina_Evlog_Buf *
-eina_evlog_steal(void)
+static Eina_Evlog_Item *
+_evlog_cursor_item_get(Eina_Evlog_Cursor *c)
 {
-   Eina_Evlog_Buf *stolen = NULL;
+   Eina_Evlog_Buf *ring = &(c->th->ring);
 
-   eina_spinlock_take(&_evlog_lock);
-   if (buf == &(buffers[0]))
+   while (c->pos != c->head)
      {
-        buf = &(buffers[1]);
-        buf->top = 0;
-        buf->overflow = 0;
-        stolen = &(buffers[0]);
+        unsigned int off = c->pos & (ring->size - 1);
+        unsigned int left = ring->size - off;
+        Eina_Evlog_Item *item = (Eina_Evlog_Item *)(ring->buf + off);
+
+        if ((left >= sizeof(Eina_Evlog_Item)) && (item->event_offset != 0))
+          return item;
+        // the end of the ring was skipped
+        c->pos += left;
      }
-   else
+   return NULL;
+}
+
+// merges the items of all the rings by time, returns the dropped items
+// count, must be called with _evlog_lock taken
+static unsigned int
+_evlog_read(Eina_Evlog_Read_Cb cb, void *data)
+{
+   Eina_Evlog_Thread *th;
+   Eina_Evlog_Cursor *c, *first;
+   unsigned int i, count = 0, lost = 0, overflow;
+
+   for (th = _evlog_threads; th; th = th->next) count++;
+   if (count > _evlog_cursors_size)
+     {
+        c = realloc(_evlog_cursors, count * sizeof(Eina_Evlog_Cursor));
+        if (!c) return 0;
+        _evlog_cursors = c;
+        _evlog_cursors_size = count;
+     }
+   for (i = 0, th = _evlog_threads; th; th = th->next, i++)
      {
-        buf = &(buffers[0]);
-        buf->top = 0;
-        buf->overflow = 0;
-        stolen = &(buffers[1]);
+        c = &(_evlog_cursors[i]);
+        c->th = th;
+        c->pos = th->tail;
+        c->head = __atomic_load_n(&(th->head), __ATOMIC_ACQUIRE);
+        c->item = _evlog_cursor_item_get(c);
      }
+   for (;;)
+     {
+        first = NULL;
+        for (i = 0; i < count; i++)
+          {
+             c = &(_evlog_cursors[i]);
+             if ((c->item) && ((!first) || (c->item->tim < first->item->tim)))
+               first = c;
+          }
+        if (!first) break;
+        if (!cb(data, first->item)) break;
+        first->pos += first->item->event_next;
+        first->item = _evlog_cursor_item_get(first);
+     }
+   for (i = 0; i < count; i++)
+     {
+        c = &(_evlog_cursors[i]);
+        th = c->th;
+        __atomic_store_n(&(th->tail), c->pos, __ATOMIC_RELEASE);
+        overflow = __atomic_load_n(&(th->ring.overflow), __ATOMIC_RELAXED);
+        lost += overflow - th->overflow_seen;
+        th->overflow_seen = overflow;
+     }
+   return lost;
+}
+
+static Eina_Bool
+_evlog_steal_cb(void *data, const Eina_Evlog_Item *src)
+{
+   Eina_Evlog_Buf *b = data;
+   Eina_Evlog_Item *item;
+
+   if ((b->top + src->event_next) > b->size) return EINA_FALSE;
+   item = (Eina_Evlog_Item *)(b->buf + b->top);
+   memcpy(item, src, src->event_next);
+   item->tim           = SWAP_DBL(src->tim);
+   item->srctim        = SWAP_DBL(src->srctim);
+   item->thread        = SWAP_64(src->thread);
+   item->obj           = SWAP_64(src->obj);
+   item->event_offset  = SWAP_16(src->event_offset);
+   item->detail_offset = SWAP_16(src->detail_offset);
+   item->event_next    = SWAP_16(src->event_next);
+   b->top += src->event_next;
+   return EINA_TRUE;
+}
+
+EAPI Eina_Evlog_Buf *
+eina_evlog_steal(void)
+{
+   Eina_Evlog_Buf *stolen = NULL;
+
+   eina_spinlock_take(&_evlog_lock);
+   if (buf == &(buffers[0])) stolen = &(buffers[1]);
+   else stolen = &(buffers[0]);
+   buf = stolen;
+   stolen->top = 0;
+   stolen->overflow = 0;
+   if (stolen->buf)
+     stolen->overflow = _evlog_read(_evlog_steal_cb, stolen);
    eina_spinlock_release(&_evlog_lock);
    return stolen;
 }
@@ -229,16 +441,348 @@ eina_evlog_start(void)
 EAPI void
 eina_evlog_stop(void)
 {
+   Eina_Evlog_Thread *th, **prev;
+
    eina_spinlock_take(&_evlog_lock);
    _evlog_go--;
    if (_evlog_go == 0)
      {
         free_buf(&(buffers[0]));
         free_buf(&(buffers[1]));
+        // a thread may still be logging, only rings of exited threads go
+        prev = &_evlog_threads;
+        while ((th = *prev))
+          {
+             if (th->orphan)
+               {
+                  *prev = th->next;
+                  free_buf(&(th->ring));
+                  free(th);
+                  continue;
+               }
+             __atomic_store_n(&(th->tail), __atomic_load_n(&(th->head), __ATOMIC_ACQUIRE),
+                              __ATOMIC_RELEASE);
+             th->overflow_seen = th->ring.overflow;
+             prev = &(th->next);
+          }
      }
    eina_spinlock_release(&_evlog_lock);
 }
 
+// stream
+
+static void
+_stream_bytes(Eina_Evlog_Stream *st, const void *data, unsigned int size)
+{
+   if ((st->buf_top + size) > st->buf_size)
+     {
+        unsigned int bsize = st->buf_size ? st->buf_size : 65536;
+        unsigned char *tmp;
+
+        while ((st->buf_top + size) > bsize) bsize *= 2;
+        tmp = realloc(st->buf, bsize);
+        if (!tmp) return;
+        st->buf = tmp;
+        st->buf_size = bsize;
+     }
+   memcpy(st->buf + st->buf_top, data, size);
+   st->buf_top += size;
+}
+
+static void
+_stream_uint(Eina_Evlog_Stream *st, unsigned long long val)
+{
+   unsigned char b[10];
+   unsigned int n = 0;
+
+   do
+     {
+        b[n] = val & 0x7f;
+        val >>= 7;
+        if (val) b[n] |= 0x80;
+        n++;
+     }
+   while (val);
+   _stream_bytes(st, b, n);
+}
+
+static void
+_stream_int(Eina_Evlog_Stream *st, long long val)
+{
+   _stream_uint(st, ((unsigned long long)val << 1) ^ (unsigned long long)(val >> 63));
+}
+
+static unsigned int
+_stream_string(Eina_Evlog_Stream *st, const char *str)
+{
+   uintptr_t id = (uintptr_t)eina_hash_find(st->strings, str);
+   unsigned char type = EINA_EVLOG_STREAM_STRING;
+   unsigned int len;
+
+   if (id) return id - 1;
+   // ids are reused from 0, redefining them
+   if (st->strings_count == EVLOG_STREAM_STRINGS_MAX)
+     {
+        eina_hash_free_buckets(st->strings);
+        st->strings_count = 0;
+     }
+   id = st->strings_count++;
+   eina_hash_add(st->strings, str, (void *)(id + 1));
+   len = strlen(str);
+   _stream_bytes(st, &type, 1);
+   _stream_uint(st, id);
+   _stream_uint(st, len);
+   _stream_bytes(st, str, len);
+   return id;
+}
+
+static unsigned int
+_stream_thread(Eina_Evlog_Stream *st, unsigned long long thread)
+{
+   uintptr_t id = (uintptr_t)eina_hash_find(st->threads, &thread);
+   unsigned char type = EINA_EVLOG_STREAM_THREAD;
+
+   if (id) return id - 1;
+   id = st->threads_count++;
+   eina_hash_add(st->threads, &thread, (void *)(id + 1));
+   _stream_bytes(st, &type, 1);
+   _stream_uint(st, id);
+   _stream_uint(st, thread);
+   return id;
+}
+
+static Eina_Bool
+_stream_open(Eina_Evlog_Stream *st)
+{
+   st->f = fopen(st->path, "wb");
+   if (!st->f) return EINA_FALSE;
+   if (fwrite(EVLOG_STREAM_MAGIC, 1, 8, st->f) != 8)
+     {
+        fclose(st->f);
+        st->f = NULL;
+        return EINA_FALSE;
+     }
+   st->written = 8;
+   // every file is self-contained
+   eina_hash_free_buckets(st->strings);
+   eina_hash_free_buckets(st->threads);
+   st->strings_count = 0;
+   st->threads_count = 0;
+   st->prev_time = 0;
+   return EINA_TRUE;
+}
+
+// keep at most max_size bytes: the last file and the one before it
+static void
+_stream_rotate(Eina_Evlog_Stream *st)
+{
+   char old[PATH_MAX];
+
+   fclose(st->f);
+   st->f = NULL;
+   snprintf(old, sizeof(old), "%s.1", st->path);
+   if (rename(st->path, old) != 0) unlink(st->path);
+   _stream_open(st);
+}
+
+static void
+_stream_write(Eina_Evlog_Stream *st)
+{
+   if ((!st->f) || (!st->buf_top)) return;
+   if (fwrite(st->buf, 1, st->buf_top, st->f) != st->buf_top)
+     {
+        fprintf(stderr, "ERR: Can't write the event log to '%s'\n", st->path);
+        fclose(st->f);
+        st->f = NULL;
+     }
+   st->written += st->buf_top;
+   st->buf_top = 0;
+}
+
+static Eina_Bool
+_stream_copy_cb(void *data, const Eina_Evlog_Item *src)
+{
+   Eina_Evlog_Buf *b = data;
+
+   if ((b->top + src->event_next) > b->size)
+     {
+        b->overflow++;
+        return EINA_FALSE;
+     }
+   memcpy(b->buf + b->top, src, src->event_next);
+   b->top += src->event_next;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_stream_item(Eina_Evlog_Stream *st, const Eina_Evlog_Item *item)
+{
+   const char *strings = (const char *)item;
+   unsigned int thread, event, detail = 0;
+   unsigned char type = EINA_EVLOG_STREAM_EVENT, flags = 0;
+   long long tim = (long long)(item->tim * 1000000000.0);
+
+   if (st->buf_top >= EVLOG_STREAM_WRITE_SIZE) _stream_write(st);
+   if ((st->max_size) &&
+       ((st->written + st->buf_top) >= (st->max_size / 2)))
+     {
+        _stream_write(st);
+        _stream_rotate(st);
+     }
+   if (!st->f) return EINA_FALSE;
+   // definitions come before the event using them
+   thread = _stream_thread(st, item->thread);
+   event = _stream_string(st, strings + item->event_offset);
+   if (item->detail_offset)
+     {
+        detail = _stream_string(st, strings + item->detail_offset);
+        flags |= EINA_EVLOG_STREAM_DETAIL;
+     }
+   if (item->obj) flags |= EINA_EVLOG_STREAM_OBJ;
+   if (item->srctim > 0.0) flags |= EINA_EVLOG_STREAM_SRCTIME;
+
+   _stream_bytes(st, &type, 1);
+   _stream_bytes(st, &flags, 1);
+   _stream_int(st, tim - st->prev_time);
+   _stream_uint(st, thread);
+   _stream_uint(st, event);
+   if (flags & EINA_EVLOG_STREAM_DETAIL) _stream_uint(st, detail);
+   if (flags & EINA_EVLOG_STREAM_OBJ) _stream_uint(st, item->obj);
+   if (flags & EINA_EVLOG_STREAM_SRCTIME)
+     _stream_int(st, tim - (long long)(item->srctim * 1000000000.0));
+   st->prev_time = tim;
+   return EINA_TRUE;
+}
+
+static void
+_stream_flush(Eina_Evlog_Stream *st)
+{
+   unsigned char type = EINA_EVLOG_STREAM_LOST;
+   const Eina_Evlog_Item *item;
+   unsigned int lost = 0, overflow, pos;
+
+   if ((!st->f) || (!st->items.buf)) return;
+   // only the merge holds the loggers back, the rest works on the copy
+   do
+     {
+        st->items.top = 0;
+        overflow = st->items.overflow;
+        eina_spinlock_take(&_evlog_lock);
+        lost += _evlog_read(_stream_copy_cb, &(st->items));
+        eina_spinlock_release(&_evlog_lock);
+        for (pos = 0; pos < st->items.top; pos += item->event_next)
+          {
+             item = (const Eina_Evlog_Item *)(st->items.buf + pos);
+             if (!_stream_item(st, item)) return;
+          }
+     }
+   while (st->items.overflow != overflow);
+   if (lost)
+     {
+        _stream_bytes(st, &type, 1);
+        _stream_uint(st, lost);
+     }
+   _stream_write(st);
+   if (st->f) fflush(st->f);
+}
+
+static void *
+_stream_thread_func(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Eina_Evlog_Stream *st = data;
+
+   eina_thread_name_set(eina_thread_self(), "Eevlog-stream");
+   eina_lock_take(&st->lock);
+   while (st->run)
+     {
+        eina_condition_timedwait(&st->cond, EVLOG_STREAM_INTERVAL);
+        eina_lock_release(&st->lock);
+        _stream_flush(st);
+        eina_lock_take(&st->lock);
+     }
+   eina_lock_release(&st->lock);
+   // what was logged until the stop
+   _stream_flush(st);
+   return NULL;
+}
+
+static void
+_stream_free(Eina_Evlog_Stream *st)
+{
+   if (st->f) fclose(st->f);
+   free_buf(&(st->items));
+   eina_hash_free(st->strings);
+   eina_hash_free(st->threads);
+   eina_condition_free(&st->cond);
+   eina_lock_free(&st->lock);
+   free(st->buf);
+   free(st->path);
+   free(st);
+}
+
+EAPI Eina_Bool
+eina_evlog_stream_start(const char *file, unsigned long long max_size)
+{
+   Eina_Evlog_Stream *st;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINA_FALSE);
+   if (_evlog_stream) return EINA_FALSE;
+
+   st = calloc(1, sizeof(Eina_Evlog_Stream));
+   if (!st) return EINA_FALSE;
+   st->path = strdup(file);
+   st->max_size = max_size;
+   st->strings = eina_hash_string_superfast_new(NULL);
+   st->threads = eina_hash_int64_new(NULL);
+   st->run = EINA_TRUE;
+   if ((!st->path) || (!st->strings) || (!st->threads) ||
+       (!eina_lock_new(&st->lock)))
+     goto err;
+   if (!eina_condition_new(&st->cond, &st->lock))
+     {
+        eina_lock_free(&st->lock);
+        goto err;
+     }
+   alloc_buf(&(st->items), EVLOG_BUF_SIZE);
+   if ((!st->items.buf) || (!_stream_open(st))) goto err_cond;
+
+   eina_evlog_start();
+   if (!eina_thread_create(&st->thread, EINA_THREAD_BACKGROUND, -1,
+                           _stream_thread_func, st))
+     {
+        eina_evlog_stop();
+        goto err_cond;
+     }
+   _evlog_stream = st;
+   return EINA_TRUE;
+
+err_cond:
+   _stream_free(st);
+   return EINA_FALSE;
+err:
+   eina_hash_free(st->strings);
+   eina_hash_free(st->threads);
+   free(st->path);
+   free(st);
+   return EINA_FALSE;
+}
+
+EAPI void
+eina_evlog_stream_stop(void)
+{
+   Eina_Evlog_Stream *st = _evlog_stream;
+
+   if (!st) return;
+   eina_lock_take(&st->lock);
+   st->run = EINA_FALSE;
+   eina_condition_signal(&st->cond);
+   eina_lock_release(&st->lock);
+   eina_thread_join(st->thread);
+   _evlog_stream = NULL;
+   eina_evlog_stop();
+   _stream_free(st);
+}
+
 // get evlog
 static Eina_Bool
 _get_cb(Eina_Debug_Session *session EINA_UNUSED, int cid EINA_UNUSED, void *buffer EINA_UNUSED, int size EINA_UNUSED)
@@ -288,7 +832,14 @@ EINA_DEBUG_OPCODES_ARRAY_DEFINE(_EINA_DEBUG_EVLOG_OPS,
 Eina_Bool
 eina_evlog_init(void)
 {
+   const char *file;
+
    eina_spinlock_new(&_evlog_lock);
+   if (!eina_tls_cb_new(&_evlog_tls, _evlog_thread_del_cb))
+     {
+        eina_spinlock_free(&_evlog_lock);
+        return EINA_FALSE;
+     }
    buf = &(buffers[0]);
 #if defined (HAVE_CLOCK_GETTIME) || defined (EXOTIC_PROVIDE_CLOCK_GETTIME)
      {
@@ -302,13 +853,31 @@ eina_evlog_init(void)
 #endif
    eina_evlog("+eina_init", NULL, 0.0, NULL);
    eina_debug_opcodes_register(NULL, _EINA_DEBUG_EVLOG_OPS(), NULL, NULL);
+
+   // leave tracing on in production, with a default cap of 64Mb
+   file = getenv("EINA_EVLOG_FILE");
+   if ((file) && (file[0]))
+     {
+        const char *max_size = getenv("EINA_EVLOG_FILE_SIZE");
+
+        eina_evlog_stream_start(file, max_size ? strtoull(max_size, NULL, 10) :
+                                64 * 1024 * 1024);
+     }
    return EINA_TRUE;
 }
 
 Eina_Bool
 eina_evlog_shutdown(void)
 {
+   Eina_Evlog_Thread *th;
+
+   eina_evlog_stream_stop();
    // yes - we don't free tyhe evlog buffers. they may be in used by debug th
+   // but the rings will be adopted again by the threads after an init
+   eina_spinlock_take(&_evlog_lock);
+   for (th = _evlog_threads; th; th = th->next) th->orphan = EINA_TRUE;
+   eina_spinlock_release(&_evlog_lock);
+   eina_tls_free(_evlog_tls);
    eina_spinlock_free(&_evlog_lock);
    return EINA_TRUE;
 }
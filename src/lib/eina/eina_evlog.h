@@ -122,6 +122,11 @@ eina_evlog(const char *event, void *obj, double srctime, const char *detail);
  * Only one buffer can be stolen at any time. If you steal a new buffer, the
  * old stolen buffer is "released" back to the evlog core.
  *
+ * Every thread logs into its own buffer without locking, the stolen buffer
+ * holds the events of all the threads since the last steal, ordered by time.
+ * Its overflow is the count of events lost meanwhile. Events that don't fit
+ * in it are kept for the next steal.
+ *
  * @return The stolen evlog buffer
  *
  * @since 1.15
@@ -148,6 +153,71 @@ eina_evlog_start(void);
 EAPI void
 eina_evlog_stop(void);
 
+/**
+ * @brief Types of the records of an event log stream.
+ *
+ * A stream starts with the 8 bytes "EINAEVL1", followed by records. A record
+ * is its type on one byte followed by its fields. Integers are stored as
+ * LEB128 varints, signed ones are zigzag encoded first. Times are in
+ * nanoseconds.
+ *
+ * @since 1.22
+ */
+typedef enum
+{
+   EINA_EVLOG_STREAM_STRING = 1, /**< id, length, bytes without nul: defines or redefines string id */
+   EINA_EVLOG_STREAM_THREAD = 2, /**< id, thread handle: defines thread id */
+   EINA_EVLOG_STREAM_EVENT = 3, /**< flags byte, signed time since the previous event, thread id, event string id, then the optional detail string id, object and signed time since the source time, as told by the flags */
+   EINA_EVLOG_STREAM_LOST = 4 /**< count of events lost since the previous record */
+} Eina_Evlog_Stream_Record;
+
+/**
+ * @brief Flags of the optional fields of an event log stream event.
+ *
+ * @since 1.22
+ */
+typedef enum
+{
+   EINA_EVLOG_STREAM_DETAIL = (1 << 0), /**< the event has a detail string */
+   EINA_EVLOG_STREAM_OBJ = (1 << 1), /**< the event has an object */
+   EINA_EVLOG_STREAM_SRCTIME = (1 << 2) /**< the event has a source time */
+} Eina_Evlog_Stream_Flags;
+
+/**
+ * @brief Streams the event log to a file.
+ *
+ * Logging begins as with eina_evlog_start() and a thread writes the logged
+ * events to @p file in a compact binary format, see
+ * #Eina_Evlog_Stream_Record, a few times per second. When @p max_size is
+ * not 0, @p file is moved to @p file.1 once it holds half of it and a new
+ * @p file is started, so the last events logged are always kept. This is a
+ * flight recorder which can be left on. Streaming also starts at init time
+ * if the EINA_EVLOG_FILE environment variable is set to the file, with
+ * EINA_EVLOG_FILE_SIZE as its size cap, 64Mb by default.
+ *
+ * The events written to the stream are not available to eina_evlog_steal()
+ * any more. eina_evlog_convert turns streams into Chrome trace files.
+ *
+ * @param[in] file The file to stream to
+ * @param[in] max_size The cap of the total size of the stream files, or 0
+ * @return EINA_TRUE if streaming started, EINA_FALSE if the file can't be
+ * created or if already streaming
+ *
+ * @since 1.22
+ */
+EAPI Eina_Bool
+eina_evlog_stream_start(const char *file, unsigned long long max_size);
+
+/**
+ * @brief Stops streaming the event log.
+ *
+ * The events logged until now are written to the file before it is closed.
+ *
+ * @since 1.22
+ */
+EAPI void
+eina_evlog_stream_stop(void);
+
 /**
  * @}
  */
@@ -25,6 +25,7 @@
 #include <string.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <errno.h>
 #ifdef HAVE_DIRENT_H
 # include <dirent.h>
 #endif
@@ -72,6 +73,10 @@
 // FIXME: This assumes HugeTLB size of 2Mb. How to get this information at runtime?
 #define EINA_HUGE_PAGE (2 * 1024 * 1024)
 #define EINA_HUGE_PAGE_MIN (8 * EINA_HUGE_PAGE)
+// Maps from this size on are aligned for transparent huge pages
+#define EINA_THP_MIN (2 * EINA_HUGE_PAGE)
+// Chunk read at once when prefetching without MADV_POPULATE_READ
+#define EINA_PREFETCH_CHUNK (64 * 1024)
 
 #ifdef HAVE_DIRENT_H
 typedef struct _Eina_File_Iterator Eina_File_Iterator;
@@ -334,6 +339,53 @@ _eina_file_map_populate(char *map, unsigned long int size, Eina_Bool hugetlb)
 }
 #endif
 
+/*
+ * Large read only maps are placed at an address congruent to their offset
+ * modulo a huge page, the only way for the kernel to back them with
+ * transparent huge pages (read only file THP or shmem). The start is found
+ * by reserving a slightly larger anonymous area and mapping the file over
+ * it. HugeTLB maps don't need this, they are aligned by the kernel.
+ */
+static void *
+_eina_file_mmap(unsigned long int length, int flags, int fd, unsigned long int offset)
+{
+#if defined(MADV_HUGEPAGE) && defined(MAP_ANONYMOUS) && defined(MAP_FIXED)
+# ifdef MAP_HUGETLB
+   if (!(flags & MAP_HUGETLB) && (length >= EINA_THP_MIN))
+# else
+   if (length >= EINA_THP_MIN)
+# endif
+     {
+        const uintptr_t slack = EINA_HUGE_PAGE;
+        uintptr_t start, aligned;
+        void *area, *map;
+
+        area = mmap(NULL, length + slack, PROT_NONE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (area != MAP_FAILED)
+          {
+             start = (uintptr_t) area;
+             aligned = start + ((offset - start) & (slack - 1));
+             map = mmap((void *) aligned, length, PROT_READ,
+                        flags | MAP_FIXED, fd, offset);
+             if (map == MAP_FAILED)
+               {
+                  munmap(area, length + slack);
+                  return map;
+               }
+             if (aligned > start)
+               munmap(area, aligned - start);
+             if (start + slack > aligned)
+               munmap((char *) aligned + length, start + slack - aligned);
+             // Only a hint, fails where THP is not supported for files
+             madvise(map, length, MADV_HUGEPAGE);
+             return map;
+          }
+     }
+#endif
+   return mmap(NULL, length, PROT_READ, flags, fd, offset);
+}
+
 static char *
 _page_aligned_address(const char *map, unsigned long int offset, Eina_Bool hugetlb)
 {
@@ -948,12 +1000,12 @@ eina_file_map_all(Eina_File *file, Eina_File_Populate rule)
    eina_mmap_safety_enabled_set(EINA_TRUE);
    eina_lock_take(&file->lock);
    if (file->global_map == MAP_FAILED)
-     file->global_map = mmap(NULL, file->length, PROT_READ, flags, file->fd, 0);
+     file->global_map = _eina_file_mmap(file->length, flags, file->fd, 0);
 #ifdef MAP_HUGETLB
    if ((file->global_map == MAP_FAILED) && (flags & MAP_HUGETLB))
      {
        flags &= ~MAP_HUGETLB;
-       file->global_map = mmap(NULL, file->length, PROT_READ, flags, file->fd, 0);
+       file->global_map = _eina_file_mmap(file->length, flags, file->fd, 0);
      }
 #endif
 
@@ -1020,12 +1072,12 @@ eina_file_map_new(Eina_File *file, Eina_File_Populate rule,
         map = malloc(sizeof (Eina_File_Map));
         if (!map) goto on_error;
 
-        map->map = mmap(NULL, length, PROT_READ, flags, file->fd, offset);
+        map->map = _eina_file_mmap(length, flags, file->fd, offset);
 #ifdef MAP_HUGETLB
         if (map->map == MAP_FAILED && (flags & MAP_HUGETLB))
           {
              flags &= ~MAP_HUGETLB;
-             map->map = mmap(NULL, length, PROT_READ, flags, file->fd, offset);
+             map->map = _eina_file_mmap(length, flags, file->fd, offset);
           }
 
         map->hugetlb = !!(flags & MAP_HUGETLB);
@@ -1103,6 +1155,109 @@ eina_file_map_populate(Eina_File *file, Eina_File_Populate rule, const void *map
    eina_lock_release(&file->lock);
 }
 
+static Eina_Error
+_eina_file_map_prefetch(int fd, const void *map, unsigned long long fileoff,
+                        unsigned long int offset, unsigned long int length)
+{
+   char *addr;
+   unsigned long int size;
+   unsigned long long pos, end;
+   char *buf;
+   ssize_t r;
+
+   addr = _page_aligned_address(map, offset, EINA_FALSE);
+   size = length + (((char *) map + offset) - addr);
+
+#ifdef MADV_POPULATE_READ
+   // Faults the range in, reporting IO errors instead of raising SIGBUS
+   for (;;)
+     {
+        if (madvise(addr, size, MADV_POPULATE_READ) == 0) return 0;
+        if (errno == EINTR) continue;
+        // Older kernels don't know about it
+        if (errno == EINVAL) break;
+        return EIO;
+     }
+#endif
+
+   // Read the range through the page cache, the faults that follow are cheap
+   pos = fileoff + (addr - (char *) map);
+   end = pos + size;
+#ifdef POSIX_FADV_WILLNEED
+   posix_fadvise(fd, pos, size, POSIX_FADV_WILLNEED);
+#endif
+   buf = malloc(EINA_PREFETCH_CHUNK);
+   if (!buf) return ENOMEM;
+   while (pos < end)
+     {
+        size_t chunk = EINA_PREFETCH_CHUNK;
+
+        if (end - pos < chunk) chunk = end - pos;
+        r = pread(fd, buf, chunk, pos);
+        if ((r < 0) && (errno == EINTR)) continue;
+        if (r <= 0) break;
+        pos += r;
+     }
+   free(buf);
+   if (pos < end) return EIO;
+
+   madvise(addr, size, MADV_WILLNEED);
+   return 0;
+}
+
+EAPI Eina_Error
+eina_file_map_prefetch(Eina_File *file, const void *map,
+                       unsigned long int offset, unsigned long int length)
+{
+   Eina_File_Map *em = NULL;
+   unsigned long long maplen, fileoff;
+   Eina_Error err = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINVAL);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(map, EINVAL);
+
+   if (file->virtual) return 0;
+
+   // Hold a reference on the map, it can be freed by another thread
+   eina_lock_take(&file->lock);
+   if ((file->global_map != MAP_FAILED) && (map == file->global_map))
+     {
+        maplen = file->length;
+        fileoff = 0;
+        file->global_refcount++;
+     }
+   else if ((em = eina_hash_find(file->rmap, &map)) != NULL)
+     {
+        maplen = em->length;
+        fileoff = em->offset;
+        em->refcount++;
+     }
+   else
+     {
+        eina_lock_release(&file->lock);
+        return EINVAL;
+     }
+   eina_lock_release(&file->lock);
+
+   if (offset < maplen)
+     {
+        if ((length == 0) || (length > maplen - offset))
+          length = maplen - offset;
+        err = _eina_file_map_prefetch(file->fd, map, fileoff, offset, length);
+     }
+
+   if (err == EIO)
+     {
+        eina_lock_take(&file->lock);
+        if (em) em->faulty = EINA_TRUE;
+        else file->global_faulty = EINA_TRUE;
+        eina_lock_release(&file->lock);
+     }
+
+   eina_file_map_free(file, (void *) map);
+   return err;
+}
+
 EAPI Eina_Bool
 eina_file_map_faulted(Eina_File *file, void *map)
 {
@@ -29,6 +29,7 @@
 #include "eina_iterator.h"
 #include "eina_tmpstr.h"
 #include "eina_str.h"
+#include "eina_error.h"
 
 /**
  * @page eina_file_example_01_page
@@ -670,6 +671,29 @@ EAPI void
 eina_file_map_populate(Eina_File *file, Eina_File_Populate rule, const void *map,
                        unsigned long int offset, unsigned long int length);
 
+/**
+ * @brief Makes a range of a file mapping resident, waiting for the IO.
+ * @details Unlike eina_file_map_populate(), this blocks until the pages of
+ *          the range are read and mapped, so that accessing them later
+ *          doesn't stall on page faults. It is meant to be called from a
+ *          worker thread while the mapping is used elsewhere, see
+ *          ecore_thread_file_map_populate(). IO errors are reported instead
+ *          of raising SIGBUS, and flag @p map for eina_file_map_faulted().
+ *
+ * @param[in] file The file handle from which the map comes
+ * @param[in] map Memory that was mapped inside of which the memory range is
+ * @param[in] offset The offset in bytes from the start of the map address
+ * @param[in] length The length in bytes of the memory region, @c 0 for all
+ *            of the map after @p offset
+ * @return @c 0 on success, @c EIO on an IO error, @c EINVAL if @p map is
+ *         not a mapping of @p file
+ *
+ * @since 1.22
+ */
+EAPI Eina_Error
+eina_file_map_prefetch(Eina_File *file, const void *map,
+                       unsigned long int offset, unsigned long int length);
+
 /**
  * @brief Maps line by line in the memory efficiently using an #Eina_Iterator.
  * @details This function returns an iterator that acts like fgets without
@@ -20,6 +20,7 @@
 # include "config.h"
 #endif
 
+#include <errno.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -865,6 +866,14 @@ eina_file_map_populate(Eina_File *file EINA_UNUSED, Eina_File_Populate rule EINA
 {
 }
 
+EAPI Eina_Error
+eina_file_map_prefetch(Eina_File *file, const void *map EINA_UNUSED,
+                       unsigned long int offset EINA_UNUSED, unsigned long int length EINA_UNUSED)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(file, EINVAL);
+   return 0;
+}
+
 EAPI void *
 eina_file_map_all(Eina_File *file, Eina_File_Populate rule EINA_UNUSED)
 {
@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "eina_config.h"
@@ -34,6 +35,7 @@
 #include "eina_safety_checks.h"
 #include "eina_hash.h"
 #include "eina_list.h"
+#include "eina_simd.h"
 
 /*============================================================================*
 *                                  Local                                     *
@@ -63,8 +65,14 @@
 
 #define EINA_HASH_RBTREE_MASK       0xFFFF
 
+/* open addressing backend: first allocation and maximum load (7/8) */
+#define EINA_HASH_OPEN_MIN_POWER    3
+#define EINA_HASH_OPEN_LOAD_NUM     7
+#define EINA_HASH_OPEN_LOAD_DEN     8
+
 typedef struct _Eina_Hash_Head         Eina_Hash_Head;
 typedef struct _Eina_Hash_Element      Eina_Hash_Element;
+typedef struct _Eina_Hash_Slot         Eina_Hash_Slot;
 typedef struct _Eina_Hash_Foreach_Data Eina_Hash_Foreach_Data;
 typedef struct _Eina_Iterator_Hash     Eina_Iterator_Hash;
 typedef struct _Eina_Hash_Each         Eina_Hash_Each;
@@ -84,6 +92,11 @@ struct _Eina_Hash
 
    int             buckets_power_size;
 
+   Eina_Hash_Slot *slots;
+   int             slots_power_size;
+
+   Eina_Hash_Backend backend;
+
    EINA_MAGIC
 };
 
@@ -102,6 +115,15 @@ struct _Eina_Hash_Element
    Eina_Hash_Tuple tuple;
 };
 
+/* The tuple must stay first, so a tuple pointer can be turned back into its slot. */
+struct _Eina_Hash_Slot
+{
+   Eina_Hash_Tuple tuple;
+   unsigned int    hash;
+   unsigned int    distance : 31; /* probe distance + 1, 0 means the slot is empty */
+   unsigned int    own_key : 1; /* key was copied by eina_hash_add() */
+};
+
 struct _Eina_Hash_Foreach_Data
 {
    Eina_Hash_Foreach cb;
@@ -123,6 +145,7 @@ struct _Eina_Iterator_Hash
    Eina_Iterator                     *list;
    Eina_Hash_Head                    *hash_head;
    Eina_Hash_Element                 *hash_element;
+   Eina_Hash_Tuple                   *tuple;
    int                                bucket;
 
    int                                index;
@@ -148,6 +171,213 @@ struct _Eina_Hash_Each
                        + (uint32_t)(((const uint8_t *)(d))[0]))
 #endif
 
+static Eina_Hash_Backend _eina_hash_default_backend = EINA_HASH_BACKEND_RBTREE;
+
+static inline unsigned int
+_eina_hash_open_index(const Eina_Hash *hash, unsigned int key_hash)
+{
+   /* Fibonacci hashing, so that weak hash functions still use all the slots. */
+   return (key_hash * 2654435769U) >> (32 - hash->slots_power_size);
+}
+
+static void
+_eina_hash_open_place(Eina_Hash *hash, const Eina_Hash_Slot *entry)
+{
+   Eina_Hash_Slot cur = *entry;
+   unsigned int mask = (1U << hash->slots_power_size) - 1;
+   unsigned int idx;
+
+   idx = _eina_hash_open_index(hash, cur.hash);
+   for (cur.distance = 1; ; idx = (idx + 1) & mask, cur.distance++)
+     {
+        Eina_Hash_Slot *slot = hash->slots + idx;
+
+        if (!slot->distance)
+          {
+             *slot = cur;
+             return;
+          }
+
+        /* Robin hood: steal the slot of an entry closer to its home. */
+        if (slot->distance < cur.distance)
+          {
+             Eina_Hash_Slot tmp = *slot;
+
+             *slot = cur;
+             cur = tmp;
+          }
+     }
+}
+
+static Eina_Bool
+_eina_hash_open_grow(Eina_Hash *hash)
+{
+   Eina_Hash_Slot *old = hash->slots;
+   int old_size = old ? 1 << hash->slots_power_size : 0;
+   int power = old ? hash->slots_power_size + 1 : EINA_HASH_OPEN_MIN_POWER;
+   int i;
+
+   if (power > 30) return EINA_FALSE;
+
+   hash->slots = calloc(1 << power, sizeof (Eina_Hash_Slot));
+   if (!hash->slots)
+     {
+        hash->slots = old;
+        return EINA_FALSE;
+     }
+   hash->slots_power_size = power;
+
+   for (i = 0; i < old_size; i++)
+     if (old[i].distance)
+       _eina_hash_open_place(hash, old + i);
+
+   free(old);
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_hash_open_add(Eina_Hash *hash,
+                    const void *key, int key_length, int alloc_length,
+                    int key_hash,
+                    const void *data)
+{
+   Eina_Hash_Slot entry;
+
+   if (!hash->slots ||
+       (hash->population + 1) * EINA_HASH_OPEN_LOAD_DEN >
+       (1 << hash->slots_power_size) * EINA_HASH_OPEN_LOAD_NUM)
+     {
+        if (!_eina_hash_open_grow(hash))
+          return EINA_FALSE;
+     }
+
+   entry.tuple.key_length = key_length;
+   entry.tuple.data = (void *)data;
+   entry.hash = key_hash;
+   entry.own_key = alloc_length > 0;
+   if (entry.own_key)
+     {
+        entry.tuple.key = malloc(alloc_length);
+        if (!entry.tuple.key)
+          return EINA_FALSE;
+        memcpy((void *)entry.tuple.key, key, alloc_length);
+     }
+   else
+     entry.tuple.key = key;
+
+   _eina_hash_open_place(hash, &entry);
+   hash->population++;
+   return EINA_TRUE;
+}
+
+static inline Eina_Hash_Slot *
+_eina_hash_open_find(const Eina_Hash *hash,
+                     const Eina_Hash_Tuple *tuple,
+                     unsigned int key_hash)
+{
+   unsigned int mask, idx, distance;
+
+   if (!hash->slots)
+     return NULL;
+
+   mask = (1U << hash->slots_power_size) - 1;
+   idx = _eina_hash_open_index(hash, key_hash);
+   for (distance = 1; ; idx = (idx + 1) & mask, distance++)
+     {
+        Eina_Hash_Slot *slot = hash->slots + idx;
+
+        /* An empty slot, or an entry closer to its home, ends the probe. */
+        if (slot->distance < distance)
+          return NULL;
+        if (slot->hash != key_hash)
+          continue;
+        if (hash->key_cmp_cb(slot->tuple.key, slot->tuple.key_length,
+                             tuple->key, tuple->key_length))
+          continue;
+        if (tuple->data && tuple->data != slot->tuple.data)
+          continue;
+        return slot;
+     }
+}
+
+static Eina_Hash_Slot *
+_eina_hash_open_find_by_data(const Eina_Hash *hash, const void *data)
+{
+   int i, size;
+
+   if (!hash->slots)
+     return NULL;
+
+   size = 1 << hash->slots_power_size;
+   for (i = 0; i < size; i++)
+     if (hash->slots[i].distance && hash->slots[i].tuple.data == data)
+       return hash->slots + i;
+
+   return NULL;
+}
+
+static void
+_eina_hash_open_del_slot(Eina_Hash *hash, Eina_Hash_Slot *slot)
+{
+   unsigned int mask = (1U << hash->slots_power_size) - 1;
+   unsigned int idx = slot - hash->slots;
+   Eina_Hash_Tuple tuple = slot->tuple;
+   Eina_Bool own_key = slot->own_key;
+
+   /* Backward shift deletion, so no tombstone is left behind. */
+   for (;;)
+     {
+        unsigned int next = (idx + 1) & mask;
+
+        if (hash->slots[next].distance <= 1)
+          break;
+
+        hash->slots[idx] = hash->slots[next];
+        hash->slots[idx].distance--;
+        idx = next;
+     }
+   hash->slots[idx].distance = 0;
+
+   hash->population--;
+   if (hash->population == 0)
+     {
+        free(hash->slots);
+        hash->slots = NULL;
+     }
+
+   if (own_key)
+     free((void *)tuple.key);
+   if (hash->data_free_cb)
+     hash->data_free_cb(tuple.data);
+}
+
+static void
+_eina_hash_open_flush(Eina_Hash *hash)
+{
+   int i, size;
+
+   if (!hash->slots)
+     return;
+
+   size = 1 << hash->slots_power_size;
+   for (i = 0; i < size; i++)
+     {
+        Eina_Hash_Slot *slot = hash->slots + i;
+
+        if (!slot->distance)
+          continue;
+
+        if (hash->data_free_cb)
+          hash->data_free_cb(slot->tuple.data);
+        if (slot->own_key)
+          free((void *)slot->tuple.key);
+     }
+
+   free(hash->slots);
+   hash->slots = NULL;
+   hash->population = 0;
+}
+
 static inline int
 _eina_hash_hash_rbtree_cmp_hash(const Eina_Hash_Head *hash_head,
                                 const int *hash,
@@ -218,6 +448,10 @@ eina_hash_add_alloc_by_hash(Eina_Hash *hash,
    EINA_SAFETY_ON_NULL_RETURN_VAL(data, EINA_FALSE);
    EINA_MAGIC_CHECK_HASH(hash);
 
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     return _eina_hash_open_add(hash, key, key_length, alloc_length,
+                                key_hash, data);
+
    /* Apply eina mask to hash. */
    hash_num = key_hash & hash->mask;
    key_hash >>= hash->buckets_power_size;
@@ -434,6 +668,43 @@ _eina_hash_del_by_hash_el(Eina_Hash *hash,
    return EINA_TRUE;
 }
 
+static inline Eina_Hash_Tuple *
+_eina_hash_tuple_find(const Eina_Hash *hash,
+                      Eina_Hash_Tuple *tuple,
+                      int key_hash,
+                      Eina_Hash_Head **hash_head)
+{
+   Eina_Hash_Element *hash_element;
+
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     return (Eina_Hash_Tuple *)_eina_hash_open_find(hash, tuple, key_hash);
+
+   hash_element = _eina_hash_find_by_hash(hash, tuple, key_hash, hash_head);
+   if (!hash_element)
+     return NULL;
+
+   return &hash_element->tuple;
+}
+
+static Eina_Bool
+_eina_hash_del_by_tuple(Eina_Hash *hash,
+                        Eina_Hash_Tuple *tuple,
+                        Eina_Hash_Head *hash_head,
+                        int key_hash)
+{
+   Eina_Hash_Element *hash_element;
+
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     {
+        _eina_hash_open_del_slot(hash, (Eina_Hash_Slot *)tuple);
+        return EINA_TRUE;
+     }
+
+   hash_element = (Eina_Hash_Element *)
+     ((char *)tuple - offsetof(Eina_Hash_Element, tuple));
+   return _eina_hash_del_by_hash_el(hash, hash_element, hash_head, key_hash);
+}
+
 static Eina_Bool
 _eina_hash_del_by_key_hash(Eina_Hash *hash,
                            const void *key,
@@ -441,26 +712,26 @@ _eina_hash_del_by_key_hash(Eina_Hash *hash,
                            int key_hash,
                            const void *data)
 {
-   Eina_Hash_Element *hash_element;
-   Eina_Hash_Head *hash_head;
+   Eina_Hash_Tuple *found;
+   Eina_Hash_Head *hash_head = NULL;
    Eina_Hash_Tuple tuple;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(hash, EINA_FALSE);
    EINA_SAFETY_ON_NULL_RETURN_VAL(key, EINA_FALSE);
    EINA_MAGIC_CHECK_HASH(hash);
 
-   if (!hash->buckets)
+   if (!hash->population)
      return EINA_FALSE;
 
    tuple.key = (void *)key;
    tuple.key_length = key_length;
    tuple.data = (void *)data;
 
-   hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
-   if (!hash_element)
+   found = _eina_hash_tuple_find(hash, &tuple, key_hash, &hash_head);
+   if (!found)
      return EINA_FALSE;
 
-   return _eina_hash_del_by_hash_el(hash, hash_element, hash_head, key_hash);
+   return _eina_hash_del_by_tuple(hash, found, hash_head, key_hash);
 }
 
 static void
@@ -479,7 +750,7 @@ _eina_hash_del_by_key(Eina_Hash *hash, const void *key, const void *data)
    EINA_SAFETY_ON_NULL_RETURN_VAL(key, EINA_FALSE);
    EINA_MAGIC_CHECK_HASH(hash);
 
-   if (!hash->buckets)
+   if (!hash->population)
      return EINA_FALSE;
 
    _eina_hash_compute(hash, key, &key_length, &key_hash);
@@ -578,46 +849,43 @@ _eina_foreach_cb(const Eina_Hash *hash,
 static void *
 _eina_hash_iterator_data_get_content(Eina_Iterator_Hash *it)
 {
-   Eina_Hash_Element *stuff;
+   Eina_Hash_Tuple *stuff;
 
    EINA_MAGIC_CHECK_HASH_ITERATOR(it, NULL);
 
-   stuff = it->hash_element;
+   stuff = it->tuple;
 
    if (!stuff)
      return NULL;
 
-   return stuff->tuple.data;
+   return stuff->data;
 }
 
 static void *
 _eina_hash_iterator_key_get_content(Eina_Iterator_Hash *it)
 {
-   Eina_Hash_Element *stuff;
+   Eina_Hash_Tuple *stuff;
 
    EINA_MAGIC_CHECK_HASH_ITERATOR(it, NULL);
 
-   stuff = it->hash_element;
+   stuff = it->tuple;
 
    if (!stuff)
      return NULL;
 
-   return (void *)stuff->tuple.key;
+   return (void *)stuff->key;
 }
 
 static Eina_Hash_Tuple *
 _eina_hash_iterator_tuple_get_content(Eina_Iterator_Hash *it)
 {
-   Eina_Hash_Element *stuff;
+   Eina_Hash_Tuple *stuff;
 
    EINA_MAGIC_CHECK_HASH_ITERATOR(it, NULL);
 
-   stuff = it->hash_element;
+   stuff = it->tuple;
 
-   if (!stuff)
-     return NULL;
-
-   return &stuff->tuple;
+   return stuff;
 }
 
 static Eina_Bool
@@ -691,11 +959,39 @@ _eina_hash_iterator_next(Eina_Iterator_Hash *it, void **data)
    it->bucket = bucket;
 
    if (ok)
-     *data = it->get_content(it);
+     {
+        it->tuple = &it->hash_element->tuple;
+        *data = it->get_content(it);
+     }
 
    return ok;
 }
 
+static Eina_Bool
+_eina_hash_iterator_open_next(Eina_Iterator_Hash *it, void **data)
+{
+   const Eina_Hash *hash = it->hash;
+   int size;
+
+   if (!hash->slots)
+     return EINA_FALSE;
+
+   size = 1 << hash->slots_power_size;
+   while (it->bucket < size)
+     {
+        Eina_Hash_Slot *slot = hash->slots + it->bucket++;
+
+        if (!slot->distance)
+          continue;
+
+        it->tuple = &slot->tuple;
+        *data = it->get_content(it);
+        return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
 static void *
 _eina_hash_iterator_get_container(Eina_Iterator_Hash *it)
 {
@@ -724,6 +1020,43 @@ _eina_hash_iterator_free(Eina_Iterator_Hash *it)
 *                                 Global                                     *
 *============================================================================*/
 
+/**
+ * @internal
+ * @brief Initialize the hash module.
+ *
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * This function picks the default hash backend from the
+ * EINA_HASH_BACKEND environment variable.
+ *
+ * @see eina_init()
+ */
+Eina_Bool
+eina_hash_init(void)
+{
+   const char *backend;
+
+   backend = getenv("EINA_HASH_BACKEND");
+   if (backend && !strcmp(backend, "open"))
+     _eina_hash_default_backend = EINA_HASH_BACKEND_OPEN;
+
+   return EINA_TRUE;
+}
+
+/**
+ * @internal
+ * @brief Shut down the hash module.
+ *
+ * @return #EINA_TRUE on success, #EINA_FALSE on failure.
+ *
+ * @see eina_shutdown()
+ */
+Eina_Bool
+eina_hash_shutdown(void)
+{
+   return EINA_TRUE;
+}
+
 /*============================================================================*
 *                                   API                                      *
 *============================================================================*/
@@ -743,6 +1076,19 @@ eina_hash_new(Eina_Key_Length key_length_cb,
               Eina_Key_Hash key_hash_cb,
               Eina_Free_Cb data_free_cb,
               int buckets_power_size)
+{
+   return eina_hash_backend_new(_eina_hash_default_backend,
+                                key_length_cb, key_cmp_cb, key_hash_cb,
+                                data_free_cb, buckets_power_size);
+}
+
+EAPI Eina_Hash *
+eina_hash_backend_new(Eina_Hash_Backend backend,
+                      Eina_Key_Length key_length_cb,
+                      Eina_Key_Cmp key_cmp_cb,
+                      Eina_Key_Hash key_hash_cb,
+                      Eina_Free_Cb data_free_cb,
+                      int buckets_power_size)
 {
    /* FIXME: Use mempool. */
    Eina_Hash *new;
@@ -751,6 +1097,7 @@ eina_hash_new(Eina_Key_Length key_length_cb,
    EINA_SAFETY_ON_NULL_RETURN_VAL(key_hash_cb, NULL);
    EINA_SAFETY_ON_TRUE_RETURN_VAL(buckets_power_size <= 2, NULL);
    EINA_SAFETY_ON_TRUE_RETURN_VAL(buckets_power_size >= 17, NULL);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(backend > EINA_HASH_BACKEND_OPEN, NULL);
 
    new = malloc(sizeof (Eina_Hash));
    if (!new)
@@ -769,12 +1116,39 @@ eina_hash_new(Eina_Key_Length key_length_cb,
    new->mask = new->size - 1;
    new->buckets_power_size = buckets_power_size;
 
+   new->slots = NULL;
+   new->slots_power_size = 0;
+   new->backend = backend;
+
    return new;
 
 on_error:
    return NULL;
 }
 
+EAPI Eina_Hash_Backend
+eina_hash_backend_get(const Eina_Hash *hash)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(hash, EINA_HASH_BACKEND_RBTREE);
+   EINA_MAGIC_CHECK_HASH(hash);
+
+   return hash->backend;
+}
+
+EAPI void
+eina_hash_backend_default_set(Eina_Hash_Backend backend)
+{
+   EINA_SAFETY_ON_TRUE_RETURN(backend > EINA_HASH_BACKEND_OPEN);
+
+   _eina_hash_default_backend = backend;
+}
+
+EAPI Eina_Hash_Backend
+eina_hash_backend_default_get(void)
+{
+   return _eina_hash_default_backend;
+}
+
 EAPI Eina_Hash *
 eina_hash_string_djb2_new(Eina_Free_Cb data_free_cb)
 {
@@ -790,7 +1164,7 @@ eina_hash_string_superfast_new(Eina_Free_Cb data_free_cb)
 {
    return eina_hash_new(EINA_KEY_LENGTH(_eina_string_key_length),
                         EINA_KEY_CMP(_eina_string_key_cmp),
-                        EINA_KEY_HASH(eina_hash_superfast),
+                        EINA_KEY_HASH(eina_hash_fast),
                         data_free_cb,
                         EINA_HASH_BUCKET_SIZE);
 }
@@ -800,7 +1174,7 @@ eina_hash_string_small_new(Eina_Free_Cb data_free_cb)
 {
    return eina_hash_new(EINA_KEY_LENGTH(_eina_string_key_length),
                         EINA_KEY_CMP(_eina_string_key_cmp),
-                        EINA_KEY_HASH(eina_hash_superfast),
+                        EINA_KEY_HASH(eina_hash_fast),
                         data_free_cb,
                         EINA_HASH_SMALL_BUCKET_SIZE);
 }
@@ -872,7 +1246,9 @@ eina_hash_free(Eina_Hash *hash)
 
    EINA_MAGIC_CHECK_HASH(hash);
 
-   if (hash->buckets)
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     _eina_hash_open_flush(hash);
+   else if (hash->buckets)
      {
         for (i = 0; i < hash->size; i++)
           eina_rbtree_delete(hash->buckets[i], EINA_RBTREE_FREE_CB(_eina_hash_head_free), hash);
@@ -890,7 +1266,9 @@ eina_hash_free_buckets(Eina_Hash *hash)
 
    EINA_MAGIC_CHECK_HASH(hash);
 
-   if (hash->buckets)
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     _eina_hash_open_flush(hash);
+   else if (hash->buckets)
      {
         for (i = 0; i < hash->size; i++)
           eina_rbtree_delete(hash->buckets[i],
@@ -992,6 +1370,18 @@ eina_hash_del_by_data(Eina_Hash *hash, const void *data)
    EINA_SAFETY_ON_NULL_RETURN_VAL(data, EINA_FALSE);
    EINA_MAGIC_CHECK_HASH(hash);
 
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     {
+        Eina_Hash_Slot *slot;
+
+        slot = _eina_hash_open_find_by_data(hash, data);
+        if (!slot)
+          goto error;
+
+        _eina_hash_open_del_slot(hash, slot);
+        return EINA_TRUE;
+     }
+
    hash_element = _eina_hash_find_by_data(hash, data, &key_hash, &hash_head);
    if (!hash_element)
      goto error;
@@ -1044,7 +1434,7 @@ eina_hash_find_by_hash(const Eina_Hash *hash,
                        int key_hash)
 {
    Eina_Hash_Head *hash_head;
-   Eina_Hash_Element *hash_element;
+   Eina_Hash_Tuple *found;
    Eina_Hash_Tuple tuple;
 
    if (!hash)
@@ -1057,9 +1447,9 @@ eina_hash_find_by_hash(const Eina_Hash *hash,
    tuple.key_length = key_length;
    tuple.data = NULL;
 
-   hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
-   if (hash_element)
-     return hash_element->tuple.data;
+   found = _eina_hash_tuple_find(hash, &tuple, key_hash, &hash_head);
+   if (found)
+     return found->data;
 
    return NULL;
 }
@@ -1090,7 +1480,7 @@ eina_hash_modify_by_hash(Eina_Hash *hash,
                          const void *data)
 {
    Eina_Hash_Head *hash_head;
-   Eina_Hash_Element *hash_element;
+   Eina_Hash_Tuple *found;
    void *old_data = NULL;
    Eina_Hash_Tuple tuple;
 
@@ -1103,11 +1493,11 @@ eina_hash_modify_by_hash(Eina_Hash *hash,
    tuple.key_length = key_length;
    tuple.data = NULL;
 
-   hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
-   if (hash_element)
+   found = _eina_hash_tuple_find(hash, &tuple, key_hash, &hash_head);
+   if (found)
      {
-        old_data = hash_element->tuple.data;
-        hash_element->tuple.data = (void *)data;
+        old_data = found->data;
+        found->data = (void *)data;
      }
 
    return old_data;
@@ -1117,8 +1507,8 @@ EAPI void *
 eina_hash_set(Eina_Hash *hash, const void *key, const void *data)
 {
    Eina_Hash_Tuple tuple;
-   Eina_Hash_Head *hash_head;
-   Eina_Hash_Element *hash_element;
+   Eina_Hash_Head *hash_head = NULL;
+   Eina_Hash_Tuple *found;
    int key_length;
    int key_hash;
 
@@ -1133,22 +1523,22 @@ eina_hash_set(Eina_Hash *hash, const void *key, const void *data)
    tuple.key_length = key_length;
    tuple.data = NULL;
 
-   hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
-   if (hash_element)
+   found = _eina_hash_tuple_find(hash, &tuple, key_hash, &hash_head);
+   if (found)
      {
         void *old_data = NULL;
 
-        old_data = hash_element->tuple.data;
+        old_data = found->data;
 
         if (data)
           {
-             hash_element->tuple.data = (void *)data;
+             found->data = (void *)data;
           }
         else
           {
              Eina_Free_Cb cb = hash->data_free_cb;
              hash->data_free_cb = NULL;
-             _eina_hash_del_by_hash_el(hash, hash_element, hash_head, key_hash);
+             _eina_hash_del_by_tuple(hash, found, hash_head, key_hash);
              hash->data_free_cb = cb;
           }
 
@@ -1253,7 +1643,10 @@ eina_hash_iterator_data_new(const Eina_Hash *hash)
    it->get_content = FUNC_ITERATOR_GET_CONTENT(_eina_hash_iterator_data_get_content);
 
    it->iterator.version = EINA_ITERATOR_VERSION;
-   it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_open_next);
+   else
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
        _eina_hash_iterator_get_container);
    it->iterator.free = FUNC_ITERATOR_FREE(_eina_hash_iterator_free);
@@ -1280,7 +1673,10 @@ eina_hash_iterator_key_new(const Eina_Hash *hash)
        _eina_hash_iterator_key_get_content);
 
    it->iterator.version = EINA_ITERATOR_VERSION;
-   it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_open_next);
+   else
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
        _eina_hash_iterator_get_container);
    it->iterator.free = FUNC_ITERATOR_FREE(_eina_hash_iterator_free);
@@ -1307,7 +1703,10 @@ eina_hash_iterator_tuple_new(const Eina_Hash *hash)
        _eina_hash_iterator_tuple_get_content);
 
    it->iterator.version = EINA_ITERATOR_VERSION;
-   it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
+   if (hash->backend == EINA_HASH_BACKEND_OPEN)
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_open_next);
+   else
+     it->iterator.next = FUNC_ITERATOR_NEXT(_eina_hash_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
        _eina_hash_iterator_get_container);
    it->iterator.free = FUNC_ITERATOR_FREE(_eina_hash_iterator_free);
@@ -1374,12 +1773,185 @@ eina_hash_superfast(const char *key, int len)
    return hash;
 }
 
+/* eina_hash_fast() is built like wyhash for short keys and like xxHash3
+ * for the long ones, with its own constants: it is meant for in memory
+ * tables only, the values are not stable across versions or byte order.
+ * Any random enough 64 bits words do as secret. */
+static const uint64_t _eina_hash_secret[24] = {
+   0x4728cfb0f8844cf8ULL, 0xf176f267746020eeULL, 0x68ea524aeb1b1aeeULL,
+   0x4e546b07993681fcULL, 0x68259d1eb10146b6ULL, 0xac0ba0c187172f2bULL,
+   0xdb59462f0f99699dULL, 0x6f5146c25c73bc83ULL, 0x9683de5a91190106ULL,
+   0x907ff5c68f1f99b7ULL, 0x234926b8930ddc0fULL, 0x90709400908287cfULL,
+   0x532eae99538d747bULL, 0x674e54e91fc1a4c3ULL, 0x8556f6796a690ae4ULL,
+   0xc7b8d481c10161a3ULL, 0xa9a082206ed20123ULL, 0x35b01fb38339183eULL,
+   0x56f10b4a1c5915fbULL, 0x1c6c521b8be3906dULL, 0x75d5de0f3ce5e274ULL,
+   0x8ca0b5c05665344dULL, 0x5ee6fc6756f6f017ULL, 0x28d7e089e9993d2dULL
+};
+
+/* 16 stripes of 64 bytes between two scrambles */
+#define EINA_HASH_FAST_BLOCK 1024
+
+static inline uint64_t
+_eina_hash_read64(const unsigned char *p)
+{
+   uint64_t v;
+
+   memcpy(&v, p, sizeof (v));
+   return v;
+}
+
+static inline uint64_t
+_eina_hash_read32(const unsigned char *p)
+{
+   uint32_t v;
+
+   memcpy(&v, p, sizeof (v));
+   return v;
+}
+
+/* full 64x64 bits product, both halves */
+static inline void
+_eina_hash_mum(uint64_t *a, uint64_t *b)
+{
+#ifdef __SIZEOF_INT128__
+   __uint128_t r = (__uint128_t)*a * *b;
+
+   *a = (uint64_t)r;
+   *b = (uint64_t)(r >> 64);
+#else
+   uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+   uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+   uint64_t t = rl + (rm0 << 32), lo, c = t < rl;
+
+   lo = t + (rm1 << 32);
+   c += lo < t;
+   *a = lo;
+   *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t
+_eina_hash_mix(uint64_t a, uint64_t b)
+{
+   _eina_hash_mum(&a, &b);
+   return a ^ b;
+}
+
+static uint64_t
+_eina_hash_fast_long(const unsigned char *p, size_t len, uint64_t seed)
+{
+   const uint64_t *secret = _eina_hash_secret;
+   uint64_t acc[8];
+   uint64_t h;
+   size_t nblocks, nstripes, n;
+   int i;
+
+   for (i = 0; i < 8; i++)
+     acc[i] = secret[i] ^ seed;
+
+   nblocks = (len - 1) / EINA_HASH_FAST_BLOCK;
+   for (n = 0; n < nblocks; n++, p += EINA_HASH_FAST_BLOCK)
+     {
+        eina_simd_hash_accumulate(acc, p, EINA_HASH_FAST_BLOCK / 64, secret);
+        /* keep the high bits of the products moving down */
+        for (i = 0; i < 8; i++)
+          acc[i] = (acc[i] ^ (acc[i] >> 47) ^ secret[16 + i]) * 0x9e3779b1U;
+     }
+
+   /* the stripes left, then the last 64 bytes even if they overlap */
+   len -= nblocks * EINA_HASH_FAST_BLOCK;
+   nstripes = (len - 1) / 64;
+   eina_simd_hash_accumulate(acc, p, nstripes, secret);
+   eina_simd_hash_accumulate(acc, p + len - 64, 1, secret + 9);
+
+   h = (len + nblocks * EINA_HASH_FAST_BLOCK) * 0x9e3779b185ebca87ULL;
+   for (i = 0; i < 4; i++)
+     h += _eina_hash_mix(acc[2 * i] ^ secret[1 + 2 * i],
+                         acc[2 * i + 1] ^ secret[2 + 2 * i]);
+   h ^= h >> 37;
+   h *= 0x165667919e3779f9ULL;
+   h ^= h >> 32;
+   return h;
+}
+
+EAPI int
+eina_hash_fast(const char *key, int len)
+{
+   const unsigned char *p = (const unsigned char *)key;
+   const uint64_t *secret = _eina_hash_secret;
+   uint64_t seed, see1, see2, a, b, h;
+   size_t l = len, i;
+
+   seed = eina_seed ^ secret[0];
+   seed ^= _eina_hash_mix(seed ^ secret[0], secret[1]);
+   if (l <= 16)
+     {
+        if (l >= 4)
+          {
+             /* two overlapping reads of 4 bytes at each end */
+             a = (_eina_hash_read32(p) << 32) |
+               _eina_hash_read32(p + ((l >> 3) << 2));
+             b = (_eina_hash_read32(p + l - 4) << 32) |
+               _eina_hash_read32(p + l - 4 - ((l >> 3) << 2));
+          }
+        else if (l > 0)
+          {
+             a = ((uint64_t)p[0] << 16) | ((uint64_t)p[l >> 1] << 8) | p[l - 1];
+             b = 0;
+          }
+        else
+          a = b = 0;
+     }
+   else if (l <= 256)
+     {
+        i = l;
+        if (i > 48)
+          {
+             see1 = seed;
+             see2 = seed;
+             do
+               {
+                  seed = _eina_hash_mix(_eina_hash_read64(p) ^ secret[1],
+                                        _eina_hash_read64(p + 8) ^ seed);
+                  see1 = _eina_hash_mix(_eina_hash_read64(p + 16) ^ secret[2],
+                                        _eina_hash_read64(p + 24) ^ see1);
+                  see2 = _eina_hash_mix(_eina_hash_read64(p + 32) ^ secret[3],
+                                        _eina_hash_read64(p + 40) ^ see2);
+                  p += 48;
+                  i -= 48;
+               }
+             while (i > 48);
+             seed ^= see1 ^ see2;
+          }
+        while (i > 16)
+          {
+             seed = _eina_hash_mix(_eina_hash_read64(p) ^ secret[1],
+                                   _eina_hash_read64(p + 8) ^ seed);
+             p += 16;
+             i -= 16;
+          }
+        a = _eina_hash_read64(p + i - 16);
+        b = _eina_hash_read64(p + i - 8);
+     }
+   else
+     {
+        h = _eina_hash_fast_long(p, l, seed);
+        return (int)(h ^ (h >> 32));
+     }
+
+   a ^= secret[1];
+   b ^= seed;
+   _eina_hash_mum(&a, &b);
+   h = _eina_hash_mix(a ^ secret[0] ^ l, b ^ secret[1]);
+   return (int)(h ^ (h >> 32));
+}
+
 EAPI void
 eina_hash_list_append(Eina_Hash *hash, const void *key, const void *data)
 {
    Eina_Hash_Tuple tuple;
-   Eina_Hash_Head *hash_head;
-   Eina_Hash_Element *hash_element;
+   Eina_Hash_Head *hash_head = NULL;
+   Eina_Hash_Tuple *found;
    int key_length;
    int key_hash;
 
@@ -1395,9 +1967,9 @@ eina_hash_list_append(Eina_Hash *hash, const void *key, const void *data)
    tuple.key_length = key_length;
    tuple.data = NULL;
 
-   hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
-   if (hash_element)
-      hash_element->tuple.data = eina_list_append(hash_element->tuple.data, data);
+   found = _eina_hash_tuple_find(hash, &tuple, key_hash, &hash_head);
+   if (found)
+      found->data = eina_list_append(found->data, data);
    else
      eina_hash_add_alloc_by_hash(hash,
                             key,
@@ -1411,8 +1983,8 @@ EAPI void
 eina_hash_list_prepend(Eina_Hash *hash, const void *key, const void *data)
 {
    Eina_Hash_Tuple tuple;
-   Eina_Hash_Head *hash_head;
-   Eina_Hash_Element *hash_element;
+   Eina_Hash_Head *hash_head = NULL;
+   Eina_Hash_Tuple *found;
    int key_length;
    int key_hash;
 
@@ -1428,9 +2000,9 @@ eina_hash_list_prepend(Eina_Hash *hash, const void *key, const void *data)
    tuple.key_length = key_length;
    tuple.data = NULL;
 
-   hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
-   if (hash_element)
-      hash_element->tuple.data = eina_list_prepend(hash_element->tuple.data, data);
+   found = _eina_hash_tuple_find(hash, &tuple, key_hash, &hash_head);
+   if (found)
+      found->data = eina_list_prepend(found->data, data);
    else
      eina_hash_add_alloc_by_hash(hash,
                             key,
@@ -1444,8 +2016,8 @@ EAPI void
 eina_hash_list_remove(Eina_Hash *hash, const void *key, const void *data)
 {
    Eina_Hash_Tuple tuple;
-   Eina_Hash_Head *hash_head;
-   Eina_Hash_Element *hash_element;
+   Eina_Hash_Head *hash_head = NULL;
+   Eina_Hash_Tuple *found;
    int key_length;
    int key_hash;
 
@@ -1461,9 +2033,9 @@ eina_hash_list_remove(Eina_Hash *hash, const void *key, const void *data)
    tuple.key_length = key_length;
    tuple.data = NULL;
 
-   hash_element = _eina_hash_find_by_hash(hash, &tuple, key_hash, &hash_head);
-   if (!hash_element) return;
-   hash_element->tuple.data = eina_list_remove(hash_element->tuple.data, data);
-   if (!hash_element->tuple.data)
-     _eina_hash_del_by_hash_el(hash, hash_element, hash_head, key_hash);
+   found = _eina_hash_tuple_find(hash, &tuple, key_hash, &hash_head);
+   if (!found) return;
+   found->data = eina_list_remove(found->data, data);
+   if (!found->data)
+     _eina_hash_del_by_tuple(hash, found, hash_head, key_hash);
 }
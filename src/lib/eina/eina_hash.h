@@ -211,32 +211,35 @@
  * (less than 30) will be added to the hash table, @ref
  * eina_hash_string_small_new should be used, since it reduces the memory
  * consumption for the buckets without causing too many collisions.
- * However, @ref eina_hash_string_small_new still uses the same hash calculation
- * function that @ref eina_hash_string_superfast_new, which is more complex than
- * @ref eina_hash_string_djb2_new. The latter has a faster hash computation
- * function, but that will imply a not so good distribution. But if just a
- * few keys are being added, this is not a problem, it will still have not many
- * collisions and be faster to calculate the hash than in a hash created with
- * @ref eina_hash_string_small_new and @ref eina_hash_string_superfast_new.
+ * @ref eina_hash_string_small_new uses the same hash calculation function as
+ * @ref eina_hash_string_superfast_new, eina_hash_fast(), which works on 8 or
+ * more bytes at a time and distributes much better than the byte at a time
+ * djb2 of @ref eina_hash_string_djb2_new. Only for keys of a few bytes is
+ * djb2 still about as fast.
  *
  * A simple comparison between them would be:
  *
- * @li @c djb2 - faster hash function - 256 buckets (higher memory consumption)
- * @li @c string_small - slower hash function but less collisions - 32 buckets
+ * @li @c djb2 - simple hash function, more collisions on long keys - 256 buckets
+ * (higher memory consumption)
+ * @li @c string_small - fast hash function, few collisions - 32 buckets
  * (lower memory consumption)
- * @li @c string_superfast - slower hash function but less collisions - 256 buckets
- * (higher memory consumption) - not randomized, avoid it on public remote interface.
+ * @li @c string_superfast - fast hash function, few collisions - 256 buckets
+ * (higher memory consumption)
  *
- * Basically for a very small number of keys (10 or less), @c djb2 should be
- * used, or @c string_small if you have a restriction on memory usage. And for a
- * higher number of keys, @c string_superfast should be preferred if not used on a
- * public remote interface.
+ * Basically @c string_superfast should be preferred, or @c string_small if you
+ * have a restriction on memory usage.
  *
  * If just stringshared keys are being added, use @ref
  * eina_hash_stringshared_new. If a lot of keys will be added to the hash table
  * (e.g. more than 1000), then it's better to increase the buckets_power_size.
  * See @ref eina_hash_new for more details.
  *
+ * Hash tables that are mostly used for lookups can use the
+ * #EINA_HASH_BACKEND_OPEN backend, either with @ref eina_hash_backend_new or
+ * for all new tables with @ref eina_hash_backend_default_set. It keeps all
+ * entries in a single array, avoiding an allocation per entry and the pointer
+ * chasing of the tree buckets.
+ *
  * When adding a new key to a hash table, use @ref eina_hash_add or @ref
  * eina_hash_direct_add (the latter if this key is already stored elsewhere). If
  * the key may be already inside the hash table, rather than checking with
@@ -343,6 +346,18 @@ typedef int          (*Eina_Key_Hash)(const void *key, int key_length);
  */
 typedef Eina_Bool    (*Eina_Hash_Foreach)(const Eina_Hash *hash, const void *key, void *data, void *fdata);
 
+/**
+ * @typedef Eina_Hash_Backend
+ * Storage layout used by a hash table.
+ *
+ * @since 1.22
+ */
+typedef enum _Eina_Hash_Backend
+{
+   EINA_HASH_BACKEND_RBTREE = 0, /**< Array of buckets, each bucket being a red black tree of nodes. This is the default. */
+   EINA_HASH_BACKEND_OPEN /**< Single flat array using open addressing with robin hood probing. Hash, key and data are stored inline. */
+} Eina_Hash_Backend;
+
 
 /**
  * @brief Creates a new hash table.
@@ -372,6 +387,9 @@ typedef Eina_Bool    (*Eina_Hash_Foreach)(const Eina_Hash *hash, const void *key
  * eina_hash_string_small_new(), eina_hash_int32_new(),
  * eina_hash_int64_new(), eina_hash_pointer_new() and
  * eina_hash_stringshared_new().
+ *
+ * The hash table uses the backend returned by
+ * eina_hash_backend_default_get().
  */
 EAPI Eina_Hash *eina_hash_new(Eina_Key_Length key_length_cb,
                               Eina_Key_Cmp    key_cmp_cb,
@@ -379,6 +397,71 @@ EAPI Eina_Hash *eina_hash_new(Eina_Key_Length key_length_cb,
                               Eina_Free_Cb    data_free_cb,
                               int             buckets_power_size) EINA_MALLOC EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(2, 3);
 
+/**
+ * @brief Creates a new hash table with an explicit storage backend.
+ *
+ * @param[in] backend The storage layout to use.
+ * @param[in] key_length_cb The function called when getting the size of the key.
+ * @param[in] key_cmp_cb The function called when comparing the keys.
+ * @param[in] key_hash_cb The function called when getting the values.
+ * @param[in] data_free_cb The function called on each value when the hash table is
+ * freed, or when an item is deleted from it. @c NULL can be passed as a
+ * callback.
+ * @param[in] buckets_power_size The size of the buckets.
+ * @return The new hash table, or @c NULL on failure.
+ *
+ * This function behaves like eina_hash_new(), but does not depend on
+ * the process wide default backend. With #EINA_HASH_BACKEND_OPEN, the
+ * table grows on demand and @p buckets_power_size is only checked for
+ * validity.
+ *
+ * The #EINA_HASH_BACKEND_OPEN backend moves entries around when the
+ * table is modified, so the pointers returned by a tuple iterator are
+ * only valid until the next modification of the hash.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Hash *eina_hash_backend_new(Eina_Hash_Backend backend,
+                                      Eina_Key_Length key_length_cb,
+                                      Eina_Key_Cmp    key_cmp_cb,
+                                      Eina_Key_Hash   key_hash_cb,
+                                      Eina_Free_Cb    data_free_cb,
+                                      int             buckets_power_size) EINA_MALLOC EINA_WARN_UNUSED_RESULT EINA_ARG_NONNULL(3, 4);
+
+/**
+ * @brief Gets the storage backend of a hash table.
+ *
+ * @param[in] hash The given hash table.
+ * @return The backend used by @p hash.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Hash_Backend eina_hash_backend_get(const Eina_Hash *hash) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Sets the backend used by newly created hash tables.
+ *
+ * @param[in] backend The storage layout to use.
+ *
+ * This affects eina_hash_new() and all the eina_hash_*_new() helpers
+ * called after it. Already existing hash tables are not changed. The
+ * initial value is #EINA_HASH_BACKEND_RBTREE, unless the environment
+ * variable @c EINA_HASH_BACKEND is set to @c "open" when eina_init()
+ * is called.
+ *
+ * @since 1.22
+ */
+EAPI void eina_hash_backend_default_set(Eina_Hash_Backend backend);
+
+/**
+ * @brief Gets the backend used by newly created hash tables.
+ *
+ * @return The current default backend.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Hash_Backend eina_hash_backend_default_get(void);
+
 /**
  * @brief Sets the data cleanup callback for a hash.
  *
@@ -418,14 +501,17 @@ EAPI Eina_Hash *eina_hash_string_djb2_new(Eina_Free_Cb data_free_cb);
  * callback.
  * @return The new hash table, or @c NULL on failure.
  *
- * This function creates a new hash table using the superfast algorithm
+ * This function creates a new hash table using eina_hash_fast()
  * for table management and strcmp() to compare the keys. Values can
  * then be looked up with pointers other than the original key pointer
  * that was used to add values.
  *
+ * @note Before 1.22 this used eina_hash_superfast(). Code passing its own
+ * key hash to the *_by_hash() functions has to use eina_hash_fast().
+ *
  * @warning Don't use this kind of hash when there is a possibility to
- * remotely request and push data in it. This hash is subject to denial
- * of service.
+ * remotely request and push data in it. The hash is seeded per process,
+ * but not strong enough to resist a determined denial of service.
  */
 EAPI Eina_Hash *eina_hash_string_superfast_new(Eina_Free_Cb data_free_cb);
 
@@ -437,7 +523,7 @@ EAPI Eina_Hash *eina_hash_string_superfast_new(Eina_Free_Cb data_free_cb);
  * callback.
  * @return The new hash table, or @c NULL on failure.
  *
- * This function creates a new hash table using the superfast algorithm
+ * This function creates a new hash table using eina_hash_fast()
  * for table management and strcmp() to compare the keys, but with a
  * smaller bucket size (compared to eina_hash_string_superfast_new())
  * which will minimize the memory used by the returned hash
@@ -1076,6 +1162,24 @@ EAPI void eina_hash_list_remove(Eina_Hash *hash, const void *key, const void *da
 EAPI int eina_hash_superfast(const char *key,
                              int         len) EINA_ARG_NONNULL(1);
 
+/**
+ * @brief
+ * Hash function of the wyhash and xxHash3 family, the one behind
+ * eina_hash_string_superfast_new() and stringshare.
+ *
+ * Long keys are mixed 64 bytes at a time with SSE2, AVX2 or NEON when the
+ * cpu has them. The result depends on the per process seed and may change
+ * between versions, so it must not be stored.
+ *
+ * @param[in] key The key to hash.
+ * @param[in] len The length of the key.
+ * @return The hash value.
+ *
+ * @since 1.22
+ */
+EAPI int eina_hash_fast(const char *key,
+                        int         len) EINA_ARG_NONNULL(1);
+
 /**
  * @brief
  * Hash function first reported by Dan Bernstein many years ago in comp.lang.c
@@ -163,6 +163,30 @@ eina_value_flush(Eina_Value *value)
    value->type = NULL;
 }
 
+static inline Eina_Bool
+eina_value_move(Eina_Value *dst, Eina_Value *src)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(dst, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(src, EINA_FALSE);
+
+   if (dst == src) return EINA_TRUE;
+   eina_value_flush(dst);
+   /* the storage is either inline or behind value.ptr, both move as is */
+   memcpy(dst, src, sizeof(Eina_Value));
+   memset(src, 0, sizeof(Eina_Value));
+   return EINA_TRUE;
+}
+
+static inline Eina_Value
+eina_value_steal(Eina_Value *value)
+{
+   Eina_Value r;
+
+   memcpy(&r, value, sizeof(Eina_Value));
+   memset(value, 0, sizeof(Eina_Value));
+   return r;
+}
+
 static inline int
 eina_value_compare(const Eina_Value *a, const Eina_Value *b)
 {
@@ -816,6 +840,41 @@ eina_value_array_pappend(Eina_Value *value, const void *ptr)
    return EINA_FALSE;
 }
 
+static inline Eina_Bool
+eina_value_array_append_steal(Eina_Value *value, Eina_Value *item)
+{
+   Eina_Value_Array desc;
+   const Eina_Value_Type *type;
+   void *mem;
+
+   EINA_VALUE_TYPE_ARRAY_CHECK_RETURN_VAL(value, 0);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(item, EINA_FALSE);
+   if (!eina_value_pget(value, &desc))
+     return EINA_FALSE;
+
+   type = item->type;
+   if (desc.subtype != EINA_VALUE_TYPE_VALUE)
+     {
+        EINA_SAFETY_ON_FALSE_RETURN_VAL(type == desc.subtype, EINA_FALSE);
+     }
+
+   mem = eina_inarray_grow(desc.array, 1);
+   if (!mem)
+     return EINA_FALSE;
+
+   if (desc.subtype == EINA_VALUE_TYPE_VALUE)
+     memcpy(mem, item, sizeof(Eina_Value));
+   else
+     {
+        /* take the payload as is and release the now empty holder */
+        memcpy(mem, eina_value_memory_get(item), type->value_size);
+        if (type->value_size > 8)
+          eina_value_inner_free(type->value_size, item->value.ptr);
+     }
+   memset(item, 0, sizeof(Eina_Value));
+   return EINA_TRUE;
+}
+
 static inline Eina_Bool
 eina_value_array_value_get(const Eina_Value *src, unsigned int position, Eina_Value *dst)
 {
@@ -306,7 +306,8 @@ eina_value_dup(const Eina_Value *val)
 {
    Eina_Value *v;
 
-   v = eina_value_new(eina_value_type_get(val));
+   /* eina_value_copy() sets the value up, do not allocate its storage twice */
+   v = eina_value_new(NULL);
    EINA_SAFETY_ON_NULL_RETURN_VAL(v, NULL);
    if (!eina_value_copy(val, v))
      {
@@ -327,8 +328,7 @@ eina_value_reference_copy(const Eina_Value *val)
 {
    Eina_Value v = EINA_VALUE_EMPTY;
 
-   if (!eina_value_setup(&v, eina_value_type_get(val)) ||
-       !eina_value_copy(val, &v))
+   if (!eina_value_copy(val, &v))
      {
         eina_value_setup(&v, EINA_VALUE_TYPE_ERROR);
         eina_value_set(&v, EINA_ERROR_VALUE_FAILED);
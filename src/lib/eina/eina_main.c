@@ -135,6 +135,7 @@ extern Eina_Lock       _sysmon_lock;
    S(module);
    S(mempool);
    S(list);
+   S(hash);
    S(binshare);
    S(stringshare);
    S(ustringshare);
@@ -152,6 +153,7 @@ extern Eina_Lock       _sysmon_lock;
    S(thread);
    S(cow);
    S(cpu);
+   S(simd);
    S(thread_queue);
    S(rbtree);
    S(file);
@@ -174,6 +176,7 @@ static const struct eina_desc_setup _eina_desc_setup[] = {
    S(module),
    S(mempool),
    S(list),
+   S(hash),
    S(stringshare),
    S(vpath),
    S(debug),
@@ -201,6 +204,7 @@ static const struct eina_desc_setup _eina_desc_setup[] = {
    S(thread),
    S(cow),
    S(cpu),
+   S(simd),
    S(thread_queue),
    S(rbtree),
    S(file),
@@ -127,6 +127,11 @@ Eina_Bool pass_through_init(void);
 void      pass_through_shutdown(void);
 #endif
 
+#ifdef EINA_STATIC_BUILD_SLAB
+Eina_Bool slab_init(void);
+void      slab_shutdown(void);
+#endif
+
 /**
  * @endcond
  */
@@ -209,6 +214,9 @@ eina_mempool_init(void)
 #ifdef EINA_STATIC_BUILD_PASS_THROUGH
    pass_through_init();
 #endif
+#ifdef EINA_STATIC_BUILD_SLAB
+   slab_init();
+#endif
 
    return EINA_TRUE;
 
@@ -231,6 +239,9 @@ eina_mempool_shutdown(void)
 #endif
 #ifdef EINA_STATIC_BUILD_PASS_THROUGH
    pass_through_shutdown();
+#endif
+#ifdef EINA_STATIC_BUILD_SLAB
+   slab_shutdown();
 #endif
    /* dynamic backends */
    eina_module_list_free(_modules);
@@ -36,12 +36,22 @@
  * requested size that are pushed inside a stack. When requested, it
  * takes this pointer from the stack to give them to whoever wants
  * them.
+ * @li @c chained_magazine: It is a chained_pool with a small per thread
+ * cache of items in front of it. Allocations and frees are served from the
+ * calling thread cache without locking, and the caches exchange batches of
+ * items with each other before going back to the chained pool. Use it for
+ * pools shared by many threads. (Since 1.22)
  * @li @c pass_through: it just call malloc() and free(). It may be
  * faster on some computers than using our own allocators (like having
  * a huge L2 cache, over 4MB).
  * @li @c one_big: It calls malloc() just one time for the requested number
  * of items. This is useful when you know in advance how many objects of some
  * type live during the life of the mempool.
+ * @li @c slab: It serves any size, unlike the other mempools. Requests are
+ * rounded up to one of a set of size classes, each class carving its items
+ * out of its own slabs. Slabs are allocated from big arenas that use huge
+ * pages when the system supports it. eina_mempool_statistics() logs the
+ * occupancy and fragmentation of every class. (Since 1.22)
  *
  * @{
  */
@@ -114,6 +114,9 @@ struct _Eina_Future {
    const void *data;
    Eina_Future **storage;
    Eina_Future_Schedule_Entry *scheduled_entry;
+   /* The callback takes over the value it gets instead of copying it,
+      whatever it returns is a new value. Only used internally. */
+   Eina_Bool consume : 1;
 };
 
 static Eina_Mempool *_promise_mp = NULL;
@@ -353,10 +356,12 @@ _eina_future_cb_dispatch(Eina_Future *f, const Eina_Value value)
 
 static Eina_Value
 _eina_future_dispatch_internal(Eina_Future **f,
-                               const Eina_Value value)
+                               const Eina_Value value,
+                               Eina_Bool *consumed)
 {
    Eina_Value next_value = EINA_VALUE_EMPTY;
 
+   *consumed = EINA_FALSE;
    assert(value.type != &EINA_VALUE_TYPE_PROMISE);
    while ((*f) && (!(*f)->cb)) *f = _eina_future_free(*f);
    if (!*f)
@@ -364,6 +369,7 @@ _eina_future_dispatch_internal(Eina_Future **f,
         _eina_promise_value_dbg("No future to deliver value", NULL, value);
         return value;
      }
+   *consumed = (*f)->consume;
    next_value = _eina_future_cb_dispatch(*f, value);
    *f = _eina_future_free(*f);
    return next_value;
@@ -383,8 +389,10 @@ _eina_value_is(const Eina_Value v1, const Eina_Value v2)
 static void
 _eina_future_dispatch(Eina_Future_Scheduler *scheduler, Eina_Future *f, Eina_Value value)
 {
-    Eina_Value next_value = _eina_future_dispatch_internal(&f, value);
-    if (!_eina_value_is(next_value, value)) eina_value_flush(&value);
+    Eina_Bool consumed;
+    Eina_Value next_value = _eina_future_dispatch_internal(&f, value, &consumed);
+    if ((!consumed) && (!_eina_value_is(next_value, value)))
+      eina_value_flush(&value);
     if (!f)
       {
          if (next_value.type == &EINA_VALUE_TYPE_PROMISE)
@@ -461,6 +469,8 @@ _eina_future_cancel(Eina_Future *f, int err)
    eina_value_setup(&value, EINA_VALUE_TYPE_ERROR);
    eina_value_set(&value, err);
 
+   /* An error has no storage, so consuming futures may keep it as is
+      while it is flushed here. */
    while (f)
      {
         if (f->cb)
@@ -647,19 +657,11 @@ static Eina_Value
 _future_proxy(void *data, const Eina_Value v,
               const Eina_Future *dead_future EINA_UNUSED)
 {
-   Eina_Value copy = EINA_VALUE_EMPTY;
-
    if (eina_value_type_get(&v) == EINA_VALUE_TYPE_ERROR) return v;
    //We're in a safe context (from mainloop), so we can avoid scheduling a new dispatch
-   if (!v.type || !memcmp(&v, &copy, sizeof (Eina_Value))) copy = v;
-   else if (!eina_value_copy(&v, &copy))
-     {
-        ERR("Value cannot be copied - unusable with Eina_Future: %p (%s)", v.type, v.type->name);
-        eina_value_setup(&copy, EINA_VALUE_TYPE_ERROR);
-        eina_value_set(&copy, ENOTSUP);
-     }
-   _eina_promise_clean_dispatch(data, copy);
-   return v;
+   //This future consumes its value, so it can be passed along as is.
+   _eina_promise_clean_dispatch(data, v);
+   return EINA_VALUE_EMPTY;
 }
 
 static void
@@ -694,6 +696,7 @@ eina_future_as_value(Eina_Future *f)
    r_future = eina_future_then(f, _future_proxy, p, NULL);
    //If eina_future_then() fails f will be cancelled
    EINA_SAFETY_ON_NULL_GOTO(r_future, err_future);
+   r_future->consume = EINA_TRUE;
 
    v = eina_promise_as_value(p);
    if (v.type == &EINA_VALUE_TYPE_PROMISE)
@@ -1203,8 +1206,10 @@ _race_then_cb(void *data, const Eina_Value v,
 {
    Race_Promise_Ctx *ctx = data;
    Eina_Promise *p = ctx->base.promise;
+   Eina_Future_Race_Result *rr;
+   Eina_Value_Struct st;
    Eina_Bool found, r;
-   Eina_Value result;
+   Eina_Value result, tmp = v;
    unsigned int i;
 
    //This is not allowed!
@@ -1212,7 +1217,8 @@ _race_then_cb(void *data, const Eina_Value v,
    found = _future_unset(&ctx->base, &i, dead_ptr);
    assert(found);
 
-   if (ctx->dispatching) return EINA_VALUE_EMPTY;
+   //This future consumes its value, give it back when it is not used.
+   if (ctx->dispatching) return v;
    ctx->dispatching = EINA_TRUE;
 
    //By freeing the race_ctx all the other futures will be cancelled.
@@ -1220,13 +1226,14 @@ _race_then_cb(void *data, const Eina_Value v,
 
    r = eina_value_struct_setup(&result, &RACE_STRUCT_DESC);
    EINA_SAFETY_ON_FALSE_GOTO(r, err_setup);
-   r = eina_value_struct_set(&result, "value", v);
-   EINA_SAFETY_ON_FALSE_GOTO(r, err_set);
-   r = eina_value_struct_set(&result, "index", i);
+   r = eina_value_pget(&result, &st);
    EINA_SAFETY_ON_FALSE_GOTO(r, err_set);
+   rr = st.memory;
+   eina_value_move(&rr->value, &tmp);
+   rr->index = i;
    //We're in a safe context (from mainloop), so we can avoid scheduling a new dispatch
    _eina_promise_clean_dispatch(p, result);
-   return v;
+   return EINA_VALUE_EMPTY;
 
  err_set:
    eina_value_flush(&result);
@@ -1242,6 +1249,8 @@ _all_then_cb(void *data, const Eina_Value v,
              const Eina_Future *dead_ptr)
 {
    All_Promise_Ctx *ctx = data;
+   Eina_Value_Array desc;
+   Eina_Value tmp = v;
    unsigned int i = 0;
    Eina_Bool found;
 
@@ -1252,7 +1261,9 @@ _all_then_cb(void *data, const Eina_Value v,
    assert(found);
 
    ctx->processed++;
-   eina_value_array_set(&ctx->values, i, v);
+   //This future consumes its value, move it in its slot.
+   eina_value_pget(&ctx->values, &desc);
+   eina_value_move(eina_inarray_nth(desc.array, i), &tmp);
    if (ctx->processed == ctx->base.futures_len)
      {
         //We're in a safe context (from mainloop), so we can avoid scheduling a new dispatch
@@ -1260,7 +1271,7 @@ _all_then_cb(void *data, const Eina_Value v,
         ctx->values = EINA_VALUE_EMPTY; /* flushed in _eina_promise_clean_dispatch() */
         _all_promise_ctx_free(ctx);
      }
-   return v;
+   return EINA_VALUE_EMPTY;
 }
 
 static void
@@ -1297,6 +1308,7 @@ promise_proxy_of_future_array_create(Eina_Future *array[],
         ctx->futures[i] = eina_future_then(array[i], future_cb, ctx, NULL);
         //Futures will be cancelled by the caller...
         EINA_SAFETY_ON_NULL_GOTO(ctx->futures[i], err_then);
+        ctx->futures[i]->consume = EINA_TRUE;
      }
    return EINA_TRUE;
 
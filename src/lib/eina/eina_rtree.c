@@ -0,0 +1,454 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "eina_config.h"
+#include "eina_private.h"
+#include "eina_safety_checks.h"
+#include "eina_cpu.h"
+#include "eina_rtree.h"
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+/* 8 children keep a node within three cache lines, and the test of all its
+ * boxes against the target is a single loop the compiler can vectorize */
+#define RTREE_FANOUT 8
+/* repack once that many items out of 8 moved since the last pack */
+#define RTREE_REPACK 2
+
+#define RTREE_NONE UINT_MAX
+
+typedef struct _Eina_Rtree_Node Eina_Rtree_Node;
+typedef struct _Eina_Rtree_Entry Eina_Rtree_Entry;
+
+/* boxes are stored as [x0, x1[ x [y0, y1[, an empty box has x0 > x1 */
+struct _Eina_Rtree_Node
+{
+   int x0[RTREE_FANOUT];
+   int y0[RTREE_FANOUT];
+   int x1[RTREE_FANOUT];
+   int y1[RTREE_FANOUT];
+   unsigned int child[RTREE_FANOUT]; /* an item in a leaf, a node otherwise */
+   unsigned int parent;
+   unsigned int count : 31;
+   unsigned int leaf : 1;
+};
+
+/* what is being packed in a level: an item or a node of the level below */
+struct _Eina_Rtree_Entry
+{
+   int x0, y0, x1, y1;
+   int cx, cy;
+   unsigned int ref;
+};
+
+struct _Eina_Rtree
+{
+   Eina_Rtree_Node *nodes;
+   unsigned int nodes_count;
+   unsigned int nodes_size;
+   unsigned int root;
+
+   Eina_Rectangle *rects;
+   void **data;
+   unsigned int *where; /* node * RTREE_FANOUT + slot of each item */
+   unsigned int count;
+   unsigned int size;
+
+   unsigned int moved;
+};
+
+static inline void
+_eina_rtree_box_set(Eina_Rtree_Entry *e, const Eina_Rectangle *r)
+{
+   if ((r->w <= 0) || (r->h <= 0))
+     {
+        e->x0 = e->y0 = INT_MAX;
+        e->x1 = e->y1 = INT_MIN;
+        e->cx = e->cy = 0;
+        return;
+     }
+   e->x0 = r->x;
+   e->y0 = r->y;
+   e->x1 = r->x + r->w;
+   e->y1 = r->y + r->h;
+   e->cx = r->x + r->w / 2;
+   e->cy = r->y + r->h / 2;
+}
+
+static int
+_eina_rtree_entry_x_cmp(const void *a, const void *b)
+{
+   const Eina_Rtree_Entry *ea = a, *eb = b;
+
+   if (ea->cx != eb->cx) return ea->cx < eb->cx ? -1 : 1;
+   return ea->ref < eb->ref ? -1 : (ea->ref > eb->ref);
+}
+
+static int
+_eina_rtree_entry_y_cmp(const void *a, const void *b)
+{
+   const Eina_Rtree_Entry *ea = a, *eb = b;
+
+   if (ea->cy != eb->cy) return ea->cy < eb->cy ? -1 : 1;
+   return ea->ref < eb->ref ? -1 : (ea->ref > eb->ref);
+}
+
+static void
+_eina_rtree_node_box(const Eina_Rtree_Node *n, Eina_Rtree_Entry *e)
+{
+   unsigned int i;
+
+   e->x0 = e->y0 = INT_MAX;
+   e->x1 = e->y1 = INT_MIN;
+   for (i = 0; i < n->count; i++)
+     {
+        if (n->x0[i] < e->x0) e->x0 = n->x0[i];
+        if (n->y0[i] < e->y0) e->y0 = n->y0[i];
+        if (n->x1[i] > e->x1) e->x1 = n->x1[i];
+        if (n->y1[i] > e->y1) e->y1 = n->y1[i];
+     }
+   if (e->x0 > e->x1)
+     e->cx = e->cy = 0;
+   else
+     {
+        e->cx = e->x0 + (int)(((long long)e->x1 - e->x0) / 2);
+        e->cy = e->y0 + (int)(((long long)e->y1 - e->y0) / 2);
+     }
+}
+
+/* Sort-Tile-Recursive: sort the entries along x, cut them in vertical
+ * slices of about sqrt(nodes) nodes each, sort every slice along y and
+ * fill the nodes in that order. Returns the first node of the level. */
+static unsigned int
+_eina_rtree_pack(Eina_Rtree *t, Eina_Rtree_Entry *entries, unsigned int count,
+                 Eina_Bool leaf)
+{
+   unsigned int nodes, slices, per_slice, first, i, j;
+
+   nodes = (count + RTREE_FANOUT - 1) / RTREE_FANOUT;
+   for (slices = 1; slices * slices < nodes; slices++);
+   per_slice = slices * RTREE_FANOUT;
+
+   qsort(entries, count, sizeof (Eina_Rtree_Entry), _eina_rtree_entry_x_cmp);
+   for (i = 0; i < count; i += per_slice)
+     qsort(entries + i, MIN(per_slice, count - i), sizeof (Eina_Rtree_Entry),
+           _eina_rtree_entry_y_cmp);
+
+   first = t->nodes_count;
+   for (i = 0; i < count; i += RTREE_FANOUT)
+     {
+        Eina_Rtree_Node *n = t->nodes + t->nodes_count;
+        unsigned int idx = t->nodes_count++;
+
+        n->count = MIN(RTREE_FANOUT, count - i);
+        n->leaf = leaf;
+        n->parent = RTREE_NONE;
+        for (j = 0; j < n->count; j++)
+          {
+             const Eina_Rtree_Entry *e = entries + i + j;
+
+             n->x0[j] = e->x0;
+             n->y0[j] = e->y0;
+             n->x1[j] = e->x1;
+             n->y1[j] = e->y1;
+             n->child[j] = e->ref;
+             if (leaf) t->where[e->ref] = idx * RTREE_FANOUT + j;
+             else t->nodes[e->ref].parent = idx;
+          }
+     }
+   return first;
+}
+
+static Eina_Bool
+_eina_rtree_build(Eina_Rtree *t)
+{
+   Eina_Rtree_Entry *entries;
+   unsigned int count, total, first, i;
+
+   t->nodes_count = 0;
+   t->root = RTREE_NONE;
+   t->moved = 0;
+   if (!t->count) return EINA_TRUE;
+
+   count = t->count;
+   total = 0;
+   do
+     {
+        count = (count + RTREE_FANOUT - 1) / RTREE_FANOUT;
+        total += count;
+     }
+   while (count > 1);
+   if (total > t->nodes_size)
+     {
+        Eina_Rtree_Node *tmp;
+
+        tmp = realloc(t->nodes, total * sizeof (Eina_Rtree_Node));
+        if (!tmp) return EINA_FALSE;
+        t->nodes = tmp;
+        t->nodes_size = total;
+     }
+
+   entries = malloc(t->count * sizeof (Eina_Rtree_Entry));
+   if (!entries) return EINA_FALSE;
+
+   for (i = 0; i < t->count; i++)
+     {
+        _eina_rtree_box_set(entries + i, t->rects + i);
+        entries[i].ref = i;
+     }
+
+   count = t->count;
+   first = _eina_rtree_pack(t, entries, count, EINA_TRUE);
+   while (t->nodes_count - first > 1)
+     {
+        count = t->nodes_count - first;
+        for (i = 0; i < count; i++)
+          {
+             _eina_rtree_node_box(t->nodes + first + i, entries + i);
+             entries[i].ref = first + i;
+          }
+        first = _eina_rtree_pack(t, entries, count, EINA_FALSE);
+     }
+   t->root = first;
+
+   free(entries);
+   return EINA_TRUE;
+}
+
+static void
+_eina_rtree_refit(Eina_Rtree *t, unsigned int idx)
+{
+   Eina_Rtree_Entry box;
+   unsigned int parent, slot;
+
+   while ((parent = t->nodes[idx].parent) != RTREE_NONE)
+     {
+        Eina_Rtree_Node *p = t->nodes + parent;
+
+        for (slot = 0; slot < p->count; slot++)
+          if (p->child[slot] == idx) break;
+
+        _eina_rtree_node_box(t->nodes + idx, &box);
+        if ((p->x0[slot] == box.x0) && (p->y0[slot] == box.y0) &&
+            (p->x1[slot] == box.x1) && (p->y1[slot] == box.y1))
+          return;
+        p->x0[slot] = box.x0;
+        p->y0[slot] = box.y0;
+        p->x1[slot] = box.x1;
+        p->y1[slot] = box.y1;
+        idx = parent;
+     }
+}
+
+static int
+_eina_rtree_id_cmp(const void *a, const void *b)
+{
+   unsigned int ia = *(const unsigned int *)a;
+   unsigned int ib = *(const unsigned int *)b;
+
+   return ia < ib ? -1 : (ia > ib);
+}
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
+
+EAPI Eina_Rtree *
+eina_rtree_new(void)
+{
+   Eina_Rtree *t;
+
+   t = calloc(1, sizeof (Eina_Rtree));
+   if (!t) return NULL;
+   t->root = RTREE_NONE;
+   return t;
+}
+
+EAPI void
+eina_rtree_free(Eina_Rtree *t)
+{
+   if (!t) return;
+   free(t->nodes);
+   free(t->rects);
+   free(t->data);
+   free(t->where);
+   free(t);
+}
+
+EAPI Eina_Bool
+eina_rtree_load(Eina_Rtree *t, const Eina_Rectangle *rects,
+                void * const *data, unsigned int count)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(t, EINA_FALSE);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL((count) && (!rects), EINA_FALSE);
+
+   if (count > t->size)
+     {
+        Eina_Rectangle *r;
+        void **d;
+        unsigned int *w;
+
+        r = realloc(t->rects, count * sizeof (Eina_Rectangle));
+        if (r) t->rects = r;
+        d = realloc(t->data, count * sizeof (void *));
+        if (d) t->data = d;
+        w = realloc(t->where, count * sizeof (unsigned int));
+        if (w) t->where = w;
+        if ((!r) || (!d) || (!w)) goto on_error;
+        t->size = count;
+     }
+
+   t->count = count;
+   if (!count) return _eina_rtree_build(t);
+
+   memcpy(t->rects, rects, count * sizeof (Eina_Rectangle));
+   if (data) memcpy(t->data, data, count * sizeof (void *));
+   else memset(t->data, 0, count * sizeof (void *));
+
+   if (_eina_rtree_build(t)) return EINA_TRUE;
+
+on_error:
+   t->count = 0;
+   t->nodes_count = 0;
+   t->root = RTREE_NONE;
+   return EINA_FALSE;
+}
+
+EAPI Eina_Bool
+eina_rtree_update(Eina_Rtree *t, unsigned int id, const Eina_Rectangle *r)
+{
+   Eina_Rtree_Entry box;
+   Eina_Rtree_Node *n;
+   unsigned int node, slot;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(t, EINA_FALSE);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(r, EINA_FALSE);
+   if (id >= t->count) return EINA_FALSE;
+
+   if ((t->rects[id].x == r->x) && (t->rects[id].y == r->y) &&
+       (t->rects[id].w == r->w) && (t->rects[id].h == r->h))
+     return EINA_TRUE;
+   t->rects[id] = *r;
+   t->moved++;
+
+   // the tree is repacked on the next lookup, no need to refit it
+   if (t->moved * 8 > t->count * RTREE_REPACK) return EINA_TRUE;
+
+   node = t->where[id] / RTREE_FANOUT;
+   slot = t->where[id] % RTREE_FANOUT;
+   n = t->nodes + node;
+   _eina_rtree_box_set(&box, r);
+   n->x0[slot] = box.x0;
+   n->y0[slot] = box.y0;
+   n->x1[slot] = box.x1;
+   n->y1[slot] = box.y1;
+   _eina_rtree_refit(t, node);
+   return EINA_TRUE;
+}
+
+EAPI unsigned int
+eina_rtree_count(const Eina_Rtree *t)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(t, 0);
+   return t->count;
+}
+
+EAPI void *
+eina_rtree_data_get(const Eina_Rtree *t, unsigned int id)
+{
+   EINA_SAFETY_ON_NULL_RETURN_VAL(t, NULL);
+   if (id >= t->count) return NULL;
+   return t->data[id];
+}
+
+EAPI unsigned int
+eina_rtree_collide(Eina_Rtree *t, const Eina_Rectangle *r, Eina_Inarray *result)
+{
+   unsigned int stack[64 * RTREE_FANOUT];
+   unsigned int top = 0, found = 0, start;
+   int x0, y0, x1, y1;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(t, 0);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(r, 0);
+   EINA_SAFETY_ON_NULL_RETURN_VAL(result, 0);
+   EINA_SAFETY_ON_FALSE_RETURN_VAL(result->member_size == sizeof (unsigned int), 0);
+
+   if ((r->w <= 0) || (r->h <= 0)) return 0;
+
+   if (t->moved * 8 > t->count * RTREE_REPACK)
+     {
+        if (!_eina_rtree_build(t))
+          {
+             t->count = 0;
+             return 0;
+          }
+     }
+   if (t->root == RTREE_NONE) return 0;
+
+   x0 = r->x;
+   y0 = r->y;
+   x1 = r->x + r->w;
+   y1 = r->y + r->h;
+   start = eina_inarray_count(result);
+
+   stack[top++] = t->root;
+   while (top)
+     {
+        const Eina_Rtree_Node *n = t->nodes + stack[--top];
+        unsigned int i, hits = 0;
+
+        for (i = 0; i < n->count; i++)
+          hits |= ((n->x0[i] < x1) & (x0 < n->x1[i]) &
+                   (n->y0[i] < y1) & (y0 < n->y1[i])) << i;
+        if (!hits) continue;
+
+        for (i = 0; i < n->count; i++)
+          {
+             if (!(hits & (1 << i))) continue;
+             if (n->leaf)
+               {
+                  if (eina_inarray_push(result, &n->child[i]) < 0) break;
+                  found++;
+               }
+             else
+               stack[top++] = n->child[i];
+          }
+     }
+
+   if (found > 1)
+     qsort(eina_inarray_nth(result, start), found, sizeof (unsigned int),
+           _eina_rtree_id_cmp);
+   return found;
+}
@@ -0,0 +1,161 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EINA_RTREE_H_
+#define EINA_RTREE_H_
+
+#include "eina_config.h"
+
+#include "eina_types.h"
+#include "eina_rectangle.h"
+#include "eina_inarray.h"
+
+/**
+ * @addtogroup Eina_Rtree_Group R-Tree
+ *
+ * @brief A static R-tree of rectangles for fast spatial lookup.
+ *
+ * Unlike @ref Eina_QuadTree, the tree is built in one go from an array of
+ * rectangles, packed with the Sort-Tile-Recursive algorithm into nodes of
+ * a few children stored next to each other. Items are identified by their
+ * index in the loaded array, which is also the order in which the
+ * collisions are reported: loading the items in stacking order gives back
+ * the colliding items in stacking order.
+ *
+ * Moving an item only refits the boxes of its ancestors. As the tree
+ * slowly loses its spatial quality with the moves, it is repacked from
+ * the current rectangles on the next lookup once enough items moved.
+ *
+ * @since 1.22
+ */
+
+/**
+ * @addtogroup Eina_Data_Types_Group Data Types
+ *
+ * @{
+ */
+
+/**
+ * @defgroup Eina_Rtree_Group R-Tree
+ *
+ * @{
+ */
+
+/**
+ * @typedef Eina_Rtree
+ * A static R-tree of rectangles.
+ *
+ * @since 1.22
+ */
+typedef struct _Eina_Rtree Eina_Rtree;
+
+/**
+ * @brief Creates a new empty R-tree.
+ *
+ * @return The new tree, or @c NULL on memory allocation failure.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Rtree *eina_rtree_new(void) EINA_MALLOC EINA_WARN_UNUSED_RESULT;
+
+/**
+ * @brief Frees an R-tree.
+ *
+ * @param[in] t The tree to free.
+ *
+ * The data pointers given to eina_rtree_load() are not touched.
+ *
+ * @since 1.22
+ */
+EAPI void eina_rtree_free(Eina_Rtree *t);
+
+/**
+ * @brief Replaces the content of a tree with the given items.
+ *
+ * @param[in,out] t The tree.
+ * @param[in] rects The rectangles of the items.
+ * @param[in] data The data of the items, may be @c NULL.
+ * @param[in] count The number of items.
+ * @return #EINA_TRUE on success, #EINA_FALSE on memory allocation failure,
+ * in which case @p t is left empty.
+ *
+ * The item @c i is identified by @c i in the other calls. Empty rectangles
+ * are kept but never collide.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Bool eina_rtree_load(Eina_Rtree *t, const Eina_Rectangle *rects, void * const *data, unsigned int count) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Changes the rectangle of an item.
+ *
+ * @param[in,out] t The tree.
+ * @param[in] id The item, as indexed in eina_rtree_load().
+ * @param[in] r Its new rectangle.
+ * @return #EINA_FALSE if @p id is not in the tree.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Bool eina_rtree_update(Eina_Rtree *t, unsigned int id, const Eina_Rectangle *r) EINA_ARG_NONNULL(1, 3);
+
+/**
+ * @brief Gets the number of items in a tree.
+ *
+ * @param[in] t The tree.
+ * @return The number of items loaded.
+ *
+ * @since 1.22
+ */
+EAPI unsigned int eina_rtree_count(const Eina_Rtree *t) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Gets the data of an item.
+ *
+ * @param[in] t The tree.
+ * @param[in] id The item.
+ * @return The data given to eina_rtree_load() for @p id.
+ *
+ * @since 1.22
+ */
+EAPI void *eina_rtree_data_get(const Eina_Rtree *t, unsigned int id) EINA_ARG_NONNULL(1);
+
+/**
+ * @brief Finds the items colliding with a rectangle.
+ *
+ * @param[in,out] t The tree.
+ * @param[in] r The rectangle to look up.
+ * @param[out] result An array of unsigned int the colliding items are
+ * appended to, in increasing order.
+ * @return The number of items appended to @p result.
+ *
+ * A 1x1 rectangle looks up the items containing a point. If the tree has to
+ * be repacked and there isn't enough memory for it, it is emptied:
+ * eina_rtree_count() then returns 0 until the items are loaded again.
+ *
+ * @since 1.22
+ */
+EAPI unsigned int eina_rtree_collide(Eina_Rtree *t, const Eina_Rectangle *r, Eina_Inarray *result) EINA_ARG_NONNULL(1, 2, 3);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#endif
@@ -70,6 +70,7 @@
 #include "eina_config.h"
 #include "eina_private.h"
 #include "eina_hash.h"
+#include "eina_inlist.h"
 #include "eina_rbtree.h"
 #include "eina_lock.h"
 
@@ -93,10 +94,33 @@ extern int _eina_share_stringshare_log_dom;
 #endif
 #define DBG_STRINGSHARE(...) EINA_LOG_DOM_DBG(_eina_share_stringshare_log_dom, __VA_ARGS__)
 
-#define EINA_SHARE_COMMON_BUCKETS 256
-#define EINA_SHARE_COMMON_MASK 0xFF
-#define EINA_SHARE_COMMON_BUCKET_IDX(h) ((h >> 8) & EINA_SHARE_COMMON_MASK)
-#define EINA_SHARE_COMMON_NODE_HASH(h) (h & EINA_SHARE_COMMON_MASK)
+#ifdef __ATOMIC_RELAXED
+#define ATOMIC 1
+#endif
+
+/* The table is split in independently locked shards selected by the low
+ * bits of the hash, so threads adding different strings rarely contend.
+ * Each shard starts with EINA_SHARE_COMMON_BUCKETS buckets and doubles
+ * them once it holds more than EINA_SHARE_COMMON_LOAD heads per bucket. */
+#define EINA_SHARE_COMMON_SHARDS 16
+#define EINA_SHARE_COMMON_SHARD_MASK (EINA_SHARE_COMMON_SHARDS - 1)
+#define EINA_SHARE_COMMON_SHARD_BITS 4
+#define EINA_SHARE_COMMON_BUCKETS 16
+#define EINA_SHARE_COMMON_LOAD 4
+#define EINA_SHARE_COMMON_SHARD_IDX(h) ((h) & EINA_SHARE_COMMON_SHARD_MASK)
+#define EINA_SHARE_COMMON_BUCKET_IDX(shard, h) \
+   (((h) >> EINA_SHARE_COMMON_SHARD_BITS) & (shard)->mask)
+
+/* Each thread keeps a small direct mapped cache of the strings it added
+ * last, so that adding a hot string again skips the lookup in its shard.
+ * The cache holds no reference: an entry only points at the node along
+ * with the generation of the shard, bumped whenever a node of the shard is
+ * freed, and is only trusted under the shard lock while that generation
+ * did not change. It is only used once eina_threads_init() has been
+ * called. */
+#define EINA_SHARE_COMMON_CACHE_SIZE 32
+#define EINA_SHARE_COMMON_CACHE_MASK (EINA_SHARE_COMMON_CACHE_SIZE - 1)
+#define EINA_SHARE_COMMON_CACHE_MAX_LENGTH 64
 
 static const char EINA_MAGIC_SHARE_STR[] = "Eina Share";
 static const char EINA_MAGIC_SHARE_HEAD_STR[] = "Eina Share Head";
@@ -132,13 +156,19 @@ struct _Eina_Share_Common_Population
 #endif
 
 typedef struct _Eina_Share_Common Eina_Share_Common;
+typedef struct _Eina_Share_Common_Shard Eina_Share_Common_Shard;
 typedef struct _Eina_Share_Common_Node Eina_Share_Common_Node;
 typedef struct _Eina_Share_Common_Head Eina_Share_Common_Head;
+typedef struct _Eina_Share_Common_Cache Eina_Share_Common_Cache;
+typedef struct _Eina_Share_Common_Cache_Entry Eina_Share_Common_Cache_Entry;
 
 struct _Eina_Share
 {
    Eina_Share_Common *share;
    Eina_Magic node_magic;
+   Eina_TLS cache_key;
+   Eina_Inlist *caches; /* of all threads, protected by _mutex_big */
+   Eina_Bool cache_key_valid : 1;
 #ifdef EINA_STRINGSHARE_USAGE
    Eina_Share_Common_Population population;
    Eina_Share_Common_Population population_group[4];
@@ -146,9 +176,18 @@ struct _Eina_Share
 #endif
 };
 
+struct _Eina_Share_Common_Shard
+{
+   Eina_Spinlock lock;
+   Eina_Share_Common_Head **buckets;
+   unsigned int mask;
+   unsigned int heads;
+   unsigned int gen;
+};
+
 struct _Eina_Share_Common
 {
-   Eina_Share_Common_Head *buckets[EINA_SHARE_COMMON_BUCKETS];
+   Eina_Share_Common_Shard shards[EINA_SHARE_COMMON_SHARDS];
 
    EINA_MAGIC
 };
@@ -169,7 +208,7 @@ struct _Eina_Share_Common_Head
    EINA_RBTREE;
    EINA_MAGIC
 
-   int hash;
+   unsigned int hash;
 
 #ifdef EINA_STRINGSHARE_USAGE
    int population;
@@ -179,9 +218,27 @@ struct _Eina_Share_Common_Head
    Eina_Share_Common_Node builtin_node;
 };
 
+struct _Eina_Share_Common_Cache_Entry
+{
+   Eina_Share_Common_Node *node;
+   unsigned int hash;
+   unsigned int gen;
+};
+
+struct _Eina_Share_Common_Cache
+{
+   EINA_INLIST;
+   Eina_Share *share;
+   Eina_Share_Common_Cache_Entry entries[EINA_SHARE_COMMON_CACHE_SIZE];
+};
+
 Eina_Bool _share_common_threads_activated = EINA_FALSE;
 
+/* protects the population statistics, the table uses the shard locks */
 static Eina_Spinlock _mutex_big;
+#ifndef ATOMIC
+static Eina_Spinlock _mutex_references;
+#endif
 
 #ifdef EINA_STRINGSHARE_USAGE
 
@@ -312,15 +369,9 @@ static void _eina_share_common_population_shutdown(EINA_UNUSED Eina_Share *share
 }
 static void _eina_share_common_population_stats(EINA_UNUSED Eina_Share *share) {
 }
-static void eina_share_common_population_nolock_add(EINA_UNUSED Eina_Share *share,
-                                                    EINA_UNUSED int slen) {
-}
 void eina_share_common_population_add(EINA_UNUSED Eina_Share *share,
                                       EINA_UNUSED int slen) {
 }
-static void eina_share_common_population_nolock_del(EINA_UNUSED Eina_Share *share,
-                                                    EINA_UNUSED int slen) {
-}
 void eina_share_common_population_del(EINA_UNUSED Eina_Share *share,
                                       EINA_UNUSED int slen) {
 }
@@ -342,13 +393,14 @@ static void _eina_share_common_population_head_del(
 
 static int
 _eina_share_common_cmp(const Eina_Share_Common_Head *ed,
-                       const int *hash,
+                       const unsigned int *hash,
                        EINA_UNUSED int length,
                        EINA_UNUSED void *data)
 {
    EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, , 0);
 
-   return EINA_SHARE_COMMON_NODE_HASH(ed->hash) - *hash;
+   if (ed->hash < *hash) return -1;
+   return ed->hash > *hash;
 }
 
 static Eina_Rbtree_Direction
@@ -359,7 +411,7 @@ _eina_share_common_node(const Eina_Share_Common_Head *left,
    EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(left,  , 0);
    EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(right, , 0);
 
-   if (EINA_SHARE_COMMON_NODE_HASH(left->hash) - EINA_SHARE_COMMON_NODE_HASH(right->hash) < 0)
+   if (left->hash < right->hash)
       return EINA_RBTREE_LEFT;
 
    return EINA_RBTREE_RIGHT;
@@ -407,15 +459,56 @@ _eina_share_common_head_alloc(int slen)
    return head;
 }
 
-static const char *
+static void
+_eina_share_common_shard_move(Eina_Share_Common_Shard *shard,
+                              Eina_Share_Common_Head **buckets,
+                              Eina_Rbtree *node)
+{
+   Eina_Share_Common_Head *head = (Eina_Share_Common_Head *)node;
+   Eina_Rbtree **p_tree;
+
+   if (!node) return;
+
+   /* children first, insertion resets the node links */
+   _eina_share_common_shard_move(shard, buckets, node->son[0]);
+   _eina_share_common_shard_move(shard, buckets, node->son[1]);
+
+   p_tree = (Eina_Rbtree **)(buckets + EINA_SHARE_COMMON_BUCKET_IDX(shard, head->hash));
+   *p_tree = eina_rbtree_inline_insert
+         (*p_tree, node,
+         EINA_RBTREE_CMP_NODE_CB(_eina_share_common_node), NULL);
+}
+
+static void
+_eina_share_common_shard_grow(Eina_Share_Common_Shard *shard)
+{
+   Eina_Share_Common_Head **buckets, **old;
+   unsigned int old_count, i;
+
+   old = shard->buckets;
+   old_count = shard->mask + 1;
+
+   buckets = calloc(old_count * 2, sizeof (Eina_Share_Common_Head *));
+   /* keep the current buckets, they are just more crowded */
+   if (!buckets) return;
+
+   shard->buckets = buckets;
+   shard->mask = old_count * 2 - 1;
+   for (i = 0; i < old_count; i++)
+     _eina_share_common_shard_move(shard, buckets, EINA_RBTREE_GET(old[i]));
+
+   free(old);
+}
+
+static Eina_Share_Common_Node *
 _eina_share_common_add_head(Eina_Share *share,
-                            Eina_Share_Common_Head **p_bucket,
-                            int hash,
+                            Eina_Share_Common_Shard *shard,
+                            unsigned int hash,
                             const char *str,
                             unsigned int slen,
                             unsigned int null_size)
 {
-   Eina_Rbtree **p_tree = (Eina_Rbtree **)p_bucket;
+   Eina_Rbtree **p_tree;
    Eina_Share_Common_Head *head;
 
    head = _eina_share_common_head_alloc(slen + null_size);
@@ -434,24 +527,31 @@ _eina_share_common_add_head(Eina_Share *share,
 
    _eina_share_common_population_head_init(share, head);
 
+   if (++shard->heads > (shard->mask + 1) * EINA_SHARE_COMMON_LOAD)
+     _eina_share_common_shard_grow(shard);
+
+   p_tree = (Eina_Rbtree **)(shard->buckets + EINA_SHARE_COMMON_BUCKET_IDX(shard, hash));
    *p_tree = eina_rbtree_inline_insert
          (*p_tree, EINA_RBTREE_GET(head),
          EINA_RBTREE_CMP_NODE_CB(_eina_share_common_node), NULL);
 
-   return head->head->str;
+   return head->head;
 }
 
 static void
-_eina_share_common_del_head(Eina_Share_Common_Head **p_bucket,
+_eina_share_common_del_head(Eina_Share_Common_Shard *shard,
                             Eina_Share_Common_Head *head)
 {
-   Eina_Rbtree **p_tree = (Eina_Rbtree **)p_bucket;
+   Eina_Rbtree **p_tree;
 
+   p_tree = (Eina_Rbtree **)(shard->buckets + EINA_SHARE_COMMON_BUCKET_IDX(shard, head->hash));
    *p_tree = eina_rbtree_inline_remove
          (*p_tree, EINA_RBTREE_GET(head),
          EINA_RBTREE_CMP_NODE_CB(_eina_share_common_node), NULL);
 
-         MAGIC_FREE(head);
+   shard->heads--;
+
+   MAGIC_FREE(head);
 }
 
 
@@ -518,7 +618,7 @@ _eina_share_common_head_remove_node(Eina_Share_Common_Head *head,
 }
 
 static Eina_Share_Common_Head *
-_eina_share_common_find_hash(Eina_Share_Common_Head *bucket, int hash)
+_eina_share_common_find_hash(Eina_Share_Common_Head *bucket, unsigned int hash)
 {
    return (Eina_Share_Common_Head *)eina_rbtree_inline_lookup
              (EINA_RBTREE_GET(bucket), &hash, 0,
@@ -562,6 +662,162 @@ _eina_share_common_node_from_str(const char *str, Eina_Magic node_magic)
    (void) node_magic; /* When magic are disable, node_magic is unused, this remove a warning. */
 }
 
+#ifdef ATOMIC
+static inline void
+_eina_share_common_node_ref(Eina_Share_Common_Node *node)
+{
+   __atomic_add_fetch(&node->references, 1, __ATOMIC_RELAXED);
+}
+
+static inline Eina_Bool
+_eina_share_common_node_unref_fast(Eina_Share_Common_Node *node)
+{
+   unsigned int refs = __atomic_load_n(&node->references, __ATOMIC_RELAXED);
+
+   while (refs > 1)
+     {
+        if (__atomic_compare_exchange_n(&node->references, &refs, refs - 1,
+                                        EINA_TRUE, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED))
+          return EINA_TRUE;
+     }
+   return EINA_FALSE;
+}
+
+static inline unsigned int
+_eina_share_common_node_unref(Eina_Share_Common_Node *node)
+{
+   return __atomic_sub_fetch(&node->references, 1, __ATOMIC_ACQ_REL);
+}
+#else
+static inline void
+_eina_share_common_node_ref(Eina_Share_Common_Node *node)
+{
+   eina_spinlock_take(&_mutex_references);
+   node->references++;
+   eina_spinlock_release(&_mutex_references);
+}
+
+static inline Eina_Bool
+_eina_share_common_node_unref_fast(Eina_Share_Common_Node *node)
+{
+   Eina_Bool r = EINA_FALSE;
+
+   eina_spinlock_take(&_mutex_references);
+   if (node->references > 1)
+     {
+        node->references--;
+        r = EINA_TRUE;
+     }
+   eina_spinlock_release(&_mutex_references);
+   return r;
+}
+
+static inline unsigned int
+_eina_share_common_node_unref(Eina_Share_Common_Node *node)
+{
+   unsigned int refs;
+
+   eina_spinlock_take(&_mutex_references);
+   refs = --node->references;
+   eina_spinlock_release(&_mutex_references);
+   return refs;
+}
+#endif
+
+static Eina_Bool
+_eina_share_common_node_release(Eina_Share *share, Eina_Share_Common_Node *node)
+{
+   Eina_Share_Common_Shard *shard;
+   Eina_Share_Common_Head *ed;
+   unsigned int hash;
+
+   /* only dropping the last reference needs the table */
+   if (_eina_share_common_node_unref_fast(node))
+     return EINA_TRUE;
+
+   hash = eina_hash_fast(node->str, node->length);
+   shard = share->share->shards + EINA_SHARE_COMMON_SHARD_IDX(hash);
+
+   eina_spinlock_take(&shard->lock);
+
+   /* someone may have added the same string again while we were waiting */
+   if (_eina_share_common_node_unref(node) > 0)
+     {
+        eina_spinlock_release(&shard->lock);
+        return EINA_TRUE;
+     }
+
+   ed = _eina_share_common_head_from_node(node);
+   if (!ed)
+      goto on_error;
+
+   EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, eina_spinlock_release(&shard->lock), EINA_FALSE);
+
+   if (node != &ed->builtin_node)
+     {
+        if (!_eina_share_common_head_remove_node(ed, node))
+          goto on_error;
+        MAGIC_FREE(node);
+        shard->gen++;
+     }
+
+   if (!ed->head || ed->head->references == 0)
+     {
+        _eina_share_common_del_head(shard, ed);
+        shard->gen++;
+     }
+   else
+      _eina_share_common_population_head_del(share, ed);
+
+   eina_spinlock_release(&shard->lock);
+
+   return EINA_TRUE;
+
+on_error:
+   eina_spinlock_release(&shard->lock);
+   /* possible segfault happened before here, but... */
+   return EINA_FALSE;
+}
+
+static void
+_eina_share_common_cache_free(void *data)
+{
+   Eina_Share_Common_Cache *cache = data;
+   Eina_Share *share = cache->share;
+
+   eina_spinlock_take(&_mutex_big);
+   share->caches = eina_inlist_remove(share->caches, EINA_INLIST_GET(cache));
+   eina_spinlock_release(&_mutex_big);
+   free(cache);
+}
+
+static Eina_Share_Common_Cache *
+_eina_share_common_cache_get(Eina_Share *share)
+{
+   Eina_Share_Common_Cache *cache;
+
+   if (!share->cache_key_valid) return NULL;
+
+   cache = eina_tls_get(share->cache_key);
+   if (cache) return cache;
+
+   cache = calloc(1, sizeof (Eina_Share_Common_Cache));
+   if (!cache) return NULL;
+   cache->share = share;
+
+   if (!eina_tls_set(share->cache_key, cache))
+     {
+        free(cache);
+        return NULL;
+     }
+
+   eina_spinlock_take(&_mutex_big);
+   share->caches = eina_inlist_append(share->caches, EINA_INLIST_GET(cache));
+   eina_spinlock_release(&_mutex_big);
+   return cache;
+}
+
 static Eina_Bool
 eina_iterator_array_check(const Eina_Rbtree *rbtree EINA_UNUSED,
                           Eina_Share_Common_Head *head,
@@ -610,6 +866,7 @@ eina_share_common_init(Eina_Share **_share,
                        const char *node_magic_STR)
 {
    Eina_Share *share;
+   unsigned int i;
 
    share = *_share = calloc(1, sizeof(Eina_Share));
    if (!share) goto on_error;
@@ -617,6 +874,20 @@ eina_share_common_init(Eina_Share **_share,
    share->share = calloc(1, sizeof(Eina_Share_Common));
    if (!share->share) goto on_error;
 
+   for (i = 0; i < EINA_SHARE_COMMON_SHARDS; i++)
+     {
+        Eina_Share_Common_Shard *shard = share->share->shards + i;
+
+        shard->buckets = calloc(EINA_SHARE_COMMON_BUCKETS,
+                                sizeof (Eina_Share_Common_Head *));
+        if (!shard->buckets) goto on_error;
+        shard->mask = EINA_SHARE_COMMON_BUCKETS - 1;
+        eina_spinlock_new(&shard->lock);
+     }
+
+   share->cache_key_valid = eina_tls_cb_new(&share->cache_key,
+                                            _eina_share_common_cache_free);
+
    share->node_magic = node_magic;
 #define EMS(n) eina_magic_string_static_set(n, n ## _STR)
    EMS(EINA_MAGIC_SHARE);
@@ -632,10 +903,24 @@ eina_share_common_init(Eina_Share **_share,
      return EINA_TRUE;
 
    eina_spinlock_new(&_mutex_big);
+#ifndef ATOMIC
+   eina_spinlock_new(&_mutex_references);
+#endif
    return EINA_TRUE;
 
  on_error:
-   _eina_share_common_count--;
+   if (share && share->share)
+     {
+        for (i = 0; i < EINA_SHARE_COMMON_SHARDS; i++)
+          {
+             if (!share->share->shards[i].buckets) break;
+             free(share->share->shards[i].buckets);
+             eina_spinlock_free(&share->share->shards[i].lock);
+          }
+        free(share->share);
+     }
+   free(share);
+   *_share = NULL;
    return EINA_FALSE;
 }
 
@@ -653,21 +938,45 @@ eina_share_common_init(Eina_Share **_share,
 Eina_Bool
 eina_share_common_shutdown(Eina_Share **_share)
 {
-   unsigned int i;
+   unsigned int i, j;
    Eina_Share *share = *_share;
 
+   /* the key goes first, so that no thread makes a new cache, then the
+    * caches of all threads go as they point into the table */
+   if (share->cache_key_valid)
+     {
+        eina_tls_set(share->cache_key, NULL);
+        eina_tls_free(share->cache_key);
+        share->cache_key_valid = EINA_FALSE;
+     }
+
    eina_spinlock_take(&_mutex_big);
 
+   while (share->caches)
+     {
+        Eina_Share_Common_Cache *cache;
+
+        cache = EINA_INLIST_CONTAINER_GET(share->caches, Eina_Share_Common_Cache);
+        share->caches = eina_inlist_remove(share->caches, share->caches);
+        free(cache);
+     }
+
    _eina_share_common_population_stats(share);
 
    /* remove any string still in the table */
-   for (i = 0; i < EINA_SHARE_COMMON_BUCKETS; i++)
+   for (i = 0; i < EINA_SHARE_COMMON_SHARDS; i++)
      {
-        eina_rbtree_delete(EINA_RBTREE_GET(
-                              share->share->buckets[i]),
-                           EINA_RBTREE_FREE_CB(
-                              _eina_share_common_head_free), NULL);
-        share->share->buckets[i] = NULL;
+        Eina_Share_Common_Shard *shard = share->share->shards + i;
+
+        eina_spinlock_take(&shard->lock);
+        for (j = 0; j <= shard->mask; j++)
+          eina_rbtree_delete(EINA_RBTREE_GET(shard->buckets[j]),
+                             EINA_RBTREE_FREE_CB(
+                                _eina_share_common_head_free), NULL);
+        free(shard->buckets);
+        shard->buckets = NULL;
+        eina_spinlock_release(&shard->lock);
+        eina_spinlock_free(&shard->lock);
      }
    MAGIC_FREE(share->share);
 
@@ -683,6 +992,9 @@ eina_share_common_shutdown(Eina_Share **_share)
      return EINA_TRUE;
 
    eina_spinlock_free(&_mutex_big);
+#ifndef ATOMIC
+   eina_spinlock_free(&_mutex_references);
+#endif
 
    return EINA_TRUE;
 }
@@ -735,9 +1047,11 @@ eina_share_common_add_length(Eina_Share *share,
                              unsigned int slen,
                              unsigned int null_size)
 {
+   Eina_Share_Common_Cache_Entry *entry = NULL;
+   Eina_Share_Common_Shard *shard;
    Eina_Share_Common_Head **p_bucket, *ed;
    Eina_Share_Common_Node *el;
-   int hash;
+   unsigned int hash;
 
    if (!str)
       return NULL;
@@ -747,41 +1061,64 @@ eina_share_common_add_length(Eina_Share *share,
    if (slen == 0)
       return NULL;
 
-   hash = eina_hash_superfast(str, slen);
+   hash = eina_hash_fast(str, slen);
 
-   eina_spinlock_take(&_mutex_big);
-   p_bucket = share->share->buckets + EINA_SHARE_COMMON_BUCKET_IDX(hash);
+   if (_share_common_threads_activated &&
+       slen <= EINA_SHARE_COMMON_CACHE_MAX_LENGTH)
+     {
+        Eina_Share_Common_Cache *cache;
+
+        cache = _eina_share_common_cache_get(share);
+        if (cache)
+          entry = cache->entries +
+            ((hash >> EINA_SHARE_COMMON_SHARD_BITS) & EINA_SHARE_COMMON_CACHE_MASK);
+     }
+
+   shard = share->share->shards + EINA_SHARE_COMMON_SHARD_IDX(hash);
+
+   eina_spinlock_take(&shard->lock);
+
+   /* nothing was freed in the shard since, so the node is still there */
+   if (entry && entry->node && entry->hash == hash &&
+       entry->gen == shard->gen &&
+       _eina_share_common_node_eq(entry->node, str, slen))
+     {
+        el = entry->node;
+        _eina_share_common_node_ref(el);
+        eina_spinlock_release(&shard->lock);
+        return el->str;
+     }
+
+   p_bucket = shard->buckets + EINA_SHARE_COMMON_BUCKET_IDX(shard, hash);
 
-   ed = _eina_share_common_find_hash(*p_bucket, EINA_SHARE_COMMON_NODE_HASH(hash));
+   ed = _eina_share_common_find_hash(*p_bucket, hash);
    if (!ed)
      {
-        const char *s = _eina_share_common_add_head(share,
-                                                    p_bucket,
-                                                    hash,
-                                                    str,
-                                                    slen,
-                                                    null_size);
-        eina_spinlock_release(&_mutex_big);
-        return s;
+        el = _eina_share_common_add_head(share,
+                                         shard,
+                                         hash,
+                                         str,
+                                         slen,
+                                         null_size);
+        goto on_added;
      }
 
-   EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, eina_spinlock_release(&_mutex_big), NULL);
+   EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, eina_spinlock_release(&shard->lock), NULL);
 
    el = _eina_share_common_head_find(ed, str, slen);
    if (el)
      {
         EINA_MAGIC_CHECK_SHARE_COMMON_NODE
           (el, share->node_magic,
-           eina_spinlock_release(&_mutex_big); return NULL);
-        el->references++;
-        eina_spinlock_release(&_mutex_big);
-        return el->str;
+           eina_spinlock_release(&shard->lock); return NULL);
+        _eina_share_common_node_ref(el);
+        goto on_added;
      }
 
    el = _eina_share_common_node_alloc(slen, null_size);
    if (!el)
      {
-                                           eina_spinlock_release(&_mutex_big);
+        eina_spinlock_release(&shard->lock);
         return NULL;
      }
 
@@ -790,7 +1127,18 @@ eina_share_common_add_length(Eina_Share *share,
    ed->head = el;
    _eina_share_common_population_head_add(share, ed);
 
-   eina_spinlock_release(&_mutex_big);
+ on_added:
+   if (el && entry)
+     {
+        entry->node = el;
+        entry->hash = hash;
+        entry->gen = shard->gen;
+     }
+
+   eina_spinlock_release(&shard->lock);
+
+   if (!el)
+      return NULL;
 
    return el->str;
 }
@@ -803,18 +1151,14 @@ eina_share_common_ref(Eina_Share *share, const char *str)
    if (!str)
       return NULL;
 
-   eina_spinlock_take(&_mutex_big);
    node = _eina_share_common_node_from_str(str, share->node_magic);
    if (!node)
-     {
-        eina_spinlock_release(&_mutex_big);
-        return str;
-     }
-   node->references++;
+      return str;
 
-   eina_share_common_population_nolock_add(share, node->length);
+   /* the caller already holds a reference, so the node can't go away */
+   _eina_share_common_node_ref(node);
 
-   eina_spinlock_release(&_mutex_big);
+   eina_share_common_population_add(share, node->length);
 
    return str;
 }
@@ -823,60 +1167,18 @@ eina_share_common_ref(Eina_Share *share, const char *str)
 Eina_Bool
 eina_share_common_del(Eina_Share *share, const char *str)
 {
-   unsigned int slen;
-   Eina_Share_Common_Head *ed;
-   Eina_Share_Common_Head **p_bucket;
    Eina_Share_Common_Node *node;
 
    if (!str)
       return EINA_TRUE;
 
-   eina_spinlock_take(&_mutex_big);
-
    node = _eina_share_common_node_from_str(str, share->node_magic);
    if (!node)
-      goto on_error;
-
-   slen = node->length;
-   eina_share_common_population_nolock_del(share, slen);
-   if (node->references > 1)
-     {
-        node->references--;
-        eina_spinlock_release(&_mutex_big);
-        return EINA_TRUE;
-     }
-
-   node->references = 0;
-
-   ed = _eina_share_common_head_from_node(node);
-   if (!ed)
-      goto on_error;
-
-   EINA_MAGIC_CHECK_SHARE_COMMON_HEAD(ed, eina_spinlock_release(&_mutex_big), EINA_FALSE);
-
-   if (node != &ed->builtin_node)
-     {
-        if (!_eina_share_common_head_remove_node(ed, node))
-          goto on_error;
-        MAGIC_FREE(node);
-     }
-
-   if (!ed->head || ed->head->references == 0)
-     {
-        p_bucket = share->share->buckets + EINA_SHARE_COMMON_BUCKET_IDX(ed->hash);
-        _eina_share_common_del_head(p_bucket, ed);
-     }
-   else
-      _eina_share_common_population_head_del(share, ed);
+      return EINA_FALSE;
 
-   eina_spinlock_release(&_mutex_big);
-
-   return EINA_TRUE;
+   eina_share_common_population_del(share, node->length);
 
-on_error:
-   eina_spinlock_release(&_mutex_big);
-   /* possible segfault happened before here, but... */
-   return EINA_FALSE;
+   return _eina_share_common_node_release(share, node);
 }
 
 int
@@ -909,17 +1211,25 @@ eina_share_common_dump(Eina_Share *share, void (*additional_dump)(
    di.unique = 0;
 
    eina_spinlock_take(&_mutex_big);
-   for (i = 0; i < EINA_SHARE_COMMON_BUCKETS; i++)
+   for (i = 0; i < EINA_SHARE_COMMON_SHARDS; i++)
      {
-        if (!share->share->buckets[i])
+        Eina_Share_Common_Shard *shard = share->share->shards + i;
+        unsigned int j;
+
+        eina_spinlock_take(&shard->lock);
+        for (j = 0; j <= shard->mask; j++)
           {
-             continue;
+             if (!shard->buckets[j])
+               {
+                  continue;
+               }
+
+             it = eina_rbtree_iterator_prefix(
+                   (Eina_Rbtree *)shard->buckets[j]);
+             eina_iterator_foreach(it, EINA_EACH_CB(eina_iterator_array_check), &di);
+             eina_iterator_free(it);
           }
-
-        it = eina_rbtree_iterator_prefix(
-              (Eina_Rbtree *)share->share->buckets[i]);
-        eina_iterator_foreach(it, EINA_EACH_CB(eina_iterator_array_check), &di);
-        eina_iterator_free(it);
+        eina_spinlock_release(&shard->lock);
      }
    if (additional_dump)
       additional_dump(&di);
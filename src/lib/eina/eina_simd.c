@@ -0,0 +1,1062 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "eina_config.h"
+#include "eina_private.h"
+#include "eina_cpu.h"
+#include "eina_simd.h"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)) && defined(BUILD_SSE3)
+# define EINA_SIMD_X86 1
+# include <immintrin.h>
+/* the rest of eina is built for the baseline cpu, only these functions
+ * get the wider instruction sets and are only called when cpuid says so */
+# define EINA_TARGET(x) __attribute__((target(x)))
+#endif
+
+#if defined(__aarch64__) && defined(BUILD_NEON_INTRINSICS)
+# define EINA_SIMD_NEON 1
+# include <arm_neon.h>
+#endif
+
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+
+/**
+ * @cond LOCAL
+ */
+
+typedef struct _Eina_Simd_Funcs Eina_Simd_Funcs;
+struct _Eina_Simd_Funcs
+{
+   Eina_Bool (*utf8_len)(const unsigned char *s, size_t len, size_t *chars);
+   size_t (*utf8_decode)(const unsigned char *s, size_t len, Eina_Unicode *out);
+   size_t (*cspan)(const unsigned char *s, size_t len, const unsigned char *set, size_t nset);
+   const unsigned char *(*memmem)(const unsigned char *hay, size_t hlen, const unsigned char *needle, size_t nlen);
+   void (*hash_accumulate)(uint64_t *acc, const unsigned char *p, size_t nstripes, const uint64_t *secret);
+   Eina_Bool (*bits_op)(uint64_t *dst, const uint64_t *src, size_t n, Eina_Simd_Bits_Op op);
+};
+
+/* Length of the strict UTF-8 sequence starting at s, 0 if it is invalid. */
+static inline size_t
+_eina_simd_utf8_seq(const unsigned char *s, size_t left)
+{
+   unsigned char c = s[0];
+
+   if (c < 0x80) return 1;
+   if (c < 0xc2) return 0; /* continuation or overlong 2 bytes lead */
+   if (c < 0xe0)
+     {
+        if ((left < 2) || ((s[1] & 0xc0) != 0x80)) return 0;
+        return 2;
+     }
+   if (c < 0xf0)
+     {
+        if ((left < 3) ||
+            ((s[1] & 0xc0) != 0x80) || ((s[2] & 0xc0) != 0x80)) return 0;
+        if ((c == 0xe0) && (s[1] < 0xa0)) return 0; /* overlong */
+        if ((c == 0xed) && (s[1] > 0x9f)) return 0; /* surrogate */
+        return 3;
+     }
+   if (c < 0xf5)
+     {
+        if ((left < 4) || ((s[1] & 0xc0) != 0x80) ||
+            ((s[2] & 0xc0) != 0x80) || ((s[3] & 0xc0) != 0x80)) return 0;
+        if ((c == 0xf0) && (s[1] < 0x90)) return 0; /* overlong */
+        if ((c == 0xf4) && (s[1] > 0x8f)) return 0; /* above U+10FFFF */
+        return 4;
+     }
+   return 0;
+}
+
+/* Decodes one sequence that _eina_simd_utf8_seq() accepted. */
+static inline Eina_Unicode
+_eina_simd_utf8_get(const unsigned char *s, size_t *idx)
+{
+   const unsigned char *p = s + *idx;
+   unsigned char c = p[0];
+
+   if (c < 0x80)
+     {
+        *idx += 1;
+        return c;
+     }
+   if (c < 0xe0)
+     {
+        *idx += 2;
+        return ((c & 0x1f) << 6) | (p[1] & 0x3f);
+     }
+   if (c < 0xf0)
+     {
+        *idx += 3;
+        return ((c & 0x0f) << 12) | ((p[1] & 0x3f) << 6) | (p[2] & 0x3f);
+     }
+   *idx += 4;
+   return ((c & 0x07) << 18) | ((p[1] & 0x3f) << 12) |
+     ((p[2] & 0x3f) << 6) | (p[3] & 0x3f);
+}
+
+/* Checks and counts the sequences of s, starting at i, until len. */
+static inline Eina_Bool
+_eina_simd_utf8_len_tail(const unsigned char *s, size_t i, size_t len, size_t *chars)
+{
+   size_t n = 0, seq;
+
+   while (i < len)
+     {
+        seq = _eina_simd_utf8_seq(s + i, len - i);
+        if (!seq) return EINA_FALSE;
+        i += seq;
+        n++;
+     }
+   *chars += n;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eina_simd_utf8_len_scalar(const unsigned char *s, size_t len, size_t *chars)
+{
+   size_t i = 0, n = 0, seq;
+   uint64_t w;
+
+   while (i < len)
+     {
+        /* skip ascii a word at a time */
+        while ((i + 8 <= len))
+          {
+             memcpy(&w, s + i, 8);
+             if (w & 0x8080808080808080ULL) break;
+             i += 8;
+             n += 8;
+          }
+        if (i >= len) break;
+        seq = _eina_simd_utf8_seq(s + i, len - i);
+        if (!seq) return EINA_FALSE;
+        i += seq;
+        n++;
+     }
+   *chars = n;
+   return EINA_TRUE;
+}
+
+static size_t
+_eina_simd_utf8_decode_scalar(const unsigned char *s, size_t len, Eina_Unicode *out)
+{
+   size_t i = 0, n = 0;
+
+   while (i < len)
+     out[n++] = _eina_simd_utf8_get(s, &i);
+   return n;
+}
+
+static size_t
+_eina_simd_cspan_scalar(const unsigned char *s, size_t len,
+                        const unsigned char *set, size_t nset)
+{
+   const unsigned char *p;
+   uint32_t bits[8] = { 0 };
+   size_t i;
+
+   if (nset == 1)
+     {
+        p = memchr(s, set[0], len);
+        return p ? (size_t)(p - s) : len;
+     }
+   for (i = 0; i < nset; i++)
+     bits[set[i] >> 5] |= 1U << (set[i] & 31);
+   for (i = 0; i < len; i++)
+     if (bits[s[i] >> 5] & (1U << (s[i] & 31))) return i;
+   return len;
+}
+
+static const unsigned char *
+_eina_simd_memmem_scalar(const unsigned char *hay, size_t hlen,
+                         const unsigned char *needle, size_t nlen)
+{
+   const unsigned char *p, *end;
+
+   if (!nlen) return hay;
+   if (nlen > hlen) return NULL;
+
+   end = hay + hlen - nlen + 1;
+   for (p = hay; p < end; p++)
+     {
+        p = memchr(p, needle[0], end - p);
+        if (!p) return NULL;
+        if (!memcmp(p + 1, needle + 1, nlen - 1)) return p;
+     }
+   return NULL;
+}
+
+/*
+ * One round of the long key hash: each 64 bytes stripe is mixed into 8
+ * 64 bits lanes, lane i getting the 32x32 product of the two halves of
+ * (data ^ secret) and its neighbour i ^ 1 the data itself. Stripe n uses
+ * the secret from its n-th word. Every version has to give the exact same
+ * result, the hashes end up in tables built before eina_init() too.
+ */
+static void
+_eina_simd_hash_accumulate_scalar(uint64_t *acc, const unsigned char *p,
+                                  size_t nstripes, const uint64_t *secret)
+{
+   uint64_t data, key;
+   size_t n;
+   int i;
+
+   for (n = 0; n < nstripes; n++, p += 64)
+     for (i = 0; i < 8; i++)
+       {
+          memcpy(&data, p + i * 8, 8);
+          key = data ^ secret[n + i];
+          acc[i ^ 1] += data;
+          acc[i] += (key & 0xffffffff) * (key >> 32);
+       }
+}
+
+static Eina_Bool
+_eina_simd_bits_op_scalar(uint64_t *dst, const uint64_t *src, size_t n,
+                          Eina_Simd_Bits_Op op)
+{
+   uint64_t any = 0;
+   size_t i;
+
+   switch (op)
+     {
+      case EINA_SIMD_BITS_OR:
+        for (i = 0; i < n; i++) any |= (dst[i] |= src[i]);
+        break;
+      case EINA_SIMD_BITS_AND:
+        for (i = 0; i < n; i++) any |= (dst[i] &= src[i]);
+        break;
+      case EINA_SIMD_BITS_ANDNOT:
+        for (i = 0; i < n; i++) any |= (dst[i] &= ~src[i]);
+        break;
+     }
+   return !!any;
+}
+
+/*
+ * Strict UTF-8 validation after "Validating UTF-8 In Less Than One
+ * Instruction Per Byte" (Keiser, Lemire). Every byte is classified with
+ * three 16 entries lookups, on the high nibble of the previous byte, its
+ * low nibble and the high nibble of the current byte; the and of the three
+ * is non zero for any invalid 2 bytes pattern. 3 and 4 bytes sequences are
+ * then checked by looking 2 and 3 bytes back for a lead byte.
+ */
+#define TOO_SHORT      (1 << 0) /* 11______ 0_______ */
+#define TOO_LONG       (1 << 1) /* 0_______ 10______ */
+#define OVERLONG_3     (1 << 2) /* 11100000 100_____ */
+#define TOO_LARGE      (1 << 3) /* 11110100 1001____ and above */
+#define SURROGATE      (1 << 4) /* 11101101 101_____ */
+#define OVERLONG_2     (1 << 5) /* 1100000_ 10______ */
+#define TOO_LARGE_1000 (1 << 6) /* 11110101 1000____ and above */
+#define OVERLONG_4     (1 << 6) /* 11110000 1000____ */
+#define TWO_CONTS      (1 << 7) /* 10______ 10______ */
+#define CARRY          (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+#if defined(EINA_SIMD_X86) || defined(EINA_SIMD_NEON)
+static const unsigned char _eina_simd_byte_1_high[16] = {
+   TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+   TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+   TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+   TOO_SHORT | OVERLONG_2,
+   TOO_SHORT,
+   TOO_SHORT | OVERLONG_3 | SURROGATE,
+   TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+};
+
+static const unsigned char _eina_simd_byte_1_low[16] = {
+   CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+   CARRY | OVERLONG_2,
+   CARRY,
+   CARRY,
+   CARRY | TOO_LARGE,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+   CARRY | TOO_LARGE | TOO_LARGE_1000,
+   CARRY | TOO_LARGE | TOO_LARGE_1000
+};
+
+static const unsigned char _eina_simd_byte_2_high[16] = {
+   TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+   TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+   TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+   TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+   TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+   TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+   TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+};
+
+/* a block may not end in the middle of a sequence, the next block then has
+ * to start with continuation bytes */
+static const unsigned char _eina_simd_incomplete[32] = {
+   0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+   0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+   0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+   0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf
+};
+#endif
+
+#ifdef EINA_SIMD_X86
+static EINA_TARGET("sse2") Eina_Bool
+_eina_simd_utf8_len_sse2(const unsigned char *s, size_t len, size_t *chars)
+{
+   size_t i = 0, n = 0, seq;
+
+   /* no byte shuffle in sse2, only skip the ascii blocks */
+   while (i < len)
+     {
+        while ((i + 16 <= len) &&
+               (!_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(s + i)))))
+          {
+             i += 16;
+             n += 16;
+          }
+        if (i >= len) break;
+        seq = _eina_simd_utf8_seq(s + i, len - i);
+        if (!seq) return EINA_FALSE;
+        i += seq;
+        n++;
+     }
+   *chars = n;
+   return EINA_TRUE;
+}
+
+static EINA_TARGET("ssse3") __m128i
+_eina_simd_utf8_check_ssse3(__m128i input, __m128i prev)
+{
+   const __m128i nibble = _mm_set1_epi8(0x0f);
+   const __m128i b1h = _mm_loadu_si128((const __m128i *)_eina_simd_byte_1_high);
+   const __m128i b1l = _mm_loadu_si128((const __m128i *)_eina_simd_byte_1_low);
+   const __m128i b2h = _mm_loadu_si128((const __m128i *)_eina_simd_byte_2_high);
+   __m128i prev1, prev2, prev3, special, must23;
+
+   prev1 = _mm_alignr_epi8(input, prev, 16 - 1);
+   prev2 = _mm_alignr_epi8(input, prev, 16 - 2);
+   prev3 = _mm_alignr_epi8(input, prev, 16 - 3);
+
+   special = _mm_shuffle_epi8(b1h, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+   special = _mm_and_si128(special, _mm_shuffle_epi8(b1l, _mm_and_si128(prev1, nibble)));
+   special = _mm_and_si128(special, _mm_shuffle_epi8(b2h, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+
+   must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xe0 - 0x80))),
+                         _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xf0 - 0x80))));
+   must23 = _mm_and_si128(must23, _mm_set1_epi8((char)0x80));
+
+   return _mm_xor_si128(must23, special);
+}
+
+static EINA_TARGET("ssse3") Eina_Bool
+_eina_simd_utf8_len_ssse3(const unsigned char *s, size_t len, size_t *chars)
+{
+   const __m128i incomplete = _mm_loadu_si128((const __m128i *)(_eina_simd_incomplete + 16));
+   const __m128i cont = _mm_set1_epi8((char)0xc0);
+   __m128i prev = _mm_setzero_si128();
+   __m128i prev_incomplete = _mm_setzero_si128();
+   __m128i error = _mm_setzero_si128();
+   __m128i input;
+   unsigned char tail[16];
+   size_t i, n = 0;
+
+   for (i = 0; i + 16 <= len; i += 16)
+     {
+        input = _mm_loadu_si128((const __m128i *)(s + i));
+        if (!_mm_movemask_epi8(input))
+          {
+             error = _mm_or_si128(error, prev_incomplete);
+             prev_incomplete = _mm_setzero_si128();
+             n += 16;
+          }
+        else
+          {
+             error = _mm_or_si128(error, _eina_simd_utf8_check_ssse3(input, prev));
+             prev_incomplete = _mm_subs_epu8(input, incomplete);
+             /* continuation bytes are the signed ones below -64 */
+             n += 16 - __builtin_popcount(_mm_movemask_epi8(_mm_cmplt_epi8(input, cont)));
+          }
+        prev = input;
+     }
+
+   /* the last block is padded with nul, which also catches a sequence cut
+    * at the very end of the string */
+   memset(tail, 0, sizeof (tail));
+   memcpy(tail, s + i, len - i);
+   input = _mm_loadu_si128((const __m128i *)tail);
+   error = _mm_or_si128(error, _eina_simd_utf8_check_ssse3(input, prev));
+   if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xffff)
+     return EINA_FALSE;
+
+   for (; i < len; i++)
+     n += ((s[i] & 0xc0) != 0x80);
+   *chars = n;
+   return EINA_TRUE;
+}
+
+static EINA_TARGET("sse2") size_t
+_eina_simd_utf8_decode_sse2(const unsigned char *s, size_t len, Eina_Unicode *out)
+{
+   const __m128i zero = _mm_setzero_si128();
+   __m128i v, lo, hi;
+   size_t i = 0, n = 0;
+
+   while (i < len)
+     {
+        if (i + 16 <= len)
+          {
+             v = _mm_loadu_si128((const __m128i *)(s + i));
+             if (!_mm_movemask_epi8(v))
+               {
+                  lo = _mm_unpacklo_epi8(v, zero);
+                  hi = _mm_unpackhi_epi8(v, zero);
+                  _mm_storeu_si128((__m128i *)(out + n), _mm_unpacklo_epi16(lo, zero));
+                  _mm_storeu_si128((__m128i *)(out + n + 4), _mm_unpackhi_epi16(lo, zero));
+                  _mm_storeu_si128((__m128i *)(out + n + 8), _mm_unpacklo_epi16(hi, zero));
+                  _mm_storeu_si128((__m128i *)(out + n + 12), _mm_unpackhi_epi16(hi, zero));
+                  i += 16;
+                  n += 16;
+                  continue;
+               }
+          }
+        out[n++] = _eina_simd_utf8_get(s, &i);
+     }
+   return n;
+}
+
+static EINA_TARGET("sse2") size_t
+_eina_simd_cspan_sse2(const unsigned char *s, size_t len,
+                      const unsigned char *set, size_t nset)
+{
+   __m128i sets[16], v, m;
+   size_t i, j;
+   int mask;
+
+   // the first set is broadcast unconditionally
+   if (!nset) return len;
+   if (nset > 16) return _eina_simd_cspan_scalar(s, len, set, nset);
+
+   for (j = 0; j < nset; j++)
+     sets[j] = _mm_set1_epi8((char)set[j]);
+
+   for (i = 0; i + 16 <= len; i += 16)
+     {
+        v = _mm_loadu_si128((const __m128i *)(s + i));
+        m = _mm_cmpeq_epi8(v, sets[0]);
+        for (j = 1; j < nset; j++)
+          m = _mm_or_si128(m, _mm_cmpeq_epi8(v, sets[j]));
+        mask = _mm_movemask_epi8(m);
+        if (mask) return i + __builtin_ctz(mask);
+     }
+   return i + _eina_simd_cspan_scalar(s + i, len - i, set, nset);
+}
+
+/* Compares the first and the last byte of the needle at 16 positions at
+ * once, only the candidates where both match get a full compare. */
+static EINA_TARGET("sse2") const unsigned char *
+_eina_simd_memmem_sse2(const unsigned char *hay, size_t hlen,
+                       const unsigned char *needle, size_t nlen)
+{
+   __m128i first, last, bf, bl;
+   const unsigned char *r;
+   size_t i;
+   int mask;
+
+   if (nlen < 2) return _eina_simd_memmem_scalar(hay, hlen, needle, nlen);
+   if (nlen > hlen) return NULL;
+
+   first = _mm_set1_epi8((char)needle[0]);
+   last = _mm_set1_epi8((char)needle[nlen - 1]);
+   for (i = 0; i + nlen - 1 + 16 <= hlen; i += 16)
+     {
+        bf = _mm_loadu_si128((const __m128i *)(hay + i));
+        bl = _mm_loadu_si128((const __m128i *)(hay + i + nlen - 1));
+        mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bf, first),
+                                               _mm_cmpeq_epi8(bl, last)));
+        while (mask)
+          {
+             int bit = __builtin_ctz(mask);
+
+             if (!memcmp(hay + i + bit + 1, needle + 1, nlen - 2))
+               return hay + i + bit;
+             mask &= mask - 1;
+          }
+     }
+   r = _eina_simd_memmem_scalar(hay + i, hlen - i, needle, nlen);
+   return r;
+}
+
+static EINA_TARGET("sse2") void
+_eina_simd_hash_accumulate_sse2(uint64_t *acc, const unsigned char *p,
+                                size_t nstripes, const uint64_t *secret)
+{
+   __m128i a[4], data, key;
+   size_t n;
+   int i;
+
+   for (i = 0; i < 4; i++)
+     a[i] = _mm_loadu_si128((const __m128i *)(acc + i * 2));
+   for (n = 0; n < nstripes; n++, p += 64)
+     for (i = 0; i < 4; i++)
+       {
+          data = _mm_loadu_si128((const __m128i *)(p + i * 16));
+          key = _mm_xor_si128(data, _mm_loadu_si128((const __m128i *)(secret + n + i * 2)));
+          /* low half times high half of each 64 bits lane */
+          a[i] = _mm_add_epi64(a[i], _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1))));
+          a[i] = _mm_add_epi64(a[i], _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+       }
+   for (i = 0; i < 4; i++)
+     _mm_storeu_si128((__m128i *)(acc + i * 2), a[i]);
+}
+
+static EINA_TARGET("sse2") Eina_Bool
+_eina_simd_bits_op_sse2(uint64_t *dst, const uint64_t *src, size_t n,
+                        Eina_Simd_Bits_Op op)
+{
+   __m128i any = _mm_setzero_si128(), d, v;
+   Eina_Bool tail = EINA_FALSE;
+   size_t i;
+
+   for (i = 0; i + 2 <= n; i += 2)
+     {
+        d = _mm_loadu_si128((const __m128i *)(dst + i));
+        v = _mm_loadu_si128((const __m128i *)(src + i));
+        if (op == EINA_SIMD_BITS_OR) d = _mm_or_si128(d, v);
+        else if (op == EINA_SIMD_BITS_AND) d = _mm_and_si128(d, v);
+        else d = _mm_andnot_si128(v, d);
+        _mm_storeu_si128((__m128i *)(dst + i), d);
+        any = _mm_or_si128(any, d);
+     }
+   if (i < n)
+     tail = _eina_simd_bits_op_scalar(dst + i, src + i, n - i, op);
+   return tail ||
+     (_mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) != 0xffff);
+}
+
+static EINA_TARGET("avx2") __m256i
+_eina_simd_utf8_check_avx2(__m256i input, __m256i prev)
+{
+   const __m256i nibble = _mm256_set1_epi8(0x0f);
+   const __m256i b1h = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)_eina_simd_byte_1_high));
+   const __m256i b1l = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)_eina_simd_byte_1_low));
+   const __m256i b2h = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)_eina_simd_byte_2_high));
+   __m256i shifted, prev1, prev2, prev3, special, must23;
+
+   /* the previous 32 bytes, crossing the 128 bits lanes */
+   shifted = _mm256_permute2x128_si256(prev, input, 0x21);
+   prev1 = _mm256_alignr_epi8(input, shifted, 16 - 1);
+   prev2 = _mm256_alignr_epi8(input, shifted, 16 - 2);
+   prev3 = _mm256_alignr_epi8(input, shifted, 16 - 3);
+
+   special = _mm256_shuffle_epi8(b1h, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+   special = _mm256_and_si256(special, _mm256_shuffle_epi8(b1l, _mm256_and_si256(prev1, nibble)));
+   special = _mm256_and_si256(special, _mm256_shuffle_epi8(b2h, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+   must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xe0 - 0x80))),
+                            _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xf0 - 0x80))));
+   must23 = _mm256_and_si256(must23, _mm256_set1_epi8((char)0x80));
+
+   return _mm256_xor_si256(must23, special);
+}
+
+static EINA_TARGET("avx2") Eina_Bool
+_eina_simd_utf8_len_avx2(const unsigned char *s, size_t len, size_t *chars)
+{
+   const __m256i incomplete = _mm256_loadu_si256((const __m256i *)_eina_simd_incomplete);
+   const __m256i cont = _mm256_set1_epi8((char)0xc0);
+   __m256i prev = _mm256_setzero_si256();
+   __m256i prev_incomplete = _mm256_setzero_si256();
+   __m256i error = _mm256_setzero_si256();
+   __m256i input;
+   unsigned char tail[32];
+   size_t i, n = 0;
+
+   for (i = 0; i + 32 <= len; i += 32)
+     {
+        input = _mm256_loadu_si256((const __m256i *)(s + i));
+        if (!_mm256_movemask_epi8(input))
+          {
+             error = _mm256_or_si256(error, prev_incomplete);
+             prev_incomplete = _mm256_setzero_si256();
+             n += 32;
+          }
+        else
+          {
+             error = _mm256_or_si256(error, _eina_simd_utf8_check_avx2(input, prev));
+             prev_incomplete = _mm256_subs_epu8(input, incomplete);
+             n += 32 - __builtin_popcount((unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(cont, input)));
+          }
+        prev = input;
+     }
+
+   memset(tail, 0, sizeof (tail));
+   memcpy(tail, s + i, len - i);
+   input = _mm256_loadu_si256((const __m256i *)tail);
+   error = _mm256_or_si256(error, _eina_simd_utf8_check_avx2(input, prev));
+   if (!_mm256_testz_si256(error, error))
+     return EINA_FALSE;
+
+   for (; i < len; i++)
+     n += ((s[i] & 0xc0) != 0x80);
+   *chars = n;
+   return EINA_TRUE;
+}
+
+static EINA_TARGET("avx2") size_t
+_eina_simd_utf8_decode_avx2(const unsigned char *s, size_t len, Eina_Unicode *out)
+{
+   size_t i = 0, n = 0;
+   int k;
+
+   while (i < len)
+     {
+        if ((i + 32 <= len) &&
+            (!_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)(s + i)))))
+          {
+             for (k = 0; k < 4; k++)
+               _mm256_storeu_si256((__m256i *)(out + n + k * 8),
+                                   _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(s + i + k * 8))));
+             i += 32;
+             n += 32;
+             continue;
+          }
+        out[n++] = _eina_simd_utf8_get(s, &i);
+     }
+   return n;
+}
+
+static EINA_TARGET("avx2") size_t
+_eina_simd_cspan_avx2(const unsigned char *s, size_t len,
+                      const unsigned char *set, size_t nset)
+{
+   __m256i sets[16], v, m;
+   size_t i, j;
+   unsigned int mask;
+
+   if (!nset) return len;
+   if (nset > 16) return _eina_simd_cspan_scalar(s, len, set, nset);
+
+   for (j = 0; j < nset; j++)
+     sets[j] = _mm256_set1_epi8((char)set[j]);
+
+   for (i = 0; i + 32 <= len; i += 32)
+     {
+        v = _mm256_loadu_si256((const __m256i *)(s + i));
+        m = _mm256_cmpeq_epi8(v, sets[0]);
+        for (j = 1; j < nset; j++)
+          m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, sets[j]));
+        mask = (unsigned int)_mm256_movemask_epi8(m);
+        if (mask) return i + __builtin_ctz(mask);
+     }
+   return i + _eina_simd_cspan_sse2(s + i, len - i, set, nset);
+}
+
+static EINA_TARGET("avx2") const unsigned char *
+_eina_simd_memmem_avx2(const unsigned char *hay, size_t hlen,
+                       const unsigned char *needle, size_t nlen)
+{
+   __m256i first, last, bf, bl;
+   size_t i;
+   unsigned int mask;
+
+   if (nlen < 2) return _eina_simd_memmem_scalar(hay, hlen, needle, nlen);
+   if (nlen > hlen) return NULL;
+
+   first = _mm256_set1_epi8((char)needle[0]);
+   last = _mm256_set1_epi8((char)needle[nlen - 1]);
+   for (i = 0; i + nlen - 1 + 32 <= hlen; i += 32)
+     {
+        bf = _mm256_loadu_si256((const __m256i *)(hay + i));
+        bl = _mm256_loadu_si256((const __m256i *)(hay + i + nlen - 1));
+        mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(bf, first),
+                                                                   _mm256_cmpeq_epi8(bl, last)));
+        while (mask)
+          {
+             int bit = __builtin_ctz(mask);
+
+             if (!memcmp(hay + i + bit + 1, needle + 1, nlen - 2))
+               return hay + i + bit;
+             mask &= mask - 1;
+          }
+     }
+   return _eina_simd_memmem_sse2(hay + i, hlen - i, needle, nlen);
+}
+
+static EINA_TARGET("avx2") void
+_eina_simd_hash_accumulate_avx2(uint64_t *acc, const unsigned char *p,
+                                size_t nstripes, const uint64_t *secret)
+{
+   __m256i a0, a1, data, key;
+   size_t n;
+
+   a0 = _mm256_loadu_si256((const __m256i *)acc);
+   a1 = _mm256_loadu_si256((const __m256i *)(acc + 4));
+   for (n = 0; n < nstripes; n++, p += 64)
+     {
+        data = _mm256_loadu_si256((const __m256i *)p);
+        key = _mm256_xor_si256(data, _mm256_loadu_si256((const __m256i *)(secret + n)));
+        a0 = _mm256_add_epi64(a0, _mm256_mul_epu32(key, _mm256_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1))));
+        a0 = _mm256_add_epi64(a0, _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        data = _mm256_loadu_si256((const __m256i *)(p + 32));
+        key = _mm256_xor_si256(data, _mm256_loadu_si256((const __m256i *)(secret + n + 4)));
+        a1 = _mm256_add_epi64(a1, _mm256_mul_epu32(key, _mm256_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1))));
+        a1 = _mm256_add_epi64(a1, _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+     }
+   _mm256_storeu_si256((__m256i *)acc, a0);
+   _mm256_storeu_si256((__m256i *)(acc + 4), a1);
+}
+
+static EINA_TARGET("avx2") Eina_Bool
+_eina_simd_bits_op_avx2(uint64_t *dst, const uint64_t *src, size_t n,
+                        Eina_Simd_Bits_Op op)
+{
+   __m256i any = _mm256_setzero_si256(), d, v;
+   Eina_Bool tail = EINA_FALSE;
+   size_t i;
+
+   for (i = 0; i + 4 <= n; i += 4)
+     {
+        d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        v = _mm256_loadu_si256((const __m256i *)(src + i));
+        if (op == EINA_SIMD_BITS_OR) d = _mm256_or_si256(d, v);
+        else if (op == EINA_SIMD_BITS_AND) d = _mm256_and_si256(d, v);
+        else d = _mm256_andnot_si256(v, d);
+        _mm256_storeu_si256((__m256i *)(dst + i), d);
+        any = _mm256_or_si256(any, d);
+     }
+   if (i < n)
+     tail = _eina_simd_bits_op_sse2(dst + i, src + i, n - i, op);
+   return tail || !_mm256_testz_si256(any, any);
+}
+#endif
+
+#ifdef EINA_SIMD_NEON
+static inline uint8x16_t
+_eina_simd_utf8_check_neon(uint8x16_t input, uint8x16_t prev)
+{
+   const uint8x16_t b1h = vld1q_u8(_eina_simd_byte_1_high);
+   const uint8x16_t b1l = vld1q_u8(_eina_simd_byte_1_low);
+   const uint8x16_t b2h = vld1q_u8(_eina_simd_byte_2_high);
+   const uint8x16_t nibble = vdupq_n_u8(0x0f);
+   uint8x16_t prev1, prev2, prev3, special, must23;
+
+   prev1 = vextq_u8(prev, input, 16 - 1);
+   prev2 = vextq_u8(prev, input, 16 - 2);
+   prev3 = vextq_u8(prev, input, 16 - 3);
+
+   special = vqtbl1q_u8(b1h, vshrq_n_u8(prev1, 4));
+   special = vandq_u8(special, vqtbl1q_u8(b1l, vandq_u8(prev1, nibble)));
+   special = vandq_u8(special, vqtbl1q_u8(b2h, vshrq_n_u8(input, 4)));
+
+   must23 = vorrq_u8(vqsubq_u8(prev2, vdupq_n_u8(0xe0 - 0x80)),
+                     vqsubq_u8(prev3, vdupq_n_u8(0xf0 - 0x80)));
+   must23 = vandq_u8(must23, vdupq_n_u8(0x80));
+
+   return veorq_u8(must23, special);
+}
+
+static Eina_Bool
+_eina_simd_utf8_len_neon(const unsigned char *s, size_t len, size_t *chars)
+{
+   const uint8x16_t incomplete = vld1q_u8(_eina_simd_incomplete + 16);
+   const uint8x16_t cont = vdupq_n_u8(0xc0);
+   uint8x16_t prev = vdupq_n_u8(0);
+   uint8x16_t prev_incomplete = vdupq_n_u8(0);
+   uint8x16_t error = vdupq_n_u8(0);
+   uint8x16_t input;
+   unsigned char tail[16];
+   size_t i, n = 0;
+
+   for (i = 0; i + 16 <= len; i += 16)
+     {
+        input = vld1q_u8(s + i);
+        if (vmaxvq_u8(input) < 0x80)
+          {
+             error = vorrq_u8(error, prev_incomplete);
+             prev_incomplete = vdupq_n_u8(0);
+             n += 16;
+          }
+        else
+          {
+             error = vorrq_u8(error, _eina_simd_utf8_check_neon(input, prev));
+             prev_incomplete = vqsubq_u8(input, incomplete);
+             /* continuation bytes are below 0xc0 once the ascii are out */
+             n += 16 - vaddvq_u8(vandq_u8(vandq_u8(vcltq_u8(input, cont),
+                                                   vcgeq_u8(input, vdupq_n_u8(0x80))),
+                                          vdupq_n_u8(1)));
+          }
+        prev = input;
+     }
+
+   memset(tail, 0, sizeof (tail));
+   memcpy(tail, s + i, len - i);
+   input = vld1q_u8(tail);
+   error = vorrq_u8(error, _eina_simd_utf8_check_neon(input, prev));
+   if (vmaxvq_u8(error)) return EINA_FALSE;
+
+   for (; i < len; i++)
+     n += ((s[i] & 0xc0) != 0x80);
+   *chars = n;
+   return EINA_TRUE;
+}
+
+static size_t
+_eina_simd_utf8_decode_neon(const unsigned char *s, size_t len, Eina_Unicode *out)
+{
+   uint8x16_t v;
+   uint16x8_t lo, hi;
+   size_t i = 0, n = 0;
+
+   while (i < len)
+     {
+        if (i + 16 <= len)
+          {
+             v = vld1q_u8(s + i);
+             if (vmaxvq_u8(v) < 0x80)
+               {
+                  lo = vmovl_u8(vget_low_u8(v));
+                  hi = vmovl_u8(vget_high_u8(v));
+                  vst1q_u32(out + n, vmovl_u16(vget_low_u16(lo)));
+                  vst1q_u32(out + n + 4, vmovl_u16(vget_high_u16(lo)));
+                  vst1q_u32(out + n + 8, vmovl_u16(vget_low_u16(hi)));
+                  vst1q_u32(out + n + 12, vmovl_u16(vget_high_u16(hi)));
+                  i += 16;
+                  n += 16;
+                  continue;
+               }
+          }
+        out[n++] = _eina_simd_utf8_get(s, &i);
+     }
+   return n;
+}
+
+static size_t
+_eina_simd_cspan_neon(const unsigned char *s, size_t len,
+                      const unsigned char *set, size_t nset)
+{
+   uint8x16_t sets[16], v, m;
+   size_t i, j;
+
+   if (!nset) return len;
+   if (nset > 16) return _eina_simd_cspan_scalar(s, len, set, nset);
+
+   for (j = 0; j < nset; j++)
+     sets[j] = vdupq_n_u8(set[j]);
+
+   for (i = 0; i + 16 <= len; i += 16)
+     {
+        v = vld1q_u8(s + i);
+        m = vceqq_u8(v, sets[0]);
+        for (j = 1; j < nset; j++)
+          m = vorrq_u8(m, vceqq_u8(v, sets[j]));
+        if (vmaxvq_u8(m))
+          return i + _eina_simd_cspan_scalar(s + i, 16, set, nset);
+     }
+   return i + _eina_simd_cspan_scalar(s + i, len - i, set, nset);
+}
+
+static const unsigned char *
+_eina_simd_memmem_neon(const unsigned char *hay, size_t hlen,
+                       const unsigned char *needle, size_t nlen)
+{
+   uint8x16_t first, last, m;
+   unsigned char cand[16];
+   size_t i;
+   int k;
+
+   if (nlen < 2) return _eina_simd_memmem_scalar(hay, hlen, needle, nlen);
+   if (nlen > hlen) return NULL;
+
+   first = vdupq_n_u8(needle[0]);
+   last = vdupq_n_u8(needle[nlen - 1]);
+   for (i = 0; i + nlen - 1 + 16 <= hlen; i += 16)
+     {
+        m = vandq_u8(vceqq_u8(vld1q_u8(hay + i), first),
+                     vceqq_u8(vld1q_u8(hay + i + nlen - 1), last));
+        if (!vmaxvq_u8(m)) continue;
+        vst1q_u8(cand, m);
+        for (k = 0; k < 16; k++)
+          if (cand[k] && !memcmp(hay + i + k + 1, needle + 1, nlen - 2))
+            return hay + i + k;
+     }
+   return _eina_simd_memmem_scalar(hay + i, hlen - i, needle, nlen);
+}
+
+static void
+_eina_simd_hash_accumulate_neon(uint64_t *acc, const unsigned char *p,
+                                size_t nstripes, const uint64_t *secret)
+{
+   uint64x2_t a[4], data, key;
+   size_t n;
+   int i;
+
+   for (i = 0; i < 4; i++)
+     a[i] = vld1q_u64(acc + i * 2);
+   for (n = 0; n < nstripes; n++, p += 64)
+     for (i = 0; i < 4; i++)
+       {
+          data = vreinterpretq_u64_u8(vld1q_u8(p + i * 16));
+          key = veorq_u64(data, vld1q_u64(secret + n + i * 2));
+          a[i] = vmlal_u32(a[i], vmovn_u64(key), vshrn_n_u64(key, 32));
+          a[i] = vaddq_u64(a[i], vextq_u64(data, data, 1));
+       }
+   for (i = 0; i < 4; i++)
+     vst1q_u64(acc + i * 2, a[i]);
+}
+
+static Eina_Bool
+_eina_simd_bits_op_neon(uint64_t *dst, const uint64_t *src, size_t n,
+                        Eina_Simd_Bits_Op op)
+{
+   uint64x2_t any = vdupq_n_u64(0), d, v;
+   Eina_Bool tail = EINA_FALSE;
+   size_t i;
+
+   for (i = 0; i + 2 <= n; i += 2)
+     {
+        d = vld1q_u64(dst + i);
+        v = vld1q_u64(src + i);
+        if (op == EINA_SIMD_BITS_OR) d = vorrq_u64(d, v);
+        else if (op == EINA_SIMD_BITS_AND) d = vandq_u64(d, v);
+        else d = vbicq_u64(d, v);
+        vst1q_u64(dst + i, d);
+        any = vorrq_u64(any, d);
+     }
+   if (i < n)
+     tail = _eina_simd_bits_op_scalar(dst + i, src + i, n - i, op);
+   return tail || (vgetq_lane_u64(any, 0) | vgetq_lane_u64(any, 1));
+}
+#endif
+
+static const Eina_Simd_Funcs _eina_simd_scalar = {
+   _eina_simd_utf8_len_scalar,
+   _eina_simd_utf8_decode_scalar,
+   _eina_simd_cspan_scalar,
+   _eina_simd_memmem_scalar,
+   _eina_simd_hash_accumulate_scalar,
+   _eina_simd_bits_op_scalar
+};
+
+/* usable before eina_init(), only faster after */
+static Eina_Simd_Funcs _eina_simd = {
+   _eina_simd_utf8_len_scalar,
+   _eina_simd_utf8_decode_scalar,
+   _eina_simd_cspan_scalar,
+   _eina_simd_memmem_scalar,
+   _eina_simd_hash_accumulate_scalar,
+   _eina_simd_bits_op_scalar
+};
+
+/**
+ * @endcond
+ */
+
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+
+Eina_Bool
+eina_simd_init(void)
+{
+   Eina_Cpu_Features features = eina_cpu_features_get();
+
+   _eina_simd = _eina_simd_scalar;
+
+#ifdef EINA_SIMD_X86
+   if ((features & EINA_CPU_SSE2) && (!getenv("EINA_CPU_NO_SSE2")))
+     {
+        _eina_simd.utf8_len = _eina_simd_utf8_len_sse2;
+        _eina_simd.utf8_decode = _eina_simd_utf8_decode_sse2;
+        _eina_simd.cspan = _eina_simd_cspan_sse2;
+        _eina_simd.memmem = _eina_simd_memmem_sse2;
+        _eina_simd.hash_accumulate = _eina_simd_hash_accumulate_sse2;
+        _eina_simd.bits_op = _eina_simd_bits_op_sse2;
+
+        if ((features & EINA_CPU_SSSE3) && (!getenv("EINA_CPU_NO_SSSE3")))
+          _eina_simd.utf8_len = _eina_simd_utf8_len_ssse3;
+
+        if ((features & EINA_CPU_AVX2) && (!getenv("EINA_CPU_NO_AVX2")))
+          {
+             _eina_simd.utf8_len = _eina_simd_utf8_len_avx2;
+             _eina_simd.utf8_decode = _eina_simd_utf8_decode_avx2;
+             _eina_simd.cspan = _eina_simd_cspan_avx2;
+             _eina_simd.memmem = _eina_simd_memmem_avx2;
+             _eina_simd.hash_accumulate = _eina_simd_hash_accumulate_avx2;
+             _eina_simd.bits_op = _eina_simd_bits_op_avx2;
+          }
+     }
+#endif
+#ifdef EINA_SIMD_NEON
+   if ((features & EINA_CPU_NEON) && (!getenv("EINA_CPU_NO_NEON")))
+     {
+        _eina_simd.utf8_len = _eina_simd_utf8_len_neon;
+        _eina_simd.utf8_decode = _eina_simd_utf8_decode_neon;
+        _eina_simd.cspan = _eina_simd_cspan_neon;
+        _eina_simd.memmem = _eina_simd_memmem_neon;
+        _eina_simd.hash_accumulate = _eina_simd_hash_accumulate_neon;
+        _eina_simd.bits_op = _eina_simd_bits_op_neon;
+     }
+#endif
+   (void)features;
+
+   return EINA_TRUE;
+}
+
+Eina_Bool
+eina_simd_shutdown(void)
+{
+   _eina_simd = _eina_simd_scalar;
+   return EINA_TRUE;
+}
+
+Eina_Bool
+eina_simd_utf8_len(const char *s, size_t len, size_t *chars)
+{
+   return _eina_simd.utf8_len((const unsigned char *)s, len, chars);
+}
+
+size_t
+eina_simd_utf8_decode(const char *s, size_t len, Eina_Unicode *out)
+{
+   return _eina_simd.utf8_decode((const unsigned char *)s, len, out);
+}
+
+size_t
+eina_simd_cspan(const char *s, size_t len, const char *set, size_t nset)
+{
+   return _eina_simd.cspan((const unsigned char *)s, len,
+                           (const unsigned char *)set, nset);
+}
+
+const char *
+eina_simd_memmem(const char *hay, size_t hlen, const char *needle, size_t nlen)
+{
+   return (const char *)_eina_simd.memmem((const unsigned char *)hay, hlen,
+                                          (const unsigned char *)needle, nlen);
+}
+
+void
+eina_simd_hash_accumulate(uint64_t *acc, const void *p, size_t nstripes,
+                          const uint64_t *secret)
+{
+   _eina_simd.hash_accumulate(acc, p, nstripes, secret);
+}
+
+Eina_Bool
+eina_simd_bits_op(uint64_t *dst, const uint64_t *src, size_t n,
+                  Eina_Simd_Bits_Op op)
+{
+   return _eina_simd.bits_op(dst, src, n, op);
+}
@@ -0,0 +1,53 @@
+#ifndef EINA_SIMD_H
+#define EINA_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eina_types.h"
+#include "eina_unicode.h"
+
+/*
+ * Internal byte string primitives with SSE2/AVX2/NEON versions, picked at
+ * eina_init() time from eina_cpu_features. All of them work on explicit
+ * lengths and never read past s + len. Every one has a scalar version, used
+ * when no vector unit is found or when EINA_CPU_NO_SSE2, EINA_CPU_NO_SSSE3,
+ * EINA_CPU_NO_AVX2 or EINA_CPU_NO_NEON is set in the environment.
+ */
+
+/* Counts the code points of s if it is strict UTF-8 (RFC 3629: no overlong
+ * forms, no surrogates, nothing above U+10FFFF). Returns EINA_FALSE without
+ * touching chars otherwise. */
+Eina_Bool eina_simd_utf8_len(const char *s, size_t len, size_t *chars);
+
+/* Decodes s, that eina_simd_utf8_len() accepted, into out. Returns the
+ * number of code points written. */
+size_t eina_simd_utf8_decode(const char *s, size_t len, Eina_Unicode *out);
+
+/* Returns the offset of the first byte of s that is in set, or len. */
+size_t eina_simd_cspan(const char *s, size_t len, const char *set, size_t nset);
+
+/* Returns the first occurrence of needle in hay, or NULL. */
+const char *eina_simd_memmem(const char *hay, size_t hlen, const char *needle, size_t nlen);
+
+/* Mixes nstripes blocks of 64 bytes of p into the 8 lanes of acc, the
+ * inner loop of eina_hash_fast() for long keys. secret must hold
+ * nstripes + 7 words. */
+void eina_simd_hash_accumulate(uint64_t *acc, const void *p, size_t nstripes, const uint64_t *secret);
+
+/* Bitwise operations over bitsets, see eina_simd_bits_op(). */
+typedef enum _Eina_Simd_Bits_Op
+{
+   EINA_SIMD_BITS_OR,     /* dst |= src */
+   EINA_SIMD_BITS_AND,    /* dst &= src */
+   EINA_SIMD_BITS_ANDNOT  /* dst &= ~src */
+} Eina_Simd_Bits_Op;
+
+/* Applies op to the n words of dst and src. Returns EINA_TRUE if any bit
+ * of dst is set afterwards. */
+Eina_Bool eina_simd_bits_op(uint64_t *dst, const uint64_t *src, size_t n, Eina_Simd_Bits_Op op);
+
+Eina_Bool eina_simd_init(void);
+Eina_Bool eina_simd_shutdown(void);
+
+#endif
@@ -40,6 +40,7 @@
 #include "eina_private.h"
 #include "eina_str.h"
 #include "eina_cpu.h"
+#include "eina_simd.h"
 
 /*============================================================================*
 *                                  Local                                     *
@@ -77,7 +78,7 @@ eina_str_split_full_helper(const char *str,
                            unsigned int *elements)
 {
    char *s, *pos, **str_array;
-   const char *src;
+   const char *src, *match;
    size_t len, dlen;
    unsigned int tokens = 0, x;
    const char *idx[256] = {NULL};
@@ -125,32 +126,20 @@ eina_str_split_full_helper(const char *str,
         return NULL;
      }
 
+   len = strlen(str);
    src = str;
-   /* count tokens and check strlen(str) */
-   while (*src != '\0')
+   /* count tokens */
+   while ((match = eina_simd_memmem(src, str + len - src, delim, dlen)))
      {
-        const char *d = delim, *d_end = d + dlen;
-        const char *tmp = src;
-        for (; (d < d_end) && (*tmp != '\0'); d++, tmp++)
+        src = match + dlen;
+        if (tokens < (sizeof(idx) / sizeof(idx[0])))
           {
-             if (EINA_LIKELY(*d != *tmp))
-                break;
+             idx[tokens] = src;
+             //printf("token %d='%s'\n", tokens + 1, idx[tokens]);
           }
-        if (EINA_UNLIKELY(d == d_end))
-          {
-             src = tmp;
-             if (tokens < (sizeof(idx) / sizeof(idx[0])))
-               {
-                  idx[tokens] = tmp;
-                  //printf("token %d='%s'\n", tokens + 1, idx[tokens]);
-               }
-             tokens++;
-             if (tokens && (tokens == (unsigned int)max_tokens)) break;
-          }
-        else
-           src++;
+        tokens++;
+        if (tokens == (unsigned int)max_tokens) break;
      }
-   len = src - str + strlen(src);
 
    str_array = malloc(sizeof(char *) * (tokens + 2));
    if (!str_array)
@@ -647,48 +636,44 @@ eina_str_convert_len(const char *enc_from EINA_UNUSED, const char *enc_to EINA_U
 EAPI char *
 eina_str_escape(const char *str)
 {
+   /* the letter that follows the backslash, 0 when nothing is escaped */
+   static const char escape[256] = {
+      ['\t'] = 't', ['\n'] = 'n', [' '] = ' ',
+      ['\"'] = '\"', ['\''] = '\'', ['\\'] = '\\'
+   };
+   static const char special[] = " \\'\"\n\t";
+   const unsigned char *s, *end;
    char *s2, *d;
-   const char *s;
+   size_t len, run, plain = 0;
 
    if (!str)
       return NULL;
 
-   s2 = malloc((strlen(str) * 2) + 1);
+   len = strlen(str);
+   s2 = malloc((len * 2) + 1);
    if (!s2)
       return NULL;
 
-   for (s = str, d = s2; *s != 0; s++, d++)
+   end = (const unsigned char *)str + len;
+   for (s = (const unsigned char *)str, d = s2; s < end; s++)
      {
-        switch (*s)
-        {
-         case ' ':
-         case '\\':
-         case '\'':
-         case '\"':
-           {
-             *d = '\\';
-             d++;
-             *d = *s;
-             break;
-           }
-         case '\n':
-           {
-             *d = '\\'; d++;
-             *d = 'n';
-             break;
-           }
-         case '\t':
-           {
-             *d = '\\'; d++;
-             *d = 't';
-             break;
-           }
-         default:
-           {
-             *d = *s;
-             break;
-           }
-        }
+        if (!escape[*s])
+          {
+             *d++ = *s;
+             /* after a few plain chars, copy the whole run up to the next
+              * char to escape in one go */
+             if (++plain < 16) continue;
+             plain = 0;
+             run = eina_simd_cspan((const char *)s + 1, end - s - 1,
+                                   special, sizeof(special) - 1);
+             memcpy(d, s + 1, run);
+             d += run;
+             s += run;
+             continue;
+          }
+        plain = 0;
+        *d++ = '\\';
+        *d++ = escape[*s];
      }
    *d = 0;
    return s2;
@@ -16,6 +16,7 @@
 #include "eina_safety_checks.h"
 #include "eina_strbuf.h"
 #include "eina_strbuf_common.h"
+#include "eina_simd.h"
 
 /*============================================================================*
 *                                  Local                                     *
@@ -933,7 +934,7 @@ eina_strbuf_replace(Eina_Strbuf *buf,
                     unsigned int n)
 {
    size_t len1, len2;
-   char *spos;
+   const char *spos, *end;
    size_t pos;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL( str, EINA_FALSE);
@@ -941,13 +942,16 @@ eina_strbuf_replace(Eina_Strbuf *buf,
    EINA_MAGIC_CHECK_STRBUF(buf, 0);
    if (n == 0) return EINA_FALSE;
 
+   len1 = strlen(str);
    spos = buf->buf;
+   end = spos + strlen(spos);
    while (n--)
      {
-        spos = strstr(spos, str);
+        spos = eina_simd_memmem(spos, end - spos, str, len1);
         if (!spos || *spos == '\0') return EINA_FALSE;
         if (n) spos++;
      }
+   pos = spos - (const char *)buf->buf;
 
    /* This is a read only buffer which need change to be made */
    if (buf->ro)
@@ -958,10 +962,9 @@ eina_strbuf_replace(Eina_Strbuf *buf,
         if (!dest) return 0;
         memcpy(dest, buf->buf, buf->len);
         buf->buf = dest;
+        buf->ro = EINA_FALSE;
      }
 
-   pos = spos - (const char *)buf->buf;
-   len1 = strlen(str);
    len2 = strlen(with);
    if (len1 != len2)
      {
@@ -984,86 +987,87 @@ EAPI int
 eina_strbuf_replace_all(Eina_Strbuf *buf, const char *str, const char *with)
 {
    size_t len1, len2, len;
-   char *tmp_buf = NULL;
-   char *spos;
-   size_t pos, start;
-   size_t pos_tmp, start_tmp;
+   const char *tmp_buf, *spos, *end, *src;
+   unsigned char *dst;
+   Eina_Bool ro;
    int n = 0;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL( str, 0);
    EINA_SAFETY_ON_NULL_RETURN_VAL(with, 0);
    EINA_MAGIC_CHECK_STRBUF(buf, 0);
 
-   spos = strstr(buf->buf, str);
-   if (!spos || *spos == '\0') return 0;
-
-   /* This is a read only buffer which need change to be made */
-   if (buf->ro)
-     {
-        char *dest;
+   len1 = strlen(str);
+   if (!len1) return 0;
 
-        dest = malloc(buf->size);
-        if (!dest) return 0;
-        memcpy(dest, buf->buf, buf->len);
-        buf->buf = dest;
-     }
+   /* like strstr(), only look up to the first nul */
+   tmp_buf = buf->buf;
+   end = tmp_buf + strlen(tmp_buf);
+   spos = eina_simd_memmem(tmp_buf, end - tmp_buf, str, len1);
+   if (!spos) return 0;
 
-   len1 = strlen(str);
    len2 = strlen(with);
+   ro = buf->ro;
    /* if the size of the two string is equal, it is fairly easy to replace them
     * we don't need to resize the buffer or doing other calculations */
    if (len1 == len2)
      {
-        while (spos)
+        size_t pos = spos - tmp_buf;
+
+        /* This is a read only buffer which need change to be made */
+        if (ro)
           {
-             memcpy(spos, with, len2);
-             spos = strstr(spos + len2, str);
+             char *dest;
+
+             dest = malloc(buf->size);
+             if (!dest) return 0;
+             memcpy(dest, buf->buf, buf->len);
+             buf->buf = dest;
+             buf->ro = EINA_FALSE;
+             end = dest + (end - tmp_buf);
+          }
+        for (spos = (const char *)buf->buf + pos; spos;
+             spos = eina_simd_memmem(spos, end - spos, str, len1))
+          {
+             memcpy((char *)spos, with, len2);
+             spos += len2;
              n++;
           }
         return n;
      }
-   pos = pos_tmp = spos - (const char *)buf->buf;
-   tmp_buf = buf->buf;
+
+   /* count the matches first so the new text is allocated only once */
+   for (src = spos; src; src = eina_simd_memmem(src, end - src, str, len1))
+     {
+        src += len1;
+        n++;
+     }
+   len = buf->len - n * len1 + n * len2;
+
    buf->buf = malloc(buf->size);
-   if (EINA_UNLIKELY(!buf->buf))
+   buf->ro = EINA_FALSE;
+   if (EINA_UNLIKELY(!buf->buf) ||
+       EINA_UNLIKELY(!_eina_strbuf_common_grow(_STRBUF_CSIZE, buf, len)))
      {
-        buf->buf = tmp_buf;
+        free(buf->buf);
+        buf->buf = (void *)tmp_buf;
+        buf->ro = ro;
         return 0;
      }
-   start = start_tmp = 0;
-   len = buf->len;
-   while (spos)
+
+   dst = buf->buf;
+   for (src = tmp_buf; spos; spos = eina_simd_memmem(src, end - src, str, len1))
      {
-        n++;
-        len = (len + len2) - len1;
-        /* resize the buffer if necessary */
-        if (EINA_UNLIKELY(!_eina_strbuf_common_grow(_STRBUF_CSIZE, buf, len)))
-          {
-             /* we have to stop replacing here, because we haven't enough
-              * memory to go on */
-             len = (len + len1) - len2;
-             break;
-          }
-        /* copy the untouched text */
-        memcpy(((unsigned char *)(buf->buf)) + start,  tmp_buf + start_tmp,
-               pos - start);
-        /* copy the new string */
-        memcpy(((unsigned char *)(buf->buf)) + pos, with, len2);
-        /* calculate the next positions */
-        start_tmp = pos_tmp + len1;
-        start = pos + len2;
-        spos = strstr(tmp_buf + start_tmp, str);
-        /* this calculations don't make sense if spos == NULL, but the
-         * calculated values won't be used, because the loop will stop
-         * then */
-        pos_tmp = spos - tmp_buf;
-        pos = start + pos_tmp - start_tmp;
+        /* copy the untouched text and the new string */
+        memcpy(dst, src, spos - src);
+        dst += spos - src;
+        memcpy(dst, with, len2);
+        dst += len2;
+        src = spos + len1;
      }
    /* and now copy the rest of the text */
-   memcpy(((unsigned char *)(buf->buf)) + start, tmp_buf + start_tmp,
-          len - start);
+   memcpy(dst, src, tmp_buf + buf->len - src);
    buf->len = len;
    memset(((unsigned char *)(buf->buf)) + buf->len, 0, 1);
-   free(tmp_buf);
+   if (!ro) free((void *)tmp_buf);
    return n;
 }
@@ -2,6 +2,7 @@
 # include "config.h"
 #endif
 
+#include <limits.h>
 #include <unistd.h>
 #include "Eina.h"
 #include "eina_thread_queue.h"
@@ -34,9 +35,11 @@
 #endif
 
 typedef struct _Eina_Thread_Queue_Msg_Block Eina_Thread_Queue_Msg_Block;
+typedef struct _Eina_Thread_Queue_Ring Eina_Thread_Queue_Ring;
 
 struct _Eina_Thread_Queue
 {
+   Eina_Thread_Queue_Ring       *ring; // single producer/consumer ring if set
    Eina_Thread_Queue_Msg_Block  *data; // all the data being written to
    Eina_Thread_Queue_Msg_Block  *last; // the last block where new data goes
    Eina_Thread_Queue_Msg_Block  *read; // block when reading starts from data
@@ -67,6 +70,32 @@ struct _Eina_Thread_Queue_Msg_Block
    Eina_Thread_Queue_Msg         data[1]; // data in memory beyond struct end
 };
 
+#ifdef ATOMIC
+// a lock-free ring for queues with exactly one writer and one reader. the
+// positions only ever grow and are masked to index into data[]. a message
+// that does not fit before the end of data[] is preceded by a skip marker
+// (a message header with a negative size) and written at the start instead
+# define RING_CACHELINE 64
+
+struct _Eina_Thread_Queue_Ring
+{
+   unsigned int                  head; // byte pos after the last sent msg
+   unsigned int                  reserve; // head once in flight sends are done
+   unsigned char                 _pad1[RING_CACHELINE - (2 * sizeof(unsigned int))];
+   unsigned int                  tail; // byte pos of the first unread msg
+   unsigned int                  read_end; // tail once in flight reads are done
+   unsigned char                 _pad2[RING_CACHELINE - (2 * sizeof(unsigned int))];
+   int                           space_wait; // the writer waits for room
+   Eina_Semaphore                space_sem; // signalling room to the writer
+   unsigned int                  mask; // size of data[] - 1
+   char                         *data; // the ring memory itself
+};
+
+// the default and minimum ring sizes
+# define RING_SIZE_DEFAULT (64 * 1024)
+# define RING_SIZE_MIN     4096
+#endif
+
 // the minimum size of any message block holding 1 or more messages
 #define MIN_SIZE ((int)(4096 - sizeof(Eina_Thread_Queue_Msg_Block) + sizeof(Eina_Thread_Queue_Msg)))
 
@@ -172,6 +201,21 @@ _eina_thread_queue_wake(Eina_Thread_Queue *thq)
      ERR("Thread queue semaphore release/wakeup faile - bad things will happen");
 }
 
+// take one more message count off the semaphore only if it is available
+// right now - batch reads use this so they never take a message that
+// another reader already has the count for
+static Eina_Bool
+_eina_thread_queue_wait_try(Eina_Thread_Queue *thq)
+{
+#if defined(EINA_HAVE_OSX_SEMAPHORE)
+   mach_timespec_t ts = { 0, 0 };
+
+   return semaphore_timedwait(thq->sem, ts) == KERN_SUCCESS;
+#else
+   return sem_trywait(&(thq->sem)) == 0;
+#endif
+}
+
 // how to allocate or release memory within one of the message blocks for
 // an arbitrary sized bit of message data. the size always includes the
 // message header which tells you the size of that message
@@ -243,12 +287,34 @@ _eina_thread_queue_msg_alloc_done(Eina_Thread_Queue_Msg_Block *blk)
    if (ref == 0) eina_lock_release(&(blk->lock_non_0_ref));
 }
 
+// consume the next message of the block being read - the caller must hold
+// the read lock and the block must be thq->read
+static Eina_Thread_Queue_Msg *
+_eina_thread_queue_msg_next(Eina_Thread_Queue *thq, Eina_Thread_Queue_Msg_Block *blk)
+{
+   Eina_Thread_Queue_Msg *msg;
+   int first;
+
+#ifdef ATOMIC
+   __atomic_load(&blk->first, &first, __ATOMIC_RELAXED);
+   msg = (Eina_Thread_Queue_Msg *)((char *)(&(blk->data[0])) + first);
+   first = __atomic_add_fetch(&(blk->first), msg->size, __ATOMIC_RELAXED);
+#else
+   eina_spinlock_take(&blk->lock_first);
+   msg = (Eina_Thread_Queue_Msg *)((char *)(&(blk->data[0])) + blk->first);
+   first = blk->first += msg->size;
+   eina_spinlock_release(&blk->lock_first);
+#endif
+   if (first >= blk->last) thq->read = NULL;
+   return msg;
+}
+
 static Eina_Thread_Queue_Msg *
 _eina_thread_queue_msg_fetch(Eina_Thread_Queue *thq, Eina_Thread_Queue_Msg_Block **blkret)
 {
    Eina_Thread_Queue_Msg_Block *blk;
    Eina_Thread_Queue_Msg *msg;
-   int ref, first;
+   int ref;
 
    if (!thq->read)
      {
@@ -275,17 +341,7 @@ _eina_thread_queue_msg_fetch(Eina_Thread_Queue *thq, Eina_Thread_Queue_Msg_Block
         RWLOCK_UNLOCK(&(thq->lock_write));
      }
    blk = thq->read;
-#ifdef ATOMIC
-   __atomic_load(&blk->first, &first, __ATOMIC_RELAXED);
-   msg = (Eina_Thread_Queue_Msg *)((char *)(&(blk->data[0])) + first);
-   first = __atomic_add_fetch(&(blk->first), msg->size, __ATOMIC_RELAXED);
-#else
-   eina_spinlock_take(&blk->lock_first);
-   msg = (Eina_Thread_Queue_Msg *)((char *)(&(blk->data[0])) + blk->first);
-   first = blk->first += msg->size;
-   eina_spinlock_release(&blk->lock_first);
-#endif
-   if (first >= blk->last) thq->read = NULL;
+   msg = _eina_thread_queue_msg_next(thq, blk);
    *blkret = blk;
 #ifdef ATOMIC
    __atomic_add_fetch(&(blk->ref), 1, __ATOMIC_RELAXED);
@@ -318,6 +374,232 @@ _eina_thread_queue_msg_fetch_done(Eina_Thread_Queue_Msg_Block *blk)
      _eina_thread_queue_msg_block_free(blk);
 }
 
+// fetch a first message and then as many of the following messages in the
+// same block as we can take a count for without blocking, up to max. they
+// are all covered by the single block reference taken by the first fetch
+static Eina_Thread_Queue_Msg *
+_eina_thread_queue_msg_fetch_many(Eina_Thread_Queue *thq, int max, int *count, Eina_Thread_Queue_Msg_Block **blkret)
+{
+   Eina_Thread_Queue_Msg_Block *blk;
+   Eina_Thread_Queue_Msg *msg;
+   int n = 1;
+
+   msg = _eina_thread_queue_msg_fetch(thq, &blk);
+   if (!msg)
+     {
+        *count = 0;
+        return NULL;
+     }
+   while ((n < max) && (thq->read == blk) && _eina_thread_queue_wait_try(thq))
+     {
+        _eina_thread_queue_msg_next(thq, blk);
+        n++;
+     }
+   *count = n;
+   *blkret = blk;
+   return msg;
+}
+
+#ifdef ATOMIC
+// the ring positions are the only state shared between the two sides
+static inline unsigned int
+_eina_thread_queue_ring_pos_get(unsigned int *pos)
+{
+   return __atomic_load_n(pos, __ATOMIC_SEQ_CST);
+}
+
+static inline void
+_eina_thread_queue_ring_pos_set(unsigned int *pos, unsigned int val)
+{
+   __atomic_store_n(pos, val, __ATOMIC_SEQ_CST);
+}
+
+static Eina_Thread_Queue_Ring *
+_eina_thread_queue_ring_new(int size)
+{
+   Eina_Thread_Queue_Ring *ring;
+   unsigned int cap = RING_SIZE_MIN;
+
+   if (size <= 0) size = RING_SIZE_DEFAULT;
+   while ((cap < (unsigned int)size) && (cap < (1U << 30))) cap <<= 1;
+
+   ring = calloc(1, sizeof(Eina_Thread_Queue_Ring));
+   if (!ring) return NULL;
+   ring->data = malloc(cap);
+   if (!ring->data) goto on_error;
+   if (!eina_semaphore_new(&(ring->space_sem), 0)) goto on_error;
+   ring->mask = cap - 1;
+   return ring;
+
+on_error:
+   free(ring->data);
+   free(ring);
+   return NULL;
+}
+
+static void
+_eina_thread_queue_ring_free(Eina_Thread_Queue_Ring *ring)
+{
+   eina_semaphore_free(&(ring->space_sem));
+   free(ring->data);
+   free(ring);
+}
+
+// block the writer until the reader has released at least need bytes
+static void
+_eina_thread_queue_ring_space_wait(Eina_Thread_Queue_Ring *ring, unsigned int need)
+{
+   __atomic_store_n(&(ring->space_wait), 1, __ATOMIC_SEQ_CST);
+   if (((ring->mask + 1) - (ring->head - _eina_thread_queue_ring_pos_get(&(ring->tail)))) < need)
+     {
+        if (!eina_semaphore_lock(&(ring->space_sem)))
+          ERR("Thread queue ring semaphore lock/wait failed - bad things will happen");
+     }
+   // the reader got in between and has already signalled us, so eat it
+   else if (!__atomic_exchange_n(&(ring->space_wait), 0, __ATOMIC_SEQ_CST))
+     {
+        if (!eina_semaphore_lock(&(ring->space_sem)))
+          ERR("Thread queue ring semaphore lock/wait failed - bad things will happen");
+     }
+}
+
+static Eina_Thread_Queue_Msg *
+_eina_thread_queue_ring_alloc(Eina_Thread_Queue_Ring *ring, int size)
+{
+   Eina_Thread_Queue_Msg *msg;
+   unsigned int head = ring->head, pos, skip = 0, need;
+
+   // round up to nearest 8 as in blocks
+   size = ((size + 7) >> 3) << 3;
+   // anything bigger may never find a contiguous spot in the ring
+   if ((unsigned int)size > ((ring->mask + 1) / 2))
+     {
+        ERR("Thread queue ring message of size %i too big for ring of %u",
+            size, ring->mask + 1);
+        return NULL;
+     }
+   pos = head & ring->mask;
+   if (((ring->mask + 1) - pos) < (unsigned int)size)
+     skip = (ring->mask + 1) - pos;
+   need = skip + size;
+   while (((ring->mask + 1) - (head - _eina_thread_queue_ring_pos_get(&(ring->tail)))) < need)
+     _eina_thread_queue_ring_space_wait(ring, need);
+   if (skip)
+     {
+        msg = (Eina_Thread_Queue_Msg *)(ring->data + pos);
+        msg->size = -(int)skip;
+        pos = 0;
+     }
+   msg = (Eina_Thread_Queue_Msg *)(ring->data + pos);
+   msg->size = size;
+   ring->reserve = head + need;
+   return msg;
+}
+
+static void
+_eina_thread_queue_ring_alloc_done(Eina_Thread_Queue_Ring *ring)
+{
+   _eina_thread_queue_ring_pos_set(&(ring->head), ring->reserve);
+}
+
+// fetch the first unread message and as many following contiguous ones as
+// we can take a count for without blocking, up to max
+static Eina_Thread_Queue_Msg *
+_eina_thread_queue_ring_fetch(Eina_Thread_Queue *thq, int max, int *count)
+{
+   Eina_Thread_Queue_Ring *ring = thq->ring;
+   Eina_Thread_Queue_Msg *msg, *next;
+   unsigned int head, tail = ring->tail, end;
+   int n = 1;
+
+   *count = 0;
+   head = _eina_thread_queue_ring_pos_get(&(ring->head));
+   if (tail == head) return NULL;
+   msg = (Eina_Thread_Queue_Msg *)(ring->data + (tail & ring->mask));
+   if (msg->size < 0)
+     {
+        tail += -msg->size;
+        if (tail == head) return NULL;
+        msg = (Eina_Thread_Queue_Msg *)(ring->data + (tail & ring->mask));
+     }
+   end = tail + msg->size;
+   while ((n < max) && (end != head) && ((end & ring->mask) != 0))
+     {
+        next = (Eina_Thread_Queue_Msg *)(ring->data + (end & ring->mask));
+        if (next->size < 0) break;
+        if (!_eina_thread_queue_wait_try(thq)) break;
+        end += next->size;
+        n++;
+     }
+   ring->read_end = end;
+   *count = n;
+   return msg;
+}
+
+static void
+_eina_thread_queue_ring_fetch_done(Eina_Thread_Queue_Ring *ring)
+{
+   _eina_thread_queue_ring_pos_set(&(ring->tail), ring->read_end);
+   if (__atomic_exchange_n(&(ring->space_wait), 0, __ATOMIC_SEQ_CST))
+     eina_semaphore_release(&(ring->space_sem), 1);
+}
+#endif
+
+static inline void
+_eina_thread_queue_pending_add(Eina_Thread_Queue *thq, int count)
+{
+#ifdef ATOMIC
+   __atomic_add_fetch(&(thq->pending), count, __ATOMIC_RELAXED);
+#else
+   eina_spinlock_take(&(thq->lock_pending));
+   thq->pending += count;
+   eina_spinlock_release(&(thq->lock_pending));
+#endif
+}
+
+// wake up readers, parent queues and fd listeners for count new messages
+static void
+_eina_thread_queue_send_notify(Eina_Thread_Queue *thq, int count)
+{
+   int i;
+
+   for (i = 0; i < count; i++) _eina_thread_queue_wake(thq);
+   if (thq->parent)
+     {
+        void *ref;
+        Eina_Thread_Queue_Msg_Sub *msg;
+
+        msg = eina_thread_queue_send_many(thq->parent,
+                                          sizeof(Eina_Thread_Queue_Msg_Sub),
+                                          count, &ref);
+        if (msg)
+          {
+             for (i = 0; i < count; i++)
+               {
+                  msg->queue = thq;
+                  msg = eina_thread_queue_msg_next(msg);
+               }
+             eina_thread_queue_send_many_done(thq->parent, count, ref);
+          }
+     }
+   if (thq->fd >= 0)
+     {
+        char dummy[64] = { 0 };
+
+        while (count > 0)
+          {
+             int len = MIN(count, (int)sizeof(dummy));
+
+             if (write(thq->fd, dummy, len) != len)
+               {
+                  ERR("Eina Threadqueue write to fd %i failed", thq->fd);
+                  break;
+               }
+             count -= len;
+          }
+     }
+}
+
 
 //////////////////////////////////////////////////////////////////////////////
 Eina_Bool
@@ -374,11 +656,36 @@ eina_thread_queue_new(void)
    return thq;
 }
 
+EAPI Eina_Thread_Queue *
+eina_thread_queue_spsc_new(int size)
+{
+   Eina_Thread_Queue *thq;
+
+   thq = eina_thread_queue_new();
+   if (!thq) return NULL;
+#ifdef ATOMIC
+   thq->ring = _eina_thread_queue_ring_new(size);
+   if (!thq->ring)
+     {
+        ERR("Allocation of Thread queue ring of size %i failed", size);
+        eina_thread_queue_free(thq);
+        return NULL;
+     }
+#else
+   // without atomics a regular queue is the best we can do
+   (void)size;
+#endif
+   return thq;
+}
+
 EAPI void
 eina_thread_queue_free(Eina_Thread_Queue *thq)
 {
    if (!thq) return;
 
+#ifdef ATOMIC
+   if (thq->ring) _eina_thread_queue_ring_free(thq->ring);
+#endif
 #ifndef ATOMIC
    eina_spinlock_free(&(thq->lock_pending));
 #endif
@@ -391,96 +698,140 @@ eina_thread_queue_free(Eina_Thread_Queue *thq)
 EAPI void *
 eina_thread_queue_send(Eina_Thread_Queue *thq, int size, void **allocref)
 {
-   Eina_Thread_Queue_Msg *msg;
+   return eina_thread_queue_send_many(thq, size, 1, allocref);
+}
+
+EAPI void
+eina_thread_queue_send_done(Eina_Thread_Queue *thq, void *allocref)
+{
+   eina_thread_queue_send_many_done(thq, 1, allocref);
+}
+
+EAPI void *
+eina_thread_queue_send_many(Eina_Thread_Queue *thq, int size, int count, void **allocref)
+{
+   Eina_Thread_Queue_Msg *msg, *m;
    Eina_Thread_Queue_Msg_Block *blk;
+   int stride, total, i;
 
-   RWLOCK_LOCK(&(thq->lock_write));
-   msg = _eina_thread_queue_msg_alloc(thq, size, &blk);
-   RWLOCK_UNLOCK(&(thq->lock_write));
-   *allocref = blk;
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(size < (int)sizeof(Eina_Thread_Queue_Msg), NULL);
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(count < 1, NULL);
+
+   // all messages of the batch are laid out one after the other and reserved
+   // as one big message, then split into count messages of the same size
+   stride = ((size + 7) >> 3) << 3;
+   EINA_SAFETY_ON_TRUE_RETURN_VAL(count > (INT_MAX / stride), NULL);
 #ifdef ATOMIC
-  __atomic_add_fetch(&(thq->pending), 1, __ATOMIC_RELAXED);
-#else
-   eina_spinlock_take(&(thq->lock_pending));
-   thq->pending++;
-   eina_spinlock_release(&(thq->lock_pending));
+   if (thq->ring)
+     {
+        msg = _eina_thread_queue_ring_alloc(thq->ring, stride * count);
+        if (!msg) return NULL;
+        *allocref = thq->ring;
+     }
+   else
 #endif
+     {
+        RWLOCK_LOCK(&(thq->lock_write));
+        msg = _eina_thread_queue_msg_alloc(thq, stride * count, &blk);
+        RWLOCK_UNLOCK(&(thq->lock_write));
+        *allocref = blk;
+     }
+   // the allocation may have been grown to fill a block, so the last
+   // message of the batch keeps whatever is left
+   total = msg->size;
+   for (i = 0, m = msg; i < (count - 1); i++)
+     {
+        m->size = stride;
+        m = (Eina_Thread_Queue_Msg *)((char *)m + stride);
+     }
+   m->size = total - (stride * (count - 1));
+   _eina_thread_queue_pending_add(thq, count);
    return msg;
 }
 
 EAPI void
-eina_thread_queue_send_done(Eina_Thread_Queue *thq, void *allocref)
+eina_thread_queue_send_many_done(Eina_Thread_Queue *thq, int count, void *allocref)
 {
-   _eina_thread_queue_msg_alloc_done(allocref);
-   _eina_thread_queue_wake(thq);
-   if (thq->parent)
-     {
-        void *ref;
-        Eina_Thread_Queue_Msg_Sub *msg;
+#ifdef ATOMIC
+   if (thq->ring) _eina_thread_queue_ring_alloc_done(allocref);
+   else
+#endif
+     _eina_thread_queue_msg_alloc_done(allocref);
+   _eina_thread_queue_send_notify(thq, count);
+}
 
-        msg = eina_thread_queue_send(thq->parent,
-                                     sizeof(Eina_Thread_Queue_Msg_Sub), &ref);
-        if (msg)
-          {
-             msg->queue = thq;
-             eina_thread_queue_send_done(thq->parent, ref);
-          }
-     }
-   if (thq->fd >= 0)
+static void *
+_eina_thread_queue_fetch_many(Eina_Thread_Queue *thq, int max, int *count, void **allocref)
+{
+   Eina_Thread_Queue_Msg *msg;
+   Eina_Thread_Queue_Msg_Block *blk = NULL;
+
+#ifdef ATOMIC
+   if (thq->ring)
      {
-        char dummy = 0;
-        if (write(thq->fd, &dummy, 1) != 1)
-          ERR("Eina Threadqueue write to fd %i failed", thq->fd);
+        msg = _eina_thread_queue_ring_fetch(thq, max, count);
+        *allocref = thq->ring;
+        return msg;
      }
+#endif
+   RWLOCK_LOCK(&(thq->lock_read));
+   msg = _eina_thread_queue_msg_fetch_many(thq, max, count, &blk);
+   RWLOCK_UNLOCK(&(thq->lock_read));
+   *allocref = blk;
+   return msg;
 }
 
 EAPI void *
 eina_thread_queue_wait(Eina_Thread_Queue *thq, void **allocref)
+{
+   int count = 1;
+
+   return eina_thread_queue_wait_many(thq, &count, allocref);
+}
+
+EAPI void *
+eina_thread_queue_wait_many(Eina_Thread_Queue *thq, int *count, void **allocref)
 {
    Eina_Thread_Queue_Msg *msg;
-   Eina_Thread_Queue_Msg_Block *blk;
+   int max = (*count > 0) ? *count : INT_MAX;
 
    _eina_thread_queue_wait(thq);
-   RWLOCK_LOCK(&(thq->lock_read));
-   msg = _eina_thread_queue_msg_fetch(thq, &blk);
-   RWLOCK_UNLOCK(&(thq->lock_read));
-   *allocref = blk;
-#ifdef ATOMIC
-  __atomic_sub_fetch(&(thq->pending), 1, __ATOMIC_RELAXED);
-#else
-   eina_spinlock_take(&(thq->lock_pending));
-   thq->pending--;
-   eina_spinlock_release(&(thq->lock_pending));
-#endif
+   msg = _eina_thread_queue_fetch_many(thq, max, count, allocref);
+   _eina_thread_queue_pending_add(thq, -(*count));
    return msg;
 }
 
 EAPI void
-eina_thread_queue_wait_done(Eina_Thread_Queue *thq EINA_UNUSED, void *allocref)
+eina_thread_queue_wait_done(Eina_Thread_Queue *thq, void *allocref)
 {
-   _eina_thread_queue_msg_fetch_done(allocref);
+#ifdef ATOMIC
+   if (thq->ring) _eina_thread_queue_ring_fetch_done(allocref);
+   else
+#else
+   (void) thq;
+#endif
+     _eina_thread_queue_msg_fetch_done(allocref);
 }
 
 EAPI void *
 eina_thread_queue_poll(Eina_Thread_Queue *thq, void **allocref)
+{
+   int count = 1;
+
+   return eina_thread_queue_poll_many(thq, &count, allocref);
+}
+
+EAPI void *
+eina_thread_queue_poll_many(Eina_Thread_Queue *thq, int *count, void **allocref)
 {
    Eina_Thread_Queue_Msg *msg;
-   Eina_Thread_Queue_Msg_Block *blk;
+   int max = (*count > 0) ? *count : INT_MAX;
 
-   RWLOCK_LOCK(&(thq->lock_read));
-   msg = _eina_thread_queue_msg_fetch(thq, &blk);
-   RWLOCK_UNLOCK(&(thq->lock_read));
+   msg = _eina_thread_queue_fetch_many(thq, max, count, allocref);
    if (msg)
      {
         _eina_thread_queue_wait(thq);
-        *allocref = blk;
-#ifdef ATOMIC
-        __atomic_sub_fetch(&(thq->pending), 1, __ATOMIC_RELAXED);
-#else
-        eina_spinlock_take(&(thq->lock_pending));
-        thq->pending--;
-        eina_spinlock_release(&(thq->lock_pending));
-#endif
+        _eina_thread_queue_pending_add(thq, -(*count));
      }
    return msg;
 }
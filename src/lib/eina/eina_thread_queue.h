@@ -76,6 +76,28 @@ struct _Eina_Thread_Queue_Msg_Sub
 EAPI Eina_Thread_Queue *
 eina_thread_queue_new(void);
 
+/**
+ * @brief Creates a new thread queue for exactly one writer and one reader.
+ *
+ * @param[in] size The size in bytes of the ring holding messages, or 0 for
+ * the default of 64KiB. It is rounded up to a power of 2.
+ * @return A valid new thread queue, or NULL on failure
+ *
+ * This creates a thread queue that is used exactly like one created with
+ * eina_thread_queue_new(), but which stores its messages in a fixed size
+ * ring that the writer and the reader access without taking any lock. Only
+ * one thread may ever send messages to it and only one thread may ever
+ * fetch messages from it, and each of them must finish a send or a fetch
+ * before starting the next one. A send blocks while the ring is full until
+ * the reader has finished with enough messages, and a single send (or batch
+ * of messages sent with eina_thread_queue_send_many()) can be at most half
+ * of the ring size.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Thread_Queue *
+eina_thread_queue_spsc_new(int size);
+
 /**
  * @brief Frees a thread queue.
  *
@@ -123,6 +145,42 @@ eina_thread_queue_send(Eina_Thread_Queue *thq, int size, void **allocref) EINA_A
 EAPI void
 eina_thread_queue_send_done(Eina_Thread_Queue *thq, void *allocref) EINA_ARG_NONNULL(1, 2);
 
+/**
+ * @brief Allocates several messages to send down a thread queue at once.
+ *
+ * @param[in,out] thq The thread queue to allocate the messages on
+ * @param[in] size The size, in bytes, of each message, including standard header
+ * @param[in] count The number of messages to allocate
+ * @param[out] allocref A pointer to store a general reference handle for the messages
+ * @return A pointer to the first message to fill in, or NULL on failure
+ *
+ * This is the same as eina_thread_queue_send(), but reserves @p count
+ * messages of @p size bytes with a single lock round trip. The messages
+ * directly follow each other in memory, so once the first one is filled in,
+ * eina_thread_queue_msg_next() gives the next one. They are all sent at once
+ * with eina_thread_queue_send_many_done(), and the reader gets them as
+ * @p count separate messages in the same order.
+ *
+ * @since 1.22
+ */
+EAPI void *
+eina_thread_queue_send_many(Eina_Thread_Queue *thq, int size, int count, void **allocref) EINA_ARG_NONNULL(1, 4);
+
+/**
+ * @brief Finishes sending messages allocated with eina_thread_queue_send_many().
+ *
+ * @param[in,out] thq The thread queue the messages were placed on
+ * @param[in] count The number of messages, as given to eina_thread_queue_send_many()
+ * @param[in,out] allocref The allocref returned by eina_thread_queue_send_many()
+ *
+ * This completes the send of all messages and wakes up listeners, as
+ * eina_thread_queue_send_done() would have done for each of them.
+ *
+ * @since 1.22
+ */
+EAPI void
+eina_thread_queue_send_many_done(Eina_Thread_Queue *thq, int count, void *allocref) EINA_ARG_NONNULL(1, 3);
+
 /**
  * @brief Fetches a message from a thread queue.
  *
@@ -149,8 +207,10 @@ eina_thread_queue_wait(Eina_Thread_Queue *thq, void **allocref) EINA_ARG_NONNULL
  * @param[in,out] thq The thread queue the message was fetched from
  * @param[in,out] allocref The allocref returned by eina_thread_queue_wait()
  *
- * This should be used after eina_thread_queue_wait() or
- * eina_thread_queue_poll() to indicate the caller is done with the message.
+ * This should be used after eina_thread_queue_wait(),
+ * eina_thread_queue_poll(), eina_thread_queue_wait_many() or
+ * eina_thread_queue_poll_many() to indicate the caller is done with the
+ * message(s).
  *
  * @since 1.11
  */
@@ -175,6 +235,62 @@ eina_thread_queue_wait_done(Eina_Thread_Queue *thq, void *allocref) EINA_ARG_NON
 EAPI void *
 eina_thread_queue_poll(Eina_Thread_Queue *thq, void **allocref) EINA_ARG_NONNULL(1, 2);
 
+/**
+ * @brief Fetches all the messages available in one go from a thread queue.
+ *
+ * @param[in,out] thq The thread queue to fetch the messages from
+ * @param[in,out] count On input the maximum number of messages to fetch, or
+ * 0 for no limit. On output the number of messages fetched.
+ * @param[out] allocref A pointer to store a general reference handle for the messages
+ * @return A pointer to the first message fetched
+ *
+ * This waits like eina_thread_queue_wait() for a message to arrive and then
+ * also fetches all the messages already sent that directly follow it in
+ * memory, so a whole batch is drained with a single lock round trip. Walk
+ * the messages with eina_thread_queue_msg_next() and call
+ * eina_thread_queue_wait_done() once when finished with all of them.
+ *
+ * @since 1.22
+ */
+EAPI void *
+eina_thread_queue_wait_many(Eina_Thread_Queue *thq, int *count, void **allocref) EINA_ARG_NONNULL(1, 2, 3);
+
+/**
+ * @brief Fetches all the messages available in one go without waiting.
+ *
+ * @param[in,out] thq The thread queue to fetch the messages from
+ * @param[in,out] count On input the maximum number of messages to fetch, or
+ * 0 for no limit. On output the number of messages fetched.
+ * @param[out] allocref A pointer to store a general reference handle for the messages
+ * @return A pointer to the first message fetched, or NULL if there is none
+ *
+ * This is the same as eina_thread_queue_wait_many(), but returns NULL
+ * immediately if no message is available.
+ *
+ * @see eina_thread_queue_wait_many()
+ *
+ * @since 1.22
+ */
+EAPI void *
+eina_thread_queue_poll_many(Eina_Thread_Queue *thq, int *count, void **allocref) EINA_ARG_NONNULL(1, 2, 3);
+
+/**
+ * @brief Gets the message following another one in a batch.
+ *
+ * @param[in] msg A message returned by eina_thread_queue_send_many(),
+ * eina_thread_queue_wait_many() or eina_thread_queue_poll_many()
+ * @return The next message of the batch
+ *
+ * This must not be called on the last message of a batch.
+ *
+ * @since 1.22
+ */
+static inline void *
+eina_thread_queue_msg_next(const void *msg)
+{
+   return (char *)msg + ((const Eina_Thread_Queue_Msg *)msg)->size;
+}
+
 /**
  * @brief Gets the number of messages on a queue as yet unfetched.
  *
@@ -29,11 +29,13 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "eina_config.h"
 #include "eina_private.h"
 #include "eina_tiler.h"
 #include "eina_cpu.h"
+#include "eina_simd.h"
 
 /*============================================================================*
 *                                  Local                                     *
@@ -92,11 +94,31 @@ static const list_t list_zeroed = { NULL, NULL };
 static list_node_pool_t list_node_pool = { NULL, 0, 1024 };
 
 
+/* The bitmask data types */
+typedef struct bitmask_span
+{
+   int c0, c1; /* columns of a run of tiles, c1 excluded */
+   int row; /* first row of the rectangle the run belongs to */
+} bitmask_span_t;
+
+typedef struct bitmask
+{
+   uint64_t *bits; /* rows of stride words, a bit per tile */
+   Eina_Rectangle *rects; /* the merged rectangles, valid unless dirty */
+   bitmask_span_t *spans[2]; /* scratch for the merge, cols / 2 + 1 each */
+   unsigned int rects_count;
+   unsigned int rects_size;
+   unsigned int gap;
+   int cols, rows, stride;
+   Eina_Bool dirty : 1;
+} bitmask_t;
+
 typedef struct _Eina_Iterator_Tiler
 {
    Eina_Iterator iterator;
    const Eina_Tiler *tiler;
    list_node_t *curr;
+   unsigned int idx;
    Eina_Rectangle r;
    EINA_MAGIC
 } Eina_Iterator_Tiler;
@@ -115,7 +137,9 @@ struct _Eina_Tiler
    Eina_Rectangle area;
    EINA_MAGIC
    splitter_t splitter;
+   bitmask_t bitmask;
 
+   Eina_Tiler_Mode mode;
    Eina_Bool rounding : 1;
    Eina_Bool strict : 1;
 };
@@ -1079,10 +1103,287 @@ static inline void _splitter_clear(Eina_Tiler *t)
 }
 /* end of splitter algorithm */
 
+/*
+ * The bitmask algorithm: a bit per tile, rows of 64 bits words. Adding and
+ * removing a rectangle sets or clears a range of bits per row it covers,
+ * combining two tilers is a bitwise operation over the whole masks, done
+ * with the vector unit. The rectangles are only built when iterating: the
+ * runs of each row are matched against the rectangles still open from the
+ * row above, identical runs extend them, the others close or open one.
+ */
+static void _bitmask_del(Eina_Tiler *t)
+{
+   free(t->bitmask.bits);
+   free(t->bitmask.rects);
+   free(t->bitmask.spans[0]);
+   free(t->bitmask.spans[1]);
+   t->bitmask.bits = NULL;
+   t->bitmask.rects = NULL;
+   t->bitmask.spans[0] = t->bitmask.spans[1] = NULL;
+   t->bitmask.rects_count = t->bitmask.rects_size = 0;
+   t->bitmask.cols = t->bitmask.rows = t->bitmask.stride = 0;
+}
+
+/* builds the masks for the area and tile size, keeping the tiles of the
+ * old masks when only the area changes */
+static Eina_Bool _bitmask_setup(Eina_Tiler *t, Eina_Bool keep)
+{
+   bitmask_t *bm = &t->bitmask;
+   bitmask_t old = *bm;
+   int cols, rows, stride, y;
+
+   cols = (t->area.w + t->tile.w - 1) / t->tile.w;
+   rows = (t->area.h + t->tile.h - 1) / t->tile.h;
+   stride = (cols + 63) / 64;
+
+   bm->bits = calloc((size_t)rows * stride, sizeof(uint64_t));
+   bm->spans[0] = malloc((cols / 2 + 1) * sizeof(bitmask_span_t));
+   bm->spans[1] = malloc((cols / 2 + 1) * sizeof(bitmask_span_t));
+   if ((!bm->bits) || (!bm->spans[0]) || (!bm->spans[1]))
+     {
+        free(bm->bits);
+        free(bm->spans[0]);
+        free(bm->spans[1]);
+        *bm = old;
+        return EINA_FALSE;
+     }
+   bm->rects = old.rects;
+   bm->rects_size = old.rects_size;
+   bm->rects_count = 0;
+   bm->cols = cols;
+   bm->rows = rows;
+   bm->stride = stride;
+   bm->dirty = EINA_TRUE;
+
+   if ((keep) && (old.bits))
+     {
+        int words = MIN(stride, old.stride);
+
+        for (y = 0; y < MIN(rows, old.rows); y++)
+          {
+             uint64_t *row = bm->bits + (size_t)y * stride;
+
+             memcpy(row, old.bits + (size_t)y * old.stride,
+                    words * sizeof(uint64_t));
+             // drop the columns out of the new area
+             if ((cols < old.cols) && (cols & 63))
+               row[words - 1] &= (1ULL << (cols & 63)) - 1;
+          }
+     }
+   free(old.bits);
+   free(old.spans[0]);
+   free(old.spans[1]);
+   return EINA_TRUE;
+}
+
+static inline void _bitmask_row_set(uint64_t *row, int c0, int c1, Eina_Bool set)
+{
+   int w0 = c0 >> 6, w1 = (c1 - 1) >> 6, w;
+   uint64_t m0 = ~0ULL << (c0 & 63);
+   uint64_t m1 = ~0ULL >> (63 - ((c1 - 1) & 63));
+
+   if (w0 == w1) m0 &= m1;
+   if (set) row[w0] |= m0;
+   else row[w0] &= ~m0;
+   if (w0 == w1) return;
+   for (w = w0 + 1; w < w1; w++)
+     row[w] = set ? ~0ULL : 0;
+   if (set) row[w1] |= m1;
+   else row[w1] &= ~m1;
+}
+
+/* r must be inside the area */
+static void _bitmask_rect_add(Eina_Tiler *t, const Eina_Rectangle *r)
+{
+   bitmask_t *bm = &t->bitmask;
+   int c0, c1, r0, r1, y;
+
+   if ((r->w <= 0) || (r->h <= 0)) return;
+   c0 = r->x / t->tile.w;
+   c1 = (r->x + r->w - 1) / t->tile.w + 1;
+   r0 = r->y / t->tile.h;
+   r1 = (r->y + r->h - 1) / t->tile.h + 1;
+   for (y = r0; y < r1; y++)
+     _bitmask_row_set(bm->bits + (size_t)y * bm->stride, c0, c1, EINA_TRUE);
+   bm->dirty = EINA_TRUE;
+}
+
+/* only clears the tiles fully covered, the last row and column are
+ * covered once r reaches the end of the area */
+static void _bitmask_rect_del(Eina_Tiler *t, const Eina_Rectangle *r)
+{
+   bitmask_t *bm = &t->bitmask;
+   int c0, c1, r0, r1, y;
+
+   c0 = (r->x + t->tile.w - 1) / t->tile.w;
+   r0 = (r->y + t->tile.h - 1) / t->tile.h;
+   c1 = (r->x + r->w >= t->area.w) ? bm->cols : (r->x + r->w) / t->tile.w;
+   r1 = (r->y + r->h >= t->area.h) ? bm->rows : (r->y + r->h) / t->tile.h;
+   if ((c0 >= c1) || (r0 >= r1)) return;
+   for (y = r0; y < r1; y++)
+     _bitmask_row_set(bm->bits + (size_t)y * bm->stride, c0, c1, EINA_FALSE);
+   bm->dirty = EINA_TRUE;
+}
+
+static Eina_Bool _bitmask_empty(const Eina_Tiler *t)
+{
+   const bitmask_t *bm = &t->bitmask;
+   size_t i, n = (size_t)bm->rows * bm->stride;
+
+   if (!bm->dirty) return !bm->rects_count;
+   for (i = 0; i < n; i++)
+     if (bm->bits[i]) return EINA_FALSE;
+   return EINA_TRUE;
+}
+
+static Eina_Bool _bitmask_compatible(const Eina_Tiler *t1, const Eina_Tiler *t2)
+{
+   return ((t1->mode == EINA_TILER_MODE_BITMASK) &&
+           (t2->mode == EINA_TILER_MODE_BITMASK) &&
+           (t1->tile.w == t2->tile.w) && (t1->tile.h == t2->tile.h) &&
+           (t1->area.w == t2->area.w) && (t1->area.h == t2->area.h));
+}
+
+/* the runs of set bits of a row, joined across at most gap clear bits */
+static int _bitmask_row_spans(const bitmask_t *bm, const uint64_t *row,
+                              bitmask_span_t *spans)
+{
+   int n = 0, c = 0, c0;
+   int w;
+   uint64_t bits;
+
+   for (;;)
+     {
+        // next set bit
+        w = c >> 6;
+        if (w >= bm->stride) break;
+        bits = row[w] & (~0ULL << (c & 63));
+        while (!bits)
+          {
+             if (++w >= bm->stride) return n;
+             bits = row[w];
+          }
+        c0 = (w << 6) + __builtin_ctzll(bits);
+        if (c0 >= bm->cols) break;
+
+        // next clear bit
+        bits = ~row[w] & (~0ULL << (c0 & 63));
+        while (!bits)
+          {
+             if (++w >= bm->stride) break;
+             bits = ~row[w];
+          }
+        c = (w < bm->stride) ? (w << 6) + __builtin_ctzll(bits) : bm->cols;
+        if (c > bm->cols) c = bm->cols;
+
+        if ((n) && (c0 - spans[n - 1].c1 <= (int)bm->gap))
+          spans[n - 1].c1 = c;
+        else
+          {
+             spans[n].c0 = c0;
+             spans[n].c1 = c;
+             n++;
+          }
+        if (c >= bm->cols) break;
+     }
+   return n;
+}
+
+static Eina_Bool _bitmask_rects_push(Eina_Tiler *t, const bitmask_span_t *sp, int row)
+{
+   bitmask_t *bm = &t->bitmask;
+   Eina_Rectangle *r;
+
+   if (bm->rects_count == bm->rects_size)
+     {
+        unsigned int size = bm->rects_size ? bm->rects_size * 2 : 32;
+
+        r = realloc(bm->rects, size * sizeof(Eina_Rectangle));
+        if (!r) return EINA_FALSE;
+        bm->rects = r;
+        bm->rects_size = size;
+     }
+   r = &(bm->rects[bm->rects_count++]);
+   r->x = sp->c0 * t->tile.w;
+   r->y = sp->row * t->tile.h;
+   r->w = MIN(sp->c1 * t->tile.w, t->area.w) - r->x;
+   r->h = MIN(row * t->tile.h, t->area.h) - r->y;
+   return EINA_TRUE;
+}
+
+static void _bitmask_merge(Eina_Tiler *t)
+{
+   bitmask_t *bm = &t->bitmask;
+   bitmask_span_t *open = bm->spans[0], *cur = bm->spans[1], *tmp;
+   int nopen = 0, ncur, y, i, j;
+
+   bm->rects_count = 0;
+   for (y = 0; y <= bm->rows; y++)
+     {
+        ncur = (y < bm->rows) ?
+          _bitmask_row_spans(bm, bm->bits + (size_t)y * bm->stride, cur) : 0;
+
+        // both lists are sorted and their runs don't overlap
+        for (i = 0, j = 0; i < nopen; i++)
+          {
+             while ((j < ncur) && (cur[j].c0 < open[i].c0))
+               cur[j++].row = y;
+             if ((j < ncur) && (cur[j].c0 == open[i].c0) &&
+                 (cur[j].c1 == open[i].c1))
+               cur[j++].row = open[i].row;
+             else
+               _bitmask_rects_push(t, &open[i], y);
+          }
+        for (; j < ncur; j++)
+          cur[j].row = y;
+
+        tmp = open;
+        open = cur;
+        cur = tmp;
+        nopen = ncur;
+     }
+   bm->dirty = EINA_FALSE;
+}
+
+/* the rectangles of t in another mode or geometry */
+static Eina_Rectangle *_tiler_rects_get(Eina_Tiler *t, unsigned int *count)
+{
+   Eina_Iterator *it;
+   Eina_Rectangle *rects = NULL, *r, *tmp;
+   unsigned int n = 0, size = 0;
+
+   *count = 0;
+   it = eina_tiler_iterator_new(t);
+   if (!it) return NULL;
+   EINA_ITERATOR_FOREACH(it, r)
+     {
+        if (n == size)
+          {
+             size = size ? size * 2 : 32;
+             tmp = realloc(rects, size * sizeof(Eina_Rectangle));
+             if (!tmp) break;
+             rects = tmp;
+          }
+        rects[n++] = *r;
+     }
+   eina_iterator_free(it);
+   *count = n;
+   return rects;
+}
+
 static Eina_Bool _iterator_next(Eina_Iterator_Tiler *it, void **data)
 {
    list_node_t *n;
 
+   if (it->tiler->mode == EINA_TILER_MODE_BITMASK)
+     {
+        if (it->idx >= it->tiler->bitmask.rects_count)
+          return EINA_FALSE;
+        it->r = it->tiler->bitmask.rects[it->idx++];
+        *(Eina_Rectangle **)data = &it->r;
+        return EINA_TRUE;
+     }
+
    for (n = it->curr; n; n = n->next)
      {
         rect_t cur;
@@ -1165,6 +1466,7 @@ EAPI void eina_tiler_free(Eina_Tiler *t)
 
    EINA_MAGIC_CHECK_TILER(t);
    _splitter_del(t);
+   _bitmask_del(t);
    free(t);
 }
 
@@ -1173,9 +1475,12 @@ EAPI void eina_tiler_area_size_set(Eina_Tiler *t, int w, int h)
    EINA_MAGIC_CHECK_TILER(t);
    if ((w <= 0) || (h <= 0))
      return;
+   if ((t->area.w == w) && (t->area.h == h)) return;
 
    t->area.w = w;
    t->area.h = h;
+   if (t->mode == EINA_TILER_MODE_BITMASK)
+     _bitmask_setup(t, EINA_TRUE);
 }
 
 EAPI void eina_tiler_area_size_get(const Eina_Tiler *t, int *w, int *h)
@@ -1196,12 +1501,71 @@ EAPI void eina_tiler_tile_size_set(Eina_Tiler *t, int w, int h)
    t->tile.w = w;
    t->tile.h = h;
    _splitter_tile_size_set(t, w, h);
+   if (t->mode == EINA_TILER_MODE_BITMASK)
+     _bitmask_setup(t, EINA_FALSE);
+}
+
+EAPI void
+eina_tiler_mode_set(Eina_Tiler *t, Eina_Tiler_Mode mode)
+{
+   Eina_Rectangle *rects;
+   unsigned int count, i;
+
+   EINA_MAGIC_CHECK_TILER(t);
+   if (t->mode == mode) return;
+   if ((mode != EINA_TILER_MODE_SPLIT) && (mode != EINA_TILER_MODE_BITMASK))
+     return;
+
+   rects = _tiler_rects_get(t, &count);
+   if (mode == EINA_TILER_MODE_BITMASK)
+     {
+        if (!_bitmask_setup(t, EINA_FALSE))
+          {
+             free(rects);
+             return;
+          }
+        _splitter_clear(t);
+        t->mode = mode;
+        for (i = 0; i < count; i++)
+          _bitmask_rect_add(t, &rects[i]);
+     }
+   else
+     {
+        _bitmask_del(t);
+        t->mode = mode;
+        for (i = 0; i < count; i++)
+          _splitter_rect_add(t, &rects[i]);
+     }
+   free(rects);
+
+   t->last.add.w = -1;
+   t->last.add.h = -1;
+   t->last.del.w = -1;
+   t->last.del.h = -1;
+}
+
+EAPI Eina_Tiler_Mode
+eina_tiler_mode_get(const Eina_Tiler *t)
+{
+   EINA_MAGIC_CHECK_TILER(t, EINA_TILER_MODE_SPLIT);
+   return t->mode;
+}
+
+EAPI void
+eina_tiler_merge_gap_set(Eina_Tiler *t, unsigned int gap)
+{
+   EINA_MAGIC_CHECK_TILER(t);
+   if (t->bitmask.gap == gap) return;
+   t->bitmask.gap = gap;
+   t->bitmask.dirty = EINA_TRUE;
 }
 
 EAPI Eina_Bool
 eina_tiler_empty(const Eina_Tiler *t)
 {
    EINA_MAGIC_CHECK_TILER(t, EINA_TRUE);
+   if (t->mode == EINA_TILER_MODE_BITMASK)
+     return _bitmask_empty(t);
    return ((!t->splitter.rects.head) && (!t->splitter.rects.tail));
 }
 
@@ -1242,6 +1606,11 @@ EAPI Eina_Bool eina_tiler_rect_add(Eina_Tiler *t, const Eina_Rectangle *r)
    t->last.add = tmp;
    t->last.del.w = t->last.del.h = -1;
 
+   if (t->mode == EINA_TILER_MODE_BITMASK)
+     {
+        _bitmask_rect_add(t, &tmp);
+        return EINA_TRUE;
+     }
    return _splitter_rect_add(t, &tmp);
 }
 
@@ -1268,13 +1637,23 @@ EAPI void eina_tiler_rect_del(Eina_Tiler *t, const Eina_Rectangle *r)
    t->last.del = tmp;
    t->last.add.w = t->last.add.h = -1;
 
-   _splitter_rect_del(t, &tmp);
+   if (t->mode == EINA_TILER_MODE_BITMASK)
+     _bitmask_rect_del(t, &tmp);
+   else
+     _splitter_rect_del(t, &tmp);
 }
 
 EAPI void eina_tiler_clear(Eina_Tiler *t)
 {
    EINA_MAGIC_CHECK_TILER(t);
    _splitter_clear(t);
+   if (t->bitmask.bits)
+     {
+        memset(t->bitmask.bits, 0, (size_t)t->bitmask.rows *
+               t->bitmask.stride * sizeof(uint64_t));
+        t->bitmask.rects_count = 0;
+        t->bitmask.dirty = EINA_FALSE;
+     }
    t->last.add.w = -1;
    t->last.add.h = -1;
    t->last.del.w = -1;
@@ -1302,6 +1681,18 @@ EAPI Eina_Iterator *eina_tiler_iterator_new(const Eina_Tiler *t)
 
    it->tiler = t;
 
+   if (t->mode == EINA_TILER_MODE_BITMASK)
+     {
+        if (t->bitmask.dirty)
+          _bitmask_merge((Eina_Tiler *)t);
+        if (!t->bitmask.rects_count)
+          {
+             free(it);
+             return NULL;
+          }
+        goto setup;
+     }
+
    if (t->splitter.need_merge == EINA_TRUE)
      {
         splitter_t *sp;
@@ -1351,6 +1742,7 @@ EAPI Eina_Iterator *eina_tiler_iterator_new(const Eina_Tiler *t)
         return NULL;
      }
 
+setup:
    it->iterator.version = EINA_ITERATOR_VERSION;
    it->iterator.next = FUNC_ITERATOR_NEXT(_iterator_next);
    it->iterator.get_container = FUNC_ITERATOR_GET_CONTAINER(
@@ -1379,8 +1771,19 @@ eina_tiler_union(Eina_Tiler *dst,
    if ((src->area.w <= 0) || (src->area.h <=0))
      return EINA_FALSE;
 
-   dst->area.w = MAX(src->area.w, dst->area.w);
-   dst->area.h = MAX(src->area.h, dst->area.h);
+   if (_bitmask_compatible(dst, src))
+     {
+        eina_simd_bits_op(dst->bitmask.bits, src->bitmask.bits,
+                          (size_t)dst->bitmask.rows * dst->bitmask.stride,
+                          EINA_SIMD_BITS_OR);
+        dst->bitmask.dirty = EINA_TRUE;
+        dst->last.add.w = dst->last.add.h = -1;
+        dst->last.del.w = dst->last.del.h = -1;
+        return EINA_TRUE;
+     }
+
+   eina_tiler_area_size_set(dst, MAX(src->area.w, dst->area.w),
+                            MAX(src->area.h, dst->area.h));
 
    itr = eina_tiler_iterator_new(src);
    if (!itr)
@@ -1389,12 +1792,15 @@ eina_tiler_union(Eina_Tiler *dst,
    EINA_ITERATOR_FOREACH(itr, rect)
      {
         _rect = *rect;
-        if (src->rounding)
+        if ((src->mode == EINA_TILER_MODE_SPLIT) && (src->rounding))
           {
              _rect.w -= 1;
              _rect.h -= 1;
           }
-        _splitter_rect_add(dst, &_rect);
+        if (dst->mode == EINA_TILER_MODE_BITMASK)
+          _bitmask_rect_add(dst, &_rect);
+        else
+          _splitter_rect_add(dst, &_rect);
      }
 
    if (rect)
@@ -1421,6 +1827,17 @@ eina_tiler_subtract(Eina_Tiler *dst,
    if ((src->area.w <= 0) || (src->area.h <= 0))
      return EINA_FALSE;
 
+   if (_bitmask_compatible(dst, src))
+     {
+        eina_simd_bits_op(dst->bitmask.bits, src->bitmask.bits,
+                          (size_t)dst->bitmask.rows * dst->bitmask.stride,
+                          EINA_SIMD_BITS_ANDNOT);
+        dst->bitmask.dirty = EINA_TRUE;
+        dst->last.add.w = dst->last.add.h = -1;
+        dst->last.del.w = dst->last.del.h = -1;
+        return EINA_TRUE;
+     }
+
    itr = eina_tiler_iterator_new(src);
    if (!itr)
      return EINA_FALSE;
@@ -1428,12 +1845,15 @@ eina_tiler_subtract(Eina_Tiler *dst,
    EINA_ITERATOR_FOREACH(itr, rect)
      {
         _rect = *rect;
-        if (src->rounding)
+        if ((src->mode == EINA_TILER_MODE_SPLIT) && (src->rounding))
           {
              _rect.w -= 1;
              _rect.h -= 1;
           }
-        _splitter_rect_del(dst, &_rect);
+        if (dst->mode == EINA_TILER_MODE_BITMASK)
+          _bitmask_rect_del(dst, &_rect);
+        else
+          _splitter_rect_del(dst, &_rect);
      }
 
    if (rect)
@@ -1460,6 +1880,28 @@ eina_tiler_intersection(Eina_Tiler *t1,
    if (!(eina_rectangles_intersect(&t1->area, &t2->area)))
      return NULL;
 
+   if (_bitmask_compatible(t1, t2))
+     {
+        t = eina_tiler_new(t1->area.w, t1->area.h);
+        if (!t) return NULL;
+        eina_tiler_tile_size_set(t, t1->tile.w, t1->tile.h);
+        eina_tiler_mode_set(t, EINA_TILER_MODE_BITMASK);
+        if ((t->mode != EINA_TILER_MODE_BITMASK) ||
+            (t->bitmask.stride != t1->bitmask.stride))
+          goto empty;
+        memcpy(t->bitmask.bits, t1->bitmask.bits, (size_t)t1->bitmask.rows *
+               t1->bitmask.stride * sizeof(uint64_t));
+        if (!eina_simd_bits_op(t->bitmask.bits, t2->bitmask.bits,
+                               (size_t)t->bitmask.rows * t->bitmask.stride,
+                               EINA_SIMD_BITS_AND))
+          goto empty;
+        t->bitmask.dirty = EINA_TRUE;
+        return t;
+empty:
+        eina_tiler_free(t);
+        return NULL;
+     }
+
    itr1 = eina_tiler_iterator_new(t1);
    itr2 = eina_tiler_iterator_new(t2);
 
@@ -1484,7 +1926,8 @@ eina_tiler_intersection(Eina_Tiler *t1,
              rect.w = MIN(rect1->x + rect1->w, rect2->x + rect2->w) - rect.x;
              rect.h = MIN(rect1->y + rect1->h, rect2->y + rect2->h) - rect.y;
 
-             if ((t1->rounding) || (t2->rounding))
+             if (((t1->mode == EINA_TILER_MODE_SPLIT) && (t1->rounding)) ||
+                 ((t2->mode == EINA_TILER_MODE_SPLIT) && (t2->rounding)))
                {
                   rect.w -= 1;
                   rect.h -= 1;
@@ -1542,6 +1985,16 @@ eina_tiler_equal(const Eina_Tiler *t1,
    if (!(eina_rectangles_intersect(&t1->area, &t2->area)))
      return EINA_FALSE;
 
+   if (_bitmask_compatible(t1, t2))
+     {
+        // as below, empty tilers are never equal
+        if ((_bitmask_empty(t1)) || (_bitmask_empty(t2)))
+          return EINA_FALSE;
+        return !memcmp(t1->bitmask.bits, t2->bitmask.bits,
+                       (size_t)t1->bitmask.rows * t1->bitmask.stride *
+                       sizeof(uint64_t));
+     }
+
    itr1 = eina_tiler_iterator_new(t1);
    itr2 = eina_tiler_iterator_new(t2);
 
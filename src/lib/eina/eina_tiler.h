@@ -174,6 +174,18 @@ struct Eina_Tile_Grid_Info
 
 typedef struct _Eina_Tile_Grid_Slicer Eina_Tile_Grid_Slicer;
 
+/**
+ * @typedef Eina_Tiler_Mode
+ * How a tiler keeps track of its rectangles.
+ *
+ * @since 1.22
+ */
+typedef enum
+{
+   EINA_TILER_MODE_SPLIT, /**< A list of rectangles, split and merged as they are added. The default. */
+   EINA_TILER_MODE_BITMASK /**< A bit per tile. Rectangles are rounded out to whole tiles and the merged rectangles are built from the rows of tiles. Adding, removing and combining rectangles no longer depends on how many there are already. */
+} Eina_Tiler_Mode;
+
 /**
  * @brief Creates a new tiler with @p w width and @p h height.
  *
@@ -244,6 +256,54 @@ EAPI void               eina_tiler_area_size_get(const Eina_Tiler *t, int *w, in
  */
 EAPI void               eina_tiler_strict_set(Eina_Tiler *t, Eina_Bool strict);
 
+/**
+ * @brief Sets how a tiler keeps track of its rectangles.
+ *
+ * @param[in,out] t The tiler.
+ * @param[in] mode The new mode.
+ *
+ * The rectangles of @p t are kept, as seen through eina_tiler_iterator_new().
+ * The bitmask mode suits damage tracking of many small rectangles, like
+ * animated widgets: its cost depends on the area of the rectangles in
+ * tiles instead of the number of rectangles. It always follows the tile
+ * grid, as if eina_tiler_strict_set() was set. eina_tiler_union(),
+ * eina_tiler_subtract(), eina_tiler_intersection() and eina_tiler_equal()
+ * work on whole bitmasks when both tilers use it with the same area and
+ * tile size. eina_tiler_rect_del() only removes the tiles fully covered by
+ * the rectangle.
+ *
+ * @see eina_tiler_merge_gap_set()
+ * @since 1.22
+ */
+EAPI void               eina_tiler_mode_set(Eina_Tiler *t, Eina_Tiler_Mode mode);
+
+/**
+ * @brief Gets how a tiler keeps track of its rectangles.
+ *
+ * @param[in] t The tiler.
+ * @return The mode of @p t.
+ *
+ * @since 1.22
+ */
+EAPI Eina_Tiler_Mode    eina_tiler_mode_get(const Eina_Tiler *t);
+
+/**
+ * @brief Sets how many clean tiles may be merged into the rectangles.
+ *
+ * @param[in,out] t The tiler.
+ * @param[in] gap The number of tiles.
+ *
+ * In bitmask mode, the rectangles given by eina_tiler_iterator_new() are
+ * built from the runs of tiles of each row, rows with the same runs being
+ * merged in a single rectangle. Runs of a row separated by at most @p gap
+ * clean tiles are joined, trading a few more pixels to draw for fewer
+ * rectangles. The default is 0, the rectangles then cover the tiles
+ * exactly.
+ *
+ * @since 1.22
+ */
+EAPI void               eina_tiler_merge_gap_set(Eina_Tiler *t, unsigned int gap);
+
 /**
  * @brief Tells if a tiler is empty or not.
  *
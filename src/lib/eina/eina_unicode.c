@@ -28,6 +28,7 @@
 /* undefs EINA_ARG_NONULL() so NULL checks are not compiled out! */
 #include "eina_safety_checks.h"
 #include "eina_unicode.h"
+#include "eina_simd.h"
 
 /* FIXME: check if sizeof(wchar_t) == sizeof(Eina_Unicode) if so,
  * probably better to use the standard functions */
@@ -307,9 +308,15 @@ eina_unicode_utf8_get_len(const char *buf)
 {
    /* returns the number of utf8 characters (not bytes) in the string */
    int i = 0, len = 0;
+   size_t chars;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(buf, 0);
 
+   /* valid strings are counted a vector at a time, anything else has to go
+    * through next_get to count the replacement codepoints the same way */
+   if (eina_simd_utf8_len(buf, strlen(buf), &chars))
+     return chars;
+
    while (eina_unicode_utf8_next_get(buf, &i))
         len++;
 
@@ -319,13 +326,23 @@ eina_unicode_utf8_get_len(const char *buf)
 EAPI Eina_Unicode *
 eina_unicode_utf8_to_unicode(const char *utf, int *_len)
 {
-   /* FIXME: Should optimize! */
    int len, i;
    int ind;
    Eina_Unicode *buf, *uind;
+   size_t bytes, chars;
 
    EINA_SAFETY_ON_NULL_RETURN_VAL(utf, NULL);
 
+   bytes = strlen(utf);
+   if (eina_simd_utf8_len(utf, bytes, &chars))
+     {
+        if (_len) *_len = chars;
+        buf = malloc(sizeof(Eina_Unicode) * (chars + 1));
+        if (!buf) return buf;
+        buf[eina_simd_utf8_decode(utf, bytes, buf)] = 0;
+        return buf;
+     }
+
    len = eina_unicode_utf8_get_len(utf);
    if (_len) *_len = len;
    buf = malloc(sizeof(Eina_Unicode) * (len + 1));
@@ -2387,13 +2387,16 @@ _eina_value_type_array_copy(const Eina_Value_Type *type EINA_UNUSED, const void
    ptr = s->array->members;
    ptr_end = ptr + (count * sz);
 
+   /* size the copy in one go instead of growing it member by member */
+   if ((count) && (!eina_inarray_resize(d->array, count)))
+     goto error;
+
    for (i = 0; ptr < ptr_end; ptr += sz, i++)
      {
-        void *imem = eina_inarray_alloc_at(d->array, i, 1);
-        if (!imem) goto error;
+        void *imem = eina_inarray_nth(d->array, i);
         if (!subtype->copy(subtype, ptr, imem))
           {
-             eina_inarray_pop(d->array);
+             eina_inarray_resize(d->array, i);
              goto error;
           }
      }
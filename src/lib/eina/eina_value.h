@@ -761,6 +761,49 @@ static inline void eina_value_flush(Eina_Value *value) EINA_ARG_NONNULL(1);
 EAPI Eina_Bool eina_value_copy(const Eina_Value *value,
                                Eina_Value *copy) EINA_ARG_NONNULL(1, 2);
 
+/**
+ * @brief Moves the contents of a value to another one.
+ *
+ * @param[out] dst Destination value object
+ * @param[in,out] src Source value object
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * Unlike eina_value_copy(), nothing is duplicated: @a dst takes over
+ * the storage of @a src, which is left as #EINA_VALUE_EMPTY and does
+ * not need to be flushed anymore. If @a dst was holding a value, it is
+ * flushed first.
+ *
+ * @see eina_value_steal()
+ *
+ * @since 1.22
+ */
+static inline Eina_Bool eina_value_move(Eina_Value *dst, Eina_Value *src) EINA_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Takes the contents out of a value.
+ *
+ * @param[in,out] value Source value object
+ * @return The contents of @a value.
+ *
+ * @a value is left as #EINA_VALUE_EMPTY and the caller owns the
+ * returned value. This is the cheap way to hand a value over to a
+ * function taking ownership of it, such as eina_promise_resolve() or
+ * eina_future_resolved(), when it is not needed anymore.
+ *
+ * @code
+ *     Eina_Value v;
+ *
+ *     eina_value_setup(&v, EINA_VALUE_TYPE_STRING);
+ *     eina_value_set(&v, "some long text");
+ *     eina_promise_resolve(p, eina_value_steal(&v));
+ * @endcode
+ *
+ * @see eina_value_move()
+ *
+ * @since 1.22
+ */
+static inline Eina_Value eina_value_steal(Eina_Value *value) EINA_ARG_NONNULL(1);
+
 /**
  * @brief Compares generic value storage.
  * @param[in] a left side of comparison
@@ -1825,6 +1868,30 @@ static inline Eina_Bool eina_value_array_pinsert(Eina_Value *value,
 static inline Eina_Bool eina_value_array_pappend(Eina_Value *value,
                                                  const void *ptr) EINA_ARG_NONNULL(1);
 
+/**
+ * @brief Appends a value to the end of an array, taking it over.
+ *
+ * @param[in,out] value Source value object
+ * @param[in,out] item Value to append
+ * @return #EINA_TRUE on success, #EINA_FALSE otherwise.
+ *
+ * The type of @a item must be the array subtype, unless the subtype is
+ * #EINA_VALUE_TYPE_VALUE in which case any value can be appended. The
+ * contents of @a item are moved into the array instead of being copied
+ * like eina_value_array_pappend() does, and @a item is left as
+ * #EINA_VALUE_EMPTY. On failure @a item is left untouched.
+ *
+ * This is the way to build arrays of arrays or structures without
+ * deep copying each member.
+ *
+ * @see eina_value_array_pappend()
+ * @see eina_value_steal()
+ *
+ * @since 1.22
+ */
+static inline Eina_Bool eina_value_array_append_steal(Eina_Value *value,
+                                                      Eina_Value *item) EINA_ARG_NONNULL(1, 2);
+
 /**
  * @brief Retrieves a value from the array as an Eina_Value copy.
  *
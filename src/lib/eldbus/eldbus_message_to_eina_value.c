@@ -116,9 +116,7 @@ _message_iter_array_to_eina_value(Eldbus_Message_Iter *iter)
         while (eldbus_message_iter_get_and_next(iter, sig[0], &entry))
           {
              Eina_Value *data = _message_iter_struct_to_eina_value(entry);
-             Eina_Value_Struct st;
-             eina_value_get(data, &st);
-             eina_value_array_append(array_value, st);
+             eina_value_array_append_steal(array_value, data);
              eina_value_free(data);
           }
      }
@@ -128,9 +126,7 @@ _message_iter_array_to_eina_value(Eldbus_Message_Iter *iter)
         while (eldbus_message_iter_get_and_next(iter, sig[0], &entry))
           {
              Eina_Value *data = _message_iter_array_to_eina_value(entry);
-             Eina_Value_Array inner_array;
-             eina_value_get(data, &inner_array);
-             eina_value_array_append(array_value, inner_array);
+             eina_value_array_append_steal(array_value, data);
              eina_value_free(data);
           }
      }
@@ -1192,6 +1192,57 @@ EAPI Eina_Bool        efl_domain_data_return(Efl_Id_Domain domain);
  */
 EAPI Eina_Bool        efl_compatible(const Eo *obj, const Eo *obj_target);
 
+/**
+ * @brief Start the Eo profiler
+ * @param sampling Time one call out of @p sampling, 0 stops the profiler
+ *
+ * While the profiler runs, Eo counts the calls of every op and every class,
+ * the events emitted and the listeners they reached, and builds a histogram
+ * of the lifetime of the objects of every class. The duration of one call
+ * out of @p sampling is measured, which is enough to estimate the time
+ * spent in an op while keeping the cost of the profiler low. Counters are
+ * kept per thread and merged in the report.
+ *
+ * The profiler can also be enabled at init time by setting the EO_PROFILE
+ * environment variable to the sampling rate, and driven from efl_debug.
+ * When it is stopped, it costs a predictable branch per call.
+ *
+ * @see efl_object_profiler_report_get()
+ * @since 1.22
+ */
+EAPI void             efl_object_profiler_start(unsigned int sampling);
+
+/**
+ * @brief Stop the Eo profiler
+ *
+ * The counters are kept, so the report can still be retrieved.
+ *
+ * @see efl_object_profiler_start()
+ * @since 1.22
+ */
+EAPI void             efl_object_profiler_stop(void);
+
+/**
+ * @brief Reset all the counters of the Eo profiler
+ *
+ * @see efl_object_profiler_start()
+ * @since 1.22
+ */
+EAPI void             efl_object_profiler_reset(void);
+
+/**
+ * @brief Get a report of the Eo profiler counters
+ * @return A newly allocated string to be freed with free(), or NULL
+ *
+ * The report is made of tab-separated lines, the first field of a line
+ * tells its kind: "op", "class", "event" or "lifetime". Lines starting with
+ * a '#' describe the fields of the lines that follow.
+ *
+ * @see efl_object_profiler_start()
+ * @since 1.22
+ */
+EAPI char            *efl_object_profiler_report_get(void);
+
 #endif
 
 // to fetch internal function and object data at once
@@ -1207,6 +1258,9 @@ typedef struct _Efl_Object_Op_Call_Data
    void         *extn4; // for future use to avoid ABI issues
 } Efl_Object_Op_Call_Data;
 
+// the last call resolved at a call site, opaque and owned by Eo
+typedef struct _Efl_Object_Call_Cache Efl_Object_Call_Cache;
+
 // to pass the internal function call to EFL_FUNC_BODY (as Func parameter)
 #define EFL_FUNC_CALL(...) __VA_ARGS__
 
@@ -1227,14 +1281,15 @@ typedef struct _Efl_Object_Op_Call_Data
 #define EFL_FUNC_COMMON_OP(Obj, Name, DefRet) \
    static Efl_Object_Op ___op = 0; \
    static unsigned int ___generation = 0; \
+   static const Efl_Object_Call_Cache *___cache = NULL; \
    Efl_Object_Op_Call_Data ___call; \
    _Eo_##Name##_func _func_;                                            \
    if (EINA_UNLIKELY((___op == EFL_NOOP) ||                       \
                      (___generation != _efl_object_init_generation))) \
      goto __##Name##_op_create; /* yes a goto - see below */ \
    __##Name##_op_create_done: EINA_HOT; \
-   if (EINA_UNLIKELY(!_efl_object_call_resolve( \
-      (Eo *) Obj, #Name, &___call, ___op, __FILE__, __LINE__))) \
+   if (EINA_UNLIKELY(!_efl_object_call_resolve_cached( \
+      (Eo *) Obj, #Name, &___call, ___op, &___cache, __FILE__, __LINE__))) \
       goto __##Name##_failed; \
    _func_ = (_Eo_##Name##_func) ___call.func;
 
@@ -1250,6 +1305,7 @@ typedef struct _Efl_Object_Op_Call_Data
 __##Name##_op_create: EINA_COLD; \
    ___op = _efl_object_op_api_id_get(EFL_FUNC_COMMON_OP_FUNC(Name), Obj, #Name, __FILE__, __LINE__); \
    ___generation = _efl_object_init_generation; \
+   ___cache = NULL; \
    if (EINA_UNLIKELY(___op == EFL_NOOP)) goto __##Name##_failed; \
    goto __##Name##_op_create_done; \
 __##Name##_failed: EINA_COLD; \
@@ -1356,6 +1412,9 @@ EAPI Efl_Object_Op _efl_object_op_api_id_get(const void *api_func, const Eo *obj
 // gets the real function pointer and the object data
 EAPI Eina_Bool _efl_object_call_resolve(Eo *obj, const char *func_name, Efl_Object_Op_Call_Data *call, Efl_Object_Op op, const char *file, int line);
 
+// same, first checking the call resolved last time at the call site
+EAPI Eina_Bool _efl_object_call_resolve_cached(Eo *obj, const char *func_name, Efl_Object_Op_Call_Data *call, Efl_Object_Op op, const Efl_Object_Call_Cache **cache, const char *file, int line);
+
 // end of the eo call barrier, unref the obj
 EAPI void _efl_object_call_end(Efl_Object_Op_Call_Data *call);
 
@@ -1536,6 +1595,70 @@ EAPI Eo *_efl_added_get(void);
 
 EAPI Eo * _efl_add_internal_start(const char *file, int line, const Efl_Class *klass_id, Eo *parent, Eina_Bool ref, Eina_Bool is_fallback);
 
+/**
+ * @typedef Efl_Add_Batch_Cb
+ * Called on each object created by #efl_add_batch, between its constructor
+ * and its finalize, like the ops passed to #efl_add.
+ *
+ * @param data The data passed to #efl_add_batch.
+ * @param obj The object being created.
+ * @param index The index of the object in the batch.
+ *
+ * @since 1.22
+ */
+typedef void (*Efl_Add_Batch_Cb)(void *data, Eo *obj, unsigned int index);
+
+/**
+ * @def efl_add_batch
+ * @brief Create many objects of the same class and add them to a parent.
+ *
+ * This is the same as calling #efl_add @p count times, but the class and
+ * the parent are checked only once, the ids of the objects are reserved
+ * together and their memory is taken from blocks of the class. That
+ * memory is kept by the class to create other objects of it once these
+ * are deleted, until the class is freed.
+ *
+ * @param klass The class of the objects to create.
+ * @param parent The parent to set to the objects (MUST not be @c NULL)
+ * @param objs An array of @p count objects filled with the new objects, or
+ * @c NULL for those which failed to be created.
+ * @param count The number of objects to create.
+ * @param init_cb The function setting up each object, can be @c NULL.
+ * @param data The data to pass to @p init_cb.
+ * @return The number of objects created.
+ *
+ * @see efl_del_batch()
+ *
+ * @since 1.22
+ */
+#define efl_add_batch(klass, parent, objs, count, init_cb, data) \
+   _efl_add_batch(__FILE__, __LINE__, klass, parent, EINA_FALSE, objs, count, init_cb, data)
+
+/**
+ * @def efl_add_batch_ref
+ * @brief Create many objects of the same class and return a reference on
+ *        each of them.
+ *
+ * This is to #efl_add_ref what #efl_add_batch is to #efl_add.
+ *
+ * @param klass The class of the objects to create.
+ * @param parent The parent to set to the objects (can be @c NULL).
+ * @param objs An array of @p count objects filled with the new objects, or
+ * @c NULL for those which failed to be created.
+ * @param count The number of objects to create.
+ * @param init_cb The function setting up each object, can be @c NULL.
+ * @param data The data to pass to @p init_cb.
+ * @return The number of objects created.
+ *
+ * @see efl_unref_batch()
+ *
+ * @since 1.22
+ */
+#define efl_add_batch_ref(klass, parent, objs, count, init_cb, data) \
+   _efl_add_batch(__FILE__, __LINE__, klass, parent, EINA_TRUE, objs, count, init_cb, data)
+
+EAPI unsigned int _efl_add_batch(const char *file, int line, const Efl_Class *klass_id, Eo *parent, Eina_Bool ref, Eo **objs, unsigned int count, Efl_Add_Batch_Cb init_cb, const void *data);
+
 /**
  * @brief Unrefs the object and reparents it to NULL.
  *
@@ -1550,6 +1673,18 @@ EAPI Eo * _efl_add_internal_start(const char *file, int line, const Efl_Class *k
  */
 EAPI void efl_del(const Eo *obj);
 
+/**
+ * @brief Calls efl_del() on each object of an array.
+ *
+ * @param objs The objects, @c NULL entries are skipped.
+ * @param count The number of objects in @p objs.
+ *
+ * @see efl_add_batch
+ *
+ * @since 1.22
+ */
+EAPI void efl_del_batch(Eo * const *objs, unsigned int count);
+
 /**
  * @brief Set an override for a class
  *
@@ -1700,6 +1835,17 @@ EAPI Eo *efl_ref(const Eo *obj);
  */
 EAPI void efl_unref(const Eo *obj);
 
+/**
+ * @brief Calls efl_unref() on each object of an array.
+ * @param objs The objects, @c NULL entries are skipped.
+ * @param count The number of objects in @p objs.
+ *
+ * @see efl_add_batch_ref
+ *
+ * @since 1.22
+ */
+EAPI void efl_unref_batch(Eo * const *objs, unsigned int count);
+
 /**
  * @brief Return the ref count of the object passed.
  * @param obj the object to work on.
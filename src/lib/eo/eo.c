@@ -33,6 +33,9 @@
 # include <memcheck.h>
 #endif
 static Eina_Bool _eo_trash_bypass = EINA_FALSE;
+/* All object instances come from a size class allocator, as every class
+ * has its own instance size. It is bypassed when running on valgrind. */
+static Eina_Mempool *_eo_objects_mp = NULL;
 
 #define EO_CLASS_IDS_FIRST 1
 #define EFL_OBJECT_OP_IDS_FIRST 1
@@ -226,8 +229,9 @@ _vtable_func_get(const Eo_Vtable *vtable, Efl_Object_Op op)
    return &chain1->chain2->funcs[DICH_CHAIN_LAST(op)];
 }
 
-/* XXX: Only used for a debug message below. Doesn't matter that it's slow. */
-static const _Efl_Class *
+/* XXX: Only used for debug messages and the profiler report. Doesn't matter
+ * that it's slow. */
+const _Efl_Class *
 _eo_op_class_get(Efl_Object_Op op)
 {
    _Efl_Class **itr = _eo_classes;
@@ -310,6 +314,110 @@ _vtable_func_clean_all(Eo_Vtable *vtable)
 
 /* END OF DICH */
 
+/* Call records: the vtable of a class, flattened with the data scopes of the
+ * implementing classes, for the calls on its objects. */
+
+static unsigned int
+_eo_call_record_data_offset(const _Efl_Class *klass, const _Efl_Class *src)
+{
+   const Eo_Extension_Data_Offset *doff_itr;
+
+   /* Same as _efl_data_scope_get() */
+   if (EINA_LIKELY(src->desc->type != EFL_CLASS_TYPE_MIXIN))
+     return src->data_offset;
+   if (src->desc->data_size == 0) return 0;
+
+   for (doff_itr = klass->extn_data_off; doff_itr && doff_itr->klass; doff_itr++)
+     {
+        if (doff_itr->klass == src)
+          return doff_itr->offset;
+     }
+   return 0;
+}
+
+static Eo_Call_Record *
+_eo_call_records_build(_Efl_Class *klass, size_t idx1)
+{
+   const Dich_Chain2 *chain2 = klass->vtable.chain[idx1].chain2;
+   Eo_Call_Record *block, *expected = NULL;
+   size_t j;
+
+   if (!chain2) return NULL;
+
+   block = calloc(DICH_CHAIN_LAST_SIZE, sizeof (Eo_Call_Record));
+   if (!block) return NULL;
+
+   for (j = 0 ; j < DICH_CHAIN_LAST_SIZE ; j++)
+     {
+        const op_type_funcs *fsrc = &chain2->funcs[j];
+
+        // Pure virtual and unknown calls keep the full resolution
+        if (!fsrc->func || !fsrc->src) continue;
+        block[j].klass = klass;
+        block[j].func = fsrc->func;
+        block[j].data_offset = _eo_call_record_data_offset(klass, fsrc->src);
+     }
+
+   // Another thread may have built the same block in the meantime
+   if (!__atomic_compare_exchange_n(&klass->calls[idx1], &expected, block, EINA_FALSE,
+                                    __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+     {
+        free(block);
+        block = expected;
+     }
+   return block;
+}
+
+static inline const Eo_Call_Record *
+_eo_call_record_get(_Efl_Class *klass, Efl_Object_Op op)
+{
+   size_t idx1 = DICH_CHAIN1(op);
+   const Eo_Call_Record *rec;
+   Eo_Call_Record *block;
+
+   if (EINA_UNLIKELY((idx1 >= klass->vtable.size) || !klass->calls)) return NULL;
+   block = __atomic_load_n(&klass->calls[idx1], __ATOMIC_ACQUIRE);
+   if (EINA_UNLIKELY(!block))
+     {
+        block = _eo_call_records_build(klass, idx1);
+        if (!block) return NULL;
+     }
+   rec = &block[DICH_CHAIN_LAST(op)];
+   return rec->func ? rec : NULL;
+}
+
+static inline void
+_eo_call_record_use(const Eo_Call_Record *rec, _Eo_Object *obj,
+                    Efl_Object_Op_Call_Data *call)
+{
+   call->obj = obj;
+   call->func = rec->func;
+   call->data = rec->data_offset ? ((char *) obj) + rec->data_offset : NULL;
+   _efl_ref(obj);
+}
+
+/* Marks a resolved call for the profiler, _efl_object_call_end() only looks
+ * at calls with extn1 set. */
+static inline void
+_eo_call_profile(Efl_Object_Op_Call_Data *call, Efl_Object_Op op, const _Efl_Class *klass)
+{
+   call->extn1 = NULL;
+   if (EINA_UNLIKELY(_eo_profiler_sampling != 0))
+     _eo_profiler_call_begin(call, op, klass);
+}
+
+static void
+_eo_call_records_free(_Efl_Class *klass)
+{
+   size_t i;
+
+   if (!klass->calls) return;
+   for (i = 0 ; i < klass->vtable.size ; i++)
+     free(klass->calls[i]);
+   free(klass->calls);
+   klass->calls = NULL;
+}
+
 #define _EO_ID_GET(Id) ((Eo_Id) (Id))
 
 
@@ -476,6 +584,18 @@ _efl_object_call_resolve(Eo *eo_id, const char *func_name, Efl_Object_Op_Call_Da
              // hot path of the function
              goto obj_super;
           }
+        if (EINA_LIKELY(vtable == &klass->vtable))
+          {
+             const Eo_Call_Record *rec;
+
+             rec = _eo_call_record_get((_Efl_Class *) klass, op);
+             if (EINA_LIKELY(rec != NULL))
+               {
+                  _eo_call_record_use(rec, obj, call);
+                  _eo_call_profile(call, op, klass);
+                  return EINA_TRUE;
+               }
+          }
 
 obj_super_back:
         call->obj = obj;
@@ -516,6 +636,7 @@ ok_cur_klass_back:
 
         if (is_obj) call->data = _efl_data_scope_get(obj, func->src);
 
+        _eo_call_profile(call, op, main_klass);
         return EINA_TRUE;
      }
 
@@ -546,6 +667,7 @@ end:
                   /* We reffed it above, but no longer need/use it. */
                   _efl_unref(obj);
                   EO_OBJ_DONE(emb_obj_id);
+                  _eo_call_profile(call, op, emb_obj->klass);
                   return EINA_TRUE;
                }
 composite_continue:
@@ -639,9 +761,47 @@ on_null:
    return EINA_FALSE;
 }
 
+EAPI Eina_Bool
+_efl_object_call_resolve_cached(Eo *eo_id, const char *func_name, Efl_Object_Op_Call_Data *call, Efl_Object_Op op, const Efl_Object_Call_Cache **cache, const char *file, int line)
+{
+   const Eo_Call_Record *rec;
+
+   // Class calls, super calls and overridden objects take the long way
+   if (EINA_UNLIKELY(!eo_id || !_eo_is_a_obj(eo_id))) goto resolve;
+
+   EO_OBJ_POINTER_RETURN_VAL_PROXY(eo_id, obj, EINA_FALSE);
+   if (EINA_UNLIKELY((obj->cur_klass != NULL) || (obj->opt->vtable != NULL)))
+     goto resolve_done;
+
+   call->eo_id = eo_id;
+   rec = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+   if (EINA_LIKELY(rec && (rec->klass == obj->klass)))
+     {
+        _eo_call_record_use(rec, obj, call);
+        _eo_call_profile(call, op, obj->klass);
+        return EINA_TRUE;
+     }
+
+   rec = _eo_call_record_get((_Efl_Class *) obj->klass, op);
+   if (EINA_UNLIKELY(!rec)) goto resolve_done;
+
+   __atomic_store_n(cache, rec, __ATOMIC_RELEASE);
+   _eo_call_record_use(rec, obj, call);
+   _eo_call_profile(call, op, obj->klass);
+   return EINA_TRUE;
+
+resolve_done:
+   // The object is looked up again, cheaply as it was the last one
+   EO_OBJ_DONE(eo_id);
+resolve:
+   return _efl_object_call_resolve(eo_id, func_name, call, op, file, line);
+}
+
 EAPI void
 _efl_object_call_end(Efl_Object_Op_Call_Data *call)
 {
+   if (EINA_UNLIKELY(call->extn1 != NULL))
+     _eo_profiler_call_end(call);
    if (EINA_LIKELY(!!call->obj))
      {
         if (EINA_UNLIKELY(call->obj->auto_unref != 0))
@@ -685,6 +845,45 @@ _efl_object_api_op_id_get_internal(const void *api_func)
    return op;
 }
 
+typedef struct
+{
+   const char **names;
+   unsigned int count;
+} Eo_Op_Names;
+
+static Eina_Bool
+_eo_op_names_fill_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                     void *data, void *fdata)
+{
+   Eo_Op_Names *n = fdata;
+   Efl_Object_Op op = (uintptr_t) data;
+
+   if (op >= n->count) return EINA_TRUE;
+#ifndef _WIN32
+# ifdef HAVE_DLADDR
+   Dl_info info;
+
+   if ((dladdr(*(void * const *) key, &info) != 0) && info.dli_sname)
+     n->names[op] = info.dli_sname;
+# endif
+#else
+   n->names[op] = key; /* The API function name on windows */
+#endif
+   return EINA_TRUE;
+}
+
+/* Fills names[op] with the name of the API function of every op below
+ * count, names are left untouched when they can't be found. */
+void
+_eo_op_names_get(const char **names, unsigned int count)
+{
+   Eo_Op_Names n = { names, count };
+
+   eina_spinlock_take(&_ops_storage_lock);
+   if (_ops_storage) eina_hash_foreach(_ops_storage, _eo_op_names_fill_cb, &n);
+   eina_spinlock_release(&_ops_storage_lock);
+}
+
 /* LEGACY, should be removed before next release */
 EAPI Efl_Object_Op
 _efl_object_api_op_id_get(const void *api_func)
@@ -838,6 +1037,7 @@ efl_class_functions_set(const Efl_Class *klass_id, const Efl_Object_Ops *object_
    _eo_ops_last_id += klass->ops_count + 1;
 
    _vtable_init(&klass->vtable, DICH_CHAIN1(_eo_ops_last_id) + 1);
+   klass->calls = calloc(klass->vtable.size, sizeof(*klass->calls));
 
    /* Flatten the function array */
      {
@@ -859,58 +1059,118 @@ err_klass:
    return EINA_FALSE;
 }
 
-EAPI Eo *
-_efl_add_internal_start(const char *file, int line, const Efl_Class *klass_id, Eo *parent_id, Eina_Bool ref, Eina_Bool is_fallback)
+static inline void *
+_eo_obj_mem_alloc(size_t size)
 {
-   const char *func_name = __FUNCTION__;
-   _Eo_Object *obj;
-   Eo_Stack_Frame *fptr = NULL;
+   if (_eo_objects_mp) return eina_mempool_calloc(_eo_objects_mp, size);
+   return calloc(1, size);
+}
 
-   if (is_fallback) fptr = _efl_add_fallback_stack_push(NULL);
+static void
+_eo_obj_mem_free(void *ptr)
+{
+   if (_eo_objects_mp) eina_mempool_free(_eo_objects_mp, ptr);
+   else free(ptr);
+}
 
-   if (class_overrides)
-     {
-        const Efl_Class *override = eina_hash_find(class_overrides, &klass_id);
-        if (override) klass_id = override;
-     }
+/* Takes a cached object of the class, its memory is otherwise cleared */
+static inline _Eo_Object *
+_eo_obj_trash_pop(_Efl_Class *klass)
+{
+   _Eo_Object *obj;
+   Eina_Bool batched;
 
-   EO_CLASS_POINTER_GOTO_PROXY(klass_id, klass, err_klass);
+   obj = eina_trash_pop(&klass->objects.trash);
+   if (!obj) return NULL;
+   batched = obj->batched;
+   memset(obj, 0, klass->obj_size);
+   obj->batched = batched;
+   klass->objects.trash_count--;
+   return obj;
+}
 
-   // Check that in the case of efl_add we do pass a parent.
-   if (!ref && !parent_id)
-     ERR("Creation of '%s' object at line %i in '%s' is done without parent. This should use efl_add_ref.",
-         klass->desc->name, line, file);
+#define EO_BATCH_CHUNK 64
+#define EO_BATCH_BLOCK_MIN 16
 
-   if (parent_id)
+/* Gets memory for count objects, from the trash first and then from a new
+ * block, returns how many got some */
+static unsigned int
+_eo_objs_alloc_many(_Efl_Class *klass, _Eo_Object **objs, unsigned int count)
+{
+   Eo_Objects_Block *block;
+   unsigned char *mem;
+   unsigned int i, j, size;
+
+   eina_spinlock_take(&klass->objects.trash_lock);
+   for (i = 0; i < count; i++)
      {
-        EO_OBJ_POINTER_GOTO_PROXY(parent_id, parent, err_parent);
+        objs[i] = _eo_obj_trash_pop(klass);
+        if (!objs[i]) break;
      }
+   if (i == count) goto end;
 
-   // not likely so use goto to alleviate l1 instruction cache of rare code
-   if (EINA_UNLIKELY(klass->desc->type != EFL_CLASS_TYPE_REGULAR))
-     goto err_noreg;
-
-   eina_spinlock_take(&klass->objects.trash_lock);
-   obj = eina_trash_pop(&klass->objects.trash);
-   if (obj)
+   if (EINA_UNLIKELY(_eo_trash_bypass))
      {
-        memset(obj, 0, klass->obj_size);
-        klass->objects.trash_count--;
+        for (; i < count; i++)
+          {
+             objs[i] = _eo_obj_mem_alloc(klass->obj_size);
+             if (!objs[i]) break;
+          }
+        goto end;
      }
-   else
+
+   // The objects left over in the block wait in the trash
+   size = count - i;
+   if (size < EO_BATCH_BLOCK_MIN) size = EO_BATCH_BLOCK_MIN;
+   block = calloc(1, eina_mempool_alignof(sizeof(Eo_Objects_Block)) +
+                  (size_t) size * klass->obj_size);
+   if (!block) goto end;
+   block->next = klass->objects.blocks;
+   klass->objects.blocks = block;
+
+   mem = ((unsigned char *) block) + eina_mempool_alignof(sizeof(Eo_Objects_Block));
+   for (j = 0; j < size; j++, mem += klass->obj_size)
      {
-        obj = calloc(1, klass->obj_size);
+        _Eo_Object *obj = (_Eo_Object *) mem;
+
+        obj->batched = EINA_TRUE;
+        if (i < count)
+          objs[i++] = obj;
+        else
+          {
+             eina_trash_push(&klass->objects.trash, obj);
+             klass->objects.trash_count++;
+          }
      }
+
+end:
    eina_spinlock_release(&klass->objects.trash_lock);
+   return i;
+}
 
-   obj->opt = eina_cow_alloc(efl_object_optional_cow);
-   _efl_ref(obj);
-   obj->klass = klass;
+static void
+_eo_objs_blocks_free(_Efl_Class *klass)
+{
+   while (klass->objects.blocks)
+     {
+        Eo_Objects_Block *block = klass->objects.blocks;
 
-   obj->header.id = _eo_id_allocate(obj, parent_id);
+        klass->objects.blocks = block->next;
+        free(block);
+     }
+}
+
+/* Constructs an object which already has its id, func_name, file and line
+ * are those of the caller for error reporting. */
+static Eo *
+_efl_add_internal_construct(const char *func_name, const char *file, int line,
+                            const _Efl_Class *klass, _Eo_Object *obj, Eo *parent_id)
+{
    Eo *eo_id = _eo_obj_id_get(obj);
 
    _eo_log_obj_ref_op(obj, EO_REF_OP_NEW);
+   if (EINA_UNLIKELY(_eo_profiler_sampling != 0))
+     _eo_profiler_object_new(obj);
 
    _eo_condtor_reset(obj);
 
@@ -925,9 +1185,6 @@ _efl_add_internal_start(const char *file, int line, const Efl_Class *klass_id, E
    if (!eo_id) goto err_noid;
    // not likely so use goto to alleviate l1 instruction cache of rare code
    else if (eo_id != _eo_obj_id_get(obj)) goto ok_nomatch;
-ok_nomatch_back:
-   if (is_fallback) fptr->obj = eo_id;
-   if (parent_id) EO_OBJ_DONE(parent_id);
    return eo_id;
 
 ok_nomatch:
@@ -941,7 +1198,7 @@ ok_nomatch:
         _efl_unref(obj);
         EO_OBJ_DONE(eo_id);
      }
-   goto ok_nomatch_back;
+   return eo_id;
 
 err_noid:
    ERR("in %s:%d: Object of class '%s' - Error while constructing object",
@@ -951,8 +1208,60 @@ err_noid:
    efl_unref(_eo_obj_id_get(obj));
    _efl_unref(obj);
 err_newid:
-   if (parent_id) EO_OBJ_DONE(parent_id);
    return NULL;
+}
+
+EAPI Eo *
+_efl_add_internal_start(const char *file, int line, const Efl_Class *klass_id, Eo *parent_id, Eina_Bool ref, Eina_Bool is_fallback)
+{
+   const char *func_name = __FUNCTION__;
+   _Eo_Object *obj;
+   Eo_Stack_Frame *fptr = NULL;
+   Eo *eo_id;
+
+   if (is_fallback) fptr = _efl_add_fallback_stack_push(NULL);
+
+   if (class_overrides)
+     {
+        const Efl_Class *override = eina_hash_find(class_overrides, &klass_id);
+        if (override) klass_id = override;
+     }
+
+   EO_CLASS_POINTER_GOTO_PROXY(klass_id, klass, err_klass);
+
+   // Check that in the case of efl_add we do pass a parent.
+   if (!ref && !parent_id)
+     ERR("Creation of '%s' object at line %i in '%s' is done without parent. This should use efl_add_ref.",
+         klass->desc->name, line, file);
+
+   if (parent_id)
+     {
+        EO_OBJ_POINTER_GOTO_PROXY(parent_id, parent, err_parent);
+     }
+
+   // not likely so use goto to alleviate l1 instruction cache of rare code
+   if (EINA_UNLIKELY(klass->desc->type != EFL_CLASS_TYPE_REGULAR))
+     goto err_noreg;
+
+   eina_spinlock_take(&klass->objects.trash_lock);
+   obj = _eo_obj_trash_pop(klass);
+   if (!obj)
+     {
+        obj = _eo_obj_mem_alloc(klass->obj_size);
+     }
+   eina_spinlock_release(&klass->objects.trash_lock);
+
+   obj->opt = eina_cow_alloc(efl_object_optional_cow);
+   _efl_ref(obj);
+   obj->klass = klass;
+
+   obj->header.id = _eo_id_allocate(obj, parent_id);
+
+   eo_id = _efl_add_internal_construct(func_name, file, line, klass, obj, parent_id);
+   if (is_fallback && eo_id) fptr->obj = eo_id;
+   if (parent_id) EO_OBJ_DONE(parent_id);
+   return eo_id;
+
 err_noreg:
    ERR("in %s:%d: Class '%s' is not instantiate-able. Aborting.", file, line, klass->desc->name);
    if (parent_id) EO_OBJ_DONE(parent_id);
@@ -1026,6 +1335,120 @@ _efl_add_end(Eo *eo_id, Eina_Bool is_ref, Eina_Bool is_fallback)
    return ret;
 }
 
+EAPI unsigned int
+_efl_add_batch(const char *file, int line, const Efl_Class *klass_id, Eo *parent_id, Eina_Bool ref,
+               Eo **objs, unsigned int count, Efl_Add_Batch_Cb init_cb, const void *data)
+{
+   const char *func_name = __FUNCTION__;
+   _Eo_Object *chunk[EO_BATCH_CHUNK];
+   unsigned int done, n, got, ids, i, created = 0;
+
+   EINA_SAFETY_ON_NULL_RETURN_VAL(objs, 0);
+
+   if (class_overrides)
+     {
+        const Efl_Class *override = eina_hash_find(class_overrides, &klass_id);
+        if (override) klass_id = override;
+     }
+
+   EO_CLASS_POINTER_GOTO_PROXY(klass_id, klass, err_klass);
+
+   if (!ref && !parent_id)
+     ERR("Creation of '%s' objects at line %i in '%s' is done without parent. This should use efl_add_batch_ref.",
+         klass->desc->name, line, file);
+
+   if (parent_id)
+     {
+        EO_OBJ_POINTER_GOTO_PROXY(parent_id, parent, err_parent);
+     }
+
+   if (EINA_UNLIKELY(klass->desc->type != EFL_CLASS_TYPE_REGULAR))
+     goto err_noreg;
+
+   for (done = 0; done < count; done += n)
+     {
+        n = count - done;
+        if (n > EO_BATCH_CHUNK) n = EO_BATCH_CHUNK;
+
+        got = _eo_objs_alloc_many(klass, chunk, n);
+        for (i = 0; i < got; i++)
+          {
+             chunk[i]->opt = eina_cow_alloc(efl_object_optional_cow);
+             _efl_ref(chunk[i]);
+             chunk[i]->klass = klass;
+          }
+        ids = _eo_id_allocate_many(chunk, got, parent_id);
+
+        for (i = 0; i < ids; i++)
+          {
+             Eo *eo_id;
+
+             eo_id = _efl_add_internal_construct(func_name, file, line, klass, chunk[i], parent_id);
+             if (eo_id && init_cb) init_cb((void *) data, eo_id, done + i);
+             objs[done + i] = _efl_add_end(eo_id, ref, EINA_FALSE);
+             if (objs[done + i]) created++;
+          }
+        if (EINA_UNLIKELY(ids < n)) goto err_alloc;
+     }
+
+   if (parent_id) EO_OBJ_DONE(parent_id);
+   return created;
+
+err_alloc:
+   ERR("in %s:%d: Could only allocate %u objects of class '%s' out of %u.",
+       file, line, done + ids, klass->desc->name, count);
+   // Objects without an id go back to the trash, nothing else knows them
+   eina_spinlock_take(&klass->objects.trash_lock);
+   for (i = ids; i < got; i++)
+     {
+        eina_cow_free(efl_object_optional_cow, (Eina_Cow_Data *) &chunk[i]->opt);
+        eina_trash_push(&klass->objects.trash, chunk[i]);
+        klass->objects.trash_count++;
+     }
+   eina_spinlock_release(&klass->objects.trash_lock);
+   for (i = done + ids; i < count; i++)
+     objs[i] = NULL;
+   if (parent_id) EO_OBJ_DONE(parent_id);
+   return created;
+
+err_noreg:
+   ERR("in %s:%d: Class '%s' is not instantiate-able. Aborting.", file, line, klass->desc->name);
+   if (parent_id) EO_OBJ_DONE(parent_id);
+   goto err;
+
+err_klass:
+   _EO_POINTER_ERR(klass_id, "in %s:%d: Class (%p) is an invalid ref.", file, line, klass_id);
+err_parent:
+err:
+   for (i = 0; i < count; i++)
+     objs[i] = NULL;
+   return 0;
+}
+
+EAPI void
+efl_unref_batch(Eo * const *objs, unsigned int count)
+{
+   unsigned int i;
+
+   EINA_SAFETY_ON_NULL_RETURN(objs);
+   for (i = 0; i < count; i++)
+     {
+        if (objs[i]) efl_unref(objs[i]);
+     }
+}
+
+EAPI void
+efl_del_batch(Eo * const *objs, unsigned int count)
+{
+   unsigned int i;
+
+   EINA_SAFETY_ON_NULL_RETURN(objs);
+   for (i = 0; i < count; i++)
+     {
+        if (objs[i]) efl_del(objs[i]);
+     }
+}
+
 EAPI void
 efl_reuse(const Eo *eo_id)
 {
@@ -1048,6 +1471,8 @@ _eo_free(_Eo_Object *obj, Eina_Bool manual_free EINA_UNUSED)
    _Efl_Class *klass = (_Efl_Class*) obj->klass;
 
    _eo_log_obj_ref_op(obj, EO_REF_OP_FREE);
+   if (EINA_UNLIKELY(_eo_profiler_sampling != 0))
+     _eo_profiler_object_free(obj);
 
 #ifdef EO_DEBUG
    if (manual_free)
@@ -1097,14 +1522,15 @@ _eo_free(_Eo_Object *obj, Eina_Bool manual_free EINA_UNUSED)
    eina_cow_free(efl_object_optional_cow, (Eina_Cow_Data *) &obj->opt);
 
    eina_spinlock_take(&klass->objects.trash_lock);
-   if ((klass->objects.trash_count <= 8) && (EINA_LIKELY(!_eo_trash_bypass)))
+   if ((obj->batched) ||
+       ((klass->objects.trash_count <= 8) && (EINA_LIKELY(!_eo_trash_bypass))))
      {
         eina_trash_push(&klass->objects.trash, obj);
         klass->objects.trash_count++;
      }
    else
      {
-        eina_freeq_ptr_main_add(obj, free, klass->obj_size);
+        eina_freeq_ptr_main_add(obj, _eo_obj_mem_free, klass->obj_size);
      }
    eina_spinlock_release(&klass->objects.trash_lock);
 }
@@ -1353,9 +1779,14 @@ eo_class_free(_Efl_Class *klass)
 
         _vtable_func_clean_all(&klass->vtable);
      }
+   _eo_call_records_free(klass);
 
    EINA_TRASH_CLEAN(&klass->objects.trash, data)
-      eina_freeq_ptr_main_add(data, free, klass->obj_size);
+     {
+        if (!((_Eo_Object *) data)->batched)
+          eina_freeq_ptr_main_add(data, _eo_obj_mem_free, klass->obj_size);
+     }
+   _eo_objs_blocks_free(klass);
 
    EINA_TRASH_CLEAN(&klass->iterators.trash, data)
       eina_freeq_ptr_main_add(data, free, 0);
@@ -1814,33 +2245,27 @@ efl_isa(const Eo *eo_id, const Efl_Class *klass_id)
      }
    else
      {
-        eina_lock_take(&(_eo_table_data_shared_data->obj_lock));
-
-        if ((tdata->cache.isa_id == eo_id) &&
-            (tdata->cache.klass == klass_id))
-          {
-             isa = tdata->cache.isa;
-             // since this is the cache we hope this gets a lot of hits and
-             // thus lets assume the hit is the mot important thing thus
-             // put the lock release and return here inline in the l1
-             // instruction cache hopefully already fetched
-             eina_lock_release(&(_eo_table_data_shared_data->obj_lock));
-             return isa;
-          }
+        // Any thread can release the object, the cache of this thread is
+        // only good while the entry of the object did not change
+        if ((data->shared_cache.isa_id == eo_id) &&
+            (data->shared_cache.klass == klass_id) &&
+            (__atomic_load_n(data->shared_cache.isa_state, __ATOMIC_ACQUIRE) ==
+             data->shared_cache.isa_expect))
+          return data->shared_cache.isa;
 
         EO_OBJ_POINTER_GOTO(eo_id, obj, err_shared_obj);
         EO_CLASS_POINTER_GOTO(klass_id, klass, err_shared_class);
         const op_type_funcs *func = _vtable_func_get
           (EO_VTABLE(obj), klass->base_id + klass->ops_count);
 
-        // Caching the result as we do a lot of serial efl_isa due to evas_object_image using it.
-        tdata->cache.isa_id = eo_id;
-        tdata->cache.klass = klass_id;
-        // Currently implemented by reusing the LAST op id. Just marking it with
-        // _eo_class_isa_func.
-        isa = tdata->cache.isa = (func && (func->func == _eo_class_isa_func));
+        isa = (func && (func->func == _eo_class_isa_func));
+        // The lookup above filled the lookup cache with the entry
+        data->shared_cache.isa_id = eo_id;
+        data->shared_cache.klass = klass_id;
+        data->shared_cache.isa_state = data->shared_cache.state;
+        data->shared_cache.isa_expect = data->shared_cache.expect;
+        data->shared_cache.isa = isa;
         EO_OBJ_DONE(eo_id);
-        eina_lock_release(&(_eo_table_data_shared_data->obj_lock));
      }
    return isa;
 
@@ -1848,7 +2273,6 @@ err_shared_class: EINA_COLD
    _EO_POINTER_ERR(klass_id, "Class (%p) is an invalid ref.", klass_id);
    EO_OBJ_DONE(eo_id);
 err_shared_obj: EINA_COLD
-   eina_lock_release(&(_eo_table_data_shared_data->obj_lock));
    return EINA_FALSE;
 
 err_class0:
@@ -2297,6 +2721,8 @@ efl_object_init(void)
 #if HAVE_VALGRIND
    _eo_trash_bypass = RUNNING_ON_VALGRIND;
 #endif
+   if (!_eo_trash_bypass)
+     _eo_objects_mp = eina_mempool_add("slab", "Eo objects", NULL);
 
    _efl_object_main_thread = eina_thread_self();
 
@@ -2375,6 +2801,8 @@ efl_object_init(void)
 
    _efl_add_fallback_init();
 
+   _eo_profiler_init();
+
    eina_log_timing(_eo_log_dom,
                    EINA_LOG_STATE_STOP,
                    EINA_LOG_STATE_INIT);
@@ -2418,6 +2846,8 @@ efl_object_shutdown(void)
 
    _efl_add_fallback_shutdown();
 
+   _eo_profiler_shutdown();
+
    for (i = 0 ; i < _eo_classes_last_id ; i++, cls_itr--)
      {
         if (*cls_itr)
@@ -2428,6 +2858,14 @@ efl_object_shutdown(void)
    _eo_classes_release();
    eina_lock_release(&_efl_class_creation_lock);
 
+   if (_eo_objects_mp)
+     {
+        /* objects may still be waiting in the free queue */
+        eina_freeq_clear(eina_freeq_main_get());
+        eina_mempool_del(_eo_objects_mp);
+        _eo_objects_mp = NULL;
+     }
+
    eina_hash_free(_ops_storage);
    _ops_storage = NULL;
 
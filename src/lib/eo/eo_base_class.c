@@ -22,8 +22,28 @@ EAPI const Efl_Event_Description _EFL_EVENT_CALLBACK_DEL =
 static int event_freeze_count = 0;
 
 typedef struct _Eo_Callback_Description  Eo_Callback_Description;
+typedef struct _Eo_Callback_Index        Eo_Callback_Index;
 typedef struct _Efl_Event_Callback_Frame Efl_Event_Callback_Frame;
 
+/* Objects with that many callbacks get an index of them by event, so an
+   emission only visits the listeners of its own event. */
+#define EO_CALLBACKS_INDEX_MIN 8
+
+typedef struct
+{
+   const Efl_Event_Description *desc;
+   unsigned int                 idx;
+} Eo_Callback_Index_Item;
+
+/* One item per event of each callback, sorted by event then by position in
+   pd->callbacks: the listeners of an event are a contiguous run. */
+struct _Eo_Callback_Index
+{
+   unsigned int           count;
+   unsigned int           legacy; // items of legacy events, see _cb_desc_match
+   Eo_Callback_Index_Item items[];
+};
+
 struct _Efl_Event_Callback_Frame
 {
    Efl_Event_Callback_Frame *next;
@@ -39,6 +59,7 @@ typedef struct
    Eo                        *composite_parent;
    Eina_Inlist               *generic_data;
    Eo                      ***wrefs;
+   Eo_Callback_Index         *callbacks_index;
 } Efl_Object_Extension;
 
 struct _Efl_Object_Data
@@ -207,6 +228,7 @@ _efl_object_extension_noneed(Efl_Object_Data *pd)
        (ext->comment) ||
        (ext->generic_data) ||
        (ext->wrefs) ||
+       (ext->callbacks_index) ||
        (ext->composite_parent)) return;
    _efl_object_extension_free(pd->ext);
    pd->ext = NULL;
@@ -1203,6 +1225,243 @@ _special_event_count_dec(Eo *obj_id, Efl_Object_Data *pd, const Efl_Callback_Arr
      }
 }
 
+static inline Eo_Callback_Index *
+_eo_callbacks_index_get(const Efl_Object_Data *pd)
+{
+   return pd->ext ? pd->ext->callbacks_index : NULL;
+}
+
+static inline Eina_Bool
+_eo_callbacks_index_before(const Eo_Callback_Index_Item *p,
+                           const Efl_Event_Description *desc,
+                           unsigned int idx)
+{
+   return (p->desc < desc) || ((p->desc == desc) && (p->idx < idx));
+}
+
+/* Returns the first item of index that is not before (desc, idx). */
+static inline unsigned int
+_eo_callbacks_index_lower(const Eo_Callback_Index *index,
+                          const Efl_Event_Description *desc,
+                          unsigned int idx)
+{
+   unsigned int start = 0, last = index->count, middle;
+
+   while (start < last)
+     {
+        middle = start + ((last - start) / 2);
+        if (_eo_callbacks_index_before(index->items + middle, desc, idx))
+          start = middle + 1;
+        else
+          last = middle;
+     }
+   return start;
+}
+
+/* Same as _eo_callbacks_index_lower, checking hint first: walking the
+   listeners of an event usually moves one item at a time. */
+static inline unsigned int
+_eo_callbacks_index_lower_hint(const Eo_Callback_Index *index,
+                               const Efl_Event_Description *desc,
+                               unsigned int idx, unsigned int hint)
+{
+   if ((hint <= index->count) &&
+       ((hint == 0) || _eo_callbacks_index_before(index->items + hint - 1, desc, idx)) &&
+       ((hint == index->count) || !_eo_callbacks_index_before(index->items + hint, desc, idx)))
+     return hint;
+   return _eo_callbacks_index_lower(index, desc, idx);
+}
+
+static void
+_eo_callbacks_index_drop(Efl_Object_Data *pd)
+{
+   if (!pd->ext || !pd->ext->callbacks_index) return;
+   free(pd->ext->callbacks_index);
+   pd->ext->callbacks_index = NULL;
+   _efl_object_extension_noneed(pd);
+}
+
+static int
+_eo_callbacks_index_cmp(const void *a, const void *b)
+{
+   const Eo_Callback_Index_Item *ia = a, *ib = b;
+
+   if (ia->desc != ib->desc) return (ia->desc < ib->desc) ? -1 : 1;
+   return (ia->idx > ib->idx) - (ia->idx < ib->idx);
+}
+
+static inline size_t
+_eo_callbacks_index_size(unsigned int count)
+{
+   // Same growth policy as pd->callbacks
+   return sizeof (Eo_Callback_Index) +
+     ((count | 0xF) + 1) * sizeof (Eo_Callback_Index_Item);
+}
+
+static void
+_eo_callbacks_index_build(Efl_Object_Data *pd)
+{
+   const Efl_Callback_Array_Item *it;
+   Efl_Object_Extension *ext;
+   Eo_Callback_Index *index;
+   unsigned int i, n = 0;
+
+   for (i = 0; i < pd->callbacks_count; i++)
+     {
+        if (!pd->callbacks[i]->func_array) n++;
+        else for (it = pd->callbacks[i]->items.item_array; it->func; it++) n++;
+     }
+
+   ext = _efl_object_extension_need(pd);
+   if (EINA_UNLIKELY(!ext)) return;
+   index = malloc(_eo_callbacks_index_size(n));
+   if (EINA_UNLIKELY(!index))
+     {
+        _eo_callbacks_index_drop(pd);
+        return;
+     }
+
+   index->legacy = 0;
+   for (i = 0, n = 0; i < pd->callbacks_count; i++)
+     {
+        if (!pd->callbacks[i]->func_array)
+          {
+             index->items[n].desc = pd->callbacks[i]->items.item.desc;
+             index->items[n++].idx = i;
+          }
+        else for (it = pd->callbacks[i]->items.item_array; it->func; it++)
+          {
+             /* an array listing an event twice is still called once */
+             if ((n > 0) && (index->items[n - 1].idx == i) &&
+                 (index->items[n - 1].desc == it->desc))
+               continue;
+             index->items[n].desc = it->desc;
+             index->items[n++].idx = i;
+          }
+     }
+   index->count = n;
+   for (i = 0; i < n; i++)
+     if (EINA_UNLIKELY(index->items[i].desc->legacy_is)) index->legacy++;
+   qsort(index->items, n, sizeof (Eo_Callback_Index_Item), _eo_callbacks_index_cmp);
+
+   free(ext->callbacks_index);
+   ext->callbacks_index = index;
+}
+
+static Eina_Bool
+_eo_callbacks_index_insert(Efl_Object_Extension *ext,
+                           const Efl_Event_Description *desc,
+                           unsigned int idx)
+{
+   Eo_Callback_Index *index = ext->callbacks_index;
+   unsigned int k;
+
+   k = _eo_callbacks_index_lower(index, desc, idx);
+   if ((k < index->count) &&
+       (index->items[k].desc == desc) &&
+       (index->items[k].idx == idx))
+     return EINA_TRUE;
+
+   if ((index->count & 0xF) == 0x0)
+     {
+        index = realloc(index, _eo_callbacks_index_size(index->count + 1));
+        if (EINA_UNLIKELY(!index)) return EINA_FALSE;
+        ext->callbacks_index = index;
+     }
+
+   memmove(index->items + k + 1, index->items + k,
+           (index->count - k) * sizeof (Eo_Callback_Index_Item));
+   index->items[k].desc = desc;
+   index->items[k].idx = idx;
+   index->count++;
+   if (EINA_UNLIKELY(desc->legacy_is)) index->legacy++;
+   return EINA_TRUE;
+}
+
+/* cb was just inserted at position j of pd->callbacks */
+static void
+_eo_callbacks_index_add(Efl_Object_Data *pd, const Eo_Callback_Description *cb, unsigned int j)
+{
+   const Efl_Callback_Array_Item *it;
+   Eo_Callback_Index *index;
+   unsigned int k;
+
+   index = _eo_callbacks_index_get(pd);
+   if (!index)
+     {
+        if (pd->callbacks_count >= EO_CALLBACKS_INDEX_MIN)
+          _eo_callbacks_index_build(pd);
+        return;
+     }
+
+   if (j + 1 < pd->callbacks_count)
+     {
+        for (k = 0; k < index->count; k++)
+          index->items[k].idx += (index->items[k].idx >= j);
+     }
+
+   if (!cb->func_array)
+     {
+        if (!_eo_callbacks_index_insert(pd->ext, cb->items.item.desc, j))
+          goto on_error;
+     }
+   else for (it = cb->items.item_array; it->func; it++)
+     {
+        if (!_eo_callbacks_index_insert(pd->ext, it->desc, j))
+          goto on_error;
+     }
+   return;
+
+ on_error:
+   // The walkers fall back to a full scan without an index
+   _eo_callbacks_index_drop(pd);
+}
+
+static void
+_eo_callbacks_index_remove(Eo_Callback_Index *index,
+                           const Efl_Event_Description *desc,
+                           unsigned int idx)
+{
+   unsigned int k;
+
+   k = _eo_callbacks_index_lower(index, desc, idx);
+   if ((k == index->count) ||
+       (index->items[k].desc != desc) ||
+       (index->items[k].idx != idx))
+     return;
+
+   memmove(index->items + k, index->items + k + 1,
+           (index->count - k - 1) * sizeof (Eo_Callback_Index_Item));
+   index->count--;
+   if (EINA_UNLIKELY(desc->legacy_is)) index->legacy--;
+}
+
+/* cb at position j of pd->callbacks is about to be removed */
+static void
+_eo_callbacks_index_del(Efl_Object_Data *pd, const Eo_Callback_Description *cb, unsigned int j)
+{
+   const Efl_Callback_Array_Item *it;
+   Eo_Callback_Index *index;
+   unsigned int k;
+
+   index = _eo_callbacks_index_get(pd);
+   if (!index) return;
+   if (pd->callbacks_count - 1 < EO_CALLBACKS_INDEX_MIN / 2)
+     {
+        _eo_callbacks_index_drop(pd);
+        return;
+     }
+
+   if (!cb->func_array)
+     _eo_callbacks_index_remove(index, cb->items.item.desc, j);
+   else for (it = cb->items.item_array; it->func; it++)
+     _eo_callbacks_index_remove(index, it->desc, j);
+
+   if (j + 1 == pd->callbacks_count) return;
+   for (k = 0; k < index->count; k++)
+     index->items[k].idx -= (index->items[k].idx > j);
+}
+
 /* Actually remove, doesn't care about walking list, or delete_me */
 static void
 _eo_callback_remove(Eo *obj, Efl_Object_Data *pd, Eo_Callback_Description **cb)
@@ -1217,6 +1476,7 @@ _eo_callback_remove(Eo *obj, Efl_Object_Data *pd, Eo_Callback_Description **cb)
      }
    else _special_event_count_dec(obj, pd, &((*cb)->items.item));
 
+   _eo_callbacks_index_del(pd, *cb, cb - pd->callbacks);
    _eo_callback_free(*cb);
 
    length = pd->callbacks_count - (cb - pd->callbacks);
@@ -1245,6 +1505,7 @@ _eo_callback_remove_all(Efl_Object_Data *pd)
    eina_freeq_ptr_main_add(pd->callbacks, free, 0);
    pd->callbacks = NULL;
    pd->callbacks_count = 0;
+   _eo_callbacks_index_drop(pd);
    pd->has_destroyed_event_cb = EINA_FALSE;
    pd->event_cb_efl_event_callback_add_count = 0;
    pd->event_cb_efl_event_callback_del_count = 0;
@@ -1280,6 +1541,8 @@ _eo_callbacks_clear(Eo *obj, Efl_Object_Data *pd)
         generation_clamp = 0;
         /* we dont need to clean later */
         pd->need_cleaning = EINA_FALSE;
+        /* rebuilt once below instead of being updated for every removal */
+        _eo_callbacks_index_drop(pd);
      }
 
    while (i < pd->callbacks_count)
@@ -1296,6 +1559,9 @@ _eo_callbacks_clear(Eo *obj, Efl_Object_Data *pd)
              i++;
           }
      }
+
+   if (remove_callbacks && (pd->callbacks_count >= EO_CALLBACKS_INDEX_MIN))
+     _eo_callbacks_index_build(pd);
 }
 
 static inline unsigned int
@@ -1361,6 +1627,7 @@ _eo_callbacks_sorted_insert(Efl_Object_Data *pd, Eo_Callback_Description *cb)
    *itr = cb;
 
    pd->callbacks_count++;
+   _eo_callbacks_index_add(pd, cb, j);
 
    // Update possible event emissions
    for (frame = pd->event_frame; frame; frame = frame->next)
@@ -1440,7 +1707,24 @@ _efl_object_event_callback_del(Eo *obj, Efl_Object_Data *pd,
                                const void *user_data)
 {
    Eo_Callback_Description **cb;
-   unsigned int i;
+   Eo_Callback_Index *index;
+   unsigned int i, k;
+
+   index = _eo_callbacks_index_get(pd);
+   if (index)
+     {
+        for (k = _eo_callbacks_index_lower(index, desc, 0);
+             (k < index->count) && (index->items[k].desc == desc);
+             k++)
+          {
+             cb = pd->callbacks + index->items[k].idx;
+             if (!(*cb)->delete_me && !(*cb)->func_array &&
+                 ((*cb)->items.item.func == func) &&
+                 ((*cb)->func_data == user_data))
+               goto found;
+          }
+        goto not_found;
+     }
 
    for (cb = pd->callbacks, i = 0;
         i < pd->callbacks_count;
@@ -1450,17 +1734,21 @@ _efl_object_event_callback_del(Eo *obj, Efl_Object_Data *pd,
             ((*cb)->items.item.desc == desc) &&
             ((*cb)->items.item.func == func) &&
             ((*cb)->func_data == user_data))
-          {
-             const Efl_Callback_Array_Item_Full arr[] =
-               { {desc, (*cb)->priority, func, (*cb)->func_data}, {NULL, 0, NULL, NULL}};
-
-             _efl_object_event_callback_clean(obj, pd, arr, cb);
-             return EINA_TRUE;
-          }
+          goto found;
      }
 
+not_found:
    DBG("Callback of object %p with function %p and data %p not found.", obj, func, user_data);
    return EINA_FALSE;
+
+found:
+   {
+      const Efl_Callback_Array_Item_Full arr[] =
+        { {desc, (*cb)->priority, func, (*cb)->func_data}, {NULL, 0, NULL, NULL}};
+
+      _efl_object_event_callback_clean(obj, pd, arr, cb);
+   }
+   return EINA_TRUE;
 }
 
 EOAPI EFL_FUNC_BODYV(efl_event_callback_del,
@@ -1552,7 +1840,27 @@ _efl_object_event_callback_array_del(Eo *obj, Efl_Object_Data *pd,
                                      const void *user_data)
 {
    Eo_Callback_Description **cb;
-   unsigned int j;
+   const Efl_Callback_Array_Item *it;
+   Efl_Callback_Array_Item_Full *ev_array;
+   Eo_Callback_Index *index;
+   unsigned int j, k, num, i;
+
+   // Look only among the listeners of the first event of the array
+   index = _eo_callbacks_index_get(pd);
+   if (index && array && array->func)
+     {
+        for (k = _eo_callbacks_index_lower(index, array->desc, 0);
+             (k < index->count) && (index->items[k].desc == array->desc);
+             k++)
+          {
+             cb = pd->callbacks + index->items[k].idx;
+             if (!(*cb)->delete_me && (*cb)->func_array &&
+                 ((*cb)->items.item_array == array) &&
+                 ((*cb)->func_data == user_data))
+               goto found;
+          }
+        goto not_found;
+     }
 
    for (cb = pd->callbacks, j = 0;
         j < pd->callbacks_count;
@@ -1561,32 +1869,30 @@ _efl_object_event_callback_array_del(Eo *obj, Efl_Object_Data *pd,
         if (!(*cb)->delete_me &&
             ((*cb)->items.item_array == array) &&
             ((*cb)->func_data == user_data))
-          {
-             const Efl_Callback_Array_Item *it;
-             unsigned int num, i;
-             Efl_Callback_Array_Item_Full *ev_array;
-
-             num = 0;
-             for (it = (*cb)->items.item_array; it->func; it++) num++;
-             ev_array = alloca((num + 1) * sizeof(Efl_Callback_Array_Item_Full));
-             for (i = 0, it = (*cb)->items.item_array; it->func; it++, i++)
-               {
-                  ev_array[i].desc = (*cb)->items.item_array[i].desc;
-                  ev_array[i].priority = (*cb)->priority;
-                  ev_array[i].func = (*cb)->items.item_array[i].func;
-                  ev_array[i].user_data = (*cb)->func_data;
-               }
-             ev_array[i].desc = NULL;
-             ev_array[i].priority = 0;
-             ev_array[i].func = NULL;
-             ev_array[i].user_data = NULL;
-             _efl_object_event_callback_clean(obj, pd, ev_array, cb);
-             return EINA_TRUE;
-          }
+          goto found;
      }
 
+not_found:
    DBG("Callback of object %p with function array %p and data %p not found.", obj, array, user_data);
    return EINA_FALSE;
+
+found:
+   num = 0;
+   for (it = (*cb)->items.item_array; it->func; it++) num++;
+   ev_array = alloca((num + 1) * sizeof(Efl_Callback_Array_Item_Full));
+   for (i = 0, it = (*cb)->items.item_array; it->func; it++, i++)
+     {
+        ev_array[i].desc = (*cb)->items.item_array[i].desc;
+        ev_array[i].priority = (*cb)->priority;
+        ev_array[i].func = (*cb)->items.item_array[i].func;
+        ev_array[i].user_data = (*cb)->func_data;
+     }
+   ev_array[i].desc = NULL;
+   ev_array[i].priority = 0;
+   ev_array[i].func = NULL;
+   ev_array[i].user_data = NULL;
+   _efl_object_event_callback_clean(obj, pd, ev_array, cb);
+   return EINA_TRUE;
 }
 
 EOAPI EFL_FUNC_BODYV(efl_event_callback_array_del,
@@ -1611,9 +1917,10 @@ _event_callback_call(Eo *obj_id, Efl_Object_Data *pd,
 {
    Eo_Callback_Description **cb;
    Eo_Current_Callback_Description *lookup, saved;
+   Eo_Callback_Index *index;
    Efl_Event ev;
-   unsigned int idx;
-   Eina_Bool callback_already_stopped, ret;
+   unsigned int idx, k, called = 0;
+   Eina_Bool callback_already_stopped, ret, indexed;
    Efl_Event_Callback_Frame frame = {
       .next = NULL,
       .idx = 0,
@@ -1621,6 +1928,9 @@ _event_callback_call(Eo *obj_id, Efl_Object_Data *pd,
       .generation = 1,
    };
 
+   if (EINA_UNLIKELY(_eo_profiler_sampling != 0))
+     _eo_profiler_event_emit(desc);
+
    if (pd->callbacks_count == 0) return EINA_FALSE;
    else if ((desc == EFL_EVENT_CALLBACK_ADD) &&
             (pd->event_cb_efl_event_callback_add_count == 0)) return EINA_FALSE;
@@ -1631,6 +1941,17 @@ _event_callback_call(Eo *obj_id, Efl_Object_Data *pd,
    else if ((desc == EFL_EVENT_NOREF) &&
             (pd->event_cb_efl_event_noref_count == 0)) return EINA_FALSE;
 
+   // Legacy names compare by string, that only the full walk can do
+   index = _eo_callbacks_index_get(pd);
+   indexed = index &&
+     !(legacy_compare && (desc->legacy_is || index->legacy));
+   if (indexed)
+     {
+        k = _eo_callbacks_index_lower(index, desc, 0);
+        if ((k >= index->count) || (index->items[k].desc != desc))
+          return EINA_TRUE;
+     }
+
    if (pd->event_frame)
      frame.generation = ((Efl_Event_Callback_Frame*)pd->event_frame)->generation + 1;
 
@@ -1653,6 +1974,20 @@ restart_back:
 
    for (; idx > 0; idx--)
      {
+        if (indexed)
+          {
+             // Jump to the next listener of desc, the index is kept in
+             // sync with pd->callbacks even while it is being walked.
+             index = _eo_callbacks_index_get(pd);
+             if (EINA_UNLIKELY(!index)) indexed = EINA_FALSE;
+             else
+               {
+                  k = _eo_callbacks_index_lower_hint(index, desc, idx, k - 1);
+                  if ((k == 0) || (index->items[k - 1].desc != desc))
+                    break;
+                  idx = index->items[k - 1].idx + 1;
+               }
+          }
         frame.idx = idx;
         cb = pd->callbacks + idx - 1;
         if (!(*cb)->delete_me)
@@ -1678,6 +2013,7 @@ restart_back:
 
                        // Handle nested restart of walking list
                        if (lookup) lookup->current = idx - 1;
+                       called++;
                        it->func((void *) (*cb)->func_data, &ev);
                        /* Abort callback calling if the func says so. */
                        if (pd->callback_stopped)
@@ -1701,6 +2037,7 @@ restart_back:
 
                   // Handle nested restart of walking list
                   if (lookup) lookup->current = idx - 1;
+                  called++;
                   (*cb)->items.item.func((void *) (*cb)->func_data, &ev);
                   /* Abort callback calling if the func says so. */
                   if (pd->callback_stopped)
@@ -1732,6 +2069,9 @@ end:
 
    pd->callback_stopped = callback_already_stopped;
 
+   if (EINA_UNLIKELY(_eo_profiler_sampling != 0) && called)
+     _eo_profiler_event_listeners(desc, called);
+
    return ret;
 restart:
    EINA_INLIST_FOREACH(pd->current, lookup)
@@ -2154,7 +2494,9 @@ efl_future_chain_array(Eo *obj,
 EOLIAN static Eo *
 _efl_object_constructor(Eo *obj, Efl_Object_Data *pd EINA_UNUSED)
 {
-   DBG("%p - %s.", obj, efl_class_name_get(obj));
+   // the class name is not free to get, once per object
+   if (eina_log_domain_level_check(_eo_log_dom, EINA_LOG_LEVEL_DBG))
+     DBG("%p - %s.", obj, efl_class_name_get(obj));
 
    _eo_condtor_done(obj);
 
@@ -2169,7 +2511,9 @@ _efl_object_destructor(Eo *obj, Efl_Object_Data *pd)
    Efl_Object_Extension *ext;
    _Eo_Object *obj_data2 = NULL;
 
-   DBG("%p - %s.", obj, efl_class_name_get(obj));
+   // the class name is not free to get, once per object
+   if (eina_log_domain_level_check(_eo_log_dom, EINA_LOG_LEVEL_DBG))
+     DBG("%p - %s.", obj, efl_class_name_get(obj));
 
    // special removal - remove from children list by hand after getting
    // child handle in case unparent method is overridden and does
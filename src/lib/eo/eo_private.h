@@ -64,6 +64,8 @@ typedef struct _Efl_Object_Optional Efl_Object_Optional;
 
 /* Allocates an entry for the given object */
 static inline Eo_Id _eo_id_allocate(const _Eo_Object *obj, const Eo *parent_id);
+/* Allocates entries for count objects at once */
+static inline unsigned int _eo_id_allocate_many(_Eo_Object **objs, unsigned int count, const Eo *parent_id);
 
 /* Releases an entry by the object id */
 static inline void _eo_id_release(const Eo_Id obj_id);
@@ -125,6 +127,7 @@ struct _Eo_Object
      Eina_Bool del_triggered:1;
      Eina_Bool destructed:1;
      Eina_Bool manual_free:1;
+     Eina_Bool batched:1; // memory from the batch blocks of the class
      unsigned char auto_unref : 1; // unref after 1 call - hack for parts
 };
 
@@ -171,6 +174,27 @@ typedef struct
    size_t offset;
 } Eo_Extension_Data_Offset;
 
+/* Memory the batches of a class take their objects from, given back with
+ * the class */
+typedef struct _Eo_Objects_Block Eo_Objects_Block;
+struct _Eo_Objects_Block
+{
+   Eo_Objects_Block *next;
+   /* followed by the objects */
+};
+
+/* A call resolved for the objects of a class: what _efl_object_call_resolve()
+ * finds in the vtable and the data scope of the implementing class, in one
+ * place. Never changes once published, so call sites can keep a pointer to
+ * it as their cache. */
+typedef struct _Efl_Object_Call_Cache Eo_Call_Record;
+struct _Efl_Object_Call_Cache
+{
+   const _Efl_Class *klass;
+   Eo_Op_Func_Type func;
+   unsigned int data_offset; /* 0 if the implementing class has no data */
+};
+
 struct _Efl_Class
 {
    Eo_Header header;
@@ -178,6 +202,9 @@ struct _Efl_Class
    const _Efl_Class *parent;
    const Efl_Class_Description *desc;
    Eo_Vtable vtable;
+   /* Records of the resolved calls, one block of DICH_CHAIN_LAST_SIZE per
+    * vtable chain, built on first use. */
+   Eo_Call_Record **calls;
 
    const _Efl_Class **extensions;
 
@@ -192,6 +219,9 @@ struct _Efl_Class
       Eina_Trash  *trash;
       Eina_Spinlock    trash_lock;
       unsigned int trash_count;
+      /* memory of the objects created by efl_add_batch(), never given back
+       * before the class is freed */
+      Eo_Objects_Block *blocks;
    } objects;
 
    /* cached iterator for faster allocation cycle */
@@ -329,6 +359,22 @@ _obj_is_override(_Eo_Object *obj)
 
 void _eo_free(_Eo_Object *obj, Eina_Bool manual_free);
 
+/* The profiler, see eo_profiler.c. The sampling is 0 when it is stopped, the
+ * hooks must only be called when it isn't. */
+extern unsigned int _eo_profiler_sampling;
+
+void _eo_profiler_init(void);
+void _eo_profiler_shutdown(void);
+void _eo_profiler_call_begin(Efl_Object_Op_Call_Data *call, Efl_Object_Op op, const _Efl_Class *klass);
+void _eo_profiler_call_end(Efl_Object_Op_Call_Data *call);
+void _eo_profiler_object_new(const _Eo_Object *obj);
+void _eo_profiler_object_free(const _Eo_Object *obj);
+void _eo_profiler_event_emit(const Efl_Event_Description *desc);
+void _eo_profiler_event_listeners(const Efl_Event_Description *desc, unsigned int count);
+
+const _Efl_Class *_eo_op_class_get(Efl_Object_Op op);
+void _eo_op_names_get(const char **names, unsigned int count);
+
 static inline _Eo_Object *
 _efl_ref(_Eo_Object *obj)
 {
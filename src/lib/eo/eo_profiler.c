@@ -0,0 +1,751 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef _WIN32
+# include <Evil.h>
+#endif
+
+#include <Eina.h>
+
+#include "Eo.h"
+#include "eo_ptr_indirection.h"
+#include "eo_private.h"
+
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+#define SWAP_32(x) x
+#else
+#define SWAP_32(x) eina_swap32(x)
+#endif
+
+/*
+ * The Eo profiler counts calls per op and per class, event emissions and
+ * the listeners they reached, and the lifetime of objects per class.
+ *
+ * Every thread writes its own buffer, found through a TLS, so counting
+ * needs no lock nor atomic operation. Ops and classes are counted in tables
+ * of blocks indexed by op and class id, blocks are allocated on first use
+ * and published with a release store, so the report can be built from
+ * another thread (the eina_debug one) while the counters keep changing.
+ * Blocks and buffers are only freed at shutdown. The buffer of a thread that
+ * exits is adopted by the next thread that needs one, its counters are
+ * merged into the report anyway.
+ *
+ * Only one call out of _eo_profiler_sampling is timed: its counter is kept
+ * in call->extn1 and its start time in call->extn2 until
+ * _efl_object_call_end().
+ */
+
+#define EO_PROFILER_BLOCK_SHIFT 8
+#define EO_PROFILER_BLOCK_SIZE (1 << EO_PROFILER_BLOCK_SHIFT)
+#define EO_PROFILER_BLOCK_MASK (EO_PROFILER_BLOCK_SIZE - 1)
+#define EO_PROFILER_BLOCKS 256
+
+/* Must be a power of 2 */
+#define EO_PROFILER_EVENTS 512
+
+/* Bucket n counts the lifetimes below 2^(n+1) microseconds, the last one
+ * counts all the longer ones. */
+#define EO_PROFILER_LIFETIMES 24
+
+typedef struct
+{
+   uint64_t calls;
+   uint64_t samples;
+   uint64_t time; /* of the samples, in ns */
+} Eo_Profiler_Op;
+
+typedef struct
+{
+   const _Efl_Class *klass;
+   uint64_t calls;
+   uint64_t created;
+   uint64_t freed;
+   uint64_t lifetimes[EO_PROFILER_LIFETIMES];
+} Eo_Profiler_Class;
+
+typedef struct
+{
+   const Efl_Event_Description *desc;
+   uint64_t emitted;
+   uint64_t listeners;
+} Eo_Profiler_Event;
+
+typedef struct _Eo_Profiler_Thread Eo_Profiler_Thread;
+struct _Eo_Profiler_Thread
+{
+   Eo_Profiler_Thread *next;
+   Eo_Profiler_Op *ops[EO_PROFILER_BLOCKS];
+   Eo_Profiler_Class *classes[EO_PROFILER_BLOCKS];
+   Eo_Profiler_Event events[EO_PROFILER_EVENTS];
+   uint64_t events_lost;
+   unsigned int tick;
+   Eina_Bool orphan : 1;
+};
+
+unsigned int _eo_profiler_sampling = 0;
+
+static Eina_Bool _eo_profiler_initted = EINA_FALSE;
+/* Created once, the eina_debug callbacks may come after a shutdown */
+static Eina_Bool _eo_profiler_lock_created = EINA_FALSE;
+static Eina_Lock _eo_profiler_lock;
+static Eina_TLS _eo_profiler_tls;
+static Eo_Profiler_Thread *_eo_profiler_threads = NULL;
+
+/* Birth time in us + 1 of the objects created while profiling */
+static Eina_Spinlock _eo_profiler_births_lock;
+static Eina_Hash *_eo_profiler_births = NULL;
+
+static int _eo_profiler_get_opcode = EINA_DEBUG_OPCODE_INVALID;
+
+static inline uint64_t
+_eo_profiler_time_get(void)
+{
+#if defined (HAVE_CLOCK_GETTIME) || defined (EXOTIC_PROVIDE_CLOCK_GETTIME)
+   struct timespec t;
+
+   if (EINA_LIKELY(!clock_gettime(CLOCK_MONOTONIC, &t)))
+     return ((uint64_t) t.tv_sec * 1000000000) + t.tv_nsec;
+#elif defined(_WIN32)
+   return (uint64_t) (evil_time_get() * 1000000000.0);
+#endif
+   {
+      struct timeval timev;
+
+      gettimeofday(&timev, NULL);
+      return ((uint64_t) timev.tv_sec * 1000000000) +
+        ((uint64_t) timev.tv_usec * 1000);
+   }
+}
+
+static void *
+_eo_profiler_slot_get(void **blocks, unsigned int idx, size_t size)
+{
+   unsigned int b = idx >> EO_PROFILER_BLOCK_SHIFT;
+   char *block;
+
+   if (EINA_UNLIKELY(b >= EO_PROFILER_BLOCKS)) return NULL;
+   block = blocks[b];
+   if (EINA_UNLIKELY(!block))
+     {
+        block = calloc(EO_PROFILER_BLOCK_SIZE, size);
+        if (!block) return NULL;
+        __atomic_store_n(&blocks[b], block, __ATOMIC_RELEASE);
+     }
+   return block + ((idx & EO_PROFILER_BLOCK_MASK) * size);
+}
+
+/* For the report, NULL if the slot was never used */
+static const void *
+_eo_profiler_slot_peek(void * const *blocks, unsigned int idx, size_t size)
+{
+   const char *block;
+
+   block = __atomic_load_n(&blocks[idx >> EO_PROFILER_BLOCK_SHIFT], __ATOMIC_ACQUIRE);
+   if (!block) return NULL;
+   return block + ((idx & EO_PROFILER_BLOCK_MASK) * size);
+}
+
+static void
+_eo_profiler_thread_del_cb(void *data)
+{
+   Eo_Profiler_Thread *pt = data;
+
+   eina_lock_take(&_eo_profiler_lock);
+   pt->orphan = EINA_TRUE;
+   eina_lock_release(&_eo_profiler_lock);
+}
+
+static Eo_Profiler_Thread *
+_eo_profiler_thread_get(void)
+{
+   Eo_Profiler_Thread *pt;
+
+   pt = eina_tls_get(_eo_profiler_tls);
+   if (EINA_LIKELY(pt != NULL)) return pt;
+
+   eina_lock_take(&_eo_profiler_lock);
+   if (!_eo_profiler_initted) goto end;
+   for (pt = _eo_profiler_threads; pt; pt = pt->next)
+     {
+        if (pt->orphan) break;
+     }
+   if (pt) pt->orphan = EINA_FALSE;
+   else
+     {
+        pt = calloc(1, sizeof(Eo_Profiler_Thread));
+        if (!pt) goto end;
+        pt->next = _eo_profiler_threads;
+        _eo_profiler_threads = pt;
+     }
+   eina_tls_set(_eo_profiler_tls, pt);
+end:
+   eina_lock_release(&_eo_profiler_lock);
+   return pt;
+}
+
+static inline Eo_Profiler_Class *
+_eo_profiler_class_get(Eo_Profiler_Thread *pt, const _Efl_Class *klass)
+{
+   Eo_Profiler_Class *pc;
+   Eo_Id id = (Eo_Id) _eo_class_id_get(klass) - MASK_CLASS_TAG;
+
+   pc = _eo_profiler_slot_get((void **) pt->classes, (unsigned int) id,
+                              sizeof(Eo_Profiler_Class));
+   if (pc) pc->klass = klass;
+   return pc;
+}
+
+static Eo_Profiler_Event *
+_eo_profiler_event_get(Eo_Profiler_Thread *pt, const Efl_Event_Description *desc)
+{
+   unsigned int i, k;
+
+   k = (unsigned int) (((uintptr_t) desc >> 4) * 2654435761u);
+   for (i = 0 ; i < EO_PROFILER_EVENTS ; i++, k++)
+     {
+        Eo_Profiler_Event *pe = &pt->events[k & (EO_PROFILER_EVENTS - 1)];
+
+        if (pe->desc == desc) return pe;
+        if (!pe->desc)
+          {
+             __atomic_store_n(&pe->desc, desc, __ATOMIC_RELEASE);
+             return pe;
+          }
+     }
+   pt->events_lost++;
+   return NULL;
+}
+
+void
+_eo_profiler_call_begin(Efl_Object_Op_Call_Data *call, Efl_Object_Op op,
+                        const _Efl_Class *klass)
+{
+   Eo_Profiler_Thread *pt = _eo_profiler_thread_get();
+   Eo_Profiler_Class *pc;
+   Eo_Profiler_Op *po;
+
+   if (!pt) return;
+   po = _eo_profiler_slot_get((void **) pt->ops, op, sizeof(Eo_Profiler_Op));
+   if (!po) return;
+   po->calls++;
+   if (klass && (pc = _eo_profiler_class_get(pt, klass))) pc->calls++;
+
+   if (++pt->tick < _eo_profiler_sampling) return;
+   pt->tick = 0;
+   call->extn1 = po;
+   call->extn2 = (void *) (uintptr_t) _eo_profiler_time_get();
+}
+
+void
+_eo_profiler_call_end(Efl_Object_Op_Call_Data *call)
+{
+   Eo_Profiler_Op *po = call->extn1;
+
+   // Only the low bits on 32 bits, the difference is still right
+   po->time += (uintptr_t) _eo_profiler_time_get() - (uintptr_t) call->extn2;
+   po->samples++;
+}
+
+void
+_eo_profiler_object_new(const _Eo_Object *obj)
+{
+   Eo_Profiler_Thread *pt = _eo_profiler_thread_get();
+   Eo_Profiler_Class *pc;
+   uintptr_t birth;
+
+   if (!pt) return;
+   pc = _eo_profiler_class_get(pt, obj->klass);
+   if (pc) pc->created++;
+
+   birth = (uintptr_t) (_eo_profiler_time_get() / 1000) + 1;
+   eina_spinlock_take(&_eo_profiler_births_lock);
+   if (_eo_profiler_births)
+     {
+        if (!eina_hash_add(_eo_profiler_births, &obj, (void *) birth))
+          eina_hash_modify(_eo_profiler_births, &obj, (void *) birth);
+     }
+   eina_spinlock_release(&_eo_profiler_births_lock);
+}
+
+void
+_eo_profiler_object_free(const _Eo_Object *obj)
+{
+   Eo_Profiler_Thread *pt = _eo_profiler_thread_get();
+   Eo_Profiler_Class *pc;
+   uintptr_t birth = 0, lifetime;
+   unsigned int bucket = 0;
+
+   if (!pt) return;
+   pc = _eo_profiler_class_get(pt, obj->klass);
+   if (!pc) return;
+   pc->freed++;
+
+   eina_spinlock_take(&_eo_profiler_births_lock);
+   if (_eo_profiler_births)
+     birth = (uintptr_t) eina_hash_find(_eo_profiler_births, &obj);
+   if (birth) eina_hash_del_by_key(_eo_profiler_births, &obj);
+   eina_spinlock_release(&_eo_profiler_births_lock);
+   // Born before the profiler started
+   if (!birth) return;
+
+   lifetime = ((uintptr_t) (_eo_profiler_time_get() / 1000) + 1 - birth) >> 1;
+   while (lifetime && (bucket < EO_PROFILER_LIFETIMES - 1))
+     {
+        lifetime >>= 1;
+        bucket++;
+     }
+   pc->lifetimes[bucket]++;
+}
+
+void
+_eo_profiler_event_emit(const Efl_Event_Description *desc)
+{
+   Eo_Profiler_Thread *pt = _eo_profiler_thread_get();
+   Eo_Profiler_Event *pe;
+
+   if (!pt) return;
+   pe = _eo_profiler_event_get(pt, desc);
+   if (pe) pe->emitted++;
+}
+
+void
+_eo_profiler_event_listeners(const Efl_Event_Description *desc, unsigned int count)
+{
+   Eo_Profiler_Thread *pt = _eo_profiler_thread_get();
+   Eo_Profiler_Event *pe;
+
+   if (!pt) return;
+   pe = _eo_profiler_event_get(pt, desc);
+   if (pe) pe->listeners += count;
+}
+
+/* Report */
+
+typedef struct
+{
+   Efl_Object_Op op;
+   Eo_Profiler_Op sum;
+} Eo_Profiler_Op_Report;
+
+typedef struct
+{
+   const char *name;
+   Eo_Profiler_Event sum;
+} Eo_Profiler_Event_Report;
+
+static int
+_eo_profiler_op_cmp(const void *a, const void *b)
+{
+   const Eo_Profiler_Op_Report *ra = a, *rb = b;
+
+   if (ra->sum.calls != rb->sum.calls)
+     return (ra->sum.calls < rb->sum.calls) ? 1 : -1;
+   return (int) ra->op - (int) rb->op;
+}
+
+static int
+_eo_profiler_class_cmp(const void *a, const void *b)
+{
+   const Eo_Profiler_Class *ca = a, *cb = b;
+
+   if (ca->calls != cb->calls) return (ca->calls < cb->calls) ? 1 : -1;
+   if (ca->created != cb->created) return (ca->created < cb->created) ? 1 : -1;
+   return strcmp(ca->klass->desc->name, cb->klass->desc->name);
+}
+
+static int
+_eo_profiler_event_cmp(const void *a, const void *b)
+{
+   const Eo_Profiler_Event_Report *ea = a, *eb = b;
+
+   if (ea->sum.emitted != eb->sum.emitted)
+     return (ea->sum.emitted < eb->sum.emitted) ? 1 : -1;
+   return strcmp(ea->name, eb->name);
+}
+
+/* The highest slot in use by any thread, plus one */
+static unsigned int
+_eo_profiler_slots_count(size_t offset)
+{
+   Eo_Profiler_Thread *pt;
+   unsigned int count = 0, b;
+
+   for (pt = _eo_profiler_threads; pt; pt = pt->next)
+     {
+        void * const *blocks = (void * const *) ((char *) pt + offset);
+
+        for (b = EO_PROFILER_BLOCKS ; b > 0 ; b--)
+          {
+             if (__atomic_load_n(&blocks[b - 1], __ATOMIC_ACQUIRE)) break;
+          }
+        if ((b * EO_PROFILER_BLOCK_SIZE) > count)
+          count = b * EO_PROFILER_BLOCK_SIZE;
+     }
+   return count;
+}
+
+static void
+_eo_profiler_report_ops(Eina_Strbuf *buf)
+{
+   Eo_Profiler_Op_Report *ops;
+   Eo_Profiler_Thread *pt;
+   const char **names;
+   unsigned int count, used = 0, i;
+
+   count = _eo_profiler_slots_count(offsetof(Eo_Profiler_Thread, ops));
+   if (!count) return;
+   ops = calloc(count, sizeof(Eo_Profiler_Op_Report));
+   names = calloc(count, sizeof(const char *));
+   if (!ops || !names) goto end;
+
+   for (i = 0 ; i < count ; i++)
+     {
+        Eo_Profiler_Op_Report *r = &ops[used];
+
+        r->op = i;
+        for (pt = _eo_profiler_threads; pt; pt = pt->next)
+          {
+             const Eo_Profiler_Op *po;
+
+             po = _eo_profiler_slot_peek((void * const *) pt->ops, i, sizeof(*po));
+             if (!po) continue;
+             r->sum.calls += po->calls;
+             r->sum.samples += po->samples;
+             r->sum.time += po->time;
+          }
+        if (r->sum.calls) used++;
+     }
+   qsort(ops, used, sizeof(Eo_Profiler_Op_Report), _eo_profiler_op_cmp);
+   _eo_op_names_get(names, count);
+
+   eina_strbuf_append(buf, "# op\tname\tclass\tcalls\tsamples\tsamples_ns\testimated_ns\n");
+   eina_lock_take(&_efl_class_creation_lock);
+   for (i = 0 ; i < used ; i++)
+     {
+        const Eo_Profiler_Op_Report *r = &ops[i];
+        const _Efl_Class *klass = _eo_op_class_get(r->op);
+        uint64_t estimated = 0;
+
+        if (r->sum.samples)
+          estimated = (uint64_t) (((double) r->sum.time / r->sum.samples) * r->sum.calls);
+        eina_strbuf_append_printf(buf, "op\t%s\t%s\t%llu\t%llu\t%llu\t%llu\n",
+                                  names[r->op] ? names[r->op] : "unknown",
+                                  klass ? klass->desc->name : "unknown",
+                                  (unsigned long long) r->sum.calls,
+                                  (unsigned long long) r->sum.samples,
+                                  (unsigned long long) r->sum.time,
+                                  (unsigned long long) estimated);
+     }
+   eina_lock_release(&_efl_class_creation_lock);
+
+end:
+   free(names);
+   free(ops);
+}
+
+static void
+_eo_profiler_report_classes(Eina_Strbuf *buf)
+{
+   Eo_Profiler_Class *classes;
+   Eo_Profiler_Thread *pt;
+   unsigned int count, used = 0, i, k;
+
+   count = _eo_profiler_slots_count(offsetof(Eo_Profiler_Thread, classes));
+   if (!count) return;
+   classes = calloc(count, sizeof(Eo_Profiler_Class));
+   if (!classes) return;
+
+   for (i = 0 ; i < count ; i++)
+     {
+        Eo_Profiler_Class *r = &classes[used];
+
+        for (pt = _eo_profiler_threads; pt; pt = pt->next)
+          {
+             const Eo_Profiler_Class *pc;
+
+             pc = _eo_profiler_slot_peek((void * const *) pt->classes, i, sizeof(*pc));
+             if (!pc || !pc->klass) continue;
+             r->klass = pc->klass;
+             r->calls += pc->calls;
+             r->created += pc->created;
+             r->freed += pc->freed;
+             for (k = 0 ; k < EO_PROFILER_LIFETIMES ; k++)
+               r->lifetimes[k] += pc->lifetimes[k];
+          }
+        if (r->klass) used++;
+     }
+   qsort(classes, used, sizeof(Eo_Profiler_Class), _eo_profiler_class_cmp);
+
+   eina_strbuf_append(buf, "# class\tname\tcalls\tcreated\tfreed\n");
+   for (i = 0 ; i < used ; i++)
+     eina_strbuf_append_printf(buf, "class\t%s\t%llu\t%llu\t%llu\n",
+                               classes[i].klass->desc->name,
+                               (unsigned long long) classes[i].calls,
+                               (unsigned long long) classes[i].created,
+                               (unsigned long long) classes[i].freed);
+
+   eina_strbuf_append_printf(buf, "# lifetime\tname\tcounts below 2^(n+1) us for n in [0, %d[, then above\n",
+                             EO_PROFILER_LIFETIMES - 1);
+   for (i = 0 ; i < used ; i++)
+     {
+        if (!classes[i].freed) continue;
+        eina_strbuf_append_printf(buf, "lifetime\t%s", classes[i].klass->desc->name);
+        for (k = 0 ; k < EO_PROFILER_LIFETIMES ; k++)
+          eina_strbuf_append_printf(buf, "\t%llu", (unsigned long long) classes[i].lifetimes[k]);
+        eina_strbuf_append_char(buf, '\n');
+     }
+   free(classes);
+}
+
+static void
+_eo_profiler_report_events(Eina_Strbuf *buf)
+{
+   Eo_Profiler_Event_Report *events = NULL, *tmp;
+   Eo_Profiler_Thread *pt;
+   unsigned int used = 0, size = 0, i, k;
+   uint64_t lost = 0;
+
+   for (pt = _eo_profiler_threads; pt; pt = pt->next)
+     {
+        lost += pt->events_lost;
+        for (i = 0 ; i < EO_PROFILER_EVENTS ; i++)
+          {
+             const Eo_Profiler_Event *pe = &pt->events[i];
+             const Efl_Event_Description *desc;
+
+             desc = __atomic_load_n(&pe->desc, __ATOMIC_ACQUIRE);
+             if (!desc) continue;
+             // Events are few, a linear search is fine
+             for (k = 0 ; k < used ; k++)
+               {
+                  if (events[k].sum.desc == desc) break;
+               }
+             if (k == used)
+               {
+                  if (used == size)
+                    {
+                       size += EO_PROFILER_EVENTS;
+                       tmp = realloc(events, size * sizeof(Eo_Profiler_Event_Report));
+                       if (!tmp) goto end;
+                       events = tmp;
+                    }
+                  memset(&events[k], 0, sizeof(Eo_Profiler_Event_Report));
+                  events[k].sum.desc = desc;
+                  events[k].name = desc->name ? desc->name : "unknown";
+                  used++;
+               }
+             events[k].sum.emitted += pe->emitted;
+             events[k].sum.listeners += pe->listeners;
+          }
+     }
+   qsort(events, used, sizeof(Eo_Profiler_Event_Report), _eo_profiler_event_cmp);
+
+   eina_strbuf_append(buf, "# event\tname\temitted\tlisteners\n");
+   for (i = 0 ; i < used ; i++)
+     eina_strbuf_append_printf(buf, "event\t%s\t%llu\t%llu\n", events[i].name,
+                               (unsigned long long) events[i].sum.emitted,
+                               (unsigned long long) events[i].sum.listeners);
+   if (lost)
+     eina_strbuf_append_printf(buf, "# %llu emissions of events not counted\n",
+                               (unsigned long long) lost);
+end:
+   free(events);
+}
+
+EAPI char *
+efl_object_profiler_report_get(void)
+{
+   Eina_Strbuf *buf;
+
+   eina_lock_take(&_eo_profiler_lock);
+   if (!_eo_profiler_initted)
+     {
+        eina_lock_release(&_eo_profiler_lock);
+        return NULL;
+     }
+   buf = eina_strbuf_new();
+   eina_strbuf_append_printf(buf, "# Eo profile, one call out of %u timed\n",
+                             _eo_profiler_sampling);
+   _eo_profiler_report_ops(buf);
+   _eo_profiler_report_classes(buf);
+   _eo_profiler_report_events(buf);
+   eina_lock_release(&_eo_profiler_lock);
+
+   return eina_strbuf_release(buf);
+}
+
+EAPI void
+efl_object_profiler_start(unsigned int sampling)
+{
+   if (!sampling)
+     {
+        efl_object_profiler_stop();
+        return;
+     }
+   eina_lock_take(&_eo_profiler_lock);
+   if (_eo_profiler_initted)
+     {
+        eina_spinlock_take(&_eo_profiler_births_lock);
+        if (!_eo_profiler_births)
+          _eo_profiler_births = eina_hash_pointer_new(NULL);
+        eina_spinlock_release(&_eo_profiler_births_lock);
+        _eo_profiler_sampling = sampling;
+     }
+   eina_lock_release(&_eo_profiler_lock);
+}
+
+EAPI void
+efl_object_profiler_stop(void)
+{
+   Eina_Hash *births;
+
+   eina_lock_take(&_eo_profiler_lock);
+   _eo_profiler_sampling = 0;
+   if (_eo_profiler_initted)
+     {
+        // The objects still alive won't be freed while profiling
+        eina_spinlock_take(&_eo_profiler_births_lock);
+        births = _eo_profiler_births;
+        _eo_profiler_births = NULL;
+        eina_spinlock_release(&_eo_profiler_births_lock);
+        eina_hash_free(births);
+     }
+   eina_lock_release(&_eo_profiler_lock);
+}
+
+EAPI void
+efl_object_profiler_reset(void)
+{
+   Eo_Profiler_Thread *pt;
+   unsigned int b;
+
+   // The counters may be written at the same time, a few counts may be
+   // missed, but nothing is freed.
+   eina_lock_take(&_eo_profiler_lock);
+   for (pt = _eo_profiler_threads; pt; pt = pt->next)
+     {
+        for (b = 0 ; b < EO_PROFILER_BLOCKS ; b++)
+          {
+             if (pt->ops[b])
+               memset(pt->ops[b], 0, EO_PROFILER_BLOCK_SIZE * sizeof(Eo_Profiler_Op));
+             if (pt->classes[b])
+               memset(pt->classes[b], 0, EO_PROFILER_BLOCK_SIZE * sizeof(Eo_Profiler_Class));
+          }
+        memset(pt->events, 0, sizeof(pt->events));
+        pt->events_lost = 0;
+     }
+   eina_lock_release(&_eo_profiler_lock);
+}
+
+/* eina_debug, the callbacks are called from the debug thread */
+
+static Eina_Bool
+_eo_profiler_on_cb(Eina_Debug_Session *session EINA_UNUSED, int cid EINA_UNUSED, void *buffer, int size)
+{
+   unsigned int sampling = 1;
+
+   if (size >= (int) sizeof(int))
+     {
+        int val;
+
+        memcpy(&val, buffer, sizeof(int));
+        val = SWAP_32(val);
+        if (val > 0) sampling = val;
+     }
+   efl_object_profiler_start(sampling);
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eo_profiler_off_cb(Eina_Debug_Session *session EINA_UNUSED, int cid EINA_UNUSED, void *buffer EINA_UNUSED, int size EINA_UNUSED)
+{
+   efl_object_profiler_stop();
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eo_profiler_reset_cb(Eina_Debug_Session *session EINA_UNUSED, int cid EINA_UNUSED, void *buffer EINA_UNUSED, int size EINA_UNUSED)
+{
+   efl_object_profiler_reset();
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_eo_profiler_get_cb(Eina_Debug_Session *session, int cid, void *buffer EINA_UNUSED, int size EINA_UNUSED)
+{
+   char *report = efl_object_profiler_report_get();
+
+   // Always reply, so the client doesn't wait for nothing
+   eina_debug_session_send(session, cid, _eo_profiler_get_opcode, report,
+                           report ? strlen(report) + 1 : 0);
+   free(report);
+   return EINA_TRUE;
+}
+
+EINA_DEBUG_OPCODES_ARRAY_DEFINE(_EO_PROFILER_OPS,
+      {"Eo/Profiler/on", NULL, &_eo_profiler_on_cb},
+      {"Eo/Profiler/off", NULL, &_eo_profiler_off_cb},
+      {"Eo/Profiler/reset", NULL, &_eo_profiler_reset_cb},
+      {"Eo/Profiler/get", &_eo_profiler_get_opcode, &_eo_profiler_get_cb},
+      {NULL, NULL, NULL}
+);
+
+void
+_eo_profiler_init(void)
+{
+   const char *s;
+
+   // The debug opcodes can't be unregistered, so they are registered once
+   if (!_eo_profiler_lock_created)
+     {
+        if (!eina_lock_new(&_eo_profiler_lock)) return;
+        _eo_profiler_lock_created = EINA_TRUE;
+        eina_debug_opcodes_register(NULL, _EO_PROFILER_OPS(), NULL, NULL);
+     }
+   if (!eina_spinlock_new(&_eo_profiler_births_lock)) return;
+   if (!eina_tls_cb_new(&_eo_profiler_tls, _eo_profiler_thread_del_cb))
+     {
+        eina_spinlock_free(&_eo_profiler_births_lock);
+        return;
+     }
+   eina_lock_take(&_eo_profiler_lock);
+   _eo_profiler_initted = EINA_TRUE;
+   eina_lock_release(&_eo_profiler_lock);
+
+   s = getenv("EO_PROFILE");
+   if (s && (atoi(s) > 0)) efl_object_profiler_start(atoi(s));
+}
+
+void
+_eo_profiler_shutdown(void)
+{
+   Eo_Profiler_Thread *pt;
+   unsigned int b;
+
+   if (!_eo_profiler_initted) return;
+   efl_object_profiler_stop();
+
+   eina_lock_take(&_eo_profiler_lock);
+   _eo_profiler_initted = EINA_FALSE;
+   while (_eo_profiler_threads)
+     {
+        pt = _eo_profiler_threads;
+        _eo_profiler_threads = pt->next;
+        for (b = 0 ; b < EO_PROFILER_BLOCKS ; b++)
+          {
+             free(pt->ops[b]);
+             free(pt->classes[b]);
+          }
+        free(pt);
+     }
+   eina_lock_release(&_eo_profiler_lock);
+
+   eina_tls_free(_eo_profiler_tls);
+   eina_spinlock_free(&_eo_profiler_births_lock);
+}
@@ -80,6 +80,7 @@ _Eo_Object *
 _eo_obj_pointer_get(const Eo_Id obj_id, const char *func_name, const char *file, int line)
 {
    _Eo_Id_Entry *entry;
+   _Eo_Object *entry_ptr;
    Generation_Counter generation;
    Table_Index mid_table_id, table_id, entry_id;
    Eo_Id tag_bit;
@@ -135,48 +136,22 @@ _eo_obj_pointer_get(const Eo_Id obj_id, const char *func_name, const char *file,
      }
    else
      {
-        eina_lock_take(&(_eo_table_data_shared_data->obj_lock));
-        if (obj_id == tdata->cache.id)
-        // yes we return keeping the lock locked. thats why
-        // you must call _eo_obj_pointer_done() wrapped
-        // by EO_OBJ_DONE() to release
-          return tdata->cache.object;
+        // The table itself needs no lock, but the object is only accessed
+        // by one thread at a time. Yes we return keeping the lock locked,
+        // thats why you must call _eo_obj_pointer_done() wrapped by
+        // EO_OBJ_DONE() to release
+        eina_lock_take(&(tdata->obj_lock));
 
-        mid_table_id = (obj_id >> SHIFT_MID_TABLE_ID) & MASK_MID_TABLE_ID;
-        EINA_PREFETCH(&(tdata->eo_ids_tables[mid_table_id]));
-        table_id = (obj_id >> SHIFT_TABLE_ID) & MASK_TABLE_ID;
-        entry_id = (obj_id >> SHIFT_ENTRY_ID) & MASK_ENTRY_ID;
-        generation = obj_id & MASK_GENERATIONS;
-
-        // get tag bit to check later down below - pipelining
         tag_bit = (obj_id) & MASK_OBJ_TAG;
         if (!obj_id) goto err_shared_null;
         else if (!tag_bit) goto err_shared;
 
-        // Check the validity of the entry
-        if (tdata->eo_ids_tables[mid_table_id])
-          {
-             _Eo_Ids_Table *tab = TABLE_FROM_IDS;
-
-             if (tab)
-               {
-                  entry = &(tab->entries[entry_id]);
-                  if (entry->active && (entry->generation == generation))
-                    {
-                       // Cache the result of that lookup
-                       tdata->cache.object = entry->ptr;
-                       tdata->cache.id = obj_id;
-                       // yes we return keeping the lock locked. thats why
-                       // you must call _eo_obj_pointer_done() wrapped
-                       // by EO_OBJ_DONE() to release
-                       return entry->ptr;
-                    }
-               }
-          }
+        entry_ptr = _eo_id_shared_lookup(data, tdata, obj_id);
+        if (entry_ptr) return entry_ptr;
         goto err_shared;
      }
 err_shared_null:
-   eina_lock_release(&(_eo_table_data_shared_data->obj_lock));
+   _eo_obj_pointer_done(obj_id);
 err_null:
    eina_log_print(_eo_log_dom,
                   EINA_LOG_LEVEL_DBG,
@@ -184,7 +159,7 @@ err_null:
                   "obj_id is NULL. Possibly unintended access?");
    return NULL;
 err_shared:
-   eina_lock_release(&(_eo_table_data_shared_data->obj_lock));
+   _eo_obj_pointer_done(obj_id);
 err:
    _eo_obj_pointer_invalid(obj_id, data, domain, func_name, file, line);
    return NULL;
@@ -60,6 +60,17 @@
  * and is reused prior to the others untill it is full.
  * When an object is freed, the entry into the table is released by appending
  * it to the fifo.
+ *
+ * The tables of the shared domain are read without the table lock: only the
+ * allocation and the release of entries take it. For this, the tables are
+ * published with release stores and read with acquire loads, the active
+ * flag and the generation of an entry are read together with one atomic
+ * load before and after reading its pointer, and the tables of the shared
+ * domain are never freed nor recycled before the shutdown of eo, so a
+ * reader can never look into memory given back to the system. A lookup
+ * still holds the objects lock until EO_OBJ_DONE(), and objects are only
+ * freed by a thread holding it, so a shared object can not go away while
+ * another thread uses it.
  */
 
 // enable this to test and use all 64bits of a pointer, otherwise limit to
@@ -253,11 +264,18 @@ typedef struct
    _Eo_Object *ptr;
    /* Indicates where to find the next entry to recycle */
    Table_Index next_in_fifo;
-   /* Active flag */
-   unsigned int active     : 1;
-   /* Generation */
-   unsigned int generation : BITS_GENERATION_COUNTER;
-
+   union
+     {
+        struct
+          {
+             /* Active flag */
+             unsigned int active     : 1;
+             /* Generation */
+             unsigned int generation : BITS_GENERATION_COUNTER;
+          };
+        /* Both of them, for the atomic accesses of the shared domain */
+        unsigned int state;
+     };
 } _Eo_Id_Entry;
 
 /* Table */
@@ -300,8 +318,10 @@ struct _Eo_Id_Table_Data
    _Eo_Ids_Table      *current_table;
    /* Spare empty table */
    _Eo_Ids_Table      *empty_table;
-   /* Optional lock around all objects in eoid table - only used if shared */
+   /* Optional lock around all accesses to the objects - only used if shared */
    Eina_Lock           obj_lock;
+   /* Optional lock around changes of the tables - only used if shared */
+   Eina_Lock           table_lock;
    /* Next generation to use when assigning a new entry to a Eo pointer */
    Generation_Counter  generation;
    /* are we shared so we need lock/unlock? */
@@ -311,6 +331,22 @@ struct _Eo_Id_Table_Data
 struct _Eo_Id_Data
 {
    Eo_Id_Table_Data   *tables[4];
+   /* Cached lookups of this thread in the shared domain, other threads
+    * can release the objects so they are checked against the state of
+    * their entry, which stays readable until shutdown */
+   struct
+     {
+        Eo_Id             id;
+        _Eo_Object       *object;
+        unsigned int     *state;
+        unsigned int      expect;
+        const Eo         *isa_id;
+        const Efl_Class  *klass;
+        unsigned int     *isa_state;
+        unsigned int      isa_expect;
+        Eina_Bool         isa;
+     }
+   shared_cache;
    unsigned char       local_domain;
    unsigned char       stack_top;
    unsigned char       domain_stack[255 - (sizeof(void *) * 4) - 2];
@@ -334,6 +370,12 @@ _eo_table_data_table_new(Efl_Id_Domain domain)
              free(tdata);
              return NULL;
           }
+        if (!eina_lock_new(&(tdata->table_lock)))
+          {
+             eina_lock_free(&(tdata->obj_lock));
+             free(tdata);
+             return NULL;
+          }
         tdata->shared = EINA_TRUE;
      }
    tdata->generation = rand() % MAX_GENERATIONS;
@@ -359,7 +401,11 @@ _eo_table_data_new(Efl_Id_Domain domain)
 static void
 _eo_table_data_table_free(Eo_Id_Table_Data *tdata)
 {
-   if (tdata->shared) eina_lock_free(&(tdata->obj_lock));
+   if (tdata->shared)
+     {
+        eina_lock_free(&(tdata->obj_lock));
+        eina_lock_free(&(tdata->table_lock));
+     }
    free(tdata);
 }
 
@@ -432,6 +478,69 @@ _eo_obj_pointer_done(const Eo_Id obj_id)
 /* Macro used for readability */
 #define TABLE_FROM_IDS tdata->eo_ids_tables[mid_table_id][table_id]
 
+/* State of an active entry of the given generation */
+static inline unsigned int
+_eo_id_entry_state(Generation_Counter generation)
+{
+   _Eo_Id_Entry entry;
+
+   entry.state = 0;
+   entry.active = 1;
+   entry.generation = generation;
+   return entry.state;
+}
+
+/* Lookup in the shared domain without the table lock, safe against
+ * concurrent allocations of entries. The caller must hold the objects lock,
+ * so that the object can not be released before it is done with it. */
+static inline _Eo_Object *
+_eo_id_shared_lookup(Eo_Id_Data *data, Eo_Id_Table_Data *tdata, const Eo_Id obj_id)
+{
+   _Eo_Ids_Table **mid_table, *table;
+   _Eo_Id_Entry *entry;
+   _Eo_Object *ptr;
+   Generation_Counter generation;
+   Table_Index mid_table_id, table_id, entry_id;
+   unsigned int state;
+
+   if ((obj_id == data->shared_cache.id) &&
+       (__atomic_load_n(data->shared_cache.state, __ATOMIC_ACQUIRE) ==
+        data->shared_cache.expect))
+     return data->shared_cache.object;
+
+   EO_DECOMPOSE_ID(obj_id, mid_table_id, table_id, entry_id, generation);
+
+   mid_table = __atomic_load_n(&(tdata->eo_ids_tables[mid_table_id]), __ATOMIC_ACQUIRE);
+   if (!mid_table) return NULL;
+   table = __atomic_load_n(&(mid_table[table_id]), __ATOMIC_ACQUIRE);
+   if (!table) return NULL;
+
+   entry = &(table->entries[entry_id]);
+   state = __atomic_load_n(&(entry->state), __ATOMIC_ACQUIRE);
+   if (state != _eo_id_entry_state(generation)) return NULL;
+   ptr = __atomic_load_n(&(entry->ptr), __ATOMIC_RELAXED);
+   // The entry may have been released and given to another object while
+   // its pointer was being read, its state then changed
+   __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   if ((!ptr) || (__atomic_load_n(&(entry->state), __ATOMIC_RELAXED) != state))
+     return NULL;
+
+   data->shared_cache.id = obj_id;
+   data->shared_cache.object = ptr;
+   data->shared_cache.state = &(entry->state);
+   data->shared_cache.expect = state;
+   return ptr;
+}
+
+/* Fills an entry of the shared domain, the state last as it is what makes
+ * the entry visible to lookups */
+static inline void
+_eo_id_shared_entry_set(_Eo_Id_Entry *entry, _Eo_Object *obj, Generation_Counter generation)
+{
+   __atomic_store_n(&(entry->ptr), obj, __ATOMIC_RELAXED);
+   __atomic_store_n(&(entry->state), _eo_id_entry_state(generation), __ATOMIC_RELEASE);
+}
+
 static inline _Eo_Id_Entry *
 _get_available_entry(_Eo_Ids_Table *table)
 {
@@ -472,7 +581,9 @@ _search_tables(Eo_Id_Table_Data *tdata)
         if (!tdata->eo_ids_tables[mid_table_id])
           {
              /* Allocate a new intermediate table */
-             tdata->eo_ids_tables[mid_table_id] = _eo_id_mem_calloc(MAX_TABLE_ID, sizeof(_Eo_Ids_Table*));
+             __atomic_store_n(&(tdata->eo_ids_tables[mid_table_id]),
+                              _eo_id_mem_calloc(MAX_TABLE_ID, sizeof(_Eo_Ids_Table*)),
+                              __ATOMIC_RELEASE);
           }
 
         for (Table_Index table_id = 0; table_id < MAX_TABLE_ID; table_id++)
@@ -500,7 +611,7 @@ _search_tables(Eo_Id_Table_Data *tdata)
                   table->partial_id = EO_COMPOSE_PARTIAL_ID(mid_table_id, table_id);
                   entry = &(table->entries[0]);
                   UNPROTECT(tdata->eo_ids_tables[mid_table_id]);
-                  TABLE_FROM_IDS = table;
+                  __atomic_store_n(&(TABLE_FROM_IDS), table, __ATOMIC_RELEASE);
                   PROTECT(tdata->eo_ids_tables[mid_table_id]);
                }
              else
@@ -520,81 +631,68 @@ _search_tables(Eo_Id_Table_Data *tdata)
    return NULL;
 }
 
-/* Gives a fake id that serves as a marker if eo id is off. */
-static inline Eo_Id
-_eo_id_allocate(const _Eo_Object *obj, const Eo *parent_id)
+/* Gives ids to count objects at once, returns how many got one */
+static inline unsigned int
+_eo_id_allocate_many(_Eo_Object **objs, unsigned int count, const Eo *parent_id)
 {
-   _Eo_Id_Entry *entry = NULL;
+   _Eo_Id_Entry *entry;
    Eo_Id_Data *data;
    Eo_Id_Table_Data *tdata;
-   Eo_Id id;
+   Efl_Id_Domain domain;
+   unsigned int i;
 
    data = _eo_table_data_get();
    if (parent_id)
      {
-        Efl_Id_Domain domain = ((Eo_Id)parent_id >> SHIFT_DOMAIN) & MASK_DOMAIN;
+        domain = ((Eo_Id)parent_id >> SHIFT_DOMAIN) & MASK_DOMAIN;
         tdata = _eo_table_data_table_get(data, domain);
      }
    else tdata = _eo_table_data_current_table_get(data);
    if (!tdata) return 0;
 
-   if (EINA_LIKELY(!tdata->shared))
+   domain = tdata->shared ? EFL_ID_DOMAIN_SHARED : data->domain_stack[data->stack_top];
+   if (tdata->shared) eina_lock_take(&(tdata->table_lock));
+   for (i = 0; i < count; i++)
      {
+        entry = NULL;
         if (tdata->current_table)
           entry = _get_available_entry(tdata->current_table);
 
         if (!entry) entry = _search_tables(tdata);
 
-        if (!tdata->current_table || !entry)
-          {
-             return 0;
-          }
+        if (!tdata->current_table || !entry) break;
 
         UNPROTECT(tdata->current_table);
         /* [1;max-1] thus we never generate an Eo_Id equal to 0 */
         tdata->generation++;
         if (tdata->generation >= MAX_GENERATIONS) tdata->generation = 1;
-        /* Fill the entry and return it's Eo Id */
-        entry->ptr = (_Eo_Object *)obj;
-        entry->active = 1;
-        entry->generation = tdata->generation;
-        PROTECT(tdata->current_table);
-        id = EO_COMPOSE_FINAL_ID(tdata->current_table->partial_id,
-                                 (entry - tdata->current_table->entries),
-                                 data->domain_stack[data->stack_top],
-                                 entry->generation);
-     }
-   else
-     {
-        eina_lock_take(&(_eo_table_data_shared_data->obj_lock));
-        if (tdata->current_table)
-          entry = _get_available_entry(tdata->current_table);
-
-        if (!entry) entry = _search_tables(tdata);
-
-        if (!tdata->current_table || !entry)
+        /* Fill the entry */
+        if (tdata->shared)
+          _eo_id_shared_entry_set(entry, objs[i], tdata->generation);
+        else
           {
-             id = 0;
-             goto shared_err;
+             entry->ptr = objs[i];
+             entry->active = 1;
+             entry->generation = tdata->generation;
           }
-
-        UNPROTECT(tdata->current_table);
-        /* [1;max-1] thus we never generate an Eo_Id equal to 0 */
-        tdata->generation++;
-        if (tdata->generation == MAX_GENERATIONS) tdata->generation = 1;
-        /* Fill the entry and return it's Eo Id */
-        entry->ptr = (_Eo_Object *)obj;
-        entry->active = 1;
-        entry->generation = tdata->generation;
         PROTECT(tdata->current_table);
-        id = EO_COMPOSE_FINAL_ID(tdata->current_table->partial_id,
-                                 (entry - tdata->current_table->entries),
-                                 EFL_ID_DOMAIN_SHARED,
-                                 entry->generation);
-shared_err:
-        eina_lock_release(&(_eo_table_data_shared_data->obj_lock));
+        objs[i]->header.id = EO_COMPOSE_FINAL_ID(tdata->current_table->partial_id,
+                                                 (entry - tdata->current_table->entries),
+                                                 domain,
+                                                 entry->generation);
      }
-   return id;
+   if (tdata->shared) eina_lock_release(&(tdata->table_lock));
+   return i;
+}
+
+/* Gives an id to one object, 0 if there is no entry left */
+static inline Eo_Id
+_eo_id_allocate(const _Eo_Object *obj, const Eo *parent_id)
+{
+   _Eo_Object *objs[1] = { (_Eo_Object *)obj };
+
+   if (!_eo_id_allocate_many(objs, 1, parent_id)) return 0;
+   return (Eo_Id)obj->header.id;
 }
 
 static inline void
@@ -666,7 +764,7 @@ _eo_id_release(const Eo_Id obj_id)
      }
    else
      {
-        eina_lock_take(&(_eo_table_data_shared_data->obj_lock));
+        eina_lock_take(&(tdata->table_lock));
         // Check the validity of the entry
         if (tdata->eo_ids_tables[mid_table_id] && (table = TABLE_FROM_IDS))
           {
@@ -675,8 +773,11 @@ _eo_id_release(const Eo_Id obj_id)
                {
                   UNPROTECT(table);
                   table->free_entries++;
-                  // Disable the entry
-                  entry->active = 0;
+                  // Disable the entry, lookups and the cached lookups of
+                  // the other threads fail from the state on
+                  __atomic_store_n(&(entry->state), entry->state & ~_eo_id_entry_state(0),
+                                   __ATOMIC_RELEASE);
+                  __atomic_store_n(&(entry->ptr), NULL, __ATOMIC_RELEASE);
                   entry->next_in_fifo = -1;
                   // Push the entry into the fifo
                   if (table->fifo_tail == -1)
@@ -687,34 +788,12 @@ _eo_id_release(const Eo_Id obj_id)
                        table->fifo_tail = entry_id;
                     }
                   PROTECT(table);
-                  if (table->free_entries == MAX_ENTRY_ID)
-                    {
-                       UNPROTECT(tdata->eo_ids_tables[mid_table_id]);
-                       TABLE_FROM_IDS = NULL;
-                       PROTECT(tdata->eo_ids_tables[mid_table_id]);
-                       // Recycle or free the empty table
-                       if (!tdata->empty_table) tdata->empty_table = table;
-                       else _eo_id_mem_free(table);
-                       if (tdata->current_table == table)
-                         tdata->current_table = NULL;
-                    }
-                  // In case an object is destroyed, wipe out the cache
-                  if (tdata->cache.id == obj_id)
-                    {
-                       tdata->cache.id = 0;
-                       tdata->cache.object = NULL;
-                    }
-                  if ((Eo_Id)tdata->cache.isa_id == obj_id)
-                    {
-                       tdata->cache.isa_id = NULL;
-                       tdata->cache.klass = NULL;;
-                       tdata->cache.isa = EINA_FALSE;
-                    }
-                  eina_lock_release(&(_eo_table_data_shared_data->obj_lock));
+                  // Empty tables are kept, other threads may be reading them
+                  eina_lock_release(&(tdata->table_lock));
                   return;
                }
           }
-        eina_lock_release(&(_eo_table_data_shared_data->obj_lock));
+        eina_lock_release(&(tdata->table_lock));
      }
    ERR("obj_id %p is not pointing to a valid object. Maybe it has already been freed.", (void *)obj_id);
 }
@@ -5496,6 +5496,42 @@ EAPI void evas_object_image_scale_hint_set(Evas_Object *obj, Evas_Image_Scale_Hi
  */
 EAPI Evas_Image_Scale_Hint evas_object_image_scale_hint_get(const Evas_Object *obj);
 
+/**
+ * @brief Set whether smooth downscales of an image start from half size
+ * copies of it.
+ *
+ * When enabled, an image drawn smooth scaled down to half its size or less
+ * is scaled from the smallest of its successive half size copies that is
+ * still at least the size it is drawn at, so that the cost of a draw
+ * follows the size it is drawn at rather than the size of the image. This
+ * suits large images zoomed out over time. The copies are built the first
+ * time they are needed, take up to a third of the memory of the image more
+ * and count towards the image cache limits. They are only made by the
+ * software engines.
+ *
+ * @param[in] mipmap @c EINA_TRUE to scale from half size copies, @c
+ * EINA_FALSE (the default) not to.
+ *
+ * @since 1.22
+ *
+ * @ingroup Evas_Image
+ */
+EAPI void evas_object_image_scale_mipmap_set(Evas_Object *obj, Eina_Bool mipmap);
+
+/**
+ * @brief Get whether smooth downscales of an image start from half size
+ * copies of it.
+ *
+ * @return @c EINA_TRUE if they do, @c EINA_FALSE otherwise.
+ *
+ * @see evas_object_image_scale_mipmap_set()
+ *
+ * @since 1.22
+ *
+ * @ingroup Evas_Image
+ */
+EAPI Eina_Bool evas_object_image_scale_mipmap_get(const Evas_Object *obj);
+
 /**
  *
  * Sets the size of the given image object.
@@ -1336,6 +1336,163 @@ _evas_event_object_list_in_get(Evas *eo_e, Eina_List *in,
                                              no_rep, source);
 }
 
+/* The hit index is an R-tree of the top level objects of all layers, in
+ * stacking order, with the area out of which
+ * _evas_event_object_list_raw_in_get_single() can't find anything in
+ * them. Looking a point up in it gives the only top level objects worth
+ * walking, the walk itself is left untouched. Restacking rebuilds it on
+ * the next lookup, a change in a top level object or one of its members
+ * only refits the object. */
+static Eina_Rectangle
+_evas_event_hit_index_rect_get(Evas_Object_Protected_Data *obj)
+{
+   Eina_Rectangle c = { 0, 0, 0, 0 };
+
+   if ((!obj->cur->visible) && (!obj->is_event_parent)) return c;
+   if (obj->child_has_map)
+     {
+        EINA_RECTANGLE_SET(&c, -(1 << 29), -(1 << 29), 1 << 30, 1 << 30);
+        return c;
+     }
+   if ((obj->map->cur.map) && (obj->map->cur.usemap))
+     return obj->map->cur.map->normal_geometry;
+   if (obj->is_smart)
+     {
+        evas_object_smart_bounding_box_update(obj);
+        evas_object_smart_bounding_box_get(obj, &c, NULL);
+        return c;
+     }
+   return obj->cur->geometry;
+}
+
+static Eina_Bool
+_evas_event_hit_index_build(Evas_Public_Data *e)
+{
+   Evas_Object_Protected_Data *obj;
+   Eina_Rectangle *rects;
+   Evas_Layer *lay;
+   void **objs;
+   unsigned int count = 0;
+   Eina_Bool r = EINA_FALSE;
+
+   e->hit_index.dirty = EINA_FALSE;
+   EINA_INLIST_FOREACH(e->layers, lay)
+     count += eina_inlist_count(EINA_INLIST_GET(lay->objects));
+   if ((!count) || (count < e->hit_index.min_objects))
+     {
+        eina_rtree_free(e->hit_index.tree);
+        e->hit_index.tree = NULL;
+        return EINA_FALSE;
+     }
+
+   rects = malloc(count * sizeof (Eina_Rectangle));
+   objs = malloc(count * sizeof (void *));
+   if ((!rects) || (!objs)) goto end;
+
+   count = 0;
+   EINA_INLIST_FOREACH(e->layers, lay)
+     EINA_INLIST_FOREACH(lay->objects, obj)
+       {
+          obj->hit_id = count;
+          rects[count] = _evas_event_hit_index_rect_get(obj);
+          objs[count++] = obj;
+       }
+
+   if (!e->hit_index.tree) e->hit_index.tree = eina_rtree_new();
+   if (e->hit_index.tree)
+     r = eina_rtree_load(e->hit_index.tree, rects, objs, count);
+
+end:
+   if (!r)
+     {
+        eina_rtree_free(e->hit_index.tree);
+        e->hit_index.tree = NULL;
+     }
+   free(rects);
+   free(objs);
+   return r;
+}
+
+static Eina_Bool
+_evas_event_hit_index_update(Evas_Public_Data *e)
+{
+   Evas_Object_Protected_Data *obj;
+
+   if (!e->hit_index.enabled) return EINA_FALSE;
+   if (e->hit_index.dirty) return _evas_event_hit_index_build(e);
+   if (!e->hit_index.tree) return EINA_FALSE;
+
+   EINA_LIST_FREE(e->hit_index.moved, obj)
+     {
+        Eina_Rectangle c = _evas_event_hit_index_rect_get(obj);
+
+        obj->hit_moved = EINA_FALSE;
+        eina_rtree_update(e->hit_index.tree, obj->hit_id, &c);
+     }
+   return EINA_TRUE;
+}
+
+/* returns EINA_FALSE if the index couldn't be used, the objects are then to
+ * be walked */
+static Eina_Bool
+_evas_event_hit_index_in_get(Evas *eo_e, Evas_Public_Data *e, int x, int y,
+                             Eina_List **in)
+{
+   Evas_Object_Protected_Data *obj;
+   Eina_Inarray found;
+   unsigned int *id;
+   int no_rep = 0;
+
+   eina_inarray_step_set(&found, sizeof (found), sizeof (unsigned int), 32);
+   if ((!eina_rtree_collide(e->hit_index.tree, &(Eina_Rectangle) { x, y, 1, 1 },
+                            &found)) &&
+       (!eina_rtree_count(e->hit_index.tree)))
+     {
+        // the tree was emptied as it couldn't be repacked, load it again
+        // next time
+        evas_event_hit_index_invalidate(e);
+        return EINA_FALSE;
+     }
+   EINA_INARRAY_REVERSE_FOREACH(&found, id)
+     {
+        obj = eina_rtree_data_get(e->hit_index.tree, *id);
+        if (obj->events->parent) continue;
+        *in = _evas_event_object_list_raw_in_get_single(eo_e, obj, *in, NULL,
+                                                        x, y, &no_rep,
+                                                        EINA_FALSE, 0);
+        if (no_rep) break;
+     }
+   eina_inarray_flush(&found);
+   return EINA_TRUE;
+}
+
+void
+evas_event_hit_index_invalidate(Evas_Public_Data *e)
+{
+   Evas_Object_Protected_Data *obj;
+
+   if (!e->hit_index.enabled) return;
+   e->hit_index.dirty = EINA_TRUE;
+   EINA_LIST_FREE(e->hit_index.moved, obj)
+     obj->hit_moved = EINA_FALSE;
+}
+
+void
+evas_event_hit_index_object_change(Evas_Object_Protected_Data *obj)
+{
+   Evas_Public_Data *e;
+
+   if ((!obj->layer) || (!obj->layer->evas)) return;
+   e = obj->layer->evas;
+   if ((!e->hit_index.tree) || (e->hit_index.dirty)) return;
+
+   while (obj->smart.parent_object_data)
+     obj = obj->smart.parent_object_data;
+   if ((!obj->in_layer) || (obj->hit_moved)) return;
+   obj->hit_moved = EINA_TRUE;
+   e->hit_index.moved = eina_list_append(e->hit_index.moved, obj);
+}
+
 static Eina_List *
 _evas_event_objects_event_list_no_frozen_check(Evas *eo_e, Evas_Object *stop, int x, int y)
 {
@@ -1345,6 +1502,10 @@ _evas_event_objects_event_list_no_frozen_check(Evas *eo_e, Evas_Object *stop, in
 
    if (!e->layers) return NULL;
 
+   if ((!stop) && (_evas_event_hit_index_update(e)) &&
+       (_evas_event_hit_index_in_get(eo_e, e, x, y, &in)))
+     return in;
+
    D("@@@@@ layer count = %i\n", eina_inlist_count(EINA_INLIST_GET(e->layers)));
    EINA_INLIST_REVERSE_FOREACH((EINA_INLIST_GET(e->layers)), lay)
      {
@@ -4186,13 +4347,30 @@ EFL_CALLBACKS_ARRAY_DEFINE(_evas_canvas_event_pointer_callbacks,
 void
 _evas_canvas_event_init(Evas *eo_e, Evas_Public_Data *e)
 {
+   const char *s;
+
    efl_event_callback_array_add(eo_e, _evas_canvas_event_pointer_callbacks(), e);
+
+   // EVAS_HIT_INDEX=N: look up the objects under the pointer in an R-tree
+   // once the canvas has at least N top level objects
+   s = getenv("EVAS_HIT_INDEX");
+   if (s)
+     {
+        e->hit_index.enabled = EINA_TRUE;
+        e->hit_index.dirty = EINA_TRUE;
+        e->hit_index.min_objects = atoi(s);
+     }
 }
 
 void
 _evas_canvas_event_shutdown(Evas *eo_e, Evas_Public_Data *e)
 {
    efl_event_callback_array_del(eo_e, _evas_canvas_event_pointer_callbacks(), e);
+
+   e->hit_index.enabled = EINA_FALSE;
+   e->hit_index.moved = eina_list_free(e->hit_index.moved);
+   eina_rtree_free(e->hit_index.tree);
+   e->hit_index.tree = NULL;
 }
 
 void
@@ -498,6 +498,35 @@ evas_object_image_scale_hint_get(const Evas_Object *obj)
    return (Evas_Image_Scale_Hint) efl_gfx_image_scale_hint_get(obj);
 }
 
+EAPI void
+evas_object_image_scale_mipmap_set(Evas_Object *eo_obj, Eina_Bool mipmap)
+{
+   EVAS_IMAGE_API(eo_obj);
+
+   Evas_Object_Protected_Data *obj = efl_data_scope_get(eo_obj, EFL_CANVAS_OBJECT_CLASS);
+   Evas_Image_Data *o = efl_data_scope_get(eo_obj, EFL_CANVAS_IMAGE_INTERNAL_CLASS);
+
+   evas_object_async_block(obj);
+   mipmap = !!mipmap;
+   if (o->cur->scale_mipmap == mipmap) return;
+   // applied to the engine image when drawn
+   EINA_COW_IMAGE_STATE_WRITE_BEGIN(o, state_write)
+     state_write->scale_mipmap = mipmap;
+   EINA_COW_IMAGE_STATE_WRITE_END(o, state_write);
+
+   o->changed = EINA_TRUE;
+   evas_object_change(eo_obj, obj);
+}
+
+EAPI Eina_Bool
+evas_object_image_scale_mipmap_get(const Evas_Object *eo_obj)
+{
+   EVAS_IMAGE_API(eo_obj, EINA_FALSE);
+
+   Evas_Image_Data *o = efl_data_scope_get(eo_obj, EFL_CANVAS_IMAGE_INTERNAL_CLASS);
+   return o->cur->scale_mipmap;
+}
+
 EAPI void
 evas_object_image_native_surface_set(Evas_Object *eo_obj, Evas_Native_Surface *surf)
 {
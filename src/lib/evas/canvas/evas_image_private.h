@@ -88,6 +88,7 @@ struct _Evas_Object_Image_State
    Evas_Image_Orient  orient;
 
    Eina_Bool      smooth_scale : 1;
+   Eina_Bool      scale_mipmap : 1;
    Eina_Bool      has_alpha :1;
    Eina_Bool      opaque_valid : 1;
    Eina_Bool      opaque : 1;
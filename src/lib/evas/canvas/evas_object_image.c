@@ -100,6 +100,7 @@ static const Evas_Object_Image_State default_state = {
    EVAS_IMAGE_ORIENT_NONE,
 
    EINA_TRUE, // smooth
+   EINA_FALSE, // scale_mipmap
    EINA_FALSE, // has_alpha
    EINA_FALSE, // opaque_valid
    EINA_FALSE // opaque
@@ -201,6 +202,10 @@ _init_cow(void)
         return EINA_FALSE;
      }
 
+   eina_cow_gc_background_set(evas_object_image_load_opts_cow, EINA_TRUE);
+   eina_cow_gc_background_set(evas_object_image_pixels_cow, EINA_TRUE);
+   eina_cow_gc_background_set(evas_object_image_state_cow, EINA_TRUE);
+
    return EINA_TRUE;
 }
 
@@ -2028,6 +2033,8 @@ _evas_image_render(Eo *eo_obj, Evas_Object_Protected_Data *obj,
      }
 
    ENFN->image_scale_hint_set(engine, pixels, o->scale_hint);
+   if (ENFN->image_scale_mipmap_set)
+     ENFN->image_scale_mipmap_set(engine, pixels, o->cur->scale_mipmap);
    idx = evas_object_image_figure_x_fill(eo_obj, obj, o->cur->fill.x, o->cur->fill.w, &idw);
    idy = evas_object_image_figure_y_fill(eo_obj, obj, o->cur->fill.y, o->cur->fill.h, &idh);
    if (idw < 1) idw = 1;
@@ -2381,7 +2388,8 @@ evas_object_image_render_pre(Evas_Object *eo_obj,
             (o->cur->image.h != o->prev->image.h) ||
             (o->cur->has_alpha != o->prev->has_alpha) ||
             (o->cur->cspace != o->prev->cspace) ||
-            (o->cur->smooth_scale != o->prev->smooth_scale))
+            (o->cur->smooth_scale != o->prev->smooth_scale) ||
+            (o->cur->scale_mipmap != o->prev->scale_mipmap))
           {
              evas_object_render_pre_prev_cur_add(&e->clip_changes, eo_obj, obj);
              goto done;
@@ -78,6 +78,13 @@ _init_cow(void)
         return EINA_FALSE;
      }
 
+   /* merged back from the main loop idler instead of only on idle flush */
+   eina_cow_gc_background_set(evas_object_proxy_cow, EINA_TRUE);
+   eina_cow_gc_background_set(evas_object_map_cow, EINA_TRUE);
+   eina_cow_gc_background_set(evas_object_3d_cow, EINA_TRUE);
+   eina_cow_gc_background_set(evas_object_mask_cow, EINA_TRUE);
+   eina_cow_gc_background_set(evas_object_events_cow, EINA_TRUE);
+
    return EINA_TRUE;
 }
 
@@ -636,6 +643,7 @@ evas_object_change(Evas_Object *eo_obj EINA_UNUSED, Evas_Object_Protected_Data *
    Evas_Canvas3D_Texture *texture;
 
    if ((!obj->layer) || (!obj->layer->evas)) return;
+   evas_event_hit_index_object_change(obj);
    if (obj->layer->evas->nochange) return;
    obj->layer->evas->changed = EINA_TRUE;
 
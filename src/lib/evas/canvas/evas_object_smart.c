@@ -1335,6 +1335,7 @@ evas_object_update_bounding_box(Evas_Object *eo_obj EINA_UNUSED, Evas_Object_Pro
    Evas_Coord px, py, pw, ph;
    Eina_Bool noclip;
 
+   evas_event_hit_index_object_change(obj);
    if (!obj->smart.parent) return;
 
    if (obj->child_has_map) return; /* Disable bounding box computation for this object and its parent */
@@ -1524,6 +1525,7 @@ evas_object_smart_cleanup(Evas_Object *eo_obj)
                        lay->objects = (Evas_Object_Protected_Data *)
                          eina_inlist_prepend(EINA_INLIST_GET(lay->objects),
                                              EINA_INLIST_GET(contained));
+                       evas_event_hit_index_invalidate(lay->evas);
                        if (contained->layer != lay)
                          {
                             if (contained->layer) contained->layer->usage--;
@@ -56,7 +56,10 @@ _efl_canvas_object_efl_gfx_stack_raise_to_top(Eo *eo_obj, Evas_Object_Protected_
    else
      {
         if (obj->in_layer)
-          obj->layer->objects = (Evas_Object_Protected_Data *)eina_inlist_demote(EINA_INLIST_GET(obj->layer->objects), EINA_INLIST_GET(obj));
+          {
+             obj->layer->objects = (Evas_Object_Protected_Data *)eina_inlist_demote(EINA_INLIST_GET(obj->layer->objects), EINA_INLIST_GET(obj));
+             evas_event_hit_index_invalidate(obj->layer->evas);
+          }
      }
    if (obj->clip.clipees)
      {
@@ -105,8 +108,11 @@ _efl_canvas_object_efl_gfx_stack_lower_to_bottom(Eo *eo_obj, Evas_Object_Protect
    else
      {
         if (obj->in_layer)
-          obj->layer->objects = (Evas_Object_Protected_Data *)eina_inlist_promote(EINA_INLIST_GET(obj->layer->objects),
-                                                                                 EINA_INLIST_GET(obj));
+          {
+             obj->layer->objects = (Evas_Object_Protected_Data *)eina_inlist_promote(EINA_INLIST_GET(obj->layer->objects),
+                                                                                    EINA_INLIST_GET(obj));
+             evas_event_hit_index_invalidate(obj->layer->evas);
+          }
      }
    if (obj->clip.clipees)
      {
@@ -198,6 +204,7 @@ _efl_canvas_object_efl_gfx_stack_stack_above(Eo *eo_obj, Evas_Object_Protected_D
              obj->layer->objects = (Evas_Object_Protected_Data *)eina_inlist_append_relative(EINA_INLIST_GET(obj->layer->objects),
                                                                                             EINA_INLIST_GET(obj),
                                                                                             EINA_INLIST_GET(above));
+             evas_event_hit_index_invalidate(obj->layer->evas);
           }
      }
    if (obj->clip.clipees)
@@ -288,6 +295,7 @@ _efl_canvas_object_efl_gfx_stack_stack_below(Eo *eo_obj, Evas_Object_Protected_D
              obj->layer->objects = (Evas_Object_Protected_Data *)eina_inlist_prepend_relative(EINA_INLIST_GET(obj->layer->objects),
                                                                                EINA_INLIST_GET(obj),
                                                                                EINA_INLIST_GET(below));
+             evas_event_hit_index_invalidate(obj->layer->evas);
           }
      }
    if (obj->clip.clipees)
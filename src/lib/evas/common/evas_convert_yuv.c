@@ -1,6 +1,12 @@
 #include "evas_common_private.h"
 #include "evas_convert_yuv.h"
 
+#include "Ecore.h"
+
+#ifdef BUILD_NEON
+# include <arm_neon.h>
+#endif
+
 #ifdef BUILD_MMX
 # include "evas_mmx.h"
 #endif
@@ -26,10 +32,6 @@ static void _evas_yv12torgb_mmx    (unsigned char **yuv, unsigned char *rgb, int
 static void _evas_yv12torgb_altivec(unsigned char **yuv, unsigned char *rgb, int w, int h);
 static void _evas_yv12torgb_diz    (unsigned char **yuv, unsigned char *rgb, int w, int h);
 #endif
-static void _evas_yv12_709torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h);
-static void _evas_yv12torgb_raster (unsigned char **yuv, unsigned char *rgb, int w, int h);
-static void _evas_yuy2torgb_raster (unsigned char **yuv, unsigned char *rgb, int w, int h);
-static void _evas_nv12torgb_raster (unsigned char **yuv, unsigned char *rgb, int w, int h);
 static void _evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h);
 
 #define CRV    104595
@@ -152,37 +154,113 @@ static unsigned char _clip_lut[1024];
 
 static int initted = 0;
 
+/* Every format is converted a row at a time by a row function reading a
+ * luma value every ys bytes and a chroma pair every cs bytes: planar
+ * YV12/I420 is ys 1 and cs 1, NV12 is ys 1 and cs 2 with v right after u,
+ * and YUY2 is ys 2 and cs 4 out of the one line. The vector row functions
+ * give the very same pixels as the C one. */
+
+typedef struct _Evas_YUV_Matrix Evas_YUV_Matrix;
+typedef struct _Evas_YUV_Job Evas_YUV_Job;
+typedef struct _Evas_YUV_Msg Evas_YUV_Msg;
+
+typedef void (*Evas_YUV_Row_Func)(const Evas_YUV_Matrix *m,
+                                  const DATA8 *yp, int ys,
+                                  const DATA8 *up, const DATA8 *vp, int cs,
+                                  DATA32 *dp, int w);
+
+struct _Evas_YUV_Matrix
+{
+   /* lookup tables of the C code: y, v for red, v and u for green, u for
+    * blue */
+   const short *ly, *lrv, *lgv, *lgu, *lbu;
+   /* the factors the tables are built from, the vector code multiplies
+    * with them and truncates the same way */
+   float y, rv, gv, gu, bu;
+   /* 16.16 fixed point factors, used instead of the tables when fy is set */
+   int fy, frv, fgv, fgu, fbu;
+};
+
+typedef enum
+{
+   EVAS_YUV_PLANAR,
+   EVAS_YUV_YUY2,
+   EVAS_YUV_NV12
+} Evas_YUV_Layout;
+
+struct _Evas_YUV_Job
+{
+   const Evas_YUV_Matrix *m;
+   Evas_YUV_Row_Func row;
+   Evas_YUV_Layout layout;
+   DATA8 **yuv;
+   DATA8 *rgb;
+   int w, h;
+};
+
+struct _Evas_YUV_Msg
+{
+   Eina_Thread_Queue_Msg head;
+   const Evas_YUV_Job *job;
+   int y0, y1;
+};
+
+static const Evas_YUV_Matrix _evas_yuv_601 = {
+   _v1164, _v1596, _v813, _v391, _v2018,
+   1.164, 1.596, 0.813, 0.391, 2.018,
+   0, 0, 0, 0, 0
+};
+
+static const Evas_YUV_Matrix _evas_yuv_709 = {
+   _v1164, _v1793, _v534, _v213, _v2115,
+   1.164, 1.793, 0.534, 0.213, 2.115,
+   0, 0, 0, 0, 0
+};
+
+static const Evas_YUV_Matrix _evas_yuv_601_fixed = {
+   NULL, NULL, NULL, NULL, NULL,
+   0, 0, 0, 0, 0,
+   YMUL, CRV, CGV, CGU, CBU
+};
+
+static void _evas_yuv_row_c(const Evas_YUV_Matrix *m, const DATA8 *yp, int ys, const DATA8 *up, const DATA8 *vp, int cs, DATA32 *dp, int w);
+static Evas_YUV_Row_Func _evas_yuv_row_get(void);
+static void _evas_yuv_convert(DATA8 **yuv, DATA8 *rgb, int w, int h, Evas_YUV_Layout layout, const Evas_YUV_Matrix *m, Evas_YUV_Row_Func row);
+
 void
 evas_common_convert_yuv_422p_709_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
    if (!initted) _evas_yuv_init();
    initted = 1;
-/* Broken atm - the sse and mmx get math.. wrong :(
-   if (evas_common_cpu_has_feature(CPU_FEATURE_MMX2))
-     _evas_yv12_709torgb_sse(src, dst, w, h);
-   else if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
-     _evas_yv12_709torgb_mmx(src, dst, w, h);
-   else
- */
-     _evas_yv12_709torgb_raster(src, dst, w, h);
+   /* the mmx and sse code below gets the 709 math wrong, so only the row
+    * functions are used */
+   _evas_yuv_convert(src, dst, w, h, EVAS_YUV_PLANAR, &_evas_yuv_709,
+                     _evas_yuv_row_get());
 }
 
 
 void
 evas_common_convert_yuv_422p_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
 {
+   Evas_YUV_Row_Func row;
+
    if (!initted) _evas_yuv_init();
    initted = 1;
-   if (evas_common_cpu_has_feature(CPU_FEATURE_MMX2))
+   /* the vector row functions are exact, the mmx and altivec code is only
+    * used where none of them is available */
+   row = _evas_yuv_row_get();
+   if (row != _evas_yuv_row_c)
+     _evas_yuv_convert(src, dst, w, h, EVAS_YUV_PLANAR, &_evas_yuv_601, row);
+   else if (evas_common_cpu_has_feature(CPU_FEATURE_MMX2))
      _evas_yv12torgb_sse(src, dst, w, h);
    else if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
      _evas_yv12torgb_mmx(src, dst, w, h);
 #ifdef BUILD_ALTIVEC
-   if (evas_common_cpu_has_feature(CPU_FEATURE_ALTIVEC))
+   else if (evas_common_cpu_has_feature(CPU_FEATURE_ALTIVEC))
      _evas_yv12torgb_altivec(src, dst, w, h);
 #endif
    else
-     _evas_yv12torgb_raster(src, dst, w, h);
+     _evas_yuv_convert(src, dst, w, h, EVAS_YUV_PLANAR, &_evas_yuv_601, row);
 }
 
 /* Thanks to Diz for this code. i've munged it a little and turned it into */
@@ -685,7 +763,7 @@ _evas_yv12_709torgb_mmx(unsigned char **yuv, unsigned char *rgb, int w, int h)
      }
    emms();
 #else
-   _evas_yv12torgb_raster(yuv, rgb, w, h);
+   _evas_yuv_convert(yuv, rgb, w, h, EVAS_YUV_PLANAR, &_evas_yuv_601, _evas_yuv_row_c);
 #endif
 }
 */
@@ -849,7 +927,7 @@ _evas_yv12torgb_mmx(unsigned char **yuv, unsigned char *rgb, int w, int h)
      }
    emms();
 #else
-   _evas_yv12torgb_raster(yuv, rgb, w, h);
+   _evas_yuv_convert(yuv, rgb, w, h, EVAS_YUV_PLANAR, &_evas_yuv_601, _evas_yuv_row_c);
 #endif
 }
 
@@ -1176,327 +1254,711 @@ _evas_yv12torgb_diz(unsigned char **yuv, unsigned char *rgb, int w, int h)
 }
 #endif
 
-static void
-_evas_yv12_709torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
+static inline void
+_evas_yuv_row_c_do(const Evas_YUV_Matrix *m, const DATA8 *yp, int ys,
+                   const DATA8 *up, const DATA8 *vp, int cs,
+                   DATA32 *dp, int w)
 {
-   int xx, yy;
-   int y, u, v;
-   unsigned char *yp1, *yp2, *up, *vp;
-   unsigned char *dp1, *dp2;
+   DATA32 *de = dp + w;
+   int y, rv, guv, bu;
 
-   /* destination pointers */
-   dp1 = rgb;
-   dp2 = rgb + (w * 4);
-
-   for (yy = 0; yy < h; yy += 2)
+   /* rv, guv and bu are what a chroma pair adds to red, takes from green
+    * and adds to blue */
+   if (m->fy)
      {
-	/* plane pointers */
-	yp1 = yuv[yy];
-	yp2 = yuv[yy + 1];
-	up = yuv[h + (yy / 2)];
-	vp = yuv[h + (h / 2) + (yy / 2)];
-	for (xx = 0; xx < w; xx += 2)
-	  {
-	     int vmu;
+        const int fy = m->fy, frv = m->frv, fgv = m->fgv, fgu = m->fgu, fbu = m->fbu;
 
-	     /* collect u & v for 2x2 pixel block */
-	     u = *up++;
-	     v = *vp++;
+#define YUV_FIXED(Y)                                                    \
+        y = ((Y) - 16) * fy;                                            \
+        *dp++ = 0xff000000 + RGB_JOIN(LUT_CLIP((y + rv) >> 16),         \
+                                      LUT_CLIP((y - guv) >> 16),        \
+                                      LUT_CLIP((y + bu) >> 16));
 
-	     /* save lookups */
-	     vmu = _v534[v] + _v213[u];
-	     u = _v2115[u];
-	     v = _v1793[v];
+        for (; dp < de; yp += 2 * ys, up += cs, vp += cs)
+          {
+             int u = *up - 128, v = *vp - 128;
+
+             rv = v * frv;
+             guv = (v * fgv) + (u * fgu) - OFF;
+             bu = (u * fbu) + OFF;
+             YUV_FIXED(yp[0]);
+             if (dp == de) break;
+             YUV_FIXED(yp[ys]);
+          }
+#undef YUV_FIXED
+     }
+   else
+     {
+        const short *ly = m->ly, *lrv = m->lrv, *lgv = m->lgv, *lgu = m->lgu, *lbu = m->lbu;
 
-             /* do the top 2 pixels of the 2x2 block which shared u & v */
-	     /* yuv to rgb */
-	     y = _v1164[*yp1++];
-	     *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+#define YUV_LUT(Y)                                                      \
+        y = ly[(Y)];                                                    \
+        *dp++ = 0xff000000 + RGB_JOIN(LUT_CLIP(y + rv),                 \
+                                      LUT_CLIP(y - guv),                \
+                                      LUT_CLIP(y + bu));
 
-	     dp1 += 4;
+        for (; dp < de; yp += 2 * ys, up += cs, vp += cs)
+          {
+             rv = lrv[*vp];
+             guv = lgv[*vp] + lgu[*up];
+             bu = lbu[*up];
+             YUV_LUT(yp[0]);
+             if (dp == de) break;
+             YUV_LUT(yp[ys]);
+          }
+#undef YUV_LUT
+     }
+}
 
-	     /* yuv to rgb */
-	     y = _v1164[*yp1++];
-	     *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+static void
+_evas_yuv_row_c(const Evas_YUV_Matrix *m, const DATA8 *yp, int ys EINA_UNUSED,
+                const DATA8 *up, const DATA8 *vp, int cs,
+                DATA32 *dp, int w)
+{
+   /* spelt out for each layout so that the strides are known, the luma
+    * one following from the chroma one */
+   if (cs == 1)
+     _evas_yuv_row_c_do(m, yp, 1, up, vp, 1, dp, w);
+   else if (cs == 2)
+     _evas_yuv_row_c_do(m, yp, 1, up, vp, 2, dp, w);
+   else
+     _evas_yuv_row_c_do(m, yp, 2, up, vp, 4, dp, w);
+}
 
-	     dp1 += 4;
+#if defined BUILD_SSE41 || defined BUILD_AVX2
+static inline int
+_evas_yuv_load16(const DATA8 *p)
+{
+   unsigned short r;
 
-	     /* do the bottom 2 pixels */
-	     /* yuv to rgb */
-	     y = _v1164[*yp2++];
-	     *((DATA32 *) dp2) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+   memcpy(&r, p, sizeof (r));
+   return r;
+}
 
-	     dp2 += 4;
+static inline int
+_evas_yuv_load32(const DATA8 *p)
+{
+   int r;
 
-	     /* yuv to rgb */
-	     y = _v1164[*yp2++];
-	     *((DATA32 *) dp2) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+   memcpy(&r, p, sizeof (r));
+   return r;
+}
+#endif
 
-	     dp2 += 4;
-	  }
-	/* jump down one line since we are doing 2 at once */
-	dp1 += (w * 4);
-	dp2 += (w * 4);
+#ifdef BUILD_SSE41
+/* 4 pixels out of y, u and v widened to 32-bit lanes */
+EVAS_INLINE_SSE41 __m128i
+_evas_yuv_rgb_sse41(const Evas_YUV_Matrix *m, __m128i y, __m128i u, __m128i v)
+{
+   const __m128i max = _mm_set1_epi32(255);
+   const __m128i zero = _mm_setzero_si128();
+   __m128i r, g, b;
+
+   y = _mm_sub_epi32(y, _mm_set1_epi32(16));
+   u = _mm_sub_epi32(u, _mm_set1_epi32(128));
+   v = _mm_sub_epi32(v, _mm_set1_epi32(128));
+   if (m->fy)
+     {
+        const __m128i off = _mm_set1_epi32(OFF);
+
+        y = _mm_mullo_epi32(y, _mm_set1_epi32(m->fy));
+        r = _mm_add_epi32(y, _mm_mullo_epi32(v, _mm_set1_epi32(m->frv)));
+        g = _mm_add_epi32(_mm_mullo_epi32(v, _mm_set1_epi32(m->fgv)),
+                          _mm_mullo_epi32(u, _mm_set1_epi32(m->fgu)));
+        g = _mm_sub_epi32(_mm_add_epi32(y, off), g);
+        b = _mm_add_epi32(_mm_add_epi32(y, off),
+                          _mm_mullo_epi32(u, _mm_set1_epi32(m->fbu)));
+        r = _mm_srai_epi32(r, 16);
+        g = _mm_srai_epi32(g, 16);
+        b = _mm_srai_epi32(b, 16);
+     }
+   else
+     {
+        const __m128 fu = _mm_cvtepi32_ps(u), fv = _mm_cvtepi32_ps(v);
+
+        y = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(y), _mm_set1_ps(m->y)));
+        r = _mm_cvttps_epi32(_mm_mul_ps(fv, _mm_set1_ps(m->rv)));
+        g = _mm_add_epi32(_mm_cvttps_epi32(_mm_mul_ps(fv, _mm_set1_ps(m->gv))),
+                          _mm_cvttps_epi32(_mm_mul_ps(fu, _mm_set1_ps(m->gu))));
+        b = _mm_cvttps_epi32(_mm_mul_ps(fu, _mm_set1_ps(m->bu)));
+        r = _mm_add_epi32(y, r);
+        g = _mm_sub_epi32(y, g);
+        b = _mm_add_epi32(y, b);
      }
+   r = _mm_min_epi32(_mm_max_epi32(r, zero), max);
+   g = _mm_min_epi32(_mm_max_epi32(g, zero), max);
+   b = _mm_min_epi32(_mm_max_epi32(b, zero), max);
+   r = _mm_or_si128(_mm_slli_epi32(r, 16), _mm_slli_epi32(g, 8));
+   return _mm_or_si128(_mm_or_si128(r, b), _mm_set1_epi32(0xff000000));
 }
 
-static void
-_evas_yv12torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
+static EVAS_TARGET_SSE41 void
+_evas_yuv_row_sse41(const Evas_YUV_Matrix *m, const DATA8 *yp, int ys,
+                    const DATA8 *up, const DATA8 *vp, int cs,
+                    DATA32 *dp, int w)
 {
-   int xx, yy;
-   int y, u, v;
-   unsigned char *yp1, *yp2, *up, *vp;
-   unsigned char *dp1, *dp2;
+   /* byte picks straight into 32-bit lanes, -1 clears */
+   const __m128i pick_0011 = _mm_setr_epi8(0, -1, -1, -1, 0, -1, -1, -1,
+                                           1, -1, -1, -1, 1, -1, -1, -1);
+   const __m128i pick_0022 = _mm_setr_epi8(0, -1, -1, -1, 0, -1, -1, -1,
+                                           2, -1, -1, -1, 2, -1, -1, -1);
+   const __m128i pick_1133 = _mm_setr_epi8(1, -1, -1, -1, 1, -1, -1, -1,
+                                           3, -1, -1, -1, 3, -1, -1, -1);
+   const __m128i pick_0246 = _mm_setr_epi8(0, -1, -1, -1, 2, -1, -1, -1,
+                                           4, -1, -1, -1, 6, -1, -1, -1);
+   const __m128i pick_1155 = _mm_setr_epi8(1, -1, -1, -1, 1, -1, -1, -1,
+                                           5, -1, -1, -1, 5, -1, -1, -1);
+   const __m128i pick_3377 = _mm_setr_epi8(3, -1, -1, -1, 3, -1, -1, -1,
+                                           7, -1, -1, -1, 7, -1, -1, -1);
+   const Evas_YUV_Matrix mm = *m;
+   int x;
+
+   for (x = 0; x + 4 <= w; x += 4)
+     {
+        __m128i y, u, v;
 
-   /* destination pointers */
-   dp1 = rgb;
-   dp2 = rgb + (w * 4);
+        if (cs == 1)
+          {
+             y = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(_evas_yuv_load32(yp + x)));
+             u = _mm_shuffle_epi8(_mm_cvtsi32_si128(_evas_yuv_load16(up + (x >> 1))), pick_0011);
+             v = _mm_shuffle_epi8(_mm_cvtsi32_si128(_evas_yuv_load16(vp + (x >> 1))), pick_0011);
+          }
+        else if (cs == 2)
+          {
+             __m128i uv = _mm_cvtsi32_si128(_evas_yuv_load32(up + x));
 
-   for (yy = 0; yy < h; yy += 2)
+             y = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(_evas_yuv_load32(yp + x)));
+             u = _mm_shuffle_epi8(uv, pick_0022);
+             v = _mm_shuffle_epi8(uv, pick_1133);
+          }
+        else
+          {
+             __m128i yuyv = _mm_loadl_epi64((const __m128i *)(yp + (x * 2)));
+
+             y = _mm_shuffle_epi8(yuyv, pick_0246);
+             u = _mm_shuffle_epi8(yuyv, pick_1155);
+             v = _mm_shuffle_epi8(yuyv, pick_3377);
+          }
+        _mm_storeu_si128((__m128i *)(dp + x), _evas_yuv_rgb_sse41(&mm, y, u, v));
+     }
+   if (x < w)
+     _evas_yuv_row_c(m, yp + (x * ys), ys, up + ((x >> 1) * cs),
+                     vp + ((x >> 1) * cs), cs, dp + x, w - x);
+}
+#endif
+
+#ifdef BUILD_AVX2
+/* 8 pixels out of y, u and v widened to 32-bit lanes */
+EVAS_INLINE_AVX2 __m256i
+_evas_yuv_rgb_avx2(const Evas_YUV_Matrix *m, __m256i y, __m256i u, __m256i v)
+{
+   const __m256i max = _mm256_set1_epi32(255);
+   const __m256i zero = _mm256_setzero_si256();
+   __m256i r, g, b;
+
+   y = _mm256_sub_epi32(y, _mm256_set1_epi32(16));
+   u = _mm256_sub_epi32(u, _mm256_set1_epi32(128));
+   v = _mm256_sub_epi32(v, _mm256_set1_epi32(128));
+   if (m->fy)
      {
-	/* plane pointers */
-	yp1 = yuv[yy];
-	yp2 = yuv[yy + 1];
-	up = yuv[h + (yy / 2)];
-	vp = yuv[h + (h / 2) + (yy / 2)];
-	for (xx = 0; xx < w; xx += 2)
-	  {
-	     int vmu;
+        const __m256i off = _mm256_set1_epi32(OFF);
+
+        y = _mm256_mullo_epi32(y, _mm256_set1_epi32(m->fy));
+        r = _mm256_add_epi32(y, _mm256_mullo_epi32(v, _mm256_set1_epi32(m->frv)));
+        g = _mm256_add_epi32(_mm256_mullo_epi32(v, _mm256_set1_epi32(m->fgv)),
+                             _mm256_mullo_epi32(u, _mm256_set1_epi32(m->fgu)));
+        g = _mm256_sub_epi32(_mm256_add_epi32(y, off), g);
+        b = _mm256_add_epi32(_mm256_add_epi32(y, off),
+                             _mm256_mullo_epi32(u, _mm256_set1_epi32(m->fbu)));
+        r = _mm256_srai_epi32(r, 16);
+        g = _mm256_srai_epi32(g, 16);
+        b = _mm256_srai_epi32(b, 16);
+     }
+   else
+     {
+        const __m256 fu = _mm256_cvtepi32_ps(u), fv = _mm256_cvtepi32_ps(v);
+
+        y = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(y), _mm256_set1_ps(m->y)));
+        r = _mm256_cvttps_epi32(_mm256_mul_ps(fv, _mm256_set1_ps(m->rv)));
+        g = _mm256_add_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(fv, _mm256_set1_ps(m->gv))),
+                             _mm256_cvttps_epi32(_mm256_mul_ps(fu, _mm256_set1_ps(m->gu))));
+        b = _mm256_cvttps_epi32(_mm256_mul_ps(fu, _mm256_set1_ps(m->bu)));
+        r = _mm256_add_epi32(y, r);
+        g = _mm256_sub_epi32(y, g);
+        b = _mm256_add_epi32(y, b);
+     }
+   r = _mm256_min_epi32(_mm256_max_epi32(r, zero), max);
+   g = _mm256_min_epi32(_mm256_max_epi32(g, zero), max);
+   b = _mm256_min_epi32(_mm256_max_epi32(b, zero), max);
+   r = _mm256_or_si256(_mm256_slli_epi32(r, 16), _mm256_slli_epi32(g, 8));
+   return _mm256_or_si256(_mm256_or_si256(r, b), _mm256_set1_epi32(0xff000000));
+}
 
-	     /* collect u & v for 2x2 pixel block */
-	     u = *up++;
-	     v = *vp++;
+static EVAS_TARGET_AVX2 void
+_evas_yuv_row_avx2(const Evas_YUV_Matrix *m, const DATA8 *yp, int ys,
+                   const DATA8 *up, const DATA8 *vp, int cs,
+                   DATA32 *dp, int w)
+{
+   /* byte picks into the 8 low bytes, widened afterwards */
+   const __m128i pick_even = _mm_setr_epi8(0, 0, 2, 2, 4, 4, 6, 6,
+                                           -1, -1, -1, -1, -1, -1, -1, -1);
+   const __m128i pick_odd = _mm_setr_epi8(1, 1, 3, 3, 5, 5, 7, 7,
+                                          -1, -1, -1, -1, -1, -1, -1, -1);
+   const __m128i pick_y = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                        -1, -1, -1, -1, -1, -1, -1, -1);
+   const __m128i pick_u = _mm_setr_epi8(1, 1, 5, 5, 9, 9, 13, 13,
+                                        -1, -1, -1, -1, -1, -1, -1, -1);
+   const __m128i pick_v = _mm_setr_epi8(3, 3, 7, 7, 11, 11, 15, 15,
+                                        -1, -1, -1, -1, -1, -1, -1, -1);
+   const Evas_YUV_Matrix mm = *m;
+   int x;
+
+   for (x = 0; x + 8 <= w; x += 8)
+     {
+        __m128i y, u, v;
 
-	     /* save lookups */
-	     vmu = _v813[v] + _v391[u];
-	     u = _v2018[u];
-	     v = _v1596[v];
+        if (cs == 1)
+          {
+             y = _mm_loadl_epi64((const __m128i *)(yp + x));
+             u = _mm_cvtsi32_si128(_evas_yuv_load32(up + (x >> 1)));
+             v = _mm_cvtsi32_si128(_evas_yuv_load32(vp + (x >> 1)));
+             u = _mm_unpacklo_epi8(u, u);
+             v = _mm_unpacklo_epi8(v, v);
+          }
+        else if (cs == 2)
+          {
+             __m128i uv = _mm_loadl_epi64((const __m128i *)(up + x));
 
-             /* do the top 2 pixels of the 2x2 block which shared u & v */
-	     /* yuv to rgb */
-	     y = _v1164[*yp1++];
-	     *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+             y = _mm_loadl_epi64((const __m128i *)(yp + x));
+             u = _mm_shuffle_epi8(uv, pick_even);
+             v = _mm_shuffle_epi8(uv, pick_odd);
+          }
+        else
+          {
+             __m128i yuyv = _mm_loadu_si128((const __m128i *)(yp + (x * 2)));
 
-	     dp1 += 4;
+             y = _mm_shuffle_epi8(yuyv, pick_y);
+             u = _mm_shuffle_epi8(yuyv, pick_u);
+             v = _mm_shuffle_epi8(yuyv, pick_v);
+          }
+        _mm256_storeu_si256((__m256i *)(dp + x),
+                            _evas_yuv_rgb_avx2(&mm, _mm256_cvtepu8_epi32(y),
+                                               _mm256_cvtepu8_epi32(u),
+                                               _mm256_cvtepu8_epi32(v)));
+     }
+   if (x < w)
+     _evas_yuv_row_c(m, yp + (x * ys), ys, up + ((x >> 1) * cs),
+                     vp + ((x >> 1) * cs), cs, dp + x, w - x);
+}
+#endif
 
-	     /* yuv to rgb */
-	     y = _v1164[*yp1++];
-	     *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+#ifdef BUILD_NEON
+/* 4 pixels out of y, u and v widened to 16 bits */
+static inline uint32x4_t
+_evas_yuv_rgb_neon(const Evas_YUV_Matrix *m, uint16x4_t y16, uint16x4_t u16, uint16x4_t v16)
+{
+   const int32x4_t max = vdupq_n_s32(255);
+   const int32x4_t zero = vdupq_n_s32(0);
+   int32x4_t y, u, v, r, g, b;
+   uint32x4_t p;
+
+   y = vsubq_s32(vreinterpretq_s32_u32(vmovl_u16(y16)), vdupq_n_s32(16));
+   u = vsubq_s32(vreinterpretq_s32_u32(vmovl_u16(u16)), vdupq_n_s32(128));
+   v = vsubq_s32(vreinterpretq_s32_u32(vmovl_u16(v16)), vdupq_n_s32(128));
+   if (m->fy)
+     {
+        const int32x4_t off = vdupq_n_s32(OFF);
+
+        y = vmulq_n_s32(y, m->fy);
+        r = vmlaq_n_s32(y, v, m->frv);
+        g = vmlaq_n_s32(vmulq_n_s32(v, m->fgv), u, m->fgu);
+        g = vsubq_s32(vaddq_s32(y, off), g);
+        b = vmlaq_n_s32(vaddq_s32(y, off), u, m->fbu);
+        r = vshrq_n_s32(r, 16);
+        g = vshrq_n_s32(g, 16);
+        b = vshrq_n_s32(b, 16);
+     }
+   else
+     {
+        const float32x4_t fu = vcvtq_f32_s32(u), fv = vcvtq_f32_s32(v);
+
+        y = vcvtq_s32_f32(vmulq_n_f32(vcvtq_f32_s32(y), m->y));
+        r = vcvtq_s32_f32(vmulq_n_f32(fv, m->rv));
+        g = vaddq_s32(vcvtq_s32_f32(vmulq_n_f32(fv, m->gv)),
+                      vcvtq_s32_f32(vmulq_n_f32(fu, m->gu)));
+        b = vcvtq_s32_f32(vmulq_n_f32(fu, m->bu));
+        r = vaddq_s32(y, r);
+        g = vsubq_s32(y, g);
+        b = vaddq_s32(y, b);
+     }
+   r = vminq_s32(vmaxq_s32(r, zero), max);
+   g = vminq_s32(vmaxq_s32(g, zero), max);
+   b = vminq_s32(vmaxq_s32(b, zero), max);
+   p = vorrq_u32(vshlq_n_u32(vreinterpretq_u32_s32(r), 16),
+                 vshlq_n_u32(vreinterpretq_u32_s32(g), 8));
+   p = vorrq_u32(p, vreinterpretq_u32_s32(b));
+   return vorrq_u32(p, vdupq_n_u32(0xff000000));
+}
 
-	     dp1 += 4;
+static inline void
+_evas_yuv_rgb8_neon(const Evas_YUV_Matrix *m, uint8x8_t y, uint8x8_t u, uint8x8_t v,
+                    DATA32 *dp)
+{
+   const uint16x8_t y16 = vmovl_u8(y), u16 = vmovl_u8(u), v16 = vmovl_u8(v);
 
-	     /* do the bottom 2 pixels */
-	     /* yuv to rgb */
-	     y = _v1164[*yp2++];
-	     *((DATA32 *) dp2) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+   vst1q_u32(dp, _evas_yuv_rgb_neon(m, vget_low_u16(y16), vget_low_u16(u16),
+                                    vget_low_u16(v16)));
+   vst1q_u32(dp + 4, _evas_yuv_rgb_neon(m, vget_high_u16(y16), vget_high_u16(u16),
+                                        vget_high_u16(v16)));
+}
 
-	     dp2 += 4;
+static void
+_evas_yuv_row_neon(const Evas_YUV_Matrix *m, const DATA8 *yp, int ys,
+                   const DATA8 *up, const DATA8 *vp, int cs,
+                   DATA32 *dp, int w)
+{
+   const Evas_YUV_Matrix mm = *m;
+   int x;
 
-	     /* yuv to rgb */
-	     y = _v1164[*yp2++];
-	     *((DATA32 *) dp2) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+   for (x = 0; x + 16 <= w; x += 16)
+     {
+        uint8x8x2_t y, u, v;
 
-	     dp2 += 4;
-	  }
-	/* jump down one line since we are doing 2 at once */
-	dp1 += (w * 4);
-	dp2 += (w * 4);
+        if (cs == 1)
+          {
+             const uint8x8_t u8 = vld1_u8(up + (x >> 1));
+             const uint8x8_t v8 = vld1_u8(vp + (x >> 1));
+
+             y.val[0] = vld1_u8(yp + x);
+             y.val[1] = vld1_u8(yp + x + 8);
+             u = vzip_u8(u8, u8);
+             v = vzip_u8(v8, v8);
+          }
+        else if (cs == 2)
+          {
+             const uint8x8x2_t uv = vld2_u8(up + x);
+
+             y.val[0] = vld1_u8(yp + x);
+             y.val[1] = vld1_u8(yp + x + 8);
+             u = vzip_u8(uv.val[0], uv.val[0]);
+             v = vzip_u8(uv.val[1], uv.val[1]);
+          }
+        else
+          {
+             const uint8x8x4_t yuyv = vld4_u8(yp + (x * 2));
+
+             y = vzip_u8(yuyv.val[0], yuyv.val[2]);
+             u = vzip_u8(yuyv.val[1], yuyv.val[1]);
+             v = vzip_u8(yuyv.val[3], yuyv.val[3]);
+          }
+        _evas_yuv_rgb8_neon(&mm, y.val[0], u.val[0], v.val[0], dp + x);
+        _evas_yuv_rgb8_neon(&mm, y.val[1], u.val[1], v.val[1], dp + x + 8);
      }
+   if (x < w)
+     _evas_yuv_row_c(m, yp + (x * ys), ys, up + ((x >> 1) * cs),
+                     vp + ((x >> 1) * cs), cs, dp + x, w - x);
 }
+#endif
 
-void
-evas_common_convert_yuv_422_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
+static Evas_YUV_Row_Func
+_evas_yuv_row_get(void)
 {
-   if (!initted) _evas_yuv_init();
-   initted = 1;
-   _evas_yuy2torgb_raster(src, dst, w, h);
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     return _evas_yuv_row_avx2;
+#endif
+#ifdef BUILD_SSE41
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE41))
+     return _evas_yuv_row_sse41;
+#endif
+#ifdef BUILD_NEON
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
+     return _evas_yuv_row_neon;
+#endif
+   return _evas_yuv_row_c;
 }
 
-void
-evas_common_convert_yuv_420_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
+static void
+_evas_yuv_rows(const Evas_YUV_Job *job, int y0, int y1)
 {
-   if (!initted) _evas_yuv_init();
-   initted = 1;
-   _evas_nv12torgb_raster(src, dst, w, h);
+   DATA8 **yuv = job->yuv;
+   int w = job->w, h = job->h;
+   int yy;
+
+   for (yy = y0; yy < y1; yy++)
+     {
+        DATA32 *dp = (DATA32 *)job->rgb + (yy * w);
+        DATA8 *up;
+
+        switch (job->layout)
+          {
+           case EVAS_YUV_YUY2:
+             job->row(job->m, yuv[yy], 2, yuv[yy] + 1, yuv[yy] + 3, 4, dp, w);
+             break;
+           case EVAS_YUV_NV12:
+             up = yuv[h + (yy >> 1)];
+             job->row(job->m, yuv[yy], 1, up, up + 1, 2, dp, w);
+             break;
+           default:
+             job->row(job->m, yuv[yy], 1, yuv[h + (yy >> 1)],
+                      yuv[h + (h >> 1) + (yy >> 1)], 1, dp, w);
+             break;
+          }
+     }
 }
 
-void
-evas_common_convert_yuv_420T_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
+/* Frames bigger than 1080p are cut in bands of rows, one per thread. The
+ * threads are started the first time such a frame comes, and a conversion
+ * finding them busy with another frame does its own alone. */
+#define YUV_THREAD_MAX 8
+#define YUV_THREAD_PIXELS (1920 * 1080)
+
+static Eina_Thread yuv_threads[YUV_THREAD_MAX - 1];
+static Eina_Thread_Queue *yuv_queues[YUV_THREAD_MAX - 1];
+static Eina_Thread_Queue *yuv_done = NULL;
+static int yuv_threads_count = 0;
+static Eina_Bool yuv_threads_tried = EINA_FALSE;
+static Eina_Bool yuv_fork_cb = EINA_FALSE;
+static LK(yuv_lock);
+
+static void *
+_evas_yuv_thread(void *data, Eina_Thread t EINA_UNUSED)
 {
-   if (initted) _evas_yuv_init();
-   initted = 1;
-   _evas_nv12tiledtorgb_raster(src, dst, w, h);
+   Eina_Thread_Queue *queue = yuv_queues[(uintptr_t)data];
+   const Evas_YUV_Job *job;
+
+   eina_thread_name_set(eina_thread_self(), "Evas-yuv");
+   do
+     {
+        Evas_YUV_Msg *msg;
+        void *ref;
+        int y0 = 0, y1 = 0;
+
+        job = NULL;
+        msg = eina_thread_queue_wait(queue, &ref);
+        if (msg)
+          {
+             job = msg->job;
+             y0 = msg->y0;
+             y1 = msg->y1;
+             eina_thread_queue_wait_done(queue, ref);
+          }
+        if (job) _evas_yuv_rows(job, y0, y1);
+
+        msg = eina_thread_queue_send(yuv_done, sizeof (Evas_YUV_Msg), &ref);
+        msg->job = job;
+        eina_thread_queue_send_done(yuv_done, ref);
+     }
+   while (job);
+
+   return NULL;
 }
 
 static void
-_evas_yuy2torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
+_evas_yuv_threads_fork_reset(void *data EINA_UNUSED)
 {
-   int xx, yy;
-   int y, u, v;
-   unsigned char *yp1, *yp2, *up, *vp;
-   unsigned char *dp1;
+   int i;
 
-   dp1 = rgb;
+   /* the threads are gone in the child, start them again when needed */
+   for (i = 0; i < yuv_threads_count; i++)
+     eina_thread_queue_free(yuv_queues[i]);
+   if (yuv_done) eina_thread_queue_free(yuv_done);
+   yuv_done = NULL;
+   yuv_threads_count = 0;
+   yuv_threads_tried = EINA_FALSE;
+   LKI(yuv_lock);
+}
 
-   /* destination pointers */
-   for (yy = 0; yy < h; yy++)
-     {
-        /* plane pointers */
-        unsigned char *line;
+static void
+_evas_yuv_threads_start(void)
+{
+   int n;
 
-        line = yuv[yy];
-        yp1 = line + 0;
-        up = line + 1;
-        yp2 = line + 2;
-        vp = line + 3;
+   yuv_threads_tried = EINA_TRUE;
 
-        for (xx = 0; xx < w; xx += 2)
-          {
-             int vmu;
+//Eina_Thread_Queue doesn't work on WIN32.
+#ifdef _WIN32
+   return;
+#endif
 
-             /* collect u & v for 2 pixels block */
-             u = *up;
-             v = *vp;
+   n = eina_cpu_count() - 1;
+   if (n > YUV_THREAD_MAX - 1) n = YUV_THREAD_MAX - 1;
+   if (n <= 0) return;
 
-             /* save lookups */
-             vmu = _v813[v] + _v391[u];
-             u = _v2018[u];
-             v = _v1596[v];
+   yuv_done = eina_thread_queue_new();
+   if (EINA_UNLIKELY(!yuv_done))
+     {
+        ERR("Failed to create thread queue");
+        return;
+     }
+   if (!yuv_fork_cb)
+     {
+        ecore_fork_reset_callback_add(_evas_yuv_threads_fork_reset, NULL);
+        yuv_fork_cb = EINA_TRUE;
+     }
 
-             /* do the top 2 pixels of the 2x2 block which shared u & v */
-	     /* yuv to rgb */
-	     y = _v1164[*yp1];
-	     *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+   while (yuv_threads_count < n)
+     {
+        int i = yuv_threads_count;
 
-	     dp1 += 4;
+        yuv_queues[i] = eina_thread_queue_new();
+        if (EINA_UNLIKELY(!yuv_queues[i]))
+          {
+             ERR("Failed to create thread queue");
+             break;
+          }
+        if (!eina_thread_create(&yuv_threads[i], EINA_THREAD_NORMAL, -1,
+                                _evas_yuv_thread, (void *)(uintptr_t)i))
+          {
+             ERR("Failed to create a YUV conversion thread");
+             eina_thread_queue_free(yuv_queues[i]);
+             break;
+          }
+        yuv_threads_count++;
+     }
+}
 
-	     /* yuv to rgb */
-	     y = _v1164[*yp2];
-	     *((DATA32 *) dp1) = 0xff000000 + RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
+static void
+_evas_yuv_convert(DATA8 **yuv, DATA8 *rgb, int w, int h,
+                  Evas_YUV_Layout layout, const Evas_YUV_Matrix *m,
+                  Evas_YUV_Row_Func row)
+{
+   Evas_YUV_Job job;
+   Evas_YUV_Msg *msg;
+   void *ref;
+   int i, band;
+
+   job.m = m;
+   job.row = row;
+   job.layout = layout;
+   job.yuv = yuv;
+   job.rgb = rgb;
+   job.w = w;
+   job.h = h;
+
+   if ((w * h <= YUV_THREAD_PIXELS) ||
+       (LKT(yuv_lock) != EINA_LOCK_SUCCEED))
+     {
+        _evas_yuv_rows(&job, 0, h);
+        return;
+     }
 
-             dp1 += 4;
+   if (!yuv_threads_tried) _evas_yuv_threads_start();
 
-	     yp1 += 4; yp2 += 4; up += 4; vp += 4;
-	  }
+   band = (h + yuv_threads_count) / (yuv_threads_count + 1);
+   for (i = 0; i < yuv_threads_count; i++)
+     {
+        msg = eina_thread_queue_send(yuv_queues[i], sizeof (Evas_YUV_Msg), &ref);
+        msg->job = &job;
+        msg->y0 = (i + 1) * band;
+        msg->y1 = (i + 2) * band;
+        if (msg->y0 > h) msg->y0 = h;
+        if (msg->y1 > h) msg->y1 = h;
+        eina_thread_queue_send_done(yuv_queues[i], ref);
+     }
+
+   _evas_yuv_rows(&job, 0, band > h ? h : band);
+
+   for (i = 0; i < yuv_threads_count; i++)
+     {
+        msg = eina_thread_queue_wait(yuv_done, &ref);
+        if (msg) eina_thread_queue_wait_done(yuv_done, ref);
      }
+
+   LKU(yuv_lock);
 }
 
-static inline void
-_evas_yuv2rgb_420_raster(unsigned char *yp1, unsigned char *yp2, unsigned char *up, unsigned char *vp,
-                         unsigned char *dp1, unsigned char *dp2)
+EAPI void
+evas_common_convert_yuv_init(void)
 {
-   int y, u, v;
-   int vmu;
-   int rgb;
-
-   /* collect u & v for 4 pixels block */
-   u = *up;
-   v = *vp;
-
-   /* save lookups */
-#ifdef MEM_BP
-   vmu = _v813[v] + _v391[u];
-   u = _v2018[u];
-   v = _v1596[v];
-#else
-   u -= 128;
-   v -= 128;
-   vmu = v * CGV + u * CGU;
-   u = u * CBU;
-   v = v * CRV;
-#endif
-
-   /* do the top 2 pixels of the 2x2 block which shared u & v */
-   /* yuv to rgb */
-#ifdef MEM_BP
-   y = _v1164[*yp1];
-   rgb = RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
-#else
-   y = (*yp1 - 16 ) * YMUL;
-   rgb = RGB_JOIN(LUT_CLIP(((y + v) >> 16)),
-                  LUT_CLIP(((y - vmu + OFF) >> 16)),
-                  LUT_CLIP(((y + u + OFF) >> 16)));
-#endif
-   *((DATA32 *) dp1) = 0xff000000 + rgb;
+   LKI(yuv_lock);
+}
 
-   dp1 += 4; yp1++;
+EAPI void
+evas_common_convert_yuv_shutdown(void)
+{
+   Evas_YUV_Msg *msg;
+   void *ref;
+   int i;
 
-   /* yuv to rgb */
-#ifdef MEM_BP
-   y = _v1164[*yp1];
-   rgb = RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
-#else
-   y = (*yp1 - 16 ) * YMUL;
-   rgb = RGB_JOIN(LUT_CLIP(((y + v) >> 16)),
-                  LUT_CLIP(((y - vmu + OFF) >> 16)),
-                  LUT_CLIP(((y + u + OFF) >> 16)));
-#endif
-   *((DATA32 *) dp1) = 0xff000000 + rgb;
+   LKL(yuv_lock);
+   for (i = 0; i < yuv_threads_count; i++)
+     {
+        msg = eina_thread_queue_send(yuv_queues[i], sizeof (Evas_YUV_Msg), &ref);
+        msg->job = NULL;
+        eina_thread_queue_send_done(yuv_queues[i], ref);
+     }
+   /* Here are the threads leaving */
+   for (i = 0; i < yuv_threads_count; i++)
+     {
+        msg = eina_thread_queue_wait(yuv_done, &ref);
+        if (msg) eina_thread_queue_wait_done(yuv_done, ref);
+     }
+   for (i = 0; i < yuv_threads_count; i++)
+     {
+        eina_thread_join(yuv_threads[i]);
+        eina_thread_queue_free(yuv_queues[i]);
+     }
+   if (yuv_done) eina_thread_queue_free(yuv_done);
+   yuv_done = NULL;
+   yuv_threads_count = 0;
+   yuv_threads_tried = EINA_FALSE;
+   if (yuv_fork_cb)
+     ecore_fork_reset_callback_del(_evas_yuv_threads_fork_reset, NULL);
+   yuv_fork_cb = EINA_FALSE;
+   LKU(yuv_lock);
+   LKD(yuv_lock);
+}
 
-   /* do the bottom 2 pixels of the 2x2 block which shared u & v */
-   /* yuv to rgb */
-#ifdef MEM_BP
-   y = _v1164[*yp2];
-   rgb = RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
-#else
-   y = (*yp2 - 16 ) * YMUL;
-   rgb = RGB_JOIN(LUT_CLIP(((y + v) >> 16)),
-                  LUT_CLIP(((y - vmu + OFF) >> 16)),
-                  LUT_CLIP(((y + u + OFF) >> 16)));
-#endif
-   *((DATA32 *) dp2) = 0xff000000 + rgb;
+void
+evas_common_convert_yuv_422_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
+{
+   if (!initted) _evas_yuv_init();
+   initted = 1;
+   _evas_yuv_convert(src, dst, w, h, EVAS_YUV_YUY2, &_evas_yuv_601,
+                     _evas_yuv_row_get());
+}
 
-   dp2 += 4; yp2++;
+void
+evas_common_convert_yuv_420_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
+{
+   if (!initted) _evas_yuv_init();
+   initted = 1;
+   _evas_yuv_convert(src, dst, w, h, EVAS_YUV_NV12, &_evas_yuv_601_fixed,
+                     _evas_yuv_row_get());
+}
 
-   /* yuv to rgb */
-#ifdef MEM_BP
-   y = _v1164[*yp2];
-   rgb = RGB_JOIN(LUT_CLIP(y + v), LUT_CLIP(y - vmu), LUT_CLIP(y + u));
-#else
-   y = (*yp2 - 16 ) * YMUL;
-   rgb = RGB_JOIN(LUT_CLIP(((y + v) >> 16)),
-                  LUT_CLIP(((y - vmu + OFF) >> 16)),
-                  LUT_CLIP(((y + u + OFF) >> 16)));
-#endif
-   *((DATA32 *) dp2) = 0xff000000 + rgb;
+void
+evas_common_convert_yuv_420T_601_rgba(DATA8 **src, DATA8 *dst, int w, int h)
+{
+   if (!initted) _evas_yuv_init();
+   initted = 1;
+   _evas_nv12tiledtorgb_raster(src, dst, w, h);
 }
 
 static void
 _evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
 {
-#define HANDLE_MACROBLOCK(YP1, YP2, UP, VP, DP1, DP2)                   \
+#define HANDLE_MACROBLOCK(YP, UP, DP)                                   \
    {                                                                    \
      int i;                                                             \
-     int j;                                                             \
-                                                                        \
-     for (i = 0; i < 32; i += 2)                                        \
-       {                                                                \
-          for (j = 0; j < 64; j += 2)                                   \
-            {                                                           \
-               _evas_yuv2rgb_420_raster(YP1, YP2, UP, VP, DP1, DP2);    \
-                                                                        \
-               /* the previous call just rendered 2 pixels per lines */ \
-               DP1 += 8; DP2 += 8;                                      \
-                                                                        \
-               /* and took for that 2 lines with 2 Y, 1 U and 1 V. Don't forget U & V are in the same plane */ \
-               YP1 += 2; YP2 += 2; UP += 2; VP += 2;                    \
-            }                                                           \
                                                                         \
-          DP1 += sizeof (int) * ((w << 1) - 64);			\
-          DP2 += sizeof (int) * ((w << 1) - 64);			\
-          YP1 += 64;                                                    \
-          YP2 += 64;                                                    \
-       }                                                                \
+     /* 32 lines of 64 Y, each two of them sharing a line of 32 UV */   \
+     for (i = 0; i < 32; i++)                                           \
+       row(&_evas_yuv_601_fixed, YP + i * 64, 1,                        \
+           UP + (i >> 1) * 64, UP + (i >> 1) * 64 + 1, 2,               \
+           (DATA32 *)(DP + i * stride), 64);                            \
    }
 
    /* One macro block is 32 lines of Y and 16 lines of UV */
    const int offset_value[2] = { 0, 64 * 16 };
+   Evas_YUV_Row_Func row = _evas_yuv_row_get();
    int mb_x, mb_y, mb_w, mb_h;
    int base_h;
    int uv_x, uv_step;
    int stride;
 
-   /* Idea iterate over each macroblock and convert each of them using _evas_nv12torgb_raster */
+   /* Idea iterate over each macroblock and convert each of them a line at a time */
 
    /* The layout of the Y macroblock order in RGB non tiled space : */
    /* --------------------------------------------------- */
@@ -1549,20 +2011,17 @@ _evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int
 
 	for (mb_x = 0; mb_x < mb_w * 2; mb_x++, rmb_x += 64 * 32)
 	  {
-	    unsigned char *yp1, *yp2, *up, *vp;
-	    unsigned char *dp1, *dp2;
+	    unsigned char *yp, *up;
+	    unsigned char *dp;
 
-	    dp1 = rgb + x + ry[offset];
-	    dp2 = dp1 + stride;
+	    dp = rgb + x + ry[offset];
 
-	    yp1 = yuv[mb_y] + rmb_x;
-	    yp2 = yp1 + 64;
+	    yp = yuv[mb_y] + rmb_x;
 
 	    /* UV plane is two time less bigger in pixel count, but it old two bytes each times */
 	    up = yuv[(mb_y >> 1) + base_h] + uv_x + offset_value[offset];
-	    vp = up + 1;
 
-	    HANDLE_MACROBLOCK(yp1, yp2, up, vp, dp1, dp2);
+	    HANDLE_MACROBLOCK(yp, up, dp);
 
 	    step++;
 	    if ((step & 0x3) == 0)
@@ -1598,56 +2057,16 @@ _evas_nv12tiledtorgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int
 
         for (mb_x = 0; mb_x < mb_w; mb_x++, x++, uv_x++)
           {
-             unsigned char *yp1, *yp2, *up, *vp;
-             unsigned char *dp1, *dp2;
+             unsigned char *yp, *up;
+             unsigned char *dp;
 
-             dp1 = rgb + (x * 64 + (ry * 32 * w)) * sizeof (int);
-             dp2 = dp1 + sizeof (int) * w;
+             dp = rgb + (x * 64 + (ry * 32 * w)) * sizeof (int);
 
-             yp1 = yuv[mb_y] + mb_x * 64 * 32;
-             yp2 = yp1 + 64;
+             yp = yuv[mb_y] + mb_x * 64 * 32;
 
              up = yuv[mb_y / 2 + base_h] + uv_x * 64 * 32;
-             vp = up + 1;
 
-             HANDLE_MACROBLOCK(yp1, yp2, up, vp, dp1, dp2);
+             HANDLE_MACROBLOCK(yp, up, dp);
           }
      }
 }
-
-static void
-_evas_nv12torgb_raster(unsigned char **yuv, unsigned char *rgb, int w, int h)
-{
-   int xx, yy;
-   unsigned char *yp1, *yp2, *up, *vp;
-   unsigned char *dp1;
-   unsigned char *dp2;
-
-   dp1 = rgb;
-   dp2 = dp1 + sizeof (int) * w;
-
-   for (yy = 0; yy < h; yy++)
-     {
-        yp1 = yuv[yy++];
-        yp2 = yuv[yy];
-
-        up = yuv[h + (yy >> 1)];
-        vp = up + 1;
-
-        for (xx = 0; xx < w; xx += 2)
-          {
-             _evas_yuv2rgb_420_raster(yp1, yp2, up, vp, dp1, dp2);
-
-             /* the previous call just rendered 2 pixels per lines */
-             dp1 += 8; dp2 += 8;
-
-             /* and took for that 2 lines with 2 Y, 1 U and 1 V. Don't forget U & V are in the same plane */
-             yp1 += 2; yp2 += 2; up += 2; vp += 2;
-          }
-
-        /* jump one line */
-        dp1 += sizeof (int) * w;
-        dp2 += sizeof (int) * w;
-     }
-}
-
@@ -1,6 +1,9 @@
 #ifndef _EVAS_CONVERT_YUV_H
 #define _EVAS_CONVERT_YUV_H
 
+EAPI void evas_common_convert_yuv_init              (void);
+EAPI void evas_common_convert_yuv_shutdown          (void);
+
 EAPI void evas_common_convert_yuv_422p_709_rgba     (DATA8 **src, DATA8 *dst, int w, int h);
 
 EAPI void evas_common_convert_yuv_422p_601_rgba     (DATA8 **src, DATA8 *dst, int w, int h);
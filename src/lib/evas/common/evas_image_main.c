@@ -483,6 +483,7 @@ _evas_common_rgba_image_new(void)
    im->flags = RGBA_IMAGE_NOTHING;
 
    evas_common_rgba_image_scalecache_init(&im->cache_entry);
+   evas_common_rgba_image_mipmap_init(&im->cache_entry);
    return &im->cache_entry;
 }
 
@@ -505,6 +506,7 @@ _evas_common_rgba_image_delete(Image_Entry *ie)
         ie->loader_data = NULL;
      }
    evas_common_rgba_image_scalecache_shutdown(&im->cache_entry);
+   evas_common_rgba_image_mipmap_shutdown(&im->cache_entry);
    if (ie->info.module) evas_module_unref((Evas_Module *)ie->info.module);
 
    if (ie->animated.frames)
@@ -528,6 +530,7 @@ evas_common_rgba_image_unload_real(Image_Entry *ie)
    RGBA_Image   *im = (RGBA_Image *) ie;
 
    ie->flags.loaded = 0;
+   evas_common_rgba_image_mipmap_dirty(ie);
 
    if ((im->cs.data) && (im->image.data))
      {
@@ -697,6 +700,7 @@ _evas_common_rgba_image_surface_alloc(Image_Entry *ie,
 
    if (im->image.no_free) return 0;
 
+   evas_common_rgba_image_mipmap_dirty(ie);
    if (im->image.data)
      {
         evas_common_rgba_image_surface_munmap(im->image.data,
@@ -757,6 +761,7 @@ _evas_common_rgba_image_surface_delete(Image_Entry *ie)
 # endif
 #endif
    if (ie->file) DBG("unload: [%p] %s %s", ie, ie->file, ie->key);
+   evas_common_rgba_image_mipmap_dirty(ie);
    if ((im->cs.data) && (im->image.data))
      {
         if (im->cs.data != im->image.data)
@@ -809,6 +814,7 @@ _evas_common_rgba_image_dirty_region(Image_Entry* ie,
 
    im->flags |= RGBA_IMAGE_IS_DIRTY;
    evas_common_rgba_image_scalecache_dirty(&im->cache_entry);
+   evas_common_rgba_image_mipmap_dirty(&im->cache_entry);
 }
 
 /* Only called when references > 0. Need to provide a fresh copie of im. */
@@ -820,6 +826,7 @@ _evas_common_rgba_image_dirty(Image_Entry *ie_dst, const Image_Entry *ie_src)
 
    evas_common_rgba_image_scalecache_dirty((Image_Entry *)ie_src);
    evas_common_rgba_image_scalecache_dirty(ie_dst);
+   evas_common_rgba_image_mipmap_dirty(ie_dst);
    evas_cache_image_load_data(&src->cache_entry);
    if (!evas_cache_image_pixels(ie_dst))
      {
@@ -852,6 +859,7 @@ _evas_common_rgba_image_ram_usage(Image_Entry *ie)
           size += im->cache_entry.w * im->cache_entry.h * sizeof(DATA32);
      }
    size += evas_common_rgba_image_scalecache_usage_get(&im->cache_entry);
+   size += evas_common_rgba_image_mipmap_usage_get(&im->cache_entry);
    return size;
 }
 
@@ -906,6 +914,28 @@ evas_common_image_new(unsigned int w, unsigned int h, unsigned int alpha)
    return evas_common_image_create(w, h);
 }
 
+/* wraps pixels living in a map of f, which the image then owns: freeing the
+ * image closes f and drops the map with it */
+RGBA_Image *
+evas_common_image_mapped_new(Eina_File *f, DATA32 *data,
+                             unsigned int w, unsigned int h, unsigned int alpha)
+{
+   RGBA_Image *im;
+
+   im = (RGBA_Image *) _evas_common_rgba_image_new();
+   if (!im) return NULL;
+   im->cache_entry.w = w;
+   im->cache_entry.h = h;
+   im->cache_entry.flags.alpha = !!alpha;
+   im->cache_entry.flags.loaded = 1;
+   im->cache_entry.flags.cached = 0;
+   im->cache_entry.space = EVAS_COLORSPACE_ARGB8888;
+   im->cache_entry.f = f;
+   im->image.data = data;
+   im->image.no_free = 1;
+   return im;
+}
+
 void
 evas_common_image_colorspace_normalize(RGBA_Image *im)
 {
@@ -0,0 +1,268 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "evas_common_private.h"
+#include "evas_private.h"
+#include "evas_image_private.h"
+
+#ifdef BUILD_NEON
+# include <arm_neon.h>
+#endif
+
+/* Half size levels of images drawn heavily downscaled.
+ *
+ * Level n is level n - 1 box filtered 2x2, level 0 being the image itself.
+ * Only images opted in with evas_object_image_scale_mipmap_set() get them,
+ * and only as deep as a draw needs: the smooth scaler then starts from a
+ * level less than twice the size it draws at, so its cost follows the
+ * destination size and not the source one. */
+
+typedef void (*Evas_Mipmap_Row_Func)(const DATA32 *s0, const DATA32 *s1,
+                                     DATA32 *d, int w);
+
+/* the four pixels each channel is averaged over sum up to 10 bits, which
+ * leaves the two channels held 16 bits apart clear of each other */
+static void
+_evas_mipmap_row_c(const DATA32 *s0, const DATA32 *s1, DATA32 *d, int w)
+{
+   DATA32 *e = d + w;
+
+   for (; d < e; d++, s0 += 2, s1 += 2)
+     {
+        DATA32 rb, ag;
+
+        rb = (s0[0] & 0x00ff00ff) + (s0[1] & 0x00ff00ff) +
+          (s1[0] & 0x00ff00ff) + (s1[1] & 0x00ff00ff) + 0x00020002;
+        ag = ((s0[0] >> 8) & 0x00ff00ff) + ((s0[1] >> 8) & 0x00ff00ff) +
+          ((s1[0] >> 8) & 0x00ff00ff) + ((s1[1] >> 8) & 0x00ff00ff) +
+          0x00020002;
+        *d = ((rb >> 2) & 0x00ff00ff) | ((ag << 6) & 0xff00ff00);
+     }
+}
+
+#ifdef BUILD_SSE41
+/* 4 pixels at a time: both rows are summed in 16-bit lanes, then each
+ * even pixel with the odd one next to it */
+static EVAS_TARGET_SSE41 void
+_evas_mipmap_row_sse41(const DATA32 *s0, const DATA32 *s1, DATA32 *d, int w)
+{
+   const __m128i two = _mm_set1_epi16(2);
+   const __m128i zero = _mm_setzero_si128();
+   int x;
+
+   for (x = 0; x + 4 <= w; x += 4, s0 += 8, s1 += 8)
+     {
+        __m128i a0 = _mm_loadu_si128((const __m128i *)s0);
+        __m128i a1 = _mm_loadu_si128((const __m128i *)(s0 + 4));
+        __m128i b0 = _mm_loadu_si128((const __m128i *)s1);
+        __m128i b1 = _mm_loadu_si128((const __m128i *)(s1 + 4));
+        __m128i lo, hi, q0, q1;
+
+        lo = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        hi = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        q0 = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+        lo = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        hi = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+        q1 = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+        q0 = _mm_srli_epi16(_mm_add_epi16(q0, two), 2);
+        q1 = _mm_srli_epi16(_mm_add_epi16(q1, two), 2);
+        _mm_storeu_si128((__m128i *)(d + x), _mm_packus_epi16(q0, q1));
+     }
+   if (x < w) _evas_mipmap_row_c(s0, s1, d + x, w - x);
+}
+#endif
+
+#ifdef BUILD_AVX2
+/* the same on 8 pixels, the in lane packing putting them back in order
+ * with one permute */
+static EVAS_TARGET_AVX2 void
+_evas_mipmap_row_avx2(const DATA32 *s0, const DATA32 *s1, DATA32 *d, int w)
+{
+   const __m256i two = _mm256_set1_epi16(2);
+   const __m256i zero = _mm256_setzero_si256();
+   int x;
+
+   for (x = 0; x + 8 <= w; x += 8, s0 += 16, s1 += 16)
+     {
+        __m256i a0 = LOAD_AVX2(s0), a1 = LOAD_AVX2(s0 + 8);
+        __m256i b0 = LOAD_AVX2(s1), b1 = LOAD_AVX2(s1 + 8);
+        __m256i lo, hi, q0, q1;
+
+        lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a0, zero), _mm256_unpacklo_epi8(b0, zero));
+        hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a0, zero), _mm256_unpackhi_epi8(b0, zero));
+        q0 = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+        lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a1, zero), _mm256_unpacklo_epi8(b1, zero));
+        hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a1, zero), _mm256_unpackhi_epi8(b1, zero));
+        q1 = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+        q0 = _mm256_srli_epi16(_mm256_add_epi16(q0, two), 2);
+        q1 = _mm256_srli_epi16(_mm256_add_epi16(q1, two), 2);
+        STORE_AVX2(d + x, _mm256_permute4x64_epi64(_mm256_packus_epi16(q0, q1),
+                                                   _MM_SHUFFLE(3, 1, 2, 0)));
+     }
+   if (x < w) _evas_mipmap_row_c(s0, s1, d + x, w - x);
+}
+#endif
+
+#ifdef BUILD_NEON
+/* 4 pixels at a time, the loads splitting even and odd pixels */
+static void
+_evas_mipmap_row_neon(const DATA32 *s0, const DATA32 *s1, DATA32 *d, int w)
+{
+   int x;
+
+   for (x = 0; x + 4 <= w; x += 4, s0 += 8, s1 += 8)
+     {
+        uint32x4x2_t a = vld2q_u32(s0), b = vld2q_u32(s1);
+        uint8x16_t a0 = vreinterpretq_u8_u32(a.val[0]);
+        uint8x16_t a1 = vreinterpretq_u8_u32(a.val[1]);
+        uint8x16_t b0 = vreinterpretq_u8_u32(b.val[0]);
+        uint8x16_t b1 = vreinterpretq_u8_u32(b.val[1]);
+        uint16x8_t lo, hi;
+
+        lo = vaddq_u16(vaddl_u8(vget_low_u8(a0), vget_low_u8(a1)),
+                       vaddl_u8(vget_low_u8(b0), vget_low_u8(b1)));
+        hi = vaddq_u16(vaddl_u8(vget_high_u8(a0), vget_high_u8(a1)),
+                       vaddl_u8(vget_high_u8(b0), vget_high_u8(b1)));
+        vst1q_u32(d + x, vreinterpretq_u32_u8(vcombine_u8(vrshrn_n_u16(lo, 2),
+                                                          vrshrn_n_u16(hi, 2))));
+     }
+   if (x < w) _evas_mipmap_row_c(s0, s1, d + x, w - x);
+}
+#endif
+
+static Evas_Mipmap_Row_Func
+_evas_mipmap_row_get(void)
+{
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     return _evas_mipmap_row_avx2;
+#endif
+#ifdef BUILD_SSE41
+   if (evas_common_cpu_has_feature(CPU_FEATURE_SSE41))
+     return _evas_mipmap_row_sse41;
+#endif
+#ifdef BUILD_NEON
+   if (evas_common_cpu_has_feature(CPU_FEATURE_NEON))
+     return _evas_mipmap_row_neon;
+#endif
+   return _evas_mipmap_row_c;
+}
+
+static RGBA_Image *
+_evas_mipmap_level_new(RGBA_Image *parent)
+{
+   Evas_Mipmap_Row_Func row;
+   RGBA_Image *im;
+   unsigned int w, h, y, pw;
+
+   w = parent->cache_entry.w / 2;
+   h = parent->cache_entry.h / 2;
+   im = evas_common_image_new(w, h, parent->cache_entry.flags.alpha);
+   if (!im) return NULL;
+
+   row = _evas_mipmap_row_get();
+   pw = parent->cache_entry.w;
+   for (y = 0; y < h; y++)
+     {
+        const DATA32 *s = parent->image.data + (y * 2 * pw);
+
+        row(s, s + pw, im->image.data + (y * w), w);
+     }
+   return im;
+}
+
+void
+evas_common_rgba_image_mipmap_init(Image_Entry *ie)
+{
+   RGBA_Image *im = (RGBA_Image *)ie;
+
+   SLKI(im->mipmap.lock);
+}
+
+void
+evas_common_rgba_image_mipmap_shutdown(Image_Entry *ie)
+{
+   RGBA_Image *im = (RGBA_Image *)ie;
+
+   evas_common_rgba_image_mipmap_dirty(ie);
+   SLKD(im->mipmap.lock);
+}
+
+void
+evas_common_rgba_image_mipmap_dirty(Image_Entry *ie)
+{
+   RGBA_Image *im = (RGBA_Image *)ie;
+   unsigned int i;
+
+   SLKL(im->mipmap.lock);
+   for (i = 0; i < im->mipmap.count; i++)
+     {
+        evas_common_rgba_image_free(&im->mipmap.levels[i]->cache_entry);
+        im->mipmap.levels[i] = NULL;
+     }
+   im->mipmap.count = 0;
+   SLKU(im->mipmap.lock);
+}
+
+int
+evas_common_rgba_image_mipmap_usage_get(Image_Entry *ie)
+{
+   RGBA_Image *im = (RGBA_Image *)ie;
+   unsigned int i;
+   int size = 0;
+
+   SLKL(im->mipmap.lock);
+   for (i = 0; i < im->mipmap.count; i++)
+     size += im->mipmap.levels[i]->cache_entry.w *
+       im->mipmap.levels[i]->cache_entry.h * sizeof(DATA32);
+   SLKU(im->mipmap.lock);
+   return size;
+}
+
+RGBA_Image *
+evas_common_rgba_image_mipmap_get(RGBA_Image *im,
+                                  int *src_region_x, int *src_region_y,
+                                  int *src_region_w, int *src_region_h,
+                                  int dst_region_w, int dst_region_h)
+{
+   Image_Entry *ie = &im->cache_entry;
+   RGBA_Image *lim = im;
+   int level = 0;
+   unsigned int n;
+
+   if ((!ie->flags.mipmap) ||
+       (ie->space != EVAS_COLORSPACE_ARGB8888) ||
+       (ie->animated.animated) || (!im->image.data) ||
+       (dst_region_w <= 0) || (dst_region_h <= 0))
+     return im;
+
+   // deepest level still at least as large as the destination
+   while ((level < EVAS_MIPMAP_LEVELS) &&
+          ((*src_region_w >> (level + 1)) >= dst_region_w) &&
+          ((*src_region_h >> (level + 1)) >= dst_region_h) &&
+          ((ie->w >> (level + 1)) > 0) && ((ie->h >> (level + 1)) > 0))
+     level++;
+   if (!level) return im;
+
+   SLKL(im->mipmap.lock);
+   for (n = im->mipmap.count; n < (unsigned int)level; n++)
+     {
+        RGBA_Image *l;
+
+        l = _evas_mipmap_level_new(n ? im->mipmap.levels[n - 1] : im);
+        if (!l) break;
+        im->mipmap.levels[n] = l;
+        im->mipmap.count = n + 1;
+     }
+   if (im->mipmap.count < (unsigned int)level) level = im->mipmap.count;
+   if (level) lim = im->mipmap.levels[level - 1];
+   SLKU(im->mipmap.lock);
+   if (!level) return im;
+
+   *src_region_x >>= level;
+   *src_region_y >>= level;
+   *src_region_w >>= level;
+   *src_region_h >>= level;
+   return lim;
+}
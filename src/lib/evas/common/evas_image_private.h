@@ -5,6 +5,7 @@ int             evas_common_rgba_image_size_set              (Image_Entry* dst,
 int             evas_common_rgba_image_from_copied_data      (Image_Entry* dst, unsigned int w, unsigned int h, DATA32 *image_data, int alpha, Evas_Colorspace cspace);
 int             evas_common_rgba_image_from_data             (Image_Entry* dst, unsigned int w, unsigned int h, DATA32 *image_data, int alpha, Evas_Colorspace cspace);
 int             evas_common_rgba_image_colorspace_set        (Image_Entry* dst, Evas_Colorspace cspace);
+RGBA_Image     *evas_common_image_mapped_new                 (Eina_File *f, DATA32 *data, unsigned int w, unsigned int h, unsigned int alpha);
 
 void evas_common_scalecache_init(void);
 void evas_common_scalecache_shutdown(void);
@@ -12,4 +13,10 @@ void evas_common_rgba_image_scalecache_dirty(Image_Entry *ie);
 void evas_common_rgba_image_scalecache_orig_use(Image_Entry *ie);
 int evas_common_rgba_image_scalecache_usage_get(Image_Entry *ie);
 
+void evas_common_rgba_image_mipmap_init(Image_Entry *ie);
+void evas_common_rgba_image_mipmap_shutdown(Image_Entry *ie);
+void evas_common_rgba_image_mipmap_dirty(Image_Entry *ie);
+int evas_common_rgba_image_mipmap_usage_get(Image_Entry *ie);
+RGBA_Image *evas_common_rgba_image_mipmap_get(RGBA_Image *im, int *src_region_x, int *src_region_y, int *src_region_w, int *src_region_h, int dst_region_w, int dst_region_h);
+
 #endif /* _EVAS_IMAGE_PRIVATE_H */
@@ -7,11 +7,16 @@
 #endif
 
 #include <assert.h>
+#include <errno.h>
+#include <utime.h>
+#include <sys/stat.h>
 
 #include "evas_common_private.h"
 #include "evas_private.h"
 #include "evas_image_private.h"
 
+#include "Ecore.h"
+
 #define SCALECACHE 1
 
 #define MAX_SCALEITEMS 32
@@ -23,9 +28,16 @@
 #define FLOP_DEL 1
 #define SCALE_CACHE_SIZE 4 * 1024 * 1024
 //#define SCALE_CACHE_SIZE 0
+#define SCALE_CACHE_DISK_SIZE 64 * 1024 * 1024
+// bump whenever the scalers start giving different results
+#define SCALE_CACHE_DISK_MAGIC "EvScl001"
 
 typedef struct _ScaleitemKey ScaleitemKey;
 typedef struct _Scaleitem Scaleitem;
+typedef struct _Scalecache_Disk_Header Scalecache_Disk_Header;
+typedef struct _Scalecache_Disk_Entry Scalecache_Disk_Entry;
+typedef struct _Scalecache_Disk_File Scalecache_Disk_File;
+typedef struct _Scalecache_Disk_Msg Scalecache_Disk_Msg;
 
 struct _ScaleitemKey
 {
@@ -49,6 +61,42 @@ struct _Scaleitem
 
    Eina_Bool forced_unload : 1;
    Eina_Bool populate_me : 1;
+   Eina_Bool disk_checked : 1;
+};
+
+/* the disk tier keeps one file per smooth scaled result: this header, the
+ * key it was stored under and, from data_offset on, the pixels. files are
+ * only ever replaced by a rename or unlinked, so a map of one stays valid
+ * whatever other processes do to the directory. */
+struct _Scalecache_Disk_Header
+{
+   char         magic[8];
+   unsigned int w, h;
+   unsigned int alpha;
+   unsigned int key_len;
+   unsigned int data_offset;
+};
+
+struct _Scalecache_Disk_Entry
+{
+   unsigned long long mtime;
+   unsigned long      size;
+   char               path[];
+};
+
+/* a result waiting for the writer thread: the whole file as it is to be
+ * written, pixels copied, as the scale item can go at any time */
+struct _Scalecache_Disk_File
+{
+   char          path[EINA_PATH_MAX];
+   size_t        size;
+   unsigned char data[];
+};
+
+struct _Scalecache_Disk_Msg
+{
+   Eina_Thread_Queue_Msg head;
+   Scalecache_Disk_File *file;
 };
 
 #ifdef SCALECACHE
@@ -64,6 +112,21 @@ static unsigned int max_dimension = MAX_SCALECACHE_DIM;
 static unsigned int max_flop_count = MAX_FLOP_COUNT;
 static unsigned int max_scale_items = MAX_SCALEITEMS;
 static unsigned int min_scale_uses = MIN_SCALE_USES;
+
+static char *disk_dir = NULL;
+static unsigned long long max_disk_size = SCALE_CACHE_DISK_SIZE;
+
+// only ever touched by whoever writes the files: the writer thread, or the
+// stores themselves under disk_lock if it could not be started
+static unsigned long long disk_size = 0;
+static Eina_Bool disk_size_known = EINA_FALSE;
+
+static SLK(disk_lock);
+static Eina_Thread disk_writer;
+static Eina_Thread_Queue *disk_queue = NULL;
+static Eina_Bool disk_writer_tried = EINA_FALSE;
+static Eina_Bool disk_fork_cb = EINA_FALSE;
+static size_t disk_pending = 0;
 #endif
 
 static int
@@ -109,6 +172,377 @@ _evas_common_scalecache_key_cmp(const void *key1, int key1_length EINA_UNUSED,
    return 0;
 }
 
+#ifdef SCALECACHE
+static Eina_Bool
+_scalecache_disk_mkpath(char *path)
+{
+   char *p;
+
+   for (p = strchr(path + 1, '/'); p; p = strchr(p + 1, '/'))
+     {
+        *p = 0;
+        if ((mkdir(path, S_IRWXU) < 0) && (errno != EEXIST))
+          {
+             *p = '/';
+             return EINA_FALSE;
+          }
+        *p = '/';
+     }
+   if ((mkdir(path, S_IRWXU) < 0) && (errno != EEXIST)) return EINA_FALSE;
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_scalecache_disk_usable(RGBA_Image *im, const ScaleitemKey *key)
+{
+   Image_Entry *ie = &im->cache_entry;
+
+   // only results that another process would compute the same from the
+   // same file: smooth scales of untouched, still images
+   return ((disk_dir) && (key->smooth) &&
+           (ie->f) && (!eina_file_virtual(ie->f)) &&
+           (ie->space == EVAS_COLORSPACE_ARGB8888) &&
+           (!ie->flags.dirty) && (!ie->animated.animated) &&
+           (ie->scale_hint != EVAS_IMAGE_SCALE_HINT_DYNAMIC));
+}
+
+static int
+_scalecache_disk_key(char *buf, size_t size,
+                     RGBA_Image *im, const ScaleitemKey *key)
+{
+   Image_Entry *ie = &im->cache_entry;
+   const Evas_Image_Load_Opts *lo = &ie->load_opts;
+   int n;
+
+   n = snprintf(buf, size,
+                "%s\n%s\n%llu:%llu\n%ux%u:%i:%i:%i\n%i/%i/%ux%u/%i+%i.%ix%i/%i\n"
+                "%i,%i %ux%u -> %ux%u",
+                eina_file_filename_get(ie->f), ie->key ? ie->key : "",
+                (unsigned long long)eina_file_mtime_get(ie->f),
+                (unsigned long long)eina_file_size_get(ie->f),
+                ie->w, ie->h, ie->flags.alpha, ie->orient, ie->flags.mipmap,
+                lo->emile.scale_down_by, (int)(lo->emile.dpi * 1000.0),
+                lo->emile.w, lo->emile.h,
+                lo->emile.region.x, lo->emile.region.y,
+                lo->emile.region.w, lo->emile.region.h,
+                lo->emile.orientation,
+                key->src_x, key->src_y, key->src_w, key->src_h,
+                key->dst_w, key->dst_h);
+   if ((n < 0) || ((size_t)n >= size)) return -1;
+   return n;
+}
+
+static Eina_Bool
+_scalecache_disk_path(char *path, size_t size, const char *key, int key_len)
+{
+   int n;
+
+   n = snprintf(path, size, "%s/%08x%08x.scale", disk_dir,
+                (unsigned int)eina_hash_superfast(key, key_len),
+                (unsigned int)eina_hash_djb2(key, key_len));
+   return ((n > 0) && ((size_t)n < size));
+}
+
+static RGBA_Image *
+_scalecache_disk_load(RGBA_Image *im, const ScaleitemKey *key)
+{
+   char kbuf[EINA_PATH_MAX + 256], path[EINA_PATH_MAX];
+   const Scalecache_Disk_Header *hd;
+   RGBA_Image *sim;
+   Eina_File *f;
+   unsigned char *map = NULL;
+   size_t size;
+   int klen;
+
+   klen = _scalecache_disk_key(kbuf, sizeof(kbuf), im, key);
+   if (klen < 0) return NULL;
+   if (!_scalecache_disk_path(path, sizeof(path), kbuf, klen)) return NULL;
+
+   f = eina_file_open(path, EINA_FALSE);
+   if (!f) return NULL;
+   size = eina_file_size_get(f);
+   if (size < sizeof(Scalecache_Disk_Header)) goto on_error;
+   map = eina_file_map_all(f, EINA_FILE_POPULATE);
+   if (!map) goto on_error;
+
+   hd = (const Scalecache_Disk_Header *)map;
+   if ((memcmp(hd->magic, SCALE_CACHE_DISK_MAGIC, sizeof(hd->magic))) ||
+       (hd->w != key->dst_w) || (hd->h != key->dst_h) ||
+       (hd->key_len != (unsigned int)klen) ||
+       (hd->data_offset < sizeof(*hd) + klen) || (hd->data_offset & 63) ||
+       (size < hd->data_offset + (size_t)hd->w * hd->h * sizeof(DATA32)) ||
+       (memcmp(map + sizeof(*hd), kbuf, klen)))
+     goto on_error;
+
+   sim = evas_common_image_mapped_new(f, (DATA32 *)(map + hd->data_offset),
+                                      hd->w, hd->h, hd->alpha);
+   if (!sim) goto on_error;
+   // the mtime orders the directory for eviction. a cache shared read only
+   // can't be touched, which only costs it some accuracy.
+   utime(path, NULL);
+   return sim;
+
+on_error:
+   if (map) eina_file_map_free(f, map);
+   eina_file_close(f);
+   return NULL;
+}
+
+static int
+_scalecache_disk_entry_cmp(const void *d1, const void *d2)
+{
+   const Scalecache_Disk_Entry *e1 = d1, *e2 = d2;
+
+   if (e1->mtime < e2->mtime) return -1;
+   if (e1->mtime > e2->mtime) return 1;
+   return 0;
+}
+
+static void
+_scalecache_disk_prune(void)
+{
+   Eina_File_Direct_Info *info;
+   Scalecache_Disk_Entry *e;
+   Eina_Iterator *it;
+   Eina_List *entries = NULL;
+   unsigned long long total = 0;
+
+   it = eina_file_stat_ls(disk_dir);
+   if (!it) return;
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        Eina_Stat st;
+
+        if (info->type != EINA_FILE_REG) continue;
+        if (eina_file_statat(eina_iterator_container_get(it), info, &st))
+          continue;
+        total += st.size;
+        e = malloc(sizeof(*e) + info->path_length + 1);
+        if (!e) continue;
+        e->mtime = st.mtime;
+        e->size = st.size;
+        memcpy(e->path, info->path, info->path_length + 1);
+        entries = eina_list_append(entries, e);
+     }
+   eina_iterator_free(it);
+
+   // leave some room so that the next few stores don't scan again for
+   // nothing
+   if (total > max_disk_size)
+     {
+        entries = eina_list_sort(entries, 0, _scalecache_disk_entry_cmp);
+        EINA_LIST_FREE(entries, e)
+          {
+             if ((total > (max_disk_size / 4) * 3) && (!unlink(e->path)))
+               total -= e->size;
+             free(e);
+          }
+     }
+   EINA_LIST_FREE(entries, e) free(e);
+   // what other processes sharing the directory store is only seen here
+   disk_size = total;
+   disk_size_known = EINA_TRUE;
+}
+
+static void
+_scalecache_disk_write(const Scalecache_Disk_File *file)
+{
+   char tmp[EINA_PATH_MAX];
+   unsigned long long replaced = 0;
+   struct stat st;
+   Eina_Bool ok;
+   FILE *fp;
+   int n;
+
+   // the directory is scanned once, then only when over budget
+   if (!disk_size_known) _scalecache_disk_prune();
+
+   n = snprintf(tmp, sizeof(tmp), "%s.%i.%lx.tmp", file->path,
+                (int)getpid(), (unsigned long)(uintptr_t)file);
+   if ((n < 0) || ((size_t)n >= sizeof(tmp))) return;
+   if (!stat(file->path, &st)) replaced = st.st_size;
+
+   fp = fopen(tmp, "wb");
+   if (!fp) return;
+   ok = (fwrite(file->data, file->size, 1, fp) == 1);
+   if (fclose(fp)) ok = EINA_FALSE;
+   // readers only ever see a complete file or none
+   if ((!ok) || (rename(tmp, file->path) < 0))
+     {
+        unlink(tmp);
+        return;
+     }
+
+   disk_size += file->size;
+   disk_size = (disk_size > replaced) ? disk_size - replaced : 0;
+   if (disk_size > max_disk_size) _scalecache_disk_prune();
+}
+
+static void *
+_scalecache_disk_writer(void *data EINA_UNUSED, Eina_Thread t EINA_UNUSED)
+{
+   Scalecache_Disk_File *file;
+
+   eina_thread_name_set(eina_thread_self(), "Evas-scalecache");
+   do
+     {
+        Scalecache_Disk_Msg *msg;
+        void *ref;
+
+        file = NULL;
+        msg = eina_thread_queue_wait(disk_queue, &ref);
+        if (msg)
+          {
+             file = msg->file;
+             eina_thread_queue_wait_done(disk_queue, ref);
+          }
+        if (file)
+          {
+             _scalecache_disk_write(file);
+             SLKL(disk_lock);
+             disk_pending -= file->size;
+             SLKU(disk_lock);
+             free(file);
+          }
+     }
+   while (file);
+
+   return NULL;
+}
+
+static void
+_scalecache_disk_fork_reset(void *data EINA_UNUSED)
+{
+   // the writer is gone in the child, and what it had left to write with it
+   if (disk_queue) eina_thread_queue_free(disk_queue);
+   disk_queue = NULL;
+   disk_writer_tried = EINA_FALSE;
+   disk_pending = 0;
+   SLKI(disk_lock);
+}
+
+static void
+_scalecache_disk_writer_start(void)
+{
+   disk_writer_tried = EINA_TRUE;
+
+//Eina_Thread_Queue doesn't work on WIN32.
+#ifdef _WIN32
+   return;
+#endif
+
+   disk_queue = eina_thread_queue_new();
+   if (EINA_UNLIKELY(!disk_queue))
+     {
+        ERR("Failed to create thread queue");
+        return;
+     }
+   if (!eina_thread_create(&disk_writer, EINA_THREAD_BACKGROUND, -1,
+                           _scalecache_disk_writer, NULL))
+     {
+        ERR("Failed to create the scale cache writer thread");
+        eina_thread_queue_free(disk_queue);
+        disk_queue = NULL;
+        return;
+     }
+   if (!disk_fork_cb)
+     {
+        ecore_fork_reset_callback_add(_scalecache_disk_fork_reset, NULL);
+        disk_fork_cb = EINA_TRUE;
+     }
+}
+
+static void
+_scalecache_disk_writer_stop(void)
+{
+   Scalecache_Disk_Msg *msg;
+   void *ref;
+
+   if (disk_queue)
+     {
+        // queued after all the pending results, which get written first
+        msg = eina_thread_queue_send(disk_queue, sizeof (Scalecache_Disk_Msg), &ref);
+        msg->file = NULL;
+        eina_thread_queue_send_done(disk_queue, ref);
+        eina_thread_join(disk_writer);
+        eina_thread_queue_free(disk_queue);
+        disk_queue = NULL;
+     }
+   if (disk_fork_cb)
+     ecore_fork_reset_callback_del(_scalecache_disk_fork_reset, NULL);
+   disk_fork_cb = EINA_FALSE;
+   disk_writer_tried = EINA_FALSE;
+   disk_size_known = EINA_FALSE;
+   disk_pending = 0;
+}
+
+static void
+_scalecache_disk_store(RGBA_Image *im, const ScaleitemKey *key,
+                       RGBA_Image *sim)
+{
+   char kbuf[EINA_PATH_MAX + 256];
+   Scalecache_Disk_File *file;
+   Scalecache_Disk_Header *hd;
+   Scalecache_Disk_Msg *msg;
+   size_t size, pixels;
+   void *ref;
+   int klen;
+
+   klen = _scalecache_disk_key(kbuf, sizeof(kbuf), im, key);
+   if (klen < 0) return;
+   pixels = (size_t)sim->cache_entry.w * sim->cache_entry.h * sizeof(DATA32);
+   size = ((sizeof(*hd) + klen + 63) & ~63) + pixels;
+
+   SLKL(disk_lock);
+   // a writer falling behind drops results rather than holding on to more
+   // memory than the scale cache itself may use
+   if (disk_pending + size > max_cache_size)
+     {
+        SLKU(disk_lock);
+        return;
+     }
+   disk_pending += size;
+   SLKU(disk_lock);
+
+   file = calloc(1, sizeof(*file) + size);
+   if ((!file) ||
+       (!_scalecache_disk_path(file->path, sizeof(file->path), kbuf, klen)))
+     {
+        free(file);
+        SLKL(disk_lock);
+        disk_pending -= size;
+        SLKU(disk_lock);
+        return;
+     }
+   file->size = size;
+   hd = (Scalecache_Disk_Header *)file->data;
+   memcpy(hd->magic, SCALE_CACHE_DISK_MAGIC, sizeof(hd->magic));
+   hd->w = sim->cache_entry.w;
+   hd->h = sim->cache_entry.h;
+   hd->alpha = sim->cache_entry.flags.alpha;
+   hd->key_len = klen;
+   hd->data_offset = size - pixels;
+   memcpy(file->data + sizeof(*hd), kbuf, klen);
+   memcpy(file->data + hd->data_offset, sim->image.data, pixels);
+
+   SLKL(disk_lock);
+   if (!disk_writer_tried) _scalecache_disk_writer_start();
+   if (!disk_queue)
+     {
+        _scalecache_disk_write(file);
+        disk_pending -= size;
+        SLKU(disk_lock);
+        free(file);
+        return;
+     }
+   SLKU(disk_lock);
+
+   msg = eina_thread_queue_send(disk_queue, sizeof (Scalecache_Disk_Msg), &ref);
+   msg->file = file;
+   eina_thread_queue_send_done(disk_queue, ref);
+}
+#endif
+
 void
 evas_common_scalecache_init(void)
 {
@@ -119,6 +553,7 @@ evas_common_scalecache_init(void)
    if (init > 1) return;
    use_counter = 0;
    SLKI(cache_lock);
+   SLKI(disk_lock);
    s = getenv("EVAS_SCALECACHE_SIZE");
    if (s) max_cache_size = atoi(s) * 1024;
    s = getenv("EVAS_SCALECACHE_MAX_DIMENSION");
@@ -129,6 +564,26 @@ evas_common_scalecache_init(void)
    if (s) max_scale_items = atoi(s);
    s = getenv("EVAS_SCALECACHE_MIN_USES");
    if (s) min_scale_uses = atoi(s);
+   s = getenv("EVAS_SCALECACHE_DISK");
+   if ((s) && (s[0]))
+     {
+        if (!strcmp(s, "1"))
+          {
+             disk_dir = eina_vpath_resolve("(:usr.cache:)/evas/scalecache");
+             if (!disk_dir)
+               disk_dir = eina_vpath_resolve("(:home:)/.cache/evas/scalecache");
+          }
+        else
+          disk_dir = strdup(s);
+        if ((disk_dir) && (!_scalecache_disk_mkpath(disk_dir)))
+          {
+             ERR("Cannot create scale cache directory '%s'", disk_dir);
+             free(disk_dir);
+             disk_dir = NULL;
+          }
+     }
+   s = getenv("EVAS_SCALECACHE_DISK_SIZE");
+   if (s) max_disk_size = strtoull(s, NULL, 10) * 1024;
 #endif
 }
 
@@ -138,7 +593,13 @@ evas_common_scalecache_shutdown(void)
 #ifdef SCALECACHE
    init--;
    if (init ==0)
-      SLKD(cache_lock);
+     {
+        _scalecache_disk_writer_stop();
+        SLKD(disk_lock);
+        SLKD(cache_lock);
+        free(disk_dir);
+        disk_dir = NULL;
+     }
 #endif
 }
 
@@ -358,6 +819,7 @@ try_alloc:
    sci->usage = 0;
    sci->usage_count = 0;
    sci->populate_me = 0;
+   sci->disk_checked = 0;
    sci->key.smooth = smooth;
    sci->forced_unload = 0;
    sci->flop = 0;
@@ -416,6 +878,7 @@ _cache_prune(Scaleitem *notsci, Eina_Bool copies_only)
         sci->usage = 0;
         sci->usage_count = 0;
         sci->flop += FLOP_ADD;
+        sci->disk_checked = 0;
 
         if (!sci->forced_unload)
           cache_size -= sci->key.dst_w * sci->key.dst_h * 4;
@@ -607,6 +1070,32 @@ evas_common_rgba_image_scalecache_prepare(Image_Entry *ie, RGBA_Image *dst EINA_
    sci->usage++;
    sci->usage_count = use_counter;
    SLKU(cache_lock);
+   // a result stored by an earlier run (or another process) is worth using
+   // from the first draw on, and without loading the original at all
+   if ((!sci->im) && (!sci->disk_checked) &&
+       (sci->key.dst_w < max_dimension) && (sci->key.dst_h < max_dimension) &&
+       ((cache_size + (sci->key.dst_w * sci->key.dst_h * 4)) <= max_cache_size) &&
+       (_scalecache_disk_usable(im, &sci->key)))
+     {
+        RGBA_Image *sim;
+
+        sci->disk_checked = 1;
+        sim = _scalecache_disk_load(im, &sci->key);
+        if (sim)
+          {
+             SLKL(cache_lock);
+             sci->im = sim;
+             sci->forced_unload = 0;
+             if (sci->populate_me)
+               {
+                  sci->populate_me = 0;
+                  im->cache.populate_count--;
+               }
+             cache_size += sci->key.dst_w * sci->key.dst_h * 4;
+             cache_list = eina_inlist_append(cache_list, (Eina_Inlist *)sci);
+             SLKU(cache_lock);
+          }
+     }
    if (sci->usage > im->cache.newest_usage) 
      im->cache.newest_usage = sci->usage;
 //   INF("newset? %p %i > %i", im, 
@@ -643,6 +1132,7 @@ evas_common_rgba_image_scalecache_do_cbs(Image_Entry *ie, RGBA_Image *dst,
    Scaleitem *sci;
    int didpop = 0;
    int dounload = 0;
+   int dostore = 0;
    Eina_Bool ret = EINA_FALSE;
 /*
    static int i = 0;
@@ -780,11 +1270,14 @@ evas_common_rgba_image_scalecache_do_cbs(Image_Entry *ie, RGBA_Image *dst,
              if (im->image.data)
                {
                   if (smooth)
-                    ret = cb_smooth(im, sci->im, ct,
-                                    src_region_x, src_region_y,
-                                    src_region_w, src_region_h,
-                                    0, 0,
-                                    dst_region_w, dst_region_h);
+                    {
+                       ret = cb_smooth(im, sci->im, ct,
+                                       src_region_x, src_region_y,
+                                       src_region_w, src_region_h,
+                                       0, 0,
+                                       dst_region_w, dst_region_h);
+                       dostore = ret && _scalecache_disk_usable(im, &sci->key);
+                    }
                   else
                     ret = cb_sample(im, sci->im, ct,
                                     src_region_x, src_region_y,
@@ -832,6 +1325,7 @@ evas_common_rgba_image_scalecache_do_cbs(Image_Entry *ie, RGBA_Image *dst,
              cache_list = eina_inlist_append(cache_list, (Eina_Inlist *)sci);
              SLKU(cache_lock);
              didpop = 1;
+             if (dostore) _scalecache_disk_store(im, &sci->key, sci->im);
           }
      }
    if (sci->im && !ie->animated.animated)
@@ -0,0 +1,374 @@
+/* blend --> dst, 8 pixels at a time
+ *
+ * Each span works on 8 pixels per iteration and hands the remainder to the
+ * C span it replaces, so both always give the very same pixels. */
+
+#ifdef BUILD_AVX2
+
+/* blend pixel --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_blend_p_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     {
+        __m256i vs = LOAD_AVX2(s);
+
+        STORE_AVX2(d, _mm256_add_epi32(vs, mul_256_avx2(sub_alpha_avx2(vs), LOAD_AVX2(d))));
+     }
+   if (l & 7) _op_blend_p_dp(s, m, c, d, l & 7);
+}
+
+static EVAS_TARGET_AVX2 void
+_op_blend_pas_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i full = _mm256_set1_epi32(0xff);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     {
+        __m256i vs = LOAD_AVX2(s), vd = LOAD_AVX2(d);
+        __m256i sa = _mm256_srli_epi32(vs, 24), r;
+
+        r = _mm256_add_epi32(vs, mul_256_avx2(sub_alpha_avx2(vs), vd));
+        r = _mm256_blendv_epi8(r, vd, _mm256_cmpeq_epi32(sa, zero));
+        r = _mm256_blendv_epi8(r, vs, _mm256_cmpeq_epi32(sa, full));
+        STORE_AVX2(d, r);
+     }
+   if (l & 7) _op_blend_pas_dp(s, m, c, d, l & 7);
+}
+
+#define _op_blend_p_dpan_avx2 _op_blend_p_dp_avx2
+#define _op_blend_pas_dpan_avx2 _op_blend_pas_dp_avx2
+
+/* blend color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_blend_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   const __m256i va = _mm256_set1_epi32(256 - (c >> 24));
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8)
+     STORE_AVX2(d, _mm256_add_epi32(vc, mul_256_avx2(va, LOAD_AVX2(d))));
+   if (l & 7) _op_blend_c_dp(s, m, c, d, l & 7);
+}
+
+#define _op_blend_caa_dp_avx2 _op_blend_c_dp_avx2
+#define _op_blend_c_dpan_avx2 _op_blend_c_dp_avx2
+#define _op_blend_caa_dpan_avx2 _op_blend_c_dp_avx2
+
+/* blend pixel x color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_blend_p_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     {
+        __m256i sc = mul4_sym_avx2(vc, LOAD_AVX2(s));
+
+        STORE_AVX2(d, _mm256_add_epi32(sc, mul_256_avx2(sub_alpha_avx2(sc), LOAD_AVX2(d))));
+     }
+   if (l & 7) _op_blend_p_c_dp(s, m, c, d, l & 7);
+}
+
+static EVAS_TARGET_AVX2 void
+_op_blend_pan_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   const __m256i ca = _mm256_set1_epi32(c & 0xff000000);
+   const __m256i va = _mm256_set1_epi32(256 - (c >> 24));
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     {
+        __m256i sc = _mm256_add_epi32(ca, mul3_sym_avx2(vc, LOAD_AVX2(s)));
+
+        STORE_AVX2(d, _mm256_add_epi32(sc, mul_256_avx2(va, LOAD_AVX2(d))));
+     }
+   if (l & 7) _op_blend_pan_c_dp(s, m, c, d, l & 7);
+}
+
+static EVAS_TARGET_AVX2 void
+_op_blend_p_can_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   const __m256i amask = _mm256_set1_epi32(0xff000000);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     {
+        __m256i vs = LOAD_AVX2(s);
+        __m256i sc = _mm256_add_epi32(_mm256_and_si256(vs, amask), mul3_sym_avx2(vc, vs));
+
+        STORE_AVX2(d, _mm256_add_epi32(sc, mul_256_avx2(sub_alpha_avx2(vs), LOAD_AVX2(d))));
+     }
+   if (l & 7) _op_blend_p_can_dp(s, m, c, d, l & 7);
+}
+
+static EVAS_TARGET_AVX2 void
+_op_blend_pan_can_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   const __m256i amask = _mm256_set1_epi32(0xff000000);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     STORE_AVX2(d, _mm256_add_epi32(amask, mul3_sym_avx2(vc, LOAD_AVX2(s))));
+   if (l & 7) _op_blend_pan_can_dp(s, m, c, d, l & 7);
+}
+
+static EVAS_TARGET_AVX2 void
+_op_blend_p_caa_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(1 + (c & 0xff));
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     {
+        __m256i sc = mul_256_avx2(vc, LOAD_AVX2(s));
+
+        STORE_AVX2(d, _mm256_add_epi32(sc, mul_256_avx2(sub_alpha_avx2(sc), LOAD_AVX2(d))));
+     }
+   if (l & 7) _op_blend_p_caa_dp(s, m, c, d, l & 7);
+}
+
+static EVAS_TARGET_AVX2 void
+_op_blend_pan_caa_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(1 + (c & 0xff));
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     STORE_AVX2(d, interp_256_avx2(vc, LOAD_AVX2(s), LOAD_AVX2(d)));
+   if (l & 7) _op_blend_pan_caa_dp(s, m, c, d, l & 7);
+}
+
+#define _op_blend_pas_c_dp_avx2 _op_blend_p_c_dp_avx2
+#define _op_blend_pas_can_dp_avx2 _op_blend_p_can_dp_avx2
+#define _op_blend_pas_caa_dp_avx2 _op_blend_p_caa_dp_avx2
+
+#define _op_blend_p_c_dpan_avx2 _op_blend_p_c_dp_avx2
+#define _op_blend_pas_c_dpan_avx2 _op_blend_pas_c_dp_avx2
+#define _op_blend_pan_c_dpan_avx2 _op_blend_pan_c_dp_avx2
+#define _op_blend_p_can_dpan_avx2 _op_blend_p_can_dp_avx2
+#define _op_blend_pas_can_dpan_avx2 _op_blend_pas_can_dp_avx2
+#define _op_blend_pan_can_dpan_avx2 _op_blend_pan_can_dp_avx2
+#define _op_blend_p_caa_dpan_avx2 _op_blend_p_caa_dp_avx2
+#define _op_blend_pas_caa_dpan_avx2 _op_blend_pas_caa_dp_avx2
+#define _op_blend_pan_caa_dpan_avx2 _op_blend_pan_caa_dp_avx2
+
+/* blend pixel x mask --> dst */
+
+/* MUL_SYM(0, s) is 0 and MUL_SYM(255, s) is s, so the general case also
+ * covers the two the C span picks out. */
+static EVAS_TARGET_AVX2 void
+_op_blend_p_mas_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8, m += 8)
+     {
+        __m256i sc = mul_sym_avx2(LOAD_MASK_AVX2(m), LOAD_AVX2(s));
+
+        STORE_AVX2(d, _mm256_add_epi32(sc, mul_256_avx2(sub_alpha_avx2(sc), LOAD_AVX2(d))));
+     }
+   if (l & 7) _op_blend_p_mas_dp(s, m, c, d, l & 7);
+}
+
+#define _op_blend_pas_mas_dp_avx2 _op_blend_p_mas_dp_avx2
+#define _op_blend_pan_mas_dp_avx2 _op_blend_p_mas_dp_avx2
+
+#define _op_blend_p_mas_dpan_avx2 _op_blend_p_mas_dp_avx2
+#define _op_blend_pas_mas_dpan_avx2 _op_blend_p_mas_dp_avx2
+#define _op_blend_pan_mas_dpan_avx2 _op_blend_p_mas_dp_avx2
+
+/* blend mask x color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_blend_mas_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, m += 8)
+     {
+        __m256i mc = mul_sym_avx2(LOAD_MASK_AVX2(m), vc);
+
+        STORE_AVX2(d, _mm256_add_epi32(mc, mul_256_avx2(sub_alpha_avx2(mc), LOAD_AVX2(d))));
+     }
+   if (l & 7) _op_blend_mas_c_dp(s, m, c, d, l & 7);
+}
+
+/* INTERP_256(1, c, d) is not d, hence the select on empty mask values. */
+static EVAS_TARGET_AVX2 void
+_op_blend_mas_can_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   const __m256i one = _mm256_set1_epi32(1);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, m += 8)
+     {
+        __m256i vm = LOAD_MASK_AVX2(m), vd = LOAD_AVX2(d), r;
+
+        r = interp_256_avx2(_mm256_add_epi32(vm, one), vc, vd);
+        r = _mm256_blendv_epi8(r, vd, _mm256_cmpeq_epi32(vm, _mm256_setzero_si256()));
+        STORE_AVX2(d, r);
+     }
+   if (l & 7) _op_blend_mas_can_dp(s, m, c, d, l & 7);
+}
+
+#define _op_blend_mas_cn_dp_avx2 _op_blend_mas_can_dp_avx2
+#define _op_blend_mas_caa_dp_avx2 _op_blend_mas_c_dp_avx2
+
+#define _op_blend_mas_c_dpan_avx2 _op_blend_mas_c_dp_avx2
+#define _op_blend_mas_cn_dpan_avx2 _op_blend_mas_cn_dp_avx2
+#define _op_blend_mas_can_dpan_avx2 _op_blend_mas_can_dp_avx2
+#define _op_blend_mas_caa_dpan_avx2 _op_blend_mas_caa_dp_avx2
+
+static void
+init_blend_span_funcs_avx2(void)
+{
+   op_blend_span_funcs[SP][SM_N][SC_N][DP][CPU_AVX2] = _op_blend_p_dp_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC_N][DP][CPU_AVX2] = _op_blend_pas_dp_avx2;
+   op_blend_span_funcs[SP][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_blend_p_dpan_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_blend_pas_dpan_avx2;
+
+   op_blend_span_funcs[SP_N][SM_N][SC][DP][CPU_AVX2] = _op_blend_c_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_N][SC_AA][DP][CPU_AVX2] = _op_blend_caa_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_N][SC][DP_AN][CPU_AVX2] = _op_blend_c_dpan_avx2;
+   op_blend_span_funcs[SP_N][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_blend_caa_dpan_avx2;
+
+   op_blend_span_funcs[SP][SM_N][SC][DP][CPU_AVX2] = _op_blend_p_c_dp_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC][DP][CPU_AVX2] = _op_blend_pas_c_dp_avx2;
+   op_blend_span_funcs[SP_AN][SM_N][SC][DP][CPU_AVX2] = _op_blend_pan_c_dp_avx2;
+   op_blend_span_funcs[SP][SM_N][SC_AN][DP][CPU_AVX2] = _op_blend_p_can_dp_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC_AN][DP][CPU_AVX2] = _op_blend_pas_can_dp_avx2;
+   op_blend_span_funcs[SP_AN][SM_N][SC_AN][DP][CPU_AVX2] = _op_blend_pan_can_dp_avx2;
+   op_blend_span_funcs[SP][SM_N][SC_AA][DP][CPU_AVX2] = _op_blend_p_caa_dp_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC_AA][DP][CPU_AVX2] = _op_blend_pas_caa_dp_avx2;
+   op_blend_span_funcs[SP_AN][SM_N][SC_AA][DP][CPU_AVX2] = _op_blend_pan_caa_dp_avx2;
+   op_blend_span_funcs[SP][SM_N][SC][DP_AN][CPU_AVX2] = _op_blend_p_c_dpan_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC][DP_AN][CPU_AVX2] = _op_blend_pas_c_dpan_avx2;
+   op_blend_span_funcs[SP_AN][SM_N][SC][DP_AN][CPU_AVX2] = _op_blend_pan_c_dpan_avx2;
+   op_blend_span_funcs[SP][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_blend_p_can_dpan_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_blend_pas_can_dpan_avx2;
+   op_blend_span_funcs[SP_AN][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_blend_pan_can_dpan_avx2;
+   op_blend_span_funcs[SP][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_blend_p_caa_dpan_avx2;
+   op_blend_span_funcs[SP_AS][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_blend_pas_caa_dpan_avx2;
+   op_blend_span_funcs[SP_AN][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_blend_pan_caa_dpan_avx2;
+
+   op_blend_span_funcs[SP][SM_AS][SC_N][DP][CPU_AVX2] = _op_blend_p_mas_dp_avx2;
+   op_blend_span_funcs[SP_AS][SM_AS][SC_N][DP][CPU_AVX2] = _op_blend_pas_mas_dp_avx2;
+   op_blend_span_funcs[SP_AN][SM_AS][SC_N][DP][CPU_AVX2] = _op_blend_pan_mas_dp_avx2;
+   op_blend_span_funcs[SP][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_blend_p_mas_dpan_avx2;
+   op_blend_span_funcs[SP_AS][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_blend_pas_mas_dpan_avx2;
+   op_blend_span_funcs[SP_AN][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_blend_pan_mas_dpan_avx2;
+
+   op_blend_span_funcs[SP_N][SM_AS][SC][DP][CPU_AVX2] = _op_blend_mas_c_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_N][DP][CPU_AVX2] = _op_blend_mas_cn_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AN][DP][CPU_AVX2] = _op_blend_mas_can_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AA][DP][CPU_AVX2] = _op_blend_mas_caa_dp_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC][DP_AN][CPU_AVX2] = _op_blend_mas_c_dpan_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_blend_mas_cn_dpan_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AN][DP_AN][CPU_AVX2] = _op_blend_mas_can_dpan_avx2;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AA][DP_AN][CPU_AVX2] = _op_blend_mas_caa_dpan_avx2;
+}
+
+#endif
+
+/* The most used spans again, 16 pixels at a time */
+
+#ifdef BUILD_AVX512
+
+static EVAS_TARGET_AVX512 void
+_op_blend_p_dp_avx512(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~15);
+
+   for (; d < e; d += 16, s += 16)
+     {
+        __m512i vs = LOAD_AVX512(s);
+
+        STORE_AVX512(d, _mm512_add_epi32(vs, mul_256_avx512(sub_alpha_avx512(vs), LOAD_AVX512(d))));
+     }
+   if (l & 15) _op_blend_p_dp_avx2(s, m, c, d, l & 15);
+}
+
+static EVAS_TARGET_AVX512 void
+_op_blend_c_dp_avx512(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m512i vc = _mm512_set1_epi32(c);
+   const __m512i va = _mm512_set1_epi32(256 - (c >> 24));
+   DATA32 *e = d + (l & ~15);
+
+   for (; d < e; d += 16)
+     STORE_AVX512(d, _mm512_add_epi32(vc, mul_256_avx512(va, LOAD_AVX512(d))));
+   if (l & 15) _op_blend_c_dp_avx2(s, m, c, d, l & 15);
+}
+
+static EVAS_TARGET_AVX512 void
+_op_blend_p_c_dp_avx512(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m512i vc = _mm512_set1_epi32(c);
+   DATA32 *e = d + (l & ~15);
+
+   for (; d < e; d += 16, s += 16)
+     {
+        __m512i sc = mul4_sym_avx512(vc, LOAD_AVX512(s));
+
+        STORE_AVX512(d, _mm512_add_epi32(sc, mul_256_avx512(sub_alpha_avx512(sc), LOAD_AVX512(d))));
+     }
+   if (l & 15) _op_blend_p_c_dp_avx2(s, m, c, d, l & 15);
+}
+
+static EVAS_TARGET_AVX512 void
+_op_blend_p_mas_dp_avx512(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~15);
+
+   for (; d < e; d += 16, s += 16, m += 16)
+     {
+        __m512i sc = mul_sym_avx512(LOAD_MASK_AVX512(m), LOAD_AVX512(s));
+
+        STORE_AVX512(d, _mm512_add_epi32(sc, mul_256_avx512(sub_alpha_avx512(sc), LOAD_AVX512(d))));
+     }
+   if (l & 15) _op_blend_p_mas_dp_avx2(s, m, c, d, l & 15);
+}
+
+static EVAS_TARGET_AVX512 void
+_op_blend_mas_c_dp_avx512(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m512i vc = _mm512_set1_epi32(c);
+   DATA32 *e = d + (l & ~15);
+
+   for (; d < e; d += 16, m += 16)
+     {
+        __m512i mc = mul_sym_avx512(LOAD_MASK_AVX512(m), vc);
+
+        STORE_AVX512(d, _mm512_add_epi32(mc, mul_256_avx512(sub_alpha_avx512(mc), LOAD_AVX512(d))));
+     }
+   if (l & 15) _op_blend_mas_c_dp_avx2(s, m, c, d, l & 15);
+}
+
+static void
+init_blend_span_funcs_avx512(void)
+{
+   op_blend_span_funcs[SP][SM_N][SC_N][DP][CPU_AVX512] = _op_blend_p_dp_avx512;
+   op_blend_span_funcs[SP][SM_N][SC_N][DP_AN][CPU_AVX512] = _op_blend_p_dp_avx512;
+
+   op_blend_span_funcs[SP_N][SM_N][SC][DP][CPU_AVX512] = _op_blend_c_dp_avx512;
+   op_blend_span_funcs[SP_N][SM_N][SC_AA][DP][CPU_AVX512] = _op_blend_c_dp_avx512;
+   op_blend_span_funcs[SP_N][SM_N][SC][DP_AN][CPU_AVX512] = _op_blend_c_dp_avx512;
+   op_blend_span_funcs[SP_N][SM_N][SC_AA][DP_AN][CPU_AVX512] = _op_blend_c_dp_avx512;
+
+   op_blend_span_funcs[SP][SM_N][SC][DP][CPU_AVX512] = _op_blend_p_c_dp_avx512;
+   op_blend_span_funcs[SP_AS][SM_N][SC][DP][CPU_AVX512] = _op_blend_p_c_dp_avx512;
+   op_blend_span_funcs[SP][SM_N][SC][DP_AN][CPU_AVX512] = _op_blend_p_c_dp_avx512;
+   op_blend_span_funcs[SP_AS][SM_N][SC][DP_AN][CPU_AVX512] = _op_blend_p_c_dp_avx512;
+
+   op_blend_span_funcs[SP][SM_AS][SC_N][DP][CPU_AVX512] = _op_blend_p_mas_dp_avx512;
+   op_blend_span_funcs[SP_AS][SM_AS][SC_N][DP][CPU_AVX512] = _op_blend_p_mas_dp_avx512;
+   op_blend_span_funcs[SP_AN][SM_AS][SC_N][DP][CPU_AVX512] = _op_blend_p_mas_dp_avx512;
+   op_blend_span_funcs[SP][SM_AS][SC_N][DP_AN][CPU_AVX512] = _op_blend_p_mas_dp_avx512;
+   op_blend_span_funcs[SP_AS][SM_AS][SC_N][DP_AN][CPU_AVX512] = _op_blend_p_mas_dp_avx512;
+   op_blend_span_funcs[SP_AN][SM_AS][SC_N][DP_AN][CPU_AVX512] = _op_blend_p_mas_dp_avx512;
+
+   op_blend_span_funcs[SP_N][SM_AS][SC][DP][CPU_AVX512] = _op_blend_mas_c_dp_avx512;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AA][DP][CPU_AVX512] = _op_blend_mas_c_dp_avx512;
+   op_blend_span_funcs[SP_N][SM_AS][SC][DP_AN][CPU_AVX512] = _op_blend_mas_c_dp_avx512;
+   op_blend_span_funcs[SP_N][SM_AS][SC_AA][DP_AN][CPU_AVX512] = _op_blend_mas_c_dp_avx512;
+}
+
+#endif
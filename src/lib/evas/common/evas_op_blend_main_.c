@@ -91,6 +91,8 @@ evas_common_gfx_compositor_blend_rel_get(void)
 # include "./evas_op_blend/op_blend_mask_color_neon.c"
 //# include "./evas_op_blend/op_blend_pixel_mask_color_neon.c"
 
+# include "./evas_op_blend/op_blend_avx2.c"
+
 #ifdef BUILD_SSE3
 void evas_common_op_blend_init_sse3(void);
 #endif
@@ -135,6 +137,14 @@ op_blend_init(void)
         init_blend_color_pt_funcs_neon();
         init_blend_mask_color_pt_funcs_neon();
      }
+#endif
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     init_blend_span_funcs_avx2();
+#endif
+#ifdef BUILD_AVX512
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX512))
+     init_blend_span_funcs_avx512();
 #endif
    init_blend_pixel_span_funcs_c();
    init_blend_pixel_color_span_funcs_c();
@@ -159,6 +169,22 @@ blend_gfx_span_func_cpu(int s, int m, int c, int d)
 {
    RGBA_Gfx_Func func = NULL;
    int cpu = CPU_N;
+#ifdef BUILD_AVX512
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX512))
+     {
+        cpu = CPU_AVX512;
+        func = op_blend_span_funcs[s][m][c][d][cpu];
+        if (func) return func;
+     }
+#endif
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     {
+        cpu = CPU_AVX2;
+        func = op_blend_span_funcs[s][m][c][d][cpu];
+        if (func) return func;
+     }
+#endif
 #ifdef BUILD_SSE3
    if (evas_common_cpu_has_feature(CPU_FEATURE_SSE3))
       {
@@ -0,0 +1,127 @@
+/* copy --> dst, 8 pixels at a time
+ *
+ * The remainder of each span goes to the C span it replaces. Plain pixel
+ * copies stay on memcpy. */
+
+#ifdef BUILD_AVX2
+
+/* copy color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_copy_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8)
+     STORE_AVX2(d, vc);
+   if (l & 7) _op_copy_c_dp(s, m, c, d, l & 7);
+}
+
+/* copy pixel x color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_copy_p_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     STORE_AVX2(d, mul4_sym_avx2(vc, LOAD_AVX2(s)));
+   if (l & 7) _op_copy_p_c_dp(s, m, c, d, l & 7);
+}
+
+static EVAS_TARGET_AVX2 void
+_op_copy_p_caa_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(1 + (c >> 24));
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     STORE_AVX2(d, mul_256_avx2(vc, LOAD_AVX2(s)));
+   if (l & 7) _op_copy_p_caa_dp(s, m, c, d, l & 7);
+}
+
+/* copy pixel x mask --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_copy_p_mas_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i one = _mm256_set1_epi32(1);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8, m += 8)
+     {
+        __m256i vm = LOAD_MASK_AVX2(m), vd = LOAD_AVX2(d), r;
+
+        r = interp_256_avx2(_mm256_add_epi32(vm, one), LOAD_AVX2(s), vd);
+        r = _mm256_blendv_epi8(r, vd, _mm256_cmpeq_epi32(vm, _mm256_setzero_si256()));
+        STORE_AVX2(d, r);
+     }
+   if (l & 7) _op_copy_p_mas_dp(s, m, c, d, l & 7);
+}
+
+/* copy mask x color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_copy_mas_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(c);
+   const __m256i one = _mm256_set1_epi32(1);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, m += 8)
+     {
+        __m256i vm = LOAD_MASK_AVX2(m);
+
+        /* an empty mask value gives 0, not MUL_256(1, c) */
+        vm = _mm256_add_epi32(vm, _mm256_andnot_si256(_mm256_cmpeq_epi32(vm, _mm256_setzero_si256()), one));
+        STORE_AVX2(d, mul_256_avx2(vm, vc));
+     }
+   if (l & 7) _op_copy_mas_c_dp(s, m, c, d, l & 7);
+}
+
+static void
+init_copy_span_funcs_avx2(void)
+{
+   op_copy_span_funcs[SP_N][SM_N][SC_N][DP][CPU_AVX2] = _op_copy_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC][DP][CPU_AVX2] = _op_copy_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_AN][DP][CPU_AVX2] = _op_copy_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_AA][DP][CPU_AVX2] = _op_copy_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_copy_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC][DP_AN][CPU_AVX2] = _op_copy_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_copy_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_copy_c_dp_avx2;
+
+   op_copy_span_funcs[SP][SM_N][SC][DP][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP_AS][SM_N][SC][DP][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP_AN][SM_N][SC][DP][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP][SM_N][SC_AN][DP][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP_AS][SM_N][SC_AN][DP][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP_AN][SM_N][SC_AN][DP][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP][SM_N][SC_AA][DP][CPU_AVX2] = _op_copy_p_caa_dp_avx2;
+   op_copy_span_funcs[SP_AS][SM_N][SC_AA][DP][CPU_AVX2] = _op_copy_p_caa_dp_avx2;
+   op_copy_span_funcs[SP_AN][SM_N][SC_AA][DP][CPU_AVX2] = _op_copy_p_caa_dp_avx2;
+   op_copy_span_funcs[SP][SM_N][SC][DP_AN][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP_AS][SM_N][SC][DP_AN][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP_AN][SM_N][SC][DP_AN][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP_AS][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP_AN][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_copy_p_c_dp_avx2;
+   op_copy_span_funcs[SP][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_copy_p_caa_dp_avx2;
+   op_copy_span_funcs[SP_AS][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_copy_p_caa_dp_avx2;
+   op_copy_span_funcs[SP_AN][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_copy_p_caa_dp_avx2;
+
+   op_copy_span_funcs[SP][SM_AS][SC_N][DP][CPU_AVX2] = _op_copy_p_mas_dp_avx2;
+   op_copy_span_funcs[SP_AN][SM_AS][SC_N][DP][CPU_AVX2] = _op_copy_p_mas_dp_avx2;
+   op_copy_span_funcs[SP_AS][SM_AS][SC_N][DP][CPU_AVX2] = _op_copy_p_mas_dp_avx2;
+   op_copy_span_funcs[SP][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_copy_p_mas_dp_avx2;
+   op_copy_span_funcs[SP_AN][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_copy_p_mas_dp_avx2;
+   op_copy_span_funcs[SP_AS][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_copy_p_mas_dp_avx2;
+
+   op_copy_span_funcs[SP_N][SM_AS][SC_N][DP][CPU_AVX2] = _op_copy_mas_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_AS][SC][DP][CPU_AVX2] = _op_copy_mas_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_AS][SC_AN][DP][CPU_AVX2] = _op_copy_mas_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_AS][SC_AA][DP][CPU_AVX2] = _op_copy_mas_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_copy_mas_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_AS][SC][DP_AN][CPU_AVX2] = _op_copy_mas_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_AS][SC_AN][DP_AN][CPU_AVX2] = _op_copy_mas_c_dp_avx2;
+   op_copy_span_funcs[SP_N][SM_AS][SC_AA][DP_AN][CPU_AVX2] = _op_copy_mas_c_dp_avx2;
+}
+
+#endif
@@ -94,6 +94,8 @@ evas_common_gfx_compositor_copy_rel_get(void)
 # include "./evas_op_copy/op_copy_mask_color_neon.c"
 //# include "./evas_op_copy/op_copy_pixel_mask_color_neon.c"
 
+# include "./evas_op_copy/op_copy_avx2.c"
+
 
 static void
 op_copy_init(void)
@@ -131,6 +133,10 @@ op_copy_init(void)
         init_copy_color_pt_funcs_neon();
         init_copy_mask_color_pt_funcs_neon();
      }
+#endif
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     init_copy_span_funcs_avx2();
 #endif
    init_copy_pixel_span_funcs_c();
    init_copy_pixel_color_span_funcs_c();
@@ -155,6 +161,14 @@ copy_gfx_span_func_cpu(int s, int m, int c, int d)
 {
    RGBA_Gfx_Func  func = NULL;
    int cpu = CPU_N;
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     {
+        cpu = CPU_AVX2;
+        func = op_copy_span_funcs[s][m][c][d][cpu];
+        if (func) return func;
+     }
+#endif
 #ifdef BUILD_MMX
    if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
     {
@@ -0,0 +1,130 @@
+/* mask --> dst, 8 pixels at a time
+ *
+ * The remainder of each span goes to the C span it replaces. */
+
+#ifdef BUILD_AVX2
+
+/* mask pixel --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_mask_p_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     STORE_AVX2(d, mul_sym_avx2(_mm256_srli_epi32(LOAD_AVX2(s), 24), LOAD_AVX2(d)));
+   if (l & 7) _op_mask_p_dp(s, m, c, d, l & 7);
+}
+
+/* mask color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_mask_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(1 + (c >> 24));
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8)
+     STORE_AVX2(d, mul_256_avx2(vc, LOAD_AVX2(d)));
+   if (l & 7) _op_mask_c_dp(s, m, c, d, l & 7);
+}
+
+/* mask pixel x color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_mask_p_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i vc = _mm256_set1_epi32(1 + (c >> 24));
+   const __m256i one = _mm256_set1_epi32(1);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8)
+     {
+        __m256i a = _mm256_mullo_epi32(vc, _mm256_srli_epi32(LOAD_AVX2(s), 24));
+
+        a = _mm256_add_epi32(one, _mm256_srli_epi32(a, 8));
+        STORE_AVX2(d, mul_256_avx2(a, LOAD_AVX2(d)));
+     }
+   if (l & 7) _op_mask_p_c_dp(s, m, c, d, l & 7);
+}
+
+/* mask pixel x mask --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_mask_p_mas_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i v256 = _mm256_set1_epi32(256);
+   const __m256i full = _mm256_set1_epi32(255);
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, s += 8, m += 8)
+     {
+        __m256i vm = LOAD_MASK_AVX2(m), vd = LOAD_AVX2(d);
+        __m256i sa = _mm256_srli_epi32(LOAD_AVX2(s), 24), a, r;
+
+        a = _mm256_mullo_epi32(_mm256_sub_epi32(v256, sa), vm);
+        a = _mm256_sub_epi32(v256, _mm256_srli_epi32(a, 8));
+        r = mul_256_avx2(a, vd);
+        /* a full mask value rounds like the plain pixel span */
+        r = _mm256_blendv_epi8(r, mul_sym_avx2(sa, vd), _mm256_cmpeq_epi32(vm, full));
+        STORE_AVX2(d, r);
+     }
+   if (l & 7) _op_mask_p_mas_dp(s, m, c, d, l & 7);
+}
+
+/* mask mask x color --> dst */
+
+static EVAS_TARGET_AVX2 void
+_op_mask_mas_c_dp_avx2(DATA32 *s, DATA8 *m, DATA32 c, DATA32 *d, int l) {
+   const __m256i v256 = _mm256_set1_epi32(256);
+   const __m256i nc = _mm256_set1_epi32(256 - (c >> 24));
+   DATA32 *e = d + (l & ~7);
+
+   for (; d < e; d += 8, m += 8)
+     {
+        __m256i a = _mm256_mullo_epi32(nc, LOAD_MASK_AVX2(m));
+
+        a = _mm256_sub_epi32(v256, _mm256_srli_epi32(a, 8));
+        STORE_AVX2(d, mul_256_avx2(a, LOAD_AVX2(d)));
+     }
+   if (l & 7) _op_mask_mas_c_dp(s, m, c, d, l & 7);
+}
+
+static void
+init_mask_span_funcs_avx2(void)
+{
+   op_mask_span_funcs[SP][SM_N][SC_N][DP][CPU_AVX2] = _op_mask_p_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC_N][DP][CPU_AVX2] = _op_mask_p_dp_avx2;
+   op_mask_span_funcs[SP][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_mask_p_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC_N][DP_AN][CPU_AVX2] = _op_mask_p_dp_avx2;
+
+   op_mask_span_funcs[SP_N][SM_N][SC][DP][CPU_AVX2] = _op_mask_c_dp_avx2;
+   op_mask_span_funcs[SP_N][SM_N][SC_AA][DP][CPU_AVX2] = _op_mask_c_dp_avx2;
+   op_mask_span_funcs[SP_N][SM_N][SC][DP_AN][CPU_AVX2] = _op_mask_c_dp_avx2;
+   op_mask_span_funcs[SP_N][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_mask_c_dp_avx2;
+
+   op_mask_span_funcs[SP][SM_N][SC][DP][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC][DP][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AN][SM_N][SC][DP][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP][SM_N][SC_AN][DP][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC_AN][DP][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP][SM_N][SC_AA][DP][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC_AA][DP][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AN][SM_N][SC_AA][DP][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP][SM_N][SC][DP_AN][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC][DP_AN][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AN][SM_N][SC][DP_AN][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC_AN][DP_AN][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+   op_mask_span_funcs[SP_AN][SM_N][SC_AA][DP_AN][CPU_AVX2] = _op_mask_p_c_dp_avx2;
+
+   op_mask_span_funcs[SP][SM_AS][SC_N][DP][CPU_AVX2] = _op_mask_p_mas_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_AS][SC_N][DP][CPU_AVX2] = _op_mask_p_mas_dp_avx2;
+   op_mask_span_funcs[SP][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_mask_p_mas_dp_avx2;
+   op_mask_span_funcs[SP_AS][SM_AS][SC_N][DP_AN][CPU_AVX2] = _op_mask_p_mas_dp_avx2;
+
+   op_mask_span_funcs[SP_N][SM_AS][SC][DP][CPU_AVX2] = _op_mask_mas_c_dp_avx2;
+   op_mask_span_funcs[SP_N][SM_AS][SC_AA][DP][CPU_AVX2] = _op_mask_mas_c_dp_avx2;
+   op_mask_span_funcs[SP_N][SM_AS][SC][DP_AN][CPU_AVX2] = _op_mask_mas_c_dp_avx2;
+   op_mask_span_funcs[SP_N][SM_AS][SC_AA][DP_AN][CPU_AVX2] = _op_mask_mas_c_dp_avx2;
+}
+
+#endif
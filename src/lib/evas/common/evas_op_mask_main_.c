@@ -49,6 +49,8 @@ evas_common_gfx_compositor_mask_get(void)
 # include "./evas_op_mask/op_mask_mask_color_i386.c"
 //# include "./evas_op_mask/op_mask_pixel_mask_color_i386.c"
 
+# include "./evas_op_mask/op_mask_avx2.c"
+
 
 static void
 op_mask_init(void)
@@ -70,6 +72,10 @@ op_mask_init(void)
         init_mask_color_pt_funcs_mmx();
         init_mask_mask_color_pt_funcs_mmx();
      }
+#endif
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     init_mask_span_funcs_avx2();
 #endif
    init_mask_pixel_span_funcs_c();
    init_mask_pixel_color_span_funcs_c();
@@ -94,6 +100,14 @@ mask_gfx_span_func_cpu(int s, int m, int c, int d)
 {
    RGBA_Gfx_Func func = NULL;
    int cpu = CPU_N;
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     {
+        cpu = CPU_AVX2;
+        func = op_mask_span_funcs[s][m][c][d][cpu];
+        if (func) return func;
+     }
+#endif
 #ifdef BUILD_MMX
    if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
     {
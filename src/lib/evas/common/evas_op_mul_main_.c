@@ -49,6 +49,8 @@ evas_common_gfx_compositor_mul_get(void)
 # include "./evas_op_mul/op_mul_mask_color_i386.c"
 // # include "./evas_op_mul/op_mul_pixel_mask_color_i386.c"
 
+# include "./evas_op_mul/op_mul_avx2.c"
+
 static void
 op_mul_init(void)
 {
@@ -69,6 +71,10 @@ op_mul_init(void)
         init_mul_color_pt_funcs_mmx();
         init_mul_mask_color_pt_funcs_mmx();
      }
+#endif
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     init_mul_span_funcs_avx2();
 #endif
    init_mul_pixel_span_funcs_c();
    init_mul_pixel_color_span_funcs_c();
@@ -93,6 +99,14 @@ mul_gfx_span_func_cpu(int s, int m, int c, int d)
 {
    RGBA_Gfx_Func func = NULL;
    int cpu = CPU_N;
+#ifdef BUILD_AVX2
+   if (evas_common_cpu_has_feature(CPU_FEATURE_AVX2))
+     {
+        cpu = CPU_AVX2;
+        func = op_mul_span_funcs[s][m][c][d][cpu];
+        if (func) return func;
+     }
+#endif
 #ifdef BUILD_MMX
    if (evas_common_cpu_has_feature(CPU_FEATURE_MMX))
      {
@@ -9,7 +9,9 @@ typedef struct _Thinfo
    int                    thread_num;
    Eina_Thread            thread_id;
    Eina_Barrier          *barrier;
-   const Eina_Inlist     *tasks;
+   SLK(lock);
+   unsigned int           tile_next;
+   unsigned int           tile_end;
    Eina_Array             cutout_trash;
    Eina_Array             rects_task;
 } Thinfo;
@@ -18,6 +20,25 @@ static RGBA_Pipe *evas_common_pipe_add(RGBA_Pipe *pipe, RGBA_Pipe_Op **op);
 static void evas_common_pipe_draw_context_copy(RGBA_Draw_Context *dc, RGBA_Pipe_Op *op);
 static void evas_common_pipe_op_free(RGBA_Pipe_Op *op);
 
+static Eina_List *im_task = NULL;
+static Eina_List *text_task = NULL;
+static Thinfo task_thinfo[TH_MAX];
+static Eina_Barrier task_thbarrier[2];
+static LK(im_task_mutex);
+static LK(text_task_mutex);
+
+static int               thread_num = 0;
+static Thinfo            thinfo[TH_MAX];
+static Eina_Barrier      thbarrier[2];
+static Eina_Bool         thread_rendering = EINA_FALSE;
+
+/* the tiles of the image being rendered that at least one op touches,
+ * each pointing to its own slice of tile_ops */
+static RGBA_Pipe_Thread_Info *buf = NULL;
+static unsigned int           buf_size = 0;
+static const RGBA_Pipe_Op   **tile_ops = NULL;
+static unsigned int           tile_ops_size = 0;
+
 /* utils */
 static RGBA_Pipe *
 evas_common_pipe_add(RGBA_Pipe *rpipe, RGBA_Pipe_Op **op)
@@ -63,65 +84,103 @@ evas_common_pipe_draw_context_copy(RGBA_Draw_Context *dc, RGBA_Pipe_Op *op)
      }
 }
 
+/* Sets the part of dst an op may touch, from its geometry and the clip
+ * of its context. It must be called after the context is copied. */
+static void
+evas_common_pipe_op_area_set(RGBA_Image *dst, RGBA_Pipe_Op *op,
+                             int x, int y, int w, int h)
+{
+   if ((w < 1) || (h < 1)) goto empty;
+
+   if (op->context.clip.use)
+     {
+        if (!RECTS_INTERSECT(x, y, w, h,
+                             op->context.clip.x, op->context.clip.y,
+                             op->context.clip.w, op->context.clip.h))
+          goto empty;
+        RECTS_CLIP_TO_RECT(x, y, w, h,
+                           op->context.clip.x, op->context.clip.y,
+                           op->context.clip.w, op->context.clip.h);
+     }
+   if (!RECTS_INTERSECT(x, y, w, h, 0, 0, dst->cache_entry.w, dst->cache_entry.h))
+     goto empty;
+   RECTS_CLIP_TO_RECT(x, y, w, h, 0, 0, dst->cache_entry.w, dst->cache_entry.h);
+   if ((w < 1) || (h < 1)) goto empty;
+
+   EINA_RECTANGLE_SET(&op->area, x, y, w, h);
+   return;
+
+ empty:
+   EINA_RECTANGLE_SET(&op->area, 0, 0, 0, 0);
+}
+
 static void
 evas_common_pipe_op_free(RGBA_Pipe_Op *op)
 {
    evas_common_draw_context_apply_clean_cutouts(&op->context.cutout);
 }
 
+static void
+evas_common_pipe_tile_render(RGBA_Image *im, const RGBA_Pipe_Thread_Info *info)
+{
+   unsigned int i;
+
+   for (i = 0; i < info->op_num; i++)
+     info->ops[i]->op_func(im, info->ops[i], info);
+}
+
+/* The owner of a range walks it from the start while the other threads
+ * steal from its end, so each thread mostly stays on its own neighbouring
+ * tiles. */
+static Eina_Bool
+evas_common_pipe_tile_pop(Thinfo *owner, Eina_Bool steal, unsigned int *tile)
+{
+   Eina_Bool r = EINA_FALSE;
+
+   SLKL(owner->lock);
+   if (owner->tile_next < owner->tile_end)
+     {
+        if (steal) *tile = --owner->tile_end;
+        else *tile = owner->tile_next++;
+        r = EINA_TRUE;
+     }
+   SLKU(owner->lock);
+
+   return r;
+}
+
 /* main api calls */
 static void *
 evas_common_pipe_thread(void *data, Eina_Thread t EINA_UNUSED)
 {
-   Thinfo *thinfo;
+   Thinfo *tinfo;
 
    eina_thread_name_set(eina_thread_self(), "Ecore-pipe");
    // INF("TH [...........");
-   thinfo = data;
+   tinfo = data;
    for (;;)
      {
-        const RGBA_Pipe_Thread_Info *info;
-        RGBA_Pipe *p;
+        unsigned int tile;
+        int i;
 
         /* wait for start signal */
-// INF(" TH %i START...", thinfo->thread_num);
-        eina_barrier_wait(&(thinfo->barrier[0]));
+// INF(" TH %i START...", tinfo->thread_num);
+        eina_barrier_wait(&(tinfo->barrier[0]));
 
-        EINA_INLIST_FOREACH(thinfo->tasks, info)
+        /* own tiles first, then help the others */
+        for (i = 0; i < thread_num; i++)
           {
-             EINA_INLIST_FOREACH(EINA_INLIST_GET(thinfo->im->cache_entry.pipe), p)
-               {
-                  int i;
+             Thinfo *owner = &(thinfo[(tinfo->thread_num + i) % thread_num]);
 
-                  for (i = 0; i < p->op_num; i++)
-                    {
-                       if (p->op[i].op_func && p->op[i].render)
-                         p->op[i].op_func(thinfo->im, &(p->op[i]), info);
-                    }
-               }
+             while (evas_common_pipe_tile_pop(owner, i > 0, &tile))
+               evas_common_pipe_tile_render(tinfo->im, &(buf[tile]));
           }
 
-        thinfo->tasks = NULL;
-
-        eina_barrier_wait(&(thinfo->barrier[1]));
+        eina_barrier_wait(&(tinfo->barrier[1]));
      }
    return NULL;
 }
 
-static Eina_List *im_task = NULL;
-static Eina_List *text_task = NULL;
-static Thinfo task_thinfo[TH_MAX];
-static Eina_Barrier task_thbarrier[2];
-static LK(im_task_mutex);
-static LK(text_task_mutex);
-
-static int               thread_num = 0;
-static Thinfo            thinfo[TH_MAX];
-static Eina_Barrier      thbarrier[2];
-
-static RGBA_Pipe_Thread_Info *buf = NULL;
-static unsigned int           buf_size = 0;
-
 static Cutout_Rects *
 evas_pipe_cutout_rects_pop(Thinfo *info)
 {
@@ -160,15 +219,64 @@ evas_pipe_prepare_push(RGBA_Pipe_Op *op)
    current++;
 }
 
+typedef void (*Evas_Pipe_Tile_Cb)(RGBA_Pipe_Thread_Info *info, const RGBA_Pipe_Op *op, void *data);
+
+/* Calls cb for each op to render and each tile of buf its area covers, in
+ * drawing order. Tiles are tw x th, cols of them per row. */
+static inline void
+evas_common_pipe_tiles_foreach(RGBA_Image *im, unsigned int cols,
+                               unsigned int tw, unsigned int th,
+                               Evas_Pipe_Tile_Cb cb, void *data)
+{
+   RGBA_Pipe *p;
+   unsigned int x, y, x0, y0, x1, y1;
+   int i;
+
+   EINA_INLIST_FOREACH(EINA_INLIST_GET(im->cache_entry.pipe), p)
+     for (i = 0; i < p->op_num; i++)
+       {
+          const RGBA_Pipe_Op *op = &(p->op[i]);
+
+          if (!op->op_func || !op->render) continue;
+          if ((op->area.w < 1) || (op->area.h < 1)) continue;
+          x0 = op->area.x / tw;
+          y0 = op->area.y / th;
+          x1 = (op->area.x + op->area.w - 1) / tw;
+          y1 = (op->area.y + op->area.h - 1) / th;
+          for (y = y0; y <= y1; y++)
+            for (x = x0; x <= x1; x++)
+              cb(&(buf[y * cols + x]), op, data);
+       }
+}
+
+static void
+evas_common_pipe_tile_count(RGBA_Pipe_Thread_Info *info,
+                            const RGBA_Pipe_Op *op EINA_UNUSED, void *data)
+{
+   unsigned int *total = data;
+
+   info->op_num++;
+   (*total)++;
+}
+
+static void
+evas_common_pipe_tile_fill(RGBA_Pipe_Thread_Info *info, const RGBA_Pipe_Op *op,
+                           void *data EINA_UNUSED)
+{
+   info->ops[info->op_num++] = op;
+}
+
 static void
 evas_common_pipe_begin(RGBA_Image *im)
 {
 #define SZ 128
-   unsigned int x, y, cpu;
    RGBA_Pipe_Thread_Info *info;
+   unsigned int x, y, i, cpu;
    unsigned int estimatex, estimatey;
-   unsigned int needed_size;
+   unsigned int cols, rows, needed_size;
+   unsigned int total, tiles;
 
+   thread_rendering = EINA_FALSE;
    if (!im->cache_entry.pipe) return;
    if (thread_num == 1) return;
 
@@ -184,36 +292,80 @@ evas_common_pipe_begin(RGBA_Image *im)
         estimatey = SZ;
      }
 
-   needed_size = ((im->cache_entry.w / estimatex) + 1 ) * ((im->cache_entry.h /  estimatey) + 1);
+   cols = (im->cache_entry.w + estimatex - 1) / estimatex;
+   rows = (im->cache_entry.h + estimatey - 1) / estimatey;
+   needed_size = cols * rows;
+   if (!needed_size) return;
    if (buf_size < needed_size)
      {
         RGBA_Pipe_Thread_Info *temp;
 
         temp = realloc(buf, sizeof (RGBA_Pipe_Thread_Info) * needed_size);
-        if (temp)
-          {
-             buf = temp;
-             buf_size = needed_size;
-          }
+        if (!temp) return;
+        buf = temp;
+        buf_size = needed_size;
      }
 
    info = buf;
-   cpu = 0;
    for (y = 0; y < im->cache_entry.h; y += estimatey)
      for (x = 0; x < im->cache_entry.w; x += estimatex)
        {
           EINA_RECTANGLE_SET(&info->area, x, y,
                              (x + estimatex > im->cache_entry.w) ? im->cache_entry.w - x : estimatex,
                              (y + estimatey > im->cache_entry.h) ? im->cache_entry.h - y : estimatey);
-
-	  thinfo[cpu].im = im;
-          thinfo[cpu].tasks = eina_inlist_prepend((void*) thinfo[cpu].tasks, EINA_INLIST_GET(info));
-          cpu++;
-          if (cpu >= (unsigned int) thread_num) cpu = 0;
+          info->ops = NULL;
+          info->op_num = 0;
 
           info++;
        }
 
+   /* bin the ops into the tiles their area covers, first counting them to
+    * give each tile its slice of tile_ops, then filling the slices in
+    * drawing order */
+   total = 0;
+   evas_common_pipe_tiles_foreach(im, cols, estimatex, estimatey,
+                                  evas_common_pipe_tile_count, &total);
+
+   /* nothing visible was drawn */
+   if (!total) return;
+
+   if (tile_ops_size < total)
+     {
+        const RGBA_Pipe_Op **temp;
+
+        temp = realloc(tile_ops, sizeof (RGBA_Pipe_Op *) * total);
+        if (!temp) return;
+        tile_ops = temp;
+        tile_ops_size = total;
+     }
+
+   total = 0;
+   for (i = 0; i < needed_size; i++)
+     {
+        buf[i].ops = tile_ops + total;
+        total += buf[i].op_num;
+        buf[i].op_num = 0;
+     }
+
+   evas_common_pipe_tiles_foreach(im, cols, estimatex, estimatey,
+                                  evas_common_pipe_tile_fill, NULL);
+
+   /* only the tiles something is drawn in are rendered */
+   tiles = 0;
+   for (i = 0; i < needed_size; i++)
+     if (buf[i].op_num) buf[tiles++] = buf[i];
+
+   /* hand each thread a band of neighbouring tiles, so the same thread
+    * keeps the same part of the destination from one frame to the next */
+   for (cpu = 0; cpu < (unsigned int) thread_num; cpu++)
+     {
+        thinfo[cpu].im = im;
+        thinfo[cpu].tile_next = tiles * cpu / thread_num;
+        thinfo[cpu].tile_end = tiles * (cpu + 1) / thread_num;
+     }
+
+   thread_rendering = EINA_TRUE;
+
    /* tell worker threads to start */
    eina_barrier_wait(&(thbarrier[0]));
 }
@@ -222,10 +374,11 @@ EAPI void
 evas_common_pipe_flush(RGBA_Image *im)
 {
    if (!im->cache_entry.pipe) return;
-   if (thread_num > 1)
+   if (thread_rendering)
      {
        /* sync worker threads */
        eina_barrier_wait(&(thbarrier[1]));
+       thread_rendering = EINA_FALSE;
      }
    else
      {
@@ -240,7 +393,8 @@ evas_common_pipe_flush(RGBA_Image *im)
           {
              for (i = 0; i < p->op_num; i++)
                {
-                  if (p->op[i].render && p->op[i].op_func)
+                  if (p->op[i].render && p->op[i].op_func &&
+                      (p->op[i].area.w > 0) && (p->op[i].area.h > 0))
                     {
                        p->op[i].op_func(im, &(p->op[i]), &info);
                     }
@@ -328,6 +482,7 @@ evas_common_pipe_rectangle_draw(RGBA_Image *dst, RGBA_Draw_Context *dc, int x, i
    op->prepare_func = evas_common_pipe_rectangle_prepare;
    evas_pipe_prepare_push(op);
    evas_common_pipe_draw_context_copy(dc, op);
+   evas_common_pipe_op_area_set(dst, op, x, y, w, h);
 }
 
 /**************** LINE ******************/
@@ -360,6 +515,9 @@ evas_common_pipe_line_draw(RGBA_Image *dst, RGBA_Draw_Context *dc,
    op->prepare_func = NULL;
    op->render = EINA_TRUE;
    evas_common_pipe_draw_context_copy(dc, op);
+   /* anti-aliased lines bleed on the pixels around them */
+   evas_common_pipe_op_area_set(dst, op, MIN(x0, x1) - 1, MIN(y0, y1) - 1,
+                                abs(x1 - x0) + 3, abs(y1 - y0) + 3);
 }
 
 /**************** POLY ******************/
@@ -391,6 +549,29 @@ evas_common_pipe_poly_draw_do(RGBA_Image *dst, const RGBA_Pipe_Op *op, const RGB
                             op->op.poly.points, op->op.poly.x, op->op.poly.y);
 }
 
+static void
+evas_common_pipe_poly_area_set(RGBA_Image *dst, RGBA_Pipe_Op *op)
+{
+   RGBA_Polygon_Point *pt;
+   int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+
+   EINA_INLIST_FOREACH(op->op.poly.points, pt)
+     {
+        if (x1 < x0)
+          {
+             x0 = x1 = pt->x;
+             y0 = y1 = pt->y;
+             continue;
+          }
+        if (pt->x < x0) x0 = pt->x;
+        if (pt->x > x1) x1 = pt->x;
+        if (pt->y < y0) y0 = pt->y;
+        if (pt->y > y1) y1 = pt->y;
+     }
+   evas_common_pipe_op_area_set(dst, op, op->op.poly.x + x0, op->op.poly.y + y0,
+                                x1 - x0 + 1, y1 - y0 + 1);
+}
+
 EAPI void
 evas_common_pipe_poly_draw(RGBA_Image *dst, RGBA_Draw_Context *dc,
                            RGBA_Polygon_Point *points, int x, int y)
@@ -422,6 +603,7 @@ evas_common_pipe_poly_draw(RGBA_Image *dst, RGBA_Draw_Context *dc,
    op->render = EINA_TRUE;
    op->prepare_func = NULL; /* FIXME: If we really want to improve it, we should prepare span for it here */
    evas_common_pipe_draw_context_copy(dc, op);
+   evas_common_pipe_poly_area_set(dst, op);
 }
 
 /**************** TEXT ******************/
@@ -474,6 +656,9 @@ evas_common_pipe_text_draw(RGBA_Image *dst, RGBA_Draw_Context *dc,
    op->prepare_func = evas_common_pipe_text_draw_prepare;
    evas_pipe_prepare_push(op);
    evas_common_pipe_draw_context_copy(dc, op);
+   /* the glyphs are only known once prepared, so text may land anywhere
+    * in its clip */
+   evas_common_pipe_op_area_set(dst, op, 0, 0, dst->cache_entry.w, dst->cache_entry.h);
    evas_common_pipe_text_prepare(intl_props);
 }
 
@@ -481,11 +666,7 @@ evas_common_pipe_text_draw(RGBA_Image *dst, RGBA_Draw_Context *dc,
 static void
 evas_common_pipe_op_image_free(RGBA_Pipe_Op *op)
 {
-   op->op.image.src->ref--;
-   if (op->op.image.src->ref == 0)
-     {
-        evas_cache_image_drop(&op->op.image.src->cache_entry);
-     }
+   evas_cache_image_drop(&op->op.image.src->cache_entry);
    evas_common_pipe_op_free(op);
 }
 
@@ -584,13 +765,15 @@ evas_common_pipe_image_draw(RGBA_Image *src, RGBA_Image *dst,
    op->op.image.dy = dst_region_y;
    op->op.image.dw = dst_region_w;
    op->op.image.dh = dst_region_h;
-   src->ref++;
+   evas_cache_image_ref(&src->cache_entry);
    op->op.image.src = src;
    op->op_func = evas_common_pipe_image_draw_do;
    op->free_func = evas_common_pipe_op_image_free;
    op->prepare_func = evas_common_pipe_op_image_prepare;
    evas_pipe_prepare_push(op);
    evas_common_pipe_draw_context_copy(dc, op);
+   evas_common_pipe_op_area_set(dst, op, dst_region_x, dst_region_y,
+                                dst_region_w, dst_region_h);
 
    evas_common_pipe_image_load(src);
 }
@@ -598,9 +781,7 @@ evas_common_pipe_image_draw(RGBA_Image *src, RGBA_Image *dst,
 static void
 evas_common_pipe_op_map_free(RGBA_Pipe_Op *op)
 {
-   op->op.map.src->ref--;
-   if (op->op.map.src->ref == 0)
-     evas_cache_image_drop(&op->op.map.src->cache_entry);
+   evas_cache_image_drop(&op->op.map.src->cache_entry);
    /* free(op->op.map.p); */
    evas_common_pipe_op_free(op);
 }
@@ -613,7 +794,7 @@ evas_common_pipe_map_draw_do(RGBA_Image *dst, const RGBA_Pipe_Op *op, const RGBA
    memcpy(&(context), &(op->context), sizeof(RGBA_Draw_Context));
    evas_common_map_rgba_do(&info->area, op->op.map.src, dst,
                            &context, op->op.map.m,
-                           op->op.map.smooth, op->op.map.anti_alias,
+                           op->op.map.smooth,
                            op->op.map.level);
 }
 
@@ -629,6 +810,33 @@ evas_common_pipe_map_draw_prepare(void *data EINA_UNUSED, RGBA_Image *dst, RGBA_
    return r;
 }
 
+static void
+evas_common_pipe_map_area_set(RGBA_Image *dst, RGBA_Pipe_Op *op)
+{
+   const RGBA_Map *m = op->op.map.m;
+   FPc x0, y0, x1, y1;
+   int i;
+
+   if (m->count < 1)
+     {
+        evas_common_pipe_op_area_set(dst, op, 0, 0, 0, 0);
+        return;
+     }
+
+   x0 = x1 = m->pts[0].x;
+   y0 = y1 = m->pts[0].y;
+   for (i = 1; i < m->count; i++)
+     {
+        if (m->pts[i].x < x0) x0 = m->pts[i].x;
+        if (m->pts[i].x > x1) x1 = m->pts[i].x;
+        if (m->pts[i].y < y0) y0 = m->pts[i].y;
+        if (m->pts[i].y > y1) y1 = m->pts[i].y;
+     }
+   /* one more pixel on each side for the anti-aliased edges */
+   evas_common_pipe_op_area_set(dst, op, (x0 >> FP) - 1, (y0 >> FP) - 1,
+                                ((x1 - x0) >> FP) + 3, ((y1 - y0) >> FP) + 3);
+}
+
 EAPI void
 evas_common_pipe_map_draw(RGBA_Image *src, RGBA_Image *dst,
                           RGBA_Draw_Context *dc, RGBA_Map *m,
@@ -652,15 +860,15 @@ evas_common_pipe_map_draw(RGBA_Image *src, RGBA_Image *dst,
 
    op->op.map.smooth = smooth;
    op->op.map.level = level;
-   src->ref++;
+   evas_cache_image_ref(&src->cache_entry);
    op->op.map.src = src;
    op->op.map.m = m;
-	op->op.map.anti_alias = dc->anti_alias;
    op->op_func = evas_common_pipe_map_draw_do;
    op->free_func = evas_common_pipe_op_map_free;
    op->prepare_func = evas_common_pipe_map_draw_prepare;
    evas_pipe_prepare_push(op);
    evas_common_pipe_draw_context_copy(dc, op);
+   evas_common_pipe_map_area_set(dst, op);
 
    evas_common_pipe_image_load(src);
 }
@@ -861,6 +1069,7 @@ evas_common_pipe_init(void)
 
 	cpunum = eina_cpu_count();
 	thread_num = cpunum;
+	if (thread_num > TH_MAX) thread_num = TH_MAX;
 // on  single cpu we still want this initted.. otherwise we block forever
 // waiting onm pthread barriers for async rendering on a single core!
 //	if (thread_num == 1) return EINA_FALSE;
@@ -875,8 +1084,8 @@ evas_common_pipe_init(void)
 	for (i = 0; i < thread_num; i++)
 	  {
 	     thinfo[i].thread_num = i;
-	     thinfo[i].tasks = NULL;
 	     thinfo[i].barrier = thbarrier;
+	     SLKI(thinfo[i].lock);
 
              eina_thread_create(&(thinfo[i].thread_id), EINA_THREAD_NORMAL, i,
                                 evas_common_pipe_thread, &(thinfo[i]));
@@ -887,7 +1096,6 @@ evas_common_pipe_init(void)
 	for (i = 0; i < thread_num; i++)
 	  {
 	     task_thinfo[i].thread_num = i;
-	     task_thinfo[i].tasks = NULL;
 	     task_thinfo[i].barrier = task_thbarrier;
              eina_array_step_set(&task_thinfo[i].cutout_trash, sizeof (Eina_Array), 8);
              eina_array_step_set(&task_thinfo[i].rects_task, sizeof (Eina_Array), 8);
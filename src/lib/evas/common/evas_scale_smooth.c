@@ -1,5 +1,6 @@
 #include "evas_common_private.h"
 #include "evas_scale_smooth.h"
+#include "evas_image_private.h"
 #include "evas_blend_private.h"
 #ifdef BUILD_NEON
 #include <arm_neon.h>
@@ -5,6 +5,13 @@ SCALE_FUNC(RGBA_Image *src, RGBA_Image *dst, int dst_clip_x, int dst_clip_y, int
    int      src_w, src_h, dst_w, dst_h;
 
    if ((!src->image.data) || (!dst->image.data)) return;
+   /* heavy downscales of images opted in to mip levels start from one */
+   if ((src_region_w >= (dst_region_w * 2)) &&
+       (src_region_h >= (dst_region_h * 2)))
+     src = evas_common_rgba_image_mipmap_get(src,
+                                             &src_region_x, &src_region_y,
+                                             &src_region_w, &src_region_h,
+                                             dst_region_w, dst_region_h);
    if (!(RECTS_INTERSECT(dst_region_x, dst_region_y, dst_region_w, dst_region_h,
                          0, 0, dst->cache_entry.w, dst->cache_entry.h))) return;
    if (!(RECTS_INTERSECT(src_region_x, src_region_y, src_region_w, src_region_h,
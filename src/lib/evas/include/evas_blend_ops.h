@@ -13,6 +13,17 @@
 # endif
 #endif
 
+/* The SSE4.1, AVX2 and AVX-512 code is built for the baseline cpu with a
+ * target attribute, like the rest of evas, and only picked when cpuid says
+ * so. */
+#if defined(BUILD_SSE3) && defined(__GNUC__) && \
+  (defined(__i386__) || defined(__x86_64__))
+# define BUILD_SSE41 1
+# define BUILD_AVX2 1
+# define BUILD_AVX512 1
+# include <immintrin.h>
+#endif
+
 /* src pixel flags: */
 
 /* pixels none */
@@ -77,8 +88,12 @@
 #define CPU_NEON 5
 /* CPU SSE3 */
 #define CPU_SSE3 6
+/* cpu AVX2 */
+#define CPU_AVX2 7
+/* cpu AVX-512 F + BW */
+#define CPU_AVX512 8
 /* cpu flags count */
-#define CPU_LAST 7
+#define CPU_LAST 9
 
 
 /* some useful constants */
@@ -413,6 +428,195 @@ mul3_sym_sse3(__m128i x, __m128i y) {
 #endif
 #endif
 
+#ifdef BUILD_SSE41
+# define EVAS_TARGET_SSE41 __attribute__((target("sse4.1")))
+# define EVAS_INLINE_SSE41 static inline __attribute__((always_inline, target("sse4.1")))
+#endif
+
+/* some useful AVX2 and AVX-512 inline functions
+ *
+ * They compute the C macros above on 8 or 16 pixels with the very same
+ * results: every per channel product of these macros fits in 16 bits, so
+ * the two channels each 32-bit half holds are worked on in 16-bit lanes. */
+
+#ifdef BUILD_AVX2
+
+# define EVAS_TARGET_AVX2 __attribute__((target("avx2")))
+# define EVAS_INLINE_AVX2 static inline __attribute__((always_inline, target("avx2")))
+
+# define LOAD_AVX2(p) _mm256_loadu_si256((const __m256i *)(p))
+# define STORE_AVX2(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+/* eight mask values, one per 32-bit lane */
+# define LOAD_MASK_AVX2(p) _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(p)))
+
+/* alpha (0 - 256) of each pixel in both of its 16-bit lanes */
+EVAS_INLINE_AVX2 __m256i
+alpha16_avx2(__m256i a)
+{
+   return _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+}
+
+/* MUL_256(a, c) */
+EVAS_INLINE_AVX2 __m256i
+mul_256_avx2(__m256i a, __m256i c)
+{
+   const __m256i ga = _mm256_set1_epi32(0x00ff00ff);
+   __m256i hi, lo;
+
+   a = alpha16_avx2(a);
+   hi = _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(c, 8), ga), a);
+   lo = _mm256_mullo_epi16(_mm256_and_si256(c, ga), a);
+   return _mm256_or_si256(_mm256_andnot_si256(ga, hi), _mm256_srli_epi16(lo, 8));
+}
+
+/* MUL_SYM(a, c) */
+EVAS_INLINE_AVX2 __m256i
+mul_sym_avx2(__m256i a, __m256i c)
+{
+   const __m256i ga = _mm256_set1_epi32(0x00ff00ff);
+   __m256i hi, lo;
+
+   a = alpha16_avx2(a);
+   hi = _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(c, 8), ga), a);
+   hi = _mm256_add_epi16(hi, ga);
+   lo = _mm256_mullo_epi16(_mm256_and_si256(c, ga), a);
+   lo = _mm256_add_epi16(lo, ga);
+   return _mm256_or_si256(_mm256_andnot_si256(ga, hi), _mm256_srli_epi16(lo, 8));
+}
+
+/* MUL4_SYM(x, y) */
+EVAS_INLINE_AVX2 __m256i
+mul4_sym_avx2(__m256i x, __m256i y)
+{
+   const __m256i ga = _mm256_set1_epi32(0x00ff00ff);
+   __m256i hi, lo;
+
+   hi = _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi32(x, 8), ga),
+                           _mm256_and_si256(_mm256_srli_epi32(y, 8), ga));
+   hi = _mm256_add_epi16(hi, ga);
+   lo = _mm256_mullo_epi16(_mm256_and_si256(x, ga), _mm256_and_si256(y, ga));
+   lo = _mm256_add_epi16(lo, ga);
+   return _mm256_or_si256(_mm256_andnot_si256(ga, hi), _mm256_srli_epi16(lo, 8));
+}
+
+/* MUL3_SYM(x, y) */
+EVAS_INLINE_AVX2 __m256i
+mul3_sym_avx2(__m256i x, __m256i y)
+{
+   return _mm256_and_si256(mul4_sym_avx2(x, y), _mm256_set1_epi32(0x00ffffff));
+}
+
+/* INTERP_256(a, c0, c1) */
+EVAS_INLINE_AVX2 __m256i
+interp_256_avx2(__m256i a, __m256i c0, __m256i c1)
+{
+   const __m256i ga = _mm256_set1_epi32(0x00ff00ff);
+   __m256i hi, lo, h1, l1;
+
+   a = alpha16_avx2(a);
+   h1 = _mm256_and_si256(_mm256_srli_epi32(c1, 8), ga);
+   hi = _mm256_sub_epi16(_mm256_and_si256(_mm256_srli_epi32(c0, 8), ga), h1);
+   hi = _mm256_add_epi16(_mm256_mullo_epi16(hi, a), _mm256_slli_epi16(h1, 8));
+   l1 = _mm256_and_si256(c1, ga);
+   lo = _mm256_sub_epi16(_mm256_and_si256(c0, ga), l1);
+   lo = _mm256_add_epi16(_mm256_mullo_epi16(lo, a), _mm256_slli_epi16(l1, 8));
+   return _mm256_or_si256(_mm256_andnot_si256(ga, hi), _mm256_srli_epi16(lo, 8));
+}
+
+/* 256 - alpha of each pixel */
+EVAS_INLINE_AVX2 __m256i
+sub_alpha_avx2(__m256i c)
+{
+   return _mm256_sub_epi32(_mm256_set1_epi32(256), _mm256_srli_epi32(c, 24));
+}
+
+#endif
+
+#ifdef BUILD_AVX512
+
+# define EVAS_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+# define EVAS_INLINE_AVX512 static inline __attribute__((always_inline, target("avx512f,avx512bw")))
+
+# define LOAD_AVX512(p) _mm512_loadu_si512((const void *)(p))
+# define STORE_AVX512(p, v) _mm512_storeu_si512((void *)(p), v)
+# define LOAD_MASK_AVX512(p) _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(p)))
+
+EVAS_INLINE_AVX512 __m512i
+alpha16_avx512(__m512i a)
+{
+   return _mm512_or_si512(a, _mm512_slli_epi32(a, 16));
+}
+
+EVAS_INLINE_AVX512 __m512i
+mul_256_avx512(__m512i a, __m512i c)
+{
+   const __m512i ga = _mm512_set1_epi32(0x00ff00ff);
+   __m512i hi, lo;
+
+   a = alpha16_avx512(a);
+   hi = _mm512_mullo_epi16(_mm512_and_si512(_mm512_srli_epi32(c, 8), ga), a);
+   lo = _mm512_mullo_epi16(_mm512_and_si512(c, ga), a);
+   return _mm512_or_si512(_mm512_andnot_si512(ga, hi), _mm512_srli_epi16(lo, 8));
+}
+
+EVAS_INLINE_AVX512 __m512i
+mul_sym_avx512(__m512i a, __m512i c)
+{
+   const __m512i ga = _mm512_set1_epi32(0x00ff00ff);
+   __m512i hi, lo;
+
+   a = alpha16_avx512(a);
+   hi = _mm512_mullo_epi16(_mm512_and_si512(_mm512_srli_epi32(c, 8), ga), a);
+   hi = _mm512_add_epi16(hi, ga);
+   lo = _mm512_mullo_epi16(_mm512_and_si512(c, ga), a);
+   lo = _mm512_add_epi16(lo, ga);
+   return _mm512_or_si512(_mm512_andnot_si512(ga, hi), _mm512_srli_epi16(lo, 8));
+}
+
+EVAS_INLINE_AVX512 __m512i
+mul4_sym_avx512(__m512i x, __m512i y)
+{
+   const __m512i ga = _mm512_set1_epi32(0x00ff00ff);
+   __m512i hi, lo;
+
+   hi = _mm512_mullo_epi16(_mm512_and_si512(_mm512_srli_epi32(x, 8), ga),
+                           _mm512_and_si512(_mm512_srli_epi32(y, 8), ga));
+   hi = _mm512_add_epi16(hi, ga);
+   lo = _mm512_mullo_epi16(_mm512_and_si512(x, ga), _mm512_and_si512(y, ga));
+   lo = _mm512_add_epi16(lo, ga);
+   return _mm512_or_si512(_mm512_andnot_si512(ga, hi), _mm512_srli_epi16(lo, 8));
+}
+
+EVAS_INLINE_AVX512 __m512i
+mul3_sym_avx512(__m512i x, __m512i y)
+{
+   return _mm512_and_si512(mul4_sym_avx512(x, y), _mm512_set1_epi32(0x00ffffff));
+}
+
+EVAS_INLINE_AVX512 __m512i
+interp_256_avx512(__m512i a, __m512i c0, __m512i c1)
+{
+   const __m512i ga = _mm512_set1_epi32(0x00ff00ff);
+   __m512i hi, lo, h1, l1;
+
+   a = alpha16_avx512(a);
+   h1 = _mm512_and_si512(_mm512_srli_epi32(c1, 8), ga);
+   hi = _mm512_sub_epi16(_mm512_and_si512(_mm512_srli_epi32(c0, 8), ga), h1);
+   hi = _mm512_add_epi16(_mm512_mullo_epi16(hi, a), _mm512_slli_epi16(h1, 8));
+   l1 = _mm512_and_si512(c1, ga);
+   lo = _mm512_sub_epi16(_mm512_and_si512(c0, ga), l1);
+   lo = _mm512_add_epi16(_mm512_mullo_epi16(lo, a), _mm512_slli_epi16(l1, 8));
+   return _mm512_or_si512(_mm512_andnot_si512(ga, hi), _mm512_srli_epi16(lo, 8));
+}
+
+EVAS_INLINE_AVX512 __m512i
+sub_alpha_avx512(__m512i c)
+{
+   return _mm512_sub_epi32(_mm512_set1_epi32(256), _mm512_srli_epi32(c, 24));
+}
+
+#endif
+
 #define LOOP_ALIGNED_U1_A48(DEST, LENGTH, UOP, A4OP, A8OP) \
   {                                                        \
       while((uintptr_t)DEST & 0xF && LENGTH) UOP \
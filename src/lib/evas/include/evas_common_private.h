@@ -365,6 +365,9 @@ extern EAPI int _evas_log_dom_global;
 
 #define RGBA_PLANE_MAX 3
 
+// enough halvings to take any image the scalers take down to a pixel
+#define EVAS_MIPMAP_LEVELS 16
+
 /*****************************************************************************/
 
 #define UNROLL2(op...) op op
@@ -504,7 +507,10 @@ typedef enum _CPU_Features
    CPU_FEATURE_VIS2    = (1 << 5),
    CPU_FEATURE_NEON    = (1 << 6),
    CPU_FEATURE_SSE3    = (1 << 7),
-   CPU_FEATURE_SVE     = (1 << 8)
+   CPU_FEATURE_SVE     = (1 << 8),
+   CPU_FEATURE_AVX2    = (1 << 9),
+   CPU_FEATURE_AVX512  = (1 << 10),
+   CPU_FEATURE_SSE41   = (1 << 11)
 } CPU_Features;
 
 /*****************************************************************************/
@@ -535,6 +541,7 @@ struct _Image_Entry_Flags
    Eina_Bool flipped       : 1;
    Eina_Bool textured      : 1;
    Eina_Bool preload_pending : 1;
+   Eina_Bool mipmap        : 1;
 };
 
 struct _Image_Entry_Frame
@@ -743,6 +750,7 @@ struct _RGBA_Pipe_Op
    void                    (*op_func) (RGBA_Image *dst, const RGBA_Pipe_Op *op, const RGBA_Pipe_Thread_Info *info);
    void                    (*free_func) (RGBA_Pipe_Op *op);
    Cutout_Rects             *rects;
+   Eina_Rectangle            area; /* part of the destination it can touch */
 
    union {
       struct {
@@ -789,8 +797,9 @@ struct _RGBA_Pipe
 
 struct _RGBA_Pipe_Thread_Info
 {
-   EINA_INLIST;
-   Eina_Rectangle area;
+   Eina_Rectangle       area;
+   const RGBA_Pipe_Op **ops;
+   unsigned int         op_num;
 };
 #endif
 
@@ -839,6 +848,13 @@ struct _RGBA_Image
       unsigned long long newest_usage_count;
    } cache;
 
+   /* half size levels, built on demand for images opted in to them */
+   struct {
+      SLK(lock);
+      RGBA_Image *levels[EVAS_MIPMAP_LEVELS];
+      unsigned int count;
+   } mipmap;
+
 #ifdef HAVE_PIXMAN
    struct {
       pixman_image_t *im;
@@ -892,6 +892,14 @@ struct _Evas_Public_Data
 
    Eina_List     *rendering;
 
+   struct {
+      Eina_Rtree    *tree; // top level objects in stacking order, when in use
+      Eina_List     *moved; // top level objects to refit in the tree
+      unsigned int   min_objects;
+      Eina_Bool      enabled : 1;
+      Eina_Bool      dirty : 1;
+   } hit_index;
+
    unsigned char  changed : 1;
    unsigned char  delete_me : 1;
    unsigned char  invalidate : 1;
@@ -1142,6 +1150,7 @@ struct _Evas_Object_Protected_Data
    unsigned int                ref;
 
    unsigned int                animator_ref;
+   unsigned int                hit_id; // in layer->evas->hit_index.tree
    uint64_t                    callback_mask;
 
    unsigned char               no_change_render;
@@ -1207,6 +1216,7 @@ struct _Evas_Object_Protected_Data
 
    Eina_Bool                   events_filter_enabled : 1;
    Eina_Bool                   is_pointer_inside_legacy : 1;
+   Eina_Bool                   hit_moved : 1;
 };
 
 struct _Evas_Data_Node
@@ -1504,6 +1514,8 @@ struct _Evas_Func
    Evas_Filter_Support (*gfx_filter_supports) (void *engine, Evas_Filter_Command *cmd);
    Eina_Bool (*gfx_filter_process)       (void *engine, Evas_Filter_Command *cmd);
 
+   void  (*image_scale_mipmap_set)       (void *engine, void *image, Eina_Bool mipmap);
+
    unsigned int info_size;
 };
 
@@ -1794,6 +1806,8 @@ struct _Evas_Proxy_Render_Data
 
 void _evas_canvas_event_init(Evas *eo_e, Evas_Public_Data *e);
 void _evas_canvas_event_shutdown(Evas *eo_e, Evas_Public_Data *e);
+void evas_event_hit_index_invalidate(Evas_Public_Data *e);
+void evas_event_hit_index_object_change(Evas_Object_Protected_Data *obj);
 void _evas_canvas_event_pointer_in_rect_mouse_move_feed(Evas_Public_Data *edata,
                                                         Evas_Object *obj,
                                                         Evas_Object_Protected_Data *obj_data,
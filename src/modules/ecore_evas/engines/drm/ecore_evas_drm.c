@@ -1075,9 +1075,7 @@ _ecore_evas_new_internal(const char *device, int x, int y, int w, int h, Eina_Bo
    ee->prop.withdrawn = EINA_TRUE;
    ee->alpha = EINA_FALSE;
 
-   ee->can_async_render = !gl;
-   if (getenv("ECORE_EVAS_FORCE_SYNC_RENDER"))
-     ee->can_async_render = 0;
+   ee->can_async_render = (!gl) && _ecore_evas_software_async_render_get();
 
    if (!ecore_evas_evas_new(ee, w, h))
      {
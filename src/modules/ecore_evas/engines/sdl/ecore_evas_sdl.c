@@ -519,7 +519,7 @@ _ecore_evas_internal_sdl_new(int rmethod, const char* name, int w, int h, int fu
    evas_output_method_set(ee->evas, rmethod);
 
    gl = !(rmethod == evas_render_method_lookup("buffer"));
-   ee->can_async_render = gl ? EINA_FALSE : EINA_TRUE;
+   ee->can_async_render = gl ? EINA_FALSE : _ecore_evas_software_async_render_get();
 
    swd->w = SDL_CreateWindow(name,
                              SDL_WINDOWPOS_UNDEFINED,
@@ -2541,10 +2541,10 @@ _ecore_evas_wl_common_new_internal(const char *disp_name, Ecore_Window parent, i
    ee->alpha = EINA_FALSE;
 
    /* Wayland egl engine can't async render */
-   if (getenv("ECORE_EVAS_FORCE_SYNC_RENDER") || !strcmp(engine_name, "wayland_egl"))
+   if (!strcmp(engine_name, "wayland_egl"))
      ee->can_async_render = 0;
    else
-     ee->can_async_render = 1;
+     ee->can_async_render = _ecore_evas_software_async_render_get();
 
    if (p) ee->alpha = ecore_wl2_window_alpha_get(p);
 
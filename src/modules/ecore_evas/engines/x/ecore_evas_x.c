@@ -4107,10 +4107,7 @@ ecore_evas_software_x11_new_internal(const char *disp_name, Ecore_X_Window paren
    ee->prop.withdrawn = EINA_TRUE;
    edata->state.sticky = 0;
 
-   if (getenv("ECORE_EVAS_FORCE_SYNC_RENDER"))
-     ee->can_async_render = 0;
-   else
-     ee->can_async_render = 1;
+   ee->can_async_render = _ecore_evas_software_async_render_get();
 
    /* init evas here */
    if (!ecore_evas_evas_new(ee, w, h))
@@ -4309,10 +4306,7 @@ ecore_evas_software_x11_pixmap_new_internal(const char *disp_name, Ecore_X_Windo
    ee->prop.sticky = 0;
    edata->state.sticky = 0;
 
-   if (getenv("ECORE_EVAS_FORCE_SYNC_RENDER"))
-     ee->can_async_render = 0;
-   else
-     ee->can_async_render = 1;
+   ee->can_async_render = _ecore_evas_software_async_render_get();
 
    /* init evas here */
    if (!ecore_evas_evas_new(ee, w, h))
@@ -70,9 +70,19 @@ static int _eina_chained_mp_log_dom = -1;
 
 #endif
 
+#ifdef __ATOMIC_RELAXED
+#define ATOMIC 1
+#endif
+
 static int aligned_chained_pool = 0;
 static int page_size = 0;
 
+// number of items a thread keeps for itself before handing half of them
+// over to the depot, and how many items the depot may hold before frees
+// go back to the chained pool
+#define CHAINED_MAGAZINE_SIZE 64
+#define CHAINED_MAGAZINE_DEPOT_MAX (CHAINED_MAGAZINE_SIZE * 16)
+
 typedef struct _Chained_Pool Chained_Pool;
 struct _Chained_Pool
 {
@@ -269,18 +279,9 @@ _eina_chained_mempool_free_in(Chained_Mempool *pool, Chained_Pool *p, void *ptr)
 }
 
 static void *
-eina_chained_mempool_malloc(void *data, EINA_UNUSED unsigned int size)
+_eina_chained_mempool_malloc_nolock(Chained_Mempool *pool)
 {
-   Chained_Mempool *pool = data;
    Chained_Pool *p = NULL;
-   void *mem;
-
-   if (!eina_spinlock_take(&pool->mutex))
-     {
-#ifdef EINA_HAVE_DEBUG_THREADS
-        assert(eina_thread_equal(pool->self, eina_thread_self()));
-#endif
-     }
 
    //we have some free space in first fill chain
    if (pool->first_fill) p = pool->first_fill;
@@ -310,31 +311,22 @@ eina_chained_mempool_malloc(void *data, EINA_UNUSED unsigned int size)
        //new chain created ,point it to be the first_fill chain
         pool->first_fill = _eina_chained_mp_pool_new(pool);
         if (!pool->first_fill)
-          {
-             eina_spinlock_release(&pool->mutex);
-             return NULL;
-          }
+          return NULL;
 
         pool->first = eina_inlist_prepend(pool->first, EINA_INLIST_GET(pool->first_fill));
         pool->root = eina_rbtree_inline_insert(pool->root, EINA_RBTREE_GET(pool->first_fill),
                                                _eina_chained_mp_pool_cmp, NULL);
      }
 
-   mem = _eina_chained_mempool_alloc_in(pool, pool->first_fill);
-
-   eina_spinlock_release(&pool->mutex);
-
-   return mem;
+   return _eina_chained_mempool_alloc_in(pool, pool->first_fill);
 }
 
-static void
-eina_chained_mempool_free(void *data, void *ptr)
+static void *
+eina_chained_mempool_malloc(void *data, EINA_UNUSED unsigned int size)
 {
    Chained_Mempool *pool = data;
-   Eina_Rbtree *r;
-   Chained_Pool *p;
+   void *mem;
 
-   // look 4 pool
    if (!eina_spinlock_take(&pool->mutex))
      {
 #ifdef EINA_HAVE_DEBUG_THREADS
@@ -342,6 +334,19 @@ eina_chained_mempool_free(void *data, void *ptr)
 #endif
      }
 
+   mem = _eina_chained_mempool_malloc_nolock(pool);
+
+   eina_spinlock_release(&pool->mutex);
+
+   return mem;
+}
+
+static void
+_eina_chained_mempool_free_nolock(Chained_Mempool *pool, void *ptr)
+{
+   Eina_Rbtree *r;
+   Chained_Pool *p;
+
    // searching for the right mempool
    r = eina_rbtree_inline_lookup(pool->root, ptr, 0, _eina_chained_mp_pool_key_cmp, NULL);
 
@@ -365,9 +370,24 @@ eina_chained_mempool_free(void *data, void *ptr)
         VALGRIND_MEMPOOL_FREE(pool, ptr);
      }
 #endif
+}
+
+static void
+eina_chained_mempool_free(void *data, void *ptr)
+{
+   Chained_Mempool *pool = data;
+
+   // look 4 pool
+   if (!eina_spinlock_take(&pool->mutex))
+     {
+#ifdef EINA_HAVE_DEBUG_THREADS
+        assert(eina_thread_equal(pool->self, eina_thread_self()));
+#endif
+     }
+
+   _eina_chained_mempool_free_nolock(pool, ptr);
 
    eina_spinlock_release(&pool->mutex);
-   return;
 }
 
 static Eina_Bool
@@ -626,6 +646,331 @@ eina_chained_mempool_shutdown(void *data)
    free(mp);
 }
 
+/*
+ * chained_magazine: a thread local layer in front of a chained mempool.
+ *
+ * Each thread allocates from and frees into its own magazine without any
+ * lock. When a magazine gets full, half of it is pushed as one batch on a
+ * lock free stack shared by all threads (the depot), so memory freed by a
+ * consumer thread flows back to the producer thread without ever touching
+ * the chained pool lock. An empty magazine is refilled from the depot
+ * first and only then, under the lock, with a batch from the chained pool.
+ */
+typedef struct _Chained_Magazine Chained_Magazine;
+typedef struct _Chained_Magazine_Mempool Chained_Magazine_Mempool;
+
+struct _Chained_Magazine
+{
+   EINA_INLIST;
+   Chained_Magazine_Mempool *pool;
+   Eina_Trash *items;
+   int count;
+};
+
+struct _Chained_Magazine_Mempool
+{
+   Chained_Mempool *chained;
+   Eina_Inlist *magazines;
+   Eina_Trash *depot;
+   int depot_count;
+   Eina_TLS key;
+   Eina_Spinlock lock; // magazines list, and depot without atomics
+   Eina_Bool key_valid : 1;
+};
+
+static void
+_eina_chained_magazine_release(Chained_Magazine_Mempool *mp, Eina_Trash *items)
+{
+   eina_spinlock_take(&mp->chained->mutex);
+   while (items)
+     _eina_chained_mempool_free_nolock(mp->chained, eina_trash_pop(&items));
+   eina_spinlock_release(&mp->chained->mutex);
+}
+
+static Eina_Bool
+_eina_chained_magazine_depot_push(Chained_Magazine_Mempool *mp,
+                                  Eina_Trash *first, Eina_Trash *last,
+                                  int count)
+{
+#ifdef ATOMIC
+   Eina_Trash *top;
+
+   if (__atomic_add_fetch(&mp->depot_count, count, __ATOMIC_RELAXED) >
+       CHAINED_MAGAZINE_DEPOT_MAX)
+     {
+        __atomic_sub_fetch(&mp->depot_count, count, __ATOMIC_RELAXED);
+        return EINA_FALSE;
+     }
+
+   // only whole batches get pushed and the depot is only emptied at once,
+   // so there is no ABA to worry about
+   top = __atomic_load_n(&mp->depot, __ATOMIC_RELAXED);
+   do
+     last->next = top;
+   while (!__atomic_compare_exchange_n(&mp->depot, &top, first, EINA_TRUE,
+                                       __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+#else
+   eina_spinlock_take(&mp->lock);
+   if (mp->depot_count + count > CHAINED_MAGAZINE_DEPOT_MAX)
+     {
+        eina_spinlock_release(&mp->lock);
+        return EINA_FALSE;
+     }
+   mp->depot_count += count;
+   last->next = mp->depot;
+   mp->depot = first;
+   eina_spinlock_release(&mp->lock);
+#endif
+   return EINA_TRUE;
+}
+
+static Eina_Trash *
+_eina_chained_magazine_depot_take(Chained_Magazine_Mempool *mp, int *count)
+{
+   Eina_Trash *items, *t;
+   int n = 0;
+
+#ifdef ATOMIC
+   if (!__atomic_load_n(&mp->depot, __ATOMIC_RELAXED)) return NULL;
+   items = __atomic_exchange_n(&mp->depot, NULL, __ATOMIC_ACQUIRE);
+#else
+   eina_spinlock_take(&mp->lock);
+   items = mp->depot;
+   mp->depot = NULL;
+   eina_spinlock_release(&mp->lock);
+#endif
+
+   for (t = items; t; t = t->next) n++;
+
+#ifdef ATOMIC
+   __atomic_sub_fetch(&mp->depot_count, n, __ATOMIC_RELAXED);
+#else
+   eina_spinlock_take(&mp->lock);
+   mp->depot_count -= n;
+   eina_spinlock_release(&mp->lock);
+#endif
+
+   *count = n;
+   return items;
+}
+
+static void
+_eina_chained_magazine_flush(Chained_Magazine_Mempool *mp,
+                             Chained_Magazine *mag, int count)
+{
+   Eina_Trash *first, *last;
+   int i;
+
+   first = last = mag->items;
+   for (i = 1; i < count; i++) last = last->next;
+   mag->items = last->next;
+   mag->count -= count;
+   last->next = NULL;
+
+   if (!_eina_chained_magazine_depot_push(mp, first, last, count))
+     _eina_chained_magazine_release(mp, first);
+}
+
+static Eina_Bool
+_eina_chained_magazine_refill(Chained_Magazine_Mempool *mp,
+                              Chained_Magazine *mag)
+{
+   int i;
+
+   mag->items = _eina_chained_magazine_depot_take(mp, &mag->count);
+   if (mag->items) return EINA_TRUE;
+
+   eina_spinlock_take(&mp->chained->mutex);
+   for (i = 0; i < CHAINED_MAGAZINE_SIZE / 2; i++)
+     {
+        void *mem = _eina_chained_mempool_malloc_nolock(mp->chained);
+
+        if (!mem) break;
+        eina_trash_push(&mag->items, mem);
+        mag->count++;
+     }
+   eina_spinlock_release(&mp->chained->mutex);
+
+   return !!mag->items;
+}
+
+static void
+_eina_chained_magazine_del(void *data)
+{
+   Chained_Magazine *mag = data;
+   Chained_Magazine_Mempool *mp = mag->pool;
+
+   _eina_chained_magazine_release(mp, mag->items);
+
+   eina_spinlock_take(&mp->lock);
+   mp->magazines = eina_inlist_remove(mp->magazines, EINA_INLIST_GET(mag));
+   eina_spinlock_release(&mp->lock);
+
+   free(mag);
+}
+
+static inline Chained_Magazine *
+_eina_chained_magazine_get(Chained_Magazine_Mempool *mp)
+{
+   Chained_Magazine *mag;
+
+   if (!mp->key_valid) return NULL;
+
+   mag = eina_tls_get(mp->key);
+   if (mag) return mag;
+
+   mag = calloc(1, sizeof (Chained_Magazine));
+   if (!mag) return NULL;
+   mag->pool = mp;
+
+   if (!eina_tls_set(mp->key, mag))
+     {
+        free(mag);
+        return NULL;
+     }
+
+   eina_spinlock_take(&mp->lock);
+   mp->magazines = eina_inlist_prepend(mp->magazines, EINA_INLIST_GET(mag));
+   eina_spinlock_release(&mp->lock);
+
+   return mag;
+}
+
+static void *
+eina_chained_magazine_malloc(void *data, unsigned int size)
+{
+   Chained_Magazine_Mempool *mp = data;
+   Chained_Magazine *mag;
+
+   mag = _eina_chained_magazine_get(mp);
+   if (!mag) return eina_chained_mempool_malloc(mp->chained, size);
+
+   if (!mag->items && !_eina_chained_magazine_refill(mp, mag))
+     return NULL;
+
+   mag->count--;
+   return eina_trash_pop(&mag->items);
+}
+
+static void
+eina_chained_magazine_free(void *data, void *ptr)
+{
+   Chained_Magazine_Mempool *mp = data;
+   Chained_Magazine *mag;
+
+   mag = _eina_chained_magazine_get(mp);
+   if (!mag)
+     {
+        eina_chained_mempool_free(mp->chained, ptr);
+        return;
+     }
+
+   eina_trash_push(&mag->items, ptr);
+   if (++mag->count >= CHAINED_MAGAZINE_SIZE)
+     _eina_chained_magazine_flush(mp, mag, CHAINED_MAGAZINE_SIZE / 2);
+}
+
+static void
+eina_chained_magazine_gc(void *data)
+{
+   Chained_Magazine_Mempool *mp = data;
+   Chained_Magazine *mag;
+   Eina_Trash *items;
+   int count;
+
+   // give back what the calling thread and the depot hold, the other
+   // threads will flush their magazine on exit
+   if (mp->key_valid && (mag = eina_tls_get(mp->key)))
+     {
+        _eina_chained_magazine_release(mp, mag->items);
+        mag->items = NULL;
+        mag->count = 0;
+     }
+
+   items = _eina_chained_magazine_depot_take(mp, &count);
+   if (items) _eina_chained_magazine_release(mp, items);
+}
+
+static Eina_Bool
+eina_chained_magazine_from(void *data, void *ptr)
+{
+   Chained_Magazine_Mempool *mp = data;
+   Chained_Magazine *mag;
+   Eina_Trash *t;
+
+   if (!eina_chained_mempool_from(mp->chained, ptr)) return EINA_FALSE;
+
+   // items cached by other threads or in the depot can't be checked
+   if (mp->key_valid && (mag = eina_tls_get(mp->key)))
+     for (t = mag->items; t; t = t->next)
+       if (t == (Eina_Trash *)ptr) return EINA_FALSE;
+
+   return EINA_TRUE;
+}
+
+static void *
+eina_chained_magazine_init(const char *context,
+                           const char *option,
+                           va_list args)
+{
+   Chained_Magazine_Mempool *mp;
+
+   mp = calloc(1, sizeof (Chained_Magazine_Mempool));
+   if (!mp) return NULL;
+
+   mp->chained = eina_chained_mempool_init(context, option, args);
+   if (!mp->chained)
+     {
+        free(mp);
+        return NULL;
+     }
+
+   // without a key, every call just goes to the chained pool
+   mp->key_valid = eina_tls_cb_new(&mp->key, _eina_chained_magazine_del);
+   eina_spinlock_new(&mp->lock);
+
+   return mp;
+}
+
+static void
+eina_chained_magazine_shutdown(void *data)
+{
+   Chained_Magazine_Mempool *mp = data;
+
+   if (mp->key_valid)
+     {
+        eina_tls_set(mp->key, NULL);
+        eina_tls_free(mp->key);
+     }
+
+   // the items themselves go away with the chained pool
+   while (mp->magazines)
+     {
+        Chained_Magazine *mag = EINA_INLIST_CONTAINER_GET(mp->magazines,
+                                                          Chained_Magazine);
+
+        mp->magazines = eina_inlist_remove(mp->magazines, mp->magazines);
+        free(mag);
+     }
+
+   eina_chained_mempool_shutdown(mp->chained);
+   eina_spinlock_free(&mp->lock);
+   free(mp);
+}
+
+static Eina_Mempool_Backend _eina_chained_magazine_mp_backend = {
+   "chained_magazine",
+   &eina_chained_magazine_init,
+   &eina_chained_magazine_free,
+   &eina_chained_magazine_malloc,
+   &eina_chained_mempool_realloc,
+   &eina_chained_magazine_gc,
+   NULL,
+   &eina_chained_magazine_shutdown,
+   NULL,
+   &eina_chained_magazine_from
+};
+
 static Eina_Mempool_Backend _eina_chained_mp_backend = {
    "chained_mempool",
    &eina_chained_mempool_init,
@@ -654,11 +999,14 @@ Eina_Bool chained_init(void)
    aligned_chained_pool = eina_mempool_alignof(sizeof(Chained_Pool));
    page_size = eina_cpu_page_size();
 
-   return eina_mempool_register(&_eina_chained_mp_backend);
+   if (!eina_mempool_register(&_eina_chained_mp_backend))
+     return EINA_FALSE;
+   return eina_mempool_register(&_eina_chained_magazine_mp_backend);
 }
 
 void chained_shutdown(void)
 {
+   eina_mempool_unregister(&_eina_chained_magazine_mp_backend);
    eina_mempool_unregister(&_eina_chained_mp_backend);
 #if defined DEBUG || defined EINA_DEBUG_MALLOC
    eina_log_domain_unregister(_eina_chained_mp_log_dom);
@@ -0,0 +1,721 @@
+/* EINA - EFL data type library
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library;
+ * if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef HAVE_SYS_MMAN_H
+# include <sys/mman.h>
+#endif
+
+#include "eina_config.h"
+#include "eina_inlist.h"
+#include "eina_module.h"
+#include "eina_mempool.h"
+#include "eina_trash.h"
+#include "eina_lock.h"
+#include "eina_log.h"
+#include "eina_cpu.h"
+
+#include "eina_private.h"
+
+#ifndef NVALGRIND
+# include <memcheck.h>
+#endif
+
+/*
+ * A mempool serving any size, made of one set of slabs per size class.
+ *
+ * Slabs are SLAB_SIZE bytes and aligned on SLAB_SIZE, so the slab (and
+ * thus the size class) of any pointer is found by masking its address,
+ * no per item header is needed. Slabs are carved out of SLAB_ARENA_SIZE
+ * arenas that are mapped with transparent huge pages when available.
+ * Allocations bigger than the largest class get their own aligned
+ * mapping with the same header, so free can tell them apart.
+ */
+
+static int _eina_slab_log_dom = -1;
+
+#ifdef INF
+#undef INF
+#endif
+#define INF(...) EINA_LOG_DOM_INFO(_eina_slab_log_dom, __VA_ARGS__)
+
+#ifdef ERR
+#undef ERR
+#endif
+#define ERR(...) EINA_LOG_DOM_ERR(_eina_slab_log_dom, __VA_ARGS__)
+
+#define SLAB_SIZE (64 * 1024)
+#define SLAB_ARENA_SIZE (2 * 1024 * 1024)
+#define SLAB_PER_ARENA (SLAB_ARENA_SIZE / SLAB_SIZE)
+// empty slabs gc leaves untouched, to absorb the next allocation burst
+#define SLAB_EMPTY_KEEP 4
+#define SLAB_ALIGN 16
+// 16 bytes steps up to 256, then 4 classes per power of two up to 8192
+#define SLAB_TINY_MAX 256
+#define SLAB_TINY_CLASSES (SLAB_TINY_MAX / SLAB_ALIGN)
+#define SLAB_MAX 8192
+#define SLAB_CLASSES (SLAB_TINY_CLASSES + 4 * 5)
+#define SLAB_CLASS_HUGE SLAB_CLASSES
+
+#define SLAB_GET(ptr) ((Slab *)((uintptr_t)(ptr) & ~((uintptr_t)SLAB_SIZE - 1)))
+
+typedef struct _Slab_Mempool Slab_Mempool;
+typedef struct _Slab_Class Slab_Class;
+typedef struct _Slab_Arena Slab_Arena;
+typedef struct _Slab Slab;
+
+struct _Slab_Arena
+{
+   EINA_INLIST;
+   void *map;
+   size_t map_size;
+   unsigned char *base;
+   unsigned int used;
+   unsigned int carved;
+};
+
+struct _Slab
+{
+   EINA_INLIST;
+   Slab_Mempool *pool;
+   Slab_Arena *arena;
+   Eina_Trash *base;
+   unsigned char *last;
+   unsigned char *limit;
+   void *map; // only for huge allocations
+   size_t map_size;
+   unsigned int klass;
+   unsigned int usage;
+   unsigned int capacity;
+};
+
+struct _Slab_Class
+{
+   Eina_Spinlock lock;
+   Eina_Inlist *partial; // slabs with room left, full ones are not listed
+   unsigned int item_size;
+   unsigned int slabs;
+   unsigned int usage;
+   unsigned int max_usage;
+};
+
+struct _Slab_Mempool
+{
+   const char *name;
+   Slab_Class classes[SLAB_CLASSES];
+
+   Eina_Spinlock lock; // everything below
+   Eina_Inlist *arenas;
+   Eina_Inlist *empty; // slabs not attached to any class
+   Eina_Inlist *huge;
+   unsigned int huge_count;
+   size_t huge_size;
+};
+
+static int page_size = 0;
+static unsigned int aligned_slab = 0;
+
+static inline unsigned int
+_eina_slab_class_get(unsigned int size)
+{
+   unsigned int shift;
+
+   if (size <= SLAB_TINY_MAX)
+     return size ? (size - 1) / SLAB_ALIGN : 0;
+   if (size > SLAB_MAX)
+     return SLAB_CLASS_HUGE;
+
+   // size is in ]2^shift, 2^(shift + 1)], split in 4 classes
+   shift = 31 - __builtin_clz(size - 1);
+   return SLAB_TINY_CLASSES + (shift - 8) * 4 +
+     ((size - 1) >> (shift - 2)) - 4;
+}
+
+static unsigned int
+_eina_slab_class_size(unsigned int klass)
+{
+   unsigned int shift;
+
+   if (klass < SLAB_TINY_CLASSES)
+     return (klass + 1) * SLAB_ALIGN;
+
+   klass -= SLAB_TINY_CLASSES;
+   shift = klass / 4 + 8;
+   return (1 << shift) + ((klass % 4) + 1) * (1 << (shift - 2));
+}
+
+static void *
+_eina_slab_map(size_t size, void **map, size_t *map_size, Eina_Bool huge_pages)
+{
+   uintptr_t aligned, align;
+
+   // over allocate to be able to align on SLAB_SIZE, or on the huge page
+   // size so that the kernel can actually back the range with huge pages
+   align = huge_pages ? SLAB_ARENA_SIZE : SLAB_SIZE;
+   *map_size = size + align;
+#if defined(HAVE_MMAP) && !defined(_WIN32)
+# ifdef HAVE_VALGRIND
+   if (RUNNING_ON_VALGRIND) *map = malloc(*map_size);
+   else
+# endif
+     {
+        *map = mmap(NULL, *map_size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANON, -1, 0);
+        if (*map == MAP_FAILED) *map = NULL;
+     }
+#else
+   *map = malloc(*map_size);
+#endif
+   if (!*map) return NULL;
+
+   aligned = ((uintptr_t)*map + align - 1) & ~(align - 1);
+
+#if defined(HAVE_MMAP) && defined(MADV_HUGEPAGE)
+   if (huge_pages
+# ifdef HAVE_VALGRIND
+       && !RUNNING_ON_VALGRIND
+# endif
+      )
+     madvise((void *)aligned, size, MADV_HUGEPAGE);
+#else
+   (void) huge_pages;
+#endif
+
+   return (void *)aligned;
+}
+
+static void
+_eina_slab_unmap(void *map, size_t map_size)
+{
+#if defined(HAVE_MMAP) && !defined(_WIN32)
+# ifdef HAVE_VALGRIND
+   if (RUNNING_ON_VALGRIND) free(map);
+   else
+# endif
+     munmap(map, map_size);
+#else
+   (void) map_size;
+   free(map);
+#endif
+}
+
+static Slab *
+_eina_slab_new(Slab_Mempool *pool)
+{
+   Slab_Arena *arena;
+   Slab *slab = NULL;
+
+   eina_spinlock_take(&pool->lock);
+   if (pool->empty)
+     {
+        slab = EINA_INLIST_CONTAINER_GET(pool->empty, Slab);
+        pool->empty = eina_inlist_remove(pool->empty, pool->empty);
+        slab->arena->used++;
+        goto end;
+     }
+
+   arena = pool->arenas ? EINA_INLIST_CONTAINER_GET(pool->arenas, Slab_Arena) : NULL;
+   if (!arena || arena->carved == SLAB_PER_ARENA)
+     {
+        arena = calloc(1, sizeof (Slab_Arena));
+        if (!arena) goto end;
+
+        arena->base = _eina_slab_map(SLAB_ARENA_SIZE, &arena->map,
+                                     &arena->map_size, EINA_TRUE);
+        if (!arena->base)
+          {
+             free(arena);
+             goto end;
+          }
+        pool->arenas = eina_inlist_prepend(pool->arenas, EINA_INLIST_GET(arena));
+     }
+
+   slab = (Slab *)(arena->base + arena->carved * SLAB_SIZE);
+   slab->arena = arena;
+   arena->carved++;
+   arena->used++;
+
+ end:
+   eina_spinlock_release(&pool->lock);
+   return slab;
+}
+
+static void
+_eina_slab_release(Slab_Mempool *pool, Slab *slab)
+{
+   eina_spinlock_take(&pool->lock);
+   slab->arena->used--;
+   pool->empty = eina_inlist_prepend(pool->empty, EINA_INLIST_GET(slab));
+   eina_spinlock_release(&pool->lock);
+}
+
+static void *
+_eina_slab_huge_malloc(Slab_Mempool *pool, unsigned int size)
+{
+   Slab *slab;
+   size_t length;
+   void *map;
+   size_t map_size;
+
+   length = aligned_slab + size;
+   length = ((length + page_size - 1) / page_size) * page_size;
+
+   slab = _eina_slab_map(length, &map, &map_size, EINA_FALSE);
+   if (!slab) return NULL;
+
+   slab->pool = pool;
+   slab->arena = NULL;
+   slab->map = map;
+   slab->map_size = map_size;
+   slab->klass = SLAB_CLASS_HUGE;
+   slab->usage = 1;
+   slab->capacity = size;
+
+   eina_spinlock_take(&pool->lock);
+   pool->huge = eina_inlist_append(pool->huge, EINA_INLIST_GET(slab));
+   pool->huge_count++;
+   pool->huge_size += size;
+   eina_spinlock_release(&pool->lock);
+
+   return ((unsigned char *)slab) + aligned_slab;
+}
+
+static void
+_eina_slab_huge_free(Slab_Mempool *pool, Slab *slab)
+{
+   eina_spinlock_take(&pool->lock);
+   pool->huge = eina_inlist_remove(pool->huge, EINA_INLIST_GET(slab));
+   pool->huge_count--;
+   pool->huge_size -= slab->capacity;
+   eina_spinlock_release(&pool->lock);
+
+   _eina_slab_unmap(slab->map, slab->map_size);
+}
+
+static void *
+eina_slab_malloc(void *data, unsigned int size)
+{
+   Slab_Mempool *pool = data;
+   Slab_Class *cl;
+   Slab *slab;
+   unsigned int klass;
+   void *mem;
+
+   klass = _eina_slab_class_get(size);
+   if (klass == SLAB_CLASS_HUGE)
+     return _eina_slab_huge_malloc(pool, size);
+
+   cl = &pool->classes[klass];
+   eina_spinlock_take(&cl->lock);
+
+   if (!cl->partial)
+     {
+        unsigned char *ptr;
+
+        slab = _eina_slab_new(pool);
+        if (!slab)
+          {
+             eina_spinlock_release(&cl->lock);
+             return NULL;
+          }
+
+        ptr = ((unsigned char *)slab) + aligned_slab;
+        slab->pool = pool;
+        slab->klass = klass;
+        slab->base = NULL;
+        slab->usage = 0;
+        slab->capacity = (SLAB_SIZE - aligned_slab) / cl->item_size;
+        slab->last = ptr;
+        slab->limit = ptr + slab->capacity * cl->item_size;
+        cl->slabs++;
+        cl->partial = eina_inlist_prepend(cl->partial, EINA_INLIST_GET(slab));
+
+#ifndef NVALGRIND
+        VALGRIND_MAKE_MEM_NOACCESS(ptr, slab->limit - ptr);
+#endif
+     }
+
+   slab = EINA_INLIST_CONTAINER_GET(cl->partial, Slab);
+   if (slab->base)
+     {
+#ifndef NVALGRIND
+        VALGRIND_MAKE_MEM_DEFINED(slab->base, cl->item_size);
+#endif
+        mem = eina_trash_pop(&slab->base);
+     }
+   else
+     {
+        mem = slab->last;
+        slab->last += cl->item_size;
+     }
+
+   // full slabs leave the list until something is freed in them
+   if (++slab->usage == slab->capacity)
+     cl->partial = eina_inlist_remove(cl->partial, EINA_INLIST_GET(slab));
+
+   if (++cl->usage > cl->max_usage) cl->max_usage = cl->usage;
+
+   eina_spinlock_release(&cl->lock);
+
+#ifndef NVALGRIND
+   VALGRIND_MEMPOOL_ALLOC(pool, mem, size);
+#endif
+
+   return mem;
+}
+
+static void
+eina_slab_free(void *data, void *ptr)
+{
+   Slab_Mempool *pool = data;
+   Slab_Class *cl;
+   Slab *slab;
+
+   slab = SLAB_GET(ptr);
+   if (slab->pool != pool)
+     {
+        ERR("%p is not the property of %p '%s' Slab_Mempool", ptr, pool, pool->name);
+        return;
+     }
+
+   if (slab->klass == SLAB_CLASS_HUGE)
+     {
+#ifndef NVALGRIND
+        VALGRIND_MEMPOOL_FREE(pool, ptr);
+#endif
+        _eina_slab_huge_free(pool, slab);
+        return;
+     }
+
+   cl = &pool->classes[slab->klass];
+   eina_spinlock_take(&cl->lock);
+
+   eina_trash_push(&slab->base, ptr);
+   cl->usage--;
+
+#ifndef NVALGRIND
+   VALGRIND_MEMPOOL_FREE(pool, ptr);
+#endif
+
+   if (slab->usage-- == slab->capacity)
+     cl->partial = eina_inlist_prepend(cl->partial, EINA_INLIST_GET(slab));
+
+   // keep the last slab of a class around to not bounce on a single item
+   if (!slab->usage &&
+       (EINA_INLIST_GET(slab)->next || EINA_INLIST_GET(slab)->prev))
+     {
+        cl->partial = eina_inlist_remove(cl->partial, EINA_INLIST_GET(slab));
+        cl->slabs--;
+        eina_spinlock_release(&cl->lock);
+
+        slab->pool = NULL;
+        _eina_slab_release(pool, slab);
+        return;
+     }
+
+   eina_spinlock_release(&cl->lock);
+}
+
+static void *
+eina_slab_realloc(void *data, void *element, unsigned int size)
+{
+   Slab_Mempool *pool = data;
+   Slab *slab;
+   unsigned int old;
+   void *mem;
+
+   if (!element) return eina_slab_malloc(data, size);
+
+   slab = SLAB_GET(element);
+   if (slab->klass == SLAB_CLASS_HUGE)
+     old = slab->capacity;
+   else
+     old = pool->classes[slab->klass].item_size;
+
+   // still fits in the same class
+   if ((size <= old) && (_eina_slab_class_get(size) == slab->klass))
+     return element;
+
+   mem = eina_slab_malloc(data, size);
+   if (!mem) return NULL;
+   memcpy(mem, element, old < size ? old : size);
+   eina_slab_free(data, element);
+
+   return mem;
+}
+
+static Eina_Bool
+eina_slab_from(void *data, void *ptr)
+{
+   Slab_Mempool *pool = data;
+   Slab_Arena *arena;
+   Slab *slab, *h;
+   Eina_Trash *t;
+   Eina_Bool ret = EINA_FALSE;
+
+   // first make sure the slab is ours before looking at it
+   slab = SLAB_GET(ptr);
+
+   eina_spinlock_take(&pool->lock);
+   EINA_INLIST_FOREACH(pool->huge, h)
+     if (h == slab)
+       {
+          ret = (((unsigned char *)ptr) == ((unsigned char *)slab) + aligned_slab);
+          eina_spinlock_release(&pool->lock);
+          return ret;
+       }
+
+   EINA_INLIST_FOREACH(pool->arenas, arena)
+     if ((unsigned char *)slab >= arena->base &&
+         (unsigned char *)slab < arena->base + arena->carved * SLAB_SIZE)
+       break;
+   eina_spinlock_release(&pool->lock);
+
+   if (!arena || slab->pool != pool) return EINA_FALSE;
+
+   eina_spinlock_take(&pool->classes[slab->klass].lock);
+
+   if ((unsigned char *)ptr < ((unsigned char *)slab) + aligned_slab) goto end;
+   if ((unsigned char *)ptr >= slab->limit) goto end;
+   if (slab->last && (unsigned char *)ptr >= slab->last) goto end;
+   if ((((unsigned char *)ptr) - (((unsigned char *)slab) + aligned_slab)) %
+       pool->classes[slab->klass].item_size)
+     goto end;
+
+   for (t = slab->base; t; t = t->next)
+     {
+#ifndef NVALGRIND
+        VALGRIND_MAKE_MEM_DEFINED(t, sizeof (Eina_Trash));
+#endif
+        if (t == ptr) goto end;
+     }
+
+   ret = EINA_TRUE;
+
+ end:
+   eina_spinlock_release(&pool->classes[slab->klass].lock);
+   return ret;
+}
+
+static void
+eina_slab_gc(void *data)
+{
+   Slab_Mempool *pool = data;
+   Eina_Inlist *l;
+   Slab *slab;
+   unsigned int empty, keep;
+   uintptr_t body;
+
+   eina_spinlock_take(&pool->lock);
+   empty = eina_inlist_count(pool->empty);
+
+   // give back the arenas that have no slab in use, as long as enough empty
+   // slabs are left to not remap one on the next allocation burst
+   l = pool->arenas;
+   while (l)
+     {
+        Slab_Arena *arena = EINA_INLIST_CONTAINER_GET(l, Slab_Arena);
+        unsigned int i;
+
+        l = l->next;
+        if (arena->used) continue;
+        if (empty < arena->carved + SLAB_EMPTY_KEEP) continue;
+        empty -= arena->carved;
+
+        for (i = 0; i < arena->carved; i++)
+          pool->empty = eina_inlist_remove(pool->empty,
+                                           EINA_INLIST_GET((Slab *)(arena->base + i * SLAB_SIZE)));
+
+        pool->arenas = eina_inlist_remove(pool->arenas, EINA_INLIST_GET(arena));
+        _eina_slab_unmap(arena->map, arena->map_size);
+        free(arena);
+     }
+
+   // the most recently emptied slabs come first and stay as they are, the
+   // pages of the others go back to the system, only their header is kept
+   body = (aligned_slab + page_size - 1) & ~((uintptr_t)page_size - 1);
+   keep = 0;
+   EINA_INLIST_FOREACH(pool->empty, slab)
+     {
+        if (keep++ < SLAB_EMPTY_KEEP) continue;
+#if defined(HAVE_MMAP) && defined(MADV_DONTNEED)
+# ifdef HAVE_VALGRIND
+        if (RUNNING_ON_VALGRIND) continue;
+# endif
+        madvise(((unsigned char *)slab) + body, SLAB_SIZE - body, MADV_DONTNEED);
+#else
+        (void) body;
+#endif
+     }
+   eina_spinlock_release(&pool->lock);
+}
+
+static void
+eina_slab_statistics(void *data)
+{
+   Slab_Mempool *pool = data;
+   unsigned int i;
+
+   INF("Slab mempool '%s' statistics:", pool->name);
+   for (i = 0; i < SLAB_CLASSES; i++)
+     {
+        Slab_Class *cl = &pool->classes[i];
+        unsigned int capacity;
+
+        eina_spinlock_take(&cl->lock);
+        if (cl->slabs)
+          {
+             capacity = cl->slabs * ((SLAB_SIZE - aligned_slab) / cl->item_size);
+             // fragmentation is the share of reserved items not in use
+             INF("  class %5u bytes: %u slabs, %u/%u items used (max %u), %3.0f%% fragmentation",
+                 cl->item_size, cl->slabs, cl->usage, capacity, cl->max_usage,
+                 capacity ? (capacity - cl->usage) * 100.0 / capacity : 0.0);
+          }
+        eina_spinlock_release(&cl->lock);
+     }
+
+   eina_spinlock_take(&pool->lock);
+   INF("  %u huge allocations, %lu bytes, %u arenas of %i bytes",
+       pool->huge_count, (unsigned long)pool->huge_size,
+       eina_inlist_count(pool->arenas), SLAB_ARENA_SIZE);
+   eina_spinlock_release(&pool->lock);
+}
+
+static void *
+eina_slab_init(const char *context,
+               EINA_UNUSED const char *option,
+               EINA_UNUSED va_list args)
+{
+   Slab_Mempool *pool;
+   size_t length;
+   unsigned int i;
+
+   length = context ? strlen(context) + 1 : 0;
+
+   pool = calloc(1, sizeof (Slab_Mempool) + length);
+   if (!pool) return NULL;
+
+   if (length)
+     {
+        pool->name = (const char *)(pool + 1);
+        memcpy((char *)pool->name, context, length);
+     }
+
+   for (i = 0; i < SLAB_CLASSES; i++)
+     {
+        pool->classes[i].item_size = _eina_slab_class_size(i);
+        eina_spinlock_new(&pool->classes[i].lock);
+     }
+   eina_spinlock_new(&pool->lock);
+
+#ifndef NVALGRIND
+   VALGRIND_CREATE_MEMPOOL(pool, 0, 1);
+#endif
+
+   return pool;
+}
+
+static void
+eina_slab_shutdown(void *data)
+{
+   Slab_Mempool *pool = data;
+   unsigned int i;
+
+   while (pool->huge)
+     {
+        Slab *slab = EINA_INLIST_CONTAINER_GET(pool->huge, Slab);
+
+        pool->huge = eina_inlist_remove(pool->huge, pool->huge);
+        _eina_slab_unmap(slab->map, slab->map_size);
+     }
+
+   while (pool->arenas)
+     {
+        Slab_Arena *arena = EINA_INLIST_CONTAINER_GET(pool->arenas, Slab_Arena);
+
+#ifdef DEBUG
+        if (arena->used)
+          INF("Bad news we are destroying a non-empty mempool [%s]\n",
+              pool->name);
+#endif
+
+        pool->arenas = eina_inlist_remove(pool->arenas, pool->arenas);
+        _eina_slab_unmap(arena->map, arena->map_size);
+        free(arena);
+     }
+
+   for (i = 0; i < SLAB_CLASSES; i++)
+     eina_spinlock_free(&pool->classes[i].lock);
+   eina_spinlock_free(&pool->lock);
+
+#ifndef NVALGRIND
+   VALGRIND_DESTROY_MEMPOOL(pool);
+#endif
+
+   free(pool);
+}
+
+static Eina_Mempool_Backend _eina_slab_mp_backend = {
+   "slab",
+   &eina_slab_init,
+   &eina_slab_free,
+   &eina_slab_malloc,
+   &eina_slab_realloc,
+   &eina_slab_gc,
+   &eina_slab_statistics,
+   &eina_slab_shutdown,
+   NULL,
+   &eina_slab_from
+};
+
+Eina_Bool slab_init(void)
+{
+   _eina_slab_log_dom = eina_log_domain_register("eina_mempool",
+                                                 EINA_LOG_COLOR_DEFAULT);
+   if (_eina_slab_log_dom < 0)
+     {
+        EINA_LOG_ERR("Could not register log domain: eina_mempool");
+        return EINA_FALSE;
+     }
+
+   page_size = eina_cpu_page_size();
+   aligned_slab = eina_mempool_alignof(sizeof (Slab));
+   if (aligned_slab < SLAB_ALIGN) aligned_slab = SLAB_ALIGN;
+
+   return eina_mempool_register(&_eina_slab_mp_backend);
+}
+
+void slab_shutdown(void)
+{
+   eina_mempool_unregister(&_eina_slab_mp_backend);
+   eina_log_domain_unregister(_eina_slab_log_dom);
+   _eina_slab_log_dom = -1;
+}
+
+#ifndef EINA_STATIC_BUILD_SLAB
+
+EINA_MODULE_INIT(slab_init);
+EINA_MODULE_SHUTDOWN(slab_shutdown);
+
+#endif /* ! EINA_STATIC_BUILD_SLAB */
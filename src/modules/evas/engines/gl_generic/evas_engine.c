@@ -1220,6 +1220,13 @@ eng_image_scale_hint_set(void *engine EINA_UNUSED, void *image, int hint)
    if (image) evas_gl_common_image_scale_hint_set(image, hint);
 }
 
+static void
+eng_image_scale_mipmap_set(void *engine EINA_UNUSED, void *image EINA_UNUSED,
+                           Eina_Bool mipmap EINA_UNUSED)
+{
+   // textures are filtered by the GPU, there are no levels to build here
+}
+
 static int
 eng_image_scale_hint_get(void *engine EINA_UNUSED, void *image)
 {
@@ -3162,6 +3169,7 @@ module_open(Evas_Module *em)
 
    ORD(image_scale_hint_set);
    ORD(image_scale_hint_get);
+   ORD(image_scale_mipmap_set);
    ORD(image_stride_get);
 
    ORD(image_map_draw);
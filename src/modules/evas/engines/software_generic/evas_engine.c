@@ -2759,6 +2759,16 @@ eng_image_scale_hint_get(void *data EINA_UNUSED, void *image)
    return im->scale_hint;
 }
 
+static void
+eng_image_scale_mipmap_set(void *data EINA_UNUSED, void *image, Eina_Bool mipmap)
+{
+   Image_Entry *im;
+
+   if (!image) return;
+   im = image;
+   im->flags.mipmap = !!mipmap;
+}
+
 static Eina_Bool
 eng_image_animated_get(void *data EINA_UNUSED, void *image)
 {
@@ -4726,6 +4736,7 @@ static Evas_Func func =
      eng_ector_surface_cache_drop,
      eng_gfx_filter_supports,
      eng_gfx_filter_process,
+     eng_image_scale_mipmap_set,
    /* FUTURE software generic calls go here */
      0 // sizeof (Info)
 };
@@ -0,0 +1,407 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Ecore.h>
+#include "ecore_suite.h"
+
+#define PARALLEL_ITEMS 10000
+
+typedef struct _Graph_Order Graph_Order;
+struct _Graph_Order
+{
+   Eina_Spinlock lock;
+   int           seq;
+   int           pos[4];
+};
+
+typedef struct _Graph_Node Graph_Node;
+struct _Graph_Node
+{
+   Graph_Order *order;
+   int          id;
+};
+
+static Eina_Value
+_future_check(void *data, const Eina_Value v, const Eina_Future *dead EINA_UNUSED)
+{
+   Eina_Error *err = data;
+
+   if (v.type == EINA_VALUE_TYPE_ERROR)
+     eina_value_error_get(&v, err);
+   else
+     *err = 0;
+   ecore_main_loop_quit();
+   return v;
+}
+
+static Eina_Value
+_future_error_get(void *data, const Eina_Value v, const Eina_Future *dead EINA_UNUSED)
+{
+   Eina_Error *err = data;
+
+   if (v.type == EINA_VALUE_TYPE_ERROR)
+     eina_value_error_get(&v, err);
+   return v;
+}
+
+static void
+_parallel_mark(void *data, Ecore_Thread *thread EINA_UNUSED,
+               unsigned int start, unsigned int end)
+{
+   unsigned char *items = data;
+   unsigned int i;
+
+   for (i = start; i < end; i++)
+     items[i]++;
+}
+
+EFL_START_TEST(ecore_test_thread_parallel_for)
+{
+   unsigned char *items;
+   Eina_Error err = -1;
+   Eina_Future *f;
+   unsigned int i;
+
+   items = calloc(PARALLEL_ITEMS, 1);
+   fail_if(!items);
+
+   f = ecore_thread_parallel_for(0, PARALLEL_ITEMS, 0, _parallel_mark, items);
+   fail_if(!f);
+   eina_future_then(f, _future_check, &err);
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(err, 0);
+   for (i = 0; i < PARALLEL_ITEMS; i++)
+     ck_assert_int_eq(items[i], 1);
+
+   /* an odd grain leaves a short last chunk */
+   memset(items, 0, PARALLEL_ITEMS);
+   f = ecore_thread_parallel_for(7, PARALLEL_ITEMS - 7, 333, _parallel_mark, items);
+   fail_if(!f);
+   eina_future_then(f, _future_check, &err);
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(err, 0);
+   for (i = 0; i < PARALLEL_ITEMS; i++)
+     ck_assert_int_eq(items[i], ((i >= 7) && (i < PARALLEL_ITEMS - 7)));
+
+   /* an empty range is done right away */
+   f = ecore_thread_parallel_for(5, 5, 1, _parallel_mark, items);
+   fail_if(!f);
+   eina_future_then(f, _future_check, &err);
+   ecore_main_loop_begin();
+   ck_assert_int_eq(err, 0);
+
+   free(items);
+}
+EFL_END_TEST
+
+static void
+_parallel_spin(void *data EINA_UNUSED, Ecore_Thread *thread,
+               unsigned int start EINA_UNUSED, unsigned int end EINA_UNUSED)
+{
+   while (!ecore_thread_check(thread))
+     usleep(1000);
+}
+
+static Eina_Bool
+_threads_idle_check(void *data EINA_UNUSED)
+{
+   if (ecore_thread_active_get() || ecore_thread_pending_total_get())
+     return EINA_TRUE;
+   ecore_main_loop_quit();
+   return EINA_FALSE;
+}
+
+EFL_START_TEST(ecore_test_thread_parallel_for_cancel)
+{
+   Eina_Error err = -1;
+   Eina_Future *f;
+
+   f = ecore_thread_parallel_for(0, 100, 1, _parallel_spin, NULL);
+   fail_if(!f);
+   eina_future_then(f, _future_error_get, &err);
+   eina_future_cancel(f);
+   ck_assert_int_eq(err, ECANCELED);
+
+   /* the jobs that were already running must stop on their own */
+   ecore_timer_add(0.01, _threads_idle_check, NULL);
+   ecore_main_loop_begin();
+}
+EFL_END_TEST
+
+static void
+_graph_node_run(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Graph_Node *node = data;
+
+   eina_spinlock_take(&node->order->lock);
+   node->order->pos[node->id] = node->order->seq++;
+   eina_spinlock_release(&node->order->lock);
+}
+
+EFL_START_TEST(ecore_test_thread_graph)
+{
+   Ecore_Thread_Graph *graph;
+   Ecore_Thread_Task *tasks[4];
+   Graph_Node nodes[4];
+   Graph_Order order;
+   Eina_Error err = -1;
+   Eina_Future *f;
+   int i;
+
+   memset(&order, 0, sizeof (order));
+   eina_spinlock_new(&order.lock);
+
+   /* diamond: 0 -> (1, 2) -> 3 */
+   graph = ecore_thread_graph_new();
+   fail_if(!graph);
+   for (i = 3; i >= 0; i--)
+     {
+        nodes[i].order = &order;
+        nodes[i].id = i;
+        tasks[i] = ecore_thread_graph_task_add(graph, _graph_node_run, &nodes[i]);
+        fail_if(!tasks[i]);
+     }
+   fail_if(!ecore_thread_graph_task_depend(tasks[1], tasks[0]));
+   fail_if(!ecore_thread_graph_task_depend(tasks[2], tasks[0]));
+   fail_if(!ecore_thread_graph_task_depend(tasks[3], tasks[1]));
+   fail_if(!ecore_thread_graph_task_depend(tasks[3], tasks[2]));
+
+   f = ecore_thread_graph_run(graph);
+   fail_if(!f);
+   eina_future_then(f, _future_check, &err);
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(err, 0);
+   ck_assert_int_eq(order.seq, 4);
+   ck_assert_int_eq(order.pos[0], 0);
+   ck_assert_int_eq(order.pos[3], 3);
+
+   /* a cycle is refused */
+   graph = ecore_thread_graph_new();
+   fail_if(!graph);
+   tasks[0] = ecore_thread_graph_task_add(graph, _graph_node_run, &nodes[0]);
+   tasks[1] = ecore_thread_graph_task_add(graph, _graph_node_run, &nodes[1]);
+   fail_if(!ecore_thread_graph_task_depend(tasks[1], tasks[0]));
+   fail_if(!ecore_thread_graph_task_depend(tasks[0], tasks[1]));
+
+   f = ecore_thread_graph_run(graph);
+   fail_if(!f);
+   eina_future_then(f, _future_check, &err);
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(err, EINVAL);
+   ck_assert_int_eq(order.seq, 4);
+
+   eina_spinlock_free(&order.lock);
+}
+EFL_END_TEST
+
+EFL_START_TEST(ecore_test_thread_file_map_populate)
+{
+   const unsigned long int length = 3 * 1024 * 1024 + 5;
+   unsigned char *buf, *map;
+   Eina_Tmpstr *path;
+   Eina_Error err = -1;
+   Eina_Future *f;
+   Eina_File *file;
+   unsigned long int i;
+   int fd;
+
+   buf = malloc(length);
+   fail_if(!buf);
+   for (i = 0; i < length; i++)
+     buf[i] = (unsigned char)(i * 13);
+   fd = eina_file_mkstemp("ecore_thread_populate_XXXXXX", &path);
+   fail_if(fd < 0);
+   fail_if(write(fd, buf, length) != (ssize_t)length);
+   close(fd);
+
+   file = eina_file_open(path, EINA_FALSE);
+   fail_if(!file);
+   map = eina_file_map_all(file, EINA_FILE_RANDOM);
+   fail_if(!map);
+
+   f = ecore_thread_file_map_populate(file, map, 0, length);
+   fail_if(!f);
+   eina_future_then(f, _future_check, &err);
+   ecore_main_loop_begin();
+   ck_assert_int_eq(err, 0);
+   fail_if(memcmp(map, buf, length));
+
+   /* a cancelled populate is rejected right away */
+   err = -1;
+   f = ecore_thread_file_map_populate(file, map, 100, 0);
+   fail_if(!f);
+   eina_future_then(f, _future_error_get, &err);
+   eina_future_cancel(f);
+   ck_assert_int_eq(err, ECANCELED);
+
+   /* a map that is not one of the file is refused */
+   f = ecore_thread_file_map_populate(file, buf, 0, 0);
+   fail_if(!f);
+   eina_future_then(f, _future_check, &err);
+   ecore_main_loop_begin();
+   ck_assert_int_eq(err, EINVAL);
+
+   ecore_timer_add(0.01, _threads_idle_check, NULL);
+   ecore_main_loop_begin();
+
+   eina_file_map_free(file, map);
+   eina_file_close(file);
+   unlink(path);
+   eina_tmpstr_del(path);
+   free(buf);
+}
+EFL_END_TEST
+
+typedef struct _Lane_Check Lane_Check;
+struct _Lane_Check
+{
+   Eina_Spinlock lock;
+   int           feedback_running;
+   int           feedback_max;
+   int           short_done;
+   int           short_count;
+   int           ended;
+   int           count;
+   Eina_Bool     blocked_saw_done;
+};
+
+static int
+_lane_short_done_get(Lane_Check *lc)
+{
+   int r;
+
+   eina_spinlock_take(&lc->lock);
+   r = lc->short_done;
+   eina_spinlock_release(&lc->lock);
+   return r;
+}
+
+/* holds its worker until all the short jobs are done, or gives up */
+static void
+_lane_blocker(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Lane_Check *lc = data;
+   int i;
+
+   for (i = 0; i < 5000; i++)
+     {
+        if (_lane_short_done_get(lc) == lc->short_count)
+          {
+             eina_spinlock_take(&lc->lock);
+             lc->blocked_saw_done = EINA_TRUE;
+             eina_spinlock_release(&lc->lock);
+             return;
+          }
+        usleep(1000);
+     }
+}
+
+static void
+_lane_feedback(void *data, Ecore_Thread *thread)
+{
+   Lane_Check *lc = data;
+
+   eina_spinlock_take(&lc->lock);
+   if (++lc->feedback_running > lc->feedback_max)
+     lc->feedback_max = lc->feedback_running;
+   eina_spinlock_release(&lc->lock);
+
+   _lane_blocker(data, thread);
+
+   eina_spinlock_take(&lc->lock);
+   lc->feedback_running--;
+   eina_spinlock_release(&lc->lock);
+}
+
+static void
+_lane_short(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Lane_Check *lc = data;
+
+   eina_spinlock_take(&lc->lock);
+   lc->short_done++;
+   eina_spinlock_release(&lc->lock);
+}
+
+static void
+_lane_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Lane_Check *lc = data;
+
+   if (++lc->ended == lc->count) ecore_main_loop_quit();
+}
+
+EFL_START_TEST(ecore_test_thread_steal)
+{
+   Lane_Check lc;
+   int i;
+
+   memset(&lc, 0, sizeof (lc));
+   eina_spinlock_new(&lc.lock);
+   lc.short_count = 64;
+   lc.count = lc.short_count + 1;
+   ecore_thread_max_set(4);
+
+   /* whatever deque the short jobs land on, the one of the blocked worker
+    * included, the other workers steal them and get them all done */
+   fail_if(!ecore_thread_run(_lane_blocker, _lane_end, _lane_end, &lc));
+   for (i = 0; i < lc.short_count; i++)
+     fail_if(!ecore_thread_run(_lane_short, _lane_end, _lane_end, &lc));
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(lc.short_done, lc.short_count);
+   fail_if(!lc.blocked_saw_done);
+
+   ecore_thread_max_reset();
+   eina_spinlock_free(&lc.lock);
+}
+EFL_END_TEST
+
+EFL_START_TEST(ecore_test_thread_lane_cap)
+{
+   Lane_Check lc;
+   int i, max, feedback;
+
+   memset(&lc, 0, sizeof (lc));
+   eina_spinlock_new(&lc.lock);
+   ecore_thread_max_set(4);
+   max = ecore_thread_max_get();
+   feedback = max - MAX(max / 4, 1);
+
+   /* as many feedback jobs as workers, all blocked until the short job
+    * is done: it only runs if feedback jobs are kept off a worker */
+   lc.short_count = 1;
+   lc.count = max + 1;
+   for (i = 0; i < max; i++)
+     fail_if(!ecore_thread_feedback_run(_lane_feedback, NULL, _lane_end,
+                                        _lane_end, &lc, EINA_FALSE));
+   fail_if(!ecore_thread_run(_lane_short, _lane_end, _lane_end, &lc));
+   ecore_main_loop_begin();
+
+   ck_assert_int_eq(lc.short_done, 1);
+   fail_if(!lc.blocked_saw_done);
+   fail_if(lc.feedback_max > feedback);
+
+   ecore_thread_max_reset();
+   eina_spinlock_free(&lc.lock);
+}
+EFL_END_TEST
+
+void ecore_test_ecore_thread(TCase *tc)
+{
+   tcase_add_test(tc, ecore_test_thread_parallel_for);
+   tcase_add_test(tc, ecore_test_thread_parallel_for_cancel);
+   tcase_add_test(tc, ecore_test_thread_graph);
+   tcase_add_test(tc, ecore_test_thread_file_map_populate);
+   tcase_add_test(tc, ecore_test_thread_steal);
+   tcase_add_test(tc, ecore_test_thread_lane_cap);
+}
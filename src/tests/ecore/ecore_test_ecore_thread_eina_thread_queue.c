@@ -675,6 +675,147 @@ EFL_START_TEST(ecore_test_ecore_thread_eina_thread_queue_t7)
 }
 EFL_END_TEST
 
+/////////////////////////////////////////////////////////////////////////////
+typedef struct
+{
+   Eina_Thread_Queue_Msg  head;
+   int                    value;
+} Msg8;
+
+static void
+th8_do(void *data EINA_UNUSED, Ecore_Thread *th)
+{
+   int val = 100, batch = 1;
+
+   while (val < 10100)
+     {
+        Msg8 *msg;
+        void *ref;
+        int i;
+
+        // batches of 1 to 16 messages, alternating message sizes
+        if (val + batch > 10100) batch = 10100 - val;
+        msg = eina_thread_queue_send_many(thq1, sizeof(Msg8) + ((batch & 1) * 24),
+                                          batch, &ref);
+        fail_if(!msg);
+        for (i = 0; i < batch; i++)
+          {
+             msg->value = val++;
+             if (i < (batch - 1)) msg = eina_thread_queue_msg_next(msg);
+          }
+        eina_thread_queue_send_many_done(thq1, batch, ref);
+        batch = (batch % 16) + 1;
+        if (ecore_thread_check(th)) break;
+     }
+}
+
+static void
+_thread_queue_batch_check(Ecore_Thread_Cb func)
+{
+   int val = 99, cnt = 0, max = 0;
+   Ecore_Thread *eth1;
+
+   eth1 = ecore_thread_feedback_run(func, NULL, NULL, NULL, NULL, EINA_TRUE);
+   while (val < 10099)
+     {
+        Msg8 *msg;
+        void *ref;
+        int i, count = max;
+
+        msg = eina_thread_queue_wait_many(thq1, &count, &ref);
+        fail_if(!msg);
+        fail_if(count < 1);
+        fail_if((max > 0) && (count > max));
+        for (i = 0; i < count; i++)
+          {
+             if (msg->value != (val + 1))
+               {
+                  ck_abort_msg("ERR: val wrong %i -> %i\n", val, msg->value);
+               }
+             val = msg->value;
+             if (i < (count - 1)) msg = eina_thread_queue_msg_next(msg);
+          }
+        eina_thread_queue_wait_done(thq1, ref);
+        // alternate between no limit and a limit of 1 to 7 messages
+        max = (cnt++ % 8);
+     }
+   ecore_thread_wait(eth1, 0.1);
+   fail_if(eina_thread_queue_pending_get(thq1) != 0);
+}
+
+EFL_START_TEST(ecore_test_ecore_thread_eina_thread_queue_t8)
+{
+   thq1 = eina_thread_queue_new();
+   fail_if(!thq1);
+   _thread_queue_batch_check(th8_do);
+   eina_thread_queue_free(thq1);
+}
+EFL_END_TEST
+
+/////////////////////////////////////////////////////////////////////////////
+EFL_START_TEST(ecore_test_ecore_thread_eina_thread_queue_t9)
+{
+   Eina_Thread_Queue *parent;
+   Eina_Thread_Queue_Msg_Sub *sub;
+   Msg8 *msg;
+   void *ref;
+   int i, count;
+
+   // a small ring so it wraps and fills up often
+   thq1 = eina_thread_queue_spsc_new(4096);
+   fail_if(!thq1);
+   _thread_queue_batch_check(th8_do);
+
+   // messages must fit in half the ring
+   msg = eina_thread_queue_send(thq1, 4096, &ref);
+   fail_if(msg != NULL);
+
+   parent = eina_thread_queue_new();
+   fail_if(!parent);
+   eina_thread_queue_parent_set(thq1, parent);
+   msg = eina_thread_queue_send_many(thq1, sizeof(Msg8), 10, &ref);
+   fail_if(!msg);
+   for (i = 0; i < 10; i++)
+     {
+        msg->value = i;
+        if (i < 9) msg = eina_thread_queue_msg_next(msg);
+     }
+   eina_thread_queue_send_many_done(thq1, 10, ref);
+
+   // one sub message per message sent on the child
+   count = 0;
+   sub = eina_thread_queue_poll_many(parent, &count, &ref);
+   fail_if(!sub);
+   ck_assert_int_eq(count, 10);
+   for (i = 0; i < count; i++)
+     {
+        fail_if(sub->queue != thq1);
+        if (i < (count - 1)) sub = eina_thread_queue_msg_next(sub);
+     }
+   eina_thread_queue_wait_done(parent, ref);
+
+   count = 4;
+   msg = eina_thread_queue_poll_many(thq1, &count, &ref);
+   fail_if(!msg);
+   ck_assert_int_eq(count, 4);
+   ck_assert_int_eq(msg->value, 0);
+   eina_thread_queue_wait_done(thq1, ref);
+   count = 0;
+   msg = eina_thread_queue_poll_many(thq1, &count, &ref);
+   fail_if(!msg);
+   ck_assert_int_eq(count, 6);
+   ck_assert_int_eq(msg->value, 4);
+   eina_thread_queue_wait_done(thq1, ref);
+   count = 0;
+   msg = eina_thread_queue_poll_many(thq1, &count, &ref);
+   fail_if(msg != NULL);
+   ck_assert_int_eq(count, 0);
+
+   eina_thread_queue_free(thq1);
+   eina_thread_queue_free(parent);
+}
+EFL_END_TEST
+
 void ecore_test_ecore_thread_eina_thread_queue(TCase *tc EINA_UNUSED)
 {
    tcase_add_test(tc, ecore_test_ecore_thread_eina_thread_queue_t1);
@@ -688,4 +829,6 @@ void ecore_test_ecore_thread_eina_thread_queue2(TCase *tc EINA_UNUSED)
    tcase_add_test(tc, ecore_test_ecore_thread_eina_thread_queue_t5);
    tcase_add_test(tc, ecore_test_ecore_thread_eina_thread_queue_t6);
    tcase_add_test(tc, ecore_test_ecore_thread_eina_thread_queue_t7);
+   tcase_add_test(tc, ecore_test_ecore_thread_eina_thread_queue_t8);
+   tcase_add_test(tc, ecore_test_ecore_thread_eina_thread_queue_t9);
 }
@@ -64,6 +64,7 @@ static const Efl_Test_Case etc[] = {
    { "String", eina_test_str },
    { "ustr", eina_test_ustr },
    { "QuadTree", eina_test_quadtree },
+   { "Rtree", eina_test_rtree },
    { "Sched", eina_test_sched },
    { "Simple Xml Parser", eina_test_simple_xml_parser},
    { "Value", eina_test_value },
@@ -89,6 +90,7 @@ static const Efl_Test_Case etc[] = {
    { "slstr", eina_test_slstr },
    { "Vpath", eina_test_vpath },
    { "debug", eina_test_debug },
+   { "Evlog", eina_test_evlog },
    { NULL, NULL }
 };
 
@@ -52,6 +52,7 @@ void eina_test_binbuf(TCase *tc);
 void eina_test_str(TCase *tc);
 void eina_test_ustr(TCase *tc);
 void eina_test_quadtree(TCase *tc);
+void eina_test_rtree(TCase *tc);
 void eina_test_fp(TCase *tc);
 void eina_test_sched(TCase *tc);
 void eina_test_simple_xml_parser(TCase *tc);
@@ -77,5 +78,6 @@ void eina_test_freeq(TCase *tc);
 void eina_test_slstr(TCase *tc);
 void eina_test_vpath(TCase *tc);
 void eina_test_debug(TCase *tc);
+void eina_test_evlog(TCase *tc);
 
 #endif /* EINA_SUITE_H_ */
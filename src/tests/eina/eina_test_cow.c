@@ -145,9 +145,88 @@ EFL_START_TEST(eina_cow)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_cow_stats)
+{
+   const Eina_Cow_Test *cur[16];
+   Eina_Cow_Test *write;
+   Eina_Cow_Test default_value = { 42, 0, NULL };
+   Eina_Cow_Stats stats;
+   Eina_Cow *cow;
+   unsigned int i;
+
+   cow = eina_cow_add("COW Test", sizeof (Eina_Cow_Test), 16, &default_value, EINA_TRUE);
+   fail_if(cow == NULL);
+   eina_cow_gc_background_set(cow, EINA_TRUE);
+   fail_if(eina_cow_gc_background_pending());
+
+   /* 16 writes of only 2 distinct values */
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(cur); i++)
+     {
+        cur[i] = eina_cow_alloc(cow);
+        write = eina_cow_write(cow, (const Eina_Cow_Data**) &cur[i]);
+        write->i = i & 1;
+        eina_cow_done(cow, (const Eina_Cow_Data**) &cur[i], write, EINA_TRUE);
+     }
+
+   fail_if(!eina_cow_stats_get(cow, &stats));
+   ck_assert_int_eq(stats.blocks, 16);
+   ck_assert_int_eq(stats.references, 16);
+   ck_assert_int_eq(stats.pending, 16);
+   ck_assert_int_eq(stats.shared_bytes, 0);
+   fail_if(!eina_cow_gc_background_pending());
+
+   while (eina_cow_gc_background_run(1.0))
+     ;
+   fail_if(eina_cow_gc_background_pending());
+
+   fail_if(!eina_cow_stats_get(cow, &stats));
+   ck_assert_int_eq(stats.blocks, 2);
+   ck_assert_int_eq(stats.references, 16);
+   ck_assert_int_eq(stats.pending, 0);
+   ck_assert_int_eq(stats.merged, 14);
+   ck_assert_int_eq(stats.shared_bytes, 14 * sizeof (Eina_Cow_Test));
+   fail_if(stats.unique_bytes < 2 * sizeof (Eina_Cow_Test));
+   for (i = 2; i < EINA_C_ARRAY_LENGTH(cur); i++)
+     ck_assert_ptr_eq(cur[i], cur[i & 1]);
+
+   /* unsharing a collected block, then writing it back to an existing value */
+   write = eina_cow_write(cow, (const Eina_Cow_Data**) &cur[0]);
+   write->i = 1;
+   eina_cow_done(cow, (const Eina_Cow_Data**) &cur[0], write, EINA_TRUE);
+   fail_if(!eina_cow_stats_get(cow, &stats));
+   ck_assert_int_eq(stats.blocks, 3);
+   ck_assert_int_eq(stats.pending, 1);
+   fail_if(!eina_cow_gc(cow));
+   fail_if(eina_cow_gc(cow));
+   ck_assert_ptr_eq(cur[0], cur[1]);
+
+   /* the last user of a collected block writes to it in place */
+   for (i = 1; i < EINA_C_ARRAY_LENGTH(cur); i += 2)
+     eina_cow_free(cow, (const Eina_Cow_Data**) &cur[i]);
+   write = eina_cow_write(cow, (const Eina_Cow_Data**) &cur[0]);
+   ck_assert_ptr_eq(write, cur[0]);
+   write->i = 5;
+   eina_cow_done(cow, (const Eina_Cow_Data**) &cur[0], write, EINA_TRUE);
+   fail_if(!eina_cow_gc(cow));
+   fail_if(!eina_cow_stats_get(cow, &stats));
+   ck_assert_int_eq(stats.references, 8);
+   ck_assert_int_eq(stats.blocks, 2);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(cur); i += 2)
+     eina_cow_free(cow, (const Eina_Cow_Data**) &cur[i]);
+   fail_if(!eina_cow_stats_get(cow, &stats));
+   ck_assert_int_eq(stats.blocks, 0);
+   ck_assert_int_eq(stats.references, 0);
+
+   eina_cow_del(cow);
+   fail_if(eina_cow_gc_background_run(1.0));
+}
+EFL_END_TEST
+
 void
 eina_test_cow(TCase *tc)
 {
    tcase_add_test(tc, eina_cow);
    tcase_add_test(tc, eina_cow_bad);
+   tcase_add_test(tc, eina_cow_stats);
 }
@@ -0,0 +1,400 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Eina.h>
+
+#include "eina_suite.h"
+
+#define EVLOG_THREADS 3
+#define EVLOG_EVENTS 500
+
+#define EVLOG_CONVERT \
+   PACKAGE_BUILD_DIR "/src/bin/eina/eina_evlog_convert/eina_evlog_convert"
+
+typedef struct
+{
+   const unsigned char *p;
+   const unsigned char *end;
+   Eina_Array *strings;
+   long long tim;
+} Stream_Reader;
+
+typedef struct
+{
+   long long tim;
+   unsigned long long thread;
+   unsigned long long obj;
+   const char *event;
+   const char *detail;
+   long long src;
+} Stream_Event;
+
+static Eina_Barrier _barrier;
+
+static void *
+_evlog_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   int n = (int)(uintptr_t)data, i;
+   char detail[16];
+
+   eina_barrier_wait(&_barrier);
+   for (i = 0; i < EVLOG_EVENTS; i++)
+     {
+        snprintf(detail, sizeof(detail), "%i", i);
+        eina_evlog(n ? "test_thread" : "test_main", NULL, 0.0, detail);
+     }
+   return NULL;
+}
+
+static void
+_evlog_threads_run(void)
+{
+   Eina_Thread th[EVLOG_THREADS - 1];
+   int i;
+
+   fail_if(!eina_barrier_new(&_barrier, EVLOG_THREADS));
+   for (i = 0; i < EVLOG_THREADS - 1; i++)
+     fail_if(!eina_thread_create(&th[i], EINA_THREAD_NORMAL, -1,
+                                 _evlog_thread, (void *)(uintptr_t)(i + 1)));
+   _evlog_thread(NULL, 0);
+   for (i = 0; i < EVLOG_THREADS - 1; i++)
+     eina_thread_join(th[i]);
+   eina_barrier_free(&_barrier);
+}
+
+EFL_START_TEST(eina_test_evlog_merge_order)
+{
+   Eina_Evlog_Buf *b;
+   unsigned int pos, main_count = 0, thread_count = 0;
+   double prev = 0.0;
+
+   eina_evlog_start();
+   _evlog_threads_run();
+   b = eina_evlog_steal();
+   fail_if(!b || !b->buf);
+   ck_assert_int_eq(b->overflow, 0);
+
+   // the rings of all the threads come out as one list sorted by time
+   for (pos = 0; pos < b->top;)
+     {
+        Eina_Evlog_Item *item = (Eina_Evlog_Item *)(b->buf + pos);
+        const char *event = (const char *)item + item->event_offset;
+
+        fail_if(item->event_next < sizeof(Eina_Evlog_Item));
+        fail_if(item->tim < prev);
+        prev = item->tim;
+        if (!strcmp(event, "test_main")) main_count++;
+        else if (!strcmp(event, "test_thread")) thread_count++;
+        pos += item->event_next;
+     }
+   ck_assert_int_eq(main_count, EVLOG_EVENTS);
+   ck_assert_int_eq(thread_count, EVLOG_EVENTS * (EVLOG_THREADS - 1));
+
+   // what was stolen is gone
+   b = eina_evlog_steal();
+   ck_assert_int_eq(b->top, 0);
+   eina_evlog_stop();
+}
+EFL_END_TEST
+
+static Eina_Bool
+_stream_uint(Stream_Reader *r, unsigned long long *val)
+{
+   unsigned int shift = 0;
+
+   *val = 0;
+   while (r->p < r->end)
+     {
+        unsigned char b = *(r->p++);
+
+        *val |= (unsigned long long)(b & 0x7f) << shift;
+        if (!(b & 0x80)) return EINA_TRUE;
+        shift += 7;
+     }
+   return EINA_FALSE;
+}
+
+static Eina_Bool
+_stream_int(Stream_Reader *r, long long *val)
+{
+   unsigned long long u;
+
+   if (!_stream_uint(r, &u)) return EINA_FALSE;
+   *val = (long long)(u >> 1) ^ -(long long)(u & 1);
+   return EINA_TRUE;
+}
+
+// reads the next event, checking the records before it
+static Eina_Bool
+_stream_event_next(Stream_Reader *r, Stream_Event *ev)
+{
+   unsigned long long id, len, thread, event, detail, obj;
+   long long delta;
+
+   while (r->p < r->end)
+     {
+        unsigned char type = *(r->p++), flags;
+
+        switch (type)
+          {
+           case EINA_EVLOG_STREAM_STRING:
+             fail_if(!_stream_uint(r, &id));
+             fail_if(!_stream_uint(r, &len));
+             fail_if(len > (unsigned long long)(r->end - r->p));
+             while (eina_array_count(r->strings) <= id)
+               eina_array_push(r->strings, strdup(""));
+             free(eina_array_data_get(r->strings, id));
+             eina_array_data_set(r->strings, id, strndup((const char *)r->p, len));
+             r->p += len;
+             break;
+           case EINA_EVLOG_STREAM_THREAD:
+             fail_if(!_stream_uint(r, &id));
+             fail_if(!_stream_uint(r, &thread));
+             break;
+           case EINA_EVLOG_STREAM_EVENT:
+             fail_if(r->p >= r->end);
+             flags = *(r->p++);
+             detail = obj = 0;
+             ev->src = 0;
+             fail_if(!_stream_int(r, &delta));
+             fail_if(!_stream_uint(r, &thread));
+             fail_if(!_stream_uint(r, &event));
+             if (flags & EINA_EVLOG_STREAM_DETAIL)
+               fail_if(!_stream_uint(r, &detail));
+             if (flags & EINA_EVLOG_STREAM_OBJ)
+               fail_if(!_stream_uint(r, &obj));
+             if (flags & EINA_EVLOG_STREAM_SRCTIME)
+               fail_if(!_stream_int(r, &(ev->src)));
+             // the strings are defined before the events using them
+             fail_if(event >= eina_array_count(r->strings));
+             fail_if(delta < 0);
+             r->tim += delta;
+             ev->tim = r->tim;
+             ev->thread = thread;
+             ev->obj = obj;
+             ev->event = eina_array_data_get(r->strings, event);
+             ev->detail = NULL;
+             if (flags & EINA_EVLOG_STREAM_DETAIL)
+               {
+                  fail_if(detail >= eina_array_count(r->strings));
+                  ev->detail = eina_array_data_get(r->strings, detail);
+               }
+             return EINA_TRUE;
+           case EINA_EVLOG_STREAM_LOST:
+             fail_if(!_stream_uint(r, &len));
+             break;
+           default:
+             ck_abort_msg("unknown record type %i", type);
+          }
+     }
+   return EINA_FALSE;
+}
+
+static void
+_stream_reader_init(Stream_Reader *r, Eina_File *f)
+{
+   size_t size = eina_file_size_get(f);
+
+   r->p = eina_file_map_all(f, EINA_FILE_SEQUENTIAL);
+   fail_if(!r->p);
+   fail_if(size < 8);
+   fail_if(memcmp(r->p, "EINAEVL1", 8));
+   r->end = r->p + size;
+   r->p += 8;
+   r->strings = eina_array_new(16);
+   r->tim = 0;
+}
+
+static void
+_stream_reader_shutdown(Stream_Reader *r)
+{
+   unsigned int i;
+
+   for (i = 0; i < eina_array_count(r->strings); i++)
+     free(eina_array_data_get(r->strings, i));
+   eina_array_free(r->strings);
+}
+
+static char *
+_stream_path(void)
+{
+   Eina_Tmpstr *tmp;
+   char *path;
+   int fd;
+
+   fd = eina_file_mkstemp("eina_evlog_XXXXXX", &tmp);
+   fail_if(fd < 0);
+   close(fd);
+   path = strdup(tmp);
+   eina_tmpstr_del(tmp);
+   return path;
+}
+
+EFL_START_TEST(eina_test_evlog_stream_format)
+{
+   Stream_Reader r;
+   Stream_Event ev;
+   Eina_File *f;
+   char *path;
+   int i = 0, main_count = 0, thread_count = 0;
+
+   path = _stream_path();
+   fail_if(!eina_evlog_stream_start(path, 0));
+   // only one stream at a time
+   fail_if(eina_evlog_stream_start(path, 0));
+   eina_evlog("+test_slice", (void *)0x1234, 0.0, "detail");
+   eina_evlog("test_src", NULL, 1.0, NULL);
+   _evlog_threads_run();
+   eina_evlog("-test_slice", NULL, 0.0, NULL);
+   eina_evlog_stream_stop();
+
+   f = eina_file_open(path, EINA_FALSE);
+   fail_if(!f);
+   _stream_reader_init(&r, f);
+   while (_stream_event_next(&r, &ev))
+     {
+        if (strstr(ev.event, "test_")) i++;
+        if (!strcmp(ev.event, "+test_slice"))
+          {
+             ck_assert_int_eq(i, 1);
+             ck_assert_str_eq(ev.detail, "detail");
+             ck_assert_int_eq(ev.obj, 0x1234);
+          }
+        else if (!strcmp(ev.event, "test_src"))
+          {
+             fail_if(ev.detail);
+             fail_if(ev.src <= 0);
+          }
+        else if (!strcmp(ev.event, "test_main")) main_count++;
+        else if (!strcmp(ev.event, "test_thread")) thread_count++;
+        else if (!strcmp(ev.event, "-test_slice"))
+          ck_assert_int_eq(i, 3 + EVLOG_EVENTS * EVLOG_THREADS);
+     }
+   fail_if(r.p != r.end);
+   ck_assert_int_eq(main_count, EVLOG_EVENTS);
+   ck_assert_int_eq(thread_count, EVLOG_EVENTS * (EVLOG_THREADS - 1));
+   _stream_reader_shutdown(&r);
+   eina_file_close(f);
+
+   unlink(path);
+   free(path);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_test_evlog_stream_rotate)
+{
+   Stream_Reader r;
+   Stream_Event ev;
+   Eina_File *f;
+   char *path, old[PATH_MAX];
+   unsigned long long max_size = 8192;
+   int i, count = 0, last = -1;
+
+   path = _stream_path();
+   snprintf(old, sizeof(old), "%s.1", path);
+   fail_if(!eina_evlog_stream_start(path, max_size));
+   for (i = 0; i < 5000; i++)
+     {
+        char detail[16];
+
+        snprintf(detail, sizeof(detail), "%i", i);
+        eina_evlog("test_rotate", NULL, 0.0, detail);
+     }
+   eina_evlog_stream_stop();
+
+   // two files of at most half the cap, each one readable on its own, the
+   // older one holding the events right before the ones of the newer
+   f = eina_file_open(old, EINA_FALSE);
+   fail_if(!f);
+   fail_if(eina_file_size_get(f) > max_size / 2 + 64);
+   _stream_reader_init(&r, f);
+   while (_stream_event_next(&r, &ev))
+     {
+        if (last >= 0) ck_assert_int_eq(atoi(ev.detail), last + 1);
+        last = atoi(ev.detail);
+        count++;
+     }
+   fail_if(!count);
+   _stream_reader_shutdown(&r);
+   eina_file_close(f);
+
+   f = eina_file_open(path, EINA_FALSE);
+   fail_if(!f);
+   fail_if(eina_file_size_get(f) > max_size / 2 + 64);
+   _stream_reader_init(&r, f);
+   while (_stream_event_next(&r, &ev))
+     {
+        ck_assert_int_eq(atoi(ev.detail), last + 1);
+        last = atoi(ev.detail);
+     }
+   ck_assert_int_eq(last, 4999);
+   _stream_reader_shutdown(&r);
+   eina_file_close(f);
+
+   unlink(old);
+   unlink(path);
+   free(path);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_test_evlog_convert)
+{
+   Eina_File *f;
+   Eina_Strbuf *cmd;
+   char *path, *json, *trace;
+   size_t size;
+
+   fail_if(access(EVLOG_CONVERT, X_OK));
+
+   path = _stream_path();
+   fail_if(!eina_evlog_stream_start(path, 0));
+   eina_evlog("+test_slice", NULL, 0.0, "a \"quoted\" detail");
+   eina_evlog("*test_counter", NULL, 0.0, "42");
+   eina_evlog(">test_state", NULL, 0.0, NULL);
+   eina_evlog("<test_state", NULL, 0.0, NULL);
+   eina_evlog("-test_slice", NULL, 0.0, NULL);
+   eina_evlog_stream_stop();
+
+   json = _stream_path();
+   cmd = eina_strbuf_new();
+   eina_strbuf_append_printf(cmd, "%s -o %s %s", EVLOG_CONVERT, json, path);
+   ck_assert_int_eq(system(eina_strbuf_string_get(cmd)), 0);
+   eina_strbuf_free(cmd);
+
+   f = eina_file_open(json, EINA_FALSE);
+   fail_if(!f);
+   size = eina_file_size_get(f);
+   trace = strndup(eina_file_map_all(f, EINA_FILE_SEQUENTIAL), size);
+   eina_file_close(f);
+
+   fail_if(strncmp(trace, "{\"traceEvents\":[", 16));
+   fail_if(!strstr(trace, "{\"name\":\"test_slice\",\"ph\":\"B\""));
+   fail_if(!strstr(trace, "\"detail\":\"a \\\"quoted\\\" detail\""));
+   fail_if(!strstr(trace, "{\"name\":\"test_counter\",\"ph\":\"C\""));
+   fail_if(!strstr(trace, "\"args\":{\"value\":42}"));
+   fail_if(!strstr(trace, "{\"name\":\"test_state\",\"ph\":\"b\",\"cat\":\"state\",\"id\":1"));
+   fail_if(!strstr(trace, "{\"name\":\"test_state\",\"ph\":\"e\",\"cat\":\"state\",\"id\":1"));
+   fail_if(!strstr(trace, "{\"name\":\"test_slice\",\"ph\":\"E\""));
+   free(trace);
+
+   unlink(json);
+   unlink(path);
+   free(json);
+   free(path);
+}
+EFL_END_TEST
+
+void
+eina_test_evlog(TCase *tc)
+{
+   tcase_add_test(tc, eina_test_evlog_merge_order);
+   tcase_add_test(tc, eina_test_evlog_stream_format);
+   tcase_add_test(tc, eina_test_evlog_stream_rotate);
+   tcase_add_test(tc, eina_test_evlog_convert);
+}
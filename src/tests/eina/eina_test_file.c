@@ -435,6 +435,63 @@ EFL_START_TEST(eina_file_map_new_test)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_test_file_map_prefetch)
+{
+   const unsigned long int length = 5 * 1024 * 1024 + 123;
+   unsigned long int i, page = eina_cpu_page_size();
+   Eina_Tmpstr *path;
+   Eina_File *f, *vf;
+   unsigned char *buf, *map, *part;
+   int fd;
+
+   buf = malloc(length);
+   fail_if(!buf);
+   for (i = 0; i < length; i++)
+     buf[i] = (unsigned char)(i * 7 + (i >> 12));
+
+   fd = eina_file_mkstemp("eina_file_prefetch_test_XXXXXX", &path);
+   fail_if(fd < 0);
+   fail_if(write(fd, buf, length) != (ssize_t)length);
+   close(fd);
+
+   f = eina_file_open(path, EINA_FALSE);
+   fail_if(!f);
+   map = eina_file_map_all(f, EINA_FILE_RANDOM);
+   fail_if(!map);
+
+   fail_if(eina_file_map_prefetch(f, map, 0, 0) != 0);
+   fail_if(eina_file_map_prefetch(f, map, page + 17, 3 * page) != 0);
+   fail_if(eina_file_map_prefetch(f, map, length - 10, length) != 0);
+   fail_if(eina_file_map_prefetch(f, map, length + 1, 10) != 0);
+   fail_if(eina_file_map_prefetch(f, buf, 0, 0) != EINVAL);
+   fail_if(memcmp(map, buf, length));
+   fail_if(eina_file_map_faulted(f, map));
+
+   part = eina_file_map_new(f, EINA_FILE_RANDOM, 2 * page, length - 4 * page);
+   fail_if(!part);
+   fail_if(eina_file_map_prefetch(f, part, 100, 0) != 0);
+   fail_if(memcmp(part, buf + 2 * page, length - 4 * page));
+   eina_file_map_free(f, part);
+   // the map is gone once its last user freed it
+   fail_if(eina_file_map_prefetch(f, part, 0, 0) != EINVAL);
+
+   eina_file_map_free(f, map);
+   fail_if(eina_file_map_prefetch(f, map, 0, 0) != EINVAL);
+   eina_file_close(f);
+
+   vf = eina_file_virtualize(NULL, buf, length, EINA_FALSE);
+   fail_if(!vf);
+   map = eina_file_map_all(vf, EINA_FILE_POPULATE);
+   fail_if(eina_file_map_prefetch(vf, map, 0, 0) != 0);
+   eina_file_map_free(vf, map);
+   eina_file_close(vf);
+
+   unlink(path);
+   eina_tmpstr_del(path);
+   free(buf);
+}
+EFL_END_TEST
+
 static const char *virtual_file_data = "this\n"
   "is a test for the sake of testing\r\n"
   "it should detect all the line of this\n"
@@ -865,6 +922,7 @@ eina_test_file(TCase *tc)
    tcase_add_test(tc, eina_file_direct_ls_simple);
    tcase_add_test(tc, eina_file_ls_simple);
    tcase_add_test(tc, eina_file_map_new_test);
+   tcase_add_test(tc, eina_test_file_map_prefetch);
    tcase_add_test(tc, eina_test_file_virtualize);
    tcase_add_test(tc, eina_test_file_thread);
    tcase_add_test(tc, eina_test_file_path);
@@ -387,6 +387,119 @@ EFL_START_TEST(eina_test_hash_seed)
 }
 EFL_END_TEST
 
+#ifndef WORDS_BIGENDIAN
+/* eina_hash_fast() of the first bytes of the test buffer under the seed
+ * below, one length in each of the ways keys are read; keys are read in
+ * the byte order of the cpu */
+static const struct {
+   int len;
+   unsigned int hash;
+} _eina_hash_fast_known[] = {
+   {    0, 0x94a7f6e2 },
+   {    1, 0xd84ea9d9 },
+   {    3, 0xc766e842 },
+   {    4, 0x6baeb824 },
+   {    8, 0xe2164686 },
+   {   15, 0xc2615d41 },
+   {   16, 0x8747cd35 },
+   {   17, 0x3eefff85 },
+   {   48, 0x7eb1dfca },
+   {   49, 0x6f39f0f5 },
+   {  100, 0x67fac7c0 },
+   {  256, 0xf57343cc },
+   {  257, 0x994673f1 },
+   { 1024, 0x5e505e0e },
+   { 1025, 0xe850d654 },
+   { 2200, 0x2c09cc2f },
+};
+#endif
+
+EFL_START_TEST(eina_test_hash_fast)
+{
+   Eina_Hash *hash;
+   char *buf, *copy, *key;
+   unsigned int i, seed, same = 0, flips = 0;
+#ifndef WORDS_BIGENDIAN
+   unsigned int known[EINA_C_ARRAY_LENGTH(_eina_hash_fast_known)];
+#endif
+   int len, h;
+
+   buf = malloc(4096);
+   copy = malloc(4096 + 8);
+   ck_assert_ptr_ne(buf, NULL);
+   ck_assert_ptr_ne(copy, NULL);
+   for (i = 0; i < 4096; i++)
+     buf[i] = (char)((i * 2654435761u) >> 13);
+
+   /* the seed is random, and stringshare hashes with it: it is only
+    * changed while nothing else is hashed */
+   seed = eina_seed;
+   eina_seed = 0x5eed;
+#ifndef WORDS_BIGENDIAN
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_eina_hash_fast_known); i++)
+     known[i] = eina_hash_fast(buf, _eina_hash_fast_known[i].len);
+#endif
+
+   /* every length around the short key, stripe and block sizes, from an
+    * unaligned copy and with one byte flipped at either end: a flip gives
+    * the same hash once in 2^32 times, so the whole batch may not give it
+    * more than once */
+   for (len = 0; len <= 2200; len++)
+     {
+        h = eina_hash_fast(buf, len);
+        memcpy(copy + 3, buf, len);
+        if (eina_hash_fast(copy + 3, len) != h) break;
+        if (len == 0) continue;
+
+        copy[3] ^= 1;
+        same += (eina_hash_fast(copy + 3, len) == h);
+        copy[3] ^= 1;
+        copy[3 + len - 1] ^= 0x80;
+        same += (eina_hash_fast(copy + 3, len) == h);
+        flips += 2;
+     }
+   same += (eina_hash_fast(buf, 16) == eina_hash_fast(buf, 17));
+   same += (eina_hash_fast(buf, 1024) == eina_hash_fast(buf, 1025));
+   eina_seed = seed;
+
+   ck_assert_int_eq(len, 2201);
+   ck_assert_int_eq(flips, 2 * 2200);
+   ck_assert_int_le(same, 1);
+#ifndef WORDS_BIGENDIAN
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_eina_hash_fast_known); i++)
+     ck_assert_int_eq(known[i], _eina_hash_fast_known[i].hash);
+#endif
+
+   /* long keys that only differ in the middle of a vector block */
+   hash = eina_hash_string_superfast_new(NULL);
+   fail_if(hash == NULL);
+   key = malloc(3001);
+   ck_assert_ptr_ne(key, NULL);
+   memset(key, 'k', 3000);
+   key[3000] = '\0';
+   for (i = 0; i < 64; i++)
+     {
+        key[1500] = 'A' + i;
+        fail_if(eina_hash_add(hash, key, copy + i) != EINA_TRUE);
+     }
+   fail_if(eina_hash_population(hash) != 64);
+   for (i = 0; i < 64; i++)
+     {
+        key[1500] = 'A' + i;
+        ck_assert_ptr_eq(eina_hash_find(hash, key), copy + i);
+        h = eina_hash_fast(key, 3001);
+        ck_assert_ptr_eq(eina_hash_find_by_hash(hash, key, 3001, h), copy + i);
+     }
+   key[1500] = '-';
+   ck_assert_ptr_eq(eina_hash_find(hash, key), NULL);
+
+   eina_hash_free(hash);
+   free(key);
+   free(copy);
+   free(buf);
+}
+EFL_END_TEST
+
 EFL_START_TEST(eina_test_hash_add_del_by_hash)
 {
    Eina_Hash *hash = NULL;
@@ -420,6 +533,120 @@ EFL_START_TEST(eina_test_hash_add_del_by_hash)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_test_hash_open_backend)
+{
+   Eina_Hash *hash = NULL;
+   Eina_Iterator *it;
+   Eina_Hash_Tuple *tuple;
+   int array[] = { 1, 42, 4, 5, 6 };
+   int key_len, key_hash;
+   int *test;
+   int i, count;
+
+   hash = eina_hash_backend_new(EINA_HASH_BACKEND_OPEN,
+                                EINA_KEY_LENGTH(_eina_string_key_length),
+                                EINA_KEY_CMP(_eina_string_key_cmp),
+                                EINA_KEY_HASH(eina_hash_superfast),
+                                NULL,
+                                EINA_HASH_BUCKET_SIZE);
+   fail_if(hash == NULL);
+   fail_if(eina_hash_backend_get(hash) != EINA_HASH_BACKEND_OPEN);
+
+   fail_if(eina_hash_add(hash, "1", &array[0]) != EINA_TRUE);
+   fail_if(eina_hash_add(hash, "42", &array[1]) != EINA_TRUE);
+   fail_if(eina_hash_direct_add(hash, "4", &array[2]) != EINA_TRUE);
+   fail_if(eina_hash_direct_add(hash, "5", &array[3]) != EINA_TRUE);
+
+   key_len = _eina_string_key_length("6");
+   key_hash = eina_hash_superfast("6", key_len);
+   fail_if(eina_hash_add_by_hash(hash, "6", key_len, key_hash, &array[4]) != EINA_TRUE);
+   test = eina_hash_find_by_hash(hash, "6", key_len, key_hash);
+   fail_if(!test || *test != 6);
+
+   test = eina_hash_find(hash, "42");
+   fail_if(!test || *test != 42);
+
+   eina_hash_foreach(hash, eina_foreach_check, NULL);
+
+   test = eina_hash_set(hash, "5", &array[0]);
+   fail_if(!test || *test != 5);
+   test = eina_hash_set(hash, "5", NULL);
+   fail_if(!test || *test != 1);
+   fail_if(eina_hash_find(hash, "5") != NULL);
+
+   fail_if(eina_hash_del(hash, NULL, &array[2]) != EINA_TRUE);
+   fail_if(eina_hash_find(hash, "4") != NULL);
+   fail_if(eina_hash_del(hash, NULL, &array[2]) != EINA_FALSE);
+
+   fail_if(eina_hash_del_by_hash(hash, "6", key_len, key_hash, &array[4]) != EINA_TRUE);
+   fail_if(eina_hash_population(hash) != 2);
+
+   /* Duplicated keys are kept, like with the rbtree buckets. */
+   fail_if(eina_hash_add(hash, "1", &array[3]) != EINA_TRUE);
+   fail_if(eina_hash_del(hash, "1", &array[3]) != EINA_TRUE);
+   test = eina_hash_find(hash, "1");
+   fail_if(!test || *test != 1);
+
+   /* Force a few resizes. */
+   for (i = 0; i < 1000; i++)
+     {
+        char buf[16];
+
+        eina_convert_itoa(i + 100, buf);
+        fail_if(eina_hash_add(hash, buf, &array[i % 5]) != EINA_TRUE);
+     }
+   fail_if(eina_hash_population(hash) != 1002);
+
+   count = 0;
+   it = eina_hash_iterator_tuple_new(hash);
+   EINA_ITERATOR_FOREACH(it, tuple)
+     {
+        fail_if(eina_hash_find(hash, tuple->key) == NULL);
+        count++;
+     }
+   eina_iterator_free(it);
+   fail_if(count != 1002);
+
+   for (i = 0; i < 1000; i++)
+     {
+        char buf[16];
+
+        eina_convert_itoa(i + 100, buf);
+        fail_if(eina_hash_del_by_key(hash, buf) != EINA_TRUE);
+     }
+   fail_if(eina_hash_population(hash) != 2);
+   test = eina_hash_find(hash, "42");
+   fail_if(!test || *test != 42);
+
+   eina_hash_free_buckets(hash);
+   fail_if(eina_hash_population(hash) != 0);
+   fail_if(eina_hash_find(hash, "42") != NULL);
+
+   eina_hash_free(hash);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_test_hash_backend_default)
+{
+   Eina_Hash_Backend backend;
+   Eina_Hash *hash;
+
+   backend = eina_hash_backend_default_get();
+
+   eina_hash_backend_default_set(EINA_HASH_BACKEND_OPEN);
+   hash = eina_hash_int32_new(NULL);
+   fail_if(eina_hash_backend_get(hash) != EINA_HASH_BACKEND_OPEN);
+   eina_hash_free(hash);
+
+   eina_hash_backend_default_set(EINA_HASH_BACKEND_RBTREE);
+   hash = eina_hash_int32_new(NULL);
+   fail_if(eina_hash_backend_get(hash) != EINA_HASH_BACKEND_RBTREE);
+   eina_hash_free(hash);
+
+   eina_hash_backend_default_set(backend);
+}
+EFL_END_TEST
+
 void
 eina_test_hash(TCase *tc)
 {
@@ -429,9 +656,12 @@ eina_test_hash(TCase *tc)
    tcase_add_test(tc, eina_test_hash_double_item);
    tcase_add_test(tc, eina_test_hash_all_int);
    tcase_add_test(tc, eina_test_hash_seed);
+   tcase_add_test(tc, eina_test_hash_fast);
    tcase_add_test(tc, eina_test_hash_int32_fuzze);
    tcase_add_test(tc, eina_test_hash_int64_fuzze);
    tcase_add_test(tc, eina_test_hash_string_fuzze);
    tcase_add_test(tc, eina_test_hash_add_del_by_hash);
+   tcase_add_test(tc, eina_test_hash_open_backend);
+   tcase_add_test(tc, eina_test_hash_backend_default);
 }
 
@@ -77,6 +77,94 @@ EFL_START_TEST(eina_mempool_chained_mempool)
 EFL_END_TEST
 #endif
 
+#ifdef EINA_BUILD_CHAINED_POOL
+EFL_START_TEST(eina_mempool_chained_magazine)
+{
+   Eina_Mempool *mp;
+
+   mp = eina_mempool_add("chained_magazine", "test", NULL, sizeof (int), 256);
+   _eina_mempool_test(mp, EINA_FALSE, EINA_FALSE, EINA_FALSE);
+}
+EFL_END_TEST
+
+static int *_magazine_tbl[1000];
+
+static void *
+_eina_mempool_magazine_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Eina_Mempool *mp = data;
+   int *tbl[1000];
+   int i, j;
+
+   for (j = 0; j < 50; j++)
+     {
+        for (i = 0; i < 1000; i++)
+          {
+             tbl[i] = eina_mempool_malloc(mp, sizeof (int));
+             if (!tbl[i]) return (void *)1;
+             *tbl[i] = i;
+          }
+        for (i = 0; i < 1000; i++)
+          {
+             if (*tbl[i] != i) return (void *)1;
+             eina_mempool_free(mp, tbl[i]);
+          }
+     }
+
+   return NULL;
+}
+
+static void *
+_eina_mempool_magazine_free_thread(void *data, Eina_Thread t EINA_UNUSED)
+{
+   Eina_Mempool *mp = data;
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_magazine_tbl); i++)
+     eina_mempool_free(mp, _magazine_tbl[i]);
+
+   return NULL;
+}
+
+EFL_START_TEST(eina_mempool_chained_magazine_threads)
+{
+   Eina_Thread threads[4];
+   Eina_Mempool *mp;
+   unsigned int i;
+
+   eina_threads_init();
+
+   mp = eina_mempool_add("chained_magazine", "test", NULL, sizeof (int), 256);
+   fail_if(!mp);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(threads); i++)
+     fail_if(!eina_thread_create(&threads[i], EINA_THREAD_NORMAL, -1,
+                                 _eina_mempool_magazine_thread, mp));
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(threads); i++)
+     fail_if(eina_thread_join(threads[i]) != NULL);
+
+   /* items allocated here are freed by another thread */
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_magazine_tbl); i++)
+     fail_if(!(_magazine_tbl[i] = eina_mempool_malloc(mp, sizeof (int))));
+
+   fail_if(!eina_thread_create(&threads[0], EINA_THREAD_NORMAL, -1,
+                               _eina_mempool_magazine_free_thread, mp));
+   fail_if(eina_thread_join(threads[0]) != NULL);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_magazine_tbl); i++)
+     fail_if(!(_magazine_tbl[i] = eina_mempool_malloc(mp, sizeof (int))));
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_magazine_tbl); i++)
+     eina_mempool_free(mp, _magazine_tbl[i]);
+
+   eina_mempool_gc(mp);
+   eina_mempool_del(mp);
+
+   eina_threads_shutdown();
+}
+EFL_END_TEST
+#endif
+
 #ifdef EINA_BUILD_PASS_THROUGH
 EFL_START_TEST(eina_mempool_pass_through)
 {
@@ -88,13 +176,119 @@ EFL_START_TEST(eina_mempool_pass_through)
 EFL_END_TEST
 #endif
 
+#ifdef EINA_BUILD_SLAB
+EFL_START_TEST(eina_mempool_slab)
+{
+   Eina_Mempool *mp;
+
+   mp = eina_mempool_add("slab", "test", NULL);
+   _eina_mempool_test(mp, EINA_TRUE, EINA_TRUE, EINA_TRUE);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_mempool_slab_sizes)
+{
+   static const unsigned int sizes[] = {
+      1, 16, 17, 100, 256, 257, 320, 1000, 4096, 8192, 8193, 100000
+   };
+   unsigned char *tbl[EINA_C_ARRAY_LENGTH(sizes)][64];
+   Eina_Mempool *mp;
+   unsigned int i, j;
+
+   mp = eina_mempool_add("slab", "test", NULL);
+   fail_if(!mp);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+     for (j = 0; j < 64; j++)
+       {
+          tbl[i][j] = eina_mempool_malloc(mp, sizes[i]);
+          fail_if(!tbl[i][j]);
+          fail_if(((uintptr_t)tbl[i][j]) % 8);
+          fail_if(!eina_mempool_from(mp, tbl[i][j]));
+          memset(tbl[i][j], i, sizes[i]);
+       }
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+     for (j = 0; j < 64; j++)
+       {
+          fail_if(tbl[i][j][0] != i);
+          fail_if(tbl[i][j][sizes[i] - 1] != i);
+       }
+
+   /* growing out of a class moves the data */
+   tbl[0][0] = eina_mempool_realloc(mp, tbl[0][0], 5000);
+   fail_if(!tbl[0][0]);
+   fail_if(tbl[0][0][0] != 0);
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+     for (j = 0; j < 64; j++)
+       {
+          eina_mempool_free(mp, tbl[i][j]);
+          fail_if(eina_mempool_from(mp, tbl[i][j]));
+       }
+
+   eina_mempool_gc(mp);
+   eina_mempool_del(mp);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_mempool_slab_gc)
+{
+   /* 4096 bytes items, so more than one arena worth of slabs */
+   unsigned char *tbl[1024];
+   Eina_Mempool *mp;
+   unsigned int i, round;
+
+   mp = eina_mempool_add("slab", "test", NULL);
+   fail_if(!mp);
+
+   /* slabs emptied then given back by gc have to be usable again */
+   for (round = 0; round < 3; round++)
+     {
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(tbl); i++)
+          {
+             tbl[i] = eina_mempool_malloc(mp, 4096);
+             fail_if(!tbl[i]);
+             memset(tbl[i], i & 0xff, 4096);
+          }
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(tbl); i++)
+          {
+             fail_if(tbl[i][0] != (i & 0xff));
+             fail_if(tbl[i][4095] != (i & 0xff));
+          }
+
+        /* keep a few in use so that some arenas stay mapped */
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(tbl); i++)
+          if (i % 256) eina_mempool_free(mp, tbl[i]);
+        eina_mempool_gc(mp);
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(tbl); i += 256)
+          {
+             fail_if(!eina_mempool_from(mp, tbl[i]));
+             fail_if(tbl[i][4095] != (i & 0xff));
+             eina_mempool_free(mp, tbl[i]);
+          }
+        eina_mempool_gc(mp);
+     }
+
+   eina_mempool_del(mp);
+}
+EFL_END_TEST
+#endif
+
 void
 eina_test_mempool(TCase *tc)
 {
 #ifdef EINA_BUILD_CHAINED_POOL
    tcase_add_test(tc, eina_mempool_chained_mempool);
+   tcase_add_test(tc, eina_mempool_chained_magazine);
+   tcase_add_test(tc, eina_mempool_chained_magazine_threads);
 #endif
 #ifdef EINA_BUILD_PASS_THROUGH
    tcase_add_test(tc, eina_mempool_pass_through);
 #endif
+#ifdef EINA_BUILD_SLAB
+   tcase_add_test(tc, eina_mempool_slab);
+   tcase_add_test(tc, eina_mempool_slab_sizes);
+   tcase_add_test(tc, eina_mempool_slab_gc);
+#endif
 }
@@ -0,0 +1,124 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+
+#include <Eina.h>
+
+#include "eina_suite.h"
+
+#define COUNT 2000
+
+static unsigned int seed = 42;
+
+static int
+_rand(int max)
+{
+   seed = seed * 1103515245 + 12345;
+   return (seed >> 8) % max;
+}
+
+static void
+_rect_random(Eina_Rectangle *r)
+{
+   EINA_RECTANGLE_SET(r, _rand(2000) - 100, _rand(2000) - 100,
+                      _rand(200), _rand(200));
+}
+
+/* the tree must find exactly what a walk over all the rectangles finds,
+ * in the same order, empty ones excluded */
+static void
+_check(Eina_Rtree *t, const Eina_Rectangle *rects, const Eina_Rectangle *target)
+{
+   Eina_Inarray *found;
+   unsigned int *id;
+   unsigned int i, n;
+
+   found = eina_inarray_new(sizeof (unsigned int), 0);
+   n = eina_rtree_collide(t, target, found);
+   ck_assert_int_eq(n, eina_inarray_count(found));
+
+   id = found->members;
+   for (i = 0; i < COUNT; i++)
+     {
+        if ((rects[i].w <= 0) || (rects[i].h <= 0)) continue;
+        if ((target->w <= 0) || (target->h <= 0)) continue;
+        if (!eina_rectangles_intersect(rects + i, target)) continue;
+        fail_if(!n);
+        ck_assert_int_eq(*id, i);
+        id++;
+        n--;
+     }
+   ck_assert_int_eq(n, 0);
+   eina_inarray_free(found);
+}
+
+EFL_START_TEST(eina_test_rtree_collide)
+{
+   Eina_Rectangle *rects, target;
+   Eina_Inarray *found;
+   void **data;
+   Eina_Rtree *t;
+   unsigned int i, j;
+
+   rects = malloc(COUNT * sizeof (Eina_Rectangle));
+   data = malloc(COUNT * sizeof (void *));
+   for (i = 0; i < COUNT; i++)
+     {
+        _rect_random(rects + i);
+        data[i] = rects + i;
+     }
+
+   t = eina_rtree_new();
+   fail_if(!t);
+
+   found = eina_inarray_new(sizeof (unsigned int), 0);
+   ck_assert_int_eq(eina_rtree_collide(t, &(Eina_Rectangle){ 0, 0, 10, 10 }, found), 0);
+   eina_inarray_free(found);
+
+   fail_if(!eina_rtree_load(t, rects, data, COUNT));
+   ck_assert_int_eq(eina_rtree_count(t), COUNT);
+   fail_if(eina_rtree_data_get(t, 10) != rects + 10);
+   fail_if(eina_rtree_data_get(t, COUNT));
+
+   for (i = 0; i < 200; i++)
+     {
+        EINA_RECTANGLE_SET(&target, _rand(2000) - 100, _rand(2000) - 100, 1, 1);
+        _check(t, rects, &target);
+        _rect_random(&target);
+        _check(t, rects, &target);
+     }
+
+   /* moves are refitted, then repacked when there are enough of them */
+   for (j = 0; j < 4; j++)
+     {
+        for (i = 0; i < COUNT / 10; i++)
+          {
+             unsigned int id = _rand(COUNT);
+
+             _rect_random(rects + id);
+             fail_if(!eina_rtree_update(t, id, rects + id));
+          }
+        for (i = 0; i < 100; i++)
+          {
+             EINA_RECTANGLE_SET(&target, _rand(2000) - 100, _rand(2000) - 100, 1, 1);
+             _check(t, rects, &target);
+          }
+     }
+   fail_if(eina_rtree_update(t, COUNT, rects));
+
+   fail_if(!eina_rtree_load(t, NULL, NULL, 0));
+   ck_assert_int_eq(eina_rtree_count(t), 0);
+
+   eina_rtree_free(t);
+   free(data);
+   free(rects);
+}
+EFL_END_TEST
+
+void
+eina_test_rtree(TCase *tc)
+{
+   tcase_add_test(tc, eina_test_rtree_collide);
+}
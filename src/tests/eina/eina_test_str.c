@@ -114,6 +114,13 @@ EFL_START_TEST(str_simple)
    free(str);
    free(ret);
 
+   /* long runs without anything to escape */
+   ret = eina_str_escape("abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-=\n"
+                         "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ\"");
+   fail_if(!eina_streq(ret, "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-=\\n"
+                            "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ\\\""));
+   free(ret);
+
 }
 EFL_END_TEST
 
@@ -307,6 +307,57 @@ EFL_START_TEST(eina_test_strbuf_replace)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_test_strbuf_replace_long)
+{
+   Eina_Strbuf *buf;
+   const char *text = "the quick brown fox jumps over the lazy dog, the end";
+   char *ro;
+   int i;
+
+   buf = eina_strbuf_new();
+   fail_if(!buf);
+
+   for (i = 0; i < 20; i++)
+     eina_strbuf_append(buf, text);
+
+   fail_if(eina_strbuf_replace_all(buf, "the", "a") != 60);
+   fail_if(strlen(eina_strbuf_string_get(buf)) != eina_strbuf_length_get(buf));
+   fail_if(eina_strbuf_length_get(buf) != 20 * (strlen(text) - 6));
+   fail_if(strncmp(eina_strbuf_string_get(buf), "a quick brown fox jumps over a lazy dog, a enda quick", 53));
+
+   fail_if(eina_strbuf_replace_all(buf, "fox", "cat") != 20);
+   fail_if(strstr(eina_strbuf_string_get(buf), "fox"));
+
+   /* matches may overlap when counting with replace() */
+   eina_strbuf_reset(buf);
+   eina_strbuf_append(buf, "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx.xx");
+   fail_if(!eina_strbuf_replace(buf, "xx", "y", 54));
+   fail_if(strcmp(eina_strbuf_string_get(buf), "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx.y"));
+   fail_if(eina_strbuf_replace(buf, "xx", "y", 54));
+
+   /* an empty pattern matches nothing */
+   fail_if(eina_strbuf_replace_all(buf, "", "z") != 0);
+
+   eina_strbuf_free(buf);
+
+   /* read only buffers are copied before the change */
+   ro = strdup("one two one two one two one two one two one two one two");
+   buf = eina_strbuf_manage_read_only_new_length(ro, strlen(ro));
+   fail_if(!buf);
+   fail_if(eina_strbuf_replace_all(buf, "two", "three") != 7);
+   fail_if(strcmp(eina_strbuf_string_get(buf), "one three one three one three one three one three one three one three"));
+   fail_if(strcmp(ro, "one two one two one two one two one two one two one two"));
+   eina_strbuf_free(buf);
+
+   buf = eina_strbuf_manage_read_only_new_length(ro, strlen(ro));
+   fail_if(!eina_strbuf_replace(buf, "two", "six", 7));
+   fail_if(strcmp(eina_strbuf_string_get(buf), "one two one two one two one two one two one two one six"));
+   fail_if(strcmp(ro, "one two one two one two one two one two one two one two"));
+   eina_strbuf_free(buf);
+   free(ro);
+}
+EFL_END_TEST
+
 EFL_START_TEST(eina_test_strbuf_realloc)
 {
    Eina_Strbuf *buf;
@@ -650,6 +701,7 @@ eina_test_strbuf(TCase *tc)
    tcase_add_test(tc, eina_test_strbuf_append);
    tcase_add_test(tc, eina_test_strbuf_insert);
    tcase_add_test(tc, eina_test_strbuf_replace);
+   tcase_add_test(tc, eina_test_strbuf_replace_long);
    tcase_add_test(tc, eina_test_strbuf_realloc);
    tcase_add_test(tc, eina_test_strbuf_append_realloc);
    tcase_add_test(tc, eina_test_strbuf_prepend_realloc);
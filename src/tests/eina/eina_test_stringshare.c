@@ -32,6 +32,31 @@ my_vprintf(const char *fmt, ...)
    return ret;
 }
 
+static void *
+_stringshare_thread(void *data EINA_UNUSED, Eina_Thread t EINA_UNUSED)
+{
+   const char *held[100] = { NULL };
+   int i, j;
+
+   for (j = 0; j < 100; j++)
+     for (i = 0; i < 100; i++)
+       {
+          char build[64] = "thread_string_";
+
+          eina_convert_itoa((i * 7 + j) % 150, build + 14);
+          eina_stringshare_del(held[i]);
+          held[i] = eina_stringshare_add(build);
+          if (!held[i] || strcmp(held[i], build)) return (void *)1;
+          if (held[i] != eina_stringshare_ref(held[i])) return (void *)1;
+          eina_stringshare_del(held[i]);
+       }
+
+   for (i = 0; i < 100; i++)
+     eina_stringshare_del(held[i]);
+
+   return NULL;
+}
+
 #endif
 
 EINA_TEST_START(eina_stringshare_simple)
@@ -240,3 +265,61 @@ EINA_TEST_START(eina_stringshare_print)
    eina_stringshare_del(t3);
 }
 EINA_TEST_END
+
+EINA_TEST_START(eina_stringshare_threads)
+{
+   Eina_Thread threads[4];
+   const char *t0, *t1;
+   void *ret;
+   unsigned int i;
+
+   eina_threads_init();
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(threads); i++)
+     fail_if(!eina_thread_create(&threads[i], EINA_THREAD_NORMAL, -1,
+                                 _stringshare_thread, NULL));
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(threads); i++)
+     {
+        ret = eina_thread_join(threads[i]);
+        fail_if(ret != NULL);
+     }
+
+   t0 = eina_stringshare_add("thread_string_42");
+   t1 = eina_stringshare_add("thread_string_42");
+   fail_if(t0 != t1);
+   eina_stringshare_del(t0);
+   eina_stringshare_del(t1);
+
+   eina_threads_shutdown();
+}
+EINA_TEST_END
+
+EINA_TEST_START(eina_stringshare_thread_cache)
+{
+   const char *t0, *t1;
+   char build[64];
+   int i;
+
+   eina_threads_init();
+
+   for (i = 0; i < 100; i++)
+     {
+        /* freed on del, the thread cache holding no reference */
+        t0 = eina_stringshare_add("thread_cache");
+        eina_stringshare_del(t0);
+
+        strcpy(build, "thread_cache_");
+        eina_convert_itoa(i, build + 13);
+        t1 = eina_stringshare_add(build);
+
+        t0 = eina_stringshare_add("thread_cache");
+        fail_if(!t0 || strcmp(t0, "thread_cache"));
+        fail_if(t0 != eina_stringshare_add("thread_cache"));
+        eina_stringshare_del(t0);
+        eina_stringshare_del(t0);
+        eina_stringshare_del(t1);
+     }
+
+   eina_threads_shutdown();
+}
+EINA_TEST_END
@@ -373,6 +373,172 @@ EFL_START_TEST(eina_test_tiler_size)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_test_tiler_bitmask)
+{
+   Eina_Tiler *t;
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+   int i;
+
+   t = eina_tiler_new(640, 480);
+   fail_if(!t);
+   eina_tiler_tile_size_set(t, 16, 16);
+   ck_assert_int_eq(eina_tiler_mode_get(t), EINA_TILER_MODE_SPLIT);
+   eina_tiler_mode_set(t, EINA_TILER_MODE_BITMASK);
+   ck_assert_int_eq(eina_tiler_mode_get(t), EINA_TILER_MODE_BITMASK);
+   fail_if(!eina_tiler_empty(t));
+   fail_if(eina_tiler_iterator_new(t));
+
+   /* rounded out to the tiles */
+   fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){ 20, 20, 10, 30 }));
+   fail_if(eina_tiler_empty(t));
+   i = 0;
+   it = eina_tiler_iterator_new(t);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        ck_assert_int_eq(rp->x, 16);
+        ck_assert_int_eq(rp->y, 16);
+        ck_assert_int_eq(rp->w, 16);
+        ck_assert_int_eq(rp->h, 48);
+        i++;
+     }
+   eina_iterator_free(it);
+   ck_assert_int_eq(i, 1);
+
+   /* two runs on the same rows, joined with a gap */
+   fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){ 64, 16, 16, 48 }));
+   i = 0;
+   it = eina_tiler_iterator_new(t);
+   EINA_ITERATOR_FOREACH(it, rp) i++;
+   eina_iterator_free(it);
+   ck_assert_int_eq(i, 2);
+
+   eina_tiler_merge_gap_set(t, 2);
+   i = 0;
+   it = eina_tiler_iterator_new(t);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        ck_assert_int_eq(rp->x, 16);
+        ck_assert_int_eq(rp->w, 64);
+        i++;
+     }
+   eina_iterator_free(it);
+   ck_assert_int_eq(i, 1);
+   eina_tiler_merge_gap_set(t, 0);
+
+   /* only fully covered tiles are removed */
+   eina_tiler_rect_del(t, &(Eina_Rectangle){ 20, 0, 10, 480 });
+   fail_if(eina_tiler_empty(t));
+   eina_tiler_rect_del(t, &(Eina_Rectangle){ 16, 0, 16, 480 });
+   i = 0;
+   it = eina_tiler_iterator_new(t);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        ck_assert_int_eq(rp->x, 64);
+        i++;
+     }
+   eina_iterator_free(it);
+   ck_assert_int_eq(i, 1);
+
+   /* the partial tiles on the edges are clipped to the area */
+   eina_tiler_clear(t);
+   fail_if(!eina_tiler_empty(t));
+   eina_tiler_area_size_set(t, 630, 470);
+   fail_if(!eina_tiler_rect_add(t, &(Eina_Rectangle){ 0, 0, 1000, 1000 }));
+   i = 0;
+   it = eina_tiler_iterator_new(t);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        ck_assert_int_eq(rp->x, 0);
+        ck_assert_int_eq(rp->y, 0);
+        ck_assert_int_eq(rp->w, 630);
+        ck_assert_int_eq(rp->h, 470);
+        i++;
+     }
+   eina_iterator_free(it);
+   ck_assert_int_eq(i, 1);
+   eina_tiler_rect_del(t, &(Eina_Rectangle){ 0, 464, 630, 6 });
+   it = eina_tiler_iterator_new(t);
+   EINA_ITERATOR_FOREACH(it, rp)
+     ck_assert_int_eq(rp->h, 464);
+   eina_iterator_free(it);
+
+   /* back to the splitter, keeping the content */
+   eina_tiler_mode_set(t, EINA_TILER_MODE_SPLIT);
+   ck_assert_int_eq(eina_tiler_mode_get(t), EINA_TILER_MODE_SPLIT);
+   i = 0;
+   it = eina_tiler_iterator_new(t);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        fail_if(rp->x || rp->y);
+        fail_if(rp->x + rp->w < 630);
+        fail_if(rp->y + rp->h < 464);
+        i++;
+     }
+   eina_iterator_free(it);
+   fail_if(!i);
+
+   eina_tiler_free(t);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_test_tiler_bitmask_calculation)
+{
+   Eina_Tiler *t1, *t2, *t;
+   Eina_Iterator *it;
+   Eina_Rectangle *rp;
+   Eina_Rectangle r1 = { 0, 0, 500, 500 }, r2 = { 100, 100, 300, 300 };
+   int i;
+
+   t1 = eina_tiler_new(500, 500);
+   t2 = eina_tiler_new(500, 500);
+   fail_if((!t1) || (!t2));
+   eina_tiler_tile_size_set(t1, 4, 4);
+   eina_tiler_tile_size_set(t2, 4, 4);
+   eina_tiler_mode_set(t1, EINA_TILER_MODE_BITMASK);
+   eina_tiler_mode_set(t2, EINA_TILER_MODE_BITMASK);
+
+   eina_tiler_rect_add(t2, &r2);
+   fail_if(!eina_tiler_union(t1, t2));
+   fail_if(!eina_tiler_equal(t1, t2));
+
+   eina_tiler_rect_add(t1, &r1);
+   fail_if(eina_tiler_equal(t1, t2));
+   fail_if(!eina_tiler_subtract(t1, t2));
+   i = 0;
+   it = eina_tiler_iterator_new(t1);
+   EINA_ITERATOR_FOREACH(it, rp)
+     {
+        fail_if(eina_rectangles_intersect(&r2, rp));
+        i++;
+     }
+   eina_iterator_free(it);
+   ck_assert_int_eq(i, 4);
+
+   t = eina_tiler_intersection(t1, t2);
+   fail_if(t);
+
+   eina_tiler_rect_add(t1, &r1);
+   t = eina_tiler_intersection(t1, t2);
+   fail_if(!t);
+   ck_assert_int_eq(eina_tiler_mode_get(t), EINA_TILER_MODE_BITMASK);
+   fail_if(!eina_tiler_equal(t, t2));
+   eina_tiler_free(t);
+
+   /* mixed modes go through the rectangles */
+   t = eina_tiler_new(500, 500);
+   eina_tiler_tile_size_set(t, 1, 1);
+   eina_tiler_rect_add(t, &r2);
+   eina_tiler_clear(t1);
+   fail_if(!eina_tiler_union(t1, t));
+   fail_if(!eina_tiler_equal(t1, t2));
+   eina_tiler_free(t);
+
+   eina_tiler_free(t1);
+   eina_tiler_free(t2);
+}
+EFL_END_TEST
+
 void
 eina_test_tiler(TCase *tc)
 {
@@ -381,4 +547,6 @@ eina_test_tiler(TCase *tc)
    tcase_add_test(tc, eina_test_tiler_stable);
    tcase_add_test(tc, eina_test_tiler_calculation);
    tcase_add_test(tc, eina_test_tiler_size);
+   tcase_add_test(tc, eina_test_tiler_bitmask);
+   tcase_add_test(tc, eina_test_tiler_bitmask_calculation);
 }
@@ -599,6 +599,42 @@ EFL_START_TEST(eina_unicode_utf8_conversion)
 }
 EFL_END_TEST
 
+/* long enough strings to go through the vector paths, with the interesting
+ * bytes moved across the 16 and 32 bytes block boundaries */
+EFL_START_TEST(eina_unicode_utf8_long)
+{
+   static const char *seqs[] = {
+      "a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", /* valid */
+      "\x80", "\xC3", "\xE2\x82", "\xED\xA0\x80", "\xE0\x80\xAF",
+      "\xF4\x90\x80\x80", "\xFF"
+   };
+   char buf[160];
+   Eina_Unicode *uni;
+   unsigned int s, pos, i;
+   int ind, len, count;
+
+   for (s = 0; s < EINA_C_ARRAY_LENGTH(seqs); s++)
+     for (pos = 0; pos < 100; pos++)
+       {
+          memset(buf, 'x', pos);
+          strcpy(buf + pos, seqs[s]);
+          strcat(buf, "0123456789abcdefghijklmnopqrstuvwxyz.!");
+
+          /* what next_get makes of it, invalid bytes included */
+          for (ind = 0, count = 0; eina_unicode_utf8_next_get(buf, &ind); count++) ;
+          ck_assert_int_eq(eina_unicode_utf8_get_len(buf), count);
+
+          uni = eina_unicode_utf8_to_unicode(buf, &len);
+          fail_if(!uni);
+          ck_assert_int_eq(len, count);
+          for (ind = 0, i = 0; i < (unsigned int)len; i++)
+            ck_assert_int_eq(uni[i], eina_unicode_utf8_next_get(buf, &ind));
+          ck_assert_int_eq(uni[len], 0);
+          free(uni);
+       }
+}
+EFL_END_TEST
+
 void
 eina_test_ustr(TCase *tc)
 {
@@ -613,5 +649,6 @@ eina_test_ustr(TCase *tc)
    tcase_add_test(tc, eina_unicode_escape_test);
    tcase_add_test(tc,eina_unicode_utf8);
    tcase_add_test(tc,eina_unicode_utf8_conversion);
+   tcase_add_test(tc,eina_unicode_utf8_long);
 
 }
@@ -3010,6 +3010,111 @@ EFL_START_TEST(eina_value_test_value_string)
 }
 EFL_END_TEST
 
+EFL_START_TEST(eina_value_test_move)
+{
+   Eina_Value a, b = EINA_VALUE_EMPTY, c;
+   Eina_Value *arr, *dup;
+   const char *msg = "A string long enough not to fit inline", *str;
+   char *cstr;
+   int i;
+
+   fail_if(!eina_value_setup(&a, EINA_VALUE_TYPE_STRING));
+   fail_if(!eina_value_set(&a, msg));
+   fail_if(!eina_value_get(&a, &str));
+   cstr = (char *)str;
+
+   /* the string itself changes hands, it is not duplicated */
+   fail_if(!eina_value_move(&b, &a));
+   fail_if(a.type != NULL);
+   fail_if(b.type != EINA_VALUE_TYPE_STRING);
+   fail_if(!eina_value_get(&b, &str));
+   fail_if(str != cstr);
+
+   /* moving over a value flushes it */
+   fail_if(!eina_value_setup(&a, EINA_VALUE_TYPE_STRING));
+   fail_if(!eina_value_set(&a, "other"));
+   fail_if(!eina_value_move(&a, &b));
+   fail_if(!eina_value_get(&a, &str));
+   fail_if(str != cstr);
+   fail_if(!eina_value_move(&a, &a));
+
+   c = eina_value_steal(&a);
+   fail_if(a.type != NULL);
+   fail_if(!eina_value_get(&c, &str));
+   fail_if(str != cstr);
+   eina_value_flush(&c);
+
+   /* values bigger than the inline storage */
+   arr = eina_value_array_new(EINA_VALUE_TYPE_INT, 0);
+   fail_if(!arr);
+   fail_if(!eina_value_array_append(arr, 42));
+   c = eina_value_steal(arr);
+   fail_if(!eina_value_array_get(&c, 0, &i));
+   fail_if(i != 42);
+   eina_value_free(arr);
+
+   /* copies of containers set their storage up once */
+   dup = eina_value_dup(&c);
+   fail_if(!dup);
+   fail_if(eina_value_compare(dup, &c));
+   eina_value_free(dup);
+   b = eina_value_reference_copy(&c);
+   fail_if(eina_value_compare(&b, &c));
+   eina_value_flush(&b);
+   eina_value_flush(&c);
+}
+EFL_END_TEST
+
+EFL_START_TEST(eina_value_test_array_append_steal)
+{
+   Eina_Value *outer, *inner, *values, v;
+   Eina_Value_Array desc;
+   const char *str, *got;
+   int i;
+
+   outer = eina_value_array_new(EINA_VALUE_TYPE_ARRAY, 0);
+   fail_if(!outer);
+
+   for (i = 0; i < 3; i++)
+     {
+        inner = eina_value_array_new(EINA_VALUE_TYPE_INT, 0);
+        fail_if(!inner);
+        fail_if(!eina_value_array_append(inner, i));
+        fail_if(!eina_value_array_append(inner, i * 10));
+        fail_if(!eina_value_array_append_steal(outer, inner));
+        fail_if(inner->type != NULL);
+        eina_value_free(inner);
+     }
+   fail_if(eina_value_array_count(outer) != 3);
+
+   fail_if(!eina_value_array_get(outer, 2, &desc));
+   fail_if(eina_inarray_count(desc.array) != 2);
+   fail_if(*(int *)eina_inarray_nth(desc.array, 1) != 20);
+
+   /* only the array subtype can be stolen in */
+   fail_if(!eina_value_setup(&v, EINA_VALUE_TYPE_INT));
+   fail_if(eina_value_array_append_steal(outer, &v));
+   fail_if(v.type != EINA_VALUE_TYPE_INT);
+   fail_if(eina_value_array_count(outer) != 3);
+
+   /* while an array of values takes anything */
+   values = eina_value_array_new(EINA_VALUE_TYPE_VALUE, 0);
+   fail_if(!values);
+   fail_if(!eina_value_array_append_steal(values, &v));
+   fail_if(!eina_value_setup(&v, EINA_VALUE_TYPE_STRING));
+   fail_if(!eina_value_set(&v, "kept as is"));
+   fail_if(!eina_value_get(&v, &str));
+   fail_if(!eina_value_array_append_steal(values, &v));
+   fail_if(v.type != NULL);
+   fail_if(!eina_value_pget(values, &desc));
+   fail_if(!eina_value_get(eina_inarray_nth(desc.array, 1), &got));
+   fail_if(got != str);
+
+   eina_value_free(values);
+   eina_value_free(outer);
+}
+EFL_END_TEST
+
 void
 eina_test_value(TCase *tc)
 {
@@ -3041,4 +3146,6 @@ eina_test_value(TCase *tc)
    tcase_add_test(tc, eina_value_test_optional_struct_members);
    tcase_add_test(tc, eina_value_test_value);
    tcase_add_test(tc, eina_value_test_value_string);
+   tcase_add_test(tc, eina_value_test_move);
+   tcase_add_test(tc, eina_value_test_array_append_steal);
 }
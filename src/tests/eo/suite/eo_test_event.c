@@ -186,11 +186,93 @@ EFL_START_TEST(eo_event_generation_bug)
 EFL_END_TEST
 
 
+static char _indexed_order[32];
+
+static void
+_indexed_record(void *data, const Efl_Event *e EINA_UNUSED)
+{
+   size_t len = strlen(_indexed_order);
+
+   if (len + 1 < sizeof (_indexed_order))
+     _indexed_order[len] = (char)(uintptr_t) data;
+}
+
+static void
+_indexed_filler(void *data EINA_UNUSED, const Efl_Event *e EINA_UNUSED)
+{
+   ck_abort_msg("callback called for another event");
+}
+
+static void
+_indexed_edit(void *data, const Efl_Event *e)
+{
+   _indexed_record(data, e);
+   // Neither of these must change the current emission
+   efl_event_callback_del(e->object, EFL_TEST_EVENT_EVENT_TESTER, _indexed_record, (void *) 'd');
+   efl_event_callback_add(e->object, EFL_TEST_EVENT_EVENT_TESTER, _indexed_record, (void *) 'n');
+}
+
+EFL_CALLBACKS_ARRAY_DEFINE(_indexed_array,
+                           { EFL_TEST_EVENT_EVENT_TESTER, _indexed_record },
+                           { EFL_TEST_EVENT_EVENT_TESTER_CLAMP_TEST, _indexed_record });
+
+EFL_START_TEST(eo_event_indexed)
+{
+   Eo *obj;
+   uintptr_t i;
+
+   obj = efl_add_ref(efl_test_event_class_get(), NULL);
+
+   // Enough listeners of other events for the object to index them
+   for (i = 0; i < 16; i++)
+     efl_event_callback_priority_add(obj, EFL_TEST_EVENT_EVENT_TESTER_SUBSCRIBE,
+                                     (int) i - 8, _indexed_filler, (void *) i);
+
+   efl_event_callback_add(obj, EFL_TEST_EVENT_EVENT_TESTER, _indexed_record, (void *) 'c');
+   efl_event_callback_priority_add(obj, EFL_TEST_EVENT_EVENT_TESTER, EFL_CALLBACK_PRIORITY_AFTER, _indexed_record, (void *) 'd');
+   efl_event_callback_priority_add(obj, EFL_TEST_EVENT_EVENT_TESTER, EFL_CALLBACK_PRIORITY_BEFORE, _indexed_record, (void *) 'a');
+   efl_event_callback_add(obj, EFL_TEST_EVENT_EVENT_TESTER, _indexed_edit, (void *) 'b');
+   efl_event_callback_array_priority_add(obj, _indexed_array(), EFL_CALLBACK_PRIORITY_AFTER, (void *) 'e');
+
+   // Same priority runs the newest first, deletion and addition are deferred
+   memset(_indexed_order, 0, sizeof (_indexed_order));
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER, NULL);
+   ck_assert_str_eq(_indexed_order, "abce");
+
+   memset(_indexed_order, 0, sizeof (_indexed_order));
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER, NULL);
+   ck_assert_str_eq(_indexed_order, "anbce");
+
+   memset(_indexed_order, 0, sizeof (_indexed_order));
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER_CLAMP_TEST, NULL);
+   ck_assert_str_eq(_indexed_order, "e");
+
+   memset(_indexed_order, 0, sizeof (_indexed_order));
+   fail_if(!efl_event_callback_array_del(obj, _indexed_array(), (void *) 'e'));
+   fail_if(efl_event_callback_array_del(obj, _indexed_array(), (void *) 'e'));
+   fail_if(!efl_event_callback_del(obj, EFL_TEST_EVENT_EVENT_TESTER_SUBSCRIBE, _indexed_filler, (void *) 3));
+   fail_if(efl_event_callback_del(obj, EFL_TEST_EVENT_EVENT_TESTER_SUBSCRIBE, _indexed_filler, (void *) 3));
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER_CLAMP_TEST, NULL);
+   ck_assert_str_eq(_indexed_order, "");
+
+   // Back to a small object, without an index
+   for (i = 0; i < 16; i++)
+     efl_event_callback_del(obj, EFL_TEST_EVENT_EVENT_TESTER_SUBSCRIBE, _indexed_filler, (void *) i);
+   efl_event_callback_del(obj, EFL_TEST_EVENT_EVENT_TESTER, _indexed_edit, (void *) 'b');
+   memset(_indexed_order, 0, sizeof (_indexed_order));
+   efl_event_callback_call(obj, EFL_TEST_EVENT_EVENT_TESTER, NULL);
+   ck_assert_str_eq(_indexed_order, "annc");
+
+   efl_unref(obj);
+}
+EFL_END_TEST
+
 void eo_test_event(TCase *tc)
 {
    tcase_add_test(tc, eo_event);
    tcase_add_test(tc, eo_event_call_in_call);
    tcase_add_test(tc, eo_event_generation_bug);
+   tcase_add_test(tc, eo_event_indexed);
 }
 
 
@@ -1252,6 +1252,119 @@ EFL_START_TEST(efl_add_failures)
 }
 EFL_END_TEST
 
+static void
+_add_batch_init(void *data, Eo *obj, unsigned int index)
+{
+   unsigned int *calls = data;
+
+   simple_a_set(obj, index);
+   (*calls)++;
+}
+
+EFL_START_TEST(efl_add_batch_tests)
+{
+   static const Efl_Class_Description class_desc = {
+        EO_VERSION,
+        "Batch_Failures",
+        EFL_CLASS_TYPE_REGULAR,
+        0,
+        _add_failures_class_initializer,
+        NULL,
+        NULL
+   };
+   Eo *objs[100], *again[100];
+   Eo *parent, *obj;
+   unsigned int i, j, calls = 0;
+
+   parent = efl_add_ref(SIMPLE_CLASS, NULL);
+   ck_assert_int_eq(efl_add_batch(SIMPLE_CLASS, parent, objs, 100,
+                                  _add_batch_init, &calls), 100);
+   ck_assert_int_eq(calls, 100);
+   for (i = 0; i < 100; i++)
+     {
+        ck_assert_ptr_ne(objs[i], NULL);
+        ck_assert_ptr_eq(efl_parent_get(objs[i]), parent);
+        ck_assert_int_eq(efl_ref_count(objs[i]), 1);
+        ck_assert_int_eq(simple_a_get(objs[i]), i);
+        fail_if(!efl_finalized_get(objs[i]));
+        for (j = 0; j < i; j++)
+          ck_assert_ptr_ne(objs[i], objs[j]);
+     }
+   efl_del_batch(objs, 100);
+   ck_assert_ptr_eq(efl_children_iterator_new(parent), NULL);
+
+   /* The objects reuse the memory of the deleted ones */
+   ck_assert_int_eq(efl_add_batch_ref(SIMPLE_CLASS, NULL, again, 100, NULL, NULL), 100);
+   for (i = 0; i < 100; i++)
+     {
+        ck_assert_int_eq(efl_ref_count(again[i]), 1);
+        ck_assert_ptr_eq(efl_parent_get(again[i]), NULL);
+        ck_assert_int_eq(simple_a_get(again[i]), 0);
+     }
+   efl_unref_batch(again, 100);
+
+   obj = efl_add_ref(SIMPLE_CLASS, NULL);
+   ck_assert_int_eq(simple_a_get(obj), 0);
+   efl_unref(obj);
+   efl_unref(parent);
+
+   /* Construction failures leave holes */
+   const Efl_Class *klass = efl_class_new(&class_desc, EO_CLASS, NULL);
+   ck_assert_int_eq(efl_add_batch_ref(klass, NULL, objs, 10, NULL, NULL), 0);
+   for (i = 0; i < 10; i++)
+     ck_assert_ptr_eq(objs[i], NULL);
+}
+EFL_END_TEST
+
+static void
+_profiler_a_changed(void *data, const Efl_Event *ev EINA_UNUSED)
+{
+   (*(int *) data)++;
+}
+
+EFL_START_TEST(efl_object_profiler_tests)
+{
+   Eo *obj;
+   char *report, *line;
+   unsigned int calls, created, freed;
+   int i, called = 0;
+
+   efl_object_profiler_reset();
+   efl_object_profiler_start(1);
+   obj = efl_add_ref(SIMPLE_CLASS, NULL);
+   efl_event_callback_add(obj, EV_A_CHANGED, _profiler_a_changed, &called);
+   for (i = 0; i < 10; i++)
+     simple_a_set(obj, i);
+   efl_unref(obj);
+   efl_object_profiler_stop();
+   ck_assert_int_eq(called, 10);
+
+   /* Nothing is counted once stopped */
+   obj = efl_add_ref(SIMPLE_CLASS, NULL);
+   simple_a_set(obj, 1);
+   efl_unref(obj);
+
+   report = efl_object_profiler_report_get();
+   ck_assert_ptr_ne(report, NULL);
+   /* The name of simple_a_set() depends on the symbols of the test binary */
+   ck_assert_ptr_ne(strstr(report, "\tSimple\t10\t10\t"), NULL);
+   ck_assert_ptr_ne(strstr(report, "\nevent\ta,changed\t10\t10\n"), NULL);
+   line = strstr(report, "\nclass\tSimple\t");
+   ck_assert_ptr_ne(line, NULL);
+   ck_assert_int_eq(sscanf(line, "\nclass\tSimple\t%u\t%u\t%u", &calls, &created, &freed), 3);
+   ck_assert_int_ge(calls, 10);
+   ck_assert_int_eq(created, 1);
+   ck_assert_int_eq(freed, 1);
+   ck_assert_ptr_ne(strstr(report, "\nlifetime\tSimple\t"), NULL);
+   free(report);
+
+   efl_object_profiler_reset();
+   report = efl_object_profiler_report_get();
+   ck_assert_ptr_eq(strstr(report, "\tSimple\t"), NULL);
+   free(report);
+}
+EFL_END_TEST
+
 static Eina_Bool intercepted = EINA_FALSE;
 
 static void
@@ -1733,6 +1846,124 @@ static void _destruct_test_destruct_cb(void *data, const Efl_Event *ev)
    //ck_assert_int_ne(efl_destructed_is(ev->object), 0);
 }
 
+typedef struct
+{
+   int v;
+} Cache_Data;
+
+EFL_FUNC_BODY(cache_value, int, 0);
+EFL_VOID_FUNC_BODYV(cache_value_set, EFL_FUNC_CALL(v), int v);
+
+static int
+_cache_value_1(Eo *obj EINA_UNUSED, void *pd)
+{
+   Cache_Data *d = pd;
+
+   return d->v;
+}
+
+static int
+_cache_value_2(Eo *obj, void *pd)
+{
+   Cache_Data *d = pd;
+
+   return d->v * 100 + cache_value(efl_super(obj, efl_class_get(obj)));
+}
+
+static void
+_cache_value_set(Eo *obj EINA_UNUSED, void *pd, int v)
+{
+   Cache_Data *d = pd;
+
+   d->v = v;
+}
+
+static Eina_Bool
+_call_cache_class_initializer_1(Efl_Class *klass)
+{
+   EFL_OPS_DEFINE(ops,
+                  EFL_OBJECT_OP_FUNC(cache_value, _cache_value_1),
+                  EFL_OBJECT_OP_FUNC(cache_value_set, _cache_value_set), );
+   return efl_class_functions_set(klass, &ops, NULL);
+}
+
+static Eina_Bool
+_call_cache_class_initializer_2(Efl_Class *klass)
+{
+   EFL_OPS_DEFINE(ops,
+                  EFL_OBJECT_OP_FUNC(cache_value, _cache_value_2),
+                  EFL_OBJECT_OP_FUNC(cache_value_set, _cache_value_set), );
+   return efl_class_functions_set(klass, &ops, NULL);
+}
+
+EFL_START_TEST(efl_call_cache)
+{
+   static const Efl_Class_Description class_desc_1 = {
+        EO_VERSION,
+        "CallCacheBase",
+        EFL_CLASS_TYPE_REGULAR,
+        sizeof(Cache_Data),
+        _call_cache_class_initializer_1,
+        NULL,
+        NULL
+   };
+
+   static const Efl_Class_Description class_desc_2 = {
+        EO_VERSION,
+        "CallCacheDerived",
+        EFL_CLASS_TYPE_REGULAR,
+        sizeof(Cache_Data),
+        _call_cache_class_initializer_2,
+        NULL,
+        NULL
+   };
+   const Efl_Class *klass1, *klass2;
+   Eo *obj1, *obj2, *obj3;
+   int i;
+
+   klass1 = efl_class_new(&class_desc_1, EO_CLASS, NULL);
+   fail_if(!klass1);
+   klass2 = efl_class_new(&class_desc_2, klass1, NULL);
+   fail_if(!klass2);
+
+   obj1 = efl_add_ref(klass1, NULL);
+   obj2 = efl_add_ref(klass2, NULL);
+   obj3 = efl_add_ref(klass1, NULL);
+   fail_if(!obj1 || !obj2 || !obj3);
+
+   // the set call site resolves to the same function for both classes but
+   // each object still has to get its own data, of the class that calls
+   cache_value_set(obj1, 1);
+   cache_value_set(obj2, 2);
+   cache_value_set(obj3, 3);
+   cache_value_set(efl_super(obj2, klass2), 5);
+
+   // one call site hit in turn by two classes, one overriding the method
+   // of the other: the cached record of one must never serve the other
+   for (i = 0; i < 4; i++)
+     {
+        ck_assert_int_eq(cache_value(obj1), 1);
+        ck_assert_int_eq(cache_value(obj2), 205);
+        ck_assert_int_eq(cache_value(obj3), 3);
+     }
+
+   // efl_super through a call site cached for the derived class
+   ck_assert_int_eq(cache_value(obj2), 205);
+   ck_assert_int_eq(cache_value(efl_super(obj2, klass2)), 5);
+   ck_assert_int_eq(cache_value(obj2), 205);
+   ck_assert_int_eq(cache_value(efl_super(obj2, klass2)), 5);
+
+   // and through a call site cached for the base class
+   ck_assert_int_eq(cache_value(obj1), 1);
+   ck_assert_int_eq(cache_value(efl_super(obj2, klass2)), 5);
+   ck_assert_int_eq(cache_value(obj1), 1);
+
+   efl_unref(obj1);
+   efl_unref(obj2);
+   efl_unref(obj3);
+}
+EFL_END_TEST
+
 EFL_START_TEST(efl_object_destruct_test)
 {
    int var = 0;
@@ -1868,12 +2099,15 @@ void eo_test_general(TCase *tc)
    tcase_add_test(tc, efl_add_do_and_custom);
    tcase_add_test(tc, eo_pointers_indirection);
    tcase_add_test(tc, efl_add_failures);
+   tcase_add_test(tc, efl_add_batch_tests);
+   tcase_add_test(tc, efl_object_profiler_tests);
    tcase_add_test(tc, efl_del_intercept);
    tcase_add_test(tc, efl_name);
    tcase_add_test(tc, eo_comment);
    tcase_add_test(tc, eo_rec_interface);
    tcase_add_test(tc, eo_domain);
    tcase_add_test(tc, efl_cast_test);
+   tcase_add_test(tc, efl_call_cache);
    tcase_add_test(tc, efl_object_destruct_test);
    tcase_add_test(tc, efl_object_auto_unref_test);
    tcase_add_test(tc, efl_object_size);
@@ -135,7 +135,107 @@ EFL_START_TEST(eo_threaded_calls_test)
 }
 EFL_END_TEST
 
+#define SHARED_THREADS 4
+#define SHARED_OBJS 8
+#define SHARED_LOOPS 2000
+
+static Eo *shared_objs[SHARED_OBJS];
+
+static void *
+_shared_thread_job(void *data, Eina_Thread t EINA_UNUSED)
+{
+   int n = (int) (uintptr_t) data;
+   int i, errors = 0;
+
+   eina_barrier_wait(&barrier);
+   for (i = 0; i < SHARED_LOOPS; i++)
+     {
+        Eo *obj, *own;
+        int v = (i + n) % SHARED_OBJS;
+
+        obj = shared_objs[v];
+        if (thread_test_v_get(obj) != v) errors++;
+        if (!efl_isa(obj, THREAD_TEST_CLASS)) errors++;
+
+        // the table changes under the lookups of the other threads
+        efl_domain_current_push(EFL_ID_DOMAIN_SHARED);
+        own = efl_add_ref(THREAD_TEST_CLASS, NULL,
+                          thread_test_constructor(efl_added, 100 + n));
+        efl_domain_current_pop();
+        if (thread_test_v_get(own) != 100 + n) errors++;
+        if (thread_test_v_get(obj) != v) errors++;
+        efl_unref(own);
+     }
+
+   return (void *) (uintptr_t) errors;
+}
+
+EFL_START_TEST(eo_threaded_shared_calls)
+{
+   Eina_Thread threads[SHARED_THREADS];
+   int i;
+
+   efl_domain_current_push(EFL_ID_DOMAIN_SHARED);
+   for (i = 0; i < SHARED_OBJS; i++)
+     shared_objs[i] = efl_add_ref(THREAD_TEST_CLASS, NULL,
+                                  thread_test_constructor(efl_added, i));
+   efl_domain_current_pop();
+
+   fail_if(!eina_barrier_new(&barrier, SHARED_THREADS));
+   for (i = 0; i < SHARED_THREADS; i++)
+     fail_if(!eina_thread_create(&threads[i], EINA_THREAD_NORMAL, -1,
+                                 _shared_thread_job, (void *) (uintptr_t) i));
+   for (i = 0; i < SHARED_THREADS; i++)
+     ck_assert_int_eq((int) (uintptr_t) eina_thread_join(threads[i]), 0);
+   eina_barrier_free(&barrier);
+
+   for (i = 0; i < SHARED_OBJS; i++)
+     {
+        ck_assert_int_eq(thread_test_v_get(shared_objs[i]), i);
+        efl_unref(shared_objs[i]);
+     }
+}
+EFL_END_TEST
+
+EFL_START_TEST(eo_shared_stale_id)
+{
+   Eo *obj, *objs[16];
+   int i;
+
+   efl_domain_current_push(EFL_ID_DOMAIN_SHARED);
+   obj = efl_add_ref(THREAD_TEST_CLASS, NULL, thread_test_constructor(efl_added, 7));
+   efl_domain_current_pop();
+
+   // leaves the id in the lookup and isa caches of this thread
+   ck_assert_int_eq(thread_test_v_get(obj), 7);
+   fail_if(!efl_isa(obj, THREAD_TEST_CLASS));
+   efl_unref(obj);
+
+   fail_if(efl_isa(obj, THREAD_TEST_CLASS));
+   ck_assert_int_eq(thread_test_v_get(obj), 0);
+
+   // the entry comes back with a new generation, the old id stays dead
+   efl_domain_current_push(EFL_ID_DOMAIN_SHARED);
+   for (i = 0; i < 16; i++)
+     objs[i] = efl_add_ref(THREAD_TEST_CLASS, NULL, thread_test_constructor(efl_added, i));
+   efl_domain_current_pop();
+
+   for (i = 0; i < 16; i++)
+     {
+        fail_if(objs[i] == obj);
+        ck_assert_int_eq(thread_test_v_get(objs[i]), i);
+     }
+   fail_if(efl_isa(obj, THREAD_TEST_CLASS));
+   ck_assert_int_eq(thread_test_v_get(obj), 0);
+
+   for (i = 0; i < 16; i++)
+     efl_unref(objs[i]);
+}
+EFL_END_TEST
+
 void eo_test_threaded_calls(TCase *tc)
 {
    tcase_add_test(tc, eo_threaded_calls_test);
+   tcase_add_test(tc, eo_threaded_shared_calls);
+   tcase_add_test(tc, eo_shared_stale_id);
 }
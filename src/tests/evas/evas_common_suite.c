@@ -0,0 +1,87 @@
+#ifdef HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdlib.h>
+
+#ifndef _WIN32
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+
+#include "../../lib/evas/include/evas_common_private.h"
+
+#include "evas_common_suite.h"
+#include "../efl_check.h"
+
+/* Tests of the software drawing code of lib/evas/common that needs to
+ * reach its internal functions: it is built in, not linked from libevas. */
+
+static const Efl_Test_Case etc[] = {
+  { "Blend", evas_test_blend },
+  { "Convert YUV", evas_test_convert_yuv },
+  { "Mipmap", evas_test_mipmap },
+  { NULL, NULL }
+};
+
+/* owned by evas_main.c in libevas, the sources built in log to it */
+int _evas_log_dom_global = -1;
+
+#ifndef _WIN32
+/* The cpu features are read once by evas_common_cpu_init(), from the
+ * EVAS_CPU_NO_* variables, so code is run with some of them turned off in
+ * a child process, that gives its results through shared memory. FALSE
+ * if the child did not complete. */
+Eina_Bool
+evas_common_suite_cpu_run(const char *const *disabled,
+                          void (*run)(void *data), void *data)
+{
+   pid_t pid;
+   int status;
+
+   pid = fork();
+   if (pid < 0) return EINA_FALSE;
+   if (!pid)
+     {
+        for (; *disabled; disabled++)
+          setenv(*disabled, "1", 1);
+        evas_common_cpu_init();
+        run(data);
+        _exit(0);
+     }
+   if (waitpid(pid, &status, 0) != pid) return EINA_FALSE;
+   return WIFEXITED(status) && !WEXITSTATUS(status);
+}
+#endif
+
+SUITE_INIT(evas_common)
+{
+   ck_assert_int_eq(eina_init(), 1);
+   _evas_log_dom_global = eina_log_domain_register("evas_common_suite",
+                                                   EVAS_DEFAULT_LOG_COLOR);
+}
+
+SUITE_SHUTDOWN(evas_common)
+{
+   eina_log_domain_unregister(_evas_log_dom_global);
+   _evas_log_dom_global = -1;
+   ck_assert_int_eq(eina_shutdown(), 0);
+}
+
+int
+main(int argc, char **argv)
+{
+   int failed_count;
+
+   if (!_efl_test_option_disp(argc, argv, etc))
+     return 0;
+
+#ifdef NEED_RUN_IN_TREE
+   putenv("EFL_RUN_IN_TREE=1");
+#endif
+
+   failed_count = _efl_suite_build_and_run(argc - 1, (const char **)argv + 1,
+                                           "Evas_Common", etc, SUITE_INIT_FN(evas_common), SUITE_SHUTDOWN_FN(evas_common));
+
+   return (failed_count == 0) ? 0 : 255;
+}
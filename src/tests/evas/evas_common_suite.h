@@ -0,0 +1,15 @@
+#ifndef _EVAS_COMMON_SUITE_H
+#define _EVAS_COMMON_SUITE_H
+
+#include <check.h>
+#include <Eina.h>
+#include "../efl_check.h"
+void evas_test_blend(TCase *tc);
+void evas_test_convert_yuv(TCase *tc);
+void evas_test_mipmap(TCase *tc);
+
+#ifndef _WIN32
+Eina_Bool evas_common_suite_cpu_run(const char *const *disabled, void (*run)(void *data), void *data);
+#endif
+
+#endif /* _EVAS_COMMON_SUITE_H */
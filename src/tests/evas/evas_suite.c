@@ -27,6 +27,9 @@ static const Efl_Test_Case etc[] = {
   { "Evas GL", evas_test_evasgl },
   { "Object Smart", evas_test_object_smart },
   { "Matrix", evas_test_matrix },
+  { "Pipe", evas_test_pipe },
+  { "Scalecache", evas_test_scalecache },
+  { "Hit Index", evas_test_hit_index },
   { NULL, NULL }
 };
 
@@ -21,5 +21,8 @@ void evas_test_mask(TCase *tc);
 void evas_test_evasgl(TCase *tc);
 void evas_test_object_smart(TCase *tc);
 void evas_test_matrix(TCase *tc);
+void evas_test_pipe(TCase *tc);
+void evas_test_scalecache(TCase *tc);
+void evas_test_hit_index(TCase *tc);
 
 #endif /* _EVAS_SUITE_H */
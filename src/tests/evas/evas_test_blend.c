@@ -0,0 +1,251 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/evas/include/evas_common_private.h"
+#include "../../lib/evas/common/evas_blend_private.h"
+
+#include "evas_common_suite.h"
+
+#if defined(BUILD_AVX2) && !defined(_WIN32)
+
+#include <sys/mman.h>
+
+typedef enum
+{
+   SPAN_PIXEL,
+   SPAN_COLOR,
+   SPAN_PIXEL_COLOR,
+   SPAN_PIXEL_MASK,
+   SPAN_MASK_COLOR,
+   SPAN_LAST
+} Span_Type;
+
+typedef struct
+{
+   int op;
+   Span_Type type;
+   Eina_Bool src_alpha, dst_alpha;
+   DATA32 col;
+   int len;
+} Blend_Case;
+
+#define MAX_LEN 1021
+
+static const int ops[] = {
+   _EVAS_RENDER_BLEND, _EVAS_RENDER_COPY, _EVAS_RENDER_MASK, _EVAS_RENDER_MUL
+};
+
+static const DATA32 cols[] = {
+   0xffffffff, 0xff336699, 0x80402010, 0x00000000
+};
+
+/* every length over a few vectors and their remainders, and a long one */
+static const int lens[] = {
+   1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+   21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38,
+   39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56,
+   57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, MAX_LEN
+};
+
+/* the vector spans fall back to C ones, not to SSE3 or MMX ones */
+#define NO_OLD_SIMD \
+   "EVAS_CPU_NO_MMX", "EVAS_CPU_NO_MMX2", "EVAS_CPU_NO_SSE", \
+   "EVAS_CPU_NO_SSE3", "EVAS_CPU_NO_SSE41"
+
+static const char *const c_only[] = {
+   NO_OLD_SIMD, "EVAS_CPU_NO_AVX2", "EVAS_CPU_NO_AVX512", NULL
+};
+static const char *const avx2_only[] = {
+   NO_OLD_SIMD, "EVAS_CPU_NO_AVX512", NULL
+};
+static const char *const avx512[] = { NO_OLD_SIMD, NULL };
+
+static unsigned int
+_blend_cases_get(Blend_Case *cases)
+{
+   unsigned int n = 0, o, t, sa, da, c, l;
+
+   for (o = 0; o < EINA_C_ARRAY_LENGTH(ops); o++)
+     for (t = 0; t < SPAN_LAST; t++)
+       for (sa = 0; sa < 2; sa++)
+         for (da = 0; da < 2; da++)
+           for (c = 0; c < EINA_C_ARRAY_LENGTH(cols); c++)
+             for (l = 0; l < EINA_C_ARRAY_LENGTH(lens); l++, n++)
+               {
+                  if (!cases) continue;
+                  cases[n].op = ops[o];
+                  cases[n].type = t;
+                  cases[n].src_alpha = sa;
+                  cases[n].dst_alpha = da;
+                  cases[n].col = cols[c];
+                  cases[n].len = lens[l];
+               }
+   return n;
+}
+
+/* random pixels, not always premultiplied, with some fully transparent
+ * and opaque ones as the spans special case those */
+static void
+_blend_case_fill(unsigned int seed, const Blend_Case *bc,
+                 DATA32 *src, DATA8 *mask, DATA32 *dst)
+{
+   int i;
+
+   srand(seed);
+   for (i = 0; i < bc->len; i++)
+     {
+        src[i] = ((DATA32)rand() << 16) ^ (DATA32)rand();
+        dst[i] = ((DATA32)rand() << 16) ^ (DATA32)rand();
+        mask[i] = rand();
+        switch (rand() % 8)
+          {
+           case 0: src[i] &= 0x00ffffff; mask[i] = 0; break;
+           case 1: src[i] |= 0xff000000; mask[i] = 255; break;
+           default: break;
+          }
+        if (!bc->src_alpha) src[i] |= 0xff000000;
+        if (!bc->dst_alpha) dst[i] |= 0xff000000;
+     }
+}
+
+static void
+_blend_cases_run(const Blend_Case *cases, unsigned int count, DATA32 *out)
+{
+   DATA32 src[MAX_LEN], dst[MAX_LEN + 3];
+   DATA8 mask[MAX_LEN];
+   unsigned int i;
+
+   for (i = 0; i < count; i++)
+     {
+        const Blend_Case *bc = &cases[i];
+        /* not always starting on a vector boundary */
+        DATA32 *d = dst + (bc->len & 3);
+        RGBA_Gfx_Func func = NULL;
+
+        _blend_case_fill(i, bc, src, mask, d);
+        switch (bc->type)
+          {
+           case SPAN_PIXEL:
+             func = evas_common_gfx_func_composite_pixel_span_get(bc->src_alpha, EINA_FALSE, bc->dst_alpha, bc->len, bc->op);
+             func(src, NULL, 0, d, bc->len);
+             break;
+           case SPAN_COLOR:
+             func = evas_common_gfx_func_composite_color_span_get(bc->col, bc->dst_alpha, bc->len, bc->op);
+             func(NULL, NULL, bc->col, d, bc->len);
+             break;
+           case SPAN_PIXEL_COLOR:
+             func = evas_common_gfx_func_composite_pixel_color_span_get(bc->src_alpha, EINA_FALSE, bc->col, bc->dst_alpha, bc->len, bc->op);
+             func(src, NULL, bc->col, d, bc->len);
+             break;
+           case SPAN_PIXEL_MASK:
+             func = evas_common_gfx_func_composite_pixel_mask_span_get(bc->src_alpha, EINA_FALSE, bc->dst_alpha, bc->len, bc->op);
+             func(src, mask, 0, d, bc->len);
+             break;
+           case SPAN_MASK_COLOR:
+             func = evas_common_gfx_func_composite_mask_color_span_get(bc->col, bc->dst_alpha, bc->len, bc->op);
+             func(NULL, mask, bc->col, d, bc->len);
+             break;
+           default:
+             break;
+          }
+        memcpy(out, d, bc->len * sizeof(DATA32));
+        out += bc->len;
+     }
+}
+
+typedef struct
+{
+   const Blend_Case *cases;
+   unsigned int count;
+   DATA32 *out;
+} Blend_Run;
+
+static void
+_blend_cases_child(void *data)
+{
+   Blend_Run *run = data;
+
+   evas_common_blend_init();
+   _blend_cases_run(run->cases, run->count, run->out);
+}
+
+static Eina_Bool
+_blend_cases_fork(const Blend_Case *cases, unsigned int count, DATA32 *out,
+                  const char *const *disabled)
+{
+   Blend_Run run = { cases, count, out };
+
+   return evas_common_suite_cpu_run(disabled, _blend_cases_child, &run);
+}
+
+static void
+_blend_cases_compare(const Blend_Case *cases, unsigned int count,
+                     const DATA32 *ref, const DATA32 *out, const char *name)
+{
+   unsigned int i;
+
+   for (i = 0; i < count; i++)
+     {
+        const Blend_Case *bc = &cases[i];
+
+        fail_if(memcmp(ref, out, bc->len * sizeof(DATA32)),
+                "%s span differs from C: op %d, type %d, src alpha %d, "
+                "dst alpha %d, color %08x, length %d", name, bc->op,
+                bc->type, bc->src_alpha, bc->dst_alpha, bc->col, bc->len);
+        ref += bc->len;
+        out += bc->len;
+     }
+}
+
+EFL_START_TEST(evas_blend_simd_spans)
+{
+   Eina_Cpu_Features features = eina_cpu_features_get();
+   Blend_Case *cases;
+   DATA32 *ref, *out;
+   unsigned int count, i;
+   size_t pixels = 0, size;
+
+   count = _blend_cases_get(NULL);
+   cases = calloc(count, sizeof(Blend_Case));
+   fail_if(!cases);
+   _blend_cases_get(cases);
+   for (i = 0; i < count; i++)
+     pixels += cases[i].len;
+
+   size = 2 * pixels * sizeof(DATA32);
+   ref = mmap(NULL, size, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   fail_if(ref == MAP_FAILED);
+   out = ref + pixels;
+
+   fail_if(!_blend_cases_fork(cases, count, ref, c_only));
+
+   if (features & EINA_CPU_AVX2)
+     {
+        fail_if(!_blend_cases_fork(cases, count, out, avx2_only));
+        _blend_cases_compare(cases, count, ref, out, "AVX2");
+     }
+   if ((features & EINA_CPU_AVX2) && (features & EINA_CPU_AVX512))
+     {
+        fail_if(!_blend_cases_fork(cases, count, out, avx512));
+        _blend_cases_compare(cases, count, ref, out, "AVX-512");
+     }
+
+   munmap(ref, size);
+   free(cases);
+}
+EFL_END_TEST
+
+#endif
+
+void evas_test_blend(TCase *tc EINA_UNUSED)
+{
+#if defined(BUILD_AVX2) && !defined(_WIN32)
+   tcase_add_test(tc, evas_blend_simd_spans);
+#endif
+}
@@ -0,0 +1,272 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/evas/include/evas_common_private.h"
+
+#include "evas_common_suite.h"
+
+#ifndef _WIN32
+
+#include <sys/mman.h>
+
+/* Every converter is run with the C rows only, then with each vector row
+ * the cpu has, and must give the same pixels. The last frame is bigger than
+ * 1080p, so it is cut in bands converted by several threads, while the C
+ * reference converts it two rows at a time, which never gets threaded. */
+
+typedef enum
+{
+   YUV_601,
+   YUV_709,
+   YUV_YUY2,
+   YUV_NV12,
+   YUV_LAST
+} Yuv_Format;
+
+typedef struct
+{
+   int w, h;
+   DATA8 *data;
+   DATA8 **rows;
+} Yuv_Frame;
+
+typedef struct
+{
+   Yuv_Format format;
+   Yuv_Frame *frames;
+   unsigned int count;
+   DATA32 *out;
+   Eina_Bool bands;
+} Yuv_Run;
+
+static const int sizes[][2] = {
+   { 1, 1 }, { 2, 2 }, { 3, 5 }, { 7, 3 }, { 9, 9 }, { 16, 16 },
+   { 17, 11 }, { 33, 7 }, { 63, 13 }, { 64, 32 }, { 65, 17 }, { 127, 3 },
+   { 255, 5 },
+   /* odd width, but an even height so that it can be cut in pairs of
+    * rows sharing their chroma */
+   { 1921, 1082 }
+};
+
+#define NO_OLD_SIMD \
+   "EVAS_CPU_NO_MMX", "EVAS_CPU_NO_MMX2", "EVAS_CPU_NO_SSE", \
+   "EVAS_CPU_NO_SSE3", "EVAS_CPU_NO_ALTIVEC"
+
+static const char *const c_only[] = {
+   NO_OLD_SIMD, "EVAS_CPU_NO_SSE41", "EVAS_CPU_NO_AVX2",
+   "EVAS_CPU_NO_AVX512", "EVAS_CPU_NO_NEON", NULL
+};
+static const char *const sse41_only[] = {
+   NO_OLD_SIMD, "EVAS_CPU_NO_AVX2", "EVAS_CPU_NO_AVX512", NULL
+};
+static const char *const best[] = { NO_OLD_SIMD, NULL };
+
+/* random planes laid out as the converters index their rows */
+static void
+_yuv_frame_new(Yuv_Frame *f, Yuv_Format format, int w, int h)
+{
+   int cw = (w + 1) / 2, ch = (h + 1) / 2;
+   int i, size;
+
+   f->w = w;
+   f->h = h;
+   switch (format)
+     {
+      case YUV_YUY2:
+        size = h * cw * 4;
+        break;
+      case YUV_NV12:
+      default:
+        size = (w * h) + (ch * cw * 2);
+        break;
+     }
+   f->data = malloc(size);
+   f->rows = calloc(2 * h, sizeof(DATA8 *));
+   fail_if(!f->data || !f->rows);
+   for (i = 0; i < size; i++)
+     f->data[i] = rand();
+
+   switch (format)
+     {
+      case YUV_YUY2:
+        for (i = 0; i < h; i++)
+          f->rows[i] = f->data + (i * cw * 4);
+        break;
+      case YUV_NV12:
+        for (i = 0; i < h; i++)
+          f->rows[i] = f->data + (i * w);
+        for (i = 0; i < ch; i++)
+          f->rows[h + i] = f->data + (w * h) + (i * cw * 2);
+        break;
+      default:
+        for (i = 0; i < h; i++)
+          f->rows[i] = f->data + (i * w);
+        /* u then v, the v rows starting h / 2 rows after the u ones */
+        for (i = 0; i < h; i++)
+          f->rows[h + i] = f->data + (w * h) + (i * cw);
+        break;
+     }
+}
+
+static void
+_yuv_frame_free(Yuv_Frame *f)
+{
+   free(f->rows);
+   free(f->data);
+}
+
+static void
+_yuv_convert(Yuv_Format format, DATA8 **rows, DATA32 *out, int w, int h)
+{
+   switch (format)
+     {
+      case YUV_601:
+        evas_common_convert_yuv_422p_601_rgba(rows, (DATA8 *)out, w, h);
+        break;
+      case YUV_709:
+        evas_common_convert_yuv_422p_709_rgba(rows, (DATA8 *)out, w, h);
+        break;
+      case YUV_YUY2:
+        evas_common_convert_yuv_422_601_rgba(rows, (DATA8 *)out, w, h);
+        break;
+      case YUV_NV12:
+        evas_common_convert_yuv_420_601_rgba(rows, (DATA8 *)out, w, h);
+        break;
+      default:
+        break;
+     }
+}
+
+/* the frame as a succession of frames of two rows */
+static void
+_yuv_convert_bands(Yuv_Format format, const Yuv_Frame *f, DATA32 *out)
+{
+   int y;
+
+   for (y = 0; y < f->h; y += 2)
+     {
+        DATA8 *rows[4] = { f->rows[y], f->rows[y + 1], NULL, NULL };
+
+        switch (format)
+          {
+           case YUV_YUY2:
+             break;
+           case YUV_NV12:
+             rows[2] = f->rows[f->h + (y >> 1)];
+             break;
+           default:
+             rows[2] = f->rows[f->h + (y >> 1)];
+             rows[3] = f->rows[f->h + (f->h >> 1) + (y >> 1)];
+             break;
+          }
+        _yuv_convert(format, rows, out + (y * f->w), f->w, 2);
+     }
+}
+
+static void
+_yuv_run_child(void *data)
+{
+   Yuv_Run *run = data;
+   DATA32 *out = run->out;
+   unsigned int i;
+
+   evas_common_convert_yuv_init();
+   for (i = 0; i < run->count; i++)
+     {
+        const Yuv_Frame *f = &run->frames[i];
+
+        if (run->bands && (f->w * f->h > 1920 * 1080))
+          _yuv_convert_bands(run->format, f, out);
+        else
+          _yuv_convert(run->format, f->rows, out, f->w, f->h);
+        out += f->w * f->h;
+     }
+   evas_common_convert_yuv_shutdown();
+}
+
+static void
+_yuv_compare(const Yuv_Run *run, const DATA32 *ref, const char *name)
+{
+   const DATA32 *out = run->out;
+   unsigned int i;
+
+   for (i = 0; i < run->count; i++)
+     {
+        const Yuv_Frame *f = &run->frames[i];
+
+        fail_if(memcmp(ref, out, f->w * f->h * sizeof(DATA32)),
+                "%s conversion of format %d differs from C at %dx%d",
+                name, run->format, f->w, f->h);
+        ref += f->w * f->h;
+        out += f->w * f->h;
+     }
+}
+
+EFL_START_TEST(evas_convert_yuv_simd_rows)
+{
+   Eina_Cpu_Features features = eina_cpu_features_get();
+   Yuv_Frame frames[EINA_C_ARRAY_LENGTH(sizes)];
+   Yuv_Run run;
+   DATA32 *ref;
+   size_t pixels = 0, size;
+   unsigned int i;
+   int format;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+     pixels += sizes[i][0] * sizes[i][1];
+   size = 2 * pixels * sizeof(DATA32);
+   ref = mmap(NULL, size, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   fail_if(ref == MAP_FAILED);
+
+   srand(42);
+   for (format = 0; format < YUV_LAST; format++)
+     {
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+          _yuv_frame_new(&frames[i], format, sizes[i][0], sizes[i][1]);
+
+        run.format = format;
+        run.frames = frames;
+        run.count = EINA_C_ARRAY_LENGTH(sizes);
+
+        run.out = ref;
+        run.bands = EINA_TRUE;
+        fail_if(!evas_common_suite_cpu_run(c_only, _yuv_run_child, &run));
+
+        run.out = ref + pixels;
+        run.bands = EINA_FALSE;
+        fail_if(!evas_common_suite_cpu_run(c_only, _yuv_run_child, &run));
+        _yuv_compare(&run, ref, "Threaded C");
+
+        if (features & EINA_CPU_SSE41)
+          {
+             fail_if(!evas_common_suite_cpu_run(sse41_only, _yuv_run_child, &run));
+             _yuv_compare(&run, ref, "SSE4.1");
+          }
+        if (features & (EINA_CPU_AVX2 | EINA_CPU_NEON))
+          {
+             fail_if(!evas_common_suite_cpu_run(best, _yuv_run_child, &run));
+             _yuv_compare(&run, ref, "AVX2 or NEON");
+          }
+
+        for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+          _yuv_frame_free(&frames[i]);
+     }
+
+   munmap(ref, size);
+}
+EFL_END_TEST
+
+#endif
+
+void evas_test_convert_yuv(TCase *tc EINA_UNUSED)
+{
+#ifndef _WIN32
+   tcase_add_test(tc, evas_convert_yuv_simd_rows);
+#endif
+}
@@ -0,0 +1,326 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/evas/include/evas_common_private.h"
+#include "../../lib/evas/include/evas_private.h"
+#include <Ecore_Evas.h>
+
+#include "evas_suite.h"
+
+#ifdef BUILD_ENGINE_BUFFER
+
+#define W 300
+#define H 300
+
+/* Two canvases get the same objects, only one of them looking the objects
+ * under the pointer up in the hit index (EVAS_HIT_INDEX, read when the
+ * canvas is made): both have to give the same objects, in the same order,
+ * at every point. */
+
+typedef struct
+{
+   Ecore_Evas *ee;
+   Evas *evas;
+   Evas_Smart *smart;
+   Eina_List *top; /* the top level objects, in the order they were added */
+   unsigned int seed;
+} Hit_Canvas;
+
+static int
+_hit_rand(Hit_Canvas *c, int max)
+{
+   c->seed = (c->seed * 1103515245) + 12345;
+   return (c->seed >> 16) % max;
+}
+
+static Evas_Object *
+_hit_rect_add(Hit_Canvas *c, Evas_Object *parent, int i)
+{
+   Evas_Object *o;
+   char name[16];
+
+   o = evas_object_rectangle_add(c->evas);
+   snprintf(name, sizeof (name), "o%i", i);
+   evas_object_name_set(o, name);
+   evas_object_geometry_set(o, _hit_rand(c, W + 40) - 20,
+                            _hit_rand(c, H + 40) - 20,
+                            _hit_rand(c, 100) + 1, _hit_rand(c, 100) + 1);
+   evas_object_repeat_events_set(o, !!(i % 5));
+   evas_object_pass_events_set(o, !(i % 7));
+   if (i % 11) evas_object_show(o);
+   if (parent) evas_object_smart_member_add(o, parent);
+   else
+     {
+        evas_object_layer_set(o, _hit_rand(c, 5) - 2);
+        c->top = eina_list_append(c->top, o);
+     }
+   return o;
+}
+
+static Evas_Object *
+_hit_smart_add(Hit_Canvas *c, Evas_Object *parent, int i)
+{
+   Evas_Object *o;
+   char name[16];
+   int j;
+
+   o = evas_object_smart_add(c->evas, c->smart);
+   snprintf(name, sizeof (name), "s%i", i);
+   evas_object_name_set(o, name);
+   evas_object_repeat_events_set(o, EINA_TRUE);
+   for (j = 0; j < 6; j++)
+     _hit_rect_add(c, o, (i * 100) + j);
+   evas_object_show(o);
+   if (parent) evas_object_smart_member_add(o, parent);
+   else
+     {
+        evas_object_layer_set(o, _hit_rand(c, 5) - 2);
+        c->top = eina_list_append(c->top, o);
+     }
+   return o;
+}
+
+static void
+_hit_map_set(Evas_Object *o)
+{
+   Evas_Map *m;
+   int x, y, w, h;
+
+   evas_object_geometry_get(o, &x, &y, &w, &h);
+   m = evas_map_new(4);
+   evas_map_util_points_populate_from_object(m, o);
+   evas_map_util_rotate(m, 30, x + (w / 2), y + (h / 2));
+   evas_object_map_set(o, m);
+   evas_object_map_enable_set(o, EINA_TRUE);
+   evas_map_free(m);
+}
+
+static void
+_hit_canvas_new(Hit_Canvas *c, Eina_Bool indexed)
+{
+   static Evas_Smart_Class sc = EVAS_SMART_CLASS_INIT_NAME_VERSION("Hit_Index_Smart");
+   Evas_Object *clip, *o, *s;
+   int i;
+
+   if (indexed) setenv("EVAS_HIT_INDEX", "1", 1);
+   else unsetenv("EVAS_HIT_INDEX");
+   c->ee = ecore_evas_buffer_new(W, H);
+   unsetenv("EVAS_HIT_INDEX");
+   fail_if(!c->ee);
+   ecore_evas_show(c->ee);
+   ecore_evas_manual_render_set(c->ee, EINA_TRUE);
+   c->evas = ecore_evas_get(c->ee);
+   c->top = NULL;
+   c->seed = 42;
+
+   evas_object_smart_clipped_smart_set(&sc);
+   c->smart = evas_smart_class_new(&sc);
+   fail_if(!c->smart);
+
+   clip = _hit_rect_add(c, NULL, 1000);
+   evas_object_show(clip);
+   for (i = 0; i < 120; i++)
+     {
+        o = _hit_rect_add(c, NULL, i);
+        if (!(i % 4)) evas_object_clip_set(o, clip);
+     }
+
+   // smart children: a smart clipped by a rectangle, nested smarts and a
+   // smart passing events
+   for (i = 0; i < 6; i++)
+     {
+        s = _hit_smart_add(c, NULL, i);
+        if (i == 1) evas_object_clip_set(s, clip);
+        if (i == 2) _hit_smart_add(c, s, 10 + i);
+        if (i == 4) evas_object_pass_events_set(s, EINA_TRUE);
+     }
+
+   // mapped objects, one of them a smart member
+   _hit_map_set(_hit_rect_add(c, NULL, 500));
+   _hit_smart_add(c, NULL, 20);
+   _hit_map_set(evas_object_name_find(c->evas, "o2000"));
+}
+
+static void
+_hit_canvas_free(Hit_Canvas *c)
+{
+   eina_list_free(c->top);
+   ecore_evas_free(c->ee);
+   evas_smart_free(c->smart);
+}
+
+static const char *
+_hit_name(Evas_Object *o)
+{
+   const char *name = evas_object_name_get(o);
+
+   // the clippers of the smarts have no name
+   if (!name) name = evas_object_type_get(o);
+   return name;
+}
+
+static void
+_hit_lists_check(Eina_List *indexed, Eina_List *walked,
+                 const char *func, int x, int y)
+{
+   Eina_List *li, *lw;
+
+   for (li = indexed, lw = walked; li && lw; li = li->next, lw = lw->next)
+     ck_assert_msg(!strcmp(_hit_name(li->data), _hit_name(lw->data)),
+                   "%s at %i,%i: %s instead of %s", func, x, y,
+                   _hit_name(li->data), _hit_name(lw->data));
+   ck_assert_msg(!li && !lw, "%s at %i,%i: %u objects instead of %u",
+                 func, x, y, eina_list_count(indexed), eina_list_count(walked));
+   eina_list_free(indexed);
+   eina_list_free(walked);
+}
+
+static void
+_hit_point_check(Hit_Canvas *indexed, Hit_Canvas *walked, int x, int y)
+{
+   _hit_lists_check(evas_tree_objects_at_xy_get(indexed->evas, NULL, x, y),
+                    evas_tree_objects_at_xy_get(walked->evas, NULL, x, y),
+                    "evas_tree_objects_at_xy_get", x, y);
+   _hit_lists_check(evas_objects_at_xy_get(indexed->evas, x, y,
+                                           EINA_TRUE, EINA_TRUE),
+                    evas_objects_at_xy_get(walked->evas, x, y,
+                                           EINA_TRUE, EINA_TRUE),
+                    "evas_objects_at_xy_get", x, y);
+   _hit_lists_check(evas_objects_at_xy_get(indexed->evas, x, y,
+                                           EINA_FALSE, EINA_FALSE),
+                    evas_objects_at_xy_get(walked->evas, x, y,
+                                           EINA_FALSE, EINA_FALSE),
+                    "evas_objects_at_xy_get", x, y);
+}
+
+static void
+_hit_check(Hit_Canvas *indexed, Hit_Canvas *walked)
+{
+   Evas_Public_Data *e;
+   int x, y;
+
+   for (y = -10; y < H + 10; y += 7)
+     for (x = -10; x < W + 10; x += 7)
+       _hit_point_check(indexed, walked, x, y);
+
+   // the lookups did go through the index
+   e = efl_data_scope_get(indexed->evas, EVAS_CANVAS_CLASS);
+   fail_if(!e->hit_index.tree);
+   fail_if(!eina_rtree_count(e->hit_index.tree));
+   e = efl_data_scope_get(walked->evas, EVAS_CANVAS_CLASS);
+   fail_if(e->hit_index.tree);
+}
+
+/* the same changes on both canvases */
+static void
+_hit_change(Hit_Canvas *c, int step)
+{
+   Evas_Object *o;
+   Eina_List *l;
+   int i = 0, x, y;
+
+   EINA_LIST_FOREACH(c->top, l, o)
+     {
+        switch ((i++ + step) % 8)
+          {
+           case 0:
+           case 1:
+           case 2:
+             // more than a quarter moves, repacking the index
+             evas_object_geometry_get(o, &x, &y, NULL, NULL);
+             evas_object_move(o, x + _hit_rand(c, 61) - 30,
+                              y + _hit_rand(c, 61) - 30);
+             break;
+           case 3:
+             if (evas_object_visible_get(o)) evas_object_hide(o);
+             else evas_object_show(o);
+             break;
+           case 4:
+             evas_object_pass_events_set(o, !evas_object_pass_events_get(o));
+             break;
+           case 5:
+             if (step % 2) evas_object_raise(o);
+             else evas_object_lower(o);
+             break;
+           case 6:
+             evas_object_resize(o, _hit_rand(c, 100) + 1,
+                                _hit_rand(c, 100) + 1);
+             break;
+          }
+     }
+   o = evas_object_name_find(c->evas, "s3");
+   evas_object_layer_set(o, step % 3);
+   o = evas_object_name_find(c->evas, "o300");
+   evas_object_move(o, _hit_rand(c, W), _hit_rand(c, H));
+}
+
+EFL_START_TEST(evas_hit_index_same_objects)
+{
+   Hit_Canvas indexed, walked;
+   int step;
+
+   _hit_canvas_new(&indexed, EINA_TRUE);
+   _hit_canvas_new(&walked, EINA_FALSE);
+
+   // before the first render, then after it
+   _hit_check(&indexed, &walked);
+   ecore_evas_manual_render(indexed.ee);
+   ecore_evas_manual_render(walked.ee);
+   _hit_check(&indexed, &walked);
+
+   for (step = 0; step < 4; step++)
+     {
+        _hit_change(&indexed, step);
+        _hit_change(&walked, step);
+        _hit_check(&indexed, &walked);
+        ecore_evas_manual_render(indexed.ee);
+        ecore_evas_manual_render(walked.ee);
+        _hit_check(&indexed, &walked);
+     }
+
+   _hit_canvas_free(&indexed);
+   _hit_canvas_free(&walked);
+}
+EFL_END_TEST
+
+EFL_START_TEST(evas_hit_index_emptied)
+{
+   Hit_Canvas indexed, walked;
+   Evas_Public_Data *e;
+
+   _hit_canvas_new(&indexed, EINA_TRUE);
+   _hit_canvas_new(&walked, EINA_FALSE);
+   ecore_evas_manual_render(indexed.ee);
+   ecore_evas_manual_render(walked.ee);
+   _hit_check(&indexed, &walked);
+
+   // what a repack that ran out of memory leaves: the objects are walked
+   // for this lookup, and the index is loaded again for the next one
+   e = efl_data_scope_get(indexed.evas, EVAS_CANVAS_CLASS);
+   fail_if(!eina_rtree_load(e->hit_index.tree, NULL, NULL, 0));
+   _hit_point_check(&indexed, &walked, W / 2, H / 2);
+   fail_if(!e->hit_index.dirty);
+   _hit_check(&indexed, &walked);
+   fail_if(e->hit_index.dirty);
+
+   _hit_canvas_free(&indexed);
+   _hit_canvas_free(&walked);
+}
+EFL_END_TEST
+
+#endif
+
+void evas_test_hit_index(TCase *tc)
+{
+#ifdef BUILD_ENGINE_BUFFER
+   tcase_add_test(tc, evas_hit_index_same_objects);
+   tcase_add_test(tc, evas_hit_index_emptied);
+#else
+   (void)tc;
+#endif
+}
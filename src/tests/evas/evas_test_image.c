@@ -740,6 +740,9 @@ EFL_START_TEST(evas_object_image_defaults)
    fail_if(evas_object_image_filled_get(o));
    evas_object_image_fill_get(o, &x, &y, &w, &h);
    fail_if(x || y || w || h);
+   fail_if(evas_object_image_scale_mipmap_get(o));
+   evas_object_image_scale_mipmap_set(o, EINA_TRUE);
+   fail_if(!evas_object_image_scale_mipmap_get(o));
    efl_del(o);
 
    o = evas_object_image_filled_add(e);
@@ -0,0 +1,308 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../lib/evas/include/evas_common_private.h"
+#include "../../lib/evas/common/evas_image_private.h"
+
+#include "evas_common_suite.h"
+
+/* The levels are images of their own, made and freed by the image cache in
+ * libevas: these stand in for it, for the plain images the tests need. */
+
+RGBA_Image *
+evas_common_image_new(unsigned int w, unsigned int h, unsigned int alpha)
+{
+   RGBA_Image *im;
+
+   im = calloc(1, sizeof(RGBA_Image));
+   if (!im) return NULL;
+   im->image.data = calloc(w * h, sizeof(DATA32));
+   if (!im->image.data)
+     {
+        free(im);
+        return NULL;
+     }
+   im->cache_entry.w = w;
+   im->cache_entry.h = h;
+   im->cache_entry.flags.alpha = !!alpha;
+   im->cache_entry.space = EVAS_COLORSPACE_ARGB8888;
+   evas_common_rgba_image_mipmap_init(&im->cache_entry);
+   return im;
+}
+
+void
+evas_common_rgba_image_free(Image_Entry *ie)
+{
+   RGBA_Image *im = (RGBA_Image *)ie;
+
+   evas_common_rgba_image_mipmap_shutdown(ie);
+   free(im->image.data);
+   free(im);
+}
+
+static RGBA_Image *
+_mipmap_image_new(int w, int h, Eina_Bool mipmap)
+{
+   RGBA_Image *im;
+   int i;
+
+   im = evas_common_image_new(w, h, 1);
+   fail_if(!im);
+   im->cache_entry.flags.mipmap = mipmap;
+   for (i = 0; i < w * h; i++)
+     im->image.data[i] = ((DATA32)rand() << 16) ^ (DATA32)rand();
+   return im;
+}
+
+/* the level drawn from, and the region in it */
+static int
+_mipmap_level(RGBA_Image *im, int *x, int *y, int *w, int *h,
+              int dw, int dh)
+{
+   RGBA_Image *lim;
+   unsigned int i;
+
+   lim = evas_common_rgba_image_mipmap_get(im, x, y, w, h, dw, dh);
+   if (lim == im) return 0;
+   for (i = 0; i < im->mipmap.count; i++)
+     if (im->mipmap.levels[i] == lim) return i + 1;
+   ck_abort_msg("%p is not a level of %p", lim, im);
+   return -1;
+}
+
+static void
+_mipmap_level_check(RGBA_Image *im, int sw, int sh, int dw, int dh,
+                    int level)
+{
+   int x = 0, y = 0, w = sw, h = sh;
+
+   ck_assert_int_eq(_mipmap_level(im, &x, &y, &w, &h, dw, dh), level);
+   ck_assert_int_eq(w, sw >> level);
+   ck_assert_int_eq(h, sh >> level);
+}
+
+/* The cpu is left uninitialized out of evas_common_suite_cpu_run(), as it
+ * is only initialized once: the levels are made by the C rows, then those
+ * are the reference the vector ones are compared to. */
+
+EFL_START_TEST(evas_mipmap_level_select)
+{
+   RGBA_Image *im;
+   int x, y, w, h;
+
+   srand(42);
+
+   im = _mipmap_image_new(256, 256, EINA_TRUE);
+   // never smaller than the destination, and less than twice its size
+   _mipmap_level_check(im, 256, 256, 256, 256, 0);
+   _mipmap_level_check(im, 256, 256, 200, 200, 0);
+   _mipmap_level_check(im, 256, 256, 129, 129, 0);
+   _mipmap_level_check(im, 256, 256, 128, 128, 1);
+   _mipmap_level_check(im, 256, 256, 127, 127, 1);
+   _mipmap_level_check(im, 256, 256, 65, 65, 1);
+   _mipmap_level_check(im, 256, 256, 64, 64, 2);
+   _mipmap_level_check(im, 256, 256, 1, 1, 8);
+   // the least downscaled direction decides
+   _mipmap_level_check(im, 256, 256, 128, 32, 1);
+   _mipmap_level_check(im, 256, 256, 16, 64, 2);
+   // levels are only built as deep as asked
+   evas_common_rgba_image_mipmap_dirty(&im->cache_entry);
+   _mipmap_level_check(im, 256, 256, 64, 64, 2);
+   ck_assert_int_eq(im->mipmap.count, 2);
+   ck_assert_int_eq(evas_common_rgba_image_mipmap_usage_get(&im->cache_entry),
+                    ((128 * 128) + (64 * 64)) * sizeof(DATA32));
+
+   // a region is looked at on its own, and moved to the level
+   x = 64; y = 32; w = 128; h = 128;
+   ck_assert_int_eq(_mipmap_level(im, &x, &y, &w, &h, 32, 32), 2);
+   ck_assert_int_eq(x, 16);
+   ck_assert_int_eq(y, 8);
+   ck_assert_int_eq(w, 32);
+   ck_assert_int_eq(h, 32);
+
+   // nothing for an empty destination
+   _mipmap_level_check(im, 256, 256, 0, 10, 0);
+   _mipmap_level_check(im, 256, 256, 10, -1, 0);
+   evas_common_rgba_image_free(&im->cache_entry);
+
+   // odd sizes round down, down to the last level one pixel high
+   im = _mipmap_image_new(255, 129, EINA_TRUE);
+   _mipmap_level_check(im, 255, 129, 10, 10, 3);
+   _mipmap_level_check(im, 255, 129, 1, 1, 7);
+   evas_common_rgba_image_free(&im->cache_entry);
+
+   // images not opted in are drawn from as they are
+   im = _mipmap_image_new(256, 256, EINA_FALSE);
+   _mipmap_level_check(im, 256, 256, 16, 16, 0);
+   ck_assert_int_eq(im->mipmap.count, 0);
+   evas_common_rgba_image_free(&im->cache_entry);
+}
+EFL_END_TEST
+
+static DATA32
+_mipmap_pixel(const DATA32 *s0, const DATA32 *s1)
+{
+   DATA32 p = 0;
+   int c;
+
+   for (c = 0; c < 32; c += 8)
+     {
+        DATA32 sum = ((s0[0] >> c) & 0xff) + ((s0[1] >> c) & 0xff) +
+          ((s1[0] >> c) & 0xff) + ((s1[1] >> c) & 0xff);
+
+        p |= ((sum + 2) >> 2) << c;
+     }
+   return p;
+}
+
+EFL_START_TEST(evas_mipmap_level_pixels)
+{
+   RGBA_Image *im, *parent;
+   int x = 0, y = 0, w = 203, h = 77;
+   unsigned int i;
+   int px, py;
+
+   srand(42);
+
+   im = _mipmap_image_new(203, 77, EINA_TRUE);
+   ck_assert_int_eq(_mipmap_level(im, &x, &y, &w, &h, 1, 1), 6);
+
+   // each level is its parent box filtered 2x2, an odd last column and
+   // row being dropped
+   parent = im;
+   for (i = 0; i < im->mipmap.count; i++)
+     {
+        RGBA_Image *l = im->mipmap.levels[i];
+        int pw = parent->cache_entry.w;
+
+        ck_assert_int_eq(l->cache_entry.w, pw / 2);
+        ck_assert_int_eq(l->cache_entry.h, parent->cache_entry.h / 2);
+        fail_if(!l->cache_entry.flags.alpha);
+        for (py = 0; py < (int)l->cache_entry.h; py++)
+          for (px = 0; px < (int)l->cache_entry.w; px++)
+            {
+               const DATA32 *s = parent->image.data + (py * 2 * pw) + (px * 2);
+
+               ck_assert_int_eq(l->image.data[(py * l->cache_entry.w) + px],
+                                _mipmap_pixel(s, s + pw));
+            }
+        parent = l;
+     }
+
+   // dropped with the image data
+   evas_common_rgba_image_mipmap_dirty(&im->cache_entry);
+   ck_assert_int_eq(im->mipmap.count, 0);
+   ck_assert_int_eq(evas_common_rgba_image_mipmap_usage_get(&im->cache_entry), 0);
+   evas_common_rgba_image_free(&im->cache_entry);
+}
+EFL_END_TEST
+
+#ifndef _WIN32
+
+#include <sys/mman.h>
+
+#define NO_OLD_SIMD \
+   "EVAS_CPU_NO_MMX", "EVAS_CPU_NO_MMX2", "EVAS_CPU_NO_SSE", \
+   "EVAS_CPU_NO_SSE3", "EVAS_CPU_NO_ALTIVEC"
+
+static const char *const c_only[] = {
+   NO_OLD_SIMD, "EVAS_CPU_NO_SSE41", "EVAS_CPU_NO_AVX2",
+   "EVAS_CPU_NO_AVX512", "EVAS_CPU_NO_NEON", NULL
+};
+static const char *const sse41_only[] = {
+   NO_OLD_SIMD, "EVAS_CPU_NO_AVX2", "EVAS_CPU_NO_AVX512", NULL
+};
+static const char *const best[] = { NO_OLD_SIMD, NULL };
+
+/* odd sizes, with rows not a multiple of any vector length */
+static const int sizes[][2] = {
+   { 203, 77 }, { 37, 515 }, { 2, 2 }, { 17, 3 }
+};
+
+typedef struct
+{
+   unsigned int seed;
+   DATA32 *out;
+} Mipmap_Run;
+
+/* all the levels of each image, one after the other */
+static void
+_mipmap_run_child(void *data)
+{
+   Mipmap_Run *run = data;
+   DATA32 *out = run->out;
+   unsigned int i, n;
+
+   srand(run->seed);
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+     {
+        int x = 0, y = 0, w = sizes[i][0], h = sizes[i][1];
+        RGBA_Image *im;
+
+        im = _mipmap_image_new(w, h, EINA_TRUE);
+        evas_common_rgba_image_mipmap_get(im, &x, &y, &w, &h, 1, 1);
+        for (n = 0; n < im->mipmap.count; n++)
+          {
+             RGBA_Image *l = im->mipmap.levels[n];
+             size_t len = l->cache_entry.w * l->cache_entry.h;
+
+             memcpy(out, l->image.data, len * sizeof(DATA32));
+             out += len;
+          }
+        evas_common_rgba_image_free(&im->cache_entry);
+     }
+}
+
+EFL_START_TEST(evas_mipmap_simd_levels)
+{
+   Eina_Cpu_Features features = eina_cpu_features_get();
+   Mipmap_Run run;
+   DATA32 *ref;
+   size_t pixels = 0, size;
+   unsigned int i;
+
+   // each level is less than a third of the image and the ones below it
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(sizes); i++)
+     pixels += sizes[i][0] * sizes[i][1] / 3;
+   size = 2 * pixels * sizeof(DATA32);
+   ref = mmap(NULL, size, PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   fail_if(ref == MAP_FAILED);
+
+   run.seed = 42;
+   run.out = ref;
+   fail_if(!evas_common_suite_cpu_run(c_only, _mipmap_run_child, &run));
+
+   run.out = ref + pixels;
+   if (features & EINA_CPU_SSE41)
+     {
+        fail_if(!evas_common_suite_cpu_run(sse41_only, _mipmap_run_child, &run));
+        fail_if(memcmp(ref, run.out, pixels * sizeof(DATA32)),
+                "SSE4.1 levels differ from C");
+     }
+   if (features & (EINA_CPU_AVX2 | EINA_CPU_NEON))
+     {
+        fail_if(!evas_common_suite_cpu_run(best, _mipmap_run_child, &run));
+        fail_if(memcmp(ref, run.out, pixels * sizeof(DATA32)),
+                "AVX2 or NEON levels differ from C");
+     }
+
+   munmap(ref, size);
+}
+EFL_END_TEST
+
+#endif
+
+void evas_test_mipmap(TCase *tc)
+{
+   tcase_add_test(tc, evas_mipmap_level_select);
+   tcase_add_test(tc, evas_mipmap_level_pixels);
+#ifndef _WIN32
+   tcase_add_test(tc, evas_mipmap_simd_levels);
+#endif
+}
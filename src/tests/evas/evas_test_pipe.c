@@ -0,0 +1,122 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../../lib/evas/include/evas_common_private.h"
+#include "../../lib/evas/include/evas_private.h"
+
+#include "evas_suite.h"
+
+#ifdef BUILD_PIPE_RENDER
+
+/* not a multiple of the 128 pixels tiles, so the last row and column of
+ * them are partial */
+#define W 517
+#define H 389
+
+typedef struct
+{
+   int x, y, w, h;
+   int r, g, b, a;
+   int clip;
+} Pipe_Test_Rect;
+
+static const Pipe_Test_Rect rects[] = {
+   { 0, 0, W, H, 20, 40, 60, 255, 0 },
+   { -30, -20, 200, 150, 200, 0, 0, 160, 0 },
+   { 100, 90, 300, 220, 0, 180, 40, 120, 0 },
+   { 127, 127, 2, 2, 250, 250, 250, 250, 0 },
+   { 250, 10, 400, 400, 30, 30, 200, 90, 1 },
+   { 400, 300, 200, 200, 100, 0, 100, 200, 0 },
+   { 5, 200, 510, 40, 60, 60, 0, 60, 1 },
+};
+
+static const int lines[][4] = {
+   { 0, 0, W - 1, H - 1 },
+   { W - 1, 0, 0, H - 1 },
+   { 10, 300, 500, 310 },
+   { 256, 5, 260, 380 },
+};
+
+static void
+_pipe_test_draw(RGBA_Image *im, Eina_Bool piped)
+{
+   RGBA_Draw_Context *dc;
+   unsigned int i;
+
+   dc = evas_common_draw_context_new();
+   evas_common_draw_context_set_render_op(dc, _EVAS_RENDER_BLEND);
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(rects); i++)
+     {
+        const Pipe_Test_Rect *r = &rects[i];
+
+        if (r->clip)
+          evas_common_draw_context_set_clip(dc, 130, 60, 250, 260);
+        else
+          evas_common_draw_context_unset_clip(dc);
+        evas_common_draw_context_set_color(dc, r->r, r->g, r->b, r->a);
+        if (piped)
+          evas_common_pipe_rectangle_draw(im, dc, r->x, r->y, r->w, r->h);
+        else
+          evas_common_rectangle_draw(im, dc, r->x, r->y, r->w, r->h);
+     }
+
+   evas_common_draw_context_unset_clip(dc);
+   evas_common_draw_context_set_color(dc, 255, 255, 0, 200);
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(lines); i++)
+     {
+        if (piped)
+          evas_common_pipe_line_draw(im, dc, lines[i][0], lines[i][1],
+                                     lines[i][2], lines[i][3]);
+        else
+          evas_common_line_draw(im, dc, lines[i][0], lines[i][1],
+                                lines[i][2], lines[i][3]);
+     }
+   evas_common_draw_context_free(dc);
+
+   if (piped)
+     {
+        evas_common_pipe_map_begin(im);
+        evas_common_pipe_flush(im);
+     }
+   else
+     evas_common_cpu_end_opt();
+}
+
+EFL_START_TEST(evas_pipe_tiled_output)
+{
+   RGBA_Image *tiled, *direct;
+   int y;
+
+   evas_common_pipe_init();
+
+   tiled = evas_common_image_new(W, H, 1);
+   direct = evas_common_image_new(W, H, 1);
+   fail_if(!tiled || !direct);
+   memset(tiled->image.data, 0, W * H * sizeof(DATA32));
+   memset(direct->image.data, 0, W * H * sizeof(DATA32));
+
+   _pipe_test_draw(tiled, EINA_TRUE);
+   _pipe_test_draw(direct, EINA_FALSE);
+   fail_if(tiled->cache_entry.pipe != NULL);
+
+   for (y = 0; y < H; y++)
+     fail_if(memcmp(tiled->image.data + (y * W), direct->image.data + (y * W),
+                    W * sizeof(DATA32)), "row %d differs", y);
+
+   evas_common_rgba_image_free(&tiled->cache_entry);
+   evas_common_rgba_image_free(&direct->cache_entry);
+}
+EFL_END_TEST
+
+#endif
+
+void evas_test_pipe(TCase *tc EINA_UNUSED)
+{
+#ifdef BUILD_PIPE_RENDER
+   tcase_add_test(tc, evas_pipe_tiled_output);
+#endif
+}
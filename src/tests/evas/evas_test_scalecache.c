@@ -0,0 +1,263 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <Evas.h>
+#include <Ecore_Evas.h>
+
+#include "evas_suite.h"
+
+#ifdef BUILD_ENGINE_BUFFER
+
+#define TESTS_IMG_DIR TESTS_SRC_DIR"/images"
+#define TEST_IMG TESTS_IMG_DIR"/Pic1-10.png"
+
+#define W 64
+#define H 64
+
+/* the scale cache populates an item from its fourth draw on */
+#define POPULATE_DRAWS 6
+
+/* The disk tier is set up from the environment when evas is initialized,
+ * and what the writer thread has left to write is written when it is shut
+ * down, which also drops everything kept in memory: each step of the tests
+ * runs between two restarts. */
+static void
+_scalecache_restart(const char *dir, const char *size)
+{
+   ecore_evas_shutdown();
+   evas_shutdown();
+   if (dir) setenv("EVAS_SCALECACHE_DISK", dir, 1);
+   else unsetenv("EVAS_SCALECACHE_DISK");
+   if (size) setenv("EVAS_SCALECACHE_DISK_SIZE", size, 1);
+   else unsetenv("EVAS_SCALECACHE_DISK_SIZE");
+   ck_assert_int_eq(evas_init(), 1);
+   ck_assert_int_eq(ecore_evas_init(), 1);
+}
+
+/* draws the image at w x h, and gives the pixels of the last draw */
+static void
+_scalecache_draw(int w, int h, int draws, unsigned int *out)
+{
+   Ecore_Evas *ee;
+   Evas_Object *o;
+   const unsigned int *pixels;
+   Evas *e;
+   int i, y;
+
+   ee = ecore_evas_buffer_new(W, H);
+   fail_if(!ee);
+   ecore_evas_show(ee);
+   ecore_evas_manual_render_set(ee, EINA_TRUE);
+   e = ecore_evas_get(ee);
+
+   o = evas_object_image_filled_add(e);
+   evas_object_image_file_set(o, TEST_IMG, NULL);
+   fail_if(evas_object_image_load_error_get(o) != EVAS_LOAD_ERROR_NONE);
+   evas_object_geometry_set(o, 0, 0, w, h);
+   evas_object_show(o);
+
+   for (i = 0; i < draws; i++)
+     {
+        evas_damage_rectangle_add(e, 0, 0, W, H);
+        ecore_evas_manual_render(ee);
+     }
+
+   if (out)
+     {
+        pixels = ecore_evas_buffer_pixels_get(ee);
+        for (y = 0; y < h; y++)
+          memcpy(out + (y * w), pixels + (y * W), w * sizeof(unsigned int));
+     }
+
+   evas_object_del(o);
+   ecore_evas_free(ee);
+}
+
+/* number of results stored, their total size and the path of one */
+static unsigned int
+_scalecache_files(const char *dir, unsigned long long *total, char *path)
+{
+   const Eina_File_Direct_Info *info;
+   Eina_Iterator *it;
+   unsigned int count = 0;
+   struct stat st;
+
+   *total = 0;
+   it = eina_file_direct_ls(dir);
+   fail_if(!it);
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        if (!eina_str_has_extension(info->path, ".scale")) continue;
+        if (stat(info->path, &st)) continue;
+        *total += st.st_size;
+        if (path) strcpy(path, info->path);
+        count++;
+     }
+   eina_iterator_free(it);
+   return count;
+}
+
+static void
+_scalecache_dir_del(Eina_Tmpstr *dir)
+{
+   const Eina_File_Direct_Info *info;
+   Eina_Iterator *it;
+
+   it = eina_file_direct_ls(dir);
+   if (it)
+     {
+        EINA_ITERATOR_FOREACH(it, info)
+          unlink(info->path);
+        eina_iterator_free(it);
+     }
+   rmdir(dir);
+   eina_tmpstr_del(dir);
+}
+
+/* the pixels are at the end of the file */
+static void
+_scalecache_file_pixels_set(const char *path, int count, unsigned int color)
+{
+   FILE *fp;
+   int i;
+
+   fp = fopen(path, "r+b");
+   fail_if(!fp);
+   fail_if(fseek(fp, -(long)(count * sizeof(unsigned int)), SEEK_END));
+   for (i = 0; i < count; i++)
+     fail_if(fwrite(&color, sizeof(color), 1, fp) != 1);
+   fail_if(fclose(fp));
+}
+
+/* changes the stored key, which holds the path of the original image */
+static void
+_scalecache_file_key_break(const char *path)
+{
+   Eina_File *f;
+   const char *map, *k;
+   size_t off;
+   FILE *fp;
+
+   f = eina_file_open(path, EINA_FALSE);
+   fail_if(!f);
+   map = eina_file_map_all(f, EINA_FILE_POPULATE);
+   fail_if(!map);
+   k = memmem(map, eina_file_size_get(f), TEST_IMG, strlen(TEST_IMG));
+   fail_if(!k);
+   off = (k - map) + strlen(TEST_IMG) - 1;
+   eina_file_map_free(f, (void *)map);
+   eina_file_close(f);
+
+   fp = fopen(path, "r+b");
+   fail_if(!fp);
+   fail_if(fseek(fp, off, SEEK_SET));
+   fail_if(fputc('x', fp) == EOF);
+   fail_if(fclose(fp));
+}
+
+EFL_START_TEST(evas_scalecache_disk_round_trip)
+{
+   unsigned int cached[48 * 40], out[48 * 40];
+   char path[PATH_MAX];
+   unsigned long long total;
+   Eina_Tmpstr *dir;
+   int i;
+
+   fail_if(!eina_file_mkdtemp("EvasScalecacheXXXXXX", &dir));
+   _scalecache_restart(dir, NULL);
+
+   _scalecache_draw(48, 40, POPULATE_DRAWS, cached);
+   _scalecache_restart(dir, NULL);
+   ck_assert_int_eq(_scalecache_files(dir, &total, path), 1);
+
+   // the stored result is drawn from the first draw on
+   _scalecache_draw(48, 40, 1, out);
+   fail_if(memcmp(out, cached, sizeof(out)));
+   _scalecache_restart(dir, NULL);
+
+   // and it is the one drawn, not a new scale of the image
+   _scalecache_file_pixels_set(path, 48 * 40, 0xff00ff00);
+   _scalecache_draw(48, 40, 1, out);
+   for (i = 0; i < 48 * 40; i++)
+     ck_assert_int_eq(out[i], 0xff00ff00);
+   _scalecache_restart(dir, NULL);
+
+   // another size is not found
+   _scalecache_draw(40, 48, 1, out);
+   for (i = 0; i < 40 * 48; i++)
+     fail_if(out[i] == 0xff00ff00);
+
+   _scalecache_restart(NULL, NULL);
+   _scalecache_dir_del(dir);
+}
+EFL_END_TEST
+
+EFL_START_TEST(evas_scalecache_disk_key_mismatch)
+{
+   unsigned int direct[48 * 40], out[48 * 40];
+   char path[PATH_MAX];
+   unsigned long long total;
+   Eina_Tmpstr *dir;
+
+   fail_if(!eina_file_mkdtemp("EvasScalecacheXXXXXX", &dir));
+   _scalecache_restart(dir, NULL);
+
+   _scalecache_draw(48, 40, 1, direct);
+   _scalecache_draw(48, 40, POPULATE_DRAWS, NULL);
+   _scalecache_restart(dir, NULL);
+   ck_assert_int_eq(_scalecache_files(dir, &total, path), 1);
+
+   // a file under the same name but for another key, as a hash collision
+   // would give, is left alone and the image scaled again
+   _scalecache_file_pixels_set(path, 48 * 40, 0xff00ff00);
+   _scalecache_file_key_break(path);
+   _scalecache_draw(48, 40, 1, out);
+   fail_if(memcmp(out, direct, sizeof(out)));
+
+   _scalecache_restart(NULL, NULL);
+   _scalecache_dir_del(dir);
+}
+EFL_END_TEST
+
+EFL_START_TEST(evas_scalecache_disk_size_cap)
+{
+   unsigned long long total;
+   unsigned int count;
+   Eina_Tmpstr *dir;
+   int i;
+
+   fail_if(!eina_file_mkdtemp("EvasScalecacheXXXXXX", &dir));
+   // room for four results of about 10KB, eight are stored
+   _scalecache_restart(dir, "48");
+
+   for (i = 0; i < 8; i++)
+     _scalecache_draw(50 - i, 50, POPULATE_DRAWS, NULL);
+   _scalecache_restart(dir, "48");
+
+   count = _scalecache_files(dir, &total, NULL);
+   fail_if(count < 1);
+   fail_if(count >= 8);
+   fail_if(total > 48 * 1024);
+
+   _scalecache_restart(NULL, NULL);
+   _scalecache_dir_del(dir);
+}
+EFL_END_TEST
+
+#endif
+
+void evas_test_scalecache(TCase *tc EINA_UNUSED)
+{
+#ifdef BUILD_ENGINE_BUFFER
+   tcase_add_test(tc, evas_scalecache_disk_round_trip);
+   tcase_add_test(tc, evas_scalecache_disk_key_mismatch);
+   tcase_add_test(tc, evas_scalecache_disk_size_cap);
+#endif
+}